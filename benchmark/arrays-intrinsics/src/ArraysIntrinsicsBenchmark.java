@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.util.Arrays;
+
+public class ArraysIntrinsicsBenchmark {
+    private static final int SIZE = 1024;
+    private static final int SMALL_SIZE = 30;
+
+    private final byte[] bytes1 = new byte[SIZE];
+    private final byte[] bytes2 = new byte[SIZE];
+    private final char[] chars1 = new char[SIZE];
+    private final char[] chars2 = new char[SIZE];
+    private final int[] ints1 = new int[SIZE];
+    private final int[] ints2 = new int[SIZE];
+    private final long[] longs1 = new long[SIZE];
+    private final long[] longs2 = new long[SIZE];
+
+    public ArraysIntrinsicsBenchmark() {
+        for (int i = 0; i < SIZE; i++) {
+            bytes1[i] = bytes2[i] = (byte) i;
+            chars1[i] = chars2[i] = (char) (i * 7);
+            ints1[i] = ints2[i] = i * 31;
+            longs1[i] = longs2[i] = i * 0x100000001L;
+        }
+    }
+
+    public boolean timeEqualsBytes(int count) {
+        boolean result = true;
+        for (int n = 0; n < count; n++) {
+            result &= Arrays.equals(bytes1, bytes2);
+        }
+        return result;
+    }
+
+    public boolean timeEqualsChars(int count) {
+        boolean result = true;
+        for (int n = 0; n < count; n++) {
+            result &= Arrays.equals(chars1, chars2);
+        }
+        return result;
+    }
+
+    public boolean timeEqualsInts(int count) {
+        boolean result = true;
+        for (int n = 0; n < count; n++) {
+            result &= Arrays.equals(ints1, ints2);
+        }
+        return result;
+    }
+
+    public boolean timeEqualsLongs(int count) {
+        boolean result = true;
+        for (int n = 0; n < count; n++) {
+            result &= Arrays.equals(longs1, longs2);
+        }
+        return result;
+    }
+
+    public void timeFillBytes(int count) {
+        for (int n = 0; n < count; n++) {
+            Arrays.fill(bytes2, (byte) n);
+        }
+    }
+
+    public void timeFillInts(int count) {
+        for (int n = 0; n < count; n++) {
+            Arrays.fill(ints2, n);
+        }
+    }
+
+    public void timeFillLongs(int count) {
+        for (int n = 0; n < count; n++) {
+            Arrays.fill(longs2, n);
+        }
+    }
+
+    public int timeHashCodeBytes(int count) {
+        int result = 0;
+        for (int n = 0; n < count; n++) {
+            result += Arrays.hashCode(bytes1);
+        }
+        return result;
+    }
+
+    public int timeHashCodeChars(int count) {
+        int result = 0;
+        for (int n = 0; n < count; n++) {
+            result += Arrays.hashCode(chars1);
+        }
+        return result;
+    }
+
+    public int timeHashCodeInts(int count) {
+        int result = 0;
+        for (int n = 0; n < count; n++) {
+            result += Arrays.hashCode(ints1);
+        }
+        return result;
+    }
+
+    public int timeHashCodeLongs(int count) {
+        int result = 0;
+        for (int n = 0; n < count; n++) {
+            result += Arrays.hashCode(longs1);
+        }
+        return result;
+    }
+
+    // Short copies, which the intrinsics handle inline instead of calling into the runtime.
+    public void timeArrayCopyBytes(int count) {
+        for (int n = 0; n < count; n++) {
+            System.arraycopy(bytes1, n & 0xff, bytes2, 0, SMALL_SIZE);
+        }
+    }
+
+    public void timeArrayCopyInts(int count) {
+        for (int n = 0; n < count; n++) {
+            System.arraycopy(ints1, n & 0xff, ints2, 0, SMALL_SIZE);
+        }
+    }
+
+    public void timeArrayCopyLongs(int count) {
+        for (int n = 0; n < count; n++) {
+            System.arraycopy(longs1, n & 0xff, longs2, 0, SMALL_SIZE);
+        }
+    }
+}
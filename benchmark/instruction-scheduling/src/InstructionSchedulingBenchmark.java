@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The loop bodies below have enough instructions for the x86-64 scheduler to
+ * consider them, and mix long latency operations (loads, multiplications,
+ * divisions) with independent short ones the scheduler can move in between.
+ */
+public class InstructionSchedulingBenchmark {
+    private static final int SIZE = 1024;
+
+    private final int[] ints1 = new int[SIZE];
+    private final int[] ints2 = new int[SIZE];
+    private final int[] ints3 = new int[SIZE];
+    private final float[] floats1 = new float[SIZE];
+    private final float[] floats2 = new float[SIZE];
+
+    public InstructionSchedulingBenchmark() {
+        for (int i = 0; i < SIZE; i++) {
+            ints1[i] = i;
+            ints2[i] = SIZE - i;
+            floats1[i] = i * 0.5f + 1.0f;
+            floats2[i] = i * 0.25f;
+        }
+    }
+
+    public void timeMulAddInts(int count) {
+        for (int n = 0; n < count; n++) {
+            $noinline$mulAddInts(ints1, ints2, ints3);
+        }
+    }
+
+    public void timeDivByConstant(int count) {
+        for (int n = 0; n < count; n++) {
+            $noinline$divByConstant(ints1, ints2, ints3);
+        }
+    }
+
+    public void timeDivFloats(int count) {
+        for (int n = 0; n < count; n++) {
+            $noinline$divFloats(floats1, floats2);
+        }
+    }
+
+    public void timeFieldLoads(int count) {
+        for (int n = 0; n < count; n++) {
+            $noinline$fieldLoads(this);
+        }
+    }
+
+    private static void $noinline$mulAddInts(int[] a, int[] b, int[] c) {
+        int sum = 0;
+        for (int i = 0; i < a.length; i++) {
+            int x = a[i] * b[i];
+            int y = (a[i] >> 2) ^ (b[i] << 1);
+            c[i] = x + y + sum;
+            sum += a[i] - b[i];
+        }
+    }
+
+    private static void $noinline$divByConstant(int[] a, int[] b, int[] c) {
+        for (int i = 0; i < a.length; i++) {
+            int q = a[i] / 10;
+            int r = b[i] % 7;
+            c[i] = q + r + (a[i] & 0xff) + (b[i] >>> 3);
+        }
+    }
+
+    private static void $noinline$divFloats(float[] a, float[] b) {
+        for (int i = 0; i < a.length; i++) {
+            float x = b[i] / a[i];
+            float y = a[i] * 0.5f + b[i];
+            b[i] = x + y;
+        }
+    }
+
+    private static int $noinline$fieldLoads(InstructionSchedulingBenchmark self) {
+        int sum = 0;
+        for (int i = 0; i < SIZE; i++) {
+            int x = self.ints1[i] * self.ints2[i];
+            int y = self.ints3[i] + i;
+            sum += x ^ y;
+        }
+        return sum;
+    }
+}
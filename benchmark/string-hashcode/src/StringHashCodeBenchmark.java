@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class StringHashCodeBenchmark {
+    // Strings hashing to 0 do not cache their hash code, so that each call hashes the
+    // whole string. "f5a5a608" hashes to 0, and so does any repetition of it.
+    private static final int REPEAT = 32;  // length = 256
+
+    private final String compressed;
+    private final String uncompressed;
+
+    public StringHashCodeBenchmark() {
+        StringBuilder sb = new StringBuilder();
+        for (int i = 0; i < REPEAT; i++) {
+            sb.append("f5a5a608");
+        }
+        compressed = sb.toString();
+        uncompressed = new String(new char[compressed.length()]);
+    }
+
+    public int timeHashCodeCompressed(int count) {
+        int result = 0;
+        for (int n = 0; n < count; n++) {
+            result += compressed.hashCode();
+        }
+        return result;
+    }
+
+    public int timeHashCodeUncompressed(int count) {
+        int result = 0;
+        for (int n = 0; n < count; n++) {
+            result += uncompressed.hashCode();
+        }
+        return result;
+    }
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class VectorLoopBenchmark {
+    private static final int SIZE = 1024;
+
+    private final byte[] bytes1 = new byte[SIZE];
+    private final byte[] bytes2 = new byte[SIZE];
+    private final short[] shorts = new short[SIZE];
+    private final int[] ints1 = new int[SIZE];
+    private final int[] ints2 = new int[SIZE];
+    private final float[] floats1 = new float[SIZE];
+    private final float[] floats2 = new float[SIZE];
+    private final double[] doubles1 = new double[SIZE];
+    private final double[] doubles2 = new double[SIZE];
+
+    public VectorLoopBenchmark() {
+        for (int i = 0; i < SIZE; i++) {
+            bytes1[i] = (byte) i;
+            bytes2[i] = (byte) (i * 3);
+            shorts[i] = (short) (i * 7);
+            ints1[i] = i;
+            ints2[i] = SIZE - i;
+            floats1[i] = i * 0.5f;
+            floats2[i] = i * 0.25f;
+            doubles1[i] = i * 0.5;
+            doubles2[i] = i * 0.25;
+        }
+    }
+
+    public void timeAddInts(int count) {
+        for (int n = 0; n < count; n++) {
+            $noinline$addInts(ints1, ints2);
+        }
+    }
+
+    public void timeMulInts(int count) {
+        for (int n = 0; n < count; n++) {
+            $noinline$mulInts(ints1, ints2);
+        }
+    }
+
+    public void timeShiftInts(int count) {
+        for (int n = 0; n < count; n++) {
+            $noinline$shiftInts(ints1);
+        }
+    }
+
+    public void timeScaleShorts(int count) {
+        for (int n = 0; n < count; n++) {
+            $noinline$scaleShorts(shorts, (short) 3);
+        }
+    }
+
+    public void timeAverageBytes(int count) {
+        for (int n = 0; n < count; n++) {
+            $noinline$averageBytes(bytes1, bytes2);
+        }
+    }
+
+    public void timeSaxpy(int count) {
+        for (int n = 0; n < count; n++) {
+            $noinline$saxpy(floats1, floats2, 1.0001f);
+        }
+    }
+
+    public void timeDaxpy(int count) {
+        for (int n = 0; n < count; n++) {
+            $noinline$daxpy(doubles1, doubles2, 1.0001);
+        }
+    }
+
+    public void timeIntToFloat(int count) {
+        for (int n = 0; n < count; n++) {
+            $noinline$intToFloat(floats1, ints1);
+        }
+    }
+
+    private static void $noinline$addInts(int[] a, int[] b) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] += b[i];
+        }
+    }
+
+    private static void $noinline$mulInts(int[] a, int[] b) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] *= b[i];
+        }
+    }
+
+    private static void $noinline$shiftInts(int[] a) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] = (a[i] << 1) ^ (a[i] >>> 3);
+        }
+    }
+
+    private static void $noinline$scaleShorts(short[] a, short s) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] = (short) (a[i] * s);
+        }
+    }
+
+    private static void $noinline$averageBytes(byte[] a, byte[] b) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] = (byte) (((a[i] & 0xff) + (b[i] & 0xff) + 1) >> 1);
+        }
+    }
+
+    private static void $noinline$saxpy(float[] x, float[] y, float alpha) {
+        for (int i = 0; i < x.length; i++) {
+            y[i] = alpha * x[i] + y[i];
+        }
+    }
+
+    private static void $noinline$daxpy(double[] x, double[] y, double alpha) {
+        for (int i = 0; i < x.length; i++) {
+            y[i] = alpha * x[i] + y[i];
+        }
+    }
+
+    private static void $noinline$intToFloat(float[] a, int[] b) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] = b[i];
+        }
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.util.zip.Adler32;
+import java.util.zip.CRC32;
+
+public class ZipChecksumBenchmark {
+    private static final int SMALL_SIZE = 16;
+    private static final int MEDIUM_SIZE = 1024;
+    // Above the sizes the intrinsics checksum themselves: measures the zlib path.
+    private static final int LARGE_SIZE = 128 * 1024;
+
+    private final byte[] bytes = new byte[LARGE_SIZE];
+    private final CRC32 crc32 = new CRC32();
+    private final Adler32 adler32 = new Adler32();
+
+    public ZipChecksumBenchmark() {
+        for (int i = 0; i < LARGE_SIZE; i++) {
+            bytes[i] = (byte) (i * 31);
+        }
+    }
+
+    public long timeCRC32UpdateByte(int count) {
+        for (int n = 0; n < count; n++) {
+            crc32.update(n);
+        }
+        return crc32.getValue();
+    }
+
+    public long timeCRC32UpdateSmall(int count) {
+        for (int n = 0; n < count; n++) {
+            crc32.update(bytes, 0, SMALL_SIZE);
+        }
+        return crc32.getValue();
+    }
+
+    public long timeCRC32UpdateMedium(int count) {
+        for (int n = 0; n < count; n++) {
+            crc32.update(bytes, 0, MEDIUM_SIZE);
+        }
+        return crc32.getValue();
+    }
+
+    public long timeCRC32UpdateLarge(int count) {
+        for (int n = 0; n < count; n++) {
+            crc32.update(bytes, 0, LARGE_SIZE);
+        }
+        return crc32.getValue();
+    }
+
+    public long timeAdler32UpdateByte(int count) {
+        for (int n = 0; n < count; n++) {
+            adler32.update(n);
+        }
+        return adler32.getValue();
+    }
+
+    public long timeAdler32UpdateSmall(int count) {
+        for (int n = 0; n < count; n++) {
+            adler32.update(bytes, 0, SMALL_SIZE);
+        }
+        return adler32.getValue();
+    }
+
+    public long timeAdler32UpdateMedium(int count) {
+        for (int n = 0; n < count; n++) {
+            adler32.update(bytes, 0, MEDIUM_SIZE);
+        }
+        return adler32.getValue();
+    }
+}
@@ -0,0 +1,660 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compilation_cache.h"
+
+#include <elf.h>
+#include <fcntl.h>
+#include <link.h>
+#include <openssl/sha.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "base/array_ref.h"
+#include "base/bit_utils.h"
+#include "base/logging.h"
+#include "class_linker-inl.h"
+#include "compiled_method.h"
+#include "dex_file-inl.h"
+#include "driver/compiler_driver.h"
+#include "driver/compiler_options.h"
+#include "driver/incremental_compilation.h"
+#include "handle_scope-inl.h"
+#include "mem_map.h"
+#include "mirror/class-inl.h"
+#include "mirror/class_loader.h"
+#include "mirror/dex_cache.h"
+#include "oat.h"
+#include "os.h"
+#include "runtime.h"
+#include "scoped_thread_state_change-inl.h"
+#include "thread.h"
+
+namespace art {
+
+constexpr uint8_t CompilationCache::kMagic[];
+constexpr uint8_t CompilationCache::kVersion[];
+
+// An entry starts with a `Header`, holding the digest of the rest of the entry, followed by
+// the `MethodEntry` of each cached method, sorted by method index, and by the data of the
+// methods. The data of a method is its `MethodHeader`, the `PatchRecord` of each of its linker
+// patches, then its code, method info, vmap table and CFI, padded to a multiple of 4 bytes.
+struct CompilationCache::Header {
+  uint8_t magic[sizeof(kMagic)];
+  uint8_t version[sizeof(kVersion)];
+  uint8_t key[SHA_DIGEST_LENGTH];
+  uint8_t digest[SHA_DIGEST_LENGTH];
+  uint32_t num_methods;
+};
+
+struct CompilationCache::MethodEntry {
+  uint32_t method_idx;
+  // Offset of the `MethodHeader` from the start of the entry.
+  uint32_t offset;
+};
+
+struct CompilationCache::MethodHeader {
+  uint32_t frame_size_in_bytes;
+  uint32_t core_spill_mask;
+  uint32_t fp_spill_mask;
+  uint32_t num_patches;
+  uint32_t code_size;
+  uint32_t method_info_size;
+  uint32_t vmap_table_size;
+  uint32_t cfi_info_size;
+};
+
+// The values of a linker patch are encoded as by `IncrementalCompilation::DecodePatch()`,
+// with `value2` holding the target dex file index for the patches other than the Baker read
+// barrier branches.
+struct CompilationCache::PatchRecord {
+  uint32_t type;
+  uint32_t literal_offset;
+  uint32_t value1;
+  uint32_t value2;
+  uint32_t target_idx;
+};
+
+static constexpr size_t kAlignment = 4u;
+
+template <typename T>
+static void Append(std::vector<uint8_t>* out, const T& value) {
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(&value);
+  out->insert(out->end(), data, data + sizeof(T));
+}
+
+static void Append(std::vector<uint8_t>* out, ArrayRef<const uint8_t> data) {
+  out->insert(out->end(), data.begin(), data.end());
+}
+
+static bool IsValidPatchType(uint32_t type) {
+  return type <= static_cast<uint32_t>(LinkerPatch::Type::kBakerReadBarrierBranch);
+}
+
+// The loaded object holding the compiler code, found by `FindCompilerObject()`.
+struct CompilerObject {
+  uintptr_t address;
+  bool found;
+  std::string path;
+  std::vector<uint8_t> build_id;
+};
+
+static int FindCompilerObject(struct dl_phdr_info* info, size_t size ATTRIBUTE_UNUSED, void* data) {
+  CompilerObject* object = reinterpret_cast<CompilerObject*>(data);
+  bool contains_address = false;
+  for (size_t i = 0; i != info->dlpi_phnum; ++i) {
+    const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+    uintptr_t start = info->dlpi_addr + phdr.p_vaddr;
+    if (phdr.p_type == PT_LOAD &&
+        object->address >= start &&
+        object->address - start < phdr.p_memsz) {
+      contains_address = true;
+      break;
+    }
+  }
+  if (!contains_address) {
+    return 0;
+  }
+  object->found = true;
+  object->path = info->dlpi_name;
+  for (size_t i = 0; i != info->dlpi_phnum; ++i) {
+    const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+    if (phdr.p_type != PT_NOTE) {
+      continue;
+    }
+    const uint8_t* note = reinterpret_cast<const uint8_t*>(info->dlpi_addr + phdr.p_vaddr);
+    const uint8_t* end = note + phdr.p_memsz;
+    while (static_cast<size_t>(end - note) >= sizeof(ElfW(Nhdr))) {
+      const ElfW(Nhdr)* note_header = reinterpret_cast<const ElfW(Nhdr)*>(note);
+      const uint8_t* name = note + sizeof(ElfW(Nhdr));
+      const uint8_t* desc = name + RoundUp(note_header->n_namesz, 4u);
+      if (desc > end || note_header->n_descsz > static_cast<size_t>(end - desc)) {
+        break;
+      }
+      if (note_header->n_type == NT_GNU_BUILD_ID &&
+          note_header->n_namesz == sizeof("GNU") &&
+          memcmp(name, "GNU", sizeof("GNU")) == 0) {
+        object->build_id.assign(desc, desc + note_header->n_descsz);
+        return 1;
+      }
+      note = desc + RoundUp(note_header->n_descsz, 4u);
+    }
+  }
+  return 1;
+}
+
+// Compute a fingerprint of the build of the compiler: the build id of the object holding its
+// code, or the digest of that object's file if it has no build id.
+static bool GetCompilerFingerprint(std::vector<uint8_t>* fingerprint, std::string* error_msg) {
+  CompilerObject object;
+  object.address = reinterpret_cast<uintptr_t>(&GetCompilerFingerprint);
+  object.found = false;
+  dl_iterate_phdr(FindCompilerObject, &object);
+  if (!object.found) {
+    *error_msg = "Cannot find the object holding the compiler";
+    return false;
+  }
+  if (!object.build_id.empty()) {
+    *fingerprint = std::move(object.build_id);
+    return true;
+  }
+  // The main executable has an empty name.
+  std::string path = object.path.empty() ? "/proc/self/exe" : object.path;
+  std::unique_ptr<File> file(OS::OpenFileForReading(path.c_str()));
+  if (file == nullptr) {
+    *error_msg = "Cannot open " + path;
+    return false;
+  }
+  SHA_CTX ctx;
+  SHA1_Init(&ctx);
+  std::vector<char> buffer(64 * KB);
+  int64_t offset = 0;
+  while (true) {
+    int64_t bytes_read = file->Read(buffer.data(), buffer.size(), offset);
+    if (bytes_read < 0) {
+      *error_msg = "Cannot read " + path;
+      return false;
+    }
+    if (bytes_read == 0) {
+      break;
+    }
+    SHA1_Update(&ctx, buffer.data(), bytes_read);
+    offset += bytes_read;
+  }
+  fingerprint->resize(SHA_DIGEST_LENGTH);
+  SHA1_Final(fingerprint->data(), &ctx);
+  return true;
+}
+
+CompilationCache::CompilationCache(CompilerDriver* driver,
+                                   const std::string& directory,
+                                   uint32_t image_file_location_oat_checksum)
+    : driver_(driver),
+      directory_(directory),
+      image_file_location_oat_checksum_(image_file_location_oat_checksum),
+      boot_class_path_(Runtime::Current()->GetClassLinker()->GetBootClassPath()),
+      enabled_(true),
+      num_hits_(0u) {
+  // The code also depends on the content of the profile, which is specific to a compilation
+  // and not part of the compiler configuration. Images embed the addresses of their objects.
+  const CompilerOptions& options = driver_->GetCompilerOptions();
+  std::string error_msg;
+  if (options.IsBootImage() || options.IsAppImage()) {
+    VLOG(compiler) << "Compilation cache disabled for images";
+    enabled_ = false;
+  } else if (driver_->GetProfileCompilationInfo() != nullptr) {
+    VLOG(compiler) << "Compilation cache disabled for profile guided compilation";
+    enabled_ = false;
+  } else if (!GetCompilerFingerprint(&compiler_fingerprint_, &error_msg)) {
+    VLOG(compiler) << "Compilation cache disabled: " << error_msg;
+    enabled_ = false;
+  }
+}
+
+CompilationCache::~CompilationCache() {}
+
+void CompilationCache::OpenEntries(jobject class_loader,
+                                   const std::vector<const DexFile*>& dex_files) {
+  if (!enabled_) {
+    return;
+  }
+  for (const DexFile* dex_file : dex_files) {
+    if (!IsSelfContained(class_loader, *dex_file)) {
+      VLOG(compiler) << "Not caching " << dex_file->GetLocation()
+                     << ", which depends on other dex files";
+      continue;
+    }
+    std::string error_msg;
+    std::unique_ptr<MemMap> map = MapEntry(*dex_file, &error_msg);
+    if (map != nullptr) {
+      entries_.emplace(dex_file, std::move(map));
+    } else {
+      VLOG(compiler) << "No compilation cache entry for " << dex_file->GetLocation()
+                     << ": " << error_msg;
+      missing_entries_.push_back(dex_file);
+    }
+  }
+}
+
+bool CompilationCache::IsSelfContained(jobject class_loader, const DexFile& dex_file) {
+  ClassLinker* class_linker = Runtime::Current()->GetClassLinker();
+  ScopedObjectAccess soa(Thread::Current());
+  StackHandleScope<2> hs(soa.Self());
+  Handle<mirror::ClassLoader> h_class_loader(
+      hs.NewHandle(soa.Decode<mirror::ClassLoader>(class_loader)));
+  Handle<mirror::DexCache> dex_cache(
+      hs.NewHandle(class_linker->FindDexCache(soa.Self(), dex_file)));
+  for (uint32_t i = 0, num_type_ids = dex_file.NumTypeIds(); i != num_type_ids; ++i) {
+    ObjPtr<mirror::Class> klass =
+        class_linker->ResolveType(dex_file, dex::TypeIndex(i), dex_cache, h_class_loader);
+    if (klass == nullptr) {
+      // Unresolved types may resolve to a class of another dex file at runtime.
+      soa.Self()->ClearException();
+      return false;
+    }
+    while (klass->IsArrayClass()) {
+      klass = klass->GetComponentType();
+    }
+    if (!klass->IsPrimitive() &&
+        klass->GetClassLoader() != nullptr &&
+        &klass->GetDexFile() != &dex_file) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::vector<uint8_t> CompilationCache::GetEntryKey(const DexFile& dex_file) const {
+  std::string configuration = IncrementalCompilation::GetCompilerConfiguration(*driver_);
+  bool generate_debug_info = driver_->GetCompilerOptions().GetGenerateDebugInfo();
+  SHA_CTX ctx;
+  SHA1_Init(&ctx);
+  SHA1_Update(&ctx, kMagic, sizeof(kMagic));
+  SHA1_Update(&ctx, kVersion, sizeof(kVersion));
+  SHA1_Update(&ctx, OatHeader::kOatVersion, sizeof(OatHeader::kOatVersion));
+  SHA1_Update(&ctx, compiler_fingerprint_.data(), compiler_fingerprint_.size());
+  SHA1_Update(&ctx, configuration.data(), configuration.size());
+  SHA1_Update(&ctx, &generate_debug_info, sizeof(generate_debug_info));
+  SHA1_Update(&ctx, &image_file_location_oat_checksum_, sizeof(image_file_location_oat_checksum_));
+  SHA1_Update(&ctx, dex_file.GetHeader().signature_, kSha1DigestSize);
+  std::vector<uint8_t> key(SHA_DIGEST_LENGTH);
+  SHA1_Final(key.data(), &ctx);
+  return key;
+}
+
+std::string CompilationCache::GetEntryFilename(const std::vector<uint8_t>& key) const {
+  static constexpr char kHexDigits[] = "0123456789abcdef";
+  std::string filename = directory_ + "/";
+  for (uint8_t value : key) {
+    filename += kHexDigits[value >> 4];
+    filename += kHexDigits[value & 0xfu];
+  }
+  return filename + ".methods";
+}
+
+std::unique_ptr<MemMap> CompilationCache::MapEntry(const DexFile& dex_file,
+                                                   std::string* error_msg) const {
+  std::vector<uint8_t> key = GetEntryKey(dex_file);
+  std::string filename = GetEntryFilename(key);
+  // Entries are renamed into place once complete, see StoreEntries().
+  std::unique_ptr<File> file(OS::OpenFileWithFlags(filename.c_str(),
+                                                   O_RDONLY | O_NOFOLLOW | O_CLOEXEC,
+                                                   /* auto_flush */ false));
+  if (file == nullptr) {
+    *error_msg = "Could not open " + filename + ": " + strerror(errno);
+    return nullptr;
+  }
+  int64_t length = file->GetLength();
+  if (length <= 0) {
+    *error_msg = "Empty entry " + filename;
+    return nullptr;
+  }
+  std::unique_ptr<MemMap> map(MemMap::MapFile(static_cast<size_t>(length),
+                                              PROT_READ,
+                                              MAP_PRIVATE,
+                                              file->Fd(),
+                                              /* start */ 0,
+                                              /* low_4gb */ false,
+                                              filename.c_str(),
+                                              error_msg));
+  if (map == nullptr) {
+    return nullptr;
+  }
+  if (!IsValidEntry(dex_file, key, map->Begin(), map->Size())) {
+    *error_msg = "Invalid entry " + filename;
+    return nullptr;
+  }
+  return map;
+}
+
+bool CompilationCache::IsValidEntry(const DexFile& dex_file,
+                                    const std::vector<uint8_t>& key,
+                                    const uint8_t* data,
+                                    size_t size) const {
+  if (size < sizeof(Header)) {
+    return false;
+  }
+  const Header* header = reinterpret_cast<const Header*>(data);
+  if (memcmp(header->magic, kMagic, sizeof(kMagic)) != 0 ||
+      memcmp(header->version, kVersion, sizeof(kVersion)) != 0 ||
+      memcmp(header->key, key.data(), SHA_DIGEST_LENGTH) != 0 ||
+      header->num_methods > (size - sizeof(Header)) / sizeof(MethodEntry)) {
+    return false;
+  }
+  uint8_t digest[SHA_DIGEST_LENGTH];
+  SHA1(data + sizeof(Header), size - sizeof(Header), digest);
+  if (memcmp(header->digest, digest, SHA_DIGEST_LENGTH) != 0) {
+    return false;
+  }
+  const MethodEntry* entries = reinterpret_cast<const MethodEntry*>(header + 1);
+  for (uint32_t i = 0; i != header->num_methods; ++i) {
+    const MethodEntry& entry = entries[i];
+    if (entry.method_idx >= dex_file.NumMethodIds() ||
+        (i != 0u && entry.method_idx <= entries[i - 1].method_idx) ||
+        !IsAligned<kAlignment>(entry.offset) ||
+        entry.offset > size ||
+        size - entry.offset < sizeof(MethodHeader)) {
+      return false;
+    }
+    const MethodHeader* method_header = reinterpret_cast<const MethodHeader*>(data + entry.offset);
+    uint64_t method_size = sizeof(MethodHeader) +
+        static_cast<uint64_t>(method_header->num_patches) * sizeof(PatchRecord) +
+        method_header->code_size +
+        method_header->method_info_size +
+        method_header->vmap_table_size +
+        method_header->cfi_info_size;
+    if (method_size > size - entry.offset) {
+      return false;
+    }
+    const PatchRecord* patches = reinterpret_cast<const PatchRecord*>(method_header + 1);
+    for (uint32_t j = 0; j != method_header->num_patches; ++j) {
+      const PatchRecord& patch = patches[j];
+      if (!IsValidPatchType(patch.type) || patch.literal_offset >= method_header->code_size) {
+        return false;
+      }
+      LinkerPatch::Type type = static_cast<LinkerPatch::Type>(patch.type);
+      if (type == LinkerPatch::Type::kBakerReadBarrierBranch) {
+        continue;
+      }
+      const DexFile* target_dex_file = GetTargetDexFile(dex_file, patch.value2);
+      if (target_dex_file == nullptr) {
+        return false;
+      }
+      size_t num_targets;
+      switch (type) {
+        case LinkerPatch::Type::kTypeRelative:
+        case LinkerPatch::Type::kTypeBssEntry:
+          num_targets = target_dex_file->NumTypeIds();
+          break;
+        case LinkerPatch::Type::kStringRelative:
+        case LinkerPatch::Type::kStringBssEntry:
+          num_targets = target_dex_file->NumStringIds();
+          break;
+        default:
+          num_targets = target_dex_file->NumMethodIds();
+          break;
+      }
+      if (patch.target_idx >= num_targets) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+int32_t CompilationCache::GetTargetDexFileIndex(const DexFile& dex_file,
+                                                const DexFile* target_dex_file) const {
+  if (target_dex_file == &dex_file) {
+    return 0;
+  }
+  auto it = std::find(boot_class_path_.begin(), boot_class_path_.end(), target_dex_file);
+  return (it != boot_class_path_.end()) ? 1 + std::distance(boot_class_path_.begin(), it) : -1;
+}
+
+const DexFile* CompilationCache::GetTargetDexFile(const DexFile& dex_file, uint32_t index) const {
+  if (index == 0u) {
+    return &dex_file;
+  }
+  return (index <= boot_class_path_.size()) ? boot_class_path_[index - 1u] : nullptr;
+}
+
+CompiledMethod* CompilationCache::GetCompiledMethod(MethodReference method_ref) {
+  auto entry_it = entries_.find(method_ref.dex_file);
+  if (entry_it == entries_.end()) {
+    return nullptr;
+  }
+  // The entry was validated by MapEntry().
+  const uint8_t* data = entry_it->second->Begin();
+  const Header* header = reinterpret_cast<const Header*>(data);
+  const MethodEntry* entries_begin = reinterpret_cast<const MethodEntry*>(header + 1);
+  const MethodEntry* entries_end = entries_begin + header->num_methods;
+  const MethodEntry* entry = std::lower_bound(
+      entries_begin,
+      entries_end,
+      method_ref.dex_method_index,
+      [](const MethodEntry& lhs, uint32_t method_idx) { return lhs.method_idx < method_idx; });
+  if (entry == entries_end || entry->method_idx != method_ref.dex_method_index) {
+    return nullptr;
+  }
+
+  const MethodHeader* method_header = reinterpret_cast<const MethodHeader*>(data + entry->offset);
+  const PatchRecord* patch_records = reinterpret_cast<const PatchRecord*>(method_header + 1);
+  std::vector<LinkerPatch> patches;
+  patches.reserve(method_header->num_patches);
+  for (uint32_t i = 0; i != method_header->num_patches; ++i) {
+    const PatchRecord& record = patch_records[i];
+    LinkerPatch::Type type = static_cast<LinkerPatch::Type>(record.type);
+    const DexFile* target_dex_file = (type != LinkerPatch::Type::kBakerReadBarrierBranch)
+        ? GetTargetDexFile(*method_ref.dex_file, record.value2)
+        : nullptr;
+    patches.push_back(IncrementalCompilation::DecodePatch(type,
+                                                          record.literal_offset,
+                                                          record.value1,
+                                                          target_dex_file,
+                                                          record.value2,
+                                                          record.target_idx));
+  }
+  const uint8_t* ptr = reinterpret_cast<const uint8_t*>(patch_records + method_header->num_patches);
+  ArrayRef<const uint8_t> code(ptr, method_header->code_size);
+  ptr += method_header->code_size;
+  ArrayRef<const uint8_t> method_info(ptr, method_header->method_info_size);
+  ptr += method_header->method_info_size;
+  ArrayRef<const uint8_t> vmap_table(ptr, method_header->vmap_table_size);
+  ptr += method_header->vmap_table_size;
+  ArrayRef<const uint8_t> cfi_info(ptr, method_header->cfi_info_size);
+
+  CompiledMethod* compiled_method = CompiledMethod::SwapAllocCompiledMethod(
+      driver_,
+      driver_->GetInstructionSet(),
+      code,
+      method_header->frame_size_in_bytes,
+      method_header->core_spill_mask,
+      method_header->fp_spill_mask,
+      method_info,
+      vmap_table,
+      cfi_info,
+      ArrayRef<const LinkerPatch>(patches));
+  num_hits_.FetchAndAddRelaxed(1u);
+  return compiled_method;
+}
+
+bool CompilationCache::EncodeMethod(const DexFile& dex_file,
+                                    const CompiledMethod* compiled_method,
+                                    std::vector<uint8_t>* out) const {
+  MethodHeader method_header;
+  method_header.frame_size_in_bytes = compiled_method->GetFrameSizeInBytes();
+  method_header.core_spill_mask = compiled_method->GetCoreSpillMask();
+  method_header.fp_spill_mask = compiled_method->GetFpSpillMask();
+  method_header.num_patches = compiled_method->GetPatches().size();
+  method_header.code_size = compiled_method->GetQuickCode().size();
+  method_header.method_info_size = compiled_method->GetMethodInfo().size();
+  method_header.vmap_table_size = compiled_method->GetVmapTable().size();
+  method_header.cfi_info_size = compiled_method->GetCFIInfo().size();
+  Append(out, method_header);
+
+  for (const LinkerPatch& patch : compiled_method->GetPatches()) {
+    PatchRecord record;
+    record.type = static_cast<uint32_t>(patch.GetType());
+    record.literal_offset = patch.LiteralOffset();
+    record.value1 = 0u;
+    record.value2 = 0u;
+    record.target_idx = 0u;
+    const DexFile* target_dex_file = nullptr;
+    switch (patch.GetType()) {
+      case LinkerPatch::Type::kMethodRelative:
+      case LinkerPatch::Type::kMethodBssEntry:
+      case LinkerPatch::Type::kCall:
+      case LinkerPatch::Type::kCallRelative:
+        if (patch.IsPcRelative() && patch.GetType() != LinkerPatch::Type::kCallRelative) {
+          record.value1 = patch.PcInsnOffset();
+        }
+        target_dex_file = patch.TargetMethod().dex_file;
+        record.target_idx = patch.TargetMethod().dex_method_index;
+        break;
+      case LinkerPatch::Type::kTypeRelative:
+      case LinkerPatch::Type::kTypeBssEntry:
+        record.value1 = patch.PcInsnOffset();
+        target_dex_file = patch.TargetTypeDexFile();
+        record.target_idx = patch.TargetTypeIndex().index_;
+        break;
+      case LinkerPatch::Type::kStringRelative:
+      case LinkerPatch::Type::kStringBssEntry:
+        record.value1 = patch.PcInsnOffset();
+        target_dex_file = patch.TargetStringDexFile();
+        record.target_idx = patch.TargetStringIndex().index_;
+        break;
+      case LinkerPatch::Type::kBakerReadBarrierBranch:
+        record.value1 = patch.GetBakerCustomValue1();
+        record.value2 = patch.GetBakerCustomValue2();
+        break;
+    }
+    if (target_dex_file != nullptr) {
+      int32_t target_dex_index = GetTargetDexFileIndex(dex_file, target_dex_file);
+      if (target_dex_index < 0) {
+        return false;
+      }
+      record.value2 = target_dex_index;
+    }
+    Append(out, record);
+  }
+
+  Append(out, compiled_method->GetQuickCode());
+  Append(out, compiled_method->GetMethodInfo());
+  Append(out, compiled_method->GetVmapTable());
+  Append(out, compiled_method->GetCFIInfo());
+  out->resize(RoundUp(out->size(), kAlignment), 0u);
+  return true;
+}
+
+void CompilationCache::StoreEntries(const std::vector<const DexFile*>& dex_files) {
+  for (const DexFile* dex_file : missing_entries_) {
+    if (std::find(dex_files.begin(), dex_files.end(), dex_file) == dex_files.end()) {
+      continue;
+    }
+    // Another process may have written the entry since we looked it up.
+    std::string error_msg;
+    if (MapEntry(*dex_file, &error_msg) != nullptr) {
+      continue;
+    }
+
+    // Collect the methods compiled by the optimizing compiler, whose code has a CodeInfo.
+    std::vector<std::pair<uint32_t, std::vector<uint8_t>>> methods;
+    for (uint32_t i = 0, num_class_defs = dex_file->NumClassDefs(); i != num_class_defs; ++i) {
+      const uint8_t* class_data = dex_file->GetClassData(dex_file->GetClassDef(i));
+      if (class_data == nullptr) {
+        continue;
+      }
+      ClassDataItemIterator it(*dex_file, class_data);
+      it.SkipAllFields();
+      for (; it.HasNext(); it.Next()) {
+        if (it.GetMethodCodeItem() == nullptr) {
+          continue;
+        }
+        const CompiledMethod* compiled_method =
+            driver_->GetCompiledMethod(MethodReference(dex_file, it.GetMemberIndex()));
+        if (compiled_method == nullptr ||
+            compiled_method->GetQuickCode().empty() ||
+            compiled_method->GetVmapTable().empty()) {
+          continue;
+        }
+        std::vector<uint8_t> method_data;
+        if (EncodeMethod(*dex_file, compiled_method, &method_data)) {
+          methods.emplace_back(it.GetMemberIndex(), std::move(method_data));
+        }
+      }
+    }
+    std::sort(methods.begin(),
+              methods.end(),
+              [](const std::pair<uint32_t, std::vector<uint8_t>>& lhs,
+                 const std::pair<uint32_t, std::vector<uint8_t>>& rhs) {
+                return lhs.first < rhs.first;
+              });
+
+    std::vector<uint8_t> contents;
+    uint32_t offset = sizeof(Header) + methods.size() * sizeof(MethodEntry);
+    for (const auto& method : methods) {
+      Append(&contents, MethodEntry { method.first, offset });
+      offset += method.second.size();
+    }
+    for (const auto& method : methods) {
+      Append(&contents, ArrayRef<const uint8_t>(method.second));
+    }
+    std::vector<uint8_t> key = GetEntryKey(*dex_file);
+    Header header;
+    std::copy_n(kMagic, sizeof(kMagic), header.magic);
+    std::copy_n(kVersion, sizeof(kVersion), header.version);
+    std::copy_n(key.data(), SHA_DIGEST_LENGTH, header.key);
+    SHA1(contents.data(), contents.size(), header.digest);
+    header.num_methods = methods.size();
+    std::vector<uint8_t> buffer;
+    Append(&buffer, header);
+    Append(&buffer, ArrayRef<const uint8_t>(contents));
+
+    // Write a temporary file and rename it to the entry, which atomically replaces an invalid
+    // entry. Other processes only see complete entries, and keep their mappings of the old one.
+    std::string filename = GetEntryFilename(key);
+    std::string temp_filename = filename + ".XXXXXX";
+    int fd = mkstemp(&temp_filename[0]);
+    if (fd == -1) {
+      PLOG(WARNING) << "Could not create compilation cache entry " << temp_filename;
+      continue;
+    }
+    File temp_file(fd, temp_filename, /* check_usage */ true);
+    if (fchmod(fd, 0640) != 0 ||
+        !temp_file.WriteFully(buffer.data(), buffer.size()) ||
+        temp_file.Flush() != 0) {
+      PLOG(WARNING) << "Could not write compilation cache entry " << temp_filename;
+      temp_file.Erase(/* unlink */ true);
+      continue;
+    }
+    if (temp_file.Close() != 0 || rename(temp_filename.c_str(), filename.c_str()) != 0) {
+      PLOG(WARNING) << "Could not rename compilation cache entry to " << filename;
+      unlink(temp_filename.c_str());
+      continue;
+    }
+    VLOG(compiler) << "Wrote compilation cache entry " << filename << " for "
+                   << dex_file->GetLocation() << " with " << methods.size() << " methods";
+  }
+  missing_entries_.clear();
+}
+
+}  // namespace art
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_DRIVER_COMPILATION_CACHE_H_
+#define ART_COMPILER_DRIVER_COMPILATION_CACHE_H_
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "atomic.h"
+#include "base/macros.h"
+#include "base/mutex.h"
+#include "jni.h"
+#include "method_reference.h"
+
+namespace art {
+
+class CompiledMethod;
+class CompilerDriver;
+class DexFile;
+class MemMap;
+
+// On-disk cache of the methods compiled by the optimizing compiler, shared by dex2oat
+// processes compiling the same dex file, e.g. a library embedded in many apps.
+//
+// The cache holds one file per dex file content and compiler configuration, named after
+// the digest of the signature of the dex file, the compiler options, the oat version, the
+// build of the compiler and the boot image checksum. The code of a method only depends on
+// these if all the types referenced by its dex file resolve to classes of the dex file or of
+// the boot class path, which is checked before compiling the dex file. Entries are written to a temporary file renamed into place,
+// so that other processes never map a partial entry, and hold a digest of their contents,
+// checked before they are used. They are then mapped read-only by later compilations.
+class CompilationCache {
+ public:
+  CompilationCache(CompilerDriver* driver,
+                   const std::string& directory,
+                   uint32_t image_file_location_oat_checksum);
+  ~CompilationCache();
+
+  // Map the cache entries of the dex files that can use the cache. Must be called before
+  // compiling the dex files.
+  void OpenEntries(jobject class_loader, const std::vector<const DexFile*>& dex_files)
+      REQUIRES(!Locks::mutator_lock_);
+
+  // Return a copy of the cached code of the method, or null if it is not cached. May be
+  // called concurrently from the compiler threads.
+  CompiledMethod* GetCompiledMethod(MethodReference method_ref);
+
+  // Write the cache entries missing for the dex files, once compiled.
+  void StoreEntries(const std::vector<const DexFile*>& dex_files);
+
+  size_t GetNumberOfHits() const {
+    return num_hits_.LoadRelaxed();
+  }
+
+ private:
+  struct Header;
+  struct MethodEntry;
+  struct MethodHeader;
+  struct PatchRecord;
+
+  static constexpr uint8_t kMagic[] = { 'c', 'm', 'c', '\n' };
+  static constexpr uint8_t kVersion[] = { '0', '0', '2', '\0' };
+
+  // Return whether the types referenced by the dex file all resolve to its own classes or
+  // to the boot class path.
+  bool IsSelfContained(jobject class_loader, const DexFile& dex_file)
+      REQUIRES(!Locks::mutator_lock_);
+
+  // Return the digest identifying the entry of the dex file, which also names its file.
+  std::vector<uint8_t> GetEntryKey(const DexFile& dex_file) const;
+  std::string GetEntryFilename(const std::vector<uint8_t>& key) const;
+
+  // Map the entry of the dex file. Returns null if it does not exist or is not valid.
+  std::unique_ptr<MemMap> MapEntry(const DexFile& dex_file, std::string* error_msg) const;
+
+  // Return whether `data` holds a valid entry for the dex file.
+  bool IsValidEntry(const DexFile& dex_file,
+                    const std::vector<uint8_t>& key,
+                    const uint8_t* data,
+                    size_t size) const;
+
+  // Return the index of a target dex file in the entries: 0 for the dex file of the entry,
+  // and 1 + its index in the boot class path otherwise. Returns -1 for other dex files.
+  int32_t GetTargetDexFileIndex(const DexFile& dex_file, const DexFile* target_dex_file) const;
+  const DexFile* GetTargetDexFile(const DexFile& dex_file, uint32_t index) const;
+
+  // Append the record of a compiled method to `out`. Returns false if it cannot be cached.
+  bool EncodeMethod(const DexFile& dex_file,
+                    const CompiledMethod* compiled_method,
+                    std::vector<uint8_t>* out) const;
+
+  CompilerDriver* const driver_;
+  const std::string directory_;
+  const uint32_t image_file_location_oat_checksum_;
+  const std::vector<const DexFile*>& boot_class_path_;
+
+  // Identifies the build of the compiler, whose code generation may change without any
+  // change of the oat version.
+  std::vector<uint8_t> compiler_fingerprint_;
+
+  // Whether the compilation options allow using the cache.
+  bool enabled_;
+
+  // Mapped entries of the dex files being compiled, and dex files whose entry is missing.
+  // Only modified before and after compiling the dex files.
+  std::unordered_map<const DexFile*, std::unique_ptr<MemMap>> entries_;
+  std::vector<const DexFile*> missing_entries_;
+
+  Atomic<size_t> num_hits_;
+
+  DISALLOW_COPY_AND_ASSIGN(CompilationCache);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_DRIVER_COMPILATION_CACHE_H_
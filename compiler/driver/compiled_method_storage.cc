@@ -189,6 +189,10 @@ void CompiledMethodStorage::DumpMemoryUsage(std::ostream& os, bool extended) con
   if (swap_space_.get() != nullptr) {
     const size_t swap_size = swap_space_->GetSize();
     os << " swap=" << PrettySize(swap_size) << " (" << swap_size << "B)";
+    const size_t num_releases = swap_space_->GetNumberOfReleases();
+    if (num_releases != 0u) {
+      os << " swap releases=" << num_releases;
+    }
   }
   if (extended) {
     Thread* self = Thread::Current();
@@ -198,6 +202,18 @@ void CompiledMethodStorage::DumpMemoryUsage(std::ostream& os, bool extended) con
   }
 }
 
+void CompiledMethodStorage::SetSwapMemoryLimit(size_t memory_limit) {
+  if (swap_space_.get() != nullptr) {
+    swap_space_->SetMemoryLimit(memory_limit);
+  }
+}
+
+void CompiledMethodStorage::RecordAccess(size_t size) const {
+  if (swap_space_.get() != nullptr) {
+    swap_space_->RecordAccess(size);
+  }
+}
+
 const LengthPrefixedArray<uint8_t>* CompiledMethodStorage::DeduplicateCode(
     const ArrayRef<const uint8_t>& code) {
   return AllocateOrDeduplicateArray(code, &dedupe_code_);
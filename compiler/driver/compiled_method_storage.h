@@ -44,10 +44,16 @@ class CompiledMethodStorage {
     return dedupe_enabled_;
   }
 
-  SwapAllocator<void> GetSwapSpaceAllocator() {
+  SwapAllocator<void> GetSwapSpaceAllocator() const {
     return SwapAllocator<void>(swap_space_.get());
   }
 
+  // Bound the memory used for the swap space, if any. See SwapSpace::SetMemoryLimit().
+  void SetSwapMemoryLimit(size_t memory_limit);
+
+  // Record that `size` bytes of compiled method data were read back, e.g. to write them out.
+  void RecordAccess(size_t size) const;
+
   const LengthPrefixedArray<uint8_t>* DeduplicateCode(const ArrayRef<const uint8_t>& code);
   void ReleaseCode(const LengthPrefixedArray<uint8_t>* code);
 
@@ -16,7 +16,9 @@
 
 #include "compiler_driver.h"
 
+#include <sys/resource.h>
 #include <unistd.h>
+#include <algorithm>
 #include <unordered_set>
 #include <vector>
 
@@ -47,13 +49,17 @@
 #include "dex_compilation_unit.h"
 #include "dex_file-inl.h"
 #include "dex_instruction-inl.h"
+#include "driver/compilation_cache.h"
 #include "driver/compiler_options.h"
+#include "driver/incremental_compilation.h"
+#include "driver/work_stealing_queue.h"
 #include "gc/accounting/card_table-inl.h"
 #include "gc/accounting/heap_bitmap.h"
 #include "gc/space/image_space.h"
 #include "gc/space/space.h"
 #include "handle_scope-inl.h"
 #include "intrinsics_enum.h"
+#include "java_vm_ext.h"
 #include "jni_internal.h"
 #include "mirror/class-inl.h"
 #include "mirror/class_loader.h"
@@ -304,6 +310,8 @@ CompilerDriver::CompilerDriver(
       compiler_context_(nullptr),
       support_boot_image_fixup_(true),
       compiled_method_storage_(swap_fd),
+      incremental_compilation_(nullptr),
+      compilation_cache_(nullptr),
       profile_compilation_info_(profile_compilation_info),
       max_arena_alloc_(0),
       dex_to_dex_references_lock_("dex-to-dex references lock"),
@@ -589,7 +597,14 @@ static void CompileMethod(Thread* self,
         driver->IsMethodToCompile(method_ref) &&
         driver->ShouldCompileBasedOnProfile(method_ref);
 
-    if (compile) {
+    if (compile && driver->GetIncrementalCompilation() != nullptr) {
+      compiled_method =
+          driver->GetIncrementalCompilation()->ReuseCompiledMethod(method_ref, class_def_idx);
+    }
+    if (compile && compiled_method == nullptr && driver->GetCompilationCache() != nullptr) {
+      compiled_method = driver->GetCompilationCache()->GetCompiledMethod(method_ref);
+    }
+    if (compile && compiled_method == nullptr) {
       // NOTE: if compiler declines to compile this method, it will return null.
       compiled_method = driver->GetCompiler()->Compile(code_item,
                                                        access_flags,
@@ -1512,11 +1527,18 @@ class ParallelCompilationManager {
     : index_(0),
       class_linker_(class_linker),
       class_loader_(class_loader),
+      dex_cache_(nullptr),
       compiler_(compiler),
       dex_file_(dex_file),
       dex_files_(dex_files),
       thread_pool_(thread_pool) {}
 
+  ~ParallelCompilationManager() {
+    if (dex_cache_ != nullptr) {
+      Thread::Current()->GetJniEnv()->DeleteGlobalRef(dex_cache_);
+    }
+  }
+
   ClassLinker* GetClassLinker() const {
     CHECK(class_linker_ != nullptr);
     return class_linker_;
@@ -1526,6 +1548,20 @@ class ParallelCompilationManager {
     return class_loader_;
   }
 
+  // Looks up the dex cache of the dex file once, for the visitors that need it for every work
+  // item. FindDexCache() takes the dex lock, which the work units would contend on.
+  void FindDexCache() REQUIRES(!Locks::mutator_lock_) {
+    DCHECK(dex_cache_ == nullptr);
+    ScopedObjectAccess soa(Thread::Current());
+    ObjPtr<mirror::DexCache> dex_cache = GetClassLinker()->FindDexCache(soa.Self(), *GetDexFile());
+    dex_cache_ = soa.Vm()->AddGlobalRef(soa.Self(), dex_cache);
+  }
+
+  jobject GetDexCache() const {
+    CHECK(dex_cache_ != nullptr);
+    return dex_cache_;
+  }
+
   CompilerDriver* GetCompiler() const {
     CHECK(compiler_ != nullptr);
     return compiler_;
@@ -1550,6 +1586,36 @@ class ParallelCompilationManager {
     for (size_t i = 0; i < work_units; ++i) {
       thread_pool_->AddTask(self, new ForAllClosure(this, end, visitor));
     }
+    RunTasks(self);
+  }
+
+  // Like ForAll, for indices of work items sorted by decreasing cost. The indices are dealt in
+  // turn to one queue per work unit, so that each work unit starts with expensive items. A work
+  // unit that emptied its queue steals the cheapest items left in the other queues, so that the
+  // workers only idle at the end, once all the work has been taken.
+  void ForAllWithWorkStealing(size_t begin,
+                              size_t end,
+                              CompilationVisitor* visitor,
+                              size_t work_units)
+      REQUIRES(!*Locks::mutator_lock_) {
+    Thread* self = Thread::Current();
+    self->AssertNoPendingException();
+    CHECK_GT(work_units, 0U);
+
+    std::vector<WorkStealingQueue> queues(work_units);
+    WorkStealingQueue::Distribute(begin, end, &queues);
+    for (size_t i = 0; i < work_units; ++i) {
+      thread_pool_->AddTask(self, new WorkStealingClosure(&queues, i, visitor));
+    }
+    RunTasks(self);
+  }
+
+  size_t NextIndex() {
+    return index_.FetchAndAddSequentiallyConsistent(1);
+  }
+
+ private:
+  void RunTasks(Thread* self) REQUIRES(!*Locks::mutator_lock_) {
     thread_pool_->StartWorkers(self);
 
     // Ensure we're suspended while we're blocked waiting for the other threads to finish (worker
@@ -1563,11 +1629,32 @@ class ParallelCompilationManager {
     thread_pool_->StopWorkers(self);
   }
 
-  size_t NextIndex() {
-    return index_.FetchAndAddSequentiallyConsistent(1);
-  }
+  class WorkStealingClosure : public Task {
+   public:
+    WorkStealingClosure(std::vector<WorkStealingQueue>* queues,
+                        size_t queue,
+                        CompilationVisitor* visitor)
+        : queues_(queues),
+          queue_(queue),
+          visitor_(visitor) {}
+
+    virtual void Run(Thread* self) {
+      WorkStealingQueue::Drain(queues_, queue_, [&](size_t index) {
+        visitor_->Visit(index);
+        self->AssertNoPendingException();
+      });
+    }
+
+    virtual void Finalize() {
+      delete this;
+    }
+
+   private:
+    std::vector<WorkStealingQueue>* const queues_;
+    const size_t queue_;
+    CompilationVisitor* const visitor_;
+  };
 
- private:
   class ForAllClosure : public Task {
    public:
     ForAllClosure(ParallelCompilationManager* manager, size_t end, CompilationVisitor* visitor)
@@ -1599,6 +1686,7 @@ class ParallelCompilationManager {
   AtomicInteger index_;
   ClassLinker* const class_linker_;
   const jobject class_loader_;
+  jobject dex_cache_;
   CompilerDriver* const compiler_;
   const DexFile* const dex_file_;
   const std::vector<const DexFile*>& dex_files_;
@@ -2702,6 +2790,10 @@ void CompilerDriver::Compile(jobject class_loader,
     dex_to_dex_references_.clear();
   }
 
+  if (compilation_cache_ != nullptr) {
+    compilation_cache_->OpenEntries(class_loader, dex_files);
+  }
+
   for (const DexFile* dex_file : dex_files) {
     CHECK(dex_file != nullptr);
     CompileDexFile(class_loader,
@@ -2734,12 +2826,36 @@ void CompilerDriver::Compile(jobject class_loader,
   }
   current_dex_to_dex_methods_ = nullptr;
 
+  if (compilation_cache_ != nullptr) {
+    compilation_cache_->StoreEntries(dex_files);
+  }
+
   VLOG(compiler) << "Compile: " << GetMemoryUsageString(false);
 }
 
-class CompileClassVisitor : public CompilationVisitor {
+// A method to compile, along with the properties of its class.
+struct MethodToCompile {
+  const DexFile::CodeItem* code_item;
+  uint32_t access_flags;
+  InvokeType invoke_type;
+  uint16_t class_def_index;
+  uint32_t method_idx;
+  optimizer::DexToDexCompilationLevel dex_to_dex_compilation_level;
+  bool compilation_enabled;
+
+  // Estimate of the compilation cost, used to compile the most expensive methods first.
+  size_t EstimatedCost() const {
+    return (code_item != nullptr) ? code_item->insns_size_in_code_units_ : 0u;
+  }
+};
+
+// Collects the methods to compile of each class. The compilation is scheduled per method,
+// so that a large class does not leave a worker compiling long after the others are done.
+class CollectMethodsToCompileVisitor : public CompilationVisitor {
  public:
-  explicit CompileClassVisitor(const ParallelCompilationManager* manager) : manager_(manager) {}
+  CollectMethodsToCompileVisitor(const ParallelCompilationManager* manager,
+                                 std::vector<std::vector<MethodToCompile>>* class_methods)
+      : manager_(manager), class_methods_(class_methods) {}
 
   virtual void Visit(size_t class_def_index) REQUIRES(!Locks::mutator_lock_) OVERRIDE {
     ATRACE_CALL();
@@ -2755,20 +2871,16 @@ class CompileClassVisitor : public CompilationVisitor {
     // Use a scoped object access to perform to the quick SkipClass check.
     const char* descriptor = dex_file.GetClassDescriptor(class_def);
     ScopedObjectAccess soa(Thread::Current());
-    StackHandleScope<3> hs(soa.Self());
+    StackHandleScope<2> hs(soa.Self());
     Handle<mirror::ClassLoader> class_loader(
         hs.NewHandle(soa.Decode<mirror::ClassLoader>(jclass_loader)));
     Handle<mirror::Class> klass(
         hs.NewHandle(class_linker->FindClass(soa.Self(), descriptor, class_loader)));
-    Handle<mirror::DexCache> dex_cache;
     if (klass == nullptr) {
       soa.Self()->AssertPendingException();
       soa.Self()->ClearException();
-      dex_cache = hs.NewHandle(class_linker->FindDexCache(soa.Self(), dex_file));
     } else if (SkipClass(jclass_loader, dex_file, klass.Get())) {
       return;
-    } else {
-      dex_cache = hs.NewHandle(klass->GetDexCache());
     }
 
     const uint8_t* class_data = dex_file.GetClassData(class_def);
@@ -2777,7 +2889,7 @@ class CompileClassVisitor : public CompilationVisitor {
       return;
     }
 
-    // Go to native so that we don't block GC during compilation.
+    // Go to native so that we don't block GC.
     ScopedThreadSuspension sts(soa.Self(), kNative);
 
     CompilerDriver* const driver = manager_->GetCompiler();
@@ -2792,7 +2904,8 @@ class CompileClassVisitor : public CompilationVisitor {
     bool compilation_enabled = driver->IsClassToCompile(
         dex_file.StringByTypeIdx(class_def.class_idx_));
 
-    // Compile direct methods
+    std::vector<MethodToCompile>* methods = &(*class_methods_)[class_def_index];
+    // Direct methods
     int64_t previous_direct_method_idx = -1;
     while (it.HasNextDirectMethod()) {
       uint32_t method_idx = it.GetMemberIndex();
@@ -2803,21 +2916,16 @@ class CompileClassVisitor : public CompilationVisitor {
         continue;
       }
       previous_direct_method_idx = method_idx;
-      CompileMethod(soa.Self(),
-                    driver,
-                    it.GetMethodCodeItem(),
-                    it.GetMethodAccessFlags(),
-                    it.GetMethodInvokeType(class_def),
-                    class_def_index,
-                    method_idx,
-                    class_loader,
-                    dex_file,
-                    dex_to_dex_compilation_level,
-                    compilation_enabled,
-                    dex_cache);
+      methods->push_back({it.GetMethodCodeItem(),
+                          it.GetMethodAccessFlags(),
+                          it.GetMethodInvokeType(class_def),
+                          dchecked_integral_cast<uint16_t>(class_def_index),
+                          method_idx,
+                          dex_to_dex_compilation_level,
+                          compilation_enabled});
       it.Next();
     }
-    // Compile virtual methods
+    // Virtual methods
     int64_t previous_virtual_method_idx = -1;
     while (it.HasNextVirtualMethod()) {
       uint32_t method_idx = it.GetMemberIndex();
@@ -2828,17 +2936,13 @@ class CompileClassVisitor : public CompilationVisitor {
         continue;
       }
       previous_virtual_method_idx = method_idx;
-      CompileMethod(soa.Self(),
-                    driver, it.GetMethodCodeItem(),
-                    it.GetMethodAccessFlags(),
-                    it.GetMethodInvokeType(class_def),
-                    class_def_index,
-                    method_idx,
-                    class_loader,
-                    dex_file,
-                    dex_to_dex_compilation_level,
-                    compilation_enabled,
-                    dex_cache);
+      methods->push_back({it.GetMethodCodeItem(),
+                          it.GetMethodAccessFlags(),
+                          it.GetMethodInvokeType(class_def),
+                          dchecked_integral_cast<uint16_t>(class_def_index),
+                          method_idx,
+                          dex_to_dex_compilation_level,
+                          compilation_enabled});
       it.Next();
     }
     DCHECK(!it.HasNext());
@@ -2846,6 +2950,46 @@ class CompileClassVisitor : public CompilationVisitor {
 
  private:
   const ParallelCompilationManager* const manager_;
+  std::vector<std::vector<MethodToCompile>>* const class_methods_;
+};
+
+class CompileMethodVisitor : public CompilationVisitor {
+ public:
+  CompileMethodVisitor(const ParallelCompilationManager* manager,
+                       const std::vector<MethodToCompile>* methods)
+      : manager_(manager), methods_(methods) {}
+
+  virtual void Visit(size_t index) REQUIRES(!Locks::mutator_lock_) OVERRIDE {
+    ATRACE_CALL();
+    const MethodToCompile& method = (*methods_)[index];
+    const DexFile& dex_file = *manager_->GetDexFile();
+    ScopedObjectAccess soa(Thread::Current());
+    StackHandleScope<2> hs(soa.Self());
+    Handle<mirror::ClassLoader> class_loader(
+        hs.NewHandle(soa.Decode<mirror::ClassLoader>(manager_->GetClassLoader())));
+    Handle<mirror::DexCache> dex_cache(
+        hs.NewHandle(soa.Decode<mirror::DexCache>(manager_->GetDexCache())));
+
+    // Go to native so that we don't block GC during compilation.
+    ScopedThreadSuspension sts(soa.Self(), kNative);
+
+    CompileMethod(soa.Self(),
+                  manager_->GetCompiler(),
+                  method.code_item,
+                  method.access_flags,
+                  method.invoke_type,
+                  method.class_def_index,
+                  method.method_idx,
+                  class_loader,
+                  dex_file,
+                  method.dex_to_dex_compilation_level,
+                  method.compilation_enabled,
+                  dex_cache);
+  }
+
+ private:
+  const ParallelCompilationManager* const manager_;
+  const std::vector<MethodToCompile>* const methods_;
 };
 
 void CompilerDriver::CompileDexFile(jobject class_loader,
@@ -2857,8 +3001,27 @@ void CompilerDriver::CompileDexFile(jobject class_loader,
   TimingLogger::ScopedTiming t("Compile Dex File", timings);
   ParallelCompilationManager context(Runtime::Current()->GetClassLinker(), class_loader, this,
                                      &dex_file, dex_files, thread_pool);
-  CompileClassVisitor visitor(&context);
-  context.ForAll(0, dex_file.NumClassDefs(), &visitor, thread_count);
+  std::vector<std::vector<MethodToCompile>> class_methods(dex_file.NumClassDefs());
+  {
+    CollectMethodsToCompileVisitor visitor(&context, &class_methods);
+    context.ForAll(0, dex_file.NumClassDefs(), &visitor, thread_count);
+  }
+  std::vector<MethodToCompile> methods;
+  for (std::vector<MethodToCompile>& methods_of_class : class_methods) {
+    methods.insert(methods.end(), methods_of_class.begin(), methods_of_class.end());
+    methods_of_class.clear();
+    methods_of_class.shrink_to_fit();
+  }
+  // Start with the most expensive methods, so that the last methods compiled are short and
+  // the workers finish together. Keep the class definition order otherwise, for determinism.
+  std::stable_sort(methods.begin(),
+                   methods.end(),
+                   [](const MethodToCompile& lhs, const MethodToCompile& rhs) {
+                     return lhs.EstimatedCost() > rhs.EstimatedCost();
+                   });
+  context.FindDexCache();
+  CompileMethodVisitor visitor(&context, &methods);
+  context.ForAllWithWorkStealing(0, methods.size(), &visitor, thread_count);
 }
 
 void CompilerDriver::AddCompiledMethod(const MethodReference& method_ref,
@@ -3002,6 +3165,12 @@ std::string CompilerDriver::GetMemoryUsageString(bool extended) const {
   const size_t free_space = static_cast<size_t>(info.fordblks);
   oss << " native alloc=" << PrettySize(allocated_space) << " (" << allocated_space << "B)"
       << " free=" << PrettySize(free_space) << " (" << free_space << "B)";
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    // The maximum resident set size is reported in kilobytes.
+    const size_t peak_rss = static_cast<size_t>(usage.ru_maxrss) * KB;
+    oss << " peak rss=" << PrettySize(peak_rss) << " (" << peak_rss << "B)";
+  }
 #endif
   compiled_method_storage_.DumpMemoryUsage(oss, extended);
   return oss.str();
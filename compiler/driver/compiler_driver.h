@@ -56,9 +56,11 @@ class VerifierDepsTest;
 }  // namespace verifier
 
 class BitVector;
+class CompilationCache;
 class CompiledMethod;
 class CompilerOptions;
 class DexCompilationUnit;
+class IncrementalCompilation;
 struct InlineIGetIPutData;
 class InstructionSetFeatures;
 class InternTable;
@@ -112,6 +114,24 @@ class CompilerDriver {
     return ArrayRef<const DexFile* const>(dex_files_for_oat_file_);
   }
 
+  // Set the reuse of the code of a previous oat file, or null.
+  void SetIncrementalCompilation(IncrementalCompilation* incremental_compilation) {
+    incremental_compilation_ = incremental_compilation;
+  }
+
+  IncrementalCompilation* GetIncrementalCompilation() const {
+    return incremental_compilation_;
+  }
+
+  // Set the on-disk cache of compiled methods, or null.
+  void SetCompilationCache(CompilationCache* compilation_cache) {
+    compilation_cache_ = compilation_cache;
+  }
+
+  CompilationCache* GetCompilationCache() const {
+    return compilation_cache_;
+  }
+
   void CompileAll(jobject class_loader,
                   const std::vector<const DexFile*>& dex_files,
                   TimingLogger* timings)
@@ -357,6 +377,10 @@ class CompilerDriver {
     return &compiled_method_storage_;
   }
 
+  const CompiledMethodStorage* GetCompiledMethodStorage() const {
+    return &compiled_method_storage_;
+  }
+
   // Can we assume that the klass is loaded?
   bool CanAssumeClassIsLoaded(mirror::Class* klass)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -544,6 +568,12 @@ class CompilerDriver {
 
   CompiledMethodStorage compiled_method_storage_;
 
+  // Reuse of the code of a previous oat file, or null.
+  IncrementalCompilation* incremental_compilation_;
+
+  // On-disk cache of compiled methods, or null.
+  CompilationCache* compilation_cache_;
+
   // Info for profile guided compilation.
   const ProfileCompilationInfo* const profile_compilation_info_;
 
@@ -558,7 +588,7 @@ class CompilerDriver {
   // indexes for dex-to-dex compilation in the current dex file.
   const BitVector* current_dex_to_dex_methods_;
 
-  friend class CompileClassVisitor;
+  friend class CollectMethodsToCompileVisitor;
   friend class DexToDexDecompilerTest;
   friend class verifier::VerifierDepsTest;
   DISALLOW_COPY_AND_ASSIGN(CompilerDriver);
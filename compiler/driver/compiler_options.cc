@@ -30,6 +30,7 @@ CompilerOptions::CompilerOptions()
       tiny_method_threshold_(kDefaultTinyMethodThreshold),
       num_dex_methods_threshold_(kDefaultNumDexMethodsThreshold),
       inline_max_code_units_(kUnsetInlineMaxCodeUnits),
+      loop_unroll_max_instructions_(kDefaultLoopUnrollMaxInstructions),
       no_inline_from_(nullptr),
       boot_image_(false),
       core_image_(false),
@@ -50,6 +51,7 @@ CompilerOptions::CompilerOptions()
       dump_cfg_append_(false),
       force_determinism_(false),
       register_allocation_strategy_(RegisterAllocator::kRegisterAllocatorDefault),
+      adaptive_register_allocation_(false),
       passes_to_run_(nullptr) {
 }
 
@@ -95,6 +97,10 @@ void CompilerOptions::ParseInlineMaxCodeUnits(const StringPiece& option, UsageFn
   ParseUintOption(option, "--inline-max-code-units", &inline_max_code_units_, Usage);
 }
 
+void CompilerOptions::ParseLoopUnrollMaxInstructions(const StringPiece& option, UsageFn Usage) {
+  ParseUintOption(option, "--loop-unroll-max-instructions", &loop_unroll_max_instructions_, Usage);
+}
+
 void CompilerOptions::ParseDumpInitFailures(const StringPiece& option,
                                             UsageFn Usage ATTRIBUTE_UNUSED) {
   DCHECK(option.starts_with("--dump-init-failures="));
@@ -115,10 +121,15 @@ void CompilerOptions::ParseRegisterAllocationStrategy(const StringPiece& option,
   StringPiece choice = option.substr(strlen("--register-allocation-strategy=")).data();
   if (choice == "linear-scan") {
     register_allocation_strategy_ = RegisterAllocator::Strategy::kRegisterAllocatorLinearScan;
+    adaptive_register_allocation_ = false;
   } else if (choice == "graph-color") {
     register_allocation_strategy_ = RegisterAllocator::Strategy::kRegisterAllocatorGraphColor;
+    adaptive_register_allocation_ = false;
+  } else if (choice == "adaptive") {
+    register_allocation_strategy_ = RegisterAllocator::kRegisterAllocatorDefault;
+    adaptive_register_allocation_ = true;
   } else {
-    Usage("Unrecognized register allocation strategy. Try linear-scan, or graph-color.");
+    Usage("Unrecognized register allocation strategy. Try linear-scan, graph-color, or adaptive.");
   }
 }
 
@@ -142,6 +153,8 @@ bool CompilerOptions::ParseCompilerOption(const StringPiece& option, UsageFn Usa
     ParseNumDexMethods(option, Usage);
   } else if (option.starts_with("--inline-max-code-units=")) {
     ParseInlineMaxCodeUnits(option, Usage);
+  } else if (option.starts_with("--loop-unroll-max-instructions=")) {
+    ParseLoopUnrollMaxInstructions(option, Usage);
   } else if (option == "--generate-debug-info" || option == "-g") {
     generate_debug_info_ = true;
   } else if (option == "--no-generate-debug-info") {
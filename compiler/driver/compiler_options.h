@@ -48,6 +48,7 @@ class CompilerOptions FINAL {
   static const bool kDefaultGenerateMiniDebugInfo = false;
   static const size_t kDefaultInlineMaxCodeUnits = 32;
   static constexpr size_t kUnsetInlineMaxCodeUnits = -1;
+  static const size_t kDefaultLoopUnrollMaxInstructions = 40;
 
   CompilerOptions();
   ~CompilerOptions();
@@ -131,6 +132,13 @@ class CompilerOptions FINAL {
     inline_max_code_units_ = units;
   }
 
+  size_t GetLoopUnrollMaxInstructions() const {
+    return loop_unroll_max_instructions_;
+  }
+  void SetLoopUnrollMaxInstructions(size_t instructions) {
+    loop_unroll_max_instructions_ = instructions;
+  }
+
   double GetTopKProfileThreshold() const {
     return top_k_profile_threshold_;
   }
@@ -253,6 +261,12 @@ class CompilerOptions FINAL {
     return register_allocation_strategy_;
   }
 
+  // Whether the register allocator is picked per method, instead of always
+  // using the strategy returned by GetRegisterAllocationStrategy().
+  bool UseAdaptiveRegisterAllocation() const {
+    return adaptive_register_allocation_;
+  }
+
   const std::vector<std::string>* GetPassesToRun() const {
     return passes_to_run_;
   }
@@ -261,6 +275,7 @@ class CompilerOptions FINAL {
   void ParseDumpInitFailures(const StringPiece& option, UsageFn Usage);
   void ParseDumpCfgPasses(const StringPiece& option, UsageFn Usage);
   void ParseInlineMaxCodeUnits(const StringPiece& option, UsageFn Usage);
+  void ParseLoopUnrollMaxInstructions(const StringPiece& option, UsageFn Usage);
   void ParseNumDexMethods(const StringPiece& option, UsageFn Usage);
   void ParseTinyMethodMax(const StringPiece& option, UsageFn Usage);
   void ParseSmallMethodMax(const StringPiece& option, UsageFn Usage);
@@ -275,6 +290,7 @@ class CompilerOptions FINAL {
   size_t tiny_method_threshold_;
   size_t num_dex_methods_threshold_;
   size_t inline_max_code_units_;
+  size_t loop_unroll_max_instructions_;
 
   // Dex files from which we should not inline code.
   // This is usually a very short list (i.e. a single dex file), so we
@@ -314,6 +330,10 @@ class CompilerOptions FINAL {
 
   RegisterAllocator::Strategy register_allocation_strategy_;
 
+  // Whether hot and small loop methods use the graph coloring allocator. When set,
+  // register_allocation_strategy_ is only used for the remaining methods.
+  bool adaptive_register_allocation_;
+
   // If not null, specifies optimization passes which will be run instead of defaults.
   // Note that passes_to_run_ is not checked for correctness and providing an incorrect
   // list of passes can lead to unexpected compiler behaviour. This is caused by dependencies
@@ -0,0 +1,746 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "incremental_compilation.h"
+
+#include <openssl/sha.h>
+
+#include <algorithm>
+#include <sstream>
+
+#include "android-base/stringprintf.h"
+#include "android-base/strings.h"
+
+#include "art_method-inl.h"
+#include "base/casts.h"
+#include "base/logging.h"
+#include "compiled_method.h"
+#include "dex_file-inl.h"
+#include "driver/compiler_driver.h"
+#include "driver/compiler_options.h"
+#include "elf_file.h"
+#include "globals.h"
+#include "leb128.h"
+#include "method_info.h"
+#include "oat.h"
+#include "oat_file-inl.h"
+#include "oat_quick_method_header.h"
+#include "os.h"
+#include "stack_map.h"
+#include "thread.h"
+
+namespace art {
+
+using android::base::StringPrintf;
+
+constexpr const char* IncrementalCompilation::kSectionName;
+constexpr uint8_t IncrementalCompilation::kMagic[];
+constexpr uint8_t IncrementalCompilation::kVersion[];
+constexpr uint32_t IncrementalCompilation::kNoRecord;
+constexpr size_t IncrementalCompilation::kPatchedBytes;
+
+// Compute the digest of everything in the dex file but the code items. Returns an empty
+// digest, which matches no other, for dex files with call sites, whose encoded arrays are
+// not hashed.
+static std::vector<uint8_t> ComputeStructureDigest(const DexFile& dex_file) {
+  if (dex_file.NumCallSiteIds() != 0u) {
+    return std::vector<uint8_t>();
+  }
+  SHA_CTX ctx;
+  SHA1_Init(&ctx);
+  auto update = [&ctx](uint32_t value) {
+    SHA1_Update(&ctx, &value, sizeof(value));
+  };
+  auto update_type_list = [&update](const DexFile::TypeList* type_list) {
+    uint32_t size = (type_list != nullptr) ? type_list->Size() : 0u;
+    update(size);
+    for (uint32_t i = 0; i != size; ++i) {
+      update(type_list->GetTypeItem(i).type_idx_.index_);
+    }
+  };
+
+  for (uint32_t i = 0, num_string_ids = dex_file.NumStringIds(); i != num_string_ids; ++i) {
+    uint32_t utf16_length;
+    const char* data = dex_file.StringDataAndUtf16LengthByIdx(dex::StringIndex(i), &utf16_length);
+    update(utf16_length);
+    SHA1_Update(&ctx, data, strlen(data) + 1u);
+  }
+  for (uint32_t i = 0, num_type_ids = dex_file.NumTypeIds(); i != num_type_ids; ++i) {
+    update(dex_file.GetTypeId(dex::TypeIndex(i)).descriptor_idx_.index_);
+  }
+  for (uint32_t i = 0, num_proto_ids = dex_file.NumProtoIds(); i != num_proto_ids; ++i) {
+    const DexFile::ProtoId& proto_id = dex_file.GetProtoId(i);
+    update(proto_id.shorty_idx_.index_);
+    update(proto_id.return_type_idx_.index_);
+    update_type_list(dex_file.GetProtoParameters(proto_id));
+  }
+  for (uint32_t i = 0, num_field_ids = dex_file.NumFieldIds(); i != num_field_ids; ++i) {
+    const DexFile::FieldId& field_id = dex_file.GetFieldId(i);
+    update(field_id.class_idx_.index_);
+    update(field_id.type_idx_.index_);
+    update(field_id.name_idx_.index_);
+  }
+  for (uint32_t i = 0, num_method_ids = dex_file.NumMethodIds(); i != num_method_ids; ++i) {
+    const DexFile::MethodId& method_id = dex_file.GetMethodId(i);
+    update(method_id.class_idx_.index_);
+    update(method_id.proto_idx_);
+    update(method_id.name_idx_.index_);
+  }
+  for (uint32_t i = 0, num_method_handles = dex_file.NumMethodHandles();
+       i != num_method_handles;
+       ++i) {
+    const DexFile::MethodHandleItem& method_handle = dex_file.GetMethodHandle(i);
+    update(method_handle.method_handle_type_);
+    update(method_handle.field_or_method_idx_);
+  }
+  // The class hierarchy and the members of the classes determine the layout of the objects
+  // and of the method tables, which the compiled code embeds.
+  for (uint32_t i = 0, num_class_defs = dex_file.NumClassDefs(); i != num_class_defs; ++i) {
+    const DexFile::ClassDef& class_def = dex_file.GetClassDef(i);
+    update(class_def.class_idx_.index_);
+    update(class_def.access_flags_);
+    update(class_def.superclass_idx_.index_);
+    update_type_list(dex_file.GetInterfacesList(class_def));
+    const uint8_t* class_data = dex_file.GetClassData(class_def);
+    if (class_data == nullptr) {
+      update(0u);
+      continue;
+    }
+    ClassDataItemIterator it(dex_file, class_data);
+    update(it.NumStaticFields());
+    update(it.NumInstanceFields());
+    update(it.NumDirectMethods());
+    update(it.NumVirtualMethods());
+    for (; it.HasNext(); it.Next()) {
+      update(it.GetMemberIndex());
+      update(it.GetRawMemberAccessFlags());
+    }
+  }
+
+  std::vector<uint8_t> digest(SHA_DIGEST_LENGTH);
+  SHA1_Final(digest.data(), &ctx);
+  return digest;
+}
+
+// Compute the hash of the code items of the methods of a class.
+static uint64_t ComputeClassHash(const DexFile& dex_file, const DexFile::ClassDef& class_def) {
+  SHA_CTX ctx;
+  SHA1_Init(&ctx);
+  const uint8_t* class_data = dex_file.GetClassData(class_def);
+  if (class_data != nullptr) {
+    ClassDataItemIterator it(dex_file, class_data);
+    it.SkipAllFields();
+    for (; it.HasNext(); it.Next()) {
+      const DexFile::CodeItem* code_item = it.GetMethodCodeItem();
+      if (code_item == nullptr) {
+        continue;
+      }
+      uint32_t method_idx = it.GetMemberIndex();
+      SHA1_Update(&ctx, &method_idx, sizeof(method_idx));
+      // Skip the offset of the debug info, which moves with any change in the dex file.
+      const uint8_t* code_item_data = reinterpret_cast<const uint8_t*>(code_item);
+      const size_t debug_info_offset = OFFSETOF_MEMBER(DexFile::CodeItem, debug_info_off_);
+      const size_t insns_size_offset =
+          OFFSETOF_MEMBER(DexFile::CodeItem, insns_size_in_code_units_);
+      SHA1_Update(&ctx, code_item_data, debug_info_offset);
+      SHA1_Update(&ctx,
+                  code_item_data + insns_size_offset,
+                  DexFile::GetCodeItemSize(*code_item) - insns_size_offset);
+    }
+  }
+  uint8_t digest[SHA_DIGEST_LENGTH];
+  SHA1_Final(digest, &ctx);
+  uint64_t hash = 0u;
+  for (size_t i = 0; i != sizeof(hash); ++i) {
+    hash |= static_cast<uint64_t>(digest[i]) << (i * kBitsPerByte);
+  }
+  return hash;
+}
+
+static void EncodeHash(std::vector<uint8_t>* out, uint64_t hash) {
+  for (size_t i = 0; i != sizeof(hash); ++i) {
+    out->push_back(static_cast<uint8_t>(hash >> (i * kBitsPerByte)));
+  }
+}
+
+static uint64_t DecodeHash(const uint8_t** in) {
+  uint64_t hash = 0u;
+  for (size_t i = 0; i != sizeof(hash); ++i) {
+    hash |= static_cast<uint64_t>((*in)[i]) << (i * kBitsPerByte);
+  }
+  *in += sizeof(hash);
+  return hash;
+}
+
+// The linker patches are encoded as their type, literal offset and three values:
+// - for the Baker read barrier branches, the two custom values and 0,
+// - for the other patches, the PC instruction offset (or 0 for calls), the index of
+//   the target dex file, and the index of the target in its dex file.
+static bool PatchHasTargetDexFile(LinkerPatch::Type type) {
+  return type != LinkerPatch::Type::kBakerReadBarrierBranch;
+}
+
+LinkerPatch IncrementalCompilation::DecodePatch(LinkerPatch::Type type,
+                                               uint32_t literal_offset,
+                                               uint32_t value1,
+                                               const DexFile* target_dex_file,
+                                               uint32_t value2,
+                                               uint32_t target_idx) {
+  switch (type) {
+    case LinkerPatch::Type::kMethodRelative:
+      return LinkerPatch::RelativeMethodPatch(literal_offset, target_dex_file, value1, target_idx);
+    case LinkerPatch::Type::kMethodBssEntry:
+      return LinkerPatch::MethodBssEntryPatch(literal_offset, target_dex_file, value1, target_idx);
+    case LinkerPatch::Type::kCall:
+      return LinkerPatch::CodePatch(literal_offset, target_dex_file, target_idx);
+    case LinkerPatch::Type::kCallRelative:
+      return LinkerPatch::RelativeCodePatch(literal_offset, target_dex_file, target_idx);
+    case LinkerPatch::Type::kTypeRelative:
+      return LinkerPatch::RelativeTypePatch(literal_offset, target_dex_file, value1, target_idx);
+    case LinkerPatch::Type::kTypeBssEntry:
+      return LinkerPatch::TypeBssEntryPatch(literal_offset, target_dex_file, value1, target_idx);
+    case LinkerPatch::Type::kStringRelative:
+      return LinkerPatch::RelativeStringPatch(literal_offset, target_dex_file, value1, target_idx);
+    case LinkerPatch::Type::kStringBssEntry:
+      return LinkerPatch::StringBssEntryPatch(literal_offset, target_dex_file, value1, target_idx);
+    case LinkerPatch::Type::kBakerReadBarrierBranch:
+      return LinkerPatch::BakerReadBarrierBranchPatch(literal_offset, value1, value2);
+  }
+  LOG(FATAL) << "Unexpected linker patch type " << type;
+  UNREACHABLE();
+}
+
+IncrementalCompilation::IncrementalCompilation(CompilerDriver* driver,
+                                               const std::vector<const DexFile*>& dex_files)
+    : driver_(driver),
+      dex_files_(dex_files),
+      num_reused_methods_(0u),
+      lock_("incremental compilation lock") {
+  structure_digests_.reserve(dex_files_.size());
+  class_hashes_.reserve(dex_files_.size());
+  for (const DexFile* dex_file : dex_files_) {
+    structure_digests_.push_back(ComputeStructureDigest(*dex_file));
+    std::vector<uint64_t> class_hashes;
+    class_hashes.reserve(dex_file->NumClassDefs());
+    for (uint32_t i = 0, num_class_defs = dex_file->NumClassDefs(); i != num_class_defs; ++i) {
+      class_hashes.push_back(ComputeClassHash(*dex_file, dex_file->GetClassDef(i)));
+    }
+    class_hashes_.push_back(std::move(class_hashes));
+  }
+}
+
+IncrementalCompilation::~IncrementalCompilation() {}
+
+std::string IncrementalCompilation::GetCompilerConfiguration(const CompilerDriver& driver) {
+  const CompilerOptions& options = driver.GetCompilerOptions();
+  std::ostringstream oss;
+  oss << driver.GetInstructionSet()
+      << " " << driver.GetInstructionSetFeatures()->GetFeatureString()
+      << " pic=" << options.GetCompilePic()
+      << " debuggable=" << options.GetDebuggable()
+      << " native-debuggable=" << options.GetNativeDebuggable()
+      << " implicit-checks=" << options.GetImplicitNullChecks()
+      << options.GetImplicitStackOverflowChecks()
+      << options.GetImplicitSuspendChecks()
+      << " inline-max-code-units=" << options.GetInlineMaxCodeUnits()
+      << " loop-unroll-max-instructions=" << options.GetLoopUnrollMaxInstructions()
+      << " adaptive-register-allocation=" << options.UseAdaptiveRegisterAllocation()
+      << " read-barrier=" << kUseReadBarrier << kUseBakerReadBarrier
+      << " heap-poisoning=" << kPoisonHeapReferences
+      << " profile=" << (driver.GetProfileCompilationInfo() != nullptr);
+  if (options.GetNoInlineFromDexFile() != nullptr) {
+    // Identify the dex files by their checksums, their locations depend on the build machine.
+    std::vector<std::string> checksums;
+    for (const DexFile* dex_file : *options.GetNoInlineFromDexFile()) {
+      checksums.push_back(StringPrintf("%08x", dex_file->GetLocationChecksum()));
+    }
+    oss << " no-inline-from=" << android::base::Join(checksums, ',');
+  }
+  if (options.GetPassesToRun() != nullptr) {
+    oss << " passes=" << android::base::Join(*options.GetPassesToRun(), ',');
+  }
+  return oss.str();
+}
+
+bool IncrementalCompilation::OpenPreviousOatFile(
+    const std::string& filename,
+    const SafeMap<std::string, std::string>& key_value_store,
+    uint32_t image_file_location_oat_checksum,
+    std::string* error_msg) {
+  const CompilerOptions& options = driver_->GetCompilerOptions();
+  if (options.IsBootImage() || options.IsAppImage()) {
+    // The compiled code of apps may depend on the classes initialized in their image.
+    *error_msg = "Compiled code is only reused for apps without an image";
+    return false;
+  }
+  if (options.GenerateAnyDebugInfo()) {
+    *error_msg = "The debug info of the compiled code is not recorded";
+    return false;
+  }
+  // The code also depends on the content of the profile, which the configuration only
+  // records the presence of.
+  if (driver_->GetProfileCompilationInfo() != nullptr) {
+    *error_msg = "Compiled code is not reused for profile guided compilation";
+    return false;
+  }
+
+  {
+    std::unique_ptr<File> file(OS::OpenFileForReading(filename.c_str()));
+    if (file == nullptr) {
+      *error_msg = StringPrintf("Failed to open '%s'", filename.c_str());
+      return false;
+    }
+    std::unique_ptr<ElfFile> elf_file(ElfFile::Open(file.get(),
+                                                    /* writable */ false,
+                                                    /* program_header_only */ false,
+                                                    /* low_4gb */ false,
+                                                    error_msg));
+    if (elf_file == nullptr) {
+      return false;
+    }
+    uint64_t section_offset;
+    uint64_t section_size;
+    if (!elf_file->GetSectionOffsetAndSize(kSectionName, &section_offset, &section_size)) {
+      *error_msg = StringPrintf("'%s' was compiled without --record-incremental-info",
+                                filename.c_str());
+      return false;
+    }
+    records_.resize(section_size);
+    if (!file->PreadFully(records_.data(), section_size, section_offset)) {
+      *error_msg = StringPrintf("Failed to read the %s section of '%s'",
+                                kSectionName,
+                                filename.c_str());
+      records_.clear();
+      return false;
+    }
+  }
+
+  previous_oat_file_.reset(OatFile::Open(filename,
+                                         filename,
+                                         /* requested_base */ nullptr,
+                                         /* oat_file_begin */ nullptr,
+                                         /* executable */ false,
+                                         /* low_4gb */ false,
+                                         /* abs_dex_location */ nullptr,
+                                         error_msg));
+  if (previous_oat_file_ == nullptr || !IndexRecords(key_value_store,
+                                                     image_file_location_oat_checksum,
+                                                     error_msg)) {
+    previous_oat_file_.reset();
+    records_.clear();
+    record_offsets_.clear();
+    return false;
+  }
+  return true;
+}
+
+bool IncrementalCompilation::IndexRecords(const SafeMap<std::string, std::string>& key_value_store,
+                                          uint32_t image_file_location_oat_checksum,
+                                          std::string* error_msg) {
+  const OatHeader& oat_header = previous_oat_file_->GetOatHeader();
+  if (oat_header.GetImageFileLocationOatChecksum() != image_file_location_oat_checksum) {
+    *error_msg = "The boot image changed";
+    return false;
+  }
+  const char* class_path = oat_header.GetStoreValueByKey(OatHeader::kClassPathKey);
+  auto it = key_value_store.find(OatHeader::kClassPathKey);
+  if (class_path == nullptr || it == key_value_store.end() || it->second != class_path) {
+    *error_msg = "The class path changed";
+    return false;
+  }
+
+  const uint8_t* ptr = records_.data();
+  const uint8_t* const end = ptr + records_.size();
+  auto decode = [&ptr, end](uint32_t* value) {
+    return DecodeUnsignedLeb128Checked(&ptr, end, value);
+  };
+  auto corrupted = [error_msg]() {
+    *error_msg = "Corrupted incremental compilation records";
+    return false;
+  };
+
+  if (records_.size() < sizeof(kMagic) + sizeof(kVersion) ||
+      memcmp(ptr, kMagic, sizeof(kMagic)) != 0 ||
+      memcmp(ptr + sizeof(kMagic), kVersion, sizeof(kVersion)) != 0) {
+    *error_msg = "Unsupported incremental compilation records";
+    return false;
+  }
+  ptr += sizeof(kMagic) + sizeof(kVersion);
+  uint32_t configuration_size;
+  if (!decode(&configuration_size) || configuration_size > static_cast<size_t>(end - ptr)) {
+    return corrupted();
+  }
+  std::string configuration(reinterpret_cast<const char*>(ptr), configuration_size);
+  ptr += configuration_size;
+  if (configuration != GetCompilerConfiguration(*driver_)) {
+    *error_msg = "Compiled with different options: " + configuration;
+    return false;
+  }
+
+  uint32_t num_dex_files;
+  if (!decode(&num_dex_files)) {
+    return corrupted();
+  }
+  if (num_dex_files != dex_files_.size() ||
+      num_dex_files != previous_oat_file_->GetOatDexFiles().size()) {
+    *error_msg = "The number of dex files changed";
+    return false;
+  }
+  previous_class_hashes_.resize(num_dex_files);
+  for (size_t i = 0; i != num_dex_files; ++i) {
+    if (static_cast<size_t>(end - ptr) < SHA_DIGEST_LENGTH) {
+      return corrupted();
+    }
+    // All dex files must have the same structure, as the classes of a dex file may
+    // depend on the layout of the classes of another.
+    if (structure_digests_[i].empty() ||
+        memcmp(ptr, structure_digests_[i].data(), SHA_DIGEST_LENGTH) != 0) {
+      *error_msg = "The structure of " + dex_files_[i]->GetLocation() + " changed";
+      return false;
+    }
+    ptr += SHA_DIGEST_LENGTH;
+    uint32_t num_class_defs;
+    if (!decode(&num_class_defs) ||
+        num_class_defs != dex_files_[i]->NumClassDefs() ||
+        static_cast<size_t>(end - ptr) / sizeof(uint64_t) < num_class_defs) {
+      return corrupted();
+    }
+    previous_class_hashes_[i].reserve(num_class_defs);
+    for (size_t j = 0; j != num_class_defs; ++j) {
+      previous_class_hashes_[i].push_back(DecodeHash(&ptr));
+    }
+  }
+
+  record_offsets_.resize(num_dex_files);
+  for (size_t i = 0; i != num_dex_files; ++i) {
+    record_offsets_[i].resize(dex_files_[i]->NumMethodIds(), kNoRecord);
+  }
+  uint32_t num_records;
+  if (!decode(&num_records)) {
+    return corrupted();
+  }
+  for (size_t i = 0; i != num_records; ++i) {
+    const uint32_t record_offset = dchecked_integral_cast<uint32_t>(ptr - records_.data());
+    uint32_t dex_index;
+    uint32_t method_idx;
+    uint32_t class_method_index;
+    uint32_t num_dependencies;
+    if (!decode(&dex_index) ||
+        dex_index >= num_dex_files ||
+        !decode(&method_idx) ||
+        method_idx >= dex_files_[dex_index]->NumMethodIds() ||
+        !decode(&class_method_index) ||
+        !decode(&num_dependencies)) {
+      return corrupted();
+    }
+    for (size_t j = 0; j != num_dependencies; ++j) {
+      uint32_t dependency_dex_index;
+      uint32_t class_def_idx;
+      if (!decode(&dependency_dex_index) ||
+          dependency_dex_index >= num_dex_files ||
+          !decode(&class_def_idx) ||
+          class_def_idx >= dex_files_[dependency_dex_index]->NumClassDefs()) {
+        return corrupted();
+      }
+    }
+    uint32_t num_patches;
+    if (!decode(&num_patches)) {
+      return corrupted();
+    }
+    for (size_t j = 0; j != num_patches; ++j) {
+      if (ptr == end ||
+          *ptr > static_cast<uint8_t>(LinkerPatch::Type::kBakerReadBarrierBranch)) {
+        return corrupted();
+      }
+      LinkerPatch::Type type = static_cast<LinkerPatch::Type>(*ptr++);
+      uint32_t literal_offset;
+      uint32_t value1;
+      uint32_t value2;
+      uint32_t target_idx;
+      if (!decode(&literal_offset) ||
+          !decode(&value1) ||
+          !decode(&value2) ||
+          !decode(&target_idx) ||
+          (PatchHasTargetDexFile(type) && value2 >= num_dex_files) ||
+          static_cast<size_t>(end - ptr) < kPatchedBytes) {
+        return corrupted();
+      }
+      ptr += kPatchedBytes;
+    }
+    record_offsets_[dex_index][method_idx] = record_offset;
+  }
+  if (ptr != end) {
+    return corrupted();
+  }
+  return true;
+}
+
+CompiledMethod* IncrementalCompilation::ReuseCompiledMethod(MethodReference method_ref,
+                                                            uint16_t class_def_idx) {
+  if (record_offsets_.empty()) {
+    return nullptr;
+  }
+  int32_t dex_index = GetDexFileIndex(method_ref.dex_file);
+  if (dex_index < 0 ||
+      record_offsets_[dex_index][method_ref.dex_method_index] == kNoRecord ||
+      class_hashes_[dex_index][class_def_idx] != previous_class_hashes_[dex_index][class_def_idx]) {
+    return nullptr;
+  }
+
+  // The record was validated by IndexRecords().
+  const uint8_t* ptr = records_.data() + record_offsets_[dex_index][method_ref.dex_method_index];
+  DecodeUnsignedLeb128(&ptr);  // Dex file index.
+  DecodeUnsignedLeb128(&ptr);  // Method index.
+  uint32_t class_method_index = DecodeUnsignedLeb128(&ptr);
+  uint32_t num_dependencies = DecodeUnsignedLeb128(&ptr);
+  std::vector<ClassDependency> dependencies;
+  dependencies.reserve(num_dependencies);
+  for (size_t i = 0; i != num_dependencies; ++i) {
+    uint32_t dependency_dex_index = DecodeUnsignedLeb128(&ptr);
+    uint32_t dependency_class_def_idx = DecodeUnsignedLeb128(&ptr);
+    if (class_hashes_[dependency_dex_index][dependency_class_def_idx] !=
+        previous_class_hashes_[dependency_dex_index][dependency_class_def_idx]) {
+      return nullptr;
+    }
+    dependencies.emplace_back(dependency_dex_index, dependency_class_def_idx);
+  }
+
+  const OatDexFile* oat_dex_file = previous_oat_file_->GetOatDexFiles()[dex_index];
+  const OatFile::OatMethod oat_method =
+      oat_dex_file->GetOatClass(class_def_idx).GetOatMethod(class_method_index);
+  const OatQuickMethodHeader* method_header = oat_method.GetOatQuickMethodHeader();
+  if (method_header == nullptr || !method_header->IsOptimized()) {
+    return nullptr;
+  }
+
+  // Restore the bytes of the code overwritten by the linker patches.
+  std::vector<uint8_t> code(method_header->GetCode(),
+                            method_header->GetCode() + method_header->GetCodeSize());
+  uint32_t num_patches = DecodeUnsignedLeb128(&ptr);
+  std::vector<LinkerPatch> patches;
+  patches.reserve(num_patches);
+  for (size_t i = 0; i != num_patches; ++i) {
+    LinkerPatch::Type type = static_cast<LinkerPatch::Type>(*ptr++);
+    uint32_t literal_offset = DecodeUnsignedLeb128(&ptr);
+    uint32_t value1 = DecodeUnsignedLeb128(&ptr);
+    uint32_t value2 = DecodeUnsignedLeb128(&ptr);
+    uint32_t target_idx = DecodeUnsignedLeb128(&ptr);
+    if (literal_offset >= code.size()) {
+      return nullptr;
+    }
+    std::copy_n(ptr, std::min(kPatchedBytes, code.size() - literal_offset), &code[literal_offset]);
+    ptr += kPatchedBytes;
+    const DexFile* target_dex_file = PatchHasTargetDexFile(type) ? dex_files_[value2] : nullptr;
+    patches.push_back(
+        DecodePatch(type, literal_offset, value1, target_dex_file, value2, target_idx));
+  }
+
+  // Make a self-contained copy of the CodeInfo, whose tables may be shared in the oat file.
+  std::vector<uint8_t> vmap_table;
+  CodeInfo::Deduper deduper(&vmap_table);
+  deduper.Dedupe(reinterpret_cast<const uint8_t*>(method_header->GetOptimizedCodeInfoPtr()));
+  ArrayRef<const uint8_t> method_info;
+  if (method_header->GetMethodInfoOffset() != 0u) {
+    const uint8_t* method_info_data =
+        reinterpret_cast<const uint8_t*>(method_header->GetOptimizedMethodInfoPtr());
+    method_info = ArrayRef<const uint8_t>(
+        method_info_data,
+        MethodInfo::ComputeSize(MethodInfo(method_info_data).NumMethodIndices()));
+  }
+
+  const QuickMethodFrameInfo frame_info = method_header->GetFrameInfo();
+  CompiledMethod* compiled_method = CompiledMethod::SwapAllocCompiledMethod(
+      driver_,
+      driver_->GetInstructionSet(),
+      ArrayRef<const uint8_t>(code),
+      frame_info.FrameSizeInBytes(),
+      frame_info.CoreSpillMask(),
+      frame_info.FpSpillMask(),
+      method_info,
+      ArrayRef<const uint8_t>(vmap_table),
+      /* cfi_info */ ArrayRef<const uint8_t>(),
+      ArrayRef<const LinkerPatch>(patches));
+
+  // Keep the dependencies for the records of the new oat file.
+  for (const ClassDependency& dependency : dependencies) {
+    RecordDependency(method_ref, dependency);
+  }
+  num_reused_methods_.FetchAndAddRelaxed(1u);
+  return compiled_method;
+}
+
+void IncrementalCompilation::RecordInlinedMethod(MethodReference method_ref,
+                                                 ArtMethod* inlined_method) {
+  int32_t dex_index = GetDexFileIndex(inlined_method->GetDexFile());
+  if (dex_index < 0) {
+    // Methods of other dex files are covered by the class path and boot image checksums.
+    return;
+  }
+  RecordDependency(method_ref, ClassDependency(dex_index, inlined_method->GetClassDefIndex()));
+}
+
+void IncrementalCompilation::RecordDependency(MethodReference method_ref,
+                                              const ClassDependency& dependency) {
+  MutexLock mu(Thread::Current(), lock_);
+  dependencies_[method_ref].insert(dependency);
+}
+
+int32_t IncrementalCompilation::GetDexFileIndex(const DexFile* dex_file) const {
+  auto it = std::find(dex_files_.begin(), dex_files_.end(), dex_file);
+  return (it != dex_files_.end()) ? static_cast<int32_t>(it - dex_files_.begin()) : -1;
+}
+
+bool IncrementalCompilation::EncodeRecord(MethodReference method_ref,
+                                          uint32_t class_method_index,
+                                          const CompiledMethod* compiled_method,
+                                          std::vector<uint8_t>* out) const {
+  const int32_t dex_index = GetDexFileIndex(method_ref.dex_file);
+  DCHECK_GE(dex_index, 0);
+  EncodeUnsignedLeb128(out, dex_index);
+  EncodeUnsignedLeb128(out, method_ref.dex_method_index);
+  EncodeUnsignedLeb128(out, class_method_index);
+  auto it = dependencies_.find(method_ref);
+  if (it != dependencies_.end()) {
+    EncodeUnsignedLeb128(out, it->second.size());
+    for (const ClassDependency& dependency : it->second) {
+      EncodeUnsignedLeb128(out, dependency.first);
+      EncodeUnsignedLeb128(out, dependency.second);
+    }
+  } else {
+    EncodeUnsignedLeb128(out, 0u);
+  }
+
+  ArrayRef<const uint8_t> code = compiled_method->GetQuickCode();
+  EncodeUnsignedLeb128(out, compiled_method->GetPatches().size());
+  for (const LinkerPatch& patch : compiled_method->GetPatches()) {
+    uint32_t value1 = 0u;
+    uint32_t value2 = 0u;
+    uint32_t target_idx = 0u;
+    switch (patch.GetType()) {
+      case LinkerPatch::Type::kMethodRelative:
+      case LinkerPatch::Type::kMethodBssEntry:
+      case LinkerPatch::Type::kCall:
+      case LinkerPatch::Type::kCallRelative: {
+        MethodReference target_method = patch.TargetMethod();
+        if (patch.IsPcRelative() && patch.GetType() != LinkerPatch::Type::kCallRelative) {
+          value1 = patch.PcInsnOffset();
+        }
+        int32_t target_dex_index = GetDexFileIndex(target_method.dex_file);
+        if (target_dex_index < 0) {
+          return false;
+        }
+        value2 = target_dex_index;
+        target_idx = target_method.dex_method_index;
+        break;
+      }
+      case LinkerPatch::Type::kTypeRelative:
+      case LinkerPatch::Type::kTypeBssEntry: {
+        int32_t target_dex_index = GetDexFileIndex(patch.TargetTypeDexFile());
+        if (target_dex_index < 0) {
+          return false;
+        }
+        value1 = patch.PcInsnOffset();
+        value2 = target_dex_index;
+        target_idx = patch.TargetTypeIndex().index_;
+        break;
+      }
+      case LinkerPatch::Type::kStringRelative:
+      case LinkerPatch::Type::kStringBssEntry: {
+        int32_t target_dex_index = GetDexFileIndex(patch.TargetStringDexFile());
+        if (target_dex_index < 0) {
+          return false;
+        }
+        value1 = patch.PcInsnOffset();
+        value2 = target_dex_index;
+        target_idx = patch.TargetStringIndex().index_;
+        break;
+      }
+      case LinkerPatch::Type::kBakerReadBarrierBranch:
+        value1 = patch.GetBakerCustomValue1();
+        value2 = patch.GetBakerCustomValue2();
+        break;
+    }
+    out->push_back(static_cast<uint8_t>(patch.GetType()));
+    EncodeUnsignedLeb128(out, patch.LiteralOffset());
+    EncodeUnsignedLeb128(out, value1);
+    EncodeUnsignedLeb128(out, value2);
+    EncodeUnsignedLeb128(out, target_idx);
+    // Save the bytes of the unpatched code, overwritten in the oat file.
+    for (size_t i = 0; i != kPatchedBytes; ++i) {
+      size_t offset = patch.LiteralOffset() + i;
+      out->push_back((offset < code.size()) ? code[offset] : 0u);
+    }
+  }
+  return true;
+}
+
+void IncrementalCompilation::Encode(std::vector<uint8_t>* out) const {
+  out->insert(out->end(), kMagic, kMagic + sizeof(kMagic));
+  out->insert(out->end(), kVersion, kVersion + sizeof(kVersion));
+  std::string configuration = GetCompilerConfiguration(*driver_);
+  EncodeUnsignedLeb128(out, configuration.size());
+  out->insert(out->end(), configuration.begin(), configuration.end());
+
+  EncodeUnsignedLeb128(out, dex_files_.size());
+  for (size_t i = 0; i != dex_files_.size(); ++i) {
+    if (structure_digests_[i].empty()) {
+      out->insert(out->end(), SHA_DIGEST_LENGTH, 0u);
+    } else {
+      out->insert(out->end(), structure_digests_[i].begin(), structure_digests_[i].end());
+    }
+    EncodeUnsignedLeb128(out, class_hashes_[i].size());
+    for (uint64_t hash : class_hashes_[i]) {
+      EncodeHash(out, hash);
+    }
+  }
+
+  // Record the methods compiled by the optimizing compiler, whose code has a CodeInfo.
+  MutexLock mu(Thread::Current(), lock_);
+  std::vector<uint8_t> records;
+  std::vector<uint8_t> record;
+  uint32_t num_records = 0u;
+  for (const DexFile* dex_file : dex_files_) {
+    for (uint32_t i = 0, num_class_defs = dex_file->NumClassDefs(); i != num_class_defs; ++i) {
+      const uint8_t* class_data = dex_file->GetClassData(dex_file->GetClassDef(i));
+      if (class_data == nullptr) {
+        continue;
+      }
+      ClassDataItemIterator it(*dex_file, class_data);
+      it.SkipAllFields();
+      for (uint32_t class_method_index = 0; it.HasNext(); it.Next(), ++class_method_index) {
+        if (it.GetMethodCodeItem() == nullptr) {
+          continue;
+        }
+        MethodReference method_ref(dex_file, it.GetMemberIndex());
+        const CompiledMethod* compiled_method = driver_->GetCompiledMethod(method_ref);
+        if (compiled_method == nullptr ||
+            compiled_method->GetQuickCode().empty() ||
+            compiled_method->GetVmapTable().empty()) {
+          continue;
+        }
+        record.clear();
+        if (EncodeRecord(method_ref, class_method_index, compiled_method, &record)) {
+          records.insert(records.end(), record.begin(), record.end());
+          ++num_records;
+        }
+      }
+    }
+  }
+  EncodeUnsignedLeb128(out, num_records);
+  out->insert(out->end(), records.begin(), records.end());
+}
+
+}  // namespace art
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_DRIVER_INCREMENTAL_COMPILATION_H_
+#define ART_COMPILER_DRIVER_INCREMENTAL_COMPILATION_H_
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "atomic.h"
+#include "base/mutex.h"
+#include "base/safe_map.h"
+#include "compiled_method.h"
+#include "method_reference.h"
+
+namespace art {
+
+class ArtMethod;
+class CompiledMethod;
+class CompilerDriver;
+class DexFile;
+class OatFile;
+
+// Reuse of the compiled code of an oat file when compiling new versions of its dex files.
+//
+// When recording, the oat file gets an `kSectionName` section describing what the code of
+// each method compiled by the optimizing compiler depends on: the structure of the dex files,
+// i.e. everything but the code items, the code items of the class of the method and of the
+// classes of the methods inlined into it, and the linker patches of the code. The code of
+// such a method is reused by a later compilation if all of these are unchanged, by copying it
+// from the previous oat file, restoring the patched bytes, and linking it again.
+//
+// The structure of all the dex files must be unchanged, as the compiled code embeds dex
+// indexes and field offsets. Dependencies outside the oat file are checked through the class
+// path and boot image checksums of the oat header, which also change with the compiler.
+class IncrementalCompilation {
+ public:
+  // Name of the ELF section holding the records, not loaded at runtime.
+  static constexpr const char* kSectionName = ".oat_incremental";
+
+  IncrementalCompilation(CompilerDriver* driver,
+                         const std::vector<const DexFile*>& dex_files);
+  ~IncrementalCompilation();
+
+  // Open the oat file of a previous compilation to reuse its code. Returns false, leaving
+  // nothing to reuse, if the oat file has no records or does not match the configuration.
+  bool OpenPreviousOatFile(const std::string& filename,
+                           const SafeMap<std::string, std::string>& key_value_store,
+                           uint32_t image_file_location_oat_checksum,
+                           std::string* error_msg);
+
+  // Return a copy of the code of the previous oat file for the method, or null if the method
+  // or anything its code depends on changed.
+  CompiledMethod* ReuseCompiledMethod(MethodReference method_ref, uint16_t class_def_idx)
+      REQUIRES(!lock_);
+
+  // Record that the code of the method at `method_ref` depends on the code of `inlined_method`.
+  void RecordInlinedMethod(MethodReference method_ref, ArtMethod* inlined_method)
+      REQUIRES_SHARED(Locks::mutator_lock_)
+      REQUIRES(!lock_);
+
+  // Append the contents of the `kSectionName` section for the compiled methods of the driver.
+  void Encode(std::vector<uint8_t>* out) const REQUIRES(!lock_);
+
+  size_t GetNumberOfReusedMethods() const {
+    return num_reused_methods_.LoadRelaxed();
+  }
+
+  // Return a description of the compiler options affecting the generated code.
+  static std::string GetCompilerConfiguration(const CompilerDriver& driver);
+
+  // Make a linker patch from its encoding: for the Baker read barrier branches, `value1` and
+  // `value2` are the custom values; for the other patches, `value1` is the PC instruction
+  // offset, or 0 for calls, and `target_idx` the index of the target in `target_dex_file`.
+  static LinkerPatch DecodePatch(LinkerPatch::Type type,
+                                 uint32_t literal_offset,
+                                 uint32_t value1,
+                                 const DexFile* target_dex_file,
+                                 uint32_t value2,
+                                 uint32_t target_idx);
+
+ private:
+  static constexpr uint8_t kMagic[] = { 'i', 'n', 'c', '\n' };
+  static constexpr uint8_t kVersion[] = { '0', '0', '1', '\0' };
+
+  // Sentinel of `record_offsets_` for methods without a record.
+  static constexpr uint32_t kNoRecord = static_cast<uint32_t>(-1);
+
+  // Number of bytes saved for each linker patch, enough for any patched instruction.
+  static constexpr size_t kPatchedBytes = 4u;
+
+  // Dependency of a method on the code items of a class, as dex file index and class def index.
+  using ClassDependency = std::pair<uint32_t, uint32_t>;
+
+  // Validate the records of the previous oat file, and index them in `record_offsets_`.
+  bool IndexRecords(const SafeMap<std::string, std::string>& key_value_store,
+                    uint32_t image_file_location_oat_checksum,
+                    std::string* error_msg);
+
+  void RecordDependency(MethodReference method_ref, const ClassDependency& dependency)
+      REQUIRES(!lock_);
+
+  // Return the index of `dex_file` in `dex_files_`, or -1 if it is not compiled.
+  int32_t GetDexFileIndex(const DexFile* dex_file) const;
+
+  // Append the record of a compiled method to `out`. Returns false if the code refers to
+  // dex files that are not compiled.
+  bool EncodeRecord(MethodReference method_ref,
+                    uint32_t class_method_index,
+                    const CompiledMethod* compiled_method,
+                    std::vector<uint8_t>* out) const REQUIRES(lock_);
+
+  CompilerDriver* const driver_;
+  const std::vector<const DexFile*> dex_files_;
+
+  // Digest of the structure of each dex file.
+  std::vector<std::vector<uint8_t>> structure_digests_;
+  // Hash of the code items of each class def of each dex file.
+  std::vector<std::vector<uint64_t>> class_hashes_;
+
+  // The previous oat file and its records.
+  std::unique_ptr<OatFile> previous_oat_file_;
+  std::vector<uint8_t> records_;
+  // Offset of the record of each method in `records_`, for each dex file.
+  std::vector<std::vector<uint32_t>> record_offsets_;
+  // Hash of the code items of each class def of each dex file of the previous oat file.
+  std::vector<std::vector<uint64_t>> previous_class_hashes_;
+
+  Atomic<size_t> num_reused_methods_;
+
+  // Classes besides its own class whose code items the code of each method depends on.
+  mutable Mutex lock_;
+  std::map<MethodReference, std::set<ClassDependency>, MethodReferenceComparator> dependencies_
+      GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(IncrementalCompilation);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_DRIVER_INCREMENTAL_COMPILATION_H_
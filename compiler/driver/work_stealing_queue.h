@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_DRIVER_WORK_STEALING_QUEUE_H_
+#define ART_COMPILER_DRIVER_WORK_STEALING_QUEUE_H_
+
+#include <vector>
+
+#include "atomic.h"
+#include "base/bit_utils.h"
+#include "base/casts.h"
+#include "base/logging.h"
+#include "base/macros.h"
+
+namespace art {
+
+// The work items `first`, `first + stride`, ... of one work unit. The owner takes items from
+// the front and the other work units steal from the back. The numbers of items taken from each
+// end share one atomic word, so that each item is taken once.
+class WorkStealingQueue {
+ public:
+  WorkStealingQueue() : first_(0u), stride_(0u), size_(0u), taken_(0u) {}
+
+  void Init(size_t first, size_t stride, uint32_t size) {
+    first_ = first;
+    stride_ = stride;
+    size_ = size;
+    taken_.StoreRelaxed(0u);
+  }
+
+  bool TakeFront(size_t* index) {
+    return Take(index, /* from_back */ false);
+  }
+
+  bool TakeBack(size_t* index) {
+    return Take(index, /* from_back */ true);
+  }
+
+  // Deals the work items [begin, end) in turn to the `queues`.
+  static void Distribute(size_t begin, size_t end, std::vector<WorkStealingQueue>* queues) {
+    CHECK_LE(begin, end);
+    const size_t num_queues = queues->size();
+    for (size_t i = 0; i < num_queues; ++i) {
+      size_t first = begin + i;
+      size_t size = (first < end) ? RoundUp(end - first, num_queues) / num_queues : 0u;
+      (*queues)[i].Init(first, num_queues, dchecked_integral_cast<uint32_t>(size));
+    }
+  }
+
+  // Visits the items of `queues[queue]`, then steals the items left in the other queues.
+  template <typename Visitor>
+  static void Drain(std::vector<WorkStealingQueue>* queues, size_t queue, const Visitor& visitor) {
+    size_t index;
+    while ((*queues)[queue].TakeFront(&index)) {
+      visitor(index);
+    }
+    for (size_t i = 1, size = queues->size(); i != size; ++i) {
+      WorkStealingQueue& victim = (*queues)[(queue + i) % size];
+      while (victim.TakeBack(&index)) {
+        visitor(index);
+      }
+    }
+  }
+
+ private:
+  static constexpr uint64_t kOneFromBack = UINT64_C(1) << 32;
+
+  bool Take(size_t* index, bool from_back) {
+    while (true) {
+      uint64_t taken = taken_.LoadRelaxed();
+      uint32_t taken_from_front = static_cast<uint32_t>(taken);
+      uint32_t taken_from_back = static_cast<uint32_t>(taken >> 32);
+      if (taken_from_front + taken_from_back == size_) {
+        return false;
+      }
+      uint64_t new_taken = taken + (from_back ? kOneFromBack : 1u);
+      if (taken_.CompareExchangeWeakRelaxed(taken, new_taken)) {
+        size_t position = from_back ? size_ - 1u - taken_from_back : taken_from_front;
+        *index = first_ + position * stride_;
+        return true;
+      }
+    }
+  }
+
+  size_t first_;
+  size_t stride_;
+  uint32_t size_;
+  Atomic<uint64_t> taken_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkStealingQueue);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_DRIVER_WORK_STEALING_QUEUE_H_
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "work_stealing_queue.h"
+
+#include <vector>
+
+#include "atomic.h"
+#include "common_runtime_test.h"
+#include "thread-inl.h"
+#include "thread_pool.h"
+
+namespace art {
+
+class WorkStealingQueueTest : public CommonRuntimeTest {
+ protected:
+  // Drains `work_units` queues holding the items [begin, end) with as many threads, and
+  // checks that each item, and only these, was visited exactly once.
+  void CheckVisitedOnce(size_t begin, size_t end, size_t work_units) {
+    Thread* self = Thread::Current();
+    std::vector<WorkStealingQueue> queues(work_units);
+    WorkStealingQueue::Distribute(begin, end, &queues);
+    // Leave room around [begin, end) to catch items outside of it.
+    std::vector<AtomicInteger> visits(end + 2u);
+
+    ThreadPool thread_pool("Work stealing queue test thread pool", work_units);
+    for (size_t i = 0; i < work_units; ++i) {
+      thread_pool.AddTask(self, new DrainTask(&queues, i, &visits));
+    }
+    thread_pool.StartWorkers(self);
+    thread_pool.Wait(self, true, false);
+    thread_pool.StopWorkers(self);
+
+    for (size_t i = 0; i != visits.size(); ++i) {
+      int32_t expected = (i >= begin && i < end) ? 1 : 0;
+      EXPECT_EQ(expected, visits[i].LoadSequentiallyConsistent())
+          << "item " << i << " of [" << begin << ", " << end << ") with " << work_units
+          << " work units";
+    }
+  }
+
+ private:
+  class DrainTask : public Task {
+   public:
+    DrainTask(std::vector<WorkStealingQueue>* queues,
+              size_t queue,
+              std::vector<AtomicInteger>* visits)
+        : queues_(queues), queue_(queue), visits_(visits) {}
+
+    void Run(Thread* self ATTRIBUTE_UNUSED) OVERRIDE {
+      WorkStealingQueue::Drain(queues_, queue_, [&](size_t index) {
+        (*visits_)[index].FetchAndAddSequentiallyConsistent(1);
+      });
+    }
+
+    void Finalize() OVERRIDE {
+      delete this;
+    }
+
+   private:
+    std::vector<WorkStealingQueue>* const queues_;
+    const size_t queue_;
+    std::vector<AtomicInteger>* const visits_;
+  };
+};
+
+TEST_F(WorkStealingQueueTest, TakeFrontAndBack) {
+  std::vector<WorkStealingQueue> queues(3);
+  WorkStealingQueue::Distribute(2, 13, &queues);
+
+  // The first queue holds 2, 5, 8 and 11.
+  size_t index;
+  ASSERT_TRUE(queues[0].TakeFront(&index));
+  EXPECT_EQ(2u, index);
+  ASSERT_TRUE(queues[0].TakeBack(&index));
+  EXPECT_EQ(11u, index);
+  ASSERT_TRUE(queues[0].TakeBack(&index));
+  EXPECT_EQ(8u, index);
+  ASSERT_TRUE(queues[0].TakeFront(&index));
+  EXPECT_EQ(5u, index);
+  EXPECT_FALSE(queues[0].TakeFront(&index));
+  EXPECT_FALSE(queues[0].TakeBack(&index));
+
+  // The last queue holds 4, 7 and 10.
+  ASSERT_TRUE(queues[2].TakeBack(&index));
+  EXPECT_EQ(10u, index);
+  ASSERT_TRUE(queues[2].TakeFront(&index));
+  EXPECT_EQ(4u, index);
+  ASSERT_TRUE(queues[2].TakeFront(&index));
+  EXPECT_EQ(7u, index);
+  EXPECT_FALSE(queues[2].TakeBack(&index));
+}
+
+TEST_F(WorkStealingQueueTest, FewerItemsThanWorkUnits) {
+  std::vector<WorkStealingQueue> queues(4);
+  WorkStealingQueue::Distribute(0, 2, &queues);
+  size_t index;
+  EXPECT_TRUE(queues[1].TakeFront(&index));
+  EXPECT_EQ(1u, index);
+  EXPECT_FALSE(queues[2].TakeFront(&index));
+  EXPECT_FALSE(queues[3].TakeBack(&index));
+}
+
+TEST_F(WorkStealingQueueTest, EachItemVisitedOnce) {
+  static constexpr size_t kWorkUnits[] = { 1u, 2u, 7u, 16u };
+  static constexpr size_t kNumItems[] = { 0u, 1u, 15u, 16u, 17u, 1000u, 100003u };
+  for (size_t work_units : kWorkUnits) {
+    for (size_t num_items : kNumItems) {
+      CheckVisitedOnce(0u, num_items, work_units);
+      CheckVisitedOnce(3u, 3u + num_items, work_units);
+    }
+  }
+}
+
+}  // namespace art
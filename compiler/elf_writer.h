@@ -64,6 +64,8 @@ class ElfWriter {
   virtual void EndText(OutputStream* text) = 0;
   virtual void WriteDynamicSection() = 0;
   virtual void WriteDebugInfo(const ArrayRef<const debug::MethodDebugInfo>& method_infos) = 0;
+  // Write the records for reusing the compiled code in a later compilation.
+  virtual void WriteIncrementalInfo(const std::vector<uint8_t>& data) = 0;
   virtual bool End() = 0;
 
   // Get the ELF writer's stream. This stream can be used for writing data directly
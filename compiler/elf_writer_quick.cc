@@ -26,6 +26,7 @@
 #include "debug/elf_debug_writer.h"
 #include "debug/method_debug_info.h"
 #include "driver/compiler_options.h"
+#include "driver/incremental_compilation.h"
 #include "elf.h"
 #include "elf_builder.h"
 #include "elf_utils.h"
@@ -105,6 +106,7 @@ class ElfWriterQuick FINAL : public ElfWriter {
   void EndText(OutputStream* text) OVERRIDE;
   void WriteDynamicSection() OVERRIDE;
   void WriteDebugInfo(const ArrayRef<const debug::MethodDebugInfo>& method_infos) OVERRIDE;
+  void WriteIncrementalInfo(const std::vector<uint8_t>& data) OVERRIDE;
   bool End() OVERRIDE;
 
   virtual OutputStream* GetStream() OVERRIDE;
@@ -269,6 +271,11 @@ void ElfWriterQuick<ElfTypes>::WriteDebugInfo(
   }
 }
 
+template <typename ElfTypes>
+void ElfWriterQuick<ElfTypes>::WriteIncrementalInfo(const std::vector<uint8_t>& data) {
+  builder_->WriteSection(IncrementalCompilation::kSectionName, &data);
+}
+
 template <typename ElfTypes>
 bool ElfWriterQuick<ElfTypes>::End() {
   builder_->End();
@@ -52,6 +52,7 @@
 #include "os.h"
 #include "safe_map.h"
 #include "scoped_thread_state_change-inl.h"
+#include "stack_map.h"
 #include "type_lookup_table.h"
 #include "utils/dex_cache_arrays_layout-inl.h"
 #include "vdex_file.h"
@@ -1049,7 +1050,9 @@ class OatWriter::InitCodeMethodVisitor : public OatDexMethodVisitor {
 class OatWriter::InitMapMethodVisitor : public OatDexMethodVisitor {
  public:
   InitMapMethodVisitor(OatWriter* writer, size_t offset)
-      : OatDexMethodVisitor(writer, offset) {}
+      : OatDexMethodVisitor(writer, offset),
+        start_offset_(offset),
+        code_info_deduper_(writer->code_info_data_.get()) {}
 
   bool VisitMethod(size_t class_def_method_index, const ClassDataItemIterator& it ATTRIBUTE_UNUSED)
       OVERRIDE REQUIRES_SHARED(Locks::mutator_lock_) {
@@ -1065,9 +1068,11 @@ class OatWriter::InitMapMethodVisitor : public OatDexMethodVisitor {
       if (map_size != 0u) {
         size_t offset = dedupe_map_.GetOrCreate(
             map.data(),
-            [this, map_size]() {
-              uint32_t new_offset = offset_;
-              offset_ += map_size;
+            [this, map]() {
+              // Share the tables of the CodeInfo with the CodeInfos written before it.
+              uint32_t new_offset = start_offset_ + code_info_deduper_.Dedupe(map.data());
+              offset_ = start_offset_ + writer_->code_info_data_->size();
+              writer_->compiler_driver_->GetCompiledMethodStorage()->RecordAccess(map.size());
               return new_offset;
             });
         // Code offset is not initialized yet, so set the map offset to 0u-offset.
@@ -1080,10 +1085,19 @@ class OatWriter::InitMapMethodVisitor : public OatDexMethodVisitor {
     return true;
   }
 
+  size_t GetSavedBytes() const {
+    return code_info_deduper_.GetSavedBytes();
+  }
+
  private:
+  const size_t start_offset_;
+
   // Deduplication is already done on a pointer basis by the compiler driver,
   // so we can simply compare the pointers to find out if things are duplicated.
   SafeMap<const uint8_t*, uint32_t> dedupe_map_;
+
+  // Deduplication of the tables of different CodeInfos.
+  CodeInfo::BasicDeduper<SwapAllocator<uint8_t>> code_info_deduper_;
 };
 
 class OatWriter::InitMethodInfoVisitor : public OatDexMethodVisitor {
@@ -1458,6 +1472,8 @@ class OatWriter::WriteCodeMethodVisitor : public OatDexMethodVisitor {
         }
         writer_->size_code_ += code_size;
         offset_ += code_size;
+        // Let the swap space release the code written out so far from memory.
+        writer_->compiler_driver_->GetCompiledMethodStorage()->RecordAccess(code_size);
       }
       DCHECK_OFFSET_();
       ++method_offsets_index_;
@@ -1605,68 +1621,6 @@ class OatWriter::WriteCodeMethodVisitor : public OatDexMethodVisitor {
   }
 };
 
-class OatWriter::WriteMapMethodVisitor : public OatDexMethodVisitor {
- public:
-  WriteMapMethodVisitor(OatWriter* writer,
-                        OutputStream* out,
-                        const size_t file_offset,
-                        size_t relative_offset)
-      : OatDexMethodVisitor(writer, relative_offset),
-        out_(out),
-        file_offset_(file_offset) {}
-
-  bool VisitMethod(size_t class_def_method_index, const ClassDataItemIterator& it) OVERRIDE {
-    OatClass* oat_class = &writer_->oat_classes_[oat_class_index_];
-    const CompiledMethod* compiled_method = oat_class->GetCompiledMethod(class_def_method_index);
-
-    if (HasCompiledCode(compiled_method)) {
-      size_t file_offset = file_offset_;
-      OutputStream* out = out_;
-
-      uint32_t map_offset = oat_class->method_headers_[method_offsets_index_].GetVmapTableOffset();
-      uint32_t code_offset = oat_class->method_offsets_[method_offsets_index_].code_offset_;
-      ++method_offsets_index_;
-
-      DCHECK((compiled_method->GetVmapTable().size() == 0u && map_offset == 0u) ||
-             (compiled_method->GetVmapTable().size() != 0u && map_offset != 0u))
-          << compiled_method->GetVmapTable().size() << " " << map_offset << " "
-          << dex_file_->PrettyMethod(it.GetMemberIndex());
-
-      // If vdex is enabled, only emit the map for compiled code. The quickening info
-      // is emitted in the vdex already.
-      if (map_offset != 0u) {
-        // Transform map_offset to actual oat data offset.
-        map_offset = (code_offset - compiled_method->CodeDelta()) - map_offset;
-        DCHECK_NE(map_offset, 0u);
-        DCHECK_LE(map_offset, offset_) << dex_file_->PrettyMethod(it.GetMemberIndex());
-
-        ArrayRef<const uint8_t> map = compiled_method->GetVmapTable();
-        size_t map_size = map.size() * sizeof(map[0]);
-        if (map_offset == offset_) {
-          // Write deduplicated map (code info for Optimizing or transformation info for dex2dex).
-          if (UNLIKELY(!out->WriteFully(map.data(), map_size))) {
-            ReportWriteFailure(it);
-            return false;
-          }
-          offset_ += map_size;
-        }
-      }
-      DCHECK_OFFSET_();
-    }
-
-    return true;
-  }
-
- private:
-  OutputStream* const out_;
-  size_t const file_offset_;
-
-  void ReportWriteFailure(const ClassDataItemIterator& it) {
-    PLOG(ERROR) << "Failed to write map for "
-        << dex_file_->PrettyMethod(it.GetMemberIndex()) << " to " << out_->GetLocation();
-  }
-};
-
 class OatWriter::WriteMethodInfoVisitor : public OatDexMethodVisitor {
  public:
   WriteMethodInfoVisitor(OatWriter* writer,
@@ -1818,10 +1772,13 @@ size_t OatWriter::InitOatMaps(size_t offset) {
     return offset;
   }
   {
+    code_info_data_.reset(new SwapVector<uint8_t>(
+        compiler_driver_->GetCompiledMethodStorage()->GetSwapSpaceAllocator()));
     InitMapMethodVisitor visitor(this, offset);
     bool success = VisitDexMethods(&visitor);
     DCHECK(success);
     offset = visitor.GetOffset();
+    VLOG(compiler) << "Sharing CodeInfo tables saved " << PrettySize(visitor.GetSavedBytes());
   }
   {
     InitMethodInfoVisitor visitor(this, offset);
@@ -2466,13 +2423,23 @@ size_t OatWriter::WriteClasses(OutputStream* out, size_t file_offset, size_t rel
 
 size_t OatWriter::WriteMaps(OutputStream* out, size_t file_offset, size_t relative_offset) {
   {
-    size_t vmap_tables_offset = relative_offset;
-    WriteMapMethodVisitor visitor(this, out, file_offset, relative_offset);
-    if (UNLIKELY(!VisitDexMethods(&visitor))) {
-      return 0;
+    // The CodeInfos were deduplicated and laid out by InitOatMaps().
+    const size_t code_info_size = (code_info_data_ != nullptr) ? code_info_data_->size() : 0u;
+    // Write them in chunks, to let the swap space release the pages written out so far.
+    static constexpr size_t kChunkSize = 64 * KB;
+    for (size_t written = 0u; written != code_info_size; ) {
+      size_t chunk_size = std::min(kChunkSize, code_info_size - written);
+      if (UNLIKELY(!out->WriteFully(code_info_data_->data() + written, chunk_size))) {
+        PLOG(ERROR) << "Failed to write CodeInfos to " << out->GetLocation();
+        return 0;
+      }
+      compiler_driver_->GetCompiledMethodStorage()->RecordAccess(chunk_size);
+      written += chunk_size;
     }
-    relative_offset = visitor.GetOffset();
-    size_vmap_table_ = relative_offset - vmap_tables_offset;
+    code_info_data_.reset();
+    relative_offset += code_info_size;
+    size_vmap_table_ = code_info_size;
+    DCHECK_OFFSET();
   }
   {
     size_t method_infos_offset = relative_offset;
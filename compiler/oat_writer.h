@@ -32,6 +32,7 @@
 #include "safe_map.h"
 #include "string_reference.h"
 #include "type_reference.h"
+#include "utils/swap_space.h"
 
 namespace art {
 
@@ -263,7 +264,6 @@ class OatWriter {
   class InitMethodInfoVisitor;
   class InitImageMethodVisitor;
   class WriteCodeMethodVisitor;
-  class WriteMapMethodVisitor;
   class WriteMethodInfoVisitor;
   class WriteQuickeningInfoMethodVisitor;
   class WriteQuickeningIndicesMethodVisitor;
@@ -424,6 +424,10 @@ class OatWriter {
   std::unique_ptr<const std::vector<uint8_t>> quick_resolution_trampoline_;
   std::unique_ptr<const std::vector<uint8_t>> quick_to_interpreter_bridge_;
 
+  // The CodeInfos of the compiled methods, with their tables shared across methods. Kept in
+  // the swap space, if any, like the compiled methods.
+  std::unique_ptr<SwapVector<uint8_t>> code_info_data_;
+
   // output stats
   uint32_t size_vdex_header_;
   uint32_t size_vdex_checksums_;
@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "block_frequency.h"
+
+#include <algorithm>
+
+#include "base/iteration_range.h"
+
+namespace art {
+
+// Number of iterations assumed for each entry of a loop without profiled exits.
+static constexpr float kLoopIterationEstimate = 10.0f;
+
+// Upper bound on a frequency, to keep deeply nested loops in a sane range.
+static constexpr float kMaximumFrequency = 1.0e6f;
+
+// Probability given to an unprofiled branch to a block that ends up throwing.
+static constexpr float kThrowingBranchProbability = 0.01f;
+
+static bool IsThrowingBlock(HBasicBlock* block) {
+  HInstruction* last = block->GetLastInstruction();
+  return last != nullptr && last->IsThrow();
+}
+
+// Returns the probability that control goes from `predecessor` to its successor
+// at `index`.
+static float GetEdgeProbability(HBasicBlock* predecessor, size_t index) {
+  HInstruction* last = predecessor->GetLastInstruction();
+  HBasicBlock* successor = predecessor->GetSuccessors()[index];
+  if (successor->IsCatchBlock()) {
+    return 0.0f;
+  }
+  if (last->IsIf() && last->AsIf()->HasBranchProfile()) {
+    HIf* if_instruction = last->AsIf();
+    float true_count = static_cast<float>(if_instruction->GetTrueCount());
+    float false_count = static_cast<float>(if_instruction->GetFalseCount());
+    return ((index == 0u) ? true_count : false_count) / (true_count + false_count);
+  }
+  if (last->IsPackedSwitch() && last->AsPackedSwitch()->GetCaseCounts() != nullptr) {
+    HPackedSwitch* packed_switch = last->AsPackedSwitch();
+    const uint32_t* counts = packed_switch->GetCaseCounts();
+    float total = 0.0f;
+    for (uint32_t i = 0; i <= packed_switch->GetNumEntries(); ++i) {
+      total += static_cast<float>(counts[i]);
+    }
+    return static_cast<float>(counts[index]) / total;
+  }
+  size_t number_of_normal_successors = predecessor->GetNormalSuccessors().size();
+  if (last->IsIf()) {
+    // Without a profile, assume an exception is unlikely to be thrown.
+    HBasicBlock* other = predecessor->GetSuccessors()[1u - index];
+    if (IsThrowingBlock(successor) && !IsThrowingBlock(other)) {
+      return kThrowingBranchProbability;
+    } else if (IsThrowingBlock(other) && !IsThrowingBlock(successor)) {
+      return 1.0f - kThrowingBranchProbability;
+    }
+  }
+  return 1.0f / static_cast<float>(number_of_normal_successors);
+}
+
+static bool HasBranchProfile(HInstruction* instruction) {
+  return (instruction->IsIf() && instruction->AsIf()->HasBranchProfile()) ||
+      (instruction->IsPackedSwitch() && instruction->AsPackedSwitch()->GetCaseCounts() != nullptr);
+}
+
+// Returns whether some branch leaving the loop has been profiled.
+static bool HasProfiledExit(const HLoopInformation& loop_info) {
+  for (HBlocksInLoopIterator it(loop_info); !it.Done(); it.Advance()) {
+    HBasicBlock* block = it.Current();
+    if (HasBranchProfile(block->GetLastInstruction())) {
+      for (HBasicBlock* successor : block->GetSuccessors()) {
+        if (!loop_info.Contains(*successor)) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+// Returns how many times the header of the loop executes per entry of the loop. With
+// profiled exits, this is 1 / (1 - p), where p is the probability of taking a back edge
+// after executing the header, computed from the frequencies of the blocks of the loop
+// relative to its header. `multipliers` must already hold the values of the inner loops,
+// and `local_frequencies` is scratch space indexed by block id.
+static float ComputeLoopMultiplier(HGraph* graph,
+                                   const HLoopInformation& loop_info,
+                                   const ArenaVector<float>& multipliers,
+                                   ArenaVector<float>* local_frequencies) {
+  if (loop_info.IsIrreducible() || !HasProfiledExit(loop_info)) {
+    return kLoopIterationEstimate;
+  }
+  HBasicBlock* header = loop_info.GetHeader();
+  // The reverse post order visits the header first, then the other blocks of the loop
+  // after all their forward predecessors.
+  for (HBasicBlock* block : graph->GetReversePostOrder()) {
+    if (!loop_info.Contains(*block)) {
+      continue;
+    }
+    if (block == header) {
+      (*local_frequencies)[block->GetBlockId()] = 1.0f;
+      continue;
+    }
+    bool is_loop_header = block->IsLoopHeader();
+    float frequency = 0.0f;
+    for (HBasicBlock* predecessor : block->GetPredecessors()) {
+      if (is_loop_header && block->GetLoopInformation()->IsBackEdge(*predecessor)) {
+        continue;
+      }
+      const ArenaVector<HBasicBlock*>& successors = predecessor->GetSuccessors();
+      for (size_t i = 0, e = successors.size(); i != e; ++i) {
+        if (successors[i] == block) {
+          frequency +=
+              (*local_frequencies)[predecessor->GetBlockId()] * GetEdgeProbability(predecessor, i);
+        }
+      }
+    }
+    if (is_loop_header) {
+      frequency *= multipliers[block->GetBlockId()];
+    }
+    (*local_frequencies)[block->GetBlockId()] = std::min(frequency, kMaximumFrequency);
+  }
+  float back_edge_probability = 0.0f;
+  for (HBasicBlock* back_edge : loop_info.GetBackEdges()) {
+    const ArenaVector<HBasicBlock*>& successors = back_edge->GetSuccessors();
+    for (size_t i = 0, e = successors.size(); i != e; ++i) {
+      if (successors[i] == header) {
+        back_edge_probability +=
+            (*local_frequencies)[back_edge->GetBlockId()] * GetEdgeProbability(back_edge, i);
+      }
+    }
+  }
+  // Loops that never exit in the profile keep a bounded frequency.
+  back_edge_probability = std::min(back_edge_probability, 1.0f - 1.0f / kMaximumFrequency);
+  return 1.0f / (1.0f - back_edge_probability);
+}
+
+void ComputeBlockFrequencies(HGraph* graph) {
+  // Number of executions of each loop header per entry of its loop, indexed by block id.
+  ArenaVector<float> multipliers(graph->GetBlocks().size(),
+                                 kLoopIterationEstimate,
+                                 graph->GetArena()->Adapter(kArenaAllocMisc));
+  if (graph->HasBranchProfiles()) {
+    ArenaVector<float> local_frequencies(graph->GetBlocks().size(),
+                                         0.0f,
+                                         graph->GetArena()->Adapter(kArenaAllocMisc));
+    // The post order visits inner loops before the loops containing them.
+    for (HBasicBlock* block : ReverseRange(graph->GetReversePostOrder())) {
+      if (block->IsLoopHeader()) {
+        multipliers[block->GetBlockId()] = ComputeLoopMultiplier(
+            graph, *block->GetLoopInformation(), multipliers, &local_frequencies);
+      }
+    }
+  }
+
+  for (HBasicBlock* block : graph->GetReversePostOrder()) {
+    if (block->IsEntryBlock()) {
+      block->SetFrequency(1.0f);
+      continue;
+    }
+    // The reverse post order guarantees all forward predecessors have been visited.
+    HLoopInformation* loop_info = block->GetLoopInformation();
+    bool is_loop_header = block->IsLoopHeader();
+    float frequency = 0.0f;
+    for (HBasicBlock* predecessor : block->GetPredecessors()) {
+      if (is_loop_header && loop_info->IsBackEdge(*predecessor)) {
+        continue;
+      }
+      const ArenaVector<HBasicBlock*>& successors = predecessor->GetSuccessors();
+      for (size_t i = 0, e = successors.size(); i != e; ++i) {
+        if (successors[i] == block) {
+          frequency += predecessor->GetFrequency() * GetEdgeProbability(predecessor, i);
+        }
+      }
+    }
+    if (is_loop_header) {
+      frequency *= multipliers[block->GetBlockId()];
+    }
+    block->SetFrequency(std::min(frequency, kMaximumFrequency));
+  }
+  graph->SetHasBlockFrequencies(true);
+}
+
+}  // namespace art
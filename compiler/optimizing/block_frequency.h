@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_BLOCK_FREQUENCY_H_
+#define ART_COMPILER_OPTIMIZING_BLOCK_FREQUENCY_H_
+
+#include "nodes.h"
+
+namespace art {
+
+// Estimates how often each block of 'graph' executes, relative to the entry
+// block, and records it with HBasicBlock::SetFrequency():
+// (1): the branch profiles collected by the interpreter (see HIf and
+//      HPackedSwitch) give the probability of each outgoing edge, otherwise
+//      all normal successors are considered equally likely,
+// (2): catch blocks and blocks that end up throwing are considered cold,
+// (3): loop headers execute a fixed number of times per entry of the loop, or,
+//      when some exit of the loop is profiled, 1 / (1 - p) times, where p is the
+//      probability of taking a back edge after executing the header.
+//
+// The graph must have up to date dominance and loop information. Passes
+// creating blocks afterwards leave them with the default frequency.
+void ComputeBlockFrequencies(HGraph* graph);
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_BLOCK_FREQUENCY_H_
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+
+#include "base/arena_allocator.h"
+#include "block_frequency.h"
+#include "builder.h"
+#include "dex_instruction.h"
+#include "linear_order.h"
+#include "nodes.h"
+#include "optimizing_unit_test.h"
+
+#include "gtest/gtest.h"
+
+namespace art {
+
+class BlockFrequencyTest : public CommonCompilerTest {};
+
+static HIf* FindIf(HGraph* graph) {
+  for (HBasicBlock* block : graph->GetReversePostOrder()) {
+    if (block->EndsWithIf()) {
+      return block->GetLastInstruction()->AsIf();
+    }
+  }
+  return nullptr;
+}
+
+TEST_F(BlockFrequencyTest, ProfiledDiamond) {
+  const uint16_t data[] = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::IF_EQ, 3,
+    Instruction::GOTO | 0x100,
+    Instruction::RETURN_VOID);
+
+  ArenaPool arena;
+  ArenaAllocator allocator(&arena);
+  HGraph* graph = CreateCFG(&allocator, data);
+  ASSERT_NE(graph, nullptr);
+  HIf* if_instruction = FindIf(graph);
+  ASSERT_NE(if_instruction, nullptr);
+  if_instruction->SetBranchProfile(/* true_count */ 10u, /* false_count */ 90u);
+
+  ComputeBlockFrequencies(graph);
+  ASSERT_TRUE(graph->HasBlockFrequencies());
+
+  HBasicBlock* if_block = if_instruction->GetBlock();
+  HBasicBlock* true_block = if_instruction->IfTrueSuccessor();
+  HBasicBlock* false_block = if_instruction->IfFalseSuccessor();
+  EXPECT_FLOAT_EQ(1.0f, if_block->GetFrequency());
+  EXPECT_FLOAT_EQ(0.1f, true_block->GetFrequency());
+  EXPECT_FLOAT_EQ(0.9f, false_block->GetFrequency());
+  EXPECT_FLOAT_EQ(1.0f, false_block->GetSingleSuccessor()->GetFrequency());
+
+  // Swapping the profile makes the other successor follow the branch in the linear order.
+  if_instruction->SwapBranchProfile();
+  ComputeBlockFrequencies(graph);
+  ArenaVector<HBasicBlock*> linear_order(allocator.Adapter(kArenaAllocLinearOrder));
+  LinearizeGraph(graph, &allocator, &linear_order);
+  auto it = std::find(linear_order.begin(), linear_order.end(), if_block);
+  ASSERT_NE(it, linear_order.end());
+  ASSERT_NE(it + 1, linear_order.end());
+  EXPECT_EQ(true_block, *(it + 1));
+}
+
+TEST_F(BlockFrequencyTest, Loop) {
+  const uint16_t data[] = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::IF_EQ, 3,
+    Instruction::GOTO | 0xFE00,
+    Instruction::RETURN_VOID);
+
+  ArenaPool arena;
+  ArenaAllocator allocator(&arena);
+  HGraph* graph = CreateCFG(&allocator, data);
+  ASSERT_NE(graph, nullptr);
+  HIf* if_instruction = FindIf(graph);
+  ASSERT_NE(if_instruction, nullptr);
+  HBasicBlock* header = if_instruction->GetBlock();
+  ASSERT_TRUE(header->IsLoopHeader());
+
+  ComputeBlockFrequencies(graph);
+  float pre_header_frequency = header->GetLoopInformation()->GetPreHeader()->GetFrequency();
+  EXPECT_GT(header->GetFrequency(), pre_header_frequency);
+  // Without a profile, both successors of the header are equally likely.
+  EXPECT_FLOAT_EQ(if_instruction->IfTrueSuccessor()->GetFrequency(),
+                  if_instruction->IfFalseSuccessor()->GetFrequency());
+}
+
+TEST_F(BlockFrequencyTest, ProfiledLoop) {
+  const uint16_t data[] = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::IF_EQ, 3,
+    Instruction::GOTO | 0xFE00,
+    Instruction::RETURN_VOID);
+
+  ArenaPool arena;
+  ArenaAllocator allocator(&arena);
+  HGraph* graph = CreateCFG(&allocator, data);
+  ASSERT_NE(graph, nullptr);
+  HIf* if_instruction = FindIf(graph);
+  ASSERT_NE(if_instruction, nullptr);
+  HBasicBlock* header = if_instruction->GetBlock();
+  ASSERT_TRUE(header->IsLoopHeader());
+  HBasicBlock* pre_header = header->GetLoopInformation()->GetPreHeader();
+  graph->SetHasBranchProfiles(true);
+
+  // The loop exits once every 100 executions of the header: 100 iterations per entry.
+  if_instruction->SetBranchProfile(/* true_count */ 1u, /* false_count */ 99u);
+  ComputeBlockFrequencies(graph);
+  EXPECT_NEAR(100.0f * pre_header->GetFrequency(), header->GetFrequency(), 0.01f);
+  EXPECT_NEAR(99.0f * pre_header->GetFrequency(),
+              if_instruction->IfFalseSuccessor()->GetFrequency(),
+              0.01f);
+
+  // A loop that always exits right away executes its header once.
+  if_instruction->SetBranchProfile(/* true_count */ 10u, /* false_count */ 0u);
+  ComputeBlockFrequencies(graph);
+  EXPECT_FLOAT_EQ(pre_header->GetFrequency(), header->GetFrequency());
+
+  // Without a profile, the header executes a fixed number of times per entry.
+  if_instruction->SetBranchProfile(/* true_count */ 0u, /* false_count */ 0u);
+  ComputeBlockFrequencies(graph);
+  EXPECT_FLOAT_EQ(10.0f * pre_header->GetFrequency(), header->GetFrequency());
+}
+
+TEST_F(BlockFrequencyTest, ColdBlockSplitting) {
+  const uint16_t data[] = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::IF_EQ, 3,
+    Instruction::GOTO | 0x100,
+    Instruction::RETURN_VOID);
+
+  ArenaPool arena;
+  ArenaAllocator allocator(&arena);
+  HGraph* graph = CreateCFG(&allocator, data);
+  ASSERT_NE(graph, nullptr);
+  HIf* if_instruction = FindIf(graph);
+  ASSERT_NE(if_instruction, nullptr);
+  // The true successor is never taken.
+  if_instruction->SetBranchProfile(/* true_count */ 0u, /* false_count */ 100u);
+
+  ComputeBlockFrequencies(graph);
+  ArenaVector<HBasicBlock*> linear_order(allocator.Adapter(kArenaAllocLinearOrder));
+  LinearizeGraph(graph, &allocator, &linear_order);
+  ArenaVector<HBasicBlock*> code_order(allocator.Adapter(kArenaAllocLinearOrder));
+  EXPECT_EQ(1u, SplitColdBlocks(graph, linear_order, &code_order));
+  ASSERT_EQ(linear_order.size(), code_order.size());
+  EXPECT_EQ(graph->GetEntryBlock(), code_order.front());
+  EXPECT_EQ(if_instruction->IfTrueSuccessor(), code_order.back());
+  for (size_t i = 0, j = 0, e = linear_order.size(); i != e; ++i) {
+    // The hot blocks keep their relative order.
+    if (linear_order[i] != if_instruction->IfTrueSuccessor()) {
+      EXPECT_EQ(linear_order[i], code_order[j]);
+      ++j;
+    }
+  }
+
+  // With an even profile, no block is cold.
+  if_instruction->SetBranchProfile(/* true_count */ 50u, /* false_count */ 50u);
+  ComputeBlockFrequencies(graph);
+  code_order.clear();
+  EXPECT_EQ(0u, SplitColdBlocks(graph, linear_order, &code_order));
+  EXPECT_TRUE(std::equal(linear_order.begin(), linear_order.end(), code_order.begin()));
+}
+
+TEST_F(BlockFrequencyTest, ColdBlockSplittingWithoutProfile) {
+  const uint16_t data[] = ONE_REGISTER_CODE_ITEM(
+    Instruction::CONST_4 | 0 | 0,
+    Instruction::IF_EQZ, 3,
+    Instruction::RETURN_VOID,
+    Instruction::THROW | 0 << 8);
+
+  ArenaPool arena;
+  ArenaAllocator allocator(&arena);
+  HGraph* graph = CreateCFG(&allocator, data);
+  ASSERT_NE(graph, nullptr);
+  ASSERT_FALSE(graph->HasBranchProfiles());
+  HIf* if_instruction = FindIf(graph);
+  ASSERT_NE(if_instruction, nullptr);
+
+  // The static estimates alone find the path to the throw cold.
+  ComputeBlockFrequencies(graph);
+  ArenaVector<HBasicBlock*> linear_order(allocator.Adapter(kArenaAllocLinearOrder));
+  LinearizeGraph(graph, &allocator, &linear_order);
+  ArenaVector<HBasicBlock*> code_order(allocator.Adapter(kArenaAllocLinearOrder));
+  EXPECT_EQ(1u, SplitColdBlocks(graph, linear_order, &code_order));
+  ASSERT_EQ(linear_order.size(), code_order.size());
+  EXPECT_EQ(if_instruction->IfTrueSuccessor(), code_order.back());
+  EXPECT_TRUE(code_order.back()->GetLastInstruction()->IsThrow());
+}
+
+}  // namespace art
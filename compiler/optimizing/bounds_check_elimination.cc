@@ -549,9 +549,8 @@ class BCEVisitor : public HGraphVisitor {
       instruction->Accept(this);
       instruction = next_;
     }
-    // We should never deoptimize from an osr method, otherwise we might wrongly optimize
-    // code dominated by the deoptimization.
-    if (!GetGraph()->IsCompilingOsr()) {
+    // Only deoptimize if the graph allows speculation (e.g. never from an osr method).
+    if (GetGraph()->CanSpeculate()) {
       AddComparesWithDeoptimization(block);
     }
   }
@@ -1531,9 +1530,9 @@ class BCEVisitor : public HGraphVisitor {
       if (loop->IsIrreducible()) {
         return false;
       }
-      // We should never deoptimize from an osr method, otherwise we might wrongly optimize
-      // code dominated by the deoptimization.
-      if (GetGraph()->IsCompilingOsr()) {
+      // Only deoptimize if the graph allows speculation (e.g. never from an osr method).
+      // Otherwise, the loop optimizer may still version a vectorizable loop on the range.
+      if (!GetGraph()->CanSpeculate()) {
         return false;
       }
       // A try boundary preheader is hard to handle.
@@ -42,6 +42,7 @@
 
 #include "base/bit_utils.h"
 #include "base/bit_utils_iterator.h"
+#include "block_frequency.h"
 #include "bytecode_utils.h"
 #include "class_linker.h"
 #include "compiled_method.h"
@@ -51,6 +52,7 @@
 #include "intern_table.h"
 #include "intrinsics.h"
 #include "leb128.h"
+#include "linear_order.h"
 #include "mirror/array-inl.h"
 #include "mirror/object_array-inl.h"
 #include "mirror/object_reference.h"
@@ -299,11 +301,40 @@ void CodeGenerator::InitializeCodeGeneration(size_t number_of_spill_slots,
   block_order_ = &block_order;
   DCHECK(!block_order.empty());
   DCHECK(block_order[0] == GetGraph()->GetEntryBlock());
+  if (!GetGraph()->IsDebuggable()) {
+    // Without a branch profile, the frequencies are only estimated statically here, for
+    // the code layout: catch blocks and the paths to a throw are still found to be cold.
+    if (!GetGraph()->HasBlockFrequencies()) {
+      ComputeBlockFrequencies(GetGraph());
+    }
+    // Emit the cold blocks after the hot ones. Branches between blocks always
+    // go through labels, so the code generators do not depend on the linear order.
+    size_t number_of_cold_blocks = SplitColdBlocks(GetGraph(), block_order, &code_order_);
+    if (number_of_cold_blocks != 0u) {
+      block_order_ = &code_order_;
+      MaybeRecordStat(stats_, kColdBlockSplit, number_of_cold_blocks);
+    }
+  }
   ComputeSpillMask();
-  first_register_slot_in_slow_path_ = RoundUp(
-      (number_of_out_slots + number_of_spill_slots) * kVRegSize, GetPreferredSlotsAlignment());
+  size_t stack_allocations_end = (number_of_out_slots + number_of_spill_slots) * kVRegSize;
+  if (GetGraph()->HasStackAllocations()) {
+    // Stack allocated objects live between the spill slots and the slow path spills.
+    stack_allocations_end = RoundUp(stack_allocations_end, kObjectAlignment);
+    for (HBasicBlock* block : block_order) {
+      for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+        if (it.Current()->IsStackAllocation()) {
+          HStackAllocation* stack_allocation = it.Current()->AsStackAllocation();
+          stack_allocation->SetFrameOffset(stack_allocations_end);
+          stack_allocations_end += stack_allocation->GetObjectSize();
+        }
+      }
+    }
+  }
+  first_register_slot_in_slow_path_ =
+      RoundUp(stack_allocations_end, GetPreferredSlotsAlignment());
 
   if (number_of_spill_slots == 0
+      && !GetGraph()->HasStackAllocations()
       && !HasAllocatedCalleeSaveRegisters()
       && IsLeafMethod()
       && !RequiresCurrentMethod()) {
@@ -613,6 +613,7 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
         fpu_callee_save_mask_(fpu_callee_save_mask),
         stack_map_stream_(graph->GetArena(), graph->GetInstructionSet()),
         block_order_(nullptr),
+        code_order_(graph->GetArena()->Adapter(kArenaAllocCodeGenerator)),
         jit_string_roots_(StringReferenceValueComparator(),
                           graph->GetArena()->Adapter(kArenaAllocCodeGenerator)),
         jit_class_roots_(TypeReferenceValueComparator(),
@@ -715,6 +716,9 @@ class CodeGenerator : public DeletableArenaObject<kArenaAllocCodeGenerator> {
   // The order to use for code generation.
   const ArenaVector<HBasicBlock*>* block_order_;
 
+  // The linear order with cold blocks moved to the end, see `SplitColdBlocks`.
+  ArenaVector<HBasicBlock*> code_order_;
+
   // Maps a StringReference (dex_file, string_index) to the index in the literal table.
   // Entries are intially added with a pointer in the handle zone, and `EmitJitRoots`
   // will compute all the indices.
@@ -5285,6 +5285,35 @@ void InstructionCodeGeneratorARM64::VisitNewArray(HNewArray* instruction) {
   codegen_->MaybeGenerateMarkingRegisterCheck(/* code */ __LINE__);
 }
 
+void LocationsBuilderARM64::VisitStackAllocation(HStackAllocation* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+  // The output is written before the class is stored.
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+void InstructionCodeGeneratorARM64::VisitStackAllocation(HStackAllocation* instruction) {
+  Register cls = InputRegisterAt(instruction, 0);
+  Register out = OutputRegister(instruction);
+  DCHECK(out.IsX());
+  DCHECK(!kPoisonHeapReferences);
+
+  __ Add(out, sp, instruction->GetFrameOffset());
+  // Clear the whole object, as the frame slots are reused when the allocation is
+  // executed again (for example in a loop). This also clears the lock word.
+  for (size_t offset = 0; offset < instruction->GetObjectSize(); offset += kArm64WordSize) {
+    __ Str(xzr, MemOperand(out, offset));
+  }
+  __ Str(cls, HeapOperand(out, mirror::Object::ClassOffset()));
+  if (instruction->IsArray()) {
+    UseScratchRegisterScope temps(GetVIXLAssembler());
+    Register length = temps.AcquireW();
+    __ Mov(length, instruction->GetArrayLength());
+    __ Str(length, HeapOperand(out, mirror::Array::LengthOffset()));
+  }
+}
+
 void LocationsBuilderARM64::VisitNewInstance(HNewInstance* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCallOnMainOnly);
@@ -5368,6 +5368,18 @@ void InstructionCodeGeneratorARMVIXL::VisitNewArray(HNewArray* instruction) {
   codegen_->MaybeGenerateMarkingRegisterCheck(/* code */ 11);
 }
 
+void LocationsBuilderARMVIXL::VisitStackAllocation(
+    HStackAllocation* instruction ATTRIBUTE_UNUSED) {
+  // Objects are only allocated on the stack on ARM64 and x86-64.
+  LOG(FATAL) << "Unreachable";
+}
+
+void InstructionCodeGeneratorARMVIXL::VisitStackAllocation(
+    HStackAllocation* instruction ATTRIBUTE_UNUSED) {
+  // Objects are only allocated on the stack on ARM64 and x86-64.
+  LOG(FATAL) << "Unreachable";
+}
+
 void LocationsBuilderARMVIXL::VisitParameterValue(HParameterValue* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
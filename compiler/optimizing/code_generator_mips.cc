@@ -8146,6 +8146,18 @@ void InstructionCodeGeneratorMIPS::VisitNewArray(HNewArray* instruction) {
   DCHECK(!codegen_->IsLeafMethod());
 }
 
+void LocationsBuilderMIPS::VisitStackAllocation(
+    HStackAllocation* instruction ATTRIBUTE_UNUSED) {
+  // Objects are only allocated on the stack on ARM64 and x86-64.
+  LOG(FATAL) << "Unreachable";
+}
+
+void InstructionCodeGeneratorMIPS::VisitStackAllocation(
+    HStackAllocation* instruction ATTRIBUTE_UNUSED) {
+  // Objects are only allocated on the stack on ARM64 and x86-64.
+  LOG(FATAL) << "Unreachable";
+}
+
 void LocationsBuilderMIPS::VisitNewInstance(HNewInstance* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCallOnMainOnly);
@@ -6325,6 +6325,18 @@ void InstructionCodeGeneratorMIPS64::VisitNewArray(HNewArray* instruction) {
   DCHECK(!codegen_->IsLeafMethod());
 }
 
+void LocationsBuilderMIPS64::VisitStackAllocation(
+    HStackAllocation* instruction ATTRIBUTE_UNUSED) {
+  // Objects are only allocated on the stack on ARM64 and x86-64.
+  LOG(FATAL) << "Unreachable";
+}
+
+void InstructionCodeGeneratorMIPS64::VisitStackAllocation(
+    HStackAllocation* instruction ATTRIBUTE_UNUSED) {
+  // Objects are only allocated on the stack on ARM64 and x86-64.
+  LOG(FATAL) << "Unreachable";
+}
+
 void LocationsBuilderMIPS64::VisitNewInstance(HNewInstance* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kCallOnMainOnly);
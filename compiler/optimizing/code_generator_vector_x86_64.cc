@@ -25,6 +25,16 @@ namespace x86_64 {
 // NOLINT on __ macro to suppress wrong warning/fix (misc-macro-parentheses) from clang-tidy.
 #define __ down_cast<X86_64Assembler*>(GetAssembler())->  // NOLINT
 
+// Returns true if the vector operation uses 256-bit AVX2 vectors rather than 128-bit SSE vectors.
+static bool IsWideVector(HVecOperation* instruction) {
+  return instruction->GetVectorNumberOfBytes() == 32u;
+}
+
+// Returns true if the instruction is a constant with an all-zero bit pattern.
+static bool IsZeroBitPattern(HInstruction* instruction) {
+  return instruction->IsConstant() && instruction->AsConstant()->IsZeroBitPattern();
+}
+
 void LocationsBuilderX86_64::VisitVecReplicateScalar(HVecReplicateScalar* instruction) {
   LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instruction);
   switch (instruction->GetPackedType()) {
@@ -50,42 +60,71 @@ void LocationsBuilderX86_64::VisitVecReplicateScalar(HVecReplicateScalar* instru
 
 void InstructionCodeGeneratorX86_64::VisitVecReplicateScalar(HVecReplicateScalar* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   XmmRegister reg = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimBoolean:
     case Primitive::kPrimByte:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
-      __ movd(reg, locations->InAt(0).AsRegister<CpuRegister>());
-      __ punpcklbw(reg, reg);
-      __ punpcklwd(reg, reg);
-      __ pshufd(reg, reg, Immediate(0));
+      DCHECK_EQ(is_wide ? 32u : 16u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vmovd(reg, locations->InAt(0).AsRegister<CpuRegister>(), /*is64bit*/ false);
+        __ vpbroadcastb(reg, reg);
+      } else {
+        __ movd(reg, locations->InAt(0).AsRegister<CpuRegister>());
+        __ punpcklbw(reg, reg);
+        __ punpcklwd(reg, reg);
+        __ pshufd(reg, reg, Immediate(0));
+      }
       break;
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ movd(reg, locations->InAt(0).AsRegister<CpuRegister>());
-      __ punpcklwd(reg, reg);
-      __ pshufd(reg, reg, Immediate(0));
+      DCHECK_EQ(is_wide ? 16u : 8u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vmovd(reg, locations->InAt(0).AsRegister<CpuRegister>(), /*is64bit*/ false);
+        __ vpbroadcastw(reg, reg);
+      } else {
+        __ movd(reg, locations->InAt(0).AsRegister<CpuRegister>());
+        __ punpcklwd(reg, reg);
+        __ pshufd(reg, reg, Immediate(0));
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ movd(reg, locations->InAt(0).AsRegister<CpuRegister>());
-      __ pshufd(reg, reg, Immediate(0));
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vmovd(reg, locations->InAt(0).AsRegister<CpuRegister>(), /*is64bit*/ false);
+        __ vpbroadcastd(reg, reg);
+      } else {
+        __ movd(reg, locations->InAt(0).AsRegister<CpuRegister>());
+        __ pshufd(reg, reg, Immediate(0));
+      }
       break;
     case Primitive::kPrimLong:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ movd(reg, locations->InAt(0).AsRegister<CpuRegister>());  // is 64-bit
-      __ punpcklqdq(reg, reg);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vmovd(reg, locations->InAt(0).AsRegister<CpuRegister>(), /*is64bit*/ true);
+        __ vpbroadcastq(reg, reg);
+      } else {
+        __ movd(reg, locations->InAt(0).AsRegister<CpuRegister>());  // is 64-bit
+        __ punpcklqdq(reg, reg);
+      }
       break;
     case Primitive::kPrimFloat:
       DCHECK(locations->InAt(0).Equals(locations->Out()));
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ shufps(reg, reg, Immediate(0));
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vbroadcastss(reg, reg);
+      } else {
+        __ shufps(reg, reg, Immediate(0));
+      }
       break;
     case Primitive::kPrimDouble:
       DCHECK(locations->InAt(0).Equals(locations->Out()));
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ shufpd(reg, reg, Immediate(0));
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vbroadcastsd(reg, reg);
+      } else {
+        __ shufpd(reg, reg, Immediate(0));
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -94,19 +133,178 @@ void InstructionCodeGeneratorX86_64::VisitVecReplicateScalar(HVecReplicateScalar
 }
 
 void LocationsBuilderX86_64::VisitVecSetScalars(HVecSetScalars* instruction) {
-  LOG(FATAL) << "No SIMD for " << instruction->GetId();
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instruction);
+
+  DCHECK_EQ(1u, instruction->InputCount());  // only one input currently implemented
+
+  HInstruction* input = instruction->InputAt(0);
+  bool is_zero = IsZeroBitPattern(input);
+
+  switch (instruction->GetPackedType()) {
+    case Primitive::kPrimInt:
+    case Primitive::kPrimLong:
+      locations->SetInAt(0, is_zero ? Location::ConstantLocation(input->AsConstant())
+                                    : Location::RequiresRegister());
+      locations->SetOut(Location::RequiresFpuRegister());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
 }
 
 void InstructionCodeGeneratorX86_64::VisitVecSetScalars(HVecSetScalars* instruction) {
-  LOG(FATAL) << "No SIMD for " << instruction->GetId();
+  LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
+  XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
+
+  DCHECK_EQ(1u, instruction->InputCount());  // only one input currently implemented
+
+  // Zero out all other elements first.
+  if (is_wide) {
+    __ vxorps(dst, dst, dst);
+  } else {
+    __ xorps(dst, dst);
+  }
+
+  // Shorthand for any type of zero.
+  if (IsZeroBitPattern(instruction->InputAt(0))) {
+    return;
+  }
+
+  // Set required elements.
+  switch (instruction->GetPackedType()) {
+    case Primitive::kPrimInt:
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vmovd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*is64bit*/ false);
+      } else {
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*is64bit*/ false);
+      }
+      break;
+    case Primitive::kPrimLong:
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vmovd(dst, locations->InAt(0).AsRegister<CpuRegister>(), /*is64bit*/ true);
+      } else {
+        __ movd(dst, locations->InAt(0).AsRegister<CpuRegister>());  // is 64-bit
+      }
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
 }
 
-void LocationsBuilderX86_64::VisitVecSumReduce(HVecSumReduce* instruction) {
-  LOG(FATAL) << "No SIMD for " << instruction->GetId();
+// Helper to combine two int or long vectors by the given kind. The 256-bit forms are used for
+// wide vectors, of which only the lower 128-bit half is relevant once folded.
+static void CombineForReduce(X86_64Assembler* assembler,
+                             HVecReduce::ReductionKind kind,
+                             Primitive::Type type,
+                             bool is_wide,
+                             XmmRegister dst,
+                             XmmRegister src) {
+  if (type == Primitive::kPrimLong) {
+    DCHECK_EQ(HVecReduce::kSum, kind);  // no long min/max
+    if (is_wide) {
+      assembler->vpaddq(dst, dst, src);
+    } else {
+      assembler->paddq(dst, src);
+    }
+    return;
+  }
+  DCHECK_EQ(Primitive::kPrimInt, type);
+  switch (kind) {
+    case HVecReduce::kSum:
+      if (is_wide) {
+        assembler->vpaddd(dst, dst, src);
+      } else {
+        assembler->paddd(dst, src);
+      }
+      break;
+    case HVecReduce::kMin:
+      if (is_wide) {
+        assembler->vpminsd(dst, dst, src);
+      } else {
+        assembler->pminsd(dst, src);
+      }
+      break;
+    case HVecReduce::kMax:
+      if (is_wide) {
+        assembler->vpmaxsd(dst, dst, src);
+      } else {
+        assembler->pmaxsd(dst, src);
+      }
+      break;
+  }
+}
+
+void LocationsBuilderX86_64::VisitVecReduce(HVecReduce* instruction) {
+  LocationSummary* locations = new (GetGraph()->GetArena()) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case Primitive::kPrimInt:
+    case Primitive::kPrimLong:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetOut(Location::RequiresRegister());
+      locations->AddTemp(Location::RequiresFpuRegister());
+      locations->AddTemp(Location::RequiresFpuRegister());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
 }
 
-void InstructionCodeGeneratorX86_64::VisitVecSumReduce(HVecSumReduce* instruction) {
-  LOG(FATAL) << "No SIMD for " << instruction->GetId();
+void InstructionCodeGeneratorX86_64::VisitVecReduce(HVecReduce* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
+  XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
+  XmmRegister tmp1 = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+  XmmRegister tmp2 = locations->GetTemp(1).AsFpuRegister<XmmRegister>();
+  CpuRegister dst = locations->Out().AsRegister<CpuRegister>();
+  HVecReduce::ReductionKind kind = instruction->GetKind();
+  Primitive::Type type = instruction->GetPackedType();
+  X86_64Assembler* assembler = down_cast<X86_64Assembler*>(GetAssembler());
+  // Fold a 256-bit vector into its lower 128-bit half first.
+  if (is_wide) {
+    __ vextracti128(tmp1, src, Immediate(1));
+    CombineForReduce(assembler, kind, type, is_wide, tmp1, src);
+  } else {
+    __ movaps(tmp1, src);
+  }
+  switch (type) {
+    case Primitive::kPrimInt:
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpshufd(tmp2, tmp1, Immediate(0x0E));  // [ x3, x4, .. ]
+        CombineForReduce(assembler, kind, type, is_wide, tmp1, tmp2);
+        __ vpshufd(tmp2, tmp1, Immediate(0x01));  // [ x2, .. ]
+        CombineForReduce(assembler, kind, type, is_wide, tmp1, tmp2);
+        __ vmovd(dst, tmp1, /*is64bit*/ false);
+      } else {
+        __ pshufd(tmp2, tmp1, Immediate(0x0E));  // [ x3, x4, .. ]
+        CombineForReduce(assembler, kind, type, is_wide, tmp1, tmp2);
+        __ pshufd(tmp2, tmp1, Immediate(0x01));  // [ x2, .. ]
+        CombineForReduce(assembler, kind, type, is_wide, tmp1, tmp2);
+        __ movd(dst, tmp1, /*is64bit*/ false);
+      }
+      break;
+    case Primitive::kPrimLong:
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpshufd(tmp2, tmp1, Immediate(0x0E));  // [ x2, .. ]
+        CombineForReduce(assembler, kind, type, is_wide, tmp1, tmp2);
+        __ vmovd(dst, tmp1, /*is64bit*/ true);
+      } else {
+        __ pshufd(tmp2, tmp1, Immediate(0x0E));  // [ x2, .. ]
+        CombineForReduce(assembler, kind, type, is_wide, tmp1, tmp2);
+        __ movd(dst, tmp1);  // is 64-bit
+      }
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
 }
 
 // Helper to set up locations for vector unary operations.
@@ -136,13 +334,18 @@ void LocationsBuilderX86_64::VisitVecCnv(HVecCnv* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecCnv(HVecCnv* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   Primitive::Type from = instruction->GetInputType();
   Primitive::Type to = instruction->GetResultType();
   if (from == Primitive::kPrimInt && to == Primitive::kPrimFloat) {
-    DCHECK_EQ(4u, instruction->GetVectorLength());
-    __ cvtdq2ps(dst, src);
+    DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+    if (is_wide) {
+      __ vcvtdq2ps(dst, src);
+    } else {
+      __ cvtdq2ps(dst, src);
+    }
   } else {
     LOG(FATAL) << "Unsupported SIMD type";
   }
@@ -154,39 +357,70 @@ void LocationsBuilderX86_64::VisitVecNeg(HVecNeg* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecNeg(HVecNeg* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimByte:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
-      __ pxor(dst, dst);
-      __ psubb(dst, src);
+      DCHECK_EQ(is_wide ? 32u : 16u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpxor(dst, dst, dst);
+        __ vpsubb(dst, dst, src);
+      } else {
+        __ pxor(dst, dst);
+        __ psubb(dst, src);
+      }
       break;
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ pxor(dst, dst);
-      __ psubw(dst, src);
+      DCHECK_EQ(is_wide ? 16u : 8u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpxor(dst, dst, dst);
+        __ vpsubw(dst, dst, src);
+      } else {
+        __ pxor(dst, dst);
+        __ psubw(dst, src);
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ pxor(dst, dst);
-      __ psubd(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpxor(dst, dst, dst);
+        __ vpsubd(dst, dst, src);
+      } else {
+        __ pxor(dst, dst);
+        __ psubd(dst, src);
+      }
       break;
     case Primitive::kPrimLong:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ pxor(dst, dst);
-      __ psubq(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpxor(dst, dst, dst);
+        __ vpsubq(dst, dst, src);
+      } else {
+        __ pxor(dst, dst);
+        __ psubq(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ xorps(dst, dst);
-      __ subps(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vxorps(dst, dst, dst);
+        __ vsubps(dst, dst, src);
+      } else {
+        __ xorps(dst, dst);
+        __ subps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ xorpd(dst, dst);
-      __ subpd(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vxorpd(dst, dst, dst);
+        __ vsubpd(dst, dst, src);
+      } else {
+        __ xorpd(dst, dst);
+        __ subpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -204,30 +438,51 @@ void LocationsBuilderX86_64::VisitVecAbs(HVecAbs* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecAbs(HVecAbs* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimInt: {
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
       XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
-      __ movaps(dst, src);
-      __ pxor(tmp, tmp);
-      __ pcmpgtd(tmp, dst);
-      __ pxor(dst, tmp);
-      __ psubd(dst, tmp);
+      if (is_wide) {
+        __ vmovaps(dst, src);
+        __ vpxor(tmp, tmp, tmp);
+        __ vpcmpgtd(tmp, tmp, dst);
+        __ vpxor(dst, dst, tmp);
+        __ vpsubd(dst, dst, tmp);
+      } else {
+        __ movaps(dst, src);
+        __ pxor(tmp, tmp);
+        __ pcmpgtd(tmp, dst);
+        __ pxor(dst, tmp);
+        __ psubd(dst, tmp);
+      }
       break;
     }
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ pcmpeqb(dst, dst);  // all ones
-      __ psrld(dst, Immediate(1));
-      __ andps(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpcmpeqb(dst, dst, dst);  // all ones
+        __ vpsrld(dst, dst, Immediate(1));
+        __ vandps(dst, dst, src);
+      } else {
+        __ pcmpeqb(dst, dst);  // all ones
+        __ psrld(dst, Immediate(1));
+        __ andps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ pcmpeqb(dst, dst);  // all ones
-      __ psrlq(dst, Immediate(1));
-      __ andpd(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpcmpeqb(dst, dst, dst);  // all ones
+        __ vpsrlq(dst, dst, Immediate(1));
+        __ vandpd(dst, dst, src);
+      } else {
+        __ pcmpeqb(dst, dst);  // all ones
+        __ psrlq(dst, Immediate(1));
+        __ andpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -237,7 +492,7 @@ void InstructionCodeGeneratorX86_64::VisitVecAbs(HVecAbs* instruction) {
 
 void LocationsBuilderX86_64::VisitVecNot(HVecNot* instruction) {
   CreateVecUnOpLocations(GetGraph()->GetArena(), instruction);
-  // Boolean-not requires a temporary to construct the 16 x one.
+  // Boolean-not requires a temporary to construct the 16 (or 32) x one.
   if (instruction->GetPackedType() == Primitive::kPrimBoolean) {
     instruction->GetLocations()->AddTemp(Location::RequiresFpuRegister());
   }
@@ -245,16 +500,24 @@ void LocationsBuilderX86_64::VisitVecNot(HVecNot* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecNot(HVecNot* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   XmmRegister src = locations->InAt(0).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimBoolean: {  // special case boolean-not
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(is_wide ? 32u : 16u, instruction->GetVectorLength());
       XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
-      __ pxor(dst, dst);
-      __ pcmpeqb(tmp, tmp);  // all ones
-      __ psubb(dst, tmp);  // 16 x one
-      __ pxor(dst, src);
+      if (is_wide) {
+        __ vpxor(dst, dst, dst);
+        __ vpcmpeqb(tmp, tmp, tmp);  // all ones
+        __ vpsubb(dst, dst, tmp);  // 16 (or 32) x one
+        __ vpxor(dst, dst, src);
+      } else {
+        __ pxor(dst, dst);
+        __ pcmpeqb(tmp, tmp);  // all ones
+        __ psubb(dst, tmp);  // 16 (or 32) x one
+        __ pxor(dst, src);
+      }
       break;
     }
     case Primitive::kPrimByte:
@@ -263,19 +526,34 @@ void InstructionCodeGeneratorX86_64::VisitVecNot(HVecNot* instruction) {
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
       DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      __ pcmpeqb(dst, dst);  // all ones
-      __ pxor(dst, src);
+      DCHECK_LE(instruction->GetVectorLength(), is_wide ? 32u : 16u);
+      if (is_wide) {
+        __ vpcmpeqb(dst, dst, dst);  // all ones
+        __ vpxor(dst, dst, src);
+      } else {
+        __ pcmpeqb(dst, dst);  // all ones
+        __ pxor(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ pcmpeqb(dst, dst);  // all ones
-      __ xorps(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpcmpeqb(dst, dst, dst);  // all ones
+        __ vxorps(dst, dst, src);
+      } else {
+        __ pcmpeqb(dst, dst);  // all ones
+        __ xorps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ pcmpeqb(dst, dst);  // all ones
-      __ xorpd(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpcmpeqb(dst, dst, dst);  // all ones
+        __ vxorpd(dst, dst, src);
+      } else {
+        __ pcmpeqb(dst, dst);  // all ones
+        __ xorpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -311,34 +589,59 @@ void LocationsBuilderX86_64::VisitVecAdd(HVecAdd* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecAdd(HVecAdd* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimByte:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
-      __ paddb(dst, src);
+      DCHECK_EQ(is_wide ? 32u : 16u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpaddb(dst, dst, src);
+      } else {
+        __ paddb(dst, src);
+      }
       break;
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ paddw(dst, src);
+      DCHECK_EQ(is_wide ? 16u : 8u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpaddw(dst, dst, src);
+      } else {
+        __ paddw(dst, src);
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ paddd(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpaddd(dst, dst, src);
+      } else {
+        __ paddd(dst, src);
+      }
       break;
     case Primitive::kPrimLong:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ paddq(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpaddq(dst, dst, src);
+      } else {
+        __ paddq(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ addps(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vaddps(dst, dst, src);
+      } else {
+        __ addps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ addpd(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vaddpd(dst, dst, src);
+      } else {
+        __ addpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -352,6 +655,7 @@ void LocationsBuilderX86_64::VisitVecHalvingAdd(HVecHalvingAdd* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecHalvingAdd(HVecHalvingAdd* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
@@ -361,13 +665,21 @@ void InstructionCodeGeneratorX86_64::VisitVecHalvingAdd(HVecHalvingAdd* instruct
 
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimByte:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
-     __ pavgb(dst, src);
+      DCHECK_EQ(is_wide ? 32u : 16u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpavgb(dst, dst, src);
+      } else {
+        __ pavgb(dst, src);
+      }
      return;
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ pavgw(dst, src);
+      DCHECK_EQ(is_wide ? 16u : 8u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpavgw(dst, dst, src);
+      } else {
+        __ pavgw(dst, src);
+      }
       return;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -381,34 +693,59 @@ void LocationsBuilderX86_64::VisitVecSub(HVecSub* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecSub(HVecSub* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimByte:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
-      __ psubb(dst, src);
+      DCHECK_EQ(is_wide ? 32u : 16u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpsubb(dst, dst, src);
+      } else {
+        __ psubb(dst, src);
+      }
       break;
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ psubw(dst, src);
+      DCHECK_EQ(is_wide ? 16u : 8u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpsubw(dst, dst, src);
+      } else {
+        __ psubw(dst, src);
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ psubd(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpsubd(dst, dst, src);
+      } else {
+        __ psubd(dst, src);
+      }
       break;
     case Primitive::kPrimLong:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ psubq(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpsubq(dst, dst, src);
+      } else {
+        __ psubq(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ subps(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vsubps(dst, dst, src);
+      } else {
+        __ subps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ subpd(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vsubpd(dst, dst, src);
+      } else {
+        __ subpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -422,26 +759,43 @@ void LocationsBuilderX86_64::VisitVecMul(HVecMul* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecMul(HVecMul* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ pmullw(dst, src);
+      DCHECK_EQ(is_wide ? 16u : 8u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpmullw(dst, dst, src);
+      } else {
+        __ pmullw(dst, src);
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ pmulld(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpmulld(dst, dst, src);
+      } else {
+        __ pmulld(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ mulps(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vmulps(dst, dst, src);
+      } else {
+        __ mulps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ mulpd(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vmulpd(dst, dst, src);
+      } else {
+        __ mulpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -455,17 +809,26 @@ void LocationsBuilderX86_64::VisitVecDiv(HVecDiv* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecDiv(HVecDiv* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ divps(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vdivps(dst, dst, src);
+      } else {
+        __ divps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ divpd(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vdivpd(dst, dst, src);
+      } else {
+        __ divpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -479,45 +842,78 @@ void LocationsBuilderX86_64::VisitVecMin(HVecMin* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecMin(HVecMin* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimByte:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(is_wide ? 32u : 16u, instruction->GetVectorLength());
       if (instruction->IsUnsigned()) {
-        __ pminub(dst, src);
+        if (is_wide) {
+          __ vpminub(dst, dst, src);
+        } else {
+          __ pminub(dst, src);
+        }
       } else {
-        __ pminsb(dst, src);
+        if (is_wide) {
+          __ vpminsb(dst, dst, src);
+        } else {
+          __ pminsb(dst, src);
+        }
       }
       break;
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(is_wide ? 16u : 8u, instruction->GetVectorLength());
       if (instruction->IsUnsigned()) {
-        __ pminuw(dst, src);
+        if (is_wide) {
+          __ vpminuw(dst, dst, src);
+        } else {
+          __ pminuw(dst, src);
+        }
       } else {
-        __ pminsw(dst, src);
+        if (is_wide) {
+          __ vpminsw(dst, dst, src);
+        } else {
+          __ pminsw(dst, src);
+        }
       }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
       if (instruction->IsUnsigned()) {
-        __ pminud(dst, src);
+        if (is_wide) {
+          __ vpminud(dst, dst, src);
+        } else {
+          __ pminud(dst, src);
+        }
       } else {
-        __ pminsd(dst, src);
+        if (is_wide) {
+          __ vpminsd(dst, dst, src);
+        } else {
+          __ pminsd(dst, src);
+        }
       }
       break;
     // Next cases are sloppy wrt 0.0 vs -0.0.
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
       DCHECK(!instruction->IsUnsigned());
-      __ minps(dst, src);
+      if (is_wide) {
+        __ vminps(dst, dst, src);
+      } else {
+        __ minps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
       DCHECK(!instruction->IsUnsigned());
-      __ minpd(dst, src);
+      if (is_wide) {
+        __ vminpd(dst, dst, src);
+      } else {
+        __ minpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -531,45 +927,78 @@ void LocationsBuilderX86_64::VisitVecMax(HVecMax* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecMax(HVecMax* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimByte:
-      DCHECK_EQ(16u, instruction->GetVectorLength());
+      DCHECK_EQ(is_wide ? 32u : 16u, instruction->GetVectorLength());
       if (instruction->IsUnsigned()) {
-        __ pmaxub(dst, src);
+        if (is_wide) {
+          __ vpmaxub(dst, dst, src);
+        } else {
+          __ pmaxub(dst, src);
+        }
       } else {
-        __ pmaxsb(dst, src);
+        if (is_wide) {
+          __ vpmaxsb(dst, dst, src);
+        } else {
+          __ pmaxsb(dst, src);
+        }
       }
       break;
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(is_wide ? 16u : 8u, instruction->GetVectorLength());
       if (instruction->IsUnsigned()) {
-        __ pmaxuw(dst, src);
+        if (is_wide) {
+          __ vpmaxuw(dst, dst, src);
+        } else {
+          __ pmaxuw(dst, src);
+        }
       } else {
-        __ pmaxsw(dst, src);
+        if (is_wide) {
+          __ vpmaxsw(dst, dst, src);
+        } else {
+          __ pmaxsw(dst, src);
+        }
       }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
       if (instruction->IsUnsigned()) {
-        __ pmaxud(dst, src);
+        if (is_wide) {
+          __ vpmaxud(dst, dst, src);
+        } else {
+          __ pmaxud(dst, src);
+        }
       } else {
-        __ pmaxsd(dst, src);
+        if (is_wide) {
+          __ vpmaxsd(dst, dst, src);
+        } else {
+          __ pmaxsd(dst, src);
+        }
       }
       break;
     // Next cases are sloppy wrt 0.0 vs -0.0.
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
       DCHECK(!instruction->IsUnsigned());
-      __ maxps(dst, src);
+      if (is_wide) {
+        __ vmaxps(dst, dst, src);
+      } else {
+        __ maxps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
       DCHECK(!instruction->IsUnsigned());
-      __ maxpd(dst, src);
+      if (is_wide) {
+        __ vmaxpd(dst, dst, src);
+      } else {
+        __ maxpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -583,6 +1012,7 @@ void LocationsBuilderX86_64::VisitVecAnd(HVecAnd* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecAnd(HVecAnd* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
@@ -594,16 +1024,28 @@ void InstructionCodeGeneratorX86_64::VisitVecAnd(HVecAnd* instruction) {
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
       DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      __ pand(dst, src);
+      DCHECK_LE(instruction->GetVectorLength(), is_wide ? 32u : 16u);
+      if (is_wide) {
+        __ vpand(dst, dst, src);
+      } else {
+        __ pand(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ andps(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vandps(dst, dst, src);
+      } else {
+        __ andps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ andpd(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vandpd(dst, dst, src);
+      } else {
+        __ andpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -617,6 +1059,7 @@ void LocationsBuilderX86_64::VisitVecAndNot(HVecAndNot* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecAndNot(HVecAndNot* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
@@ -628,16 +1071,28 @@ void InstructionCodeGeneratorX86_64::VisitVecAndNot(HVecAndNot* instruction) {
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
       DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      __ pandn(dst, src);
+      DCHECK_LE(instruction->GetVectorLength(), is_wide ? 32u : 16u);
+      if (is_wide) {
+        __ vpandn(dst, dst, src);
+      } else {
+        __ pandn(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ andnps(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vandnps(dst, dst, src);
+      } else {
+        __ andnps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ andnpd(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vandnpd(dst, dst, src);
+      } else {
+        __ andnpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -651,6 +1106,7 @@ void LocationsBuilderX86_64::VisitVecOr(HVecOr* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecOr(HVecOr* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
@@ -662,16 +1118,28 @@ void InstructionCodeGeneratorX86_64::VisitVecOr(HVecOr* instruction) {
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
       DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      __ por(dst, src);
+      DCHECK_LE(instruction->GetVectorLength(), is_wide ? 32u : 16u);
+      if (is_wide) {
+        __ vpor(dst, dst, src);
+      } else {
+        __ por(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ orps(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vorps(dst, dst, src);
+      } else {
+        __ orps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ orpd(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vorpd(dst, dst, src);
+      } else {
+        __ orpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -685,6 +1153,7 @@ void LocationsBuilderX86_64::VisitVecXor(HVecXor* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecXor(HVecXor* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   XmmRegister src = locations->InAt(1).AsFpuRegister<XmmRegister>();
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
@@ -696,16 +1165,28 @@ void InstructionCodeGeneratorX86_64::VisitVecXor(HVecXor* instruction) {
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
       DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      __ pxor(dst, src);
+      DCHECK_LE(instruction->GetVectorLength(), is_wide ? 32u : 16u);
+      if (is_wide) {
+        __ vpxor(dst, dst, src);
+      } else {
+        __ pxor(dst, src);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ xorps(dst, src);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vxorps(dst, dst, src);
+      } else {
+        __ xorps(dst, src);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ xorpd(dst, src);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vxorpd(dst, dst, src);
+      } else {
+        __ xorpd(dst, src);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -737,22 +1218,36 @@ void LocationsBuilderX86_64::VisitVecShl(HVecShl* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecShl(HVecShl* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
+  Immediate shift_count(static_cast<int8_t>(value));
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ psllw(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_wide ? 16u : 8u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpsllw(dst, dst, shift_count);
+      } else {
+        __ psllw(dst, shift_count);
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ pslld(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpslld(dst, dst, shift_count);
+      } else {
+        __ pslld(dst, shift_count);
+      }
       break;
     case Primitive::kPrimLong:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ psllq(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpsllq(dst, dst, shift_count);
+      } else {
+        __ psllq(dst, shift_count);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -766,18 +1261,28 @@ void LocationsBuilderX86_64::VisitVecShr(HVecShr* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecShr(HVecShr* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
+  Immediate shift_count(static_cast<int8_t>(value));
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ psraw(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_wide ? 16u : 8u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpsraw(dst, dst, shift_count);
+      } else {
+        __ psraw(dst, shift_count);
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ psrad(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpsrad(dst, dst, shift_count);
+      } else {
+        __ psrad(dst, shift_count);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -791,22 +1296,36 @@ void LocationsBuilderX86_64::VisitVecUShr(HVecUShr* instruction) {
 
 void InstructionCodeGeneratorX86_64::VisitVecUShr(HVecUShr* instruction) {
   LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
   DCHECK(locations->InAt(0).Equals(locations->Out()));
   int32_t value = locations->InAt(1).GetConstant()->AsIntConstant()->GetValue();
+  Immediate shift_count(static_cast<int8_t>(value));
   XmmRegister dst = locations->Out().AsFpuRegister<XmmRegister>();
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimChar:
     case Primitive::kPrimShort:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
-      __ psrlw(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_wide ? 16u : 8u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpsrlw(dst, dst, shift_count);
+      } else {
+        __ psrlw(dst, shift_count);
+      }
       break;
     case Primitive::kPrimInt:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      __ psrld(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpsrld(dst, dst, shift_count);
+      } else {
+        __ psrld(dst, shift_count);
+      }
       break;
     case Primitive::kPrimLong:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      __ psrlq(dst, Immediate(static_cast<int8_t>(value)));
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        __ vpsrlq(dst, dst, shift_count);
+      } else {
+        __ psrlq(dst, shift_count);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -822,6 +1341,164 @@ void InstructionCodeGeneratorX86_64::VisitVecMultiplyAccumulate(HVecMultiplyAccu
   LOG(FATAL) << "No SIMD for " << instr->GetId();
 }
 
+// Helper to set up locations for vector accumulations of narrower operands.
+static void CreateVecAccumLocations(ArenaAllocator* arena, HVecOperation* instruction) {
+  LocationSummary* locations = new (arena) LocationSummary(instruction);
+  switch (instruction->GetPackedType()) {
+    case Primitive::kPrimInt:
+      locations->SetInAt(0, Location::RequiresFpuRegister());
+      locations->SetInAt(1, Location::RequiresFpuRegister());
+      locations->SetInAt(2, Location::RequiresFpuRegister());
+      locations->SetOut(Location::SameAsFirstInput());
+      locations->AddTemp(Location::RequiresFpuRegister());
+      locations->AddTemp(Location::RequiresFpuRegister());
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
+}
+
+void LocationsBuilderX86_64::VisitVecDotProd(HVecDotProd* instruction) {
+  CreateVecAccumLocations(GetGraph()->GetArena(), instruction);
+}
+
+void InstructionCodeGeneratorX86_64::VisitVecDotProd(HVecDotProd* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
+  DCHECK(locations->InAt(0).Equals(locations->Out()));
+  XmmRegister acc = locations->InAt(0).AsFpuRegister<XmmRegister>();
+  XmmRegister left = locations->InAt(1).AsFpuRegister<XmmRegister>();
+  XmmRegister right = locations->InAt(2).AsFpuRegister<XmmRegister>();
+  XmmRegister tmp1 = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+  XmmRegister tmp2 = locations->GetTemp(1).AsFpuRegister<XmmRegister>();
+  HVecOperation* a = instruction->InputAt(1)->AsVecOperation();
+  DCHECK_EQ(Primitive::kPrimInt, instruction->GetPackedType());
+  DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+  switch (a->GetPackedType()) {
+    case Primitive::kPrimByte:
+      DCHECK_EQ(is_wide ? 32u : 16u, a->GetVectorLength());
+      // Sign extend the lower and upper bytes into words, and multiply-add those.
+      if (is_wide) {
+        __ vpunpcklbw(tmp1, left, left);
+        __ vpunpcklbw(tmp2, right, right);
+        __ vpsraw(tmp1, tmp1, Immediate(8));
+        __ vpsraw(tmp2, tmp2, Immediate(8));
+        __ vpmaddwd(tmp1, tmp1, tmp2);
+        __ vpaddd(acc, acc, tmp1);
+        __ vpunpckhbw(tmp1, left, left);
+        __ vpunpckhbw(tmp2, right, right);
+        __ vpsraw(tmp1, tmp1, Immediate(8));
+        __ vpsraw(tmp2, tmp2, Immediate(8));
+        __ vpmaddwd(tmp1, tmp1, tmp2);
+        __ vpaddd(acc, acc, tmp1);
+      } else {
+        __ movaps(tmp1, left);
+        __ movaps(tmp2, right);
+        __ punpcklbw(tmp1, tmp1);
+        __ punpcklbw(tmp2, tmp2);
+        __ psraw(tmp1, Immediate(8));
+        __ psraw(tmp2, Immediate(8));
+        __ pmaddwd(tmp1, tmp2);
+        __ paddd(acc, tmp1);
+        __ movaps(tmp1, left);
+        __ movaps(tmp2, right);
+        __ punpckhbw(tmp1, tmp1);
+        __ punpckhbw(tmp2, tmp2);
+        __ psraw(tmp1, Immediate(8));
+        __ psraw(tmp2, Immediate(8));
+        __ pmaddwd(tmp1, tmp2);
+        __ paddd(acc, tmp1);
+      }
+      break;
+    case Primitive::kPrimShort:
+      DCHECK_EQ(is_wide ? 16u : 8u, a->GetVectorLength());
+      if (is_wide) {
+        __ vpmaddwd(tmp1, left, right);
+        __ vpaddd(acc, acc, tmp1);
+      } else {
+        __ movaps(tmp1, left);
+        __ pmaddwd(tmp1, right);
+        __ paddd(acc, tmp1);
+      }
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
+}
+
+void LocationsBuilderX86_64::VisitVecSADAccumulate(HVecSADAccumulate* instruction) {
+  CreateVecAccumLocations(GetGraph()->GetArena(), instruction);
+}
+
+void InstructionCodeGeneratorX86_64::VisitVecSADAccumulate(HVecSADAccumulate* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  bool is_wide = IsWideVector(instruction);
+  DCHECK(locations->InAt(0).Equals(locations->Out()));
+  XmmRegister acc = locations->InAt(0).AsFpuRegister<XmmRegister>();
+  XmmRegister left = locations->InAt(1).AsFpuRegister<XmmRegister>();
+  XmmRegister right = locations->InAt(2).AsFpuRegister<XmmRegister>();
+  XmmRegister tmp1 = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+  XmmRegister tmp2 = locations->GetTemp(1).AsFpuRegister<XmmRegister>();
+  HVecOperation* a = instruction->InputAt(1)->AsVecOperation();
+  DCHECK_EQ(Primitive::kPrimInt, instruction->GetPackedType());
+  DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+  // The signed difference max(x, y) - min(x, y) is exact as an unsigned narrow value.
+  switch (a->GetPackedType()) {
+    case Primitive::kPrimByte:
+      DCHECK_EQ(is_wide ? 32u : 16u, a->GetVectorLength());
+      // Sum each group of eight unsigned byte differences into a quadword.
+      if (is_wide) {
+        __ vpmaxsb(tmp1, left, right);
+        __ vpminsb(tmp2, left, right);
+        __ vpsubb(tmp1, tmp1, tmp2);
+        __ vpxor(tmp2, tmp2, tmp2);
+        __ vpsadbw(tmp1, tmp1, tmp2);
+        __ vpaddd(acc, acc, tmp1);
+      } else {
+        __ movaps(tmp1, left);
+        __ movaps(tmp2, left);
+        __ pmaxsb(tmp1, right);
+        __ pminsb(tmp2, right);
+        __ psubb(tmp1, tmp2);
+        __ pxor(tmp2, tmp2);
+        __ psadbw(tmp1, tmp2);
+        __ paddd(acc, tmp1);
+      }
+      break;
+    case Primitive::kPrimShort:
+      DCHECK_EQ(is_wide ? 16u : 8u, a->GetVectorLength());
+      // Zero extend the lower and upper unsigned word differences into doublewords.
+      if (is_wide) {
+        __ vpmaxsw(tmp1, left, right);
+        __ vpminsw(tmp2, left, right);
+        __ vpsubw(tmp1, tmp1, tmp2);
+        __ vpsrld(tmp2, tmp1, Immediate(16));
+        __ vpslld(tmp1, tmp1, Immediate(16));
+        __ vpsrld(tmp1, tmp1, Immediate(16));
+        __ vpaddd(acc, acc, tmp1);
+        __ vpaddd(acc, acc, tmp2);
+      } else {
+        __ movaps(tmp1, left);
+        __ movaps(tmp2, left);
+        __ pmaxsw(tmp1, right);
+        __ pminsw(tmp2, right);
+        __ psubw(tmp1, tmp2);
+        __ movaps(tmp2, tmp1);
+        __ psrld(tmp2, Immediate(16));
+        __ pslld(tmp1, Immediate(16));
+        __ psrld(tmp1, Immediate(16));
+        __ paddd(acc, tmp1);
+        __ paddd(acc, tmp2);
+      }
+      break;
+    default:
+      LOG(FATAL) << "Unsupported SIMD type";
+      UNREACHABLE();
+  }
+}
+
 // Helper to set up locations for vector memory operations.
 static void CreateVecMemLocations(ArenaAllocator* arena,
                                   HVecMemoryOperation* instruction,
@@ -880,12 +1557,14 @@ void InstructionCodeGeneratorX86_64::VisitVecLoad(HVecLoad* instruction) {
   size_t size = Primitive::ComponentSize(instruction->GetPackedType());
   Address address = VecAddress(locations, size, instruction->IsStringCharAt());
   XmmRegister reg = locations->Out().AsFpuRegister<XmmRegister>();
-  bool is_aligned16 = instruction->GetAlignment().IsAlignedAt(16);
+  bool is_wide = IsWideVector(instruction);
+  bool is_aligned = instruction->GetAlignment().IsAlignedAt(is_wide ? 32 : 16);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimChar:
-      DCHECK_EQ(8u, instruction->GetVectorLength());
+      DCHECK_EQ(is_wide ? 16u : 8u, instruction->GetVectorLength());
       // Special handling of compressed/uncompressed string load.
       if (mirror::kUseStringCompression && instruction->IsStringCharAt()) {
+        DCHECK(!is_wide);
         NearLabel done, not_compressed;
         XmmRegister tmp = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
         // Test compression bit.
@@ -901,7 +1580,7 @@ void InstructionCodeGeneratorX86_64::VisitVecLoad(HVecLoad* instruction) {
         __ jmp(&done);
         // Load 8 direct uncompressed chars.
         __ Bind(&not_compressed);
-        is_aligned16 ?  __ movdqa(reg, address) :  __ movdqu(reg, address);
+        is_aligned ?  __ movdqa(reg, address) :  __ movdqu(reg, address);
         __ Bind(&done);
         return;
       }
@@ -912,16 +1591,28 @@ void InstructionCodeGeneratorX86_64::VisitVecLoad(HVecLoad* instruction) {
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
       DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      is_aligned16 ? __ movdqa(reg, address) : __ movdqu(reg, address);
+      DCHECK_LE(instruction->GetVectorLength(), is_wide ? 32u : 16u);
+      if (is_wide) {
+        is_aligned ? __ vmovdqa(reg, address) : __ vmovdqu(reg, address);
+      } else {
+        is_aligned ? __ movdqa(reg, address) : __ movdqu(reg, address);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      is_aligned16 ? __ movaps(reg, address) : __ movups(reg, address);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        is_aligned ? __ vmovaps(reg, address) : __ vmovups(reg, address);
+      } else {
+        is_aligned ? __ movaps(reg, address) : __ movups(reg, address);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      is_aligned16 ? __ movapd(reg, address) : __ movupd(reg, address);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        is_aligned ? __ vmovapd(reg, address) : __ vmovupd(reg, address);
+      } else {
+        is_aligned ? __ movapd(reg, address) : __ movupd(reg, address);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -938,7 +1629,8 @@ void InstructionCodeGeneratorX86_64::VisitVecStore(HVecStore* instruction) {
   size_t size = Primitive::ComponentSize(instruction->GetPackedType());
   Address address = VecAddress(locations, size, /*is_string_char_at*/ false);
   XmmRegister reg = locations->InAt(2).AsFpuRegister<XmmRegister>();
-  bool is_aligned16 = instruction->GetAlignment().IsAlignedAt(16);
+  bool is_wide = IsWideVector(instruction);
+  bool is_aligned = instruction->GetAlignment().IsAlignedAt(is_wide ? 32 : 16);
   switch (instruction->GetPackedType()) {
     case Primitive::kPrimBoolean:
     case Primitive::kPrimByte:
@@ -947,16 +1639,28 @@ void InstructionCodeGeneratorX86_64::VisitVecStore(HVecStore* instruction) {
     case Primitive::kPrimInt:
     case Primitive::kPrimLong:
       DCHECK_LE(2u, instruction->GetVectorLength());
-      DCHECK_LE(instruction->GetVectorLength(), 16u);
-      is_aligned16 ? __ movdqa(address, reg) : __ movdqu(address, reg);
+      DCHECK_LE(instruction->GetVectorLength(), is_wide ? 32u : 16u);
+      if (is_wide) {
+        is_aligned ? __ vmovdqa(address, reg) : __ vmovdqu(address, reg);
+      } else {
+        is_aligned ? __ movdqa(address, reg) : __ movdqu(address, reg);
+      }
       break;
     case Primitive::kPrimFloat:
-      DCHECK_EQ(4u, instruction->GetVectorLength());
-      is_aligned16 ? __ movaps(address, reg) : __ movups(address, reg);
+      DCHECK_EQ(is_wide ? 8u : 4u, instruction->GetVectorLength());
+      if (is_wide) {
+        is_aligned ? __ vmovaps(address, reg) : __ vmovups(address, reg);
+      } else {
+        is_aligned ? __ movaps(address, reg) : __ movups(address, reg);
+      }
       break;
     case Primitive::kPrimDouble:
-      DCHECK_EQ(2u, instruction->GetVectorLength());
-      is_aligned16 ? __ movapd(address, reg) : __ movupd(address, reg);
+      DCHECK_EQ(is_wide ? 4u : 2u, instruction->GetVectorLength());
+      if (is_wide) {
+        is_aligned ? __ vmovapd(address, reg) : __ vmovupd(address, reg);
+      } else {
+        is_aligned ? __ movapd(address, reg) : __ movupd(address, reg);
+      }
       break;
     default:
       LOG(FATAL) << "Unsupported SIMD type";
@@ -4247,6 +4247,18 @@ void InstructionCodeGeneratorX86::VisitNewArray(HNewArray* instruction) {
   DCHECK(!codegen_->IsLeafMethod());
 }
 
+void LocationsBuilderX86::VisitStackAllocation(
+    HStackAllocation* instruction ATTRIBUTE_UNUSED) {
+  // Objects are only allocated on the stack on ARM64 and x86-64.
+  LOG(FATAL) << "Unreachable";
+}
+
+void InstructionCodeGeneratorX86::VisitStackAllocation(
+    HStackAllocation* instruction ATTRIBUTE_UNUSED) {
+  // Objects are only allocated on the stack on ARM64 and x86-64.
+  LOG(FATAL) << "Unreachable";
+}
+
 void LocationsBuilderX86::VisitParameterValue(HParameterValue* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
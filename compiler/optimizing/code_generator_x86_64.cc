@@ -1161,7 +1161,9 @@ size_t CodeGeneratorX86_64::RestoreCoreRegister(size_t stack_index, uint32_t reg
 }
 
 size_t CodeGeneratorX86_64::SaveFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
-  if (GetGraph()->HasSIMD()) {
+  if (GetGraph()->HasWideSIMD()) {
+    __ vmovups(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
+  } else if (GetGraph()->HasSIMD()) {
     __ movups(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
   } else {
     __ movsd(Address(CpuRegister(RSP), stack_index), XmmRegister(reg_id));
@@ -1170,7 +1172,9 @@ size_t CodeGeneratorX86_64::SaveFloatingPointRegister(size_t stack_index, uint32
 }
 
 size_t CodeGeneratorX86_64::RestoreFloatingPointRegister(size_t stack_index, uint32_t reg_id) {
-  if (GetGraph()->HasSIMD()) {
+  if (GetGraph()->HasWideSIMD()) {
+    __ vmovups(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
+  } else if (GetGraph()->HasSIMD()) {
     __ movups(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
   } else {
     __ movsd(XmmRegister(reg_id), Address(CpuRegister(RSP), stack_index));
@@ -1197,6 +1201,11 @@ void CodeGeneratorX86_64::InvokeRuntimeWithoutRecordingPcInfo(int32_t entry_poin
 }
 
 void CodeGeneratorX86_64::GenerateInvokeRuntime(int32_t entry_point_offset) {
+  if (GetGraph()->HasWideSIMD()) {
+    // Avoid AVX to SSE transition penalties in the runtime. Vector values are never
+    // live across calls, and the slow paths have already saved any live ymm registers.
+    __ vzeroupper();
+  }
   __ gs()->call(Address::Absolute(entry_point_offset, /* no_rip */ true));
 }
 
@@ -1338,6 +1347,9 @@ void CodeGeneratorX86_64::GenerateFrameExit() {
       }
     }
   }
+  if (GetGraph()->HasWideSIMD()) {
+    __ vzeroupper();  // avoid AVX to SSE transition penalties in the caller
+  }
   __ ret();
   __ cfi().RestoreState();
   __ cfi().DefCFAOffset(GetFrameSize());
@@ -4110,6 +4122,33 @@ void InstructionCodeGeneratorX86_64::VisitNewArray(HNewArray* instruction) {
   DCHECK(!codegen_->IsLeafMethod());
 }
 
+void LocationsBuilderX86_64::VisitStackAllocation(HStackAllocation* instruction) {
+  LocationSummary* locations =
+      new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
+  locations->SetInAt(0, Location::RequiresRegister());
+  // The output is written before the class is stored.
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+void InstructionCodeGeneratorX86_64::VisitStackAllocation(HStackAllocation* instruction) {
+  LocationSummary* locations = instruction->GetLocations();
+  CpuRegister cls = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  DCHECK(!kPoisonHeapReferences);
+
+  __ leaq(out, Address(CpuRegister(RSP), instruction->GetFrameOffset()));
+  // Clear the whole object, as the frame slots are reused when the allocation is
+  // executed again (for example in a loop). This also clears the lock word.
+  for (size_t offset = 0; offset < instruction->GetObjectSize(); offset += kX86_64WordSize) {
+    __ movq(Address(out, static_cast<int32_t>(offset)), Immediate(0));
+  }
+  __ movl(Address(out, mirror::Object::ClassOffset().Int32Value()), cls);
+  if (instruction->IsArray()) {
+    __ movl(Address(out, mirror::Array::LengthOffset().Int32Value()),
+            Immediate(instruction->GetArrayLength()));
+  }
+}
+
 void LocationsBuilderX86_64::VisitParameterValue(HParameterValue* instruction) {
   LocationSummary* locations =
       new (GetGraph()->GetArena()) LocationSummary(instruction, LocationSummary::kNoCall);
@@ -5268,8 +5307,13 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
     }
   } else if (source.IsSIMDStackSlot()) {
     DCHECK(destination.IsFpuRegister());
-    __ movups(destination.AsFpuRegister<XmmRegister>(),
-              Address(CpuRegister(RSP), source.GetStackIndex()));
+    if (codegen_->GetGraph()->HasWideSIMD()) {
+      __ vmovups(destination.AsFpuRegister<XmmRegister>(),
+                 Address(CpuRegister(RSP), source.GetStackIndex()));
+    } else {
+      __ movups(destination.AsFpuRegister<XmmRegister>(),
+                Address(CpuRegister(RSP), source.GetStackIndex()));
+    }
   } else if (source.IsConstant()) {
     HConstant* constant = source.GetConstant();
     if (constant->IsIntConstant() || constant->IsNullConstant()) {
@@ -5316,7 +5360,11 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
     }
   } else if (source.IsFpuRegister()) {
     if (destination.IsFpuRegister()) {
-      __ movaps(destination.AsFpuRegister<XmmRegister>(), source.AsFpuRegister<XmmRegister>());
+      if (codegen_->GetGraph()->HasWideSIMD()) {
+        __ vmovaps(destination.AsFpuRegister<XmmRegister>(), source.AsFpuRegister<XmmRegister>());
+      } else {
+        __ movaps(destination.AsFpuRegister<XmmRegister>(), source.AsFpuRegister<XmmRegister>());
+      }
     } else if (destination.IsStackSlot()) {
       __ movss(Address(CpuRegister(RSP), destination.GetStackIndex()),
                source.AsFpuRegister<XmmRegister>());
@@ -5325,8 +5373,13 @@ void ParallelMoveResolverX86_64::EmitMove(size_t index) {
                source.AsFpuRegister<XmmRegister>());
     } else {
        DCHECK(destination.IsSIMDStackSlot());
-      __ movups(Address(CpuRegister(RSP), destination.GetStackIndex()),
-                source.AsFpuRegister<XmmRegister>());
+      if (codegen_->GetGraph()->HasWideSIMD()) {
+        __ vmovups(Address(CpuRegister(RSP), destination.GetStackIndex()),
+                   source.AsFpuRegister<XmmRegister>());
+      } else {
+        __ movups(Address(CpuRegister(RSP), destination.GetStackIndex()),
+                  source.AsFpuRegister<XmmRegister>());
+      }
     }
   }
 }
@@ -5407,9 +5460,23 @@ void ParallelMoveResolverX86_64::EmitSwap(size_t index) {
   } else if (source.IsDoubleStackSlot() && destination.IsDoubleStackSlot()) {
     Exchange64(destination.GetStackIndex(), source.GetStackIndex());
   } else if (source.IsFpuRegister() && destination.IsFpuRegister()) {
-    __ movd(CpuRegister(TMP), source.AsFpuRegister<XmmRegister>());
-    __ movaps(source.AsFpuRegister<XmmRegister>(), destination.AsFpuRegister<XmmRegister>());
-    __ movd(destination.AsFpuRegister<XmmRegister>(), CpuRegister(TMP));
+    XmmRegister src = source.AsFpuRegister<XmmRegister>();
+    XmmRegister dst = destination.AsFpuRegister<XmmRegister>();
+    if (codegen_->GetGraph()->HasWideSIMD()) {
+      // Swap full 256-bit vectors without a scratch register.
+      __ vxorps(src, src, dst);
+      __ vxorps(dst, dst, src);
+      __ vxorps(src, src, dst);
+    } else if (codegen_->GetGraph()->HasSIMD()) {
+      // Swap full 128-bit vectors without a scratch register.
+      __ xorps(src, dst);
+      __ xorps(dst, src);
+      __ xorps(src, dst);
+    } else {
+      __ movd(CpuRegister(TMP), src);
+      __ movaps(src, dst);
+      __ movd(dst, CpuRegister(TMP));
+    }
   } else if (source.IsFpuRegister() && destination.IsStackSlot()) {
     Exchange32(source.AsFpuRegister<XmmRegister>(), destination.GetStackIndex());
   } else if (source.IsStackSlot() && destination.IsFpuRegister()) {
@@ -326,6 +326,9 @@ class CodeGeneratorX86_64 : public CodeGenerator {
   }
 
   size_t GetFloatingPointSpillSlotSize() const OVERRIDE {
+    if (GetGraph()->HasWideSIMD()) {
+      return 4 * kX86_64WordSize;  // 32 bytes == 4 x86_64 words for each spill
+    }
     return GetGraph()->HasSIMD()
         ? 2 * kX86_64WordSize   // 16 bytes == 2 x86_64 words for each spill
         : 1 * kX86_64WordSize;  //  8 bytes == 1 x86_64 words for each spill
@@ -17,6 +17,7 @@
 #include "code_sinking.h"
 
 #include "common_dominator.h"
+#include "escape.h"
 #include "nodes.h"
 
 namespace art {
@@ -250,33 +251,9 @@ void CodeSinking::SinkCodeToUncommonBranch(HBasicBlock* end_block) {
   ArenaVector<HInstruction*> move_in_order(allocator.Adapter(kArenaAllocMisc));
 
   // Step (1): Visit post order to get a subset of blocks post dominated by `end_block`.
-  // TODO(ngeoffray): Getting the full set of post-dominated shoud be done by
-  // computint the post dominator tree, but that could be too time consuming. Also,
-  // we should start the analysis from blocks dominated by an uncommon branch, but we
-  // don't profile branches yet.
-  bool found_block = false;
-  for (HBasicBlock* block : graph_->GetPostOrder()) {
-    if (block == end_block) {
-      found_block = true;
-      post_dominated.SetBit(block->GetBlockId());
-    } else if (found_block) {
-      bool is_post_dominated = true;
-      if (block->GetSuccessors().empty()) {
-        // We currently bail for loops.
-        is_post_dominated = false;
-      } else {
-        for (HBasicBlock* successor : block->GetSuccessors()) {
-          if (!post_dominated.IsBitSet(successor->GetBlockId())) {
-            is_post_dominated = false;
-            break;
-          }
-        }
-      }
-      if (is_post_dominated) {
-        post_dominated.SetBit(block->GetBlockId());
-      }
-    }
-  }
+  // TODO(ngeoffray): We should start the analysis from blocks dominated by an uncommon
+  // branch, but we don't profile branches yet.
+  FindPostDominatedBlocks(graph_, end_block, &post_dominated);
 
   // Now that we have found a subset of post-dominated blocks, add to the worklist all inputs
   // of instructions in these blocks that are not themselves in these blocks.
@@ -182,8 +182,8 @@ inline vixl::aarch64::MemOperand StackOperandFrom(Location location) {
 
 inline vixl::aarch64::MemOperand HeapOperand(const vixl::aarch64::Register& base,
                                                     size_t offset = 0) {
-  // A heap reference must be 32bit, so fit in a W register.
-  DCHECK(base.IsW());
+  // A heap reference must be 32bit, so fit in a W register. The address of a stack
+  // allocated object (see HStackAllocation) is held in an X register.
   return vixl::aarch64::MemOperand(base.X(), offset);
 }
 
@@ -191,8 +191,8 @@ inline vixl::aarch64::MemOperand HeapOperand(const vixl::aarch64::Register& base
                                                     const vixl::aarch64::Register& regoffset,
                                                     vixl::aarch64::Shift shift = vixl::aarch64::LSL,
                                                     unsigned shift_amount = 0) {
-  // A heap reference must be 32bit, so fit in a W register.
-  DCHECK(base.IsW());
+  // A heap reference must be 32bit, so fit in a W register. The address of a stack
+  // allocated object (see HStackAllocation) is held in an X register.
   return vixl::aarch64::MemOperand(base.X(), regoffset, shift, shift_amount);
 }
 
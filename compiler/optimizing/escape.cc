@@ -16,10 +16,38 @@
 
 #include "escape.h"
 
+#include "base/bit_vector-inl.h"
 #include "nodes.h"
 
 namespace art {
 
+// Returns true if `user` makes `reference` visible under another name, in the heap,
+// or to another method.
+static bool IsEscapingUse(HInstruction* reference, HInstruction* user) {
+  if (user->IsBoundType() || user->IsNullCheck()) {
+    // BoundType shouldn't normally be necessary for an allocation. Just be conservative
+    // for the uncommon cases. Similarly, null checks are eventually eliminated for explicit
+    // allocations, but if we see one before it is simplified, assume an alias.
+    return true;
+  } else if (user->IsPhi() || user->IsSelect() || user->IsInvoke() ||
+             (user->IsInstanceFieldSet() && (reference == user->InputAt(1))) ||
+             (user->IsUnresolvedInstanceFieldSet() && (reference == user->InputAt(1))) ||
+             (user->IsStaticFieldSet() && (reference == user->InputAt(1))) ||
+             (user->IsUnresolvedStaticFieldSet() && (reference == user->InputAt(0))) ||
+             (user->IsArraySet() && (reference == user->InputAt(2)))) {
+    // The reference is merged to HPhi/HSelect, passed to a callee, or stored to heap.
+    // Hence, the reference is no longer the only name that can refer to its value.
+    return true;
+  } else if ((user->IsUnresolvedInstanceFieldGet() && (reference == user->InputAt(0))) ||
+             (user->IsUnresolvedInstanceFieldSet() && (reference == user->InputAt(0)))) {
+    // The field is accessed in an unresolved way. We mark the object as a non-singleton.
+    // Note that we could optimize this case and still perform some optimizations until
+    // we hit the unresolved access, but the conservative assumption is the simplest.
+    return true;
+  }
+  return false;
+}
+
 void CalculateEscape(HInstruction* reference,
                      bool (*no_escape)(HInstruction*, HInstruction*),
                      /*out*/ bool* is_singleton,
@@ -43,31 +71,7 @@ void CalculateEscape(HInstruction* reference,
     if (no_escape != nullptr && (*no_escape)(reference, user)) {
       // Client supplied analysis says there is no escape.
       continue;
-    } else if (user->IsBoundType() || user->IsNullCheck()) {
-      // BoundType shouldn't normally be necessary for an allocation. Just be conservative
-      // for the uncommon cases. Similarly, null checks are eventually eliminated for explicit
-      // allocations, but if we see one before it is simplified, assume an alias.
-      *is_singleton = false;
-      *is_singleton_and_not_returned = false;
-      *is_singleton_and_not_deopt_visible = false;
-      return;
-    } else if (user->IsPhi() || user->IsSelect() || user->IsInvoke() ||
-               (user->IsInstanceFieldSet() && (reference == user->InputAt(1))) ||
-               (user->IsUnresolvedInstanceFieldSet() && (reference == user->InputAt(1))) ||
-               (user->IsStaticFieldSet() && (reference == user->InputAt(1))) ||
-               (user->IsUnresolvedStaticFieldSet() && (reference == user->InputAt(0))) ||
-               (user->IsArraySet() && (reference == user->InputAt(2)))) {
-      // The reference is merged to HPhi/HSelect, passed to a callee, or stored to heap.
-      // Hence, the reference is no longer the only name that can refer to its value.
-      *is_singleton = false;
-      *is_singleton_and_not_returned = false;
-      *is_singleton_and_not_deopt_visible = false;
-      return;
-    } else if ((user->IsUnresolvedInstanceFieldGet() && (reference == user->InputAt(0))) ||
-               (user->IsUnresolvedInstanceFieldSet() && (reference == user->InputAt(0)))) {
-      // The field is accessed in an unresolved way. We mark the object as a non-singleton.
-      // Note that we could optimize this case and still perform some optimizations until
-      // we hit the unresolved access, but the conservative assumption is the simplest.
+    } else if (IsEscapingUse(reference, user)) {
       *is_singleton = false;
       *is_singleton_and_not_returned = false;
       *is_singleton_and_not_deopt_visible = false;
@@ -100,4 +104,62 @@ bool DoesNotEscape(HInstruction* reference, bool (*no_escape)(HInstruction*, HIn
   return is_singleton_and_not_returned;
 }
 
+bool IsPartialSingleton(HInstruction* reference, const ArenaBitVector& escape_blocks) {
+  if (!reference->IsNewInstance() && !reference->IsNewArray()) {
+    return false;
+  }
+  if (reference->IsNewInstance() && reference->AsNewInstance()->IsFinalizable()) {
+    // Finalizable objects escape globally.
+    return false;
+  }
+  if (escape_blocks.IsBitSet(reference->GetBlock()->GetBlockId())) {
+    // Nothing to gain, the allocation only lives in the escape blocks.
+    return false;
+  }
+  bool escapes_in_escape_blocks = false;
+  for (const HUseListNode<HInstruction*>& use : reference->GetUses()) {
+    HInstruction* user = use.GetUser();
+    if (IsEscapingUse(reference, user) || user->IsReturn()) {
+      if (!escape_blocks.IsBitSet(user->GetBlock()->GetBlockId())) {
+        return false;
+      }
+      escapes_in_escape_blocks = true;
+    }
+  }
+  for (const HUseListNode<HEnvironment*>& use : reference->GetEnvUses()) {
+    HInstruction* holder = use.GetUser()->GetHolder();
+    if (holder->IsDeoptimize() && !escape_blocks.IsBitSet(holder->GetBlock()->GetBlockId())) {
+      return false;
+    }
+  }
+  return escapes_in_escape_blocks;
+}
+
+void FindPostDominatedBlocks(HGraph* graph, HBasicBlock* end_block, ArenaBitVector* blocks) {
+  // TODO(ngeoffray): Getting the full set of post-dominated shoud be done by
+  // computint the post dominator tree, but that could be too time consuming.
+  for (HBasicBlock* block : graph->GetPostOrder()) {
+    bool is_end_block = (end_block != nullptr)
+        ? (block == end_block)
+        : block->GetLastInstruction()->IsThrow();
+    bool is_post_dominated = true;
+    if (is_end_block) {
+      // Trivially post dominated.
+    } else if (block->GetSuccessors().empty()) {
+      // We currently bail for loops.
+      is_post_dominated = false;
+    } else {
+      for (HBasicBlock* successor : block->GetSuccessors()) {
+        if (!blocks->IsBitSet(successor->GetBlockId())) {
+          is_post_dominated = false;
+          break;
+        }
+      }
+    }
+    if (is_post_dominated) {
+      blocks->SetBit(block->GetBlockId());
+    }
+  }
+}
+
 }  // namespace art
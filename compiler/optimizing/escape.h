@@ -19,6 +19,9 @@
 
 namespace art {
 
+class ArenaBitVector;
+class HBasicBlock;
+class HGraph;
 class HInstruction;
 
 /*
@@ -63,6 +66,25 @@ void CalculateEscape(HInstruction* reference,
  */
 bool DoesNotEscape(HInstruction* reference, bool (*no_escape)(HInstruction*, HInstruction*));
 
+/*
+ * Returns true if the allocation 'reference' only escapes, is returned, or is visible to
+ * an HDeoptimize instruction in 'escape_blocks'. Control flow must never leave
+ * 'escape_blocks' other than to the exit block, as computed by FindPostDominatedBlocks,
+ * so that the reference is a singleton in all other blocks. Optimizations can then treat
+ * the reference as a singleton outside of 'escape_blocks', and sink the allocation into
+ * these blocks.
+ */
+bool IsPartialSingleton(HInstruction* reference, const ArenaBitVector& escape_blocks);
+
+/*
+ * Marks in 'blocks' the blocks post dominated by 'end_block', or by blocks ending in an
+ * HThrow when 'end_block' is null, which are the uncommon branches of the method. Once
+ * in a marked block, control flow only reaches other marked blocks and the exit block.
+ * The result is a subset of the post dominated blocks, as we do not compute the post
+ * dominator tree and blocks in loops are never marked.
+ */
+void FindPostDominatedBlocks(HGraph* graph, HBasicBlock* end_block, ArenaBitVector* blocks);
+
 }  // namespace art
 
 #endif  // ART_COMPILER_OPTIMIZING_ESCAPE_H_
@@ -263,6 +263,9 @@ void GraphChecker::VisitBoundsCheck(HBoundsCheck* check) {
 void GraphChecker::VisitDeoptimize(HDeoptimize* deopt) {
   if (GetGraph()->IsCompilingOsr()) {
     AddError(StringPrintf("A graph compiled OSR cannot have a HDeoptimize instruction"));
+  } else if (!GetGraph()->CanSpeculate()) {
+    AddError(StringPrintf("A graph with speculation disabled cannot have a HDeoptimize "
+                          "instruction"));
   }
 
   // Perform the instruction base checks too.
@@ -538,6 +538,20 @@ class HGraphVisualizerPrinter : public HGraphDelegateVisitor {
     StartAttributeStream("unsigned") << std::boolalpha << max->IsUnsigned() << std::noboolalpha;
   }
 
+  void VisitVecReduce(HVecReduce* reduce) OVERRIDE {
+    switch (reduce->GetKind()) {
+      case HVecReduce::kSum:
+        StartAttributeStream("kind") << "sum";
+        break;
+      case HVecReduce::kMin:
+        StartAttributeStream("kind") << "min";
+        break;
+      case HVecReduce::kMax:
+        StartAttributeStream("kind") << "max";
+        break;
+    }
+  }
+
   void VisitVecMultiplyAccumulate(HVecMultiplyAccumulate* instruction) OVERRIDE {
     StartAttributeStream("kind") << instruction->GetOpKind();
   }
@@ -18,6 +18,7 @@
 
 #include "art_method-inl.h"
 #include "base/enums.h"
+#include "block_frequency.h"
 #include "builder.h"
 #include "class_linker.h"
 #include "constant_folding.h"
@@ -32,6 +33,7 @@
 #include "intrinsics.h"
 #include "jit/jit.h"
 #include "jit/jit_code_cache.h"
+#include "jit/profiling_info.h"
 #include "mirror/class_loader.h"
 #include "mirror/dex_cache.h"
 #include "nodes.h"
@@ -62,9 +64,23 @@ static constexpr size_t kMaximumNumberOfCumulatedDexRegisters = 32;
 // much inlining compared to code locality.
 static constexpr size_t kMaximumNumberOfRecursiveCalls = 4;
 
+// Call sites executed less than once every 50 invocations of the outermost method
+// are cold. They only get to inline methods not much bigger than the call itself,
+// like accessors: the budget accounts for the return and exit instructions.
+static constexpr float kColdCallSiteFrequency = 0.02f;
+static constexpr size_t kMaximumNumberOfInstructionsForColdCallSite = 5;
+
 // Controls the use of inline caches in AOT mode.
 static constexpr bool kUseAOTInlineCaches = true;
 
+// Controls inlining of the dominant receiver types of megamorphic call sites in JIT mode.
+static constexpr bool kUseMegamorphicInlining = true;
+
+// Maximum number of receiver types inlined at a megamorphic call site, and the
+// percentage of the calls they need to account for.
+static constexpr size_t kMaximumNumberOfMegamorphicTargets = 2;
+static constexpr uint32_t kMegamorphicDominancePercentage = 90;
+
 // We check for line numbers to make sure the DepthString implementation
 // aligns the output nicely.
 #define LOG_INTERNAL(msg) \
@@ -123,6 +139,24 @@ void HInliner::UpdateInliningBudget() {
   }
 }
 
+size_t HInliner::GetCallSiteBudget(ArtMethod* method) const {
+  if (call_site_frequency_ >= kColdCallSiteFrequency || IsProfiledAsHot(method)) {
+    return inlining_budget_;
+  }
+  return std::min(inlining_budget_, kMaximumNumberOfInstructionsForColdCallSite);
+}
+
+bool HInliner::IsProfiledAsHot(ArtMethod* method) const {
+  if (Runtime::Current()->UseJitCompilation()) {
+    // The JIT only allocates a profiling info for warm methods.
+    return method->GetProfilingInfo(kRuntimePointerSize) != nullptr;
+  }
+  const ProfileCompilationInfo* pci = compiler_driver_->GetProfileCompilationInfo();
+  return pci != nullptr &&
+      pci->GetMethodHotness(
+          MethodReference(method->GetDexFile(), method->GetDexMethodIndex())).IsHot();
+}
+
 void HInliner::Run() {
   if (graph_->IsDebuggable()) {
     // For simplicity, we currently never inline when the graph is debuggable. This avoids
@@ -151,37 +185,72 @@ void HInliner::Run() {
   const bool honor_inlining_directives =
       IsCompilingWithCoreImage() && Runtime::Current()->IsAotCompiler();
 
-  // Keep a copy of all blocks when starting the visit.
-  ArenaVector<HBasicBlock*> blocks = graph_->GetReversePostOrder();
-  DCHECK(!blocks.empty());
-  // Because we are changing the graph when inlining,
-  // we just iterate over the blocks of the outer method.
-  // This avoids doing the inlining work again on the inlined blocks.
-  for (HBasicBlock* block : blocks) {
-    for (HInstruction* instruction = block->GetFirstInstruction(); instruction != nullptr;) {
-      HInstruction* next = instruction->GetNext();
-      HInvoke* call = instruction->AsInvoke();
+  // Estimate how often each call site executes, from the branch profiles when
+  // there are some. The frequencies are computed again once the optimizations
+  // are done, so do not let other passes use them.
+  ComputeBlockFrequencies(graph_);
+  graph_->SetHasBlockFrequencies(false);
+
+  // Collect the call sites of the outer method before changing the graph. This
+  // avoids doing the inlining work again on the inlined blocks.
+  ArenaVector<std::pair<HInvoke*, float>> call_sites(
+      graph_->GetArena()->Adapter(kArenaAllocOptimization));
+  for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+    float frequency = block->GetFrequency();
+    // Without a profile, only the blocks that end up throwing are known to be cold. The
+    // static estimates split branches evenly, which would make nested call sites cold.
+    if (!graph_->HasBranchProfiles() && !block->GetLastInstruction()->IsThrow()) {
+      frequency = std::max(frequency, kColdCallSiteFrequency);
+    }
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      HInvoke* call = it.Current()->AsInvoke();
       // As long as the call is not intrinsified, it is worth trying to inline.
       if (call != nullptr && call->GetIntrinsic() == Intrinsics::kNone) {
-        if (honor_inlining_directives) {
-          // Debugging case: directives in method names control or assert on inlining.
-          std::string callee_name = outer_compilation_unit_.GetDexFile()->PrettyMethod(
-              call->GetDexMethodIndex(), /* with_signature */ false);
-          // Tests prevent inlining by having $noinline$ in their method names.
-          if (callee_name.find("$noinline$") == std::string::npos) {
-            if (!TryInline(call)) {
-              bool should_have_inlined = (callee_name.find("$inline$") != std::string::npos);
-              CHECK(!should_have_inlined) << "Could not inline " << callee_name;
-            }
-          }
+        call_sites.push_back(std::make_pair(call, outer_frequency_ * frequency));
+      }
+    }
+  }
+  // Inline the hottest call sites first, so that they get the instruction budget
+  // before the cold ones. Call sites of the same frequency keep the program order.
+  std::stable_sort(call_sites.begin(),
+                   call_sites.end(),
+                   [](const std::pair<HInvoke*, float>& lhs,
+                      const std::pair<HInvoke*, float>& rhs) {
+                     return lhs.second > rhs.second;
+                   });
+
+  size_t number_of_inlined_call_sites = 0;
+  for (const std::pair<HInvoke*, float>& call_site : call_sites) {
+    HInvoke* call = call_site.first;
+    call_site_frequency_ = call_site.second;
+    if (honor_inlining_directives) {
+      // Debugging case: directives in method names control or assert on inlining.
+      std::string callee_name = outer_compilation_unit_.GetDexFile()->PrettyMethod(
+          call->GetDexMethodIndex(), /* with_signature */ false);
+      // Tests prevent inlining by having $noinline$ in their method names.
+      if (callee_name.find("$noinline$") == std::string::npos) {
+        bool should_have_inlined = (callee_name.find("$inline$") != std::string::npos);
+        if (should_have_inlined) {
+          // The directive takes precedence over the frequency of the call site.
+          call_site_frequency_ = std::max(call_site_frequency_, kColdCallSiteFrequency);
+        }
+        if (TryInline(call)) {
+          ++number_of_inlined_call_sites;
         } else {
-          // Normal case: try to inline.
-          TryInline(call);
+          CHECK(!should_have_inlined) << "Could not inline " << callee_name;
         }
       }
-      instruction = next;
+    } else if (TryInline(call)) {
+      // Normal case: try to inline.
+      ++number_of_inlined_call_sites;
     }
   }
+  call_site_frequency_ = outer_frequency_;
+
+  LOG_NOTE() << "Inlined " << number_of_inlined_call_sites << " of " << call_sites.size()
+             << " call sites in "
+             << caller_compilation_unit_.GetDexFile()->PrettyMethod(
+                    caller_compilation_unit_.GetDexMethodIndex());
 }
 
 static bool IsMethodOrDeclaringClassFinal(ArtMethod* method)
@@ -366,8 +435,8 @@ ArtMethod* HInliner::TryCHADevirtualization(ArtMethod* resolved_method) {
     // No CHA-based devirtulization for AOT compiler (yet).
     return nullptr;
   }
-  if (outermost_graph_->IsCompilingOsr()) {
-    // We do not support HDeoptimize in OSR methods.
+  if (!outermost_graph_->CanSpeculate()) {
+    // We do not support HDeoptimize in OSR methods, or in methods in a deoptimization storm.
     return nullptr;
   }
   PointerSize pointer_size = caller_compilation_unit_.GetClassLinker()->GetImagePointerSize();
@@ -498,7 +567,10 @@ bool HInliner::UseOnlyPolymorphicInliningWithNoDeopt() {
   //
   // For OSR:
   //     We may come from the interpreter and it may have seen different receiver types.
-  return Runtime::Current()->IsAotCompiler() || outermost_graph_->IsCompilingOsr();
+  //
+  // For JIT methods whose compiled code deoptimized too often:
+  //     The inline caches are not a good prediction of the receiver types anymore.
+  return Runtime::Current()->IsAotCompiler() || !outermost_graph_->CanSpeculate();
 }
 bool HInliner::TryInlineFromInlineCache(const DexFile& caller_dex_file,
                                         HInvoke* invoke_instruction,
@@ -534,7 +606,8 @@ bool HInliner::TryInlineFromInlineCache(const DexFile& caller_dex_file,
     case kInlineCacheMonomorphic: {
       MaybeRecordStat(stats_, kMonomorphicCall);
       if (UseOnlyPolymorphicInliningWithNoDeopt()) {
-        return TryInlinePolymorphicCall(invoke_instruction, resolved_method, inline_cache);
+        return TryInlinePolymorphicCall(
+            invoke_instruction, resolved_method, inline_cache, /* is_megamorphic */ false);
       } else {
         return TryInlineMonomorphicCall(invoke_instruction, resolved_method, inline_cache);
       }
@@ -542,7 +615,14 @@ bool HInliner::TryInlineFromInlineCache(const DexFile& caller_dex_file,
 
     case kInlineCachePolymorphic: {
       MaybeRecordStat(stats_, kPolymorphicCall);
-      return TryInlinePolymorphicCall(invoke_instruction, resolved_method, inline_cache);
+      return TryInlinePolymorphicCall(
+          invoke_instruction, resolved_method, inline_cache, /* is_megamorphic */ false);
+    }
+
+    case kInlineCacheMegamorphicSkewed: {
+      MaybeRecordStat(stats_, kMegamorphicSkewedCall);
+      return TryInlinePolymorphicCall(
+          invoke_instruction, resolved_method, inline_cache, /* is_megamorphic */ true);
     }
 
     case kInlineCacheMegamorphic: {
@@ -587,10 +667,26 @@ HInliner::InlineCacheType HInliner::GetInlineCacheJIT(
     // We can't extract any data if we failed to allocate;
     return kInlineCacheNoData;
   } else {
+    const InlineCache& ic = *profiling_info->GetInlineCache(invoke_instruction->GetDexPc());
+    // Decide from the snapshot of the hit counts taken with the classes, as the
+    // interpreter keeps updating the inline cache.
+    InlineCacheCounts counts;
     Runtime::Current()->GetJit()->GetCodeCache()->CopyInlineCacheInto(
-        *profiling_info->GetInlineCache(invoke_instruction->GetDexPc()),
-        *inline_cache);
-    return GetInlineCacheType(*inline_cache);
+        ic, *inline_cache, &counts);
+    InlineCacheType type = GetInlineCacheType(*inline_cache);
+    if (kUseMegamorphicInlining &&
+        type == kInlineCacheMegamorphic &&
+        counts.IsDominatedBy(kMaximumNumberOfMegamorphicTargets,
+                             kMegamorphicDominancePercentage)) {
+      // The classes are sorted by decreasing frequency: only keep the dominant ones.
+      for (size_t i = kMaximumNumberOfMegamorphicTargets;
+           i < InlineCache::kIndividualCacheSize;
+           ++i) {
+        (*inline_cache)->Set(i, nullptr);
+      }
+      type = kInlineCacheMegamorphicSkewed;
+    }
+    return type;
   }
 }
 
@@ -908,11 +1004,15 @@ HInstruction* HInliner::AddTypeGuard(HInstruction* receiver,
 
 bool HInliner::TryInlinePolymorphicCall(HInvoke* invoke_instruction,
                                         ArtMethod* resolved_method,
-                                        Handle<mirror::ObjectArray<mirror::Class>> classes) {
+                                        Handle<mirror::ObjectArray<mirror::Class>> classes,
+                                        bool is_megamorphic) {
   DCHECK(invoke_instruction->IsInvokeVirtual() || invoke_instruction->IsInvokeInterface())
       << invoke_instruction->DebugName();
 
-  if (TryInlinePolymorphicCallToSameTarget(invoke_instruction, resolved_method, classes)) {
+  // For megamorphic call sites, the guard of the same target optimization would
+  // deoptimize on the non-dominant receiver types.
+  if (!is_megamorphic &&
+      TryInlinePolymorphicCallToSameTarget(invoke_instruction, resolved_method, classes)) {
     return true;
   }
 
@@ -959,7 +1059,8 @@ bool HInliner::TryInlinePolymorphicCall(HInvoke* invoke_instruction,
 
       // If we have inlined all targets before, and this receiver is the last seen,
       // we deoptimize instead of keeping the original invoke instruction.
-      bool deoptimize = !UseOnlyPolymorphicInliningWithNoDeopt() &&
+      bool deoptimize = !is_megamorphic &&
+          !UseOnlyPolymorphicInliningWithNoDeopt() &&
           all_targets_inlined &&
           (i != InlineCache::kIndividualCacheSize - 1) &&
           (classes->Get(i + 1) == nullptr);
@@ -993,7 +1094,7 @@ bool HInliner::TryInlinePolymorphicCall(HInvoke* invoke_instruction,
     return false;
   }
 
-  MaybeRecordStat(stats_, kInlinedPolymorphicCall);
+  MaybeRecordStat(stats_, is_megamorphic ? kInlinedMegamorphicCall : kInlinedPolymorphicCall);
 
   // Run type propagation to get the guards typed.
   ReferenceTypePropagation rtp_fixup(graph_,
@@ -1172,7 +1273,7 @@ bool HInliner::TryInlinePolymorphicCallToSameTarget(
   bb_cursor->InsertInstructionAfter(class_table_get, receiver_class);
   bb_cursor->InsertInstructionAfter(compare, class_table_get);
 
-  if (outermost_graph_->IsCompilingOsr()) {
+  if (!outermost_graph_->CanSpeculate()) {
     CreateDiamondPatternForPolymorphicInline(compare, return_replacement, invoke_instruction);
   } else {
     HDeoptimize* deoptimize = new (graph_->GetArena()) HDeoptimize(
@@ -1322,6 +1423,7 @@ bool HInliner::TryBuildAndInline(HInvoke* invoke_instruction,
       LOG_SUCCESS() << "Successfully replaced pattern of invoke "
                     << method->PrettyMethod();
       MaybeRecordStat(stats_, kReplacedInvokeWithSimplePattern);
+      outermost_graph_->AddInlinedMethod(method);
       return true;
     }
     LOG_FAIL(stats_, kNotInlinedWont)
@@ -1394,6 +1496,7 @@ bool HInliner::TryBuildAndInline(HInvoke* invoke_instruction,
 
   LOG_SUCCESS() << method->PrettyMethod();
   MaybeRecordStat(stats_, kInlinedInvoke);
+  outermost_graph_->AddInlinedMethod(method);
   return true;
 }
 
@@ -1781,6 +1884,7 @@ bool HInliner::TryBuildAndInlineHelper(HInvoke* invoke_instruction,
     return false;
   }
 
+  size_t call_site_budget = GetCallSiteBudget(resolved_method);
   size_t number_of_instructions = 0;
   // Skip the entry block, it does not contain instructions that prevent inlining.
   for (HBasicBlock* block : callee_graph->GetReversePostOrderSkipEntryBlock()) {
@@ -1807,11 +1911,18 @@ bool HInliner::TryBuildAndInlineHelper(HInvoke* invoke_instruction,
     for (HInstructionIterator instr_it(block->GetInstructions());
          !instr_it.Done();
          instr_it.Advance()) {
-      if (++number_of_instructions >= inlining_budget_) {
-        LOG_FAIL(stats_, kNotInlinedInstructionBudget)
-            << "Method " << callee_dex_file.PrettyMethod(method_index)
-            << " is not inlined because the outer method has reached"
-            << " its instruction budget limit.";
+      if (++number_of_instructions >= call_site_budget) {
+        if (call_site_budget < inlining_budget_) {
+          LOG_FAIL(stats_, kNotInlinedColdCallSite)
+              << "Method " << callee_dex_file.PrettyMethod(method_index)
+              << " is not inlined because the call site is cold"
+              << " and the method is too big.";
+        } else {
+          LOG_FAIL(stats_, kNotInlinedInstructionBudget)
+              << "Method " << callee_dex_file.PrettyMethod(method_index)
+              << " is not inlined because the outer method has reached"
+              << " its instruction budget limit.";
+        }
         return false;
       }
       HInstruction* current = instr_it.Current();
@@ -1931,7 +2042,8 @@ void HInliner::RunOptimizations(HGraph* callee_graph,
                    total_number_of_dex_registers_ + code_item->registers_size_,
                    total_number_of_instructions_ + number_of_instructions,
                    this,
-                   depth_ + 1);
+                   depth_ + 1,
+                   call_site_frequency_);
   inliner.Run();
 }
 
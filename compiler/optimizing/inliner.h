@@ -44,7 +44,8 @@ class HInliner : public HOptimization {
            size_t total_number_of_dex_registers,
            size_t total_number_of_instructions,
            HInliner* parent,
-           size_t depth = 0)
+           size_t depth = 0,
+           float outer_frequency = 1.0f)
       : HOptimization(outer_graph, kInlinerPassName, stats),
         outermost_graph_(outermost_graph),
         outer_compilation_unit_(outer_compilation_unit),
@@ -55,6 +56,8 @@ class HInliner : public HOptimization {
         total_number_of_instructions_(total_number_of_instructions),
         parent_(parent),
         depth_(depth),
+        outer_frequency_(outer_frequency),
+        call_site_frequency_(outer_frequency),
         inlining_budget_(0),
         handles_(handles),
         inline_stats_(nullptr) {}
@@ -70,7 +73,10 @@ class HInliner : public HOptimization {
     kInlineCacheMonomorphic = 2,
     kInlineCachePolymorphic = 3,
     kInlineCacheMegamorphic = 4,
-    kInlineCacheMissingTypes = 5
+    kInlineCacheMissingTypes = 5,
+    // Megamorphic, but a few receiver types account for most of the calls. Only the
+    // dominant types are kept in the inline cache.
+    kInlineCacheMegamorphicSkewed = 6
   };
 
   bool TryInline(HInvoke* invoke_instruction);
@@ -169,10 +175,13 @@ class HInliner : public HOptimization {
                                 Handle<mirror::ObjectArray<mirror::Class>> classes)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
-  // Try to inline targets of a polymorphic call.
+  // Try to inline targets of a polymorphic call. If `is_megamorphic` is true, `classes`
+  // only holds the dominant receiver types of the call site, and the original invoke is
+  // always kept as a fallback for the other types instead of deoptimizing.
   bool TryInlinePolymorphicCall(HInvoke* invoke_instruction,
                                 ArtMethod* resolved_method,
-                                Handle<mirror::ObjectArray<mirror::Class>> classes)
+                                Handle<mirror::ObjectArray<mirror::Class>> classes,
+                                bool is_megamorphic)
     REQUIRES_SHARED(Locks::mutator_lock_);
 
   bool TryInlinePolymorphicCallToSameTarget(HInvoke* invoke_instruction,
@@ -269,6 +278,14 @@ class HInliner : public HOptimization {
   // Update the inlining budget based on `total_number_of_instructions_`.
   void UpdateInliningBudget();
 
+  // Returns the instruction budget for inlining `method` at the current call site.
+  // Cold call sites only get to inline tiny methods, unless the profile says
+  // `method` is hot.
+  size_t GetCallSiteBudget(ArtMethod* method) const REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Returns whether the JIT or the AOT profile consider `method` hot.
+  bool IsProfiledAsHot(ArtMethod* method) const REQUIRES_SHARED(Locks::mutator_lock_);
+
   // Count the number of calls of `method` being inlined recursively.
   size_t CountRecursiveCallsOf(ArtMethod* method) const;
 
@@ -288,6 +305,14 @@ class HInliner : public HOptimization {
   const HInliner* const parent_;
   const size_t depth_;
 
+  // The estimated frequency of the call site of `graph_` in the outermost graph,
+  // relative to the entry of the outermost graph.
+  const float outer_frequency_;
+
+  // The estimated frequency of the call site being inlined, relative to the
+  // entry of the outermost graph.
+  float call_site_frequency_;
+
   // The budget left for inlining, in number of instructions.
   size_t inlining_budget_;
   VariableSizedHandleScope* const handles_;
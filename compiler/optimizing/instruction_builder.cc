@@ -22,6 +22,7 @@
 #include "dex_instruction-inl.h"
 #include "driver/compiler_options.h"
 #include "imtable-inl.h"
+#include "jit/profiling_info.h"
 #include "quicken_info.h"
 #include "scoped_thread_state_change-inl.h"
 #include "sharpening.h"
@@ -277,6 +278,19 @@ bool HInstructionBuilder::Build() {
     FindNativeDebugInfoLocations(native_debug_info_locations);
   }
 
+  // Branch profiles of inlined methods are not specific to the call site, so
+  // we only use the ones of the method being compiled.
+  if (graph_->GetArtMethod() != nullptr &&
+      dex_compilation_unit_ == outer_compilation_unit_ &&
+      Runtime::Current()->UseJitCompilation()) {
+    ScopedObjectAccess soa(Thread::Current());
+    ArtMethod* method = graph_->GetArtMethod();
+    if (!method->IsNative()) {
+      // The profiling info is kept alive by the JIT code cache while the method is compiled.
+      profiling_info_ = method->GetProfilingInfo(kRuntimePointerSize);
+    }
+  }
+
   for (HBasicBlock* block : graph_->GetReversePostOrder()) {
     current_block_ = block;
     uint32_t block_dex_pc = current_block_->GetDexPc();
@@ -492,7 +506,13 @@ void HInstructionBuilder::If_22t(const Instruction& instruction, uint32_t dex_pc
   HInstruction* second = LoadLocal(instruction.VRegB(), Primitive::kPrimInt);
   T* comparison = new (arena_) T(first, second, dex_pc);
   AppendInstruction(comparison);
-  AppendInstruction(new (arena_) HIf(comparison, dex_pc));
+  const uint32_t* profile = GetBranchProfile(dex_pc, /* number_of_targets */ 2u);
+  HIf* if_instruction =
+      new (arena_) HIf(SpeculateOnBranchProfile(comparison, profile, dex_pc), dex_pc);
+  if (profile != nullptr) {
+    if_instruction->SetBranchProfile(profile[0], profile[1]);
+  }
+  AppendInstruction(if_instruction);
   current_block_ = nullptr;
 }
 
@@ -501,7 +521,13 @@ void HInstructionBuilder::If_21t(const Instruction& instruction, uint32_t dex_pc
   HInstruction* value = LoadLocal(instruction.VRegA(), Primitive::kPrimInt);
   T* comparison = new (arena_) T(value, graph_->GetIntConstant(0, dex_pc), dex_pc);
   AppendInstruction(comparison);
-  AppendInstruction(new (arena_) HIf(comparison, dex_pc));
+  const uint32_t* profile = GetBranchProfile(dex_pc, /* number_of_targets */ 2u);
+  HIf* if_instruction =
+      new (arena_) HIf(SpeculateOnBranchProfile(comparison, profile, dex_pc), dex_pc);
+  if (profile != nullptr) {
+    if_instruction->SetBranchProfile(profile[0], profile[1]);
+  }
+  AppendInstruction(if_instruction);
   current_block_ = nullptr;
 }
 
@@ -625,30 +651,104 @@ static bool IsFallthroughInstruction(const Instruction& instruction,
 void HInstructionBuilder::BuildSwitch(const Instruction& instruction, uint32_t dex_pc) {
   HInstruction* value = LoadLocal(instruction.VRegA(), Primitive::kPrimInt);
   DexSwitchTable table(instruction, dex_pc);
+  uint32_t num_entries = table.GetNumEntries();
 
-  if (table.GetNumEntries() == 0) {
+  if (num_entries == 0) {
     // Empty Switch. Code falls through to the next block.
     DCHECK(IsFallthroughInstruction(instruction, dex_pc, current_block_));
     AppendInstruction(new (arena_) HGoto(dex_pc));
   } else if (table.ShouldBuildDecisionTree()) {
-    for (DexSwitchTableIterator it(table); !it.Done(); it.Advance()) {
+    // Counts of the cases in table order, followed by the count of the default.
+    const uint32_t* profile = GetBranchProfile(dex_pc, num_entries + 1u);
+    uint64_t remaining_count = 0u;
+    if (profile != nullptr) {
+      for (uint32_t i = 0; i <= num_entries; ++i) {
+        remaining_count += profile[i];
+      }
+    }
+    uint32_t index = 0;
+    for (DexSwitchTableIterator it(table); !it.Done(); it.Advance(), ++index) {
       HInstruction* case_value = graph_->GetIntConstant(it.CurrentKey(), dex_pc);
       HEqual* comparison = new (arena_) HEqual(value, case_value, dex_pc);
       AppendInstruction(comparison);
-      AppendInstruction(new (arena_) HIf(comparison, dex_pc));
+      HIf* if_instruction = new (arena_) HIf(comparison, dex_pc);
+      if (profile != nullptr) {
+        // The false successor tests the remaining cases, and eventually goes to the default.
+        remaining_count -= profile[index];
+        if_instruction->SetBranchProfile(
+            profile[index],
+            dchecked_integral_cast<uint32_t>(
+                std::min<uint64_t>(remaining_count, std::numeric_limits<uint32_t>::max())));
+      }
+      AppendInstruction(if_instruction);
 
       if (!it.IsLast()) {
         current_block_ = FindBlockStartingAt(it.GetDexPcForCurrentIndex());
       }
     }
   } else {
-    AppendInstruction(
-        new (arena_) HPackedSwitch(table.GetEntryAt(0), table.GetNumEntries(), value, dex_pc));
+    HPackedSwitch* packed_switch =
+        new (arena_) HPackedSwitch(table.GetEntryAt(0), num_entries, value, dex_pc);
+    packed_switch->SetCaseCounts(GetBranchProfile(dex_pc, num_entries + 1u));
+    AppendInstruction(packed_switch);
   }
 
   current_block_ = nullptr;
 }
 
+const uint32_t* HInstructionBuilder::GetBranchProfile(uint32_t dex_pc,
+                                                     uint32_t number_of_targets) {
+  if (profiling_info_ == nullptr) {
+    return nullptr;
+  }
+  const BranchCache* cache = profiling_info_->GetBranchCache(dex_pc);
+  if (cache == nullptr || cache->GetNumberOfTargets() != number_of_targets) {
+    return nullptr;
+  }
+  // The interpreter keeps updating the counters, so take a snapshot to have
+  // consistent counts during the whole compilation.
+  uint32_t* counts = arena_->AllocArray<uint32_t>(number_of_targets, kArenaAllocGraphBuilder);
+  bool executed = false;
+  for (uint32_t i = 0; i != number_of_targets; ++i) {
+    counts[i] = profiling_info_->GetBranchCount(*cache, i);
+    executed = executed || (counts[i] != 0u);
+  }
+  if (!executed) {
+    // Not executed yet, the profile does not tell anything.
+    return nullptr;
+  }
+  graph_->SetHasBranchProfiles(true);
+  return counts;
+}
+
+// Minimum number of executions of a branch, all going to the same successor,
+// before we speculate that the other successor is never taken.
+static constexpr uint32_t kMinimumCountForColdBranch = 1000u;
+
+HInstruction* HInstructionBuilder::SpeculateOnBranchProfile(HInstruction* condition,
+                                                          const uint32_t* profile,
+                                                          uint32_t dex_pc) {
+  if (profile == nullptr || !graph_->CanSpeculate()) {
+    return condition;
+  }
+  bool true_is_cold = (profile[0] == 0u) && (profile[1] >= kMinimumCountForColdBranch);
+  bool false_is_cold = (profile[1] == 0u) && (profile[0] >= kMinimumCountForColdBranch);
+  if (!true_is_cold && !false_is_cold) {
+    return condition;
+  }
+  // Deoptimize when the cold successor would be taken. The environment is the
+  // one before the branch, so the interpreter re-executes the branch.
+  HDeoptimize* deoptimize =
+      new (arena_) HDeoptimize(arena_, condition, DeoptimizationKind::kColdBranch, dex_pc);
+  AppendInstruction(deoptimize);
+  if (false_is_cold) {
+    HInstruction* opposite = graph_->InsertOppositeCondition(condition, deoptimize);
+    deoptimize->ReplaceInput(opposite, 0);
+  }
+  MaybeRecordStat(compilation_stats_, MethodCompilationStat::kColdBranchPruned);
+  return graph_->GetIntConstant(false_is_cold ? 1 : 0, dex_pc);
+}
+
 void HInstructionBuilder::BuildReturn(const Instruction& instruction,
                                       Primitive::Type type,
                                       uint32_t dex_pc) {
@@ -34,6 +34,7 @@ namespace art {
 
 class CodeGenerator;
 class Instruction;
+class ProfilingInfo;
 
 class HInstructionBuilder : public ValueObject {
  public:
@@ -71,6 +72,7 @@ class HInstructionBuilder : public ValueObject {
         quicken_info_(interpreter_metadata),
         compilation_stats_(compiler_stats),
         dex_cache_(dex_cache),
+        profiling_info_(nullptr),
         loop_headers_(graph->GetArena()->Adapter(kArenaAllocGraphBuilder)) {
     loop_headers_.reserve(kDefaultNumberOfLoops);
   }
@@ -106,6 +108,18 @@ class HInstructionBuilder : public ValueObject {
 
   void InitializeParameters();
 
+  // Returns a copy of the branch profile collected by the interpreter for the
+  // branch or switch instruction at `dex_pc`, or null if there is none.
+  const uint32_t* GetBranchProfile(uint32_t dex_pc, uint32_t number_of_targets);
+
+  // Returns the input of the HIf testing `condition` at `dex_pc`. If `profile`
+  // shows that one successor has never been taken, guards that assumption with
+  // an HDeoptimize and returns a constant, so that dead code elimination removes
+  // the cold successor.
+  HInstruction* SpeculateOnBranchProfile(HInstruction* condition,
+                                         const uint32_t* profile,
+                                         uint32_t dex_pc);
+
   // Returns whether the current method needs access check for the type.
   // Output parameter finalizable is set to whether the type is finalizable.
   bool NeedsAccessCheck(dex::TypeIndex type_index, /*out*/bool* finalizable) const
@@ -355,6 +369,10 @@ class HInstructionBuilder : public ValueObject {
   OptimizingCompilerStats* compilation_stats_;
   Handle<mirror::DexCache> dex_cache_;
 
+  // The profiling info of the method being compiled, when it holds branch
+  // profiles. Always null when compiling an inlined method.
+  ProfilingInfo* profiling_info_;
+
   ArenaVector<HBasicBlock*> loop_headers_;
 
   static constexpr int kDefaultNumberOfLoops = 2;
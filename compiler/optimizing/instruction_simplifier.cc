@@ -864,6 +864,7 @@ void InstructionSimplifierVisitor::VisitIf(HIf* instruction) {
     // Swap successors if input is negated.
     instruction->ReplaceInput(condition->InputAt(0), 0);
     instruction->GetBlock()->SwapSuccessors();
+    instruction->SwapBranchProfile();
     RecordSimplification();
   }
 }
@@ -1976,6 +1977,14 @@ void InstructionSimplifierVisitor::SimplifySystemArrayCopy(HInvoke* instruction)
       // is unlikely that it exists. The most usual situation for such typed
       // arraycopy methods is a direct pointer to the boot image.
       HSharpening::SharpenInvokeStaticOrDirect(invoke, codegen_, compiler_driver_);
+      // Most typed arraycopy methods have their own intrinsic, which unlike the generic
+      // one does not need to bail out to the runtime for primitive arrays.
+      if (method->IsIntrinsic()) {
+        invoke->SetIntrinsic(static_cast<Intrinsics>(method->GetIntrinsic()),
+                             kNeedsEnvironmentOrCache,
+                             kAllSideEffects,
+                             kCanThrow);
+      }
     }
   }
 }
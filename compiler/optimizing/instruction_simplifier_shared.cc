@@ -239,6 +239,10 @@ bool TryExtractArrayAccessAddress(HInstruction* access,
     // memory access instruction, so do not split the access.
     return false;
   }
+  if (array->IsStackAllocation()) {
+    // The intermediate address is a 32-bit value, which cannot hold a stack address.
+    return false;
+  }
   if (access->IsArraySet() &&
       access->AsArraySet()->GetValue()->GetType() == Primitive::kPrimNot) {
     // The access may require a runtime call or the original array pointer.
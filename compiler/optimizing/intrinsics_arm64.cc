@@ -51,6 +51,7 @@ using helpers::LocationFrom;
 using helpers::OperandFrom;
 using helpers::RegisterFrom;
 using helpers::SRegisterFrom;
+using helpers::VRegisterFrom;
 using helpers::WRegisterFrom;
 using helpers::XRegisterFrom;
 using helpers::InputRegisterAt;
@@ -1239,6 +1240,146 @@ void IntrinsicCodeGeneratorARM64::VisitUnsafeCASObject(HInvoke* invoke) {
   GenCas(invoke, Primitive::kPrimNot, codegen_);
 }
 
+static void CreateUnsafeGetAndUpdateLocations(ArenaAllocator* arena,
+                                              HInvoke* invoke,
+                                              Primitive::Type type) {
+  bool can_call = kEmitCompilerReadBarrier &&
+      kUseBakerReadBarrier &&
+      (invoke->GetIntrinsic() == Intrinsics::kUnsafeGetAndSetObject);
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           (can_call
+                                                                ? LocationSummary::kCallOnSlowPath
+                                                                : LocationSummary::kNoCall),
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::NoLocation());        // Unused receiver.
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetInAt(2, Location::RequiresRegister());
+  locations->SetInAt(3, Location::RequiresRegister());
+  // The old value is loaded in the loop that still reads the inputs.
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+  // Pointer to the field.
+  locations->AddTemp(Location::RequiresRegister());
+  if (type == Primitive::kPrimNot && kEmitCompilerReadBarrier && kUseBakerReadBarrier) {
+    // Temporary register for (Baker) read barrier.
+    locations->AddTemp(Location::RequiresRegister());
+  }
+}
+
+// Unsafe.getAndAdd*() and Unsafe.getAndSet*(). These are volatile accesses: the exclusive
+// load-acquire and store-release pair orders them like the CAS intrinsics above.
+static void GenUnsafeGetAndUpdate(HInvoke* invoke,
+                                  Primitive::Type type,
+                                  bool is_add,
+                                  CodeGeneratorARM64* codegen) {
+  MacroAssembler* masm = codegen->GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Location out_loc = locations->Out();
+  Register out = RegisterFrom(out_loc, type);                      // Old value.
+  Register base = WRegisterFrom(locations->InAt(1));               // Object pointer.
+  Location offset_loc = locations->InAt(2);
+  Register offset = XRegisterFrom(offset_loc);                     // Long offset.
+  Register value = RegisterFrom(locations->InAt(3), type);         // Value to add or set.
+  Register tmp_ptr = XRegisterFrom(locations->GetTemp(0));         // Pointer to actual memory.
+
+  // This needs to be before the temp registers, as MarkGCCard also uses VIXL temps.
+  if (type == Primitive::kPrimNot) {
+    DCHECK(!is_add);
+    bool value_can_be_null = true;  // TODO: Worth finding out this information?
+    codegen->MarkGCCard(base, value, value_can_be_null);
+
+    // The only read barrier implementation supporting the
+    // UnsafeGetAndSetObject intrinsic is the Baker-style read barriers.
+    DCHECK(!kEmitCompilerReadBarrier || kUseBakerReadBarrier);
+
+    if (kEmitCompilerReadBarrier && kUseBakerReadBarrier) {
+      Register temp = WRegisterFrom(locations->GetTemp(1));
+      // Make sure the reference stored in the field is a to-space one, so
+      // that the old value returned by the exchange is one too.
+      codegen->UpdateReferenceFieldWithBakerReadBarrier(
+          invoke,
+          out_loc,  // Unused, used only as a "temporary" within the read barrier.
+          base,
+          /* field_offset */ offset_loc,
+          temp,
+          /* needs_null_check */ false,
+          /* use_load_acquire */ false);
+    }
+  }
+
+  __ Add(tmp_ptr, base.X(), Operand(offset));
+
+  UseScratchRegisterScope temps(masm);
+  Register status = temps.AcquireW();
+  Register new_value = value;
+  if (is_add) {
+    new_value = temps.AcquireSameSizeAs(value);
+  } else if (kPoisonHeapReferences && type == Primitive::kPrimNot) {
+    new_value = temps.AcquireW();
+    __ Mov(new_value, value);
+    codegen->GetAssembler()->PoisonHeapReference(new_value);
+  }
+
+  // do {
+  //   out = [tmp_ptr];
+  // } while (failure([tmp_ptr] <- is_add ? out + value : value));
+
+  vixl::aarch64::Label loop_head;
+  __ Bind(&loop_head);
+  __ Ldaxr(out, MemOperand(tmp_ptr));
+  if (is_add) {
+    __ Add(new_value, out, value);
+  }
+  __ Stlxr(status, new_value, MemOperand(tmp_ptr));
+  __ Cbnz(status, &loop_head);
+
+  if (type == Primitive::kPrimNot) {
+    codegen->GetAssembler()->MaybeUnpoisonHeapReference(out);
+  }
+}
+
+void IntrinsicLocationsBuilderARM64::VisitUnsafeGetAndAddInt(HInvoke* invoke) {
+  CreateUnsafeGetAndUpdateLocations(arena_, invoke, Primitive::kPrimInt);
+}
+void IntrinsicLocationsBuilderARM64::VisitUnsafeGetAndAddLong(HInvoke* invoke) {
+  CreateUnsafeGetAndUpdateLocations(arena_, invoke, Primitive::kPrimLong);
+}
+void IntrinsicLocationsBuilderARM64::VisitUnsafeGetAndSetInt(HInvoke* invoke) {
+  CreateUnsafeGetAndUpdateLocations(arena_, invoke, Primitive::kPrimInt);
+}
+void IntrinsicLocationsBuilderARM64::VisitUnsafeGetAndSetLong(HInvoke* invoke) {
+  CreateUnsafeGetAndUpdateLocations(arena_, invoke, Primitive::kPrimLong);
+}
+void IntrinsicLocationsBuilderARM64::VisitUnsafeGetAndSetObject(HInvoke* invoke) {
+  // The only read barrier implementation supporting the
+  // UnsafeGetAndSetObject intrinsic is the Baker-style read barriers.
+  if (kEmitCompilerReadBarrier && !kUseBakerReadBarrier) {
+    return;
+  }
+
+  CreateUnsafeGetAndUpdateLocations(arena_, invoke, Primitive::kPrimNot);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitUnsafeGetAndAddInt(HInvoke* invoke) {
+  GenUnsafeGetAndUpdate(invoke, Primitive::kPrimInt, /* is_add */ true, codegen_);
+}
+void IntrinsicCodeGeneratorARM64::VisitUnsafeGetAndAddLong(HInvoke* invoke) {
+  GenUnsafeGetAndUpdate(invoke, Primitive::kPrimLong, /* is_add */ true, codegen_);
+}
+void IntrinsicCodeGeneratorARM64::VisitUnsafeGetAndSetInt(HInvoke* invoke) {
+  GenUnsafeGetAndUpdate(invoke, Primitive::kPrimInt, /* is_add */ false, codegen_);
+}
+void IntrinsicCodeGeneratorARM64::VisitUnsafeGetAndSetLong(HInvoke* invoke) {
+  GenUnsafeGetAndUpdate(invoke, Primitive::kPrimLong, /* is_add */ false, codegen_);
+}
+void IntrinsicCodeGeneratorARM64::VisitUnsafeGetAndSetObject(HInvoke* invoke) {
+  // The only read barrier implementation supporting the
+  // UnsafeGetAndSetObject intrinsic is the Baker-style read barriers.
+  DCHECK(!kEmitCompilerReadBarrier || kUseBakerReadBarrier);
+
+  GenUnsafeGetAndUpdate(invoke, Primitive::kPrimNot, /* is_add */ false, codegen_);
+}
+
 void IntrinsicLocationsBuilderARM64::VisitStringCompareTo(HInvoke* invoke) {
   LocationSummary* locations = new (arena_) LocationSummary(invoke,
                                                             invoke->InputAt(1)->CanBeNull()
@@ -2095,9 +2236,9 @@ void IntrinsicCodeGeneratorARM64::VisitStringGetCharsNoCheck(HInvoke* invoke) {
   __ Bind(&done);
 }
 
-// Mirrors ARRAYCOPY_SHORT_CHAR_ARRAY_THRESHOLD in libcore, so we can choose to use the native
-// implementation there for longer copy lengths.
-static constexpr int32_t kSystemArrayCopyCharThreshold = 32;
+// Mirrors the ARRAYCOPY_SHORT_*_ARRAY_THRESHOLD constants in libcore, so we can choose to use
+// the native implementation there for longer copy lengths.
+static constexpr int32_t kSystemArrayCopyPrimitiveThreshold = 32;
 
 static void SetSystemArrayCopyLocationRequires(LocationSummary* locations,
                                                uint32_t at,
@@ -2110,7 +2251,7 @@ static void SetSystemArrayCopyLocationRequires(LocationSummary* locations,
   }
 }
 
-void IntrinsicLocationsBuilderARM64::VisitSystemArrayCopyChar(HInvoke* invoke) {
+static void CreateSystemArrayCopyPrimitiveLocations(ArenaAllocator* allocator, HInvoke* invoke) {
   // Check to see if we have known failures that will cause us to have to bail out
   // to the runtime, and just generate the runtime call directly.
   HIntConstant* src_pos = invoke->InputAt(1)->AsIntConstant();
@@ -2128,17 +2269,16 @@ void IntrinsicLocationsBuilderARM64::VisitSystemArrayCopyChar(HInvoke* invoke) {
   HIntConstant* length = invoke->InputAt(4)->AsIntConstant();
   if (length != nullptr) {
     int32_t len = length->GetValue();
-    if (len < 0 || len > kSystemArrayCopyCharThreshold) {
+    if (len < 0 || len > kSystemArrayCopyPrimitiveThreshold) {
       // Just call as normal.
       return;
     }
   }
 
-  ArenaAllocator* allocator = invoke->GetBlock()->GetGraph()->GetArena();
   LocationSummary* locations = new (allocator) LocationSummary(invoke,
                                                                LocationSummary::kCallOnSlowPath,
                                                                kIntrinsified);
-  // arraycopy(char[] src, int src_pos, char[] dst, int dst_pos, int length).
+  // arraycopy(T[] src, int src_pos, T[] dst, int dst_pos, int length).
   locations->SetInAt(0, Location::RequiresRegister());
   SetSystemArrayCopyLocationRequires(locations, 1, invoke->InputAt(1));
   locations->SetInAt(2, Location::RequiresRegister());
@@ -2207,8 +2347,8 @@ static void GenSystemArrayCopyAddresses(MacroAssembler* masm,
                                         const Register& src_base,
                                         const Register& dst_base,
                                         const Register& src_end) {
-  // This routine is used by the SystemArrayCopy and the SystemArrayCopyChar intrinsics.
-  DCHECK(type == Primitive::kPrimNot || type == Primitive::kPrimChar)
+  // This routine is used by the SystemArrayCopy and the typed SystemArrayCopy* intrinsics.
+  DCHECK(type == Primitive::kPrimNot || Primitive::IsIntegralType(type))
       << "Unexpected element type: " << type;
   const int32_t element_size = Primitive::ComponentSize(type);
   const int32_t element_size_shift = Primitive::ComponentSizeShift(type);
@@ -2238,8 +2378,10 @@ static void GenSystemArrayCopyAddresses(MacroAssembler* masm,
   }
 }
 
-void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopyChar(HInvoke* invoke) {
-  MacroAssembler* masm = GetVIXLAssembler();
+static void GenSystemArrayCopyPrimitive(HInvoke* invoke,
+                                        CodeGeneratorARM64* codegen,
+                                        Primitive::Type type) {
+  MacroAssembler* masm = codegen->GetVIXLAssembler();
   LocationSummary* locations = invoke->GetLocations();
   Register src = XRegisterFrom(locations->InAt(0));
   Location src_pos = locations->InAt(1);
@@ -2247,8 +2389,9 @@ void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopyChar(HInvoke* invoke) {
   Location dst_pos = locations->InAt(3);
   Location length = locations->InAt(4);
 
-  SlowPathCodeARM64* slow_path = new (GetAllocator()) IntrinsicSlowPathARM64(invoke);
-  codegen_->AddSlowPath(slow_path);
+  SlowPathCodeARM64* slow_path =
+      new (codegen->GetGraph()->GetArena()) IntrinsicSlowPathARM64(invoke);
+  codegen->AddSlowPath(slow_path);
 
   // If source and destination are the same, take the slow path. Overlapping copy regions must be
   // copied in reverse and we can't know in all cases if it's needed.
@@ -2265,12 +2408,13 @@ void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopyChar(HInvoke* invoke) {
     // Merge the following two comparisons into one:
     //   If the length is negative, bail out (delegate to libcore's native implementation).
     //   If the length > 32 then (currently) prefer libcore's native implementation.
-    __ Cmp(WRegisterFrom(length), kSystemArrayCopyCharThreshold);
+    __ Cmp(WRegisterFrom(length), kSystemArrayCopyPrimitiveThreshold);
     __ B(slow_path->GetEntryLabel(), hi);
   } else {
     // We have already checked in the LocationsBuilder for the constant case.
     DCHECK_GE(length.GetConstant()->AsIntConstant()->GetValue(), 0);
-    DCHECK_LE(length.GetConstant()->AsIntConstant()->GetValue(), 32);
+    DCHECK_LE(length.GetConstant()->AsIntConstant()->GetValue(),
+              kSystemArrayCopyPrimitiveThreshold);
   }
 
   Register src_curr_addr = WRegisterFrom(locations->GetTemp(0));
@@ -2298,7 +2442,7 @@ void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopyChar(HInvoke* invoke) {
   src_stop_addr = src_stop_addr.X();
 
   GenSystemArrayCopyAddresses(masm,
-                              Primitive::kPrimChar,
+                              type,
                               src,
                               src_pos,
                               dst,
@@ -2308,22 +2452,629 @@ void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopyChar(HInvoke* invoke) {
                               dst_curr_addr,
                               src_stop_addr);
 
-  // Iterate over the arrays and do a raw copy of the chars.
-  const int32_t char_size = Primitive::ComponentSize(Primitive::kPrimChar);
+  // Iterate over the arrays and do a raw copy of the elements, 16 bytes at a time
+  // first, and then one element at a time.
+  const int32_t element_size = Primitive::ComponentSize(type);
   UseScratchRegisterScope temps(masm);
-  Register tmp = temps.AcquireW();
-  vixl::aarch64::Label loop, done;
-  __ Bind(&loop);
+  Register tmp = temps.AcquireX();
+  VRegister vtmp = temps.AcquireVRegisterOfSize(kQRegSize);
+  vixl::aarch64::Label vector_loop, element_loop, done;
+  __ Bind(&vector_loop);
+  __ Sub(tmp, src_stop_addr, src_curr_addr);
+  __ Cmp(tmp, kQRegSizeInBytes);
+  __ B(&element_loop, lt);
+  __ Ldr(vtmp.Q(), MemOperand(src_curr_addr, kQRegSizeInBytes, PostIndex));
+  __ Str(vtmp.Q(), MemOperand(dst_curr_addr, kQRegSizeInBytes, PostIndex));
+  __ B(&vector_loop);
+  __ Bind(&element_loop);
   __ Cmp(src_curr_addr, src_stop_addr);
   __ B(&done, eq);
-  __ Ldrh(tmp, MemOperand(src_curr_addr, char_size, PostIndex));
-  __ Strh(tmp, MemOperand(dst_curr_addr, char_size, PostIndex));
-  __ B(&loop);
+  switch (type) {
+    case Primitive::kPrimByte:
+      __ Ldrb(tmp.W(), MemOperand(src_curr_addr, element_size, PostIndex));
+      __ Strb(tmp.W(), MemOperand(dst_curr_addr, element_size, PostIndex));
+      break;
+    case Primitive::kPrimChar:
+    case Primitive::kPrimShort:
+      __ Ldrh(tmp.W(), MemOperand(src_curr_addr, element_size, PostIndex));
+      __ Strh(tmp.W(), MemOperand(dst_curr_addr, element_size, PostIndex));
+      break;
+    case Primitive::kPrimInt:
+      __ Ldr(tmp.W(), MemOperand(src_curr_addr, element_size, PostIndex));
+      __ Str(tmp.W(), MemOperand(dst_curr_addr, element_size, PostIndex));
+      break;
+    case Primitive::kPrimLong:
+      __ Ldr(tmp, MemOperand(src_curr_addr, element_size, PostIndex));
+      __ Str(tmp, MemOperand(dst_curr_addr, element_size, PostIndex));
+      break;
+    default:
+      LOG(FATAL) << "Unexpected element type: " << type;
+      UNREACHABLE();
+  }
+  __ B(&element_loop);
   __ Bind(&done);
 
   __ Bind(slow_path->GetExitLabel());
 }
 
+void IntrinsicLocationsBuilderARM64::VisitSystemArrayCopyByte(HInvoke* invoke) {
+  CreateSystemArrayCopyPrimitiveLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopyByte(HInvoke* invoke) {
+  GenSystemArrayCopyPrimitive(invoke, codegen_, Primitive::kPrimByte);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitSystemArrayCopyChar(HInvoke* invoke) {
+  CreateSystemArrayCopyPrimitiveLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopyChar(HInvoke* invoke) {
+  GenSystemArrayCopyPrimitive(invoke, codegen_, Primitive::kPrimChar);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitSystemArrayCopyShort(HInvoke* invoke) {
+  CreateSystemArrayCopyPrimitiveLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopyShort(HInvoke* invoke) {
+  GenSystemArrayCopyPrimitive(invoke, codegen_, Primitive::kPrimShort);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitSystemArrayCopyInt(HInvoke* invoke) {
+  CreateSystemArrayCopyPrimitiveLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopyInt(HInvoke* invoke) {
+  GenSystemArrayCopyPrimitive(invoke, codegen_, Primitive::kPrimInt);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitSystemArrayCopyLong(HInvoke* invoke) {
+  CreateSystemArrayCopyPrimitiveLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitSystemArrayCopyLong(HInvoke* invoke) {
+  GenSystemArrayCopyPrimitive(invoke, codegen_, Primitive::kPrimLong);
+}
+
+static void CreateArraysEqualsLocations(ArenaAllocator* arena, HInvoke* invoke) {
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kNoCall,
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->SetOut(Location::RequiresRegister());
+}
+
+static void GenArraysEquals(MacroAssembler* masm,
+                            LocationSummary* locations,
+                            Primitive::Type type) {
+  Register array1 = WRegisterFrom(locations->InAt(0));
+  Register array2 = WRegisterFrom(locations->InAt(1));
+  Register out = XRegisterFrom(locations->Out());
+  Register count = XRegisterFrom(locations->GetTemp(0));
+  Register temp = XRegisterFrom(locations->GetTemp(1));
+  Register ptr1 = XRegisterFrom(locations->GetTemp(2));
+  Register ptr2 = XRegisterFrom(locations->GetTemp(3));
+  VRegister vector1 = VRegisterFrom(locations->GetTemp(4));
+  VRegister vector2 = VRegisterFrom(locations->GetTemp(5));
+
+  const int32_t element_size = Primitive::ComponentSize(type);
+  const uint32_t length_offset = mirror::Array::LengthOffset().Uint32Value();
+  const uint32_t data_offset = mirror::Array::DataOffset(element_size).Uint32Value();
+
+  vixl::aarch64::Label vector_loop, tail, element_loop, return_true, return_false, end;
+
+  // The same array, or both null: equal.
+  __ Cmp(array1, array2);
+  __ B(&return_true, eq);
+
+  // Only one of them null: not equal.
+  __ Cbz(array1, &return_false);
+  __ Cbz(array2, &return_false);
+
+  // Different lengths: not equal.
+  __ Ldr(count.W(), HeapOperand(array1, length_offset));
+  __ Ldr(temp.W(), HeapOperand(array2, length_offset));
+  __ Cmp(count.W(), temp.W());
+  __ B(&return_false, ne);
+
+  // Compare the contents as raw bytes. `count` holds the number of bytes left to compare.
+  __ Lsl(count, count, Primitive::ComponentSizeShift(type));
+  __ Add(ptr1, array1.X(), data_offset);
+  __ Add(ptr2, array2.X(), data_offset);
+
+  // Compare 16 bytes at a time.
+  __ Bind(&vector_loop);
+  __ Cmp(count, kQRegSizeInBytes);
+  __ B(&tail, lt);
+  __ Ldr(vector1.Q(), MemOperand(ptr1, kQRegSizeInBytes, PostIndex));
+  __ Ldr(vector2.Q(), MemOperand(ptr2, kQRegSizeInBytes, PostIndex));
+  __ Cmeq(vector1.V16B(), vector1.V16B(), vector2.V16B());
+  // All the bytes are 0xff if and only if all the bytes compared equal.
+  __ Uminv(vector1.B(), vector1.V16B());
+  __ Umov(temp.W(), vector1.V16B(), 0);
+  __ Cbz(temp.W(), &return_false);
+  __ Sub(count, count, kQRegSizeInBytes);
+  __ B(&vector_loop);
+
+  // Compare 8 bytes, then the remaining elements one at a time. The data of an
+  // array is not padded to a multiple of 16 bytes, so we cannot read past it.
+  __ Bind(&tail);
+  __ Cmp(count, kXRegSizeInBytes);
+  __ B(&element_loop, lt);
+  __ Ldr(temp, MemOperand(ptr1, kXRegSizeInBytes, PostIndex));
+  __ Ldr(out, MemOperand(ptr2, kXRegSizeInBytes, PostIndex));
+  __ Cmp(temp, out);
+  __ B(&return_false, ne);
+  __ Sub(count, count, kXRegSizeInBytes);
+
+  __ Bind(&element_loop);
+  // Long arrays have no data left after the 8 bytes comparison.
+  if (type != Primitive::kPrimLong) {
+    __ Cbz(count, &return_true);
+    switch (type) {
+      case Primitive::kPrimByte:
+        __ Ldrb(temp.W(), MemOperand(ptr1, element_size, PostIndex));
+        __ Ldrb(out.W(), MemOperand(ptr2, element_size, PostIndex));
+        break;
+      case Primitive::kPrimChar:
+      case Primitive::kPrimShort:
+        __ Ldrh(temp.W(), MemOperand(ptr1, element_size, PostIndex));
+        __ Ldrh(out.W(), MemOperand(ptr2, element_size, PostIndex));
+        break;
+      case Primitive::kPrimInt:
+        __ Ldr(temp.W(), MemOperand(ptr1, element_size, PostIndex));
+        __ Ldr(out.W(), MemOperand(ptr2, element_size, PostIndex));
+        break;
+      default:
+        LOG(FATAL) << "Unexpected element type: " << type;
+        UNREACHABLE();
+    }
+    __ Cmp(temp.W(), out.W());
+    __ B(&return_false, ne);
+    __ Sub(count, count, element_size);
+    __ B(&element_loop);
+  }
+
+  __ Bind(&return_true);
+  __ Mov(out.W(), 1);
+  __ B(&end);
+
+  __ Bind(&return_false);
+  __ Mov(out.W(), 0);
+  __ Bind(&end);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysEqualsByte(HInvoke* invoke) {
+  CreateArraysEqualsLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysEqualsByte(HInvoke* invoke) {
+  GenArraysEquals(GetVIXLAssembler(), invoke->GetLocations(), Primitive::kPrimByte);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysEqualsChar(HInvoke* invoke) {
+  CreateArraysEqualsLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysEqualsChar(HInvoke* invoke) {
+  GenArraysEquals(GetVIXLAssembler(), invoke->GetLocations(), Primitive::kPrimChar);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysEqualsShort(HInvoke* invoke) {
+  CreateArraysEqualsLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysEqualsShort(HInvoke* invoke) {
+  GenArraysEquals(GetVIXLAssembler(), invoke->GetLocations(), Primitive::kPrimShort);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysEqualsInt(HInvoke* invoke) {
+  CreateArraysEqualsLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysEqualsInt(HInvoke* invoke) {
+  GenArraysEquals(GetVIXLAssembler(), invoke->GetLocations(), Primitive::kPrimInt);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysEqualsLong(HInvoke* invoke) {
+  CreateArraysEqualsLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysEqualsLong(HInvoke* invoke) {
+  GenArraysEquals(GetVIXLAssembler(), invoke->GetLocations(), Primitive::kPrimLong);
+}
+
+static void CreateArraysFillLocations(ArenaAllocator* arena, HInvoke* invoke) {
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kCallOnSlowPath,
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+}
+
+static void GenArraysFill(HInvoke* invoke, CodeGeneratorARM64* codegen, Primitive::Type type) {
+  MacroAssembler* masm = codegen->GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+  Register array = WRegisterFrom(locations->InAt(0));
+  Register value = XRegisterFrom(locations->InAt(1));
+  Register ptr = XRegisterFrom(locations->GetTemp(0));
+  Register end = XRegisterFrom(locations->GetTemp(1));
+  VRegister vector = VRegisterFrom(locations->GetTemp(2));
+
+  const int32_t element_size = Primitive::ComponentSize(type);
+  const uint32_t length_offset = mirror::Array::LengthOffset().Uint32Value();
+  const uint32_t data_offset = mirror::Array::DataOffset(element_size).Uint32Value();
+
+  // Let the runtime throw the NullPointerException.
+  SlowPathCodeARM64* slow_path =
+      new (codegen->GetGraph()->GetArena()) IntrinsicSlowPathARM64(invoke);
+  codegen->AddSlowPath(slow_path);
+  __ Cbz(array, slow_path->GetEntryLabel());
+
+  __ Ldr(end.W(), HeapOperand(array, length_offset));
+  __ Add(ptr, array.X(), data_offset);
+  __ Add(end, ptr, Operand(end, LSL, Primitive::ComponentSizeShift(type)));
+
+  // Replicate the value in all the lanes of `vector`.
+  switch (type) {
+    case Primitive::kPrimByte:
+      __ Dup(vector.V16B(), value.W());
+      break;
+    case Primitive::kPrimChar:
+    case Primitive::kPrimShort:
+      __ Dup(vector.V8H(), value.W());
+      break;
+    case Primitive::kPrimInt:
+      __ Dup(vector.V4S(), value.W());
+      break;
+    case Primitive::kPrimLong:
+      __ Dup(vector.V2D(), value);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected element type: " << type;
+      UNREACHABLE();
+  }
+
+  // Store 16 bytes at a time, then the remaining elements one at a time.
+  UseScratchRegisterScope temps(masm);
+  Register tmp = temps.AcquireX();
+  vixl::aarch64::Label vector_loop, element_loop;
+  __ Bind(&vector_loop);
+  __ Sub(tmp, end, ptr);
+  __ Cmp(tmp, kQRegSizeInBytes);
+  __ B(&element_loop, lt);
+  __ Str(vector.Q(), MemOperand(ptr, kQRegSizeInBytes, PostIndex));
+  __ B(&vector_loop);
+
+  __ Bind(&element_loop);
+  __ Cmp(ptr, end);
+  __ B(slow_path->GetExitLabel(), eq);
+  switch (type) {
+    case Primitive::kPrimByte:
+      __ Strb(value.W(), MemOperand(ptr, element_size, PostIndex));
+      break;
+    case Primitive::kPrimChar:
+    case Primitive::kPrimShort:
+      __ Strh(value.W(), MemOperand(ptr, element_size, PostIndex));
+      break;
+    case Primitive::kPrimInt:
+      __ Str(value.W(), MemOperand(ptr, element_size, PostIndex));
+      break;
+    case Primitive::kPrimLong:
+      __ Str(value, MemOperand(ptr, element_size, PostIndex));
+      break;
+    default:
+      LOG(FATAL) << "Unexpected element type: " << type;
+      UNREACHABLE();
+  }
+  __ B(&element_loop);
+
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysFillByte(HInvoke* invoke) {
+  CreateArraysFillLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysFillByte(HInvoke* invoke) {
+  GenArraysFill(invoke, codegen_, Primitive::kPrimByte);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysFillChar(HInvoke* invoke) {
+  CreateArraysFillLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysFillChar(HInvoke* invoke) {
+  GenArraysFill(invoke, codegen_, Primitive::kPrimChar);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysFillShort(HInvoke* invoke) {
+  CreateArraysFillLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysFillShort(HInvoke* invoke) {
+  GenArraysFill(invoke, codegen_, Primitive::kPrimShort);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysFillInt(HInvoke* invoke) {
+  CreateArraysFillLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysFillInt(HInvoke* invoke) {
+  GenArraysFill(invoke, codegen_, Primitive::kPrimInt);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysFillLong(HInvoke* invoke) {
+  CreateArraysFillLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysFillLong(HInvoke* invoke) {
+  GenArraysFill(invoke, codegen_, Primitive::kPrimLong);
+}
+
+static void CreateArraysHashCodeLocations(ArenaAllocator* arena,
+                                          HInvoke* invoke,
+                                          Primitive::Type type) {
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kNoCall,
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  if (type != Primitive::kPrimLong) {
+    // The hash of long arrays is computed one element at a time.
+    locations->AddTemp(Location::RequiresFpuRegister());
+    locations->AddTemp(Location::RequiresFpuRegister());
+    locations->AddTemp(Location::RequiresFpuRegister());
+  }
+  locations->SetOut(Location::RequiresRegister());
+}
+
+// Continues the hash in `out` with the elements of type `type` from `ptr` to `end`, that is,
+// computes `out = 31 * out + element` for each of them, as done by `Arrays.hashCode()` and
+// `String.hashCode()`. Bytes of type `kPrimBoolean` are zero extended. Clobbers `ptr` and
+// the vector temporaries of `locations`.
+//
+// The vector loop hashes four elements at a time: each lane accumulates
+// `lane = 31^4 * lane + element`, with the initial hash in the last lane. Weighting
+// the lanes by 31^3, 31^2, 31 and 1 and adding them up gives the hash of the
+// elements visited so far, which the scalar loop then continues with.
+static void GenHashCodeLoops(MacroAssembler* masm,
+                             LocationSummary* locations,
+                             const Register& out,
+                             const Register& ptr,
+                             const Register& end,
+                             Primitive::Type type) {
+  const int32_t element_size = Primitive::ComponentSize(type);
+  UseScratchRegisterScope temps(masm);
+  Register tmp = temps.AcquireX();
+  vixl::aarch64::Label element_loop, done;
+
+  if (type != Primitive::kPrimLong) {
+    VRegister accumulator = VRegisterFrom(locations->GetTemp(2));
+    VRegister elements = VRegisterFrom(locations->GetTemp(3));
+    VRegister factors = VRegisterFrom(locations->GetTemp(4));
+    vixl::aarch64::Label vector_loop, reduce;
+
+    // accumulator = [0, 0, 0, out], factors = [31^4, 31^4, 31^4, 31^4].
+    __ Movi(accumulator.V4S(), 0);
+    __ Mov(accumulator.V4S(), 3, out);
+    __ Mov(tmp.W(), 31 * 31 * 31 * 31);
+    __ Dup(factors.V4S(), tmp.W());
+
+    __ Bind(&vector_loop);
+    __ Sub(tmp, end, ptr);
+    __ Cmp(tmp, 4 * element_size);
+    __ B(&reduce, lt);
+    // Load four elements, sign or zero extended to 32 bits.
+    switch (type) {
+      case Primitive::kPrimBoolean:
+        __ Ldr(elements.S(), MemOperand(ptr, 4 * element_size, PostIndex));
+        __ Uxtl(elements.V8H(), elements.V8B());
+        __ Uxtl(elements.V4S(), elements.V4H());
+        break;
+      case Primitive::kPrimByte:
+        __ Ldr(elements.S(), MemOperand(ptr, 4 * element_size, PostIndex));
+        __ Sxtl(elements.V8H(), elements.V8B());
+        __ Sxtl(elements.V4S(), elements.V4H());
+        break;
+      case Primitive::kPrimChar:
+        __ Ldr(elements.D(), MemOperand(ptr, 4 * element_size, PostIndex));
+        __ Uxtl(elements.V4S(), elements.V4H());
+        break;
+      case Primitive::kPrimShort:
+        __ Ldr(elements.D(), MemOperand(ptr, 4 * element_size, PostIndex));
+        __ Sxtl(elements.V4S(), elements.V4H());
+        break;
+      case Primitive::kPrimInt:
+        __ Ldr(elements.Q(), MemOperand(ptr, 4 * element_size, PostIndex));
+        break;
+      default:
+        LOG(FATAL) << "Unexpected element type: " << type;
+        UNREACHABLE();
+    }
+    __ Mul(accumulator.V4S(), accumulator.V4S(), factors.V4S());
+    __ Add(accumulator.V4S(), accumulator.V4S(), elements.V4S());
+    __ B(&vector_loop);
+
+    // factors = [31^3, 31^2, 31, 1]. Without any vector iteration, this reduces to `out`.
+    __ Bind(&reduce);
+    __ Mov(tmp, (INT64_C(31 * 31) << 32) | (31 * 31 * 31));
+    __ Mov(factors.V2D(), 0, tmp);
+    __ Mov(tmp, (INT64_C(1) << 32) | 31);
+    __ Mov(factors.V2D(), 1, tmp);
+    __ Mul(accumulator.V4S(), accumulator.V4S(), factors.V4S());
+    __ Addv(accumulator.S(), accumulator.V4S());
+    __ Umov(out, accumulator.V4S(), 0);
+  }
+
+  __ Bind(&element_loop);
+  __ Cmp(ptr, end);
+  __ B(&done, eq);
+  switch (type) {
+    case Primitive::kPrimBoolean:
+      __ Ldrb(tmp.W(), MemOperand(ptr, element_size, PostIndex));
+      break;
+    case Primitive::kPrimByte:
+      __ Ldrsb(tmp.W(), MemOperand(ptr, element_size, PostIndex));
+      break;
+    case Primitive::kPrimChar:
+      __ Ldrh(tmp.W(), MemOperand(ptr, element_size, PostIndex));
+      break;
+    case Primitive::kPrimShort:
+      __ Ldrsh(tmp.W(), MemOperand(ptr, element_size, PostIndex));
+      break;
+    case Primitive::kPrimInt:
+      __ Ldr(tmp.W(), MemOperand(ptr, element_size, PostIndex));
+      break;
+    case Primitive::kPrimLong:
+      // Long.hashCode(): (int) (value ^ (value >>> 32)).
+      __ Ldr(tmp, MemOperand(ptr, element_size, PostIndex));
+      __ Eor(tmp, tmp, Operand(tmp, LSR, 32));
+      break;
+    default:
+      LOG(FATAL) << "Unexpected element type: " << type;
+      UNREACHABLE();
+  }
+  // out = 31 * out + element.
+  __ Add(tmp.W(), tmp.W(), Operand(out, LSL, 5));
+  __ Sub(out, tmp.W(), out);
+  __ B(&element_loop);
+
+  __ Bind(&done);
+}
+
+static void GenArraysHashCode(MacroAssembler* masm,
+                              LocationSummary* locations,
+                              Primitive::Type type) {
+  Register array = WRegisterFrom(locations->InAt(0));
+  Register out = WRegisterFrom(locations->Out());
+  Register ptr = XRegisterFrom(locations->GetTemp(0));
+  Register end = XRegisterFrom(locations->GetTemp(1));
+
+  const uint32_t length_offset = mirror::Array::LengthOffset().Uint32Value();
+  const uint32_t data_offset =
+      mirror::Array::DataOffset(Primitive::ComponentSize(type)).Uint32Value();
+
+  vixl::aarch64::Label done;
+
+  // The hash of a null array is 0.
+  __ Mov(out, 0);
+  __ Cbz(array, &done);
+
+  // Otherwise, the hash starts at 1.
+  __ Ldr(end.W(), HeapOperand(array, length_offset));
+  __ Add(ptr, array.X(), data_offset);
+  __ Add(end, ptr, Operand(end, LSL, Primitive::ComponentSizeShift(type)));
+  __ Mov(out, 1);
+  GenHashCodeLoops(masm, locations, out, ptr, end, type);
+
+  __ Bind(&done);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysHashCodeByte(HInvoke* invoke) {
+  CreateArraysHashCodeLocations(arena_, invoke, Primitive::kPrimByte);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysHashCodeByte(HInvoke* invoke) {
+  GenArraysHashCode(GetVIXLAssembler(), invoke->GetLocations(), Primitive::kPrimByte);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysHashCodeChar(HInvoke* invoke) {
+  CreateArraysHashCodeLocations(arena_, invoke, Primitive::kPrimChar);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysHashCodeChar(HInvoke* invoke) {
+  GenArraysHashCode(GetVIXLAssembler(), invoke->GetLocations(), Primitive::kPrimChar);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysHashCodeShort(HInvoke* invoke) {
+  CreateArraysHashCodeLocations(arena_, invoke, Primitive::kPrimShort);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysHashCodeShort(HInvoke* invoke) {
+  GenArraysHashCode(GetVIXLAssembler(), invoke->GetLocations(), Primitive::kPrimShort);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysHashCodeInt(HInvoke* invoke) {
+  CreateArraysHashCodeLocations(arena_, invoke, Primitive::kPrimInt);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysHashCodeInt(HInvoke* invoke) {
+  GenArraysHashCode(GetVIXLAssembler(), invoke->GetLocations(), Primitive::kPrimInt);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitArraysHashCodeLong(HInvoke* invoke) {
+  CreateArraysHashCodeLocations(arena_, invoke, Primitive::kPrimLong);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitArraysHashCodeLong(HInvoke* invoke) {
+  GenArraysHashCode(GetVIXLAssembler(), invoke->GetLocations(), Primitive::kPrimLong);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitStringHashCode(HInvoke* invoke) {
+  // Same registers as for the hash of a char array.
+  CreateArraysHashCodeLocations(arena_, invoke, Primitive::kPrimChar);
+}
+
+void IntrinsicCodeGeneratorARM64::VisitStringHashCode(HInvoke* invoke) {
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Register str = WRegisterFrom(locations->InAt(0));
+  Register out = WRegisterFrom(locations->Out());
+  Register ptr = XRegisterFrom(locations->GetTemp(0));
+  Register end = XRegisterFrom(locations->GetTemp(1));
+
+  const int32_t count_offset = mirror::String::CountOffset().Int32Value();
+  const int32_t value_offset = mirror::String::ValueOffset().Int32Value();
+  const int32_t hash_code_offset = mirror::String::HashCodeOffset().Int32Value();
+
+  // Note that the null check must have been done earlier.
+  DCHECK(!invoke->CanDoImplicitNullCheckOn(invoke->InputAt(0)));
+
+  vixl::aarch64::Label store, done;
+
+  // Return the cached hash code, if any. Otherwise `out` holds 0, the initial hash.
+  __ Ldr(out, HeapOperand(str, hash_code_offset));
+  __ Cbnz(out, &done);
+
+  __ Ldr(end.W(), HeapOperand(str, count_offset));
+  __ Add(ptr, str.X(), value_offset);
+  if (mirror::kUseStringCompression) {
+    vixl::aarch64::Label uncompressed;
+    // The count is `(length << 1) | uncompressed`.
+    __ Tbnz(end.W(), 0, &uncompressed);
+    __ Add(end, ptr, Operand(end, LSR, 1));
+    GenHashCodeLoops(masm, locations, out, ptr, end, Primitive::kPrimBoolean);
+    __ B(&store);
+    __ Bind(&uncompressed);
+    // Clearing the flag leaves the length of the data in bytes.
+    __ And(end, end, ~INT64_C(1));
+    __ Add(end, ptr, end);
+  } else {
+    __ Add(end, ptr, Operand(end, LSL, 1));
+  }
+  GenHashCodeLoops(masm, locations, out, ptr, end, Primitive::kPrimChar);
+
+  // Racing threads store the same value, so there is no need for synchronization.
+  __ Bind(&store);
+  __ Str(out, HeapOperand(str, hash_code_offset));
+
+  __ Bind(&done);
+}
+
 // We can choose to use the native implementation there for longer copy lengths.
 static constexpr int32_t kSystemArrayCopyThreshold = 128;
 
@@ -2992,6 +3743,261 @@ void IntrinsicCodeGeneratorARM64::VisitThreadInterrupted(HInvoke* invoke) {
   __ Bind(&done);
 }
 
+// Longer buffers are checksummed by zlib, so that the thread reaches its next suspend check
+// in a bounded time.
+static constexpr int32_t kCRC32UpdateBytesThreshold = 64 * KB;
+
+// The scalar Adler32 loop only beats zlib, including its JNI transition, for short buffers.
+static constexpr int32_t kAdler32UpdateBytesThreshold = 256;
+
+// Largest prime smaller than 2^16, the modulus of the Adler32 sums.
+static constexpr int32_t kAdler32Base = 65521;
+
+// zlib reduces the Adler32 sums at least every 5552 bytes, before they can overflow. Buffers
+// up to the threshold are reduced once, at the end.
+static_assert(kAdler32UpdateBytesThreshold <= 5552, "Adler32 sums may overflow");
+
+static void CreateZipUpdateLocations(ArenaAllocator* arena, HInvoke* invoke) {
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kNoCall,
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+// Used for the update(int, byte[], int, int) and update(int, long, int, int) methods.
+static void CreateZipUpdateBytesLocations(ArenaAllocator* arena,
+                                          HInvoke* invoke,
+                                          int32_t threshold,
+                                          size_t num_temps) {
+  HIntConstant* length = invoke->InputAt(3)->AsIntConstant();
+  if (length != nullptr && length->GetValue() > threshold) {
+    // Just call as normal.
+    return;
+  }
+
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kCallOnSlowPath,
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetInAt(2, Location::RequiresRegister());
+  locations->SetInAt(3, Location::RequiresRegister());
+  for (size_t i = 0; i != num_temps; ++i) {
+    locations->AddTemp(Location::RequiresRegister());
+  }
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+// Sets `ptr` to the first byte to checksum and `end` past the last one, or takes `slow_path`
+// if there are more than `threshold` bytes.
+static void GenZipUpdateBytesBounds(MacroAssembler* masm,
+                                    LocationSummary* locations,
+                                    bool is_byte_buffer,
+                                    int32_t threshold,
+                                    SlowPathCodeARM64* slow_path) {
+  Register offset = WRegisterFrom(locations->InAt(2));
+  Register length = WRegisterFrom(locations->InAt(3));
+  Register ptr = XRegisterFrom(locations->GetTemp(0));
+  Register end = XRegisterFrom(locations->GetTemp(1));
+
+  // The callers have checked the bounds, so `offset` and `length` are not negative.
+  __ Cmp(length, threshold);
+  __ B(slow_path->GetEntryLabel(), gt);
+
+  if (is_byte_buffer) {
+    __ Add(ptr, XRegisterFrom(locations->InAt(1)), Operand(offset, UXTW));
+  } else {
+    const int32_t data_offset = mirror::Array::DataOffset(sizeof(uint8_t)).Int32Value();
+    __ Add(ptr, XRegisterFrom(locations->InAt(1)), data_offset);
+    __ Add(ptr, ptr, Operand(offset, UXTW));
+  }
+  __ Add(end, ptr, Operand(length, UXTW));
+}
+
+void IntrinsicLocationsBuilderARM64::VisitCRC32Update(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasCRC()) {
+    return;
+  }
+  CreateZipUpdateLocations(arena_, invoke);
+}
+
+// CRC32.update(int crc, int b).
+void IntrinsicCodeGeneratorARM64::VisitCRC32Update(HInvoke* invoke) {
+  DCHECK(codegen_->GetInstructionSetFeatures().HasCRC());
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Register crc = WRegisterFrom(locations->InAt(0));
+  Register value = WRegisterFrom(locations->InAt(1));
+  Register out = WRegisterFrom(locations->Out());
+
+  // zlib keeps the CRC inverted while updating it. CRC32B only uses the low byte of `value`.
+  __ Mvn(out, crc);
+  __ Crc32b(out, out, value);
+  __ Mvn(out, out);
+}
+
+static void GenCRC32UpdateBytes(HInvoke* invoke,
+                                CodeGeneratorARM64* codegen,
+                                bool is_byte_buffer) {
+  DCHECK(codegen->GetInstructionSetFeatures().HasCRC());
+  MacroAssembler* masm = codegen->GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Register crc = WRegisterFrom(locations->InAt(0));
+  Register out = WRegisterFrom(locations->Out());
+  Register ptr = XRegisterFrom(locations->GetTemp(0));
+  Register end = XRegisterFrom(locations->GetTemp(1));
+
+  SlowPathCodeARM64* slow_path =
+      new (codegen->GetGraph()->GetArena()) IntrinsicSlowPathARM64(invoke);
+  codegen->AddSlowPath(slow_path);
+  GenZipUpdateBytesBounds(masm, locations, is_byte_buffer, kCRC32UpdateBytesThreshold, slow_path);
+
+  UseScratchRegisterScope temps(masm);
+  Register tmp = temps.AcquireX();
+  vixl::aarch64::Label eight_bytes_loop, byte_loop, done;
+
+  __ Mvn(out, crc);
+
+  // The CRC32X instruction processes eight bytes, in memory order.
+  __ Bind(&eight_bytes_loop);
+  __ Sub(tmp, end, ptr);
+  __ Cmp(tmp, 8);
+  __ B(&byte_loop, lt);
+  __ Ldr(tmp, MemOperand(ptr, 8, PostIndex));
+  __ Crc32x(out, out, tmp);
+  __ B(&eight_bytes_loop);
+
+  __ Bind(&byte_loop);
+  __ Cmp(ptr, end);
+  __ B(&done, eq);
+  __ Ldrb(tmp.W(), MemOperand(ptr, 1, PostIndex));
+  __ Crc32b(out, out, tmp.W());
+  __ B(&byte_loop);
+
+  __ Bind(&done);
+  __ Mvn(out, out);
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitCRC32UpdateBytes(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasCRC()) {
+    return;
+  }
+  CreateZipUpdateBytesLocations(arena_, invoke, kCRC32UpdateBytesThreshold, /* num_temps */ 2);
+}
+
+// CRC32.updateBytes(int crc, byte[] b, int off, int len).
+void IntrinsicCodeGeneratorARM64::VisitCRC32UpdateBytes(HInvoke* invoke) {
+  GenCRC32UpdateBytes(invoke, codegen_, /* is_byte_buffer */ false);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitCRC32UpdateByteBuffer(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasCRC()) {
+    return;
+  }
+  CreateZipUpdateBytesLocations(arena_, invoke, kCRC32UpdateBytesThreshold, /* num_temps */ 2);
+}
+
+// CRC32.updateByteBuffer(int crc, long addr, int off, int len).
+void IntrinsicCodeGeneratorARM64::VisitCRC32UpdateByteBuffer(HInvoke* invoke) {
+  GenCRC32UpdateBytes(invoke, codegen_, /* is_byte_buffer */ true);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitAdler32Update(HInvoke* invoke) {
+  CreateZipUpdateLocations(arena_, invoke);
+}
+
+// Adler32.update(int adler, int b).
+void IntrinsicCodeGeneratorARM64::VisitAdler32Update(HInvoke* invoke) {
+  MacroAssembler* masm = GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Register adler = WRegisterFrom(locations->InAt(0));
+  Register value = WRegisterFrom(locations->InAt(1));
+  Register out = WRegisterFrom(locations->Out());
+
+  UseScratchRegisterScope temps(masm);
+  Register sum = temps.AcquireW();
+  Register base = temps.AcquireW();
+
+  // Both sums are below 2 * kAdler32Base, so one conditional subtraction reduces them.
+  __ Mov(base, kAdler32Base);
+  __ And(out, adler, 0xffff);
+  __ Add(out, out, Operand(value, UXTB));
+  __ Subs(sum, out, base);
+  __ Csel(out, sum, out, hs);
+  __ Add(sum, out, Operand(adler, LSR, 16));
+  __ Subs(base, sum, base);
+  __ Csel(sum, base, sum, hs);
+  __ Orr(out, out, Operand(sum, LSL, 16));
+}
+
+static void GenAdler32UpdateBytes(HInvoke* invoke,
+                                  CodeGeneratorARM64* codegen,
+                                  bool is_byte_buffer) {
+  MacroAssembler* masm = codegen->GetVIXLAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  Register adler = WRegisterFrom(locations->InAt(0));
+  Register out = WRegisterFrom(locations->Out());
+  Register ptr = XRegisterFrom(locations->GetTemp(0));
+  Register end = XRegisterFrom(locations->GetTemp(1));
+  Register sum = WRegisterFrom(locations->GetTemp(2));
+
+  SlowPathCodeARM64* slow_path =
+      new (codegen->GetGraph()->GetArena()) IntrinsicSlowPathARM64(invoke);
+  codegen->AddSlowPath(slow_path);
+  GenZipUpdateBytesBounds(masm, locations, is_byte_buffer, kAdler32UpdateBytesThreshold, slow_path);
+
+  UseScratchRegisterScope temps(masm);
+  Register tmp = temps.AcquireW();
+  Register base = temps.AcquireW();
+  vixl::aarch64::Label loop, done;
+
+  // `out` is the sum of the bytes, `sum` the sum of these sums.
+  __ And(out, adler, 0xffff);
+  __ Lsr(sum, adler, 16);
+
+  __ Bind(&loop);
+  __ Cmp(ptr, end);
+  __ B(&done, eq);
+  __ Ldrb(tmp, MemOperand(ptr, 1, PostIndex));
+  __ Add(out, out, tmp);
+  __ Add(sum, sum, out);
+  __ B(&loop);
+
+  __ Bind(&done);
+  __ Mov(base, kAdler32Base);
+  __ Udiv(tmp, out, base);
+  __ Msub(out, tmp, base, out);
+  __ Udiv(tmp, sum, base);
+  __ Msub(sum, tmp, base, sum);
+  __ Orr(out, out, Operand(sum, LSL, 16));
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderARM64::VisitAdler32UpdateBytes(HInvoke* invoke) {
+  CreateZipUpdateBytesLocations(arena_, invoke, kAdler32UpdateBytesThreshold, /* num_temps */ 3);
+}
+
+// Adler32.updateBytes(int adler, byte[] b, int off, int len).
+void IntrinsicCodeGeneratorARM64::VisitAdler32UpdateBytes(HInvoke* invoke) {
+  GenAdler32UpdateBytes(invoke, codegen_, /* is_byte_buffer */ false);
+}
+
+void IntrinsicLocationsBuilderARM64::VisitAdler32UpdateByteBuffer(HInvoke* invoke) {
+  CreateZipUpdateBytesLocations(arena_, invoke, kAdler32UpdateBytesThreshold, /* num_temps */ 3);
+}
+
+// Adler32.updateByteBuffer(int adler, long addr, int off, int len).
+void IntrinsicCodeGeneratorARM64::VisitAdler32UpdateByteBuffer(HInvoke* invoke) {
+  GenAdler32UpdateBytes(invoke, codegen_, /* is_byte_buffer */ true);
+}
+
 UNIMPLEMENTED_INTRINSIC(ARM64, ReferenceGetReferent)
 UNIMPLEMENTED_INTRINSIC(ARM64, IntegerHighestOneBit)
 UNIMPLEMENTED_INTRINSIC(ARM64, LongHighestOneBit)
@@ -3007,13 +4013,6 @@ UNIMPLEMENTED_INTRINSIC(ARM64, StringBuilderAppend);
 UNIMPLEMENTED_INTRINSIC(ARM64, StringBuilderLength);
 UNIMPLEMENTED_INTRINSIC(ARM64, StringBuilderToString);
 
-// 1.8.
-UNIMPLEMENTED_INTRINSIC(ARM64, UnsafeGetAndAddInt)
-UNIMPLEMENTED_INTRINSIC(ARM64, UnsafeGetAndAddLong)
-UNIMPLEMENTED_INTRINSIC(ARM64, UnsafeGetAndSetInt)
-UNIMPLEMENTED_INTRINSIC(ARM64, UnsafeGetAndSetLong)
-UNIMPLEMENTED_INTRINSIC(ARM64, UnsafeGetAndSetObject)
-
 UNREACHABLE_INTRINSICS(ARM64)
 
 #undef __
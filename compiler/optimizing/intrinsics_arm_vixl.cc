@@ -3145,6 +3145,34 @@ UNIMPLEMENTED_INTRINSIC(ARMVIXL, UnsafeGetAndSetInt)
 UNIMPLEMENTED_INTRINSIC(ARMVIXL, UnsafeGetAndSetLong)
 UNIMPLEMENTED_INTRINSIC(ARMVIXL, UnsafeGetAndSetObject)
 
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, SystemArrayCopyByte)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, SystemArrayCopyShort)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, SystemArrayCopyInt)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, SystemArrayCopyLong)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysEqualsByte)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysEqualsChar)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysEqualsShort)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysEqualsInt)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysEqualsLong)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysFillByte)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysFillChar)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysFillShort)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysFillInt)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysFillLong)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysHashCodeByte)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysHashCodeChar)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysHashCodeShort)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysHashCodeInt)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, ArraysHashCodeLong)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, StringHashCode)
+
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, CRC32Update)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, CRC32UpdateBytes)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, CRC32UpdateByteBuffer)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, Adler32Update)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, Adler32UpdateBytes)
+UNIMPLEMENTED_INTRINSIC(ARMVIXL, Adler32UpdateByteBuffer)
+
 UNREACHABLE_INTRINSICS(ARMVIXL)
 
 #undef __
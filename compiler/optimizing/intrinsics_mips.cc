@@ -3261,6 +3261,34 @@ UNIMPLEMENTED_INTRINSIC(MIPS, UnsafeGetAndSetObject)
 
 UNIMPLEMENTED_INTRINSIC(MIPS, ThreadInterrupted)
 
+UNIMPLEMENTED_INTRINSIC(MIPS, SystemArrayCopyByte)
+UNIMPLEMENTED_INTRINSIC(MIPS, SystemArrayCopyShort)
+UNIMPLEMENTED_INTRINSIC(MIPS, SystemArrayCopyInt)
+UNIMPLEMENTED_INTRINSIC(MIPS, SystemArrayCopyLong)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysEqualsByte)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysEqualsChar)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysEqualsShort)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysEqualsInt)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysEqualsLong)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysFillByte)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysFillChar)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysFillShort)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysFillInt)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysFillLong)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysHashCodeByte)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysHashCodeChar)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysHashCodeShort)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysHashCodeInt)
+UNIMPLEMENTED_INTRINSIC(MIPS, ArraysHashCodeLong)
+UNIMPLEMENTED_INTRINSIC(MIPS, StringHashCode)
+
+UNIMPLEMENTED_INTRINSIC(MIPS, CRC32Update)
+UNIMPLEMENTED_INTRINSIC(MIPS, CRC32UpdateBytes)
+UNIMPLEMENTED_INTRINSIC(MIPS, CRC32UpdateByteBuffer)
+UNIMPLEMENTED_INTRINSIC(MIPS, Adler32Update)
+UNIMPLEMENTED_INTRINSIC(MIPS, Adler32UpdateBytes)
+UNIMPLEMENTED_INTRINSIC(MIPS, Adler32UpdateByteBuffer)
+
 UNREACHABLE_INTRINSICS(MIPS)
 
 #undef __
@@ -2625,6 +2625,34 @@ UNIMPLEMENTED_INTRINSIC(MIPS64, UnsafeGetAndSetObject)
 
 UNIMPLEMENTED_INTRINSIC(MIPS64, ThreadInterrupted)
 
+UNIMPLEMENTED_INTRINSIC(MIPS64, SystemArrayCopyByte)
+UNIMPLEMENTED_INTRINSIC(MIPS64, SystemArrayCopyShort)
+UNIMPLEMENTED_INTRINSIC(MIPS64, SystemArrayCopyInt)
+UNIMPLEMENTED_INTRINSIC(MIPS64, SystemArrayCopyLong)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysEqualsByte)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysEqualsChar)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysEqualsShort)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysEqualsInt)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysEqualsLong)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysFillByte)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysFillChar)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysFillShort)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysFillInt)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysFillLong)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysHashCodeByte)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysHashCodeChar)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysHashCodeShort)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysHashCodeInt)
+UNIMPLEMENTED_INTRINSIC(MIPS64, ArraysHashCodeLong)
+UNIMPLEMENTED_INTRINSIC(MIPS64, StringHashCode)
+
+UNIMPLEMENTED_INTRINSIC(MIPS64, CRC32Update)
+UNIMPLEMENTED_INTRINSIC(MIPS64, CRC32UpdateBytes)
+UNIMPLEMENTED_INTRINSIC(MIPS64, CRC32UpdateByteBuffer)
+UNIMPLEMENTED_INTRINSIC(MIPS64, Adler32Update)
+UNIMPLEMENTED_INTRINSIC(MIPS64, Adler32UpdateBytes)
+UNIMPLEMENTED_INTRINSIC(MIPS64, Adler32UpdateByteBuffer)
+
 UNREACHABLE_INTRINSICS(MIPS64)
 
 #undef __
@@ -3392,6 +3392,34 @@ UNIMPLEMENTED_INTRINSIC(X86, UnsafeGetAndSetInt)
 UNIMPLEMENTED_INTRINSIC(X86, UnsafeGetAndSetLong)
 UNIMPLEMENTED_INTRINSIC(X86, UnsafeGetAndSetObject)
 
+UNIMPLEMENTED_INTRINSIC(X86, SystemArrayCopyByte)
+UNIMPLEMENTED_INTRINSIC(X86, SystemArrayCopyShort)
+UNIMPLEMENTED_INTRINSIC(X86, SystemArrayCopyInt)
+UNIMPLEMENTED_INTRINSIC(X86, SystemArrayCopyLong)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysEqualsByte)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysEqualsChar)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysEqualsShort)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysEqualsInt)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysEqualsLong)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysFillByte)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysFillChar)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysFillShort)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysFillInt)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysFillLong)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysHashCodeByte)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysHashCodeChar)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysHashCodeShort)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysHashCodeInt)
+UNIMPLEMENTED_INTRINSIC(X86, ArraysHashCodeLong)
+UNIMPLEMENTED_INTRINSIC(X86, StringHashCode)
+
+UNIMPLEMENTED_INTRINSIC(X86, CRC32Update)
+UNIMPLEMENTED_INTRINSIC(X86, CRC32UpdateBytes)
+UNIMPLEMENTED_INTRINSIC(X86, CRC32UpdateByteBuffer)
+UNIMPLEMENTED_INTRINSIC(X86, Adler32Update)
+UNIMPLEMENTED_INTRINSIC(X86, Adler32UpdateBytes)
+UNIMPLEMENTED_INTRINSIC(X86, Adler32UpdateByteBuffer)
+
 UNREACHABLE_INTRINSICS(X86)
 
 #undef __
@@ -925,7 +925,7 @@ void IntrinsicCodeGeneratorX86_64::VisitMathNextAfter(HInvoke* invoke) {
   GenFPToFPCall(invoke, codegen_, kQuickNextAfter);
 }
 
-void IntrinsicLocationsBuilderX86_64::VisitSystemArrayCopyChar(HInvoke* invoke) {
+static void CreateSystemArrayCopyPrimitiveLocations(ArenaAllocator* arena, HInvoke* invoke) {
   // Check to see if we have known failures that will cause us to have to bail out
   // to the runtime, and just generate the runtime call directly.
   HIntConstant* src_pos = invoke->InputAt(1)->AsIntConstant();
@@ -948,17 +948,17 @@ void IntrinsicLocationsBuilderX86_64::VisitSystemArrayCopyChar(HInvoke* invoke)
     }
   }
 
-  LocationSummary* locations = new (arena_) LocationSummary(invoke,
-                                                            LocationSummary::kCallOnSlowPath,
-                                                            kIntrinsified);
-  // arraycopy(Object src, int src_pos, Object dest, int dest_pos, int length).
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kCallOnSlowPath,
+                                                           kIntrinsified);
+  // arraycopy(T[] src, int src_pos, T[] dest, int dest_pos, int length).
   locations->SetInAt(0, Location::RequiresRegister());
   locations->SetInAt(1, Location::RegisterOrConstant(invoke->InputAt(1)));
   locations->SetInAt(2, Location::RequiresRegister());
   locations->SetInAt(3, Location::RegisterOrConstant(invoke->InputAt(3)));
   locations->SetInAt(4, Location::RegisterOrConstant(invoke->InputAt(4)));
 
-  // And we need some temporaries.  We will use REP MOVSW, so we need fixed registers.
+  // And we need some temporaries.  We will use REP MOVS, so we need fixed registers.
   locations->AddTemp(Location::RegisterLocation(RSI));
   locations->AddTemp(Location::RegisterLocation(RDI));
   locations->AddTemp(Location::RegisterLocation(RCX));
@@ -1028,8 +1028,10 @@ static void CheckPosition(X86_64Assembler* assembler,
   }
 }
 
-void IntrinsicCodeGeneratorX86_64::VisitSystemArrayCopyChar(HInvoke* invoke) {
-  X86_64Assembler* assembler = GetAssembler();
+static void GenSystemArrayCopyPrimitive(HInvoke* invoke,
+                                        CodeGeneratorX86_64* codegen,
+                                        Primitive::Type type) {
+  X86_64Assembler* assembler = down_cast<X86_64Assembler*>(codegen->GetAssembler());
   LocationSummary* locations = invoke->GetLocations();
 
   CpuRegister src = locations->InAt(0).AsRegister<CpuRegister>();
@@ -1038,7 +1040,7 @@ void IntrinsicCodeGeneratorX86_64::VisitSystemArrayCopyChar(HInvoke* invoke) {
   Location dest_pos = locations->InAt(3);
   Location length = locations->InAt(4);
 
-  // Temporaries that we need for MOVSW.
+  // Temporaries that we need for MOVS.
   CpuRegister src_base = locations->GetTemp(0).AsRegister<CpuRegister>();
   DCHECK_EQ(src_base.AsRegister(), RSI);
   CpuRegister dest_base = locations->GetTemp(1).AsRegister<CpuRegister>();
@@ -1046,8 +1048,9 @@ void IntrinsicCodeGeneratorX86_64::VisitSystemArrayCopyChar(HInvoke* invoke) {
   CpuRegister count = locations->GetTemp(2).AsRegister<CpuRegister>();
   DCHECK_EQ(count.AsRegister(), RCX);
 
-  SlowPathCode* slow_path = new (GetAllocator()) IntrinsicSlowPathX86_64(invoke);
-  codegen_->AddSlowPath(slow_path);
+  SlowPathCode* slow_path =
+      new (codegen->GetGraph()->GetArena()) IntrinsicSlowPathX86_64(invoke);
+  codegen->AddSlowPath(slow_path);
 
   // Bail out if the source and destination are the same.
   __ cmpl(src, dest);
@@ -1082,33 +1085,600 @@ void IntrinsicCodeGeneratorX86_64::VisitSystemArrayCopyChar(HInvoke* invoke) {
   }
 
   // Okay, everything checks out.  Finally time to do the copy.
-  // Check assumption that sizeof(Char) is 2 (used in scaling below).
-  const size_t char_size = Primitive::ComponentSize(Primitive::kPrimChar);
-  DCHECK_EQ(char_size, 2u);
-
-  const uint32_t data_offset = mirror::Array::DataOffset(char_size).Uint32Value();
+  const size_t element_size = Primitive::ComponentSize(type);
+  const ScaleFactor scale_factor = static_cast<ScaleFactor>(Primitive::ComponentSizeShift(type));
+  const uint32_t data_offset = mirror::Array::DataOffset(element_size).Uint32Value();
 
   if (src_pos.IsConstant()) {
     int32_t src_pos_const = src_pos.GetConstant()->AsIntConstant()->GetValue();
-    __ leal(src_base, Address(src, char_size * src_pos_const + data_offset));
+    __ leal(src_base, Address(src, element_size * src_pos_const + data_offset));
   } else {
-    __ leal(src_base, Address(src, src_pos.AsRegister<CpuRegister>(),
-                              ScaleFactor::TIMES_2, data_offset));
+    __ leal(src_base, Address(src, src_pos.AsRegister<CpuRegister>(), scale_factor, data_offset));
   }
   if (dest_pos.IsConstant()) {
     int32_t dest_pos_const = dest_pos.GetConstant()->AsIntConstant()->GetValue();
-    __ leal(dest_base, Address(dest, char_size * dest_pos_const + data_offset));
+    __ leal(dest_base, Address(dest, element_size * dest_pos_const + data_offset));
   } else {
-    __ leal(dest_base, Address(dest, dest_pos.AsRegister<CpuRegister>(),
-                               ScaleFactor::TIMES_2, data_offset));
+    __ leal(dest_base,
+            Address(dest, dest_pos.AsRegister<CpuRegister>(), scale_factor, data_offset));
   }
 
-  // Do the move.
-  __ rep_movsw();
+  // Do the move. The string move instructions use wide transfers internally on
+  // current cores, so the element granularity only matters for the count.
+  switch (type) {
+    case Primitive::kPrimByte:
+      __ rep_movsb();
+      break;
+    case Primitive::kPrimChar:
+    case Primitive::kPrimShort:
+      __ rep_movsw();
+      break;
+    case Primitive::kPrimInt:
+      __ rep_movsl();
+      break;
+    case Primitive::kPrimLong:
+      __ rep_movsq();
+      break;
+    default:
+      LOG(FATAL) << "Unexpected element type: " << type;
+      UNREACHABLE();
+  }
 
   __ Bind(slow_path->GetExitLabel());
 }
 
+void IntrinsicLocationsBuilderX86_64::VisitSystemArrayCopyByte(HInvoke* invoke) {
+  CreateSystemArrayCopyPrimitiveLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitSystemArrayCopyByte(HInvoke* invoke) {
+  GenSystemArrayCopyPrimitive(invoke, codegen_, Primitive::kPrimByte);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitSystemArrayCopyChar(HInvoke* invoke) {
+  CreateSystemArrayCopyPrimitiveLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitSystemArrayCopyChar(HInvoke* invoke) {
+  GenSystemArrayCopyPrimitive(invoke, codegen_, Primitive::kPrimChar);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitSystemArrayCopyShort(HInvoke* invoke) {
+  CreateSystemArrayCopyPrimitiveLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitSystemArrayCopyShort(HInvoke* invoke) {
+  GenSystemArrayCopyPrimitive(invoke, codegen_, Primitive::kPrimShort);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitSystemArrayCopyInt(HInvoke* invoke) {
+  CreateSystemArrayCopyPrimitiveLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitSystemArrayCopyInt(HInvoke* invoke) {
+  GenSystemArrayCopyPrimitive(invoke, codegen_, Primitive::kPrimInt);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitSystemArrayCopyLong(HInvoke* invoke) {
+  CreateSystemArrayCopyPrimitiveLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitSystemArrayCopyLong(HInvoke* invoke) {
+  GenSystemArrayCopyPrimitive(invoke, codegen_, Primitive::kPrimLong);
+}
+
+static void CreateArraysEqualsLocations(ArenaAllocator* arena, HInvoke* invoke) {
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kNoCall,
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->SetOut(Location::RequiresRegister());
+}
+
+static void GenArraysEquals(X86_64Assembler* assembler,
+                            LocationSummary* locations,
+                            Primitive::Type type) {
+  CpuRegister array1 = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister array2 = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister count = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister offset = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(2).AsRegister<CpuRegister>();
+  XmmRegister vector1 = locations->GetTemp(3).AsFpuRegister<XmmRegister>();
+  XmmRegister vector2 = locations->GetTemp(4).AsFpuRegister<XmmRegister>();
+
+  const size_t element_size = Primitive::ComponentSize(type);
+  const uint32_t length_offset = mirror::Array::LengthOffset().Uint32Value();
+  const uint32_t data_offset = mirror::Array::DataOffset(element_size).Uint32Value();
+
+  Label vector_loop, tail, element_loop, return_true, return_false, end;
+
+  // The same array, or both null: equal.
+  __ cmpl(array1, array2);
+  __ j(kEqual, &return_true);
+
+  // Only one of them null: not equal.
+  __ testl(array1, array1);
+  __ j(kEqual, &return_false);
+  __ testl(array2, array2);
+  __ j(kEqual, &return_false);
+
+  // Different lengths: not equal.
+  __ movl(count, Address(array1, length_offset));
+  __ cmpl(count, Address(array2, length_offset));
+  __ j(kNotEqual, &return_false);
+
+  // Compare the contents as raw bytes. `count` holds the number of bytes left to
+  // compare, and `offset` the offset of the next ones in both arrays.
+  if (element_size != 1u) {
+    __ shlq(count, Immediate(Primitive::ComponentSizeShift(type)));
+  }
+  __ xorl(offset, offset);
+
+  // Compare 16 bytes at a time.
+  __ cmpq(count, Immediate(16));
+  __ j(kLess, &tail);
+  __ Bind(&vector_loop);
+  __ movdqu(vector1, Address(array1, offset, TIMES_1, data_offset));
+  __ movdqu(vector2, Address(array2, offset, TIMES_1, data_offset));
+  __ pcmpeqb(vector1, vector2);
+  __ pmovmskb(temp, vector1);
+  __ cmpl(temp, Immediate(0xffff));
+  __ j(kNotEqual, &return_false);
+  __ addq(offset, Immediate(16));
+  __ subq(count, Immediate(16));
+  __ cmpq(count, Immediate(16));
+  __ j(kGreaterEqual, &vector_loop);
+
+  // Compare 8 bytes, then the remaining elements one at a time. The data of an
+  // array is not padded to a multiple of 16 bytes, so we cannot read past it.
+  __ Bind(&tail);
+  __ cmpq(count, Immediate(8));
+  __ j(kLess, &element_loop);
+  __ movq(temp, Address(array1, offset, TIMES_1, data_offset));
+  __ cmpq(temp, Address(array2, offset, TIMES_1, data_offset));
+  __ j(kNotEqual, &return_false);
+  __ addq(offset, Immediate(8));
+  __ subq(count, Immediate(8));
+
+  __ Bind(&element_loop);
+  // Long arrays have no data left after the 8 bytes comparison.
+  if (type != Primitive::kPrimLong) {
+    __ testq(count, count);
+    __ j(kEqual, &return_true);
+    switch (type) {
+      case Primitive::kPrimByte:
+        __ movzxb(temp, Address(array1, offset, TIMES_1, data_offset));
+        __ movzxb(out, Address(array2, offset, TIMES_1, data_offset));
+        __ cmpl(temp, out);
+        break;
+      case Primitive::kPrimChar:
+      case Primitive::kPrimShort:
+        __ movzxw(temp, Address(array1, offset, TIMES_1, data_offset));
+        __ movzxw(out, Address(array2, offset, TIMES_1, data_offset));
+        __ cmpl(temp, out);
+        break;
+      case Primitive::kPrimInt:
+        __ movl(temp, Address(array1, offset, TIMES_1, data_offset));
+        __ cmpl(temp, Address(array2, offset, TIMES_1, data_offset));
+        break;
+      default:
+        LOG(FATAL) << "Unexpected element type: " << type;
+        UNREACHABLE();
+    }
+    __ j(kNotEqual, &return_false);
+    __ addq(offset, Immediate(element_size));
+    __ subq(count, Immediate(element_size));
+    __ jmp(&element_loop);
+  }
+
+  __ Bind(&return_true);
+  __ movl(out, Immediate(1));
+  __ jmp(&end);
+
+  __ Bind(&return_false);
+  __ xorl(out, out);
+  __ Bind(&end);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysEqualsByte(HInvoke* invoke) {
+  CreateArraysEqualsLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysEqualsByte(HInvoke* invoke) {
+  GenArraysEquals(GetAssembler(), invoke->GetLocations(), Primitive::kPrimByte);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysEqualsChar(HInvoke* invoke) {
+  CreateArraysEqualsLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysEqualsChar(HInvoke* invoke) {
+  GenArraysEquals(GetAssembler(), invoke->GetLocations(), Primitive::kPrimChar);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysEqualsShort(HInvoke* invoke) {
+  CreateArraysEqualsLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysEqualsShort(HInvoke* invoke) {
+  GenArraysEquals(GetAssembler(), invoke->GetLocations(), Primitive::kPrimShort);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysEqualsInt(HInvoke* invoke) {
+  CreateArraysEqualsLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysEqualsInt(HInvoke* invoke) {
+  GenArraysEquals(GetAssembler(), invoke->GetLocations(), Primitive::kPrimInt);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysEqualsLong(HInvoke* invoke) {
+  CreateArraysEqualsLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysEqualsLong(HInvoke* invoke) {
+  GenArraysEquals(GetAssembler(), invoke->GetLocations(), Primitive::kPrimLong);
+}
+
+static void CreateArraysFillLocations(ArenaAllocator* arena, HInvoke* invoke) {
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kCallOnSlowPath,
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+}
+
+static void GenArraysFill(HInvoke* invoke, CodeGeneratorX86_64* codegen, Primitive::Type type) {
+  X86_64Assembler* assembler = down_cast<X86_64Assembler*>(codegen->GetAssembler());
+  LocationSummary* locations = invoke->GetLocations();
+  CpuRegister array = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister value = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister count = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister offset = locations->GetTemp(1).AsRegister<CpuRegister>();
+  XmmRegister vector = locations->GetTemp(2).AsFpuRegister<XmmRegister>();
+
+  const size_t element_size = Primitive::ComponentSize(type);
+  const uint32_t length_offset = mirror::Array::LengthOffset().Uint32Value();
+  const uint32_t data_offset = mirror::Array::DataOffset(element_size).Uint32Value();
+
+  // Let the runtime throw the NullPointerException.
+  SlowPathCode* slow_path =
+      new (codegen->GetGraph()->GetArena()) IntrinsicSlowPathX86_64(invoke);
+  codegen->AddSlowPath(slow_path);
+  __ testl(array, array);
+  __ j(kEqual, slow_path->GetEntryLabel());
+
+  // `count` holds the number of bytes left to fill, and `offset` the offset of
+  // the next ones in the array.
+  __ movl(count, Address(array, length_offset));
+  if (element_size != 1u) {
+    __ shlq(count, Immediate(Primitive::ComponentSizeShift(type)));
+  }
+  __ xorl(offset, offset);
+
+  // Replicate the value in all the lanes of `vector`.
+  if (type == Primitive::kPrimLong) {
+    __ movd(vector, value);
+    __ punpcklqdq(vector, vector);
+  } else {
+    __ movd(vector, value, /* is64bit */ false);
+    if (type == Primitive::kPrimByte) {
+      __ punpcklbw(vector, vector);
+      __ punpcklwd(vector, vector);
+    } else if (type != Primitive::kPrimInt) {
+      __ punpcklwd(vector, vector);
+    }
+    __ pshufd(vector, vector, Immediate(0));
+  }
+
+  // Store 16 bytes at a time, then the remaining elements one at a time.
+  Label vector_loop, element_loop;
+  __ cmpq(count, Immediate(16));
+  __ j(kLess, &element_loop);
+  __ Bind(&vector_loop);
+  __ movdqu(Address(array, offset, TIMES_1, data_offset), vector);
+  __ addq(offset, Immediate(16));
+  __ subq(count, Immediate(16));
+  __ cmpq(count, Immediate(16));
+  __ j(kGreaterEqual, &vector_loop);
+
+  __ Bind(&element_loop);
+  __ testq(count, count);
+  __ j(kEqual, slow_path->GetExitLabel());
+  switch (type) {
+    case Primitive::kPrimByte:
+      __ movb(Address(array, offset, TIMES_1, data_offset), value);
+      break;
+    case Primitive::kPrimChar:
+    case Primitive::kPrimShort:
+      __ movw(Address(array, offset, TIMES_1, data_offset), value);
+      break;
+    case Primitive::kPrimInt:
+      __ movl(Address(array, offset, TIMES_1, data_offset), value);
+      break;
+    case Primitive::kPrimLong:
+      __ movq(Address(array, offset, TIMES_1, data_offset), value);
+      break;
+    default:
+      LOG(FATAL) << "Unexpected element type: " << type;
+      UNREACHABLE();
+  }
+  __ addq(offset, Immediate(element_size));
+  __ subq(count, Immediate(element_size));
+  __ jmp(&element_loop);
+
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysFillByte(HInvoke* invoke) {
+  CreateArraysFillLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysFillByte(HInvoke* invoke) {
+  GenArraysFill(invoke, codegen_, Primitive::kPrimByte);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysFillChar(HInvoke* invoke) {
+  CreateArraysFillLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysFillChar(HInvoke* invoke) {
+  GenArraysFill(invoke, codegen_, Primitive::kPrimChar);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysFillShort(HInvoke* invoke) {
+  CreateArraysFillLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysFillShort(HInvoke* invoke) {
+  GenArraysFill(invoke, codegen_, Primitive::kPrimShort);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysFillInt(HInvoke* invoke) {
+  CreateArraysFillLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysFillInt(HInvoke* invoke) {
+  GenArraysFill(invoke, codegen_, Primitive::kPrimInt);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysFillLong(HInvoke* invoke) {
+  CreateArraysFillLocations(arena_, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysFillLong(HInvoke* invoke) {
+  GenArraysFill(invoke, codegen_, Primitive::kPrimLong);
+}
+
+static void CreateArraysHashCodeLocations(ArenaAllocator* arena,
+                                          CodeGeneratorX86_64* codegen,
+                                          HInvoke* invoke,
+                                          Primitive::Type type) {
+  // The vector loop needs PMULLD, from SSE4.1. The hash of long arrays is computed
+  // one element at a time.
+  if (type != Primitive::kPrimLong && !codegen->GetInstructionSetFeatures().HasSSE4_1()) {
+    return;
+  }
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kNoCall,
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  if (type != Primitive::kPrimLong) {
+    locations->AddTemp(Location::RequiresFpuRegister());
+    locations->AddTemp(Location::RequiresFpuRegister());
+    locations->AddTemp(Location::RequiresFpuRegister());
+  }
+  locations->SetOut(Location::RequiresRegister());
+}
+
+// Continues the hash in `out` with the `count` elements of type `type` found at `base` +
+// `data_offset`, that is, computes `out = 31 * out + element` for each of them, as done by
+// `Arrays.hashCode()` and `String.hashCode()`. Bytes of type `kPrimBoolean` are zero extended.
+// Clobbers the temporaries of `locations`.
+//
+// The vector loop hashes four elements at a time: each lane accumulates
+// `lane = 31^4 * lane + element`, with the initial hash in the last lane. Weighting
+// the lanes by 31^3, 31^2, 31 and 1 and adding them up gives the hash of the
+// elements visited so far, which the scalar loop then continues with.
+static void GenHashCodeLoops(X86_64Assembler* assembler,
+                             LocationSummary* locations,
+                             CpuRegister base,
+                             uint32_t data_offset,
+                             Primitive::Type type) {
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister count = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister index = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(2).AsRegister<CpuRegister>();
+  const ScaleFactor scale_factor = static_cast<ScaleFactor>(Primitive::ComponentSizeShift(type));
+
+  Label element_loop, end;
+  __ xorl(index, index);
+
+  if (type != Primitive::kPrimLong) {
+    XmmRegister accumulator = locations->GetTemp(3).AsFpuRegister<XmmRegister>();
+    XmmRegister elements = locations->GetTemp(4).AsFpuRegister<XmmRegister>();
+    XmmRegister factors = locations->GetTemp(5).AsFpuRegister<XmmRegister>();
+    Label vector_loop;
+
+    __ cmpl(count, Immediate(4));
+    __ j(kLess, &element_loop);
+
+    // accumulator = [0, 0, 0, out], factors = [31^4, 31^4, 31^4, 31^4].
+    __ movd(accumulator, out, /* is64bit */ false);
+    __ pshufd(accumulator, accumulator, Immediate(0x15));
+    __ movl(temp, Immediate(31 * 31 * 31 * 31));
+    __ movd(factors, temp, /* is64bit */ false);
+    __ pshufd(factors, factors, Immediate(0));
+
+    __ Bind(&vector_loop);
+    // Load four elements, sign or zero extended to 32 bits.
+    switch (type) {
+      case Primitive::kPrimBoolean:
+        __ movss(elements, Address(base, index, scale_factor, data_offset));
+        __ punpcklbw(elements, elements);
+        __ punpcklwd(elements, elements);
+        __ psrld(elements, Immediate(24));
+        break;
+      case Primitive::kPrimByte:
+        __ movss(elements, Address(base, index, scale_factor, data_offset));
+        __ punpcklbw(elements, elements);
+        __ punpcklwd(elements, elements);
+        __ psrad(elements, Immediate(24));
+        break;
+      case Primitive::kPrimChar:
+        __ movsd(elements, Address(base, index, scale_factor, data_offset));
+        __ punpcklwd(elements, elements);
+        __ psrld(elements, Immediate(16));
+        break;
+      case Primitive::kPrimShort:
+        __ movsd(elements, Address(base, index, scale_factor, data_offset));
+        __ punpcklwd(elements, elements);
+        __ psrad(elements, Immediate(16));
+        break;
+      case Primitive::kPrimInt:
+        __ movdqu(elements, Address(base, index, scale_factor, data_offset));
+        break;
+      default:
+        LOG(FATAL) << "Unexpected element type: " << type;
+        UNREACHABLE();
+    }
+    __ pmulld(accumulator, factors);
+    __ paddd(accumulator, elements);
+    __ addl(index, Immediate(4));
+    __ subl(count, Immediate(4));
+    __ cmpl(count, Immediate(4));
+    __ j(kGreaterEqual, &vector_loop);
+
+    // factors = [31^3, 31^2, 31, 1].
+    __ movq(temp, Immediate((INT64_C(31 * 31) << 32) | (31 * 31 * 31)));
+    __ movd(factors, temp);
+    __ movq(temp, Immediate((INT64_C(1) << 32) | 31));
+    __ movd(elements, temp);
+    __ punpcklqdq(factors, elements);
+
+    // Reduce the lanes.
+    __ pmulld(accumulator, factors);
+    __ phaddd(accumulator, accumulator);
+    __ phaddd(accumulator, accumulator);
+    __ movd(out, accumulator, /* is64bit */ false);
+  }
+
+  __ Bind(&element_loop);
+  __ testl(count, count);
+  __ j(kEqual, &end);
+  switch (type) {
+    case Primitive::kPrimBoolean:
+      __ movzxb(temp, Address(base, index, scale_factor, data_offset));
+      break;
+    case Primitive::kPrimByte:
+      __ movsxb(temp, Address(base, index, scale_factor, data_offset));
+      break;
+    case Primitive::kPrimChar:
+      __ movzxw(temp, Address(base, index, scale_factor, data_offset));
+      break;
+    case Primitive::kPrimShort:
+      __ movsxw(temp, Address(base, index, scale_factor, data_offset));
+      break;
+    case Primitive::kPrimInt:
+      __ movl(temp, Address(base, index, scale_factor, data_offset));
+      break;
+    case Primitive::kPrimLong:
+      // Long.hashCode(): (int) (value ^ (value >>> 32)).
+      __ movl(temp, Address(base, index, scale_factor, data_offset + sizeof(int32_t)));
+      __ xorl(temp, Address(base, index, scale_factor, data_offset));
+      break;
+    default:
+      LOG(FATAL) << "Unexpected element type: " << type;
+      UNREACHABLE();
+  }
+  __ imull(out, out, Immediate(31));
+  __ addl(out, temp);
+  __ addl(index, Immediate(1));
+  __ subl(count, Immediate(1));
+  __ jmp(&element_loop);
+
+  __ Bind(&end);
+}
+
+static void GenArraysHashCode(X86_64Assembler* assembler,
+                              LocationSummary* locations,
+                              Primitive::Type type) {
+  CpuRegister array = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister count = locations->GetTemp(0).AsRegister<CpuRegister>();
+
+  const uint32_t length_offset = mirror::Array::LengthOffset().Uint32Value();
+  const uint32_t data_offset =
+      mirror::Array::DataOffset(Primitive::ComponentSize(type)).Uint32Value();
+
+  Label end;
+
+  // The hash of a null array is 0.
+  __ xorl(out, out);
+  __ testl(array, array);
+  __ j(kEqual, &end);
+
+  // Otherwise, the hash starts at 1.
+  __ movl(count, Address(array, length_offset));
+  __ movl(out, Immediate(1));
+  GenHashCodeLoops(assembler, locations, array, data_offset, type);
+
+  __ Bind(&end);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysHashCodeByte(HInvoke* invoke) {
+  CreateArraysHashCodeLocations(arena_, codegen_, invoke, Primitive::kPrimByte);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysHashCodeByte(HInvoke* invoke) {
+  GenArraysHashCode(GetAssembler(), invoke->GetLocations(), Primitive::kPrimByte);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysHashCodeChar(HInvoke* invoke) {
+  CreateArraysHashCodeLocations(arena_, codegen_, invoke, Primitive::kPrimChar);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysHashCodeChar(HInvoke* invoke) {
+  GenArraysHashCode(GetAssembler(), invoke->GetLocations(), Primitive::kPrimChar);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysHashCodeShort(HInvoke* invoke) {
+  CreateArraysHashCodeLocations(arena_, codegen_, invoke, Primitive::kPrimShort);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysHashCodeShort(HInvoke* invoke) {
+  GenArraysHashCode(GetAssembler(), invoke->GetLocations(), Primitive::kPrimShort);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysHashCodeInt(HInvoke* invoke) {
+  CreateArraysHashCodeLocations(arena_, codegen_, invoke, Primitive::kPrimInt);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysHashCodeInt(HInvoke* invoke) {
+  GenArraysHashCode(GetAssembler(), invoke->GetLocations(), Primitive::kPrimInt);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitArraysHashCodeLong(HInvoke* invoke) {
+  CreateArraysHashCodeLocations(arena_, codegen_, invoke, Primitive::kPrimLong);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitArraysHashCodeLong(HInvoke* invoke) {
+  GenArraysHashCode(GetAssembler(), invoke->GetLocations(), Primitive::kPrimLong);
+}
+
 
 void IntrinsicLocationsBuilderX86_64::VisitSystemArrayCopy(HInvoke* invoke) {
   // The only read barrier implementation supporting the
@@ -1810,6 +2380,64 @@ static void GenerateStringIndexOf(HInvoke* invoke,
   }
 }
 
+void IntrinsicLocationsBuilderX86_64::VisitStringHashCode(HInvoke* invoke) {
+  // The vector loop needs PMULLD, from SSE4.1.
+  if (!codegen_->GetInstructionSetFeatures().HasSSE4_1()) {
+    return;
+  }
+  LocationSummary* locations = new (arena_) LocationSummary(invoke,
+                                                            LocationSummary::kNoCall,
+                                                            kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->SetOut(Location::RequiresRegister());
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitStringHashCode(HInvoke* invoke) {
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister str = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister count = locations->GetTemp(0).AsRegister<CpuRegister>();
+
+  const uint32_t hash_code_offset = mirror::String::HashCodeOffset().Uint32Value();
+  const uint32_t count_offset = mirror::String::CountOffset().Uint32Value();
+  const uint32_t value_offset = mirror::String::ValueOffset().Uint32Value();
+
+  Label store_hash_code, end;
+
+  // Return the cached hash code, if any. Like String.hashCode(), we recompute a hash
+  // code of 0 every time.
+  __ movl(out, Address(str, hash_code_offset));
+  __ testl(out, out);
+  __ j(kNotEqual, &end);
+
+  __ movl(count, Address(str, count_offset));
+  if (mirror::kUseStringCompression) {
+    Label uncompressed;
+    // Extract the length, and the compression flag in the carry.
+    __ shrl(count, Immediate(1));
+    static_assert(static_cast<uint32_t>(mirror::StringCompressionFlag::kCompressed) == 0u,
+                  "Expecting 0=compressed, 1=uncompressed");
+    __ j(kCarrySet, &uncompressed);
+    GenHashCodeLoops(assembler, locations, str, value_offset, Primitive::kPrimBoolean);
+    __ jmp(&store_hash_code);
+    __ Bind(&uncompressed);
+  }
+  GenHashCodeLoops(assembler, locations, str, value_offset, Primitive::kPrimChar);
+
+  // Racing threads store the same value, so there is no need for synchronization.
+  __ Bind(&store_hash_code);
+  __ movl(Address(str, hash_code_offset), out);
+  __ Bind(&end);
+}
+
 void IntrinsicLocationsBuilderX86_64::VisitStringIndexOf(HInvoke* invoke) {
   CreateStringIndexOfLocations(invoke, arena_, /* start_at_zero */ true);
 }
@@ -2532,6 +3160,146 @@ void IntrinsicCodeGeneratorX86_64::VisitUnsafeCASObject(HInvoke* invoke) {
   GenCAS(Primitive::kPrimNot, invoke, codegen_);
 }
 
+static void CreateUnsafeGetAndUpdateLocations(ArenaAllocator* arena,
+                                              Primitive::Type type,
+                                              HInvoke* invoke) {
+  bool can_call = kEmitCompilerReadBarrier &&
+      kUseBakerReadBarrier &&
+      (invoke->GetIntrinsic() == Intrinsics::kUnsafeGetAndSetObject);
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           (can_call
+                                                                ? LocationSummary::kCallOnSlowPath
+                                                                : LocationSummary::kNoCall),
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::NoLocation());        // Unused receiver.
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetInAt(2, Location::RequiresRegister());
+  locations->SetInAt(3, Location::RequiresRegister());
+  // The new value is copied to `out`, which receives the old value, so it must not share a
+  // register with the address of the field.
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+  if (type == Primitive::kPrimNot) {
+    // Need temporary registers for card-marking, and possibly for
+    // (Baker) read barrier.
+    locations->AddTemp(Location::RequiresRegister());
+    locations->AddTemp(Location::RequiresRegister());
+  }
+}
+
+// Unsafe.getAndAdd*() and Unsafe.getAndSet*(). The LOCK XADD and XCHG instructions are
+// full barriers, as required by these volatile accesses, so no fence is needed.
+static void GenUnsafeGetAndUpdate(HInvoke* invoke,
+                                  Primitive::Type type,
+                                  bool is_add,
+                                  CodeGeneratorX86_64* codegen) {
+  X86_64Assembler* assembler = down_cast<X86_64Assembler*>(codegen->GetAssembler());
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister base = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister offset = locations->InAt(2).AsRegister<CpuRegister>();
+  CpuRegister value = locations->InAt(3).AsRegister<CpuRegister>();
+  Location out_loc = locations->Out();
+  CpuRegister out = out_loc.AsRegister<CpuRegister>();
+  Address field_addr(base, offset, ScaleFactor::TIMES_1, 0);
+
+  if (type == Primitive::kPrimNot) {
+    DCHECK(!is_add);
+    // The only read barrier implementation supporting the
+    // UnsafeGetAndSetObject intrinsic is the Baker-style read barriers.
+    DCHECK(!kEmitCompilerReadBarrier || kUseBakerReadBarrier);
+
+    CpuRegister temp1 = locations->GetTemp(0).AsRegister<CpuRegister>();
+    CpuRegister temp2 = locations->GetTemp(1).AsRegister<CpuRegister>();
+
+    bool value_can_be_null = true;  // TODO: Worth finding out this information?
+    codegen->MarkGCCard(temp1, temp2, base, value, value_can_be_null);
+
+    if (kEmitCompilerReadBarrier && kUseBakerReadBarrier) {
+      // Make sure the reference stored in the field is a to-space one, so
+      // that the old value returned by the exchange is one too.
+      codegen->GenerateReferenceLoadWithBakerReadBarrier(
+          invoke,
+          out_loc,  // Unused, used only as a "temporary" within the read barrier.
+          base,
+          field_addr,
+          /* needs_null_check */ false,
+          /* always_update_field */ true,
+          &temp1,
+          &temp2);
+    }
+
+    __ movl(out, value);
+    __ MaybePoisonHeapReference(out);
+    __ xchgl(out, field_addr);
+    __ MaybeUnpoisonHeapReference(out);
+  } else if (type == Primitive::kPrimInt) {
+    __ movl(out, value);
+    if (is_add) {
+      __ LockXaddl(field_addr, out);
+    } else {
+      __ xchgl(out, field_addr);
+    }
+  } else {
+    DCHECK_EQ(type, Primitive::kPrimLong);
+    __ movq(out, value);
+    if (is_add) {
+      __ LockXaddq(field_addr, out);
+    } else {
+      __ xchgq(out, field_addr);
+    }
+  }
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitUnsafeGetAndAddInt(HInvoke* invoke) {
+  CreateUnsafeGetAndUpdateLocations(arena_, Primitive::kPrimInt, invoke);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitUnsafeGetAndAddLong(HInvoke* invoke) {
+  CreateUnsafeGetAndUpdateLocations(arena_, Primitive::kPrimLong, invoke);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitUnsafeGetAndSetInt(HInvoke* invoke) {
+  CreateUnsafeGetAndUpdateLocations(arena_, Primitive::kPrimInt, invoke);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitUnsafeGetAndSetLong(HInvoke* invoke) {
+  CreateUnsafeGetAndUpdateLocations(arena_, Primitive::kPrimLong, invoke);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitUnsafeGetAndSetObject(HInvoke* invoke) {
+  // The only read barrier implementation supporting the
+  // UnsafeGetAndSetObject intrinsic is the Baker-style read barriers.
+  if (kEmitCompilerReadBarrier && !kUseBakerReadBarrier) {
+    return;
+  }
+
+  CreateUnsafeGetAndUpdateLocations(arena_, Primitive::kPrimNot, invoke);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitUnsafeGetAndAddInt(HInvoke* invoke) {
+  GenUnsafeGetAndUpdate(invoke, Primitive::kPrimInt, /* is_add */ true, codegen_);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitUnsafeGetAndAddLong(HInvoke* invoke) {
+  GenUnsafeGetAndUpdate(invoke, Primitive::kPrimLong, /* is_add */ true, codegen_);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitUnsafeGetAndSetInt(HInvoke* invoke) {
+  GenUnsafeGetAndUpdate(invoke, Primitive::kPrimInt, /* is_add */ false, codegen_);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitUnsafeGetAndSetLong(HInvoke* invoke) {
+  GenUnsafeGetAndUpdate(invoke, Primitive::kPrimLong, /* is_add */ false, codegen_);
+}
+
+void IntrinsicCodeGeneratorX86_64::VisitUnsafeGetAndSetObject(HInvoke* invoke) {
+  // The only read barrier implementation supporting the
+  // UnsafeGetAndSetObject intrinsic is the Baker-style read barriers.
+  DCHECK(!kEmitCompilerReadBarrier || kUseBakerReadBarrier);
+
+  GenUnsafeGetAndUpdate(invoke, Primitive::kPrimNot, /* is_add */ false, codegen_);
+}
+
 void IntrinsicLocationsBuilderX86_64::VisitIntegerReverse(HInvoke* invoke) {
   LocationSummary* locations = new (arena_) LocationSummary(invoke,
                                                            LocationSummary::kNoCall,
@@ -3045,9 +3813,300 @@ void IntrinsicCodeGeneratorX86_64::VisitThreadInterrupted(HInvoke* invoke) {
   __ Bind(&done);
 }
 
+static void CreateZipUpdateLocations(ArenaAllocator* arena, HInvoke* invoke) {
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kNoCall,
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+// Largest prime smaller than 2^16, the modulus of the Adler32 sums.
+static constexpr int32_t kAdler32Base = 65521;
+
+// Longer buffers are checksummed by zlib, so that the thread reaches its next suspend check
+// in a bounded time.
+static constexpr int32_t kCRC32UpdateBytesThreshold = 64 * KB;
+
+// Constants for computing the CRC32 of zlib with carry-less multiplications, see "Fast CRC
+// Computation for Generic Polynomials Using PCLMULQDQ Instruction" by Intel. All of them are
+// bit-reflected, as is the CRC.
+// (x^(128+32) mod P << 32)' << 1 and (x^(128-32) mod P << 32)' << 1, fold 16 bytes.
+static constexpr int64_t kCRC32Fold128Low = INT64_C(0x1751997d0);
+static constexpr int64_t kCRC32Fold128High = INT64_C(0x0ccaa009e);
+// (x^64 mod P << 32)' << 1, folds 96 bits into 64.
+static constexpr int64_t kCRC32Fold96 = INT64_C(0x163cd6124);
+// P' and (x^64 / P)', for the Barrett reduction of 64 bits into the 32 bits of the CRC.
+static constexpr int64_t kCRC32Polynomial = INT64_C(0x1db710641);
+static constexpr int64_t kCRC32BarrettMu = INT64_C(0x1f7011641);
+
+// Clears all but the low doubleword of each quadword of `reg`.
+static void GenZeroExtendLowDoublewords(X86_64Assembler* assembler, XmmRegister reg) {
+  __ psllq(reg, Immediate(32));
+  __ psrlq(reg, Immediate(32));
+}
+
+// Reduces the low quadword of `value` modulo the CRC32 polynomial, and sets `out` to the
+// remainder.
+static void GenCRC32BarrettReduction(CodeGeneratorX86_64* codegen,
+                                     CpuRegister out,
+                                     XmmRegister value,
+                                     XmmRegister constant,
+                                     XmmRegister temp) {
+  X86_64Assembler* assembler = codegen->GetAssembler();
+  __ movaps(temp, value);
+  GenZeroExtendLowDoublewords(assembler, value);
+  codegen->Load64BitValue(constant, kCRC32BarrettMu);
+  __ pclmulqdq(value, constant, Immediate(0x00));
+  GenZeroExtendLowDoublewords(assembler, value);
+  codegen->Load64BitValue(constant, kCRC32Polynomial);
+  __ pclmulqdq(value, constant, Immediate(0x00));
+  __ pxor(value, temp);
+  // The remainder is in the second doubleword.
+  __ movd(out, value, /* is64bit */ true);
+  __ shrq(out, Immediate(32));
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitCRC32Update(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasPCLMULQDQ()) {
+    return;
+  }
+  LocationSummary* locations = new (arena_) LocationSummary(invoke,
+                                                            LocationSummary::kNoCall,
+                                                            kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+// CRC32.update(int crc, int b).
+void IntrinsicCodeGeneratorX86_64::VisitCRC32Update(HInvoke* invoke) {
+  DCHECK(codegen_->GetInstructionSetFeatures().HasPCLMULQDQ());
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister crc = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister value = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  XmmRegister xmm_value = locations->GetTemp(0).AsFpuRegister<XmmRegister>();
+  XmmRegister xmm_constant = locations->GetTemp(1).AsFpuRegister<XmmRegister>();
+  XmmRegister xmm_temp = locations->GetTemp(2).AsFpuRegister<XmmRegister>();
+
+  // zlib keeps the CRC inverted while updating it. Multiply the low byte of `value`, xored
+  // into the CRC, by x^32 and reduce it, together with the rest of the CRC.
+  __ movzxb(out, value);
+  __ xorl(out, crc);
+  __ notl(out);
+  __ shlq(out, Immediate(24));
+  __ movd(xmm_value, out, /* is64bit */ true);
+  GenCRC32BarrettReduction(codegen_, out, xmm_value, xmm_constant, xmm_temp);
+  __ notl(out);
+}
+
+static void CreateCRC32UpdateBytesLocations(ArenaAllocator* arena, HInvoke* invoke) {
+  HIntConstant* length = invoke->InputAt(3)->AsIntConstant();
+  if (length != nullptr && length->GetValue() > kCRC32UpdateBytesThreshold) {
+    // Just call as normal.
+    return;
+  }
+
+  LocationSummary* locations = new (arena) LocationSummary(invoke,
+                                                           LocationSummary::kCallOnSlowPath,
+                                                           kIntrinsified);
+  locations->SetInAt(0, Location::RequiresRegister());
+  locations->SetInAt(1, Location::RequiresRegister());
+  locations->SetInAt(2, Location::RequiresRegister());
+  locations->SetInAt(3, Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->AddTemp(Location::RequiresFpuRegister());
+  locations->SetOut(Location::RequiresRegister(), Location::kOutputOverlap);
+}
+
+static void GenCRC32UpdateBytes(HInvoke* invoke,
+                                CodeGeneratorX86_64* codegen,
+                                bool is_byte_buffer) {
+  DCHECK(codegen->GetInstructionSetFeatures().HasPCLMULQDQ());
+  X86_64Assembler* assembler = codegen->GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister crc = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister base = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister offset = locations->InAt(2).AsRegister<CpuRegister>();
+  CpuRegister length = locations->InAt(3).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister ptr = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister end = locations->GetTemp(1).AsRegister<CpuRegister>();
+  CpuRegister remaining = locations->GetTemp(2).AsRegister<CpuRegister>();
+  XmmRegister xmm_value = locations->GetTemp(3).AsFpuRegister<XmmRegister>();
+  XmmRegister xmm_constant = locations->GetTemp(4).AsFpuRegister<XmmRegister>();
+  XmmRegister xmm_temp = locations->GetTemp(5).AsFpuRegister<XmmRegister>();
+
+  SlowPathCode* slow_path =
+      new (codegen->GetGraph()->GetArena()) IntrinsicSlowPathX86_64(invoke);
+  codegen->AddSlowPath(slow_path);
+
+  // The callers have checked the bounds, so `offset` and `length` are not negative.
+  __ cmpl(length, Immediate(kCRC32UpdateBytesThreshold));
+  __ j(kGreater, slow_path->GetEntryLabel());
+
+  __ movl(ptr, offset);
+  if (is_byte_buffer) {
+    __ addq(ptr, base);
+  } else {
+    const int32_t data_offset = mirror::Array::DataOffset(sizeof(uint8_t)).Int32Value();
+    __ leaq(ptr, Address(base, ptr, TIMES_1, data_offset));
+  }
+  __ movl(end, length);
+  __ addq(end, ptr);
+
+  Label fold_loop, fold_done, word_loop, byte_loop, done;
+
+  // zlib keeps the CRC inverted while updating it.
+  __ movl(out, crc);
+  __ notl(out);
+
+  __ movq(remaining, end);
+  __ subq(remaining, ptr);
+  __ cmpq(remaining, Immediate(16));
+  __ j(kLess, &word_loop);
+
+  // Xor the CRC into the first 16 bytes, then fold them into the next 16 bytes until fewer
+  // than 16 bytes remain.
+  __ movdqu(xmm_value, Address(ptr, 0));
+  __ movd(xmm_temp, out, /* is64bit */ false);
+  __ pxor(xmm_value, xmm_temp);
+  __ addq(ptr, Immediate(16));
+  codegen->Load64BitValue(xmm_constant, kCRC32Fold128Low);
+  codegen->Load64BitValue(xmm_temp, kCRC32Fold128High);
+  __ punpcklqdq(xmm_constant, xmm_temp);
+
+  __ Bind(&fold_loop);
+  __ movq(remaining, end);
+  __ subq(remaining, ptr);
+  __ cmpq(remaining, Immediate(16));
+  __ j(kLess, &fold_done);
+  __ movaps(xmm_temp, xmm_value);
+  __ pclmulqdq(xmm_temp, xmm_constant, Immediate(0x11));
+  __ pclmulqdq(xmm_value, xmm_constant, Immediate(0x00));
+  __ pxor(xmm_value, xmm_temp);
+  __ movdqu(xmm_temp, Address(ptr, 0));
+  __ pxor(xmm_value, xmm_temp);
+  __ addq(ptr, Immediate(16));
+  __ jmp(&fold_loop);
+
+  // Fold the 128 bits into 96, appending the 32 zero bits of the CRC, then into 64.
+  __ Bind(&fold_done);
+  __ pclmulqdq(xmm_constant, xmm_value, Immediate(0x01));
+  __ psrldq(xmm_value, Immediate(8));
+  __ pxor(xmm_value, xmm_constant);
+  __ movaps(xmm_temp, xmm_value);
+  __ psrldq(xmm_temp, Immediate(4));
+  GenZeroExtendLowDoublewords(assembler, xmm_value);
+  codegen->Load64BitValue(xmm_constant, kCRC32Fold96);
+  __ pclmulqdq(xmm_value, xmm_constant, Immediate(0x00));
+  __ pxor(xmm_value, xmm_temp);
+  GenCRC32BarrettReduction(codegen, out, xmm_value, xmm_constant, xmm_temp);
+
+  // The remaining bytes are xored into the CRC, which is then multiplied by x^32 and reduced.
+  __ Bind(&word_loop);
+  __ movq(remaining, end);
+  __ subq(remaining, ptr);
+  __ cmpq(remaining, Immediate(4));
+  __ j(kLess, &byte_loop);
+  __ xorl(out, Address(ptr, 0));
+  __ movd(xmm_value, out, /* is64bit */ true);
+  GenCRC32BarrettReduction(codegen, out, xmm_value, xmm_constant, xmm_temp);
+  __ addq(ptr, Immediate(4));
+  __ jmp(&word_loop);
+
+  __ Bind(&byte_loop);
+  __ cmpq(ptr, end);
+  __ j(kEqual, &done);
+  __ movzxb(remaining, Address(ptr, 0));
+  __ xorl(out, remaining);
+  __ shlq(out, Immediate(24));
+  __ movd(xmm_value, out, /* is64bit */ true);
+  GenCRC32BarrettReduction(codegen, out, xmm_value, xmm_constant, xmm_temp);
+  __ addq(ptr, Immediate(1));
+  __ jmp(&byte_loop);
+
+  __ Bind(&done);
+  __ notl(out);
+  __ Bind(slow_path->GetExitLabel());
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitCRC32UpdateBytes(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasPCLMULQDQ()) {
+    return;
+  }
+  CreateCRC32UpdateBytesLocations(arena_, invoke);
+}
+
+// CRC32.updateBytes(int crc, byte[] b, int off, int len).
+void IntrinsicCodeGeneratorX86_64::VisitCRC32UpdateBytes(HInvoke* invoke) {
+  GenCRC32UpdateBytes(invoke, codegen_, /* is_byte_buffer */ false);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitCRC32UpdateByteBuffer(HInvoke* invoke) {
+  if (!codegen_->GetInstructionSetFeatures().HasPCLMULQDQ()) {
+    return;
+  }
+  CreateCRC32UpdateBytesLocations(arena_, invoke);
+}
+
+// CRC32.updateByteBuffer(int crc, long addr, int off, int len).
+void IntrinsicCodeGeneratorX86_64::VisitCRC32UpdateByteBuffer(HInvoke* invoke) {
+  GenCRC32UpdateBytes(invoke, codegen_, /* is_byte_buffer */ true);
+}
+
+void IntrinsicLocationsBuilderX86_64::VisitAdler32Update(HInvoke* invoke) {
+  CreateZipUpdateLocations(arena_, invoke);
+}
+
+// Adler32.update(int adler, int b).
+void IntrinsicCodeGeneratorX86_64::VisitAdler32Update(HInvoke* invoke) {
+  X86_64Assembler* assembler = GetAssembler();
+  LocationSummary* locations = invoke->GetLocations();
+
+  CpuRegister adler = locations->InAt(0).AsRegister<CpuRegister>();
+  CpuRegister value = locations->InAt(1).AsRegister<CpuRegister>();
+  CpuRegister out = locations->Out().AsRegister<CpuRegister>();
+  CpuRegister sum = locations->GetTemp(0).AsRegister<CpuRegister>();
+  CpuRegister temp = locations->GetTemp(1).AsRegister<CpuRegister>();
+
+  // Both sums are below 2 * kAdler32Base, so one conditional subtraction reduces them.
+  __ movzxb(out, value);
+  __ movl(temp, adler);
+  __ andl(temp, Immediate(0xffff));
+  __ addl(out, temp);
+  __ leal(temp, Address(out, -kAdler32Base));
+  __ cmpl(out, Immediate(kAdler32Base));
+  __ cmov(kAboveEqual, out, temp, /* is64bit */ false);
+  __ movl(sum, adler);
+  __ shrl(sum, Immediate(16));
+  __ addl(sum, out);
+  __ leal(temp, Address(sum, -kAdler32Base));
+  __ cmpl(sum, Immediate(kAdler32Base));
+  __ cmov(kAboveEqual, sum, temp, /* is64bit */ false);
+  __ shll(sum, Immediate(16));
+  __ orl(out, sum);
+}
+
 UNIMPLEMENTED_INTRINSIC(X86_64, ReferenceGetReferent)
 UNIMPLEMENTED_INTRINSIC(X86_64, FloatIsInfinite)
 UNIMPLEMENTED_INTRINSIC(X86_64, DoubleIsInfinite)
+UNIMPLEMENTED_INTRINSIC(X86_64, Adler32UpdateBytes)
+UNIMPLEMENTED_INTRINSIC(X86_64, Adler32UpdateByteBuffer)
 
 UNIMPLEMENTED_INTRINSIC(X86_64, StringStringIndexOf);
 UNIMPLEMENTED_INTRINSIC(X86_64, StringStringIndexOfAfter);
@@ -3058,13 +4117,6 @@ UNIMPLEMENTED_INTRINSIC(X86_64, StringBuilderAppend);
 UNIMPLEMENTED_INTRINSIC(X86_64, StringBuilderLength);
 UNIMPLEMENTED_INTRINSIC(X86_64, StringBuilderToString);
 
-// 1.8.
-UNIMPLEMENTED_INTRINSIC(X86_64, UnsafeGetAndAddInt)
-UNIMPLEMENTED_INTRINSIC(X86_64, UnsafeGetAndAddLong)
-UNIMPLEMENTED_INTRINSIC(X86_64, UnsafeGetAndSetInt)
-UNIMPLEMENTED_INTRINSIC(X86_64, UnsafeGetAndSetLong)
-UNIMPLEMENTED_INTRINSIC(X86_64, UnsafeGetAndSetObject)
-
 UNREACHABLE_INTRINSICS(X86_64)
 
 #undef __
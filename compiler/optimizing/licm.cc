@@ -16,6 +16,7 @@
 
 #include "licm.h"
 
+#include "load_store_analysis.h"
 #include "side_effects_analysis.h"
 
 namespace art {
@@ -78,6 +79,156 @@ static void UpdateLoopPhisIn(HEnvironment* environment, HLoopInformation* info)
   }
 }
 
+static bool IsHeapLoad(HInstruction* instruction) {
+  return instruction->IsInstanceFieldGet() ||
+         instruction->IsStaticFieldGet() ||
+         instruction->IsArrayGet();
+}
+
+static bool IsHeapStore(HInstruction* instruction) {
+  return instruction->IsInstanceFieldSet() ||
+         instruction->IsStaticFieldSet() ||
+         instruction->IsArraySet();
+}
+
+static bool MayAlias(const HeapLocationCollector& heap_locations,
+                     size_t location1,
+                     size_t location2) {
+  return location1 == location2 || heap_locations.MayAlias(location1, location2);
+}
+
+/**
+ * Returns whether `instruction` is a load of a heap location that none of the
+ * heap locations in `writes` may alias, and that does not otherwise depend on `loop_effects`.
+ */
+static bool IsLoadOfUnwrittenLocation(const HeapLocationCollector& heap_locations,
+                                      HInstruction* instruction,
+                                      SideEffects loop_effects,
+                                      const ArenaVector<size_t>& writes) {
+  if (!IsHeapLoad(instruction) ||
+      instruction->GetSideEffects().MayDependOn(loop_effects.Exclusion(SideEffects::AllWrites()))) {
+    return false;
+  }
+  size_t location = heap_locations.GetHeapLocationOf(instruction);
+  if (location == HeapLocationCollector::kHeapLocationNotFound) {
+    return false;
+  }
+  for (size_t write : writes) {
+    if (MayAlias(heap_locations, location, write)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool LICM::CollectHeapWrites(const HeapLocationCollector& heap_locations,
+                             HLoopInformation* loop_info,
+                             ArenaVector<size_t>* writes) const {
+  for (HBlocksInLoopIterator it_loop(*loop_info); !it_loop.Done(); it_loop.Advance()) {
+    HBasicBlock* block = it_loop.Current();
+    for (HInstructionIterator inst_it(block->GetInstructions());
+         !inst_it.Done();
+         inst_it.Advance()) {
+      HInstruction* instruction = inst_it.Current();
+      if (!instruction->GetSideEffects().DoesAnyWrite()) {
+        continue;
+      }
+      if (!IsHeapStore(instruction)) {
+        return false;
+      }
+      size_t location = heap_locations.GetHeapLocationOf(instruction);
+      if (location == HeapLocationCollector::kHeapLocationNotFound) {
+        return false;
+      }
+      writes->push_back(location);
+    }
+  }
+  return true;
+}
+
+void LICM::SinkStores(const HeapLocationCollector& heap_locations, HLoopInformation* loop_info) {
+  // We only sink into the successor of a single exit edge.
+  HBasicBlock* exiting_block = nullptr;
+  HBasicBlock* exit_block = nullptr;
+  for (HBlocksInLoopIterator it_loop(*loop_info); !it_loop.Done(); it_loop.Advance()) {
+    HBasicBlock* block = it_loop.Current();
+    for (HBasicBlock* successor : block->GetSuccessors()) {
+      if (!loop_info->Contains(*successor)) {
+        if (exit_block != nullptr) {
+          return;
+        }
+        exiting_block = block;
+        exit_block = successor;
+      }
+    }
+  }
+  if (exit_block == nullptr ||
+      exit_block->IsExitBlock() ||
+      exit_block->GetPredecessors().size() != 1u) {
+    return;
+  }
+
+  // A store can only be delayed if nothing in the loop can observe it: no instruction
+  // throws, and all memory accesses are to known heap locations.
+  ArenaVector<HInstruction*> accesses(graph_->GetArena()->Adapter(kArenaAllocLICM));
+  for (HBlocksInLoopIterator it_loop(*loop_info); !it_loop.Done(); it_loop.Advance()) {
+    HBasicBlock* block = it_loop.Current();
+    for (HInstructionIterator inst_it(block->GetInstructions());
+         !inst_it.Done();
+         inst_it.Advance()) {
+      HInstruction* instruction = inst_it.Current();
+      if (instruction->CanThrow()) {
+        return;
+      }
+      SideEffects effects = instruction->GetSideEffects();
+      if (!effects.DoesAnyWrite() && !effects.DoesAnyRead()) {
+        continue;
+      }
+      if (!IsHeapLoad(instruction) && !IsHeapStore(instruction)) {
+        return;
+      }
+      if (heap_locations.GetHeapLocationOf(instruction) ==
+              HeapLocationCollector::kHeapLocationNotFound) {
+        return;
+      }
+      accesses.push_back(instruction);
+    }
+  }
+
+  // A store can be sunk if it stores to a loop invariant location, is executed in
+  // every iteration before the loop exits, and no other access of the loop may alias it.
+  // The stored value then dominates the exit.
+  ArenaVector<HInstruction*> stores_to_sink(graph_->GetArena()->Adapter(kArenaAllocLICM));
+  for (HInstruction* store : accesses) {
+    if (!IsHeapStore(store) ||
+        store->GetBlock()->GetLoopInformation() != loop_info ||
+        !store->GetBlock()->Dominates(exiting_block) ||
+        !loop_info->IsDefinedOutOfTheLoop(store->InputAt(0)) ||
+        (store->IsArraySet() && !loop_info->IsDefinedOutOfTheLoop(store->InputAt(1)))) {
+      continue;
+    }
+    size_t location = heap_locations.GetHeapLocationOf(store);
+    bool is_only_access = true;
+    for (HInstruction* other : accesses) {
+      if (other != store &&
+          MayAlias(heap_locations, location, heap_locations.GetHeapLocationOf(other))) {
+        is_only_access = false;
+        break;
+      }
+    }
+    if (is_only_access) {
+      stores_to_sink.push_back(store);
+    }
+  }
+
+  // Keep the sunk stores in their original order.
+  HInstruction* cursor = exit_block->GetFirstInstruction();
+  for (HInstruction* store : stores_to_sink) {
+    store->MoveBefore(cursor);
+    MaybeRecordStat(stats_, MethodCompilationStat::kLoopStoreSunk);
+  }
+}
+
 void LICM::Run() {
   DCHECK(side_effects_.HasRun());
 
@@ -90,6 +241,12 @@ void LICM::Run() {
                                                       kArenaAllocLICM);
   }
 
+  const HeapLocationCollector* heap_locations = nullptr;
+  if (lsa_ != nullptr && lsa_->GetHeapLocationCollector().GetNumberOfHeapLocations() != 0) {
+    heap_locations = &lsa_->GetHeapLocationCollector();
+  }
+  ArenaVector<size_t> loop_heap_writes(graph_->GetArena()->Adapter(kArenaAllocLICM));
+
   // Post order visit to visit inner loops before outer loops.
   for (HBasicBlock* block : graph_->GetPostOrder()) {
     if (!block->IsLoopHeader()) {
@@ -101,6 +258,13 @@ void LICM::Run() {
     SideEffects loop_effects = side_effects_.GetLoopEffects(block);
     HBasicBlock* pre_header = loop_info->GetPreHeader();
 
+    // Refine the side effects of the loop into the heap locations it writes.
+    loop_heap_writes.clear();
+    bool has_known_heap_writes = heap_locations != nullptr &&
+        loop_effects.DoesAnyWrite() &&
+        !loop_info->ContainsIrreducibleLoop() &&
+        CollectHeapWrites(*heap_locations, loop_info, &loop_heap_writes);
+
     for (HBlocksInLoopIterator it_loop(*loop_info); !it_loop.Done(); it_loop.Advance()) {
       HBasicBlock* inner = it_loop.Current();
       DCHECK(inner->IsInLoop());
@@ -131,7 +295,10 @@ void LICM::Run() {
         HInstruction* instruction = inst_it.Current();
         if (instruction->CanBeMoved()
             && (!instruction->CanThrow() || !found_first_non_hoisted_visible_instruction_in_loop)
-            && !instruction->GetSideEffects().MayDependOn(loop_effects)
+            && (!instruction->GetSideEffects().MayDependOn(loop_effects) ||
+                (has_known_heap_writes &&
+                 IsLoadOfUnwrittenLocation(
+                     *heap_locations, instruction, loop_effects, loop_heap_writes)))
             && InputsAreDefinedBeforeLoop(instruction)) {
           // We need to update the environment if the instruction has a loop header
           // phi in it.
@@ -149,6 +316,14 @@ void LICM::Run() {
         }
       }
     }
+
+    // Delaying stores is only visible to a debugger, or to a catch block.
+    if (heap_locations != nullptr &&
+        !graph_->IsDebuggable() &&
+        !graph_->HasTryCatch() &&
+        !loop_info->ContainsIrreducibleLoop()) {
+      SinkStores(*heap_locations, loop_info);
+    }
   }
 }
 
@@ -22,20 +22,40 @@
 
 namespace art {
 
+class HeapLocationCollector;
+class LoadStoreAnalysis;
 class SideEffectsAnalysis;
 
 class LICM : public HOptimization {
  public:
-  LICM(HGraph* graph, const SideEffectsAnalysis& side_effects, OptimizingCompilerStats* stats)
+  // When given, `lsa` refines the side effects of the loop into the heap locations it
+  // writes, to hoist loads of locations the loop does not write and to sink stores.
+  LICM(HGraph* graph,
+       const SideEffectsAnalysis& side_effects,
+       const LoadStoreAnalysis* lsa,
+       OptimizingCompilerStats* stats)
       : HOptimization(graph, kLoopInvariantCodeMotionPassName, stats),
-        side_effects_(side_effects) {}
+        side_effects_(side_effects),
+        lsa_(lsa) {}
 
   void Run() OVERRIDE;
 
   static constexpr const char* kLoopInvariantCodeMotionPassName = "licm";
 
  private:
+  // Collects in `writes` the heap locations that may be written in the loop. Returns
+  // false if the loop may write memory not described by a heap location, for example
+  // in a call.
+  bool CollectHeapWrites(const HeapLocationCollector& heap_locations,
+                         HLoopInformation* loop_info,
+                         ArenaVector<size_t>* writes) const;
+
+  // Moves stores of loop invariant heap locations, which no other instruction of the
+  // loop accesses, to the exit of the loop.
+  void SinkStores(const HeapLocationCollector& heap_locations, HLoopInformation* loop_info);
+
   const SideEffectsAnalysis& side_effects_;
+  const LoadStoreAnalysis* const lsa_;
 
   DISALLOW_COPY_AND_ASSIGN(LICM);
 };
@@ -18,6 +18,7 @@
 
 #include "base/arena_allocator.h"
 #include "builder.h"
+#include "load_store_analysis.h"
 #include "nodes.h"
 #include "optimizing_unit_test.h"
 #include "side_effects_analysis.h"
@@ -94,7 +95,42 @@ class LICMTest : public CommonCompilerTest {
     graph_->BuildDominatorTree();
     SideEffectsAnalysis side_effects(graph_);
     side_effects.Run();
-    LICM(graph_, side_effects, nullptr).Run();
+    LICM(graph_, side_effects, /* lsa */ nullptr, /* stats */ nullptr).Run();
+  }
+
+  // Performs LICM optimizations refined by the load store analysis (after proper set up).
+  void PerformLICMWithHeapLocations() {
+    graph_->BuildDominatorTree();
+    SideEffectsAnalysis side_effects(graph_);
+    side_effects.Run();
+    LoadStoreAnalysis lsa(graph_);
+    lsa.Run();
+    LICM(graph_, side_effects, &lsa, /* stats */ nullptr).Run();
+  }
+
+  HInstruction* MakeFieldGet(Primitive::Type type, size_t offset) {
+    return new (&allocator_) HInstanceFieldGet(parameter_,
+                                               nullptr,
+                                               type,
+                                               MemberOffset(offset),
+                                               false,
+                                               kUnknownFieldIndex,
+                                               kUnknownClassDefIndex,
+                                               graph_->GetDexFile(),
+                                               0);
+  }
+
+  HInstruction* MakeFieldSet(HInstruction* value, Primitive::Type type, size_t offset) {
+    return new (&allocator_) HInstanceFieldSet(parameter_,
+                                               value,
+                                               nullptr,
+                                               type,
+                                               MemberOffset(offset),
+                                               false,
+                                               kUnknownFieldIndex,
+                                               kUnknownClassDefIndex,
+                                               graph_->GetDexFile(),
+                                               0);
   }
 
   // General building fields.
@@ -215,4 +251,66 @@ TEST_F(LICMTest, NoArrayHoisting) {
   EXPECT_EQ(set_array->GetBlock(), loop_body_);
 }
 
+TEST_F(LICMTest, FieldHoistingWithHeapLocations) {
+  BuildLoop();
+
+  // Populate the loop with instructions: set/get different fields with the same type.
+  HInstruction* get_field = MakeFieldGet(Primitive::kPrimInt, 10);
+  loop_body_->InsertInstructionBefore(get_field, loop_body_->GetLastInstruction());
+  HInstruction* set_field = MakeFieldSet(int_constant_, Primitive::kPrimInt, 20);
+  loop_body_->InsertInstructionBefore(set_field, loop_body_->GetLastInstruction());
+
+  EXPECT_EQ(get_field->GetBlock(), loop_body_);
+  EXPECT_EQ(set_field->GetBlock(), loop_body_);
+  PerformLICMWithHeapLocations();
+  EXPECT_EQ(get_field->GetBlock(), loop_preheader_);
+  EXPECT_EQ(set_field->GetBlock(), loop_body_);
+}
+
+TEST_F(LICMTest, NoFieldHoistingWithHeapLocations) {
+  BuildLoop();
+
+  // Populate the loop with instructions: set/get the same field.
+  HInstruction* get_field = MakeFieldGet(Primitive::kPrimInt, 10);
+  loop_body_->InsertInstructionBefore(get_field, loop_body_->GetLastInstruction());
+  HInstruction* set_field = MakeFieldSet(int_constant_, Primitive::kPrimInt, 10);
+  loop_body_->InsertInstructionBefore(set_field, loop_body_->GetLastInstruction());
+
+  EXPECT_EQ(get_field->GetBlock(), loop_body_);
+  EXPECT_EQ(set_field->GetBlock(), loop_body_);
+  PerformLICMWithHeapLocations();
+  EXPECT_EQ(get_field->GetBlock(), loop_body_);
+  EXPECT_EQ(set_field->GetBlock(), loop_body_);
+}
+
+TEST_F(LICMTest, StoreSinking) {
+  BuildLoop();
+
+  // Populate the loop header, which is executed before exiting the loop, with a store.
+  HInstruction* set_field = MakeFieldSet(int_constant_, Primitive::kPrimInt, 10);
+  loop_header_->InsertInstructionBefore(set_field, loop_header_->GetLastInstruction());
+
+  EXPECT_EQ(set_field->GetBlock(), loop_header_);
+  PerformLICMWithHeapLocations();
+  EXPECT_EQ(set_field->GetBlock(), return_);
+}
+
+TEST_F(LICMTest, NoStoreSinking) {
+  BuildLoop();
+
+  // Populate the loop with instructions: the store is not executed before exiting the
+  // loop, and the loop reads the stored field.
+  HInstruction* set_field = MakeFieldSet(int_constant_, Primitive::kPrimInt, 10);
+  loop_body_->InsertInstructionBefore(set_field, loop_body_->GetLastInstruction());
+  HInstruction* get_field = MakeFieldGet(Primitive::kPrimInt, 10);
+  loop_header_->InsertInstructionBefore(get_field, loop_header_->GetLastInstruction());
+  HInstruction* set_field2 = MakeFieldSet(get_field, Primitive::kPrimInt, 10);
+  loop_header_->InsertInstructionBefore(set_field2, loop_header_->GetLastInstruction());
+
+  PerformLICMWithHeapLocations();
+  EXPECT_EQ(set_field->GetBlock(), loop_body_);
+  EXPECT_EQ(get_field->GetBlock(), loop_header_);
+  EXPECT_EQ(set_field2->GetBlock(), loop_header_);
+}
+
 }  // namespace art
@@ -16,8 +16,13 @@
 
 #include "linear_order.h"
 
+#include <algorithm>
+
 namespace art {
 
+// Blocks executed less than once every 50 invocations of the method are cold.
+static constexpr float kColdBlockFrequency = 0.02f;
+
 static bool InSameLoop(HLoopInformation* first_loop, HLoopInformation* second_loop) {
   return first_loop == second_loop;
 }
@@ -105,14 +110,26 @@ void LinearizeGraph(const HGraph* graph,
   //      iterate over the successors. When all non-back edge predecessors of a
   //      successor block are visited, the successor block is added in the worklist
   //      following an order that satisfies the requirements to build our linear graph.
+  //      When block frequencies are known, the successors are visited from the coldest
+  //      to the hottest, so that the hottest one is placed right after the current
+  //      block when possible, and the cold paths are moved out of the way.
   linear_order->reserve(graph->GetReversePostOrder().size());
   ArenaVector<HBasicBlock*> worklist(allocator->Adapter(kArenaAllocLinearOrder));
+  ArenaVector<HBasicBlock*> successors(allocator->Adapter(kArenaAllocLinearOrder));
   worklist.push_back(graph->GetEntryBlock());
   do {
     HBasicBlock* current = worklist.back();
     worklist.pop_back();
     linear_order->push_back(current);
-    for (HBasicBlock* successor : current->GetSuccessors()) {
+    successors.assign(current->GetSuccessors().begin(), current->GetSuccessors().end());
+    if (graph->HasBlockFrequencies()) {
+      std::stable_sort(successors.begin(),
+                       successors.end(),
+                       [](HBasicBlock* lhs, HBasicBlock* rhs) {
+                         return lhs->GetFrequency() < rhs->GetFrequency();
+                       });
+    }
+    for (HBasicBlock* successor : successors) {
       int block_id = successor->GetBlockId();
       size_t number_of_remaining_predecessors = forward_predecessors[block_id];
       if (number_of_remaining_predecessors == 1) {
@@ -125,4 +142,39 @@ void LinearizeGraph(const HGraph* graph,
   DCHECK(graph->HasIrreducibleLoops() || IsLinearOrderWellFormed(graph, linear_order));
 }
 
+static bool IsColdBlock(HBasicBlock* block) {
+  if (block->IsEntryBlock()) {
+    // The frame entry falls through to the entry block.
+    return false;
+  }
+  if (block->IsCatchBlock()) {
+    return true;
+  }
+  HInstruction* last = block->GetLastInstruction();
+  return (last != nullptr && last->IsThrow()) || block->GetFrequency() < kColdBlockFrequency;
+}
+
+size_t SplitColdBlocks(const HGraph* graph,
+                       const ArenaVector<HBasicBlock*>& linear_order,
+                       ArenaVector<HBasicBlock*>* code_order) {
+  DCHECK(code_order->empty());
+  DCHECK(graph->HasBlockFrequencies());
+  code_order->reserve(linear_order.size());
+  for (HBasicBlock* block : linear_order) {
+    if (!IsColdBlock(block)) {
+      code_order->push_back(block);
+    }
+  }
+  size_t number_of_cold_blocks = linear_order.size() - code_order->size();
+  if (number_of_cold_blocks != 0u) {
+    for (HBasicBlock* block : linear_order) {
+      if (IsColdBlock(block)) {
+        code_order->push_back(block);
+      }
+    }
+  }
+  DCHECK_EQ(code_order->size(), linear_order.size());
+  return number_of_cold_blocks;
+}
+
 }  // namespace art
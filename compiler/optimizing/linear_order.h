@@ -36,6 +36,15 @@ void LinearizeGraph(const HGraph* graph,
                     ArenaAllocator* allocator,
                     ArenaVector<HBasicBlock*>* linear_order);
 
+// Computes into 'code_order' the order in which the code generator emits the
+// blocks of 'linear_order': the blocks the block frequencies of 'graph' consider
+// cold (see block_frequency.h) are moved after all the other blocks, keeping
+// their relative order, so that hot code is densely packed at the start of the
+// method. Returns the number of cold blocks.
+size_t SplitColdBlocks(const HGraph* graph,
+                       const ArenaVector<HBasicBlock*>& linear_order,
+                       ArenaVector<HBasicBlock*>* code_order);
+
 }  // namespace art
 
 #endif  // ART_COMPILER_OPTIMIZING_LINEAR_ORDER_H_
@@ -133,7 +133,33 @@ bool HeapLocationCollector::CanArrayIndicesAlias(const HInstruction* idx1,
   return true;
 }
 
+size_t HeapLocationCollector::GetHeapLocationOf(HInstruction* instruction) const {
+  switch (instruction->GetKind()) {
+    case HInstruction::kInstanceFieldGet:
+      return GetFieldHeapLocation(instruction->InputAt(0),
+                                  instruction->AsInstanceFieldGet()->GetFieldInfo());
+    case HInstruction::kInstanceFieldSet:
+      return GetFieldHeapLocation(instruction->InputAt(0),
+                                  instruction->AsInstanceFieldSet()->GetFieldInfo());
+    case HInstruction::kStaticFieldGet:
+      return GetFieldHeapLocation(instruction->InputAt(0),
+                                  instruction->AsStaticFieldGet()->GetFieldInfo());
+    case HInstruction::kStaticFieldSet:
+      return GetFieldHeapLocation(instruction->InputAt(0),
+                                  instruction->AsStaticFieldSet()->GetFieldInfo());
+    case HInstruction::kArrayGet:
+    case HInstruction::kArraySet:
+      return GetArrayAccessHeapLocation(instruction->InputAt(0), instruction->InputAt(1));
+    default:
+      return kHeapLocationNotFound;
+  }
+}
+
 void LoadStoreAnalysis::Run() {
+  if (!graph_->HasTryCatch()) {
+    // A throw may not leave the method in the presence of try/catch.
+    heap_location_collector_.FindEscapeBlocks();
+  }
   for (HBasicBlock* block : graph_->GetReversePostOrder()) {
     heap_location_collector_.VisitBasicBlock(block);
   }
@@ -27,18 +27,22 @@ namespace art {
 // whether it's a singleton, returned, etc.
 class ReferenceInfo : public ArenaObject<kArenaAllocMisc> {
  public:
-  ReferenceInfo(HInstruction* reference, size_t pos)
+  ReferenceInfo(HInstruction* reference, size_t pos, const ArenaBitVector* escape_blocks = nullptr)
       : reference_(reference),
         position_(pos),
         is_singleton_(true),
         is_singleton_and_not_returned_(true),
         is_singleton_and_not_deopt_visible_(true),
+        is_partial_singleton_(false),
         has_index_aliasing_(false) {
     CalculateEscape(reference_,
                     nullptr,
                     &is_singleton_,
                     &is_singleton_and_not_returned_,
                     &is_singleton_and_not_deopt_visible_);
+    if (!is_singleton_ && escape_blocks != nullptr) {
+      is_partial_singleton_ = IsPartialSingleton(reference_, *escape_blocks);
+    }
   }
 
   HInstruction* GetReference() const {
@@ -70,6 +74,15 @@ class ReferenceInfo : public ArenaObject<kArenaAllocMisc> {
            (!is_singleton_and_not_returned_ || !is_singleton_and_not_deopt_visible_);
   }
 
+  // Returns true if reference_ is not a singleton, but only escapes in blocks that
+  // never flow back to the rest of the method (see HeapLocationCollector::IsEscapeBlock).
+  // Outside of these blocks, reference_ cannot be referred to by another name, nor be seen
+  // by callees. The allocation and stores into reference_ must be kept, for the blocks
+  // where it escapes.
+  bool IsPartialSingleton() const {
+    return is_partial_singleton_;
+  }
+
   bool HasIndexAliasing() {
     return has_index_aliasing_;
   }
@@ -90,6 +103,8 @@ class ReferenceInfo : public ArenaObject<kArenaAllocMisc> {
   bool is_singleton_and_not_returned_;
   // Is singleton and not used as an environment local of HDeoptimize.
   bool is_singleton_and_not_deopt_visible_;
+  // Is not a singleton, but is one outside of the blocks where it escapes.
+  bool is_partial_singleton_;
   // Some heap locations with reference_ have array index aliasing,
   // e.g. arr[i] and arr[j] may be the same location.
   bool has_index_aliasing_;
@@ -178,6 +193,7 @@ class HeapLocationCollector : public HGraphVisitor {
                          kInitialAliasingMatrixBitVectorSize,
                          true,
                          kArenaAllocLSE),
+        escape_blocks_(graph->GetArena(), 0, /* expandable */ true, kArenaAllocLSE),
         has_heap_stores_(false),
         has_volatile_(false),
         has_monitor_operations_(false) {}
@@ -187,6 +203,18 @@ class HeapLocationCollector : public HGraphVisitor {
     ref_info_array_.clear();
   }
 
+  // Collects the blocks where allocations may escape without preventing load/store
+  // elimination on them in the other blocks. These are the uncommon branches that
+  // end in an HThrow. Needs to be called before visiting the graph.
+  void FindEscapeBlocks() {
+    DCHECK(ref_info_array_.empty());
+    FindPostDominatedBlocks(GetGraph(), /* end_block */ nullptr, &escape_blocks_);
+  }
+
+  bool IsEscapeBlock(const HBasicBlock* block) const {
+    return escape_blocks_.IsBitSet(block->GetBlockId());
+  }
+
   size_t GetNumberOfHeapLocations() const {
     return heap_locations_.size();
   }
@@ -225,6 +253,20 @@ class HeapLocationCollector : public HGraphVisitor {
                                  HeapLocation::kDeclaringClassDefIndexForArrays);
   }
 
+  size_t GetFieldHeapLocation(HInstruction* object, const FieldInfo& field_info) const {
+    DCHECK(object != nullptr);
+    HInstruction* original_ref = HuntForOriginalReference(object);
+    ReferenceInfo* ref_info = FindReferenceInfoOf(original_ref);
+    return FindHeapLocationIndex(ref_info,
+                                 field_info.GetFieldOffset().SizeValue(),
+                                 nullptr,
+                                 field_info.GetDeclaringClassDefIndex());
+  }
+
+  // Returns the heap location read or written by the field or array access `instruction`,
+  // or kHeapLocationNotFound for other instructions.
+  size_t GetHeapLocationOf(HInstruction* instruction) const;
+
   bool HasHeapStores() const {
     return has_heap_stores_;
   }
@@ -362,7 +404,7 @@ class HeapLocationCollector : public HGraphVisitor {
     ReferenceInfo* ref_info = FindReferenceInfoOf(instruction);
     if (ref_info == nullptr) {
       size_t pos = ref_info_array_.size();
-      ref_info = new (GetGraph()->GetArena()) ReferenceInfo(instruction, pos);
+      ref_info = new (GetGraph()->GetArena()) ReferenceInfo(instruction, pos, &escape_blocks_);
       ref_info_array_.push_back(ref_info);
     }
     return ref_info;
@@ -514,6 +556,7 @@ class HeapLocationCollector : public HGraphVisitor {
   ArenaVector<ReferenceInfo*> ref_info_array_;   // All references used for heap accesses.
   ArenaVector<HeapLocation*> heap_locations_;    // All heap locations.
   ArenaBitVector aliasing_matrix_;    // aliasing info between each pair of locations.
+  ArenaBitVector escape_blocks_;      // blocks where partial singletons may escape.
   bool has_heap_stores_;    // If there is no heap stores, LSE acts as GVN with better
                             // alias analysis and won't be as effective.
   bool has_volatile_;       // If there are volatile field accesses.
@@ -524,8 +567,8 @@ class HeapLocationCollector : public HGraphVisitor {
 
 class LoadStoreAnalysis : public HOptimization {
  public:
-  explicit LoadStoreAnalysis(HGraph* graph)
-    : HOptimization(graph, kLoadStoreAnalysisPassName),
+  explicit LoadStoreAnalysis(HGraph* graph, const char* name = kLoadStoreAnalysisPassName)
+    : HOptimization(graph, name),
       heap_location_collector_(graph) {}
 
   const HeapLocationCollector& GetHeapLocationCollector() const {
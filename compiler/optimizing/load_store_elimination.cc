@@ -436,7 +436,8 @@ class LSEVisitor : public HGraphVisitor {
         // Value is already unknown, no need for aliasing check.
         continue;
       }
-      if (heap_location_collector_.MayAlias(i, idx)) {
+      if (heap_location_collector_.MayAlias(i, idx) &&
+          !AreDistinctReferencesIn(i, idx, instruction->GetBlock())) {
         // Kill heap locations that may alias.
         heap_values[i] = kUnknownHeapValue;
       }
@@ -529,6 +530,9 @@ class LSEVisitor : public HGraphVisitor {
       ReferenceInfo* ref_info = heap_location_collector_.GetHeapLocation(i)->GetReferenceInfo();
       if (ref_info->IsSingleton()) {
         // Singleton references cannot be seen by the callee.
+      } else if (ref_info->IsPartialSingleton() &&
+                 !heap_location_collector_.IsEscapeBlock(invoke->GetBlock())) {
+        // Partial singleton references have not escaped yet, and cannot be seen by the callee.
       } else {
         heap_values[i] = kUnknownHeapValue;
       }
@@ -624,6 +628,18 @@ class LSEVisitor : public HGraphVisitor {
     }
   }
 
+  // Returns true if heap locations `index1` and `index2` are known to belong to different
+  // objects in `block`, because one of them belongs to a partial singleton that has not
+  // escaped yet. The aliasing matrix conservatively treats partial singletons as escaping.
+  bool AreDistinctReferencesIn(size_t index1, size_t index2, HBasicBlock* block) const {
+    ReferenceInfo* ref_info1 = heap_location_collector_.GetHeapLocation(index1)->GetReferenceInfo();
+    ReferenceInfo* ref_info2 = heap_location_collector_.GetHeapLocation(index2)->GetReferenceInfo();
+    if (ref_info1 == ref_info2 || heap_location_collector_.IsEscapeBlock(block)) {
+      return false;
+    }
+    return ref_info1->IsPartialSingleton() || ref_info2->IsPartialSingleton();
+  }
+
   // Find an instruction's substitute if it should be removed.
   // Return the same instruction if it should not be removed.
   HInstruction* FindSubstitute(HInstruction* instruction) {
@@ -31,8 +31,15 @@ namespace art {
 // Enables vectorization (SIMDization) in the loop optimizer.
 static constexpr bool kEnableVectorization = true;
 
-// All current SIMD targets want 16-byte alignment.
-static constexpr size_t kAlignedBase = 16;
+// Enables unrolling of scalar loops in the loop optimizer.
+static constexpr bool kEnableScalarUnrolling = true;
+
+// Upper bounds on the unrolling factor for loops with known and unknown trip counts.
+static constexpr uint32_t kMaxUnrollingFactor = 4;
+static constexpr uint32_t kMaxUnknownTripCountUnrollingFactor = 2;
+
+// Upper bound on the number of runtime tests that guard a vector loop.
+static constexpr size_t kMaxRuntimeTests = 4;
 
 // Remove the instruction from the graph. A bit more elaborate than the usual
 // instruction removal, since there may be a cycle in the use structure.
@@ -285,6 +292,37 @@ static bool HasReductionFormat(HInstruction* reduction, HInstruction* phi) {
   return false;
 }
 
+// Returns the narrower of the types of the given operands (constants are int).
+static Primitive::Type GetNarrowerType(HInstruction* a, HInstruction* b) {
+  Primitive::Type type = a->GetType();
+  if (Primitive::ComponentSize(b->GetType()) < Primitive::ComponentSize(type)) {
+    type = b->GetType();
+  }
+  return type;
+}
+
+// Returns the vector length of the accumulator of an idiom that packs operands of the
+// narrower other_type with the given vector length into components of the wider type.
+static uint32_t GetOtherVL(Primitive::Type type, Primitive::Type other_type, uint32_t vl) {
+  DCHECK(Primitive::IsIntegralType(type) && Primitive::IsIntegralType(other_type));
+  DCHECK_GE(Primitive::ComponentSize(type), Primitive::ComponentSize(other_type));
+  return vl >> (Primitive::ComponentSizeShift(type) - Primitive::ComponentSizeShift(other_type));
+}
+
+// Returns the kind of horizontal combine that completes the given vector reduction.
+static HVecReduce::ReductionKind GetReductionKind(HVecOperation* reduction) {
+  if (reduction->IsVecMin()) {
+    return HVecReduce::kMin;
+  } else if (reduction->IsVecMax()) {
+    return HVecReduce::kMax;
+  }
+  DCHECK(reduction->IsVecAdd() ||
+         reduction->IsVecSub() ||
+         reduction->IsVecSADAccumulate() ||
+         reduction->IsVecDotProd());
+  return HVecReduce::kSum;
+}
+
 // Test vector restrictions.
 static bool HasVectorRestrictions(uint64_t restrictions, uint64_t tested) {
   return (restrictions & tested) != 0;
@@ -330,11 +368,13 @@ HLoopOptimization::HLoopOptimization(HGraph* graph,
       reductions_(nullptr),
       simplified_(false),
       vector_length_(0),
+      vector_wide_(false),
       vector_refs_(nullptr),
       vector_peeling_candidate_(nullptr),
-      vector_runtime_test_a_(nullptr),
-      vector_runtime_test_b_(nullptr),
-      vector_map_(nullptr) {
+      vector_runtime_tests_(nullptr),
+      vector_map_(nullptr),
+      vector_permanent_map_(nullptr),
+      vector_mode_(kSequential) {
 }
 
 void HLoopOptimization::Run() {
@@ -386,20 +426,27 @@ void HLoopOptimization::LocalRun() {
     ArenaSafeMap<HInstruction*, HInstruction*> reds(
         std::less<HInstruction*>(), loop_allocator_->Adapter(kArenaAllocLoopOptimization));
     ArenaSet<ArrayReference> refs(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+    ArenaVector<RuntimeTest> tests(loop_allocator_->Adapter(kArenaAllocLoopOptimization));
     ArenaSafeMap<HInstruction*, HInstruction*> map(
         std::less<HInstruction*>(), loop_allocator_->Adapter(kArenaAllocLoopOptimization));
+    ArenaSafeMap<HInstruction*, HInstruction*> perm(
+        std::less<HInstruction*>(), loop_allocator_->Adapter(kArenaAllocLoopOptimization));
     // Attach.
     iset_ = &iset;
     reductions_ = &reds;
     vector_refs_ = &refs;
+    vector_runtime_tests_ = &tests;
     vector_map_ = &map;
+    vector_permanent_map_ = &perm;
     // Traverse.
     TraverseLoopsInnerToOuter(top_loop_);
     // Detach.
     iset_ = nullptr;
     reductions_ = nullptr;
     vector_refs_ = nullptr;
+    vector_runtime_tests_ = nullptr;
     vector_map_ = nullptr;
+    vector_permanent_map_ = nullptr;
   }
 }
 
@@ -603,11 +650,22 @@ bool HLoopOptimization::OptimizeInnerLoop(LoopNode* node) {
   // Vectorize loop, if possible and valid.
   if (kEnableVectorization &&
       TrySetSimpleLoopHeader(header, &main_phi) &&
-      reductions_->empty() &&  // TODO: possible with some effort
       ShouldVectorize(node, body, trip_count) &&
       TryAssignLastValue(node->loop_info, main_phi, preheader, /*collect_loop_uses*/ true)) {
     Vectorize(node, body, exit, trip_count);
     graph_->SetHasSIMD(true);  // flag SIMD usage
+    if (vector_wide_) {
+      graph_->SetHasWideSIMD(true);
+    }
+    return true;
+  }
+  // Otherwise unroll loop, if possible and profitable.
+  if (kEnableScalarUnrolling &&
+      TrySetSimpleLoopHeader(header, &main_phi) &&
+      reductions_->empty() &&  // TODO: possible with some effort
+      ShouldUnroll(node, body, trip_count) &&
+      TryAssignLastValue(node->loop_info, main_phi, preheader, /*collect_loop_uses*/ true)) {
+    Unroll(node, body, exit, trip_count);
     return true;
   }
   return false;
@@ -620,12 +678,30 @@ bool HLoopOptimization::OptimizeInnerLoop(LoopNode* node) {
 //
 
 bool HLoopOptimization::ShouldVectorize(LoopNode* node, HBasicBlock* block, int64_t trip_count) {
+  // All vector code in a graph shares one vector width, since the width determines the
+  // size of SIMD spill slots. The first vectorized loop decides, preferring 256-bit vectors
+  // where supported and falling back to 128-bit vectors for loops that cannot use them.
+  if (graph_->HasSIMD()) {
+    vector_wide_ = graph_->HasWideSIMD();
+    return ShouldVectorizeAtWidth(node, block, trip_count);
+  }
+  vector_wide_ = SupportsWideVectors();
+  if (vector_wide_ && ShouldVectorizeAtWidth(node, block, trip_count)) {
+    return true;
+  }
+  vector_wide_ = false;
+  return ShouldVectorizeAtWidth(node, block, trip_count);
+}
+
+bool HLoopOptimization::ShouldVectorizeAtWidth(LoopNode* node,
+                                               HBasicBlock* block,
+                                               int64_t trip_count) {
   // Reset vector bookkeeping.
+  vector_mode_ = kVector;
   vector_length_ = 0;
   vector_refs_->clear();
   vector_peeling_candidate_ = nullptr;
-  vector_runtime_test_a_ =
-  vector_runtime_test_b_= nullptr;
+  vector_runtime_tests_->clear();
 
   // Phis in the loop-body prevent vectorization.
   if (!block->GetPhis().IsEmpty()) {
@@ -671,16 +747,8 @@ bool HLoopOptimization::ShouldVectorize(LoopNode* node, HBasicBlock* block, int6
           // Found a[i+x] vs. b[i+y]. Accept if x == y (at worst loop-independent data dependence).
           // Conservatively assume a potential loop-carried data dependence otherwise, avoided by
           // generating an explicit a != b disambiguation runtime test on the two references.
-          if (x != y) {
-            // To avoid excessive overhead, we only accept one a != b test.
-            if (vector_runtime_test_a_ == nullptr) {
-              // First test found.
-              vector_runtime_test_a_ = a;
-              vector_runtime_test_b_ = b;
-            } else if ((vector_runtime_test_a_ != a || vector_runtime_test_b_ != b) &&
-                       (vector_runtime_test_a_ != b || vector_runtime_test_b_ != a)) {
-              return false;  // second test would be needed
-            }
+          if (x != y && !TryAddRuntimeTest(RuntimeTest::kNotEqual, a, b)) {
+            return false;  // too many runtime tests
           }
         }
       }
@@ -725,7 +793,7 @@ void HLoopOptimization::Vectorize(LoopNode* node,
     DCHECK_LT(vector_length_, trip_count) << "dynamic peeling currently requires known trip count";
     //
     // TODO: Implement this. Compute address of first access memory location and
-    //       compute peeling factor to obtain kAlignedBase alignment.
+    //       compute peeling factor to obtain alignment at the vector size (16 or 32 bytes).
     //
     needs_cleanup = true;
   }
@@ -750,12 +818,27 @@ void HLoopOptimization::Vectorize(LoopNode* node,
   }
   vector_index_ = graph_->GetIntConstant(0);
 
-  // Generate runtime disambiguation test:
+  // Generate runtime disambiguation and bounds tests, which version the loop into
+  // the vector loop and a sequential loop that executes all iterations otherwise:
   // vtc = a != b ? vtc : 0;
-  if (vector_runtime_test_a_ != nullptr) {
-    HInstruction* rt = Insert(
-        preheader,
-        new (global_allocator_) HNotEqual(vector_runtime_test_a_, vector_runtime_test_b_));
+  // vtc = 0 <= x && x <= len - stc ? vtc : 0;
+  for (const RuntimeTest& test : *vector_runtime_tests_) {
+    HInstruction* rt = nullptr;
+    if (test.kind == RuntimeTest::kNotEqual) {
+      rt = Insert(preheader, new (global_allocator_) HNotEqual(test.opa, test.opb));
+    } else {
+      int64_t value = 0;
+      if (!IsInt64AndGet(test.opb, &value)) {
+        HInstruction* lo = Insert(
+            preheader,
+            new (global_allocator_) HGreaterThanOrEqual(test.opb, graph_->GetIntConstant(0)));
+        vtc = Insert(preheader,
+                     new (global_allocator_) HSelect(lo, vtc, graph_->GetIntConstant(0), kNoDexPc));
+      }
+      // Since len and stc are both non-negative, the subtraction cannot overflow.
+      HInstruction* hi = Insert(preheader, new (global_allocator_) HSub(induc_type, test.opa, stc));
+      rt = Insert(preheader, new (global_allocator_) HLessThanOrEqual(test.opb, hi));
+    }
     vtc = Insert(preheader,
                  new (global_allocator_) HSelect(rt, vtc, graph_->GetIntConstant(0), kNoDexPc));
     needs_cleanup = true;
@@ -802,6 +885,19 @@ void HLoopOptimization::Vectorize(LoopNode* node,
                     /*unroll*/ 1);
   }
 
+  // Link reductions to their final uses.
+  for (auto i = reductions_->begin(); i != reductions_->end(); ++i) {
+    if (i->first->IsPhi()) {
+      HInstruction* phi = i->first;
+      HInstruction* repl = ReduceAndExtractIfNeeded(i->second);
+      // Deal with regular uses.
+      for (const HUseListNode<HInstruction*>& use : phi->GetUses()) {
+        induction_range_.Replace(use.GetUser(), phi, repl);  // update induction use
+      }
+      phi->ReplaceWith(repl);
+    }
+  }
+
   // Remove the original loop by disconnecting the body block
   // and removing all instructions from the header.
   block->DisconnectAndDelete();
@@ -816,6 +912,116 @@ void HLoopOptimization::Vectorize(LoopNode* node,
   node->loop_info = vloop;
 }
 
+//
+// Scalar loop unrolling. The loop-body is replicated by means of the same synthesis
+// that generates the sequential peeling and cleanup loops during vectorization.
+//
+
+bool HLoopOptimization::ShouldUnroll(LoopNode* node, HBasicBlock* block, int64_t trip_count) {
+  // Reset bookkeeping.
+  vector_mode_ = kSequential;
+  vector_length_ = 0;
+  vector_refs_->clear();
+  vector_peeling_candidate_ = nullptr;
+  vector_runtime_tests_->clear();
+
+  // Phis in the loop-body prevent unrolling.
+  if (!block->GetPhis().IsEmpty()) {
+    return false;
+  }
+
+  // Scan the loop-body. Since the unrolled loop-body executes all operations in the
+  // original order, no data dependence analysis is required. Instructions that could
+  // throw (e.g. remaining bounds checks) are not replicated, however, and prevent
+  // unrolling altogether.
+  for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+    HInstruction* instruction = it.Current();
+    if (instruction->CanThrow() || !VectorizeDef(node, instruction, /*generate_code*/ false)) {
+      return false;
+    }
+  }
+
+  // Does unrolling seem profitable?
+  return GetUnrollingFactor(block, trip_count) > 1;
+}
+
+void HLoopOptimization::Unroll(LoopNode* node,
+                               HBasicBlock* block,
+                               HBasicBlock* exit,
+                               int64_t trip_count) {
+  Primitive::Type induc_type = Primitive::kPrimInt;
+  HBasicBlock* header = node->loop_info->GetHeader();
+  HBasicBlock* preheader = node->loop_info->GetPreHeader();
+
+  // Pick a loop unrolling factor for the scalar loop.
+  uint32_t unroll = GetUnrollingFactor(block, trip_count);
+  DCHECK(IsPowerOfTwo(unroll) && unroll > 1u);
+
+  // A cleanup loop is needed, at least, for any unknown trip count or
+  // for a known trip count with remainder iterations after unrolling.
+  bool needs_cleanup = trip_count == 0 || (trip_count % unroll) != 0;
+
+  // Adjust bookkeeping.
+  HPhi* main_phi = nullptr;
+  bool is_simple_loop_header = TrySetSimpleLoopHeader(header, &main_phi);  // refills sets
+  DCHECK(is_simple_loop_header);
+  vector_header_ = header;
+  vector_body_ = block;
+
+  // Generate loop control:
+  // stc = <trip-count>;
+  // utc = stc - stc % unroll;
+  // i = 0;
+  HInstruction* stc = induction_range_.GenerateTripCount(node->loop_info, graph_, preheader);
+  HInstruction* utc = stc;
+  if (needs_cleanup) {
+    HInstruction* rem = Insert(
+        preheader, new (global_allocator_) HAnd(induc_type,
+                                                stc,
+                                                graph_->GetIntConstant(unroll - 1)));
+    utc = Insert(preheader, new (global_allocator_) HSub(induc_type, stc, rem));
+  }
+  vector_index_ = graph_->GetIntConstant(0);
+
+  // Generate unrolled loop:
+  // for ( ; i < utc; i += unroll)
+  //    <loop-body> ... <loop-body>
+  GenerateNewLoop(node,
+                  block,
+                  graph_->TransformLoopForVectorization(vector_header_, vector_body_, exit),
+                  vector_index_,
+                  utc,
+                  graph_->GetIntConstant(1),  // increment per unroll
+                  unroll);
+  HLoopInformation* uloop = vector_header_->GetLoopInformation();
+
+  // Generate cleanup loop, if needed:
+  // for ( ; i < stc; i += 1)
+  //    <loop-body>
+  if (needs_cleanup) {
+    GenerateNewLoop(node,
+                    block,
+                    graph_->TransformLoopForVectorization(vector_header_, vector_body_, exit),
+                    vector_index_,
+                    stc,
+                    graph_->GetIntConstant(1),
+                    /*unroll*/ 1);
+  }
+
+  // Remove the original loop by disconnecting the body block
+  // and removing all instructions from the header.
+  block->DisconnectAndDelete();
+  while (!header->GetFirstInstruction()->IsGoto()) {
+    header->RemoveInstruction(header->GetFirstInstruction());
+  }
+
+  // Update loop hierarchy: the old header now resides in the same outer loop
+  // as the old preheader. Note that we don't bother putting the cleanup
+  // loop back in the hierarchy at this point.
+  header->SetLoopInformation(preheader->GetLoopInformation());  // outward
+  node->loop_info = uloop;
+}
+
 void HLoopOptimization::GenerateNewLoop(LoopNode* node,
                                         HBasicBlock* block,
                                         HBasicBlock* new_preheader,
@@ -823,7 +1029,6 @@ void HLoopOptimization::GenerateNewLoop(LoopNode* node,
                                         HInstruction* hi,
                                         HInstruction* step,
                                         uint32_t unroll) {
-  DCHECK(unroll == 1 || vector_mode_ == kVector);
   Primitive::Type induc_type = Primitive::kPrimInt;
   // Prepare new loop.
   vector_preheader_ = new_preheader,
@@ -841,13 +1046,14 @@ void HLoopOptimization::GenerateNewLoop(LoopNode* node,
   vector_header_->AddInstruction(cond);
   vector_header_->AddInstruction(new (global_allocator_) HIf(cond));
   vector_index_ = phi;
+  vector_permanent_map_->clear();  // preserved over unrolling
   for (uint32_t u = 0; u < unroll; u++) {
     // Clear map, leaving loop invariants setup during unrolling.
     if (u == 0) {
       vector_map_->clear();
     } else {
       for (auto i = vector_map_->begin(); i != vector_map_->end(); ) {
-        if (i->second->IsVecReplicateScalar()) {
+        if (i->second->IsVecReplicateScalar() || i->second == i->first) {
           DCHECK(node->loop_info->IsDefinedOutOfTheLoop(i->first));
           ++i;
         } else {
@@ -865,6 +1071,11 @@ void HLoopOptimization::GenerateNewLoop(LoopNode* node,
     for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
       auto i = vector_map_->find(it.Current());
       if (i != vector_map_->end() && !i->second->IsInBlock()) {
+        // A retained bounds check throws at the same point as the original check.
+        if (i->second->IsBoundsCheck()) {
+          GenerateVecEnvironment(node, it.Current(), i->second);
+          continue;
+        }
         Insert(vector_body_, i->second);
         // Deal with instructions that need an environment, such as the scalar intrinsics.
         if (i->second->NeedsEnvironment()) {
@@ -875,6 +1086,13 @@ void HLoopOptimization::GenerateNewLoop(LoopNode* node,
     vector_index_ = new (global_allocator_) HAdd(induc_type, vector_index_, step);
     Insert(vector_body_, vector_index_);
   }
+  // Finalize phi inputs for the reductions (if any).
+  for (auto i = reductions_->begin(); i != reductions_->end(); ++i) {
+    if (!i->first->IsPhi()) {
+      DCHECK(i->second->IsPhi());
+      GenerateVecReductionPhiInputs(i->second->AsPhi(), i->first);
+    }
+  }
   // Finalize phi inputs for the loop index.
   phi->AddInput(lo);
   phi->AddInput(vector_index_);
@@ -910,6 +1128,48 @@ bool HLoopOptimization::VectorizeDef(LoopNode* node,
     }
     return false;
   }
+  // Accept a left-hand-side reduction for
+  // (1) supported vector type,
+  // (2) vectorizable right-hand-side value.
+  auto redit = reductions_->find(instruction);
+  if (redit != reductions_->end()) {
+    Primitive::Type type = instruction->GetType();
+    // Recognize SAD or dot product idiom, or a direct reduction.
+    if (VectorizeSADIdiom(node, instruction, generate_code, type, restrictions) ||
+        VectorizeDotProdIdiom(node, instruction, generate_code, type, restrictions) ||
+        (TrySetVectorType(type, &restrictions) &&
+         VectorizeUse(node, instruction, generate_code, type, restrictions))) {
+      if (generate_code) {
+        HInstruction* new_red = vector_map_->Get(instruction);
+        vector_permanent_map_->Put(new_red, vector_map_->Get(redit->second));
+        vector_permanent_map_->Overwrite(redit->second, new_red);
+      }
+      return true;
+    }
+    return false;
+  }
+  // Accept a bounds check on a unit stride subscript i + offset against a loop-invariant
+  // length, provided that a runtime test can verify the full subscript range in front of
+  // the vector loop. The check is dropped from the vector loop, but retained in the
+  // sequential loops, which execute all iterations if the runtime test fails.
+  if (instruction->IsBoundsCheck()) {
+    HInstruction* index = instruction->InputAt(0);
+    HInstruction* length = instruction->InputAt(1);
+    HInstruction* offset = nullptr;
+    if (node->loop_info->IsDefinedOutOfTheLoop(length) &&
+        induction_range_.IsUnitStride(instruction, index, graph_, &offset)) {
+      int64_t value = 0;
+      if (IsInt64AndGet(offset, &value) && value < 0) {
+        return false;  // certain failure
+      }
+      if (generate_code) {
+        GenerateVecBoundsCheck(instruction, offset);
+        return true;
+      }
+      return TryAddRuntimeTest(RuntimeTest::kInBounds, length, offset);
+    }
+    return false;
+  }
   // Branch back okay.
   if (instruction->IsGoto()) {
     return true;
@@ -1141,11 +1401,34 @@ bool HLoopOptimization::VectorizeUse(LoopNode* node,
       default:
         return false;
     }  // switch
+  } else if (instruction->IsPhi()) {
+    // Accept particular phi operations.
+    if (reductions_->find(instruction) != reductions_->end()) {
+      // Deal with vector restrictions.
+      if (HasVectorRestrictions(restrictions, kNoReduction)) {
+        return false;
+      }
+      // Accept a reduction.
+      if (generate_code) {
+        GenerateVecReductionPhi(instruction->AsPhi());
+      }
+      return true;
+    }
+    // TODO: accept right-hand-side induction?
+    return false;
   }
   return false;
 }
 
 bool HLoopOptimization::TrySetVectorType(Primitive::Type type, uint64_t* restrictions) {
+  // Scalar code supports all primitive types, but integral division is rejected,
+  // since its divide-by-zero check would not be replicated.
+  if (vector_mode_ == kSequential) {
+    if (Primitive::IsIntegralType(type)) {
+      *restrictions |= kNoDiv;
+    }
+    return type != Primitive::kPrimNot && type != Primitive::kPrimVoid;
+  }
   const InstructionSetFeatures* features = compiler_driver_->GetInstructionSetFeatures();
   switch (compiler_driver_->GetInstructionSet()) {
     case kArm:
@@ -1155,14 +1438,14 @@ bool HLoopOptimization::TrySetVectorType(Primitive::Type type, uint64_t* restric
       switch (type) {
         case Primitive::kPrimBoolean:
         case Primitive::kPrimByte:
-          *restrictions |= kNoDiv;
+          *restrictions |= kNoDiv | kNoReduction;
           return TrySetVectorLength(8);
         case Primitive::kPrimChar:
         case Primitive::kPrimShort:
-          *restrictions |= kNoDiv | kNoStringCharAt;
+          *restrictions |= kNoDiv | kNoReduction | kNoStringCharAt;
           return TrySetVectorLength(4);
         case Primitive::kPrimInt:
-          *restrictions |= kNoDiv;
+          *restrictions |= kNoDiv | kNoReduction;
           return TrySetVectorLength(2);
         default:
           break;
@@ -1187,37 +1470,47 @@ bool HLoopOptimization::TrySetVectorType(Primitive::Type type, uint64_t* restric
           *restrictions |= kNoDiv | kNoMul | kNoMinMax;
           return TrySetVectorLength(2);
         case Primitive::kPrimFloat:
+          *restrictions |= kNoReduction;  // keep FP order
           return TrySetVectorLength(4);
         case Primitive::kPrimDouble:
+          *restrictions |= kNoReduction;  // keep FP order
           return TrySetVectorLength(2);
         default:
           return false;
       }
     case kX86:
     case kX86_64:
-      // Allow vectorization for SSE4.1-enabled X86 devices only (128-bit SIMD).
+      // Allow vectorization for SSE4.1-enabled X86 devices only (128-bit SIMD),
+      // with twice the lanes when AVX2 vectors were selected (256-bit SIMD).
       if (features->AsX86InstructionSetFeatures()->HasSSE4_1()) {
+        uint32_t scale = vector_wide_ ? 2u : 1u;
+        if (compiler_driver_->GetInstructionSet() == kX86) {
+          *restrictions |= kNoReduction;  // no 32-bit horizontal combines
+        }
         switch (type) {
           case Primitive::kPrimBoolean:
           case Primitive::kPrimByte:
             *restrictions |= kNoMul | kNoDiv | kNoShift | kNoAbs | kNoSignedHAdd | kNoUnroundedHAdd;
-            return TrySetVectorLength(16);
+            return TrySetVectorLength(16 * scale);
           case Primitive::kPrimChar:
           case Primitive::kPrimShort:
             *restrictions |= kNoDiv | kNoAbs | kNoSignedHAdd | kNoUnroundedHAdd;
-            return TrySetVectorLength(8);
+            if (vector_wide_) {
+              *restrictions |= kNoStringCharAt;  // no 256-bit compressed string load
+            }
+            return TrySetVectorLength(8 * scale);
           case Primitive::kPrimInt:
             *restrictions |= kNoDiv;
-            return TrySetVectorLength(4);
+            return TrySetVectorLength(4 * scale);
           case Primitive::kPrimLong:
             *restrictions |= kNoMul | kNoDiv | kNoShr | kNoAbs | kNoMinMax;
-            return TrySetVectorLength(2);
+            return TrySetVectorLength(2 * scale);
           case Primitive::kPrimFloat:
-            *restrictions |= kNoMinMax;  // -0.0 vs +0.0
-            return TrySetVectorLength(4);
+            *restrictions |= kNoMinMax | kNoReduction;  // -0.0 vs +0.0, keep FP order
+            return TrySetVectorLength(4 * scale);
           case Primitive::kPrimDouble:
-            *restrictions |= kNoMinMax;  // -0.0 vs +0.0
-            return TrySetVectorLength(2);
+            *restrictions |= kNoMinMax | kNoReduction;  // -0.0 vs +0.0, keep FP order
+            return TrySetVectorLength(2 * scale);
           default:
             break;
         }  // switch type
@@ -1228,23 +1521,23 @@ bool HLoopOptimization::TrySetVectorType(Primitive::Type type, uint64_t* restric
         switch (type) {
           case Primitive::kPrimBoolean:
           case Primitive::kPrimByte:
-            *restrictions |= kNoDiv;
+            *restrictions |= kNoDiv | kNoReduction;
             return TrySetVectorLength(16);
           case Primitive::kPrimChar:
           case Primitive::kPrimShort:
-            *restrictions |= kNoDiv | kNoStringCharAt;
+            *restrictions |= kNoDiv | kNoReduction | kNoStringCharAt;
             return TrySetVectorLength(8);
           case Primitive::kPrimInt:
-            *restrictions |= kNoDiv;
+            *restrictions |= kNoDiv | kNoReduction;
             return TrySetVectorLength(4);
           case Primitive::kPrimLong:
-            *restrictions |= kNoDiv;
+            *restrictions |= kNoDiv | kNoReduction;
             return TrySetVectorLength(2);
           case Primitive::kPrimFloat:
-            *restrictions |= kNoMinMax;  // min/max(x, NaN)
+            *restrictions |= kNoMinMax | kNoReduction;  // min/max(x, NaN)
             return TrySetVectorLength(4);
           case Primitive::kPrimDouble:
-            *restrictions |= kNoMinMax;  // min/max(x, NaN)
+            *restrictions |= kNoMinMax | kNoReduction;  // min/max(x, NaN)
             return TrySetVectorLength(2);
           default:
             break;
@@ -1256,23 +1549,23 @@ bool HLoopOptimization::TrySetVectorType(Primitive::Type type, uint64_t* restric
         switch (type) {
           case Primitive::kPrimBoolean:
           case Primitive::kPrimByte:
-            *restrictions |= kNoDiv;
+            *restrictions |= kNoDiv | kNoReduction;
             return TrySetVectorLength(16);
           case Primitive::kPrimChar:
           case Primitive::kPrimShort:
-            *restrictions |= kNoDiv | kNoStringCharAt;
+            *restrictions |= kNoDiv | kNoReduction | kNoStringCharAt;
             return TrySetVectorLength(8);
           case Primitive::kPrimInt:
-            *restrictions |= kNoDiv;
+            *restrictions |= kNoDiv | kNoReduction;
             return TrySetVectorLength(4);
           case Primitive::kPrimLong:
-            *restrictions |= kNoDiv;
+            *restrictions |= kNoDiv | kNoReduction;
             return TrySetVectorLength(2);
           case Primitive::kPrimFloat:
-            *restrictions |= kNoMinMax;  // min/max(x, NaN)
+            *restrictions |= kNoMinMax | kNoReduction;  // min/max(x, NaN)
             return TrySetVectorLength(4);
           case Primitive::kPrimDouble:
-            *restrictions |= kNoMinMax;  // min/max(x, NaN)
+            *restrictions |= kNoMinMax | kNoReduction;  // min/max(x, NaN)
             return TrySetVectorLength(2);
           default:
             break;
@@ -1296,6 +1589,12 @@ bool HLoopOptimization::TrySetVectorLength(uint32_t length) {
   return vector_length_ == length;
 }
 
+bool HLoopOptimization::SupportsWideVectors() const {
+  // Only x86-64 code generation supports 256-bit vectors, when AVX2 is available.
+  return compiler_driver_->GetInstructionSet() == kX86_64 &&
+      compiler_driver_->GetInstructionSetFeatures()->AsX86_64InstructionSetFeatures()->HasAVX2();
+}
+
 void HLoopOptimization::GenerateVecInv(HInstruction* org, Primitive::Type type) {
   if (vector_map_->find(org) == vector_map_->end()) {
     // In scalar code, just use a self pass-through for scalar invariants
@@ -1325,6 +1624,65 @@ void HLoopOptimization::GenerateVecSub(HInstruction* org, HInstruction* offset)
   }
 }
 
+void HLoopOptimization::GenerateVecBoundsCheck(HInstruction* org, HInstruction* offset) {
+  DCHECK(org->IsBoundsCheck());
+  if (vector_mode_ == kVector) {
+    // Vector code relies on the runtime test, and just uses the subscript.
+    GenerateVecSub(org, offset);
+    return;
+  }
+  // Scalar code retains the bounds check on the subscript.
+  HInstruction* index = org->InputAt(0);
+  GenerateVecSub(index, offset);
+  HBoundsCheck* check = new (global_allocator_) HBoundsCheck(
+      vector_map_->Get(index),
+      org->InputAt(1),
+      org->GetDexPc(),
+      org->AsBoundsCheck()->IsStringCharAt());
+  vector_map_->Put(org, check);
+}
+
+void HLoopOptimization::GenerateVecEnvironment(LoopNode* node,
+                                               HInstruction* org,
+                                               HInstruction* check) {
+  DCHECK(vector_mode_ == kSequential);
+  DCHECK(org->IsBoundsCheck() && check->IsBoundsCheck());
+  // Map the loop induction first, since that may generate code in front of the check.
+  HLoopInformation* loop_info = node->loop_info;
+  for (HEnvironment* env = org->GetEnvironment(); env != nullptr; env = env->GetParent()) {
+    for (size_t i = 0, size = env->Size(); i < size; ++i) {
+      HInstruction* value = env->GetInstructionAt(i);
+      HInstruction* offset = nullptr;
+      if (value != nullptr &&
+          value->IsLoopHeaderPhi() &&
+          value->GetBlock() == loop_info->GetHeader() &&
+          vector_map_->find(value) == vector_map_->end() &&
+          induction_range_.IsUnitStride(org, value, graph_, &offset)) {
+        GenerateVecSub(value, offset);
+      }
+    }
+  }
+  Insert(vector_body_, check);
+  // Copy the environment of the original check, with the values of the original loop
+  // replaced by their counterparts in the new loop. Values that the new loop does not
+  // compute have no other uses than environments, and become undefined, like dead locals.
+  check->CopyEnvironmentFrom(org->GetEnvironment());
+  for (HEnvironment* env = check->GetEnvironment(); env != nullptr; env = env->GetParent()) {
+    for (size_t i = 0, size = env->Size(); i < size; ++i) {
+      HInstruction* value = env->GetInstructionAt(i);
+      if (value != nullptr && loop_info->Contains(*value->GetBlock())) {
+        auto it = vector_map_->find(value);
+        HInstruction* replacement = it != vector_map_->end() ? it->second : nullptr;
+        env->RemoveAsUserOfInput(i);
+        env->SetRawEnvAt(i, replacement);
+        if (replacement != nullptr) {
+          replacement->AddEnvUseAt(env, i);
+        }
+      }
+    }
+  }
+}
+
 void HLoopOptimization::GenerateVecMem(HInstruction* org,
                                        HInstruction* opa,
                                        HInstruction* opb,
@@ -1346,7 +1704,8 @@ void HLoopOptimization::GenerateVecMem(HInstruction* org,
     if (vector_peeling_candidate_ != nullptr &&
         vector_peeling_candidate_->base == base &&
         vector_peeling_candidate_->offset == offset) {
-      vector->AsVecMemoryOperation()->SetAlignment(Alignment(kAlignedBase, 0));
+      size_t vector_size = vector_length_ * Primitive::ComponentSize(type);
+      vector->AsVecMemoryOperation()->SetAlignment(Alignment(vector_size, 0));
     }
   } else {
     // Scalar store or load.
@@ -1522,6 +1881,89 @@ void HLoopOptimization::GenerateVecOp(HInstruction* org,
 
 #undef GENERATE_VEC
 
+void HLoopOptimization::GenerateVecReductionPhi(HPhi* phi) {
+  DCHECK(reductions_->find(phi) != reductions_->end());
+  DCHECK(reductions_->Get(phi->InputAt(1)) == phi);
+  HInstruction* vector = nullptr;
+  // Link the reduction back to the update of the prior unrolled copy, or generate
+  // a first phi (which carries a SIMD value in vector code).
+  auto it = vector_permanent_map_->find(phi);
+  if (it != vector_permanent_map_->end()) {
+    vector = it->second;
+  } else {
+    HPhi* new_phi = new (global_allocator_) HPhi(
+        global_allocator_,
+        kNoRegNumber,
+        0,
+        vector_mode_ == kSequential ? phi->GetType() : Primitive::kPrimDouble);
+    vector_header_->AddPhi(new_phi);
+    vector = new_phi;
+  }
+  vector_map_->Put(phi, vector);
+}
+
+void HLoopOptimization::GenerateVecReductionPhiInputs(HPhi* phi, HInstruction* reduction) {
+  HInstruction* new_phi = vector_map_->Get(phi);
+  HInstruction* new_init = reductions_->Get(phi);
+  HInstruction* new_red = vector_map_->Get(reduction);
+  // Link unrolled loop-body back to new phi.
+  for (; !new_phi->IsPhi(); new_phi = vector_permanent_map_->Get(new_phi)) {
+    DCHECK(new_phi->IsVecOperation() || vector_mode_ == kSequential);
+  }
+  // Prepare the new initialization.
+  if (vector_mode_ == kVector) {
+    // Generate a [initial, 0, .., 0] vector for add or
+    // a [initial, initial, .., initial] vector for min/max.
+    HVecOperation* red_vector = new_red->AsVecOperation();
+    HVecReduce::ReductionKind kind = GetReductionKind(red_vector);
+    size_t vector_length = red_vector->GetVectorLength();
+    Primitive::Type type = red_vector->GetPackedType();
+    if (kind == HVecReduce::kSum) {
+      new_init = Insert(vector_preheader_,
+                        new (global_allocator_) HVecSetScalars(global_allocator_,
+                                                               &new_init,
+                                                               type,
+                                                               vector_length,
+                                                               1));
+    } else {
+      new_init = Insert(vector_preheader_,
+                        new (global_allocator_) HVecReplicateScalar(global_allocator_,
+                                                                    new_init,
+                                                                    type,
+                                                                    vector_length));
+    }
+  } else {
+    new_init = ReduceAndExtractIfNeeded(new_init);
+  }
+  // Set the phi inputs.
+  DCHECK(new_phi->IsPhi());
+  new_phi->AsPhi()->AddInput(new_init);
+  new_phi->AsPhi()->AddInput(new_red);
+  // New feed value for next phi (safe mutation in iteration).
+  reductions_->find(phi)->second = new_phi;
+}
+
+HInstruction* HLoopOptimization::ReduceAndExtractIfNeeded(HInstruction* instruction) {
+  if (instruction->IsPhi()) {
+    HInstruction* input = instruction->InputAt(1);
+    if (HVecOperation::ReturnsSIMDValue(input)) {
+      DCHECK(!input->IsPhi());
+      HVecOperation* input_vector = input->AsVecOperation();
+      // Generate a horizontal combine of all components into a scalar
+      //    x = REDUCE( [x_1, .., x_n] )
+      // along the exit of the defining loop.
+      HBasicBlock* exit = instruction->GetBlock()->GetSuccessors()[0];
+      instruction = new (global_allocator_) HVecReduce(global_allocator_,
+                                                       instruction,
+                                                       input_vector->GetPackedType(),
+                                                       input_vector->GetVectorLength(),
+                                                       GetReductionKind(input_vector));
+      exit->InsertInstructionBefore(instruction, exit->GetFirstInstruction());
+    }
+  }
+  return instruction;
+}
+
 //
 // Vectorization idioms.
 //
@@ -1601,6 +2043,145 @@ bool HLoopOptimization::VectorizeHalvingAddIdiom(LoopNode* node,
   return false;
 }
 
+// Method recognizes the following idiom:
+//   q += ABS(a - b) for signed operands a, b of a narrower type
+// Provided that the operands are promoted to int to do the arithmetic, the idiom maps into
+// a SIMD sum of absolute differences that operates directly on the narrower operands and
+// accumulates into the int components, without any risk of intermediate overflow.
+// TODO: consider unsigned operands and long accumulation.
+bool HLoopOptimization::VectorizeSADIdiom(LoopNode* node,
+                                          HInstruction* instruction,
+                                          bool generate_code,
+                                          Primitive::Type reduction_type,
+                                          uint64_t restrictions) {
+  // Filter integral "q += ABS(a - b);" reduction, where ABS and SUB are done in int.
+  if (!instruction->IsAdd() || reduction_type != Primitive::kPrimInt) {
+    return false;
+  }
+  HInstruction* q = instruction->InputAt(0);
+  HInstruction* v = instruction->InputAt(1);
+  if (v == reductions_->Get(instruction)) {
+    std::swap(q, v);
+  }
+  if (!v->IsInvokeStaticOrDirect() ||
+      v->AsInvokeStaticOrDirect()->GetIntrinsic() != Intrinsics::kMathAbsInt ||
+      !v->InputAt(0)->IsSub()) {
+    return false;
+  }
+  HInstruction* a = v->InputAt(0)->InputAt(0);
+  HInstruction* b = v->InputAt(0)->InputAt(1);
+  // Accept consistent sign extension for narrower-type on operands a and b.
+  HInstruction* r = nullptr;
+  HInstruction* s = nullptr;
+  bool is_unsigned = false;
+  Primitive::Type sub_type = GetNarrowerType(a, b);
+  if (sub_type == reduction_type ||
+      !IsNarrowerOperands(a, b, sub_type, &r, &s, &is_unsigned) ||
+      is_unsigned) {
+    return false;
+  }
+  // Try narrower type and deal with vector restrictions.
+  if (!TrySetVectorType(sub_type, &restrictions) ||
+      HasVectorRestrictions(restrictions, kNoSAD)) {
+    return false;
+  }
+  // Accept SAD idiom for vectorizable operands. Vectorized code uses the shorthand
+  // idiomatic operation. Sequential code uses the original scalar expressions.
+  DCHECK(r != nullptr && s != nullptr);
+  if (generate_code && vector_mode_ != kVector) {  // de-idiom
+    r = s = v->InputAt(0);
+  }
+  if (VectorizeUse(node, q, generate_code, sub_type, restrictions) &&
+      VectorizeUse(node, r, generate_code, sub_type, restrictions) &&
+      VectorizeUse(node, s, generate_code, sub_type, restrictions)) {
+    if (generate_code) {
+      if (vector_mode_ == kVector) {
+        vector_map_->Put(instruction, new (global_allocator_) HVecSADAccumulate(
+            global_allocator_,
+            vector_map_->Get(q),
+            vector_map_->Get(r),
+            vector_map_->Get(s),
+            reduction_type,
+            GetOtherVL(reduction_type, sub_type, vector_length_)));
+      } else {
+        GenerateVecOp(v, vector_map_->Get(r), nullptr, reduction_type);
+        GenerateVecOp(instruction, vector_map_->Get(q), vector_map_->Get(v), reduction_type);
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+// Method recognizes the following idiom:
+//   q += a * b for signed operands a, b of a narrower type
+// Provided that the operands are promoted to int to do the arithmetic, the idiom maps into
+// a SIMD dot product that multiplies the narrower operands into wider products and adds
+// these pairwise into the int components, which wraps around just like the scalar code.
+// TODO: consider unsigned operands.
+bool HLoopOptimization::VectorizeDotProdIdiom(LoopNode* node,
+                                              HInstruction* instruction,
+                                              bool generate_code,
+                                              Primitive::Type reduction_type,
+                                              uint64_t restrictions) {
+  // Filter integral "q += a * b;" reduction, where MUL is done in int.
+  if (!instruction->IsAdd() || reduction_type != Primitive::kPrimInt) {
+    return false;
+  }
+  HInstruction* q = instruction->InputAt(0);
+  HInstruction* v = instruction->InputAt(1);
+  if (v == reductions_->Get(instruction)) {
+    std::swap(q, v);
+  }
+  if (!v->IsMul() || v->GetType() != reduction_type) {
+    return false;
+  }
+  HInstruction* a = v->InputAt(0);
+  HInstruction* b = v->InputAt(1);
+  // Accept consistent sign extension for narrower-type on operands a and b.
+  HInstruction* r = nullptr;
+  HInstruction* s = nullptr;
+  bool is_unsigned = false;
+  Primitive::Type mul_type = GetNarrowerType(a, b);
+  if (mul_type == reduction_type ||
+      !IsNarrowerOperands(a, b, mul_type, &r, &s, &is_unsigned) ||
+      is_unsigned) {
+    return false;
+  }
+  // Try narrower type and deal with vector restrictions.
+  if (!TrySetVectorType(mul_type, &restrictions) ||
+      HasVectorRestrictions(restrictions, kNoDotProd)) {
+    return false;
+  }
+  // Accept dot product idiom for vectorizable operands. Vectorized code uses the shorthand
+  // idiomatic operation. Sequential code uses the original scalar expressions.
+  DCHECK(r != nullptr && s != nullptr);
+  if (generate_code && vector_mode_ != kVector) {  // de-idiom
+    r = a;
+    s = b;
+  }
+  if (VectorizeUse(node, q, generate_code, mul_type, restrictions) &&
+      VectorizeUse(node, r, generate_code, mul_type, restrictions) &&
+      VectorizeUse(node, s, generate_code, mul_type, restrictions)) {
+    if (generate_code) {
+      if (vector_mode_ == kVector) {
+        vector_map_->Put(instruction, new (global_allocator_) HVecDotProd(
+            global_allocator_,
+            vector_map_->Get(q),
+            vector_map_->Get(r),
+            vector_map_->Get(s),
+            reduction_type,
+            GetOtherVL(reduction_type, mul_type, vector_length_)));
+      } else {
+        GenerateVecOp(v, vector_map_->Get(r), vector_map_->Get(s), reduction_type);
+        GenerateVecOp(instruction, vector_map_->Get(q), vector_map_->Get(v), reduction_type);
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
 //
 // Vectorization heuristics.
 //
@@ -1624,24 +2205,65 @@ void HLoopOptimization::SetPeelingCandidate(const ArrayReference* candidate,
   vector_peeling_candidate_ = candidate;
 }
 
+bool HLoopOptimization::TryAddRuntimeTest(RuntimeTest::Kind kind,
+                                          HInstruction* a,
+                                          HInstruction* b) {
+  for (const RuntimeTest& test : *vector_runtime_tests_) {
+    if (test.Matches(kind, a, b)) {
+      return true;  // already present
+    }
+  }
+  // To avoid excessive overhead in front of the vector loop, only accept a few tests.
+  if (vector_runtime_tests_->size() >= kMaxRuntimeTests) {
+    return false;
+  }
+  vector_runtime_tests_->push_back(RuntimeTest(kind, a, b));
+  return true;
+}
+
 uint32_t HLoopOptimization::GetUnrollingFactor(HBasicBlock* block, int64_t trip_count) {
-  // Current heuristic: unroll by 2 on ARM64/X86 for large known trip
-  // counts and small loop bodies.
+  // Current heuristic: unroll scalar loops on all targets, but vector loops only on
+  // ARM64/X86, which have sufficient SIMD registers, and only for known trip counts.
   // TODO: refine with operation count, remaining iterations, etc.
   //       Artem had some really cool ideas for this already.
-  switch (compiler_driver_->GetInstructionSet()) {
-    case kArm64:
-    case kX86:
-    case kX86_64: {
-      size_t num_instructions = block->GetInstructions().CountSize();
-      if (num_instructions <= 10 && trip_count >= 4 * vector_length_) {
-        return 2;
-      }
-      return 1;
+  uint32_t chunk = 1;
+  if (vector_mode_ == kVector) {
+    switch (compiler_driver_->GetInstructionSet()) {
+      case kArm64:
+      case kX86:
+      case kX86_64:
+        break;
+      default:
+        return 1;
     }
-    default:
+    if (trip_count == 0) {
       return 1;
+    }
+    chunk = vector_length_;
   }
+  size_t max_instructions = compiler_driver_->GetCompilerOptions().GetLoopUnrollMaxInstructions();
+  return ComputeUnrollingFactor(block->GetInstructions().CountSize(),
+                                trip_count,
+                                chunk,
+                                max_instructions);
+}
+
+uint32_t HLoopOptimization::ComputeUnrollingFactor(size_t num_instructions,
+                                                   int64_t trip_count,
+                                                   uint32_t chunk,
+                                                   size_t max_instructions) {
+  // Double the unrolling factor as long as the unrolled loop-body stays within the code
+  // size budget and a known trip count still leaves at least two unrolled iterations.
+  // An unknown trip count may well be too small to amortize the remainder iterations
+  // in the cleanup loop, so such loops are unrolled less aggressively.
+  uint32_t max_unroll = trip_count == 0 ? kMaxUnknownTripCountUnrollingFactor : kMaxUnrollingFactor;
+  uint32_t unroll = 1;
+  while (unroll < max_unroll &&
+         2 * unroll * num_instructions <= max_instructions &&
+         (trip_count == 0 || trip_count >= 4 * unroll * chunk)) {
+    unroll *= 2;
+  }
+  return unroll;
 }
 
 //
@@ -73,6 +73,9 @@ class HLoopOptimization : public HOptimization {
     kNoAbs           = 128,  // no absolute value
     kNoMinMax        = 256,  // no min/max
     kNoStringCharAt  = 512,  // no StringCharAt
+    kNoReduction     = 1024, // no reduction
+    kNoSAD           = 2048, // no sum of absolute differences (SAD)
+    kNoDotProd       = 4096, // no dot product
   };
 
   /*
@@ -104,6 +107,25 @@ class HLoopOptimization : public HOptimization {
     bool lhs;              // def/use
   };
 
+  /*
+   * Representation of a runtime test that guards the vector loop (loop versioning).
+   * If any test fails, the sequential cleanup loop executes all iterations instead.
+   */
+  struct RuntimeTest {
+    enum Kind {
+      kNotEqual,  // a != b on two array references (disambiguation)
+      kInBounds   // 0 <= b && b + trip-count <= a on a length and unit stride offset
+    };
+    RuntimeTest(Kind k, HInstruction* a, HInstruction* b) : kind(k), opa(a), opb(b) { }
+    bool Matches(Kind k, HInstruction* a, HInstruction* b) const {
+      return kind == k &&
+          ((opa == a && opb == b) || (k == kNotEqual && opa == b && opb == a));
+    }
+    Kind kind;
+    HInstruction* opa;  // array base or length
+    HInstruction* opb;  // array base or offset
+  };
+
   //
   // Loop setup and traversal.
   //
@@ -132,7 +154,10 @@ class HLoopOptimization : public HOptimization {
   //
 
   bool ShouldVectorize(LoopNode* node, HBasicBlock* block, int64_t trip_count);
+  bool ShouldVectorizeAtWidth(LoopNode* node, HBasicBlock* block, int64_t trip_count);
   void Vectorize(LoopNode* node, HBasicBlock* block, HBasicBlock* exit, int64_t trip_count);
+  bool ShouldUnroll(LoopNode* node, HBasicBlock* block, int64_t trip_count);
+  void Unroll(LoopNode* node, HBasicBlock* block, HBasicBlock* exit, int64_t trip_count);
   void GenerateNewLoop(LoopNode* node,
                        HBasicBlock* block,
                        HBasicBlock* new_preheader,
@@ -148,8 +173,11 @@ class HLoopOptimization : public HOptimization {
                     uint64_t restrictions);
   bool TrySetVectorType(Primitive::Type type, /*out*/ uint64_t* restrictions);
   bool TrySetVectorLength(uint32_t length);
+  bool SupportsWideVectors() const;
   void GenerateVecInv(HInstruction* org, Primitive::Type type);
   void GenerateVecSub(HInstruction* org, HInstruction* offset);
+  void GenerateVecBoundsCheck(HInstruction* org, HInstruction* offset);
+  void GenerateVecEnvironment(LoopNode* node, HInstruction* org, HInstruction* check);
   void GenerateVecMem(HInstruction* org,
                       HInstruction* opa,
                       HInstruction* opb,
@@ -160,6 +188,9 @@ class HLoopOptimization : public HOptimization {
                      HInstruction* opb,
                      Primitive::Type type,
                      bool is_unsigned = false);
+  void GenerateVecReductionPhi(HPhi* phi);
+  void GenerateVecReductionPhiInputs(HPhi* phi, HInstruction* reduction);
+  HInstruction* ReduceAndExtractIfNeeded(HInstruction* instruction);
 
   // Vectorization idioms.
   bool VectorizeHalvingAddIdiom(LoopNode* node,
@@ -167,11 +198,30 @@ class HLoopOptimization : public HOptimization {
                                 bool generate_code,
                                 Primitive::Type type,
                                 uint64_t restrictions);
+  bool VectorizeSADIdiom(LoopNode* node,
+                         HInstruction* instruction,
+                         bool generate_code,
+                         Primitive::Type reduction_type,
+                         uint64_t restrictions);
+  bool VectorizeDotProdIdiom(LoopNode* node,
+                             HInstruction* instruction,
+                             bool generate_code,
+                             Primitive::Type reduction_type,
+                             uint64_t restrictions);
 
   // Vectorization heuristics.
   bool IsVectorizationProfitable(int64_t trip_count);
   void SetPeelingCandidate(const ArrayReference* candidate, int64_t trip_count);
+  bool TryAddRuntimeTest(RuntimeTest::Kind kind, HInstruction* a, HInstruction* b);
+
+  // Unrolling heuristics, shared by scalar and vector loops. Returns the largest power-of-two
+  // unrolling factor that keeps the unrolled loop-body of num_instructions within the budget
+  // of max_instructions, for a loop that processes chunk iterations per loop-body.
   uint32_t GetUnrollingFactor(HBasicBlock* block, int64_t trip_count);
+  static uint32_t ComputeUnrollingFactor(size_t num_instructions,
+                                         int64_t trip_count,
+                                         uint32_t chunk,
+                                         size_t max_instructions);
 
   //
   // Helpers.
@@ -236,6 +286,9 @@ class HLoopOptimization : public HOptimization {
   // Number of "lanes" for selected packed type.
   uint32_t vector_length_;
 
+  // Flag that selects 256-bit rather than 128-bit vectors (x86-64 AVX2).
+  bool vector_wide_;
+
   // Set of array references in the vector loop.
   // Contents reside in phase-local heap memory.
   ArenaSet<ArrayReference>* vector_refs_;
@@ -243,16 +296,22 @@ class HLoopOptimization : public HOptimization {
   // Dynamic loop peeling candidate for alignment.
   const ArrayReference* vector_peeling_candidate_;
 
-  // Dynamic data dependence test of the form a != b.
-  HInstruction* vector_runtime_test_a_;
-  HInstruction* vector_runtime_test_b_;
+  // Dynamic data dependence and bounds tests that guard the vector loop.
+  // Contents reside in phase-local heap memory.
+  ArenaVector<RuntimeTest>* vector_runtime_tests_;
 
-  // Mapping used during vectorization synthesis for both the scalar peeling/cleanup
+  // Mapping used during vectorization synthesis for both the scalar peeling/cleanup/unrolled
   // loop (mode is kSequential) and the actual vector loop (mode is kVector). The data
   // structure maps original instructions into the new instructions.
   // Contents reside in phase-local heap memory.
   ArenaSafeMap<HInstruction*, HInstruction*>* vector_map_;
 
+  // Permanent mapping used during vectorization synthesis, which is preserved while
+  // unrolling the loop-body. Links each new reduction update back to the update of the
+  // previous unrolled copy (or to the new phi), so that reductions form a single chain.
+  // Contents reside in phase-local heap memory.
+  ArenaSafeMap<HInstruction*, HInstruction*>* vector_permanent_map_;
+
   // Temporary vectorization bookkeeping.
   VectorMode vector_mode_;  // synthesis mode
   HBasicBlock* vector_preheader_;  // preheader of the new loop
@@ -89,6 +89,77 @@ class LoopOptimizationTest : public CommonCompilerTest {
     return LoopStructureRecurse(loop_opt_->top_loop_);
   }
 
+  /**
+   * Constructs the loop "for (int i = 0; i < bound; i++) a[i] = a[i + 1]", which cannot
+   * be vectorized because of its loop-carried data dependence.
+   */
+  void BuildCopyLoop(HInstruction* bound) {
+    HInstruction* array = new (&allocator_) HParameterValue(graph_->GetDexFile(),
+                                                            dex::TypeIndex(1),
+                                                            1,
+                                                            Primitive::kPrimNot);
+    entry_block_->AddInstruction(array);
+    HBasicBlock* header = new (&allocator_) HBasicBlock(graph_);
+    HBasicBlock* body = new (&allocator_) HBasicBlock(graph_);
+    graph_->AddBlock(header);
+    graph_->AddBlock(body);
+    // Control flow.
+    entry_block_->ReplaceSuccessor(return_block_, header);
+    header->AddSuccessor(body);
+    header->AddSuccessor(return_block_);
+    body->AddSuccessor(header);
+    // Data flow.
+    HInstruction* constant_0 = graph_->GetIntConstant(0);
+    HInstruction* constant_1 = graph_->GetIntConstant(1);
+    HPhi* phi = new (&allocator_) HPhi(&allocator_, 0, 0, Primitive::kPrimInt);
+    HInstruction* suspend_check = new (&allocator_) HSuspendCheck();
+    HInstruction* cond = new (&allocator_) HLessThan(phi, bound);
+    header->AddPhi(phi);
+    header->AddInstruction(suspend_check);
+    header->AddInstruction(cond);
+    header->AddInstruction(new (&allocator_) HIf(cond));
+    HEnvironment* environment = new (&allocator_) HEnvironment(&allocator_,
+                                                               1,
+                                                               graph_->GetArtMethod(),
+                                                               0,
+                                                               suspend_check);
+    suspend_check->SetRawEnvironment(environment);
+    environment->SetRawEnvAt(0, phi);
+    phi->AddEnvUseAt(suspend_check->GetEnvironment(), 0);
+    HInstruction* index = new (&allocator_) HAdd(Primitive::kPrimInt, phi, constant_1);
+    HInstruction* get = new (&allocator_) HArrayGet(array, index, Primitive::kPrimInt, 0);
+    HInstruction* set = new (&allocator_) HArraySet(array, phi, get, Primitive::kPrimInt, 0);
+    HInstruction* increment = new (&allocator_) HAdd(Primitive::kPrimInt, phi, constant_1);
+    body->AddInstruction(index);
+    body->AddInstruction(get);
+    body->AddInstruction(set);
+    body->AddInstruction(increment);
+    body->AddInstruction(new (&allocator_) HGoto());
+    phi->AddInput(constant_0);
+    phi->AddInput(increment);
+  }
+
+  /** Runs the full loop optimization with the compiler options of the test. */
+  void PerformOptimization() {
+    graph_->BuildDominatorTree();
+    iva_->Run();
+    HLoopOptimization loop_opt(graph_, compiler_driver_.get(), iva_);
+    loop_opt.Run();
+  }
+
+  /** Counts the array stores in the graph, one per copy of the loop-body. */
+  size_t CountArraySets() {
+    size_t count = 0;
+    for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+      for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+        if (it.Current()->IsArraySet()) {
+          count++;
+        }
+      }
+    }
+    return count;
+  }
+
   // Helper method
   std::string LoopStructureRecurse(HLoopOptimization::LoopNode* node) {
     std::string s;
@@ -235,4 +306,43 @@ TEST_F(LoopOptimizationTest, SimplifyLoop) {
     ASSERT_TRUE(input->GetBlock()->Dominates(header->GetPredecessors()[i]));
   }
 }
+
+TEST_F(LoopOptimizationTest, UnrollingFactor) {
+  // Unroll as far as the code size budget allows.
+  EXPECT_EQ(4u, HLoopOptimization::ComputeUnrollingFactor(5, 1000, 1, 40));
+  EXPECT_EQ(2u, HLoopOptimization::ComputeUnrollingFactor(10, 1000, 1, 40));
+  EXPECT_EQ(2u, HLoopOptimization::ComputeUnrollingFactor(20, 1000, 1, 40));
+  EXPECT_EQ(1u, HLoopOptimization::ComputeUnrollingFactor(21, 1000, 1, 40));
+  EXPECT_EQ(1u, HLoopOptimization::ComputeUnrollingFactor(5, 1000, 1, 0));
+  // Leave at least two unrolled iterations for known trip counts.
+  EXPECT_EQ(2u, HLoopOptimization::ComputeUnrollingFactor(5, 7, 1, 40));
+  EXPECT_EQ(1u, HLoopOptimization::ComputeUnrollingFactor(5, 3, 1, 40));
+  EXPECT_EQ(2u, HLoopOptimization::ComputeUnrollingFactor(5, 16, 4, 40));
+  EXPECT_EQ(4u, HLoopOptimization::ComputeUnrollingFactor(5, 32, 4, 40));
+  // Unroll less aggressively for unknown trip counts.
+  EXPECT_EQ(2u, HLoopOptimization::ComputeUnrollingFactor(5, 0, 1, 40));
+}
+
+TEST_F(LoopOptimizationTest, UnrollKnownTripCount) {
+  BuildCopyLoop(graph_->GetIntConstant(128));
+  PerformOptimization();
+  // Unrolled by four, without cleanup loop.
+  EXPECT_EQ(4u, CountArraySets());
+}
+
+TEST_F(LoopOptimizationTest, UnrollUnknownTripCount) {
+  BuildCopyLoop(parameter_);
+  PerformOptimization();
+  // Unrolled by two, followed by a cleanup loop.
+  EXPECT_EQ(3u, CountArraySets());
+}
+
+TEST_F(LoopOptimizationTest, UnrollWithinBudget) {
+  compiler_options_->SetLoopUnrollMaxInstructions(0);
+  BuildCopyLoop(graph_->GetIntConstant(128));
+  PerformOptimization();
+  // Not unrolled at all.
+  EXPECT_EQ(1u, CountArraySets());
+}
+
 }  // namespace art
@@ -326,8 +326,13 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
         has_bounds_checks_(false),
         has_try_catch_(false),
         has_simd_(false),
+        has_wide_simd_(false),
+        has_stack_allocations_(false),
         has_loops_(false),
         has_irreducible_loops_(false),
+        speculation_disabled_(false),
+        has_branch_profiles_(false),
+        has_block_frequencies_(false),
         debuggable_(debuggable),
         current_instruction_id_(start_instruction_id),
         dex_file_(dex_file),
@@ -345,7 +350,8 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
         art_method_(nullptr),
         inexact_object_rti_(ReferenceTypeInfo::CreateInvalid()),
         osr_(osr),
-        cha_single_implementation_list_(arena->Adapter(kArenaAllocCHA)) {
+        cha_single_implementation_list_(arena->Adapter(kArenaAllocCHA)),
+        inlined_methods_(arena->Adapter(kArenaAllocGraph)) {
     blocks_.reserve(kDefaultNumberOfBlocks);
   }
 
@@ -557,6 +563,12 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
 
   bool IsCompilingOsr() const { return osr_; }
 
+  // Returns whether optimizations can speculate and guard their assumptions with
+  // an HDeoptimize. We never deoptimize from an osr method, otherwise we might
+  // wrongly optimize code dominated by the deoptimization.
+  bool CanSpeculate() const { return !osr_ && !speculation_disabled_; }
+  void DisableSpeculation() { speculation_disabled_ = true; }
+
   ArenaSet<ArtMethod*>& GetCHASingleImplementationList() {
     return cha_single_implementation_list_;
   }
@@ -565,6 +577,15 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
     cha_single_implementation_list_.insert(method);
   }
 
+  const ArenaSet<ArtMethod*>& GetInlinedMethods() const {
+    return inlined_methods_;
+  }
+
+  // Record that the code of `method` was inlined or pattern-substituted in this graph.
+  void AddInlinedMethod(ArtMethod* method) {
+    inlined_methods_.insert(method);
+  }
+
   bool HasShouldDeoptimizeFlag() const {
     return number_of_cha_guards_ != 0;
   }
@@ -575,12 +596,24 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   bool HasSIMD() const { return has_simd_; }
   void SetHasSIMD(bool value) { has_simd_ = value; }
 
+  bool HasWideSIMD() const { return has_wide_simd_; }
+  void SetHasWideSIMD(bool value) { has_wide_simd_ = value; }
+
+  bool HasStackAllocations() const { return has_stack_allocations_; }
+  void SetHasStackAllocations(bool value) { has_stack_allocations_ = value; }
+
   bool HasLoops() const { return has_loops_; }
   void SetHasLoops(bool value) { has_loops_ = value; }
 
   bool HasIrreducibleLoops() const { return has_irreducible_loops_; }
   void SetHasIrreducibleLoops(bool value) { has_irreducible_loops_ = value; }
 
+  bool HasBranchProfiles() const { return has_branch_profiles_; }
+  void SetHasBranchProfiles(bool value) { has_branch_profiles_ = value; }
+
+  bool HasBlockFrequencies() const { return has_block_frequencies_; }
+  void SetHasBlockFrequencies(bool value) { has_block_frequencies_ = value; }
+
   ArtMethod* GetArtMethod() const { return art_method_; }
   void SetArtMethod(ArtMethod* method) { art_method_ = method; }
 
@@ -672,6 +705,15 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   // contents of SIMD registers.
   bool has_simd_;
 
+  // Flag whether the SIMD instructions in the graph operate on 256-bit
+  // vectors (x86-64 AVX2) rather than 128-bit vectors. All vectors in a
+  // graph share one width, which determines the size of SIMD spill slots.
+  bool has_wide_simd_;
+
+  // Flag whether there are HStackAllocation instructions in the graph. If true,
+  // the code generator reserves room for the objects in the frame.
+  bool has_stack_allocations_;
+
   // Flag whether there are any loops in the graph. We can skip loop
   // optimization if it's false. It's only best effort to keep it up
   // to date in the presence of code elimination so there might be false
@@ -683,6 +725,18 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   // so there might be false positives.
   bool has_irreducible_loops_;
 
+  // Flag whether speculative optimizations are disabled for this graph, for
+  // example because its compiled code deoptimized too often (JIT only).
+  bool speculation_disabled_;
+
+  // Flag whether some control flow instructions carry a branch profile collected
+  // by the interpreter (JIT only).
+  bool has_branch_profiles_;
+
+  // Flag whether the blocks' frequencies have been estimated from the branch
+  // profiles. Blocks created afterwards keep the default frequency.
+  bool has_block_frequencies_;
+
   // Indicates whether the graph should be compiled in a way that
   // ensures full debuggability. If false, we can apply more
   // aggressive optimizations that may limit the level of debugging.
@@ -737,6 +791,9 @@ class HGraph : public ArenaObject<kArenaAllocGraph> {
   // List of methods that are assumed to have single implementation.
   ArenaSet<ArtMethod*> cha_single_implementation_list_;
 
+  // Methods whose bytecode was used to build this graph, besides the compiled method.
+  ArenaSet<ArtMethod*> inlined_methods_;
+
   friend class SsaBuilder;           // For caching constants.
   friend class SsaLivenessAnalysis;  // For the linear order.
   friend class HInliner;             // For the reverse post order.
@@ -925,7 +982,8 @@ class HBasicBlock : public ArenaObject<kArenaAllocBasicBlock> {
         dex_pc_(dex_pc),
         lifetime_start_(kNoLifetime),
         lifetime_end_(kNoLifetime),
-        try_catch_information_(nullptr) {
+        try_catch_information_(nullptr),
+        frequency_(1.0f) {
     predecessors_.reserve(kDefaultNumberOfPredecessors);
     successors_.reserve(kDefaultNumberOfSuccessors);
     dominated_blocks_.reserve(kDefaultNumberOfDominatedBlocks);
@@ -1238,6 +1296,9 @@ class HBasicBlock : public ArenaObject<kArenaAllocBasicBlock> {
   void SetLifetimeStart(size_t start) { lifetime_start_ = start; }
   void SetLifetimeEnd(size_t end) { lifetime_end_ = end; }
 
+  float GetFrequency() const { return frequency_; }
+  void SetFrequency(float frequency) { frequency_ = frequency; }
+
   bool EndsWithControlFlowInstruction() const;
   bool EndsWithIf() const;
   bool EndsWithTryBoundary() const;
@@ -1258,6 +1319,8 @@ class HBasicBlock : public ArenaObject<kArenaAllocBasicBlock> {
   size_t lifetime_start_;
   size_t lifetime_end_;
   TryCatchInformation* try_catch_information_;
+  // Estimated execution frequency relative to the entry block, see block_frequency.h.
+  float frequency_;
 
   friend class HGraph;
   friend class HInstruction;
@@ -1359,6 +1422,7 @@ class HLoopInformationOutwardIterator : public ValueObject {
   M(Ror, BinaryOperation)                                               \
   M(Shl, BinaryOperation)                                               \
   M(Shr, BinaryOperation)                                               \
+  M(StackAllocation, Instruction)                                       \
   M(StaticFieldGet, Instruction)                                        \
   M(StaticFieldSet, Instruction)                                        \
   M(UnresolvedInstanceFieldGet, Instruction)                            \
@@ -1374,7 +1438,7 @@ class HLoopInformationOutwardIterator : public ValueObject {
   M(UShr, BinaryOperation)                                              \
   M(Xor, BinaryOperation)                                               \
   M(VecReplicateScalar, VecUnaryOperation)                              \
-  M(VecSumReduce, VecUnaryOperation)                                    \
+  M(VecReduce, VecUnaryOperation)                                       \
   M(VecCnv, VecUnaryOperation)                                          \
   M(VecNeg, VecUnaryOperation)                                          \
   M(VecAbs, VecUnaryOperation)                                          \
@@ -1395,6 +1459,8 @@ class HLoopInformationOutwardIterator : public ValueObject {
   M(VecUShr, VecBinaryOperation)                                        \
   M(VecSetScalars, VecOperation)                                        \
   M(VecMultiplyAccumulate, VecOperation)                                \
+  M(VecDotProd, VecOperation)                                           \
+  M(VecSADAccumulate, VecOperation)                                     \
   M(VecLoad, VecMemoryOperation)                                        \
   M(VecStore, VecMemoryOperation)                                       \
 
@@ -2915,7 +2981,9 @@ class HDoubleConstant FINAL : public HConstant {
 class HIf FINAL : public HTemplateInstruction<1> {
  public:
   explicit HIf(HInstruction* input, uint32_t dex_pc = kNoDexPc)
-      : HTemplateInstruction(SideEffects::None(), dex_pc) {
+      : HTemplateInstruction(SideEffects::None(), dex_pc),
+        true_count_(0u),
+        false_count_(0u) {
     SetRawInputAt(0, input);
   }
 
@@ -2929,9 +2997,23 @@ class HIf FINAL : public HTemplateInstruction<1> {
     return GetBlock()->GetSuccessors()[1];
   }
 
+  // Branch profile collected by the interpreter, if any. The counts follow the
+  // successors: callers swapping the successors must also call `SwapBranchProfile()`.
+  bool HasBranchProfile() const { return true_count_ != 0u || false_count_ != 0u; }
+  uint32_t GetTrueCount() const { return true_count_; }
+  uint32_t GetFalseCount() const { return false_count_; }
+  void SetBranchProfile(uint32_t true_count, uint32_t false_count) {
+    true_count_ = true_count;
+    false_count_ = false_count;
+  }
+  void SwapBranchProfile() { std::swap(true_count_, false_count_); }
+
   DECLARE_INSTRUCTION(If);
 
  private:
+  uint32_t true_count_;
+  uint32_t false_count_;
+
   DISALLOW_COPY_AND_ASSIGN(HIf);
 };
 
@@ -3181,7 +3263,8 @@ class HPackedSwitch FINAL : public HTemplateInstruction<1> {
                 uint32_t dex_pc = kNoDexPc)
     : HTemplateInstruction(SideEffects::None(), dex_pc),
       start_value_(start_value),
-      num_entries_(num_entries) {
+      num_entries_(num_entries),
+      case_counts_(nullptr) {
     SetRawInputAt(0, input);
   }
 
@@ -3195,11 +3278,18 @@ class HPackedSwitch FINAL : public HTemplateInstruction<1> {
     // Last entry is the default block.
     return GetBlock()->GetSuccessors()[num_entries_];
   }
+
+  // Case histogram collected by the interpreter, indexed like the successors
+  // (`num_entries_ + 1` counts, the last one for the default block), or null.
+  const uint32_t* GetCaseCounts() const { return case_counts_; }
+  void SetCaseCounts(const uint32_t* case_counts) { case_counts_ = case_counts; }
+
   DECLARE_INSTRUCTION(PackedSwitch);
 
  private:
   const int32_t start_value_;
   const uint32_t num_entries_;
+  const uint32_t* case_counts_;
 
   DISALLOW_COPY_AND_ASSIGN(HPackedSwitch);
 };
@@ -4540,6 +4630,65 @@ class HNewArray FINAL : public HExpression<2> {
   DISALLOW_COPY_AND_ASSIGN(HNewArray);
 };
 
+// Allocates a non-escaping object or array in the frame of the compiled method, in place
+// of an HNewInstance or HNewArray. The result is the address of the object in the frame.
+// It is not a heap reference, as compressed references cannot hold stack addresses, and
+// therefore has a pointer-sized integral type. Only 64-bit targets allocate on the stack.
+class HStackAllocation FINAL : public HExpression<1> {
+ public:
+  static constexpr uint32_t kUnassignedFrameOffset = static_cast<uint32_t>(-1);
+
+  HStackAllocation(HInstruction* cls,
+                   size_t object_size,
+                   bool is_array,
+                   int32_t array_length,
+                   uint32_t dex_pc)
+      : HExpression(Primitive::kPrimLong, SideEffects::None(), dex_pc),
+        object_size_(object_size),
+        array_length_(array_length),
+        frame_offset_(kUnassignedFrameOffset) {
+    SetPackedFlag<kFlagIsArray>(is_array);
+    SetRawInputAt(0, cls);
+  }
+
+  HLoadClass* GetLoadClass() const {
+    DCHECK(InputAt(0)->IsLoadClass());
+    return InputAt(0)->AsLoadClass();
+  }
+
+  bool IsArray() const { return GetPackedFlag<kFlagIsArray>(); }
+
+  // Size of the object, including the object header.
+  size_t GetObjectSize() const { return object_size_; }
+
+  int32_t GetArrayLength() const {
+    DCHECK(IsArray());
+    return array_length_;
+  }
+
+  // Offset of the object from the stack pointer, set by the code generator
+  // when laying out the frame.
+  uint32_t GetFrameOffset() const {
+    DCHECK_NE(frame_offset_, kUnassignedFrameOffset);
+    return frame_offset_;
+  }
+  void SetFrameOffset(uint32_t offset) { frame_offset_ = offset; }
+
+  DECLARE_INSTRUCTION(StackAllocation);
+
+ private:
+  static constexpr size_t kFlagIsArray = kNumberOfExpressionPackedBits;
+  static constexpr size_t kNumberOfStackAllocationPackedBits = kFlagIsArray + 1;
+  static_assert(kNumberOfStackAllocationPackedBits <= kMaxNumberOfPackedBits,
+                "Too many packed fields.");
+
+  const size_t object_size_;
+  const int32_t array_length_;
+  uint32_t frame_offset_;
+
+  DISALLOW_COPY_AND_ASSIGN(HStackAllocation);
+};
+
 class HAdd FINAL : public HBinaryOperation {
  public:
   HAdd(Primitive::Type result_type,
@@ -100,6 +100,23 @@ class HVecOperation : public HVariableInputSizeInstruction {
     return GetPackedField<TypeField>();
   }
 
+  // Helper method to determine if an instruction returns a SIMD value, i.e. a vector
+  // operation other than a reduction into a scalar, or a phi that carries such a value.
+  // TODO: This method is needed until we introduce SIMD as proper type.
+  static bool ReturnsSIMDValue(HInstruction* instruction) {
+    if (instruction->IsVecOperation()) {
+      return !instruction->IsVecReduce();  // only scalar returning vec op
+    } else if (instruction->IsPhi()) {
+      // Vectorizer only uses Phis in reductions, so checking for a 2-way phi
+      // with a direct vector operand as second argument suffices.
+      return
+          instruction->GetType() == Primitive::kPrimDouble &&
+          instruction->InputCount() == 2 &&
+          instruction->InputAt(1)->IsVecOperation();
+    }
+    return false;
+  }
+
   // Assumes vector nodes cannot be moved by default. Each concrete implementation
   // that can be moved should override this method and return true.
   bool CanBeMoved() const OVERRIDE { return false; }
@@ -222,6 +239,9 @@ class HVecMemoryOperation : public HVecOperation {
 
 // Packed type consistency checker (same vector length integral types may mix freely).
 inline static bool HasConsistentPackedTypes(HInstruction* input, Primitive::Type type) {
+  if (input->IsPhi()) {
+    return input->GetType() == Primitive::kPrimDouble;  // carries SIMD, see reductions
+  }
   DCHECK(input->IsVecOperation());
   Primitive::Type input_type = input->AsVecOperation()->GetPackedType();
   switch (input_type) {
@@ -265,27 +285,47 @@ class HVecReplicateScalar FINAL : public HVecUnaryOperation {
   DISALLOW_COPY_AND_ASSIGN(HVecReplicateScalar);
 };
 
-// Sum-reduces the given vector into a shorter vector (m < n) or scalar (m = 1),
-// viz. sum-reduce[ x1, .. , xn ] = [ y1, .., ym ], where yi = sum_j x_j.
-class HVecSumReduce FINAL : public HVecUnaryOperation {
-  HVecSumReduce(ArenaAllocator* arena,
-                HInstruction* input,
-                Primitive::Type packed_type,
-                size_t vector_length,
-                uint32_t dex_pc = kNoDexPc)
-      : HVecUnaryOperation(arena, input, packed_type, vector_length, dex_pc) {
+// Reduces the given vector into a scalar by the given kind of reduction,
+// viz. sum-reduce[ x1, .. , xn ] = x1 + .. + xn, and similarly for min and max.
+class HVecReduce FINAL : public HVecUnaryOperation {
+ public:
+  enum ReductionKind {
+    kSum = 1,
+    kMin = 2,
+    kMax = 3
+  };
+
+  HVecReduce(ArenaAllocator* arena,
+             HInstruction* input,
+             Primitive::Type packed_type,
+             size_t vector_length,
+             ReductionKind kind,
+             uint32_t dex_pc = kNoDexPc)
+      : HVecUnaryOperation(arena, input, packed_type, vector_length, dex_pc),
+        kind_(kind) {
     DCHECK(HasConsistentPackedTypes(input, packed_type));
+    DCHECK(packed_type == Primitive::kPrimInt || packed_type == Primitive::kPrimLong);
   }
 
-  // TODO: probably integral promotion
+  ReductionKind GetKind() const { return kind_; }
+
+  // The reduction yields a scalar of the (int or long) packed type.
   Primitive::Type GetType() const OVERRIDE { return GetPackedType(); }
 
   bool CanBeMoved() const OVERRIDE { return true; }
 
-  DECLARE_INSTRUCTION(VecSumReduce);
+  bool InstructionDataEquals(const HInstruction* other) const OVERRIDE {
+    DCHECK(other->IsVecReduce());
+    const HVecReduce* o = other->AsVecReduce();
+    return HVecOperation::InstructionDataEquals(o) && GetKind() == o->GetKind();
+  }
+
+  DECLARE_INSTRUCTION(VecReduce);
 
  private:
-  DISALLOW_COPY_AND_ASSIGN(HVecSumReduce);
+  const ReductionKind kind_;
+
+  DISALLOW_COPY_AND_ASSIGN(HVecReduce);
 };
 
 // Converts every component in the vector,
@@ -754,22 +794,26 @@ class HVecUShr FINAL : public HVecBinaryOperation {
 //
 
 // Assigns the given scalar elements to a vector,
-// viz. set( array(x1, .., xn) ) = [ x1, .. , xn ].
+// viz. set( array(x1, .., xn) ) = [ x1, .. , xn ] if n == m,
+//      set( array(x1, .., xm) ) = [ x1, .. , xm, 0, .. , 0 ] if m <  n.
 class HVecSetScalars FINAL : public HVecOperation {
+ public:
   HVecSetScalars(ArenaAllocator* arena,
                  HInstruction** scalars,  // array
                  Primitive::Type packed_type,
                  size_t vector_length,
+                 size_t number_of_scalars,
                  uint32_t dex_pc = kNoDexPc)
       : HVecOperation(arena,
                       packed_type,
                       SideEffects::None(),
-                      /* number_of_inputs */ vector_length,
+                      number_of_scalars,
                       vector_length,
                       dex_pc) {
-    for (size_t i = 0; i < vector_length; i++) {
+    DCHECK_LE(number_of_scalars, vector_length);
+    for (size_t i = 0; i < number_of_scalars; i++) {
       DCHECK(!scalars[i]->IsVecOperation());
-      SetRawInputAt(0, scalars[i]);
+      SetRawInputAt(i, scalars[i]);
     }
   }
 
@@ -835,6 +879,82 @@ class HVecMultiplyAccumulate FINAL : public HVecOperation {
   DISALLOW_COPY_AND_ASSIGN(HVecMultiplyAccumulate);
 };
 
+// Multiplies every component in the two vectors of a narrower signed type and adds
+// all products to the components of the wider accumulator vector, viz.
+// [ a1, .. , am ] + [ x1, .. , xn ] . [ y1, .. , yn ] = [ b1, .. , bm ],
+//     where b1 + .. + bm = a1 + .. + am + x1 * y1 + .. + xn * yn.
+// How the products are distributed over the components is left to the code generator,
+// since the accumulator is only ever consumed by a sum-reduction. The vector length
+// and packed type refer to the accumulator.
+class HVecDotProd FINAL : public HVecOperation {
+ public:
+  HVecDotProd(ArenaAllocator* arena,
+              HInstruction* accumulator,
+              HInstruction* left,
+              HInstruction* right,
+              Primitive::Type packed_type,
+              size_t vector_length,
+              uint32_t dex_pc = kNoDexPc)
+      : HVecOperation(arena,
+                      packed_type,
+                      SideEffects::None(),
+                      /* number_of_inputs */ 3,
+                      vector_length,
+                      dex_pc) {
+    DCHECK(HasConsistentPackedTypes(accumulator, packed_type));
+    DCHECK(left->IsVecOperation() && right->IsVecOperation());
+    DCHECK_EQ(left->AsVecOperation()->GetPackedType(), right->AsVecOperation()->GetPackedType());
+    SetRawInputAt(0, accumulator);
+    SetRawInputAt(1, left);
+    SetRawInputAt(2, right);
+  }
+
+  bool CanBeMoved() const OVERRIDE { return true; }
+
+  DECLARE_INSTRUCTION(VecDotProd);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HVecDotProd);
+};
+
+// Takes the absolute difference of every component in the two vectors of a narrower
+// signed type and adds all differences to the components of the wider accumulator vector,
+// viz. [ a1, .. , am ] + sad([ x1, .. , xn ], [ y1, .. , yn ]) = [ b1, .. , bm ],
+//     where b1 + .. + bm = a1 + .. + am + |x1 - y1| + .. + |xn - yn|.
+// As above, the distribution over the components is left to the code generator.
+// The vector length and packed type refer to the accumulator.
+class HVecSADAccumulate FINAL : public HVecOperation {
+ public:
+  HVecSADAccumulate(ArenaAllocator* arena,
+                    HInstruction* accumulator,
+                    HInstruction* sad_left,
+                    HInstruction* sad_right,
+                    Primitive::Type packed_type,
+                    size_t vector_length,
+                    uint32_t dex_pc = kNoDexPc)
+      : HVecOperation(arena,
+                      packed_type,
+                      SideEffects::None(),
+                      /* number_of_inputs */ 3,
+                      vector_length,
+                      dex_pc) {
+    DCHECK(HasConsistentPackedTypes(accumulator, packed_type));
+    DCHECK(sad_left->IsVecOperation() && sad_right->IsVecOperation());
+    DCHECK_EQ(sad_left->AsVecOperation()->GetPackedType(),
+              sad_right->AsVecOperation()->GetPackedType());
+    SetRawInputAt(0, accumulator);
+    SetRawInputAt(1, sad_left);
+    SetRawInputAt(2, sad_right);
+  }
+
+  bool CanBeMoved() const OVERRIDE { return true; }
+
+  DECLARE_INSTRUCTION(VecSADAccumulate);
+
+ private:
+  DISALLOW_COPY_AND_ASSIGN(HVecSADAccumulate);
+};
+
 // Loads a vector from memory, viz. load(mem, 1)
 // yield the vector [ mem(1), .. , mem(n) ].
 class HVecLoad FINAL : public HVecMemoryOperation {
@@ -19,9 +19,14 @@
 #include <fstream>
 #include <memory>
 #include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <stdint.h>
 
+#include "android-base/strings.h"
+
 #ifdef ART_ENABLE_CODEGEN_arm64
 #include "instruction_simplifier_arm64.h"
 #endif
@@ -44,7 +49,9 @@
 #include "base/dumpable.h"
 #include "base/macros.h"
 #include "base/mutex.h"
+#include "base/time_utils.h"
 #include "base/timing_logger.h"
+#include "block_frequency.h"
 #include "bounds_check_elimination.h"
 #include "builder.h"
 #include "cha_guard_optimization.h"
@@ -62,6 +69,7 @@
 #include "driver/compiler_driver-inl.h"
 #include "driver/compiler_options.h"
 #include "driver/dex_compilation_unit.h"
+#include "driver/incremental_compilation.h"
 #include "elf_writer_quick.h"
 #include "graph_checker.h"
 #include "graph_visualizer.h"
@@ -75,6 +83,8 @@
 #include "jit/jit.h"
 #include "jit/jit_code_cache.h"
 #include "jit/jit_logger.h"
+#include "jit/jit_telemetry.h"
+#include "jit/profiling_info.h"
 #include "jni/quick/jni_compiler.h"
 #include "licm.h"
 #include "load_store_analysis.h"
@@ -92,6 +102,7 @@
 #include "ssa_builder.h"
 #include "ssa_liveness_analysis.h"
 #include "ssa_phi_elimination.h"
+#include "stack_allocation.h"
 #include "utils/assembler.h"
 #include "verifier/verifier_compiler_binding.h"
 
@@ -135,15 +146,21 @@ static constexpr const char kStringFilter[] = "";
 
 class PassScope;
 
+// Name and duration in nanoseconds of each pass run on a method.
+using PassTimes = std::vector<std::pair<std::string, uint64_t>>;
+
 class PassObserver : public ValueObject {
  public:
   PassObserver(HGraph* graph,
                CodeGenerator* codegen,
                std::ostream* visualizer_output,
                CompilerDriver* compiler_driver,
-               Mutex& dump_mutex)
+               Mutex& dump_mutex,
+               PassTimes* pass_times_ns = nullptr)
       : graph_(graph),
         cached_method_name_(),
+        pass_times_ns_(pass_times_ns),
+        pass_start_ns_(0u),
         timing_logger_enabled_(compiler_driver->GetDumpPasses()),
         timing_logger_(timing_logger_enabled_ ? GetMethodName() : "", true, true),
         disasm_info_(graph->GetArena()),
@@ -200,6 +217,9 @@ class PassObserver : public ValueObject {
     if (timing_logger_enabled_) {
       timing_logger_.StartTiming(pass_name);
     }
+    if (pass_times_ns_ != nullptr) {
+      pass_start_ns_ = NanoTime();
+    }
   }
 
   void FlushVisualizer() REQUIRES(!visualizer_dump_mutex_) {
@@ -215,6 +235,9 @@ class PassObserver : public ValueObject {
     if (timing_logger_enabled_) {
       timing_logger_.EndTiming();
     }
+    if (pass_times_ns_ != nullptr) {
+      pass_times_ns_->emplace_back(pass_name, NanoTime() - pass_start_ns_);
+    }
     if (visualizer_enabled_) {
       visualizer_.DumpGraph(pass_name, /* is_after_pass */ true, graph_in_bad_state_);
       FlushVisualizer();
@@ -253,6 +276,10 @@ class PassObserver : public ValueObject {
 
   std::string cached_method_name_;
 
+  // Where to record the duration of each pass, or null.
+  PassTimes* const pass_times_ns_;
+  uint64_t pass_start_ns_;
+
   bool timing_logger_enabled_;
   TimingLogger timing_logger_;
 
@@ -341,7 +368,8 @@ class OptimizingCompiler FINAL : public Compiler {
                         CompilerDriver* driver,
                         const DexCompilationUnit& dex_compilation_unit,
                         PassObserver* pass_observer,
-                        VariableSizedHandleScope* handles) const;
+                        VariableSizedHandleScope* handles,
+                        OptimizingCompilerStats* stats) const;
 
   void RunOptimizations(HOptimization* optimizations[],
                         size_t length,
@@ -362,6 +390,8 @@ class OptimizingCompiler FINAL : public Compiler {
   // 2) Transforms the graph to SSA. Returns null if it failed.
   // 3) Runs optimizations on the graph, including register allocator.
   // 4) Generates code with the `code_allocator` provided.
+  // Statistics are recorded in `stats`, and the time spent in each pass is
+  // appended to `pass_times_ns` if not null.
   CodeGenerator* TryCompile(ArenaAllocator* arena,
                             CodeVectorAllocator* code_allocator,
                             const DexFile::CodeItem* code_item,
@@ -374,19 +404,23 @@ class OptimizingCompiler FINAL : public Compiler {
                             Handle<mirror::DexCache> dex_cache,
                             ArtMethod* method,
                             bool osr,
-                            VariableSizedHandleScope* handles) const;
+                            VariableSizedHandleScope* handles,
+                            OptimizingCompilerStats* stats,
+                            PassTimes* pass_times_ns) const;
 
   void MaybeRunInliner(HGraph* graph,
                        CodeGenerator* codegen,
                        CompilerDriver* driver,
                        const DexCompilationUnit& dex_compilation_unit,
                        PassObserver* pass_observer,
-                       VariableSizedHandleScope* handles) const;
+                       VariableSizedHandleScope* handles,
+                       OptimizingCompilerStats* stats) const;
 
   void RunArchOptimizations(InstructionSet instruction_set,
                             HGraph* graph,
                             CodeGenerator* codegen,
-                            PassObserver* pass_observer) const;
+                            PassObserver* pass_observer,
+                            OptimizingCompilerStats* stats) const;
 
   std::unique_ptr<OptimizingCompilerStats> compilation_stats_;
 
@@ -413,7 +447,8 @@ void OptimizingCompiler::Init() {
         driver->GetCompilerOptions().GetDumpCfgAppend() ? std::ofstream::app : std::ofstream::out;
     visualizer_output_.reset(new std::ofstream(cfg_file_name, cfg_file_mode));
   }
-  if (driver->GetDumpStats()) {
+  // Do not pay for collecting statistics that are never logged.
+  if (driver->GetDumpStats() && OptimizingCompilerStats::IsLogged()) {
     compilation_stats_.reset(new OptimizingCompilerStats());
   }
 }
@@ -498,7 +533,7 @@ static HOptimization* BuildOptimization(
     return new (arena) IntrinsicsRecognizer(graph, stats);
   } else if (opt_name == LICM::kLoopInvariantCodeMotionPassName) {
     CHECK(most_recent_side_effects != nullptr);
-    return new (arena) LICM(graph, *most_recent_side_effects, stats);
+    return new (arena) LICM(graph, *most_recent_side_effects, most_recent_lsa, stats);
   } else if (opt_name == LoadStoreAnalysis::kLoadStoreAnalysisPassName) {
     return new (arena) LoadStoreAnalysis(graph);
   } else if (opt_name == LoadStoreElimination::kLoadStoreEliminationPassName) {
@@ -514,6 +549,8 @@ static HOptimization* BuildOptimization(
     return new (arena) CHAGuardOptimization(graph);
   } else if (opt_name == CodeSinking::kCodeSinkingPassName) {
     return new (arena) CodeSinking(graph, stats);
+  } else if (opt_name == StackAllocationOptimization::kStackAllocationPassName) {
+    return new (arena) StackAllocationOptimization(graph, driver->GetInstructionSet(), stats);
 #ifdef ART_ENABLE_CODEGEN_arm
   } else if (opt_name == arm::InstructionSimplifierArm::kInstructionSimplifierArmPassName) {
     return new (arena) arm::InstructionSimplifierArm(graph, stats);
@@ -594,8 +631,8 @@ void OptimizingCompiler::MaybeRunInliner(HGraph* graph,
                                          CompilerDriver* driver,
                                          const DexCompilationUnit& dex_compilation_unit,
                                          PassObserver* pass_observer,
-                                         VariableSizedHandleScope* handles) const {
-  OptimizingCompilerStats* stats = compilation_stats_.get();
+                                         VariableSizedHandleScope* handles,
+                                         OptimizingCompilerStats* stats) const {
   const CompilerOptions& compiler_options = driver->GetCompilerOptions();
   bool should_inline = (compiler_options.GetInlineMaxCodeUnits() > 0);
   if (!should_inline) {
@@ -622,9 +659,9 @@ void OptimizingCompiler::MaybeRunInliner(HGraph* graph,
 void OptimizingCompiler::RunArchOptimizations(InstructionSet instruction_set,
                                               HGraph* graph,
                                               CodeGenerator* codegen,
-                                              PassObserver* pass_observer) const {
+                                              PassObserver* pass_observer,
+                                              OptimizingCompilerStats* stats) const {
   UNUSED(codegen);  // To avoid compilation error when compiling for svelte
-  OptimizingCompilerStats* stats = compilation_stats_.get();
   ArenaAllocator* arena = graph->GetArena();
   switch (instruction_set) {
 #if defined(ART_ENABLE_CODEGEN_arm)
@@ -691,9 +728,13 @@ void OptimizingCompiler::RunArchOptimizations(InstructionSet instruction_set,
 #endif
 #ifdef ART_ENABLE_CODEGEN_x86_64
     case kX86_64: {
+      // Schedule first, so that memory operand generation sees the final instruction order.
+      HInstructionScheduling* scheduling =
+          new (arena) HInstructionScheduling(graph, instruction_set);
       x86::X86MemoryOperandGeneration* memory_gen =
           new (arena) x86::X86MemoryOperandGeneration(graph, codegen, stats);
       HOptimization* x86_64_optimizations[] = {
+          scheduling,
           memory_gen
       };
       RunOptimizations(x86_64_optimizations, arraysize(x86_64_optimizations), pass_observer);
@@ -705,6 +746,66 @@ void OptimizingCompiler::RunArchOptimizations(InstructionSet instruction_set,
   }
 }
 
+// Picks the register allocator for `graph`. Unless the strategy is picked per method,
+// this is the one given on the command line. Otherwise, hot methods and small methods
+// with loops are allocated by graph coloring when compiling for the JIT, or ahead-of-time
+// with a profile.
+static RegisterAllocator::Strategy SelectRegisterAllocationStrategy(
+    HGraph* graph,
+    CompilerDriver* compiler_driver,
+    const CompilerOptions& compiler_options) {
+  if (!compiler_options.UseAdaptiveRegisterAllocation()) {
+    return compiler_options.GetRegisterAllocationStrategy();
+  }
+  bool is_hot = graph->IsCompilingOsr();
+  // The JIT only compiles methods that its own profiling found to be warm.
+  bool has_hotness_information = !Runtime::Current()->IsAotCompiler();
+  const ProfileCompilationInfo* profile = compiler_driver->GetProfileCompilationInfo();
+  if (profile != nullptr) {
+    MethodReference method_ref(&graph->GetDexFile(), graph->GetMethodIdx());
+    is_hot = is_hot || profile->GetMethodHotness(method_ref).IsHot();
+    has_hotness_information = true;
+  }
+  return RegisterAllocator::SelectAdaptiveStrategy(
+      static_cast<size_t>(graph->GetCurrentInstructionId()),
+      graph->HasLoops(),
+      is_hot,
+      has_hotness_information);
+}
+
+static bool IsSpillSlot(Location location) {
+  return location.IsStackSlot() || location.IsDoubleStackSlot() || location.IsSIMDStackSlot();
+}
+
+// Counts the spills (register to stack moves) and reloads (stack to register moves)
+// inserted by the register allocator.
+static void RecordSpillsAndReloads(HGraph* graph, OptimizingCompilerStats* stats) {
+  size_t spills = 0;
+  size_t reloads = 0;
+  for (HBasicBlock* block : graph->GetReversePostOrder()) {
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      if (!it.Current()->IsParallelMove()) {
+        continue;
+      }
+      HParallelMove* move = it.Current()->AsParallelMove();
+      for (size_t i = 0, e = move->NumMoves(); i < e; ++i) {
+        MoveOperands* operands = move->MoveOperandsAt(i);
+        Location source = operands->GetSource();
+        Location destination = operands->GetDestination();
+        if (operands->IsRedundant()) {
+          continue;
+        } else if (source.IsRegisterKind() && IsSpillSlot(destination)) {
+          ++spills;
+        } else if (IsSpillSlot(source) && destination.IsRegisterKind()) {
+          ++reloads;
+        }
+      }
+    }
+  }
+  stats->RecordStat(MethodCompilationStat::kRegisterAllocatorSpill, spills);
+  stats->RecordStat(MethodCompilationStat::kRegisterAllocatorReload, reloads);
+}
+
 NO_INLINE  // Avoid increasing caller's frame size by large stack-allocated objects.
 static void AllocateRegisters(HGraph* graph,
                               CodeGenerator* codegen,
@@ -725,6 +826,14 @@ static void AllocateRegisters(HGraph* graph,
     PassScope scope(RegisterAllocator::kRegisterAllocatorPassName, pass_observer);
     RegisterAllocator::Create(graph->GetArena(), codegen, liveness, strategy)->AllocateRegisters();
   }
+  // Counting the spill and reload moves walks the whole graph again. There are statistics
+  // only with --dump-stats in builds that log them, or for JIT telemetry events.
+  if (stats != nullptr) {
+    if (strategy == RegisterAllocator::kRegisterAllocatorGraphColor) {
+      stats->RecordStat(MethodCompilationStat::kGraphColorRegisterAllocation);
+    }
+    RecordSpillsAndReloads(graph, stats);
+  }
 }
 
 void OptimizingCompiler::RunOptimizations(HGraph* graph,
@@ -732,8 +841,8 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
                                           CompilerDriver* driver,
                                           const DexCompilationUnit& dex_compilation_unit,
                                           PassObserver* pass_observer,
-                                          VariableSizedHandleScope* handles) const {
-  OptimizingCompilerStats* stats = compilation_stats_.get();
+                                          VariableSizedHandleScope* handles,
+                                          OptimizingCompilerStats* stats) const {
   ArenaAllocator* arena = graph->GetArena();
   if (driver->GetCompilerOptions().GetPassesToRun() != nullptr) {
     ArenaVector<HOptimization*> optimizations = BuildOptimizations(
@@ -767,7 +876,9 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
   SideEffectsAnalysis* side_effects2 = new (arena) SideEffectsAnalysis(
       graph, "side_effects$before_lse");
   GVNOptimization* gvn = new (arena) GVNOptimization(graph, *side_effects1);
-  LICM* licm = new (arena) LICM(graph, *side_effects1, stats);
+  LoadStoreAnalysis* lsa1 = new (arena) LoadStoreAnalysis(
+      graph, "load_store_analysis$before_licm");
+  LICM* licm = new (arena) LICM(graph, *side_effects1, lsa1, stats);
   HInductionVarAnalysis* induction = new (arena) HInductionVarAnalysis(graph);
   BoundsCheckElimination* bce = new (arena) BoundsCheckElimination(graph, *side_effects1, induction);
   HLoopOptimization* loop = new (arena) HLoopOptimization(graph, driver, induction);
@@ -784,6 +895,8 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
   IntrinsicsRecognizer* intrinsics = new (arena) IntrinsicsRecognizer(graph, stats);
   CHAGuardOptimization* cha_guard = new (arena) CHAGuardOptimization(graph);
   CodeSinking* code_sinking = new (arena) CodeSinking(graph, stats);
+  StackAllocationOptimization* stack_allocation =
+      new (arena) StackAllocationOptimization(graph, driver->GetInstructionSet(), stats);
 
   HOptimization* optimizations1[] = {
     intrinsics,
@@ -794,7 +907,7 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
   };
   RunOptimizations(optimizations1, arraysize(optimizations1), pass_observer);
 
-  MaybeRunInliner(graph, codegen, driver, dex_compilation_unit, pass_observer, handles);
+  MaybeRunInliner(graph, codegen, driver, dex_compilation_unit, pass_observer, handles, stats);
 
   HOptimization* optimizations2[] = {
     // SelectGenerator depends on the InstructionSimplifier removing
@@ -805,6 +918,19 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
     dce2,
     side_effects1,
     gvn,
+  };
+  RunOptimizations(optimizations2, arraysize(optimizations2), pass_observer);
+
+  // LICM only uses the heap locations to hoist loads out of loops. Without loops,
+  // do not run the analysis: LICM then sees no heap location.
+  if (graph->HasLoops()) {
+    HOptimization* licm_analyses[] = {
+      lsa1,
+    };
+    RunOptimizations(licm_analyses, arraysize(licm_analyses), pass_observer);
+  }
+
+  HOptimization* optimizations3[] = {
     licm,
     induction,
     bce,
@@ -817,14 +943,23 @@ void OptimizingCompiler::RunOptimizations(HGraph* graph,
     cha_guard,
     dce3,
     code_sinking,
+    // Stack allocation runs after LSE, which removes the allocations it can.
+    stack_allocation,
     // The codegen has a few assumptions that only the instruction simplifier
     // can satisfy. For example, the code generator does not expect to see a
     // HTypeConversion from a type to the same type.
     simplify4,
   };
-  RunOptimizations(optimizations2, arraysize(optimizations2), pass_observer);
+  RunOptimizations(optimizations3, arraysize(optimizations3), pass_observer);
+
+  // Block frequencies are used by the scheduler, the register allocator and
+  // the code layout, and are only worth computing with a branch profile.
+  // Otherwise, the code generator estimates them for the code layout only.
+  if (graph->HasBranchProfiles()) {
+    ComputeBlockFrequencies(graph);
+  }
 
-  RunArchOptimizations(driver->GetInstructionSet(), graph, codegen, pass_observer);
+  RunArchOptimizations(driver->GetInstructionSet(), graph, codegen, pass_observer, stats);
 }
 
 static ArenaVector<LinkerPatch> EmitAndSortLinkerPatches(CodeGenerator* codegen) {
@@ -887,8 +1022,10 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* arena,
                                               Handle<mirror::DexCache> dex_cache,
                                               ArtMethod* method,
                                               bool osr,
-                                              VariableSizedHandleScope* handles) const {
-  MaybeRecordStat(compilation_stats_.get(),
+                                              VariableSizedHandleScope* handles,
+                                              OptimizingCompilerStats* stats,
+                                              PassTimes* pass_times_ns) const {
+  MaybeRecordStat(stats,
                   MethodCompilationStat::kAttemptCompilation);
   CompilerDriver* compiler_driver = GetCompilerDriver();
   InstructionSet instruction_set = compiler_driver->GetInstructionSet();
@@ -899,13 +1036,13 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* arena,
 
   // Do not attempt to compile on architectures we do not support.
   if (!IsInstructionSetSupported(instruction_set)) {
-    MaybeRecordStat(compilation_stats_.get(),
+    MaybeRecordStat(stats,
                     MethodCompilationStat::kNotCompiledUnsupportedIsa);
     return nullptr;
   }
 
   if (Compiler::IsPathologicalCase(*code_item, method_idx, dex_file)) {
-    MaybeRecordStat(compilation_stats_.get(),
+    MaybeRecordStat(stats,
                     MethodCompilationStat::kNotCompiledPathological);
     return nullptr;
   }
@@ -916,7 +1053,7 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* arena,
   const CompilerOptions& compiler_options = compiler_driver->GetCompilerOptions();
   if ((compiler_options.GetCompilerFilter() == CompilerFilter::kSpace)
       && (code_item->insns_size_in_code_units_ > kSpaceFilterOptimizingThreshold)) {
-    MaybeRecordStat(compilation_stats_.get(),
+    MaybeRecordStat(stats,
                     MethodCompilationStat::kNotCompiledSpaceFilter);
     return nullptr;
   }
@@ -955,6 +1092,15 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* arena,
     graph->SetArtMethod(method);
     ScopedObjectAccess soa(Thread::Current());
     interpreter_metadata = method->GetQuickenedInfo(class_linker->GetImagePointerSize());
+    if (Runtime::Current()->UseJitCompilation() && !method->IsNative()) {
+      // The profiling info is kept alive by the JIT code cache while the method is compiled.
+      ProfilingInfo* info = method->GetProfilingInfo(class_linker->GetImagePointerSize());
+      if (info != nullptr && info->IsSpeculationDisabled()) {
+        graph->DisableSpeculation();
+        MaybeRecordStat(stats,
+                        MethodCompilationStat::kSpeculationDisabled);
+      }
+    }
   }
 
   std::unique_ptr<CodeGenerator> codegen(
@@ -962,9 +1108,9 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* arena,
                             instruction_set,
                             *compiler_driver->GetInstructionSetFeatures(),
                             compiler_driver->GetCompilerOptions(),
-                            compilation_stats_.get()));
+                            stats));
   if (codegen.get() == nullptr) {
-    MaybeRecordStat(compilation_stats_.get(),
+    MaybeRecordStat(stats,
                     MethodCompilationStat::kNotCompiledNoCodegen);
     return nullptr;
   }
@@ -975,7 +1121,8 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* arena,
                              codegen.get(),
                              visualizer_output_.get(),
                              compiler_driver,
-                             dump_mutex_);
+                             dump_mutex_,
+                             pass_times_ns);
 
   {
     VLOG(compiler) << "Building " << pass_observer.GetMethodName();
@@ -987,7 +1134,7 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* arena,
                           *code_item,
                           compiler_driver,
                           codegen.get(),
-                          compilation_stats_.get(),
+                          stats,
                           interpreter_metadata,
                           dex_cache,
                           handles);
@@ -995,22 +1142,22 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* arena,
     if (result != kAnalysisSuccess) {
       switch (result) {
         case kAnalysisSkipped: {
-          MaybeRecordStat(compilation_stats_.get(),
+          MaybeRecordStat(stats,
                           MethodCompilationStat::kNotCompiledSkipped);
         }
           break;
         case kAnalysisInvalidBytecode: {
-          MaybeRecordStat(compilation_stats_.get(),
+          MaybeRecordStat(stats,
                           MethodCompilationStat::kNotCompiledInvalidBytecode);
         }
           break;
         case kAnalysisFailThrowCatchLoop: {
-          MaybeRecordStat(compilation_stats_.get(),
+          MaybeRecordStat(stats,
                           MethodCompilationStat::kNotCompiledThrowCatchLoop);
         }
           break;
         case kAnalysisFailAmbiguousArrayOp: {
-          MaybeRecordStat(compilation_stats_.get(),
+          MaybeRecordStat(stats,
                           MethodCompilationStat::kNotCompiledAmbiguousArrayOp);
         }
           break;
@@ -1027,15 +1174,16 @@ CodeGenerator* OptimizingCompiler::TryCompile(ArenaAllocator* arena,
                    compiler_driver,
                    dex_compilation_unit,
                    &pass_observer,
-                   handles);
+                   handles,
+                   stats);
 
   RegisterAllocator::Strategy regalloc_strategy =
-    compiler_options.GetRegisterAllocationStrategy();
+      SelectRegisterAllocationStrategy(graph, compiler_driver, compiler_options);
   AllocateRegisters(graph,
                     codegen.get(),
                     &pass_observer,
                     regalloc_strategy,
-                    compilation_stats_.get());
+                    stats);
 
   codegen->Compile(code_allocator);
   pass_observer.DumpDisassembly();
@@ -1080,13 +1228,25 @@ CompiledMethod* OptimizingCompiler::Compile(const DexFile::CodeItem* code_item,
                      dex_cache,
                      nullptr,
                      /* osr */ false,
-                     &handles));
+                     &handles,
+                     compilation_stats_.get(),
+                     /* pass_times_ns */ nullptr));
     }
     if (codegen.get() != nullptr) {
       MaybeRecordStat(compilation_stats_.get(),
                       MethodCompilationStat::kCompiled);
       method = Emit(&arena, &code_allocator, codegen.get(), compiler_driver, code_item);
 
+      IncrementalCompilation* incremental_compilation =
+          compiler_driver->GetIncrementalCompilation();
+      if (incremental_compilation != nullptr && method != nullptr) {
+        MethodReference method_ref(&dex_file, method_idx);
+        ScopedObjectAccess soa(Thread::Current());
+        for (ArtMethod* inlined_method : codegen->GetGraph()->GetInlinedMethods()) {
+          incremental_compilation->RecordInlinedMethod(method_ref, inlined_method);
+        }
+      }
+
       if (kArenaAllocatorCountAllocations) {
         if (arena.BytesAllocated() > kArenaAllocatorMemoryReportThreshold) {
           MemStats mem_stats(arena.GetMemStats());
@@ -1147,6 +1307,49 @@ bool CanEncodeInlinedMethodInStackMap(const DexFile& caller_dex_file, ArtMethod*
   return false;
 }
 
+// Reports the details of a JIT compilation to the JIT telemetry when leaving
+// its scope, whatever the outcome of the compilation.
+class JitCompilationReporter : public ValueObject {
+ public:
+  JitCompilationReporter(jit::JitCompilationEvent* event,
+                         ArenaPool* arena_pool,
+                         const OptimizingCompilerStats* method_stats,
+                         OptimizingCompilerStats* global_stats)
+      : event_(event),
+        arena_pool_(arena_pool),
+        method_stats_(method_stats),
+        global_stats_(global_stats) {
+    if (event_ != nullptr) {
+      // The JIT compiles one method at a time, so the pool is only used by this compilation.
+      arena_pool_->ResetPeakBytesInUse();
+    }
+  }
+
+  ~JitCompilationReporter() {
+    if (event_ == nullptr) {
+      return;
+    }
+    event_->arena_bytes = arena_pool_->GetPeakBytesInUse();
+    method_stats_->VisitRecordedStats([this](const std::string& name, uint32_t count) {
+      event_->compiler_stats.emplace_back(name, count);
+      if (event_->failure_reason.empty() && android::base::StartsWith(name, "NotCompiled")) {
+        event_->failure_reason = name;
+      }
+    });
+    if (global_stats_ != nullptr) {
+      method_stats_->AddTo(global_stats_);
+    }
+  }
+
+ private:
+  jit::JitCompilationEvent* const event_;
+  ArenaPool* const arena_pool_;
+  const OptimizingCompilerStats* const method_stats_;
+  OptimizingCompilerStats* const global_stats_;
+
+  DISALLOW_COPY_AND_ASSIGN(JitCompilationReporter);
+};
+
 bool OptimizingCompiler::JitCompile(Thread* self,
                                     jit::JitCodeCache* code_cache,
                                     ArtMethod* method,
@@ -1169,6 +1372,18 @@ bool OptimizingCompiler::JitCompile(Thread* self,
   CodeVectorAllocator code_allocator(&arena);
   VariableSizedHandleScope handles(self);
 
+  // With telemetry, statistics are collected for this method only, and added
+  // to the global ones afterwards.
+  jit::JitCompilationEvent* event = Runtime::Current()->GetJit()->GetCurrentCompilationEvent(self);
+  std::unique_ptr<OptimizingCompilerStats> method_stats;
+  if (event != nullptr) {
+    method_stats.reset(new OptimizingCompilerStats());
+  }
+  OptimizingCompilerStats* stats =
+      (event != nullptr) ? method_stats.get() : compilation_stats_.get();
+  JitCompilationReporter reporter(
+      event, arena.GetArenaPool(), method_stats.get(), compilation_stats_.get());
+
   std::unique_ptr<CodeGenerator> codegen;
   {
     // Go to native so that we don't block GC during compilation.
@@ -1186,7 +1401,9 @@ bool OptimizingCompiler::JitCompile(Thread* self,
                    dex_cache,
                    method,
                    osr,
-                   &handles));
+                   &handles,
+                   stats,
+                   (event != nullptr) ? &event->pass_times_ns : nullptr));
     if (codegen.get() == nullptr) {
       return false;
     }
@@ -1214,6 +1431,9 @@ bool OptimizingCompiler::JitCompile(Thread* self,
     // Out of memory, just clear the exception to avoid any Java exception uncaught problems.
     DCHECK(self->IsExceptionPending());
     self->ClearException();
+    if (event != nullptr) {
+      event->failure_reason = "OutOfMemoryForRoots";
+    }
     return false;
   }
   uint8_t* stack_map_data = nullptr;
@@ -1228,9 +1448,12 @@ bool OptimizingCompiler::JitCompile(Thread* self,
                                                &method_info_data,
                                                &roots_data);
   if (stack_map_data == nullptr || roots_data == nullptr) {
+    if (event != nullptr) {
+      event->failure_reason = "CodeCacheFull";
+    }
     return false;
   }
-  MaybeRecordStat(compilation_stats_.get(), MethodCompilationStat::kCompiled);
+  MaybeRecordStat(stats, MethodCompilationStat::kCompiled);
   codegen->BuildStackMaps(MemoryRegion(stack_map_data, stack_map_size),
                           MemoryRegion(method_info_data, method_info_size),
                           *code_item);
@@ -1255,8 +1478,14 @@ bool OptimizingCompiler::JitCompile(Thread* self,
 
   if (code == nullptr) {
     code_cache->ClearData(self, stack_map_data, roots_data);
+    if (event != nullptr) {
+      event->failure_reason = "CodeCacheFull";
+    }
     return false;
   }
+  if (event != nullptr) {
+    event->code_size = code_allocator.GetSize();
+  }
 
   const CompilerOptions& compiler_options = GetCompilerDriver()->GetCompilerOptions();
   if (compiler_options.GetGenerateDebugInfo()) {
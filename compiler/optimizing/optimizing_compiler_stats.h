@@ -57,12 +57,15 @@ enum MethodCompilationStat {
   kNotCompiledVerifyAtRuntime,
   kInlinedMonomorphicCall,
   kInlinedPolymorphicCall,
+  kInlinedMegamorphicCall,
   kMonomorphicCall,
   kPolymorphicCall,
   kMegamorphicCall,
+  kMegamorphicSkewedCall,
   kBooleanSimplified,
   kIntrinsicRecognized,
   kLoopInvariantMoved,
+  kLoopStoreSunk,
   kSelectGenerated,
   kRemovedInstanceOf,
   kInlinedInvokeVirtualOrInterface,
@@ -87,10 +90,20 @@ enum MethodCompilationStat {
   kNotInlinedWont,
   kNotInlinedRecursiveBudget,
   kNotInlinedProxy,
+  kNotInlinedColdCallSite,
   kConstructorFenceGeneratedNew,
   kConstructorFenceGeneratedFinal,
   kConstructorFenceRemovedLSE,
   kConstructorFenceRemovedPFRA,
+  kSpeculationDisabled,
+  kColdBranchPruned,
+  kGraphColorRegisterAllocation,
+  kRegisterAllocatorSpill,
+  kRegisterAllocatorReload,
+  kStackAllocatedInstance,
+  kStackAllocatedArray,
+  kStackAllocatedBytes,
+  kColdBlockSplit,
   kLastStat
 };
 
@@ -105,9 +118,13 @@ class OptimizingCompilerStats {
     compile_stats_[stat] += count;
   }
 
+  // Log only in debug builds or if the compiler is verbose.
+  static bool IsLogged() {
+    return kIsDebugBuild || VLOG_IS_ON(compiler);
+  }
+
   void Log() const {
-    if (!kIsDebugBuild && !VLOG_IS_ON(compiler)) {
-      // Log only in debug builds or if the compiler is verbose.
+    if (!IsLogged()) {
       return;
     }
 
@@ -144,6 +161,17 @@ class OptimizingCompilerStats {
     }
   }
 
+  // Calls `visitor(name, count)` for each stat recorded at least once.
+  template <typename Visitor>
+  void VisitRecordedStats(Visitor&& visitor) const {
+    for (size_t i = 0; i != kLastStat; ++i) {
+      uint32_t count = compile_stats_[i];
+      if (count != 0) {
+        visitor(PrintMethodCompilationStat(static_cast<MethodCompilationStat>(i)), count);
+      }
+    }
+  }
+
  private:
   std::string PrintMethodCompilationStat(MethodCompilationStat stat) const {
     std::string name;
@@ -177,12 +205,15 @@ class OptimizingCompilerStats {
       case kNotCompiledVerifyAtRuntime : name = "NotCompiledVerifyAtRuntime"; break;
       case kInlinedMonomorphicCall: name = "InlinedMonomorphicCall"; break;
       case kInlinedPolymorphicCall: name = "InlinedPolymorphicCall"; break;
+      case kInlinedMegamorphicCall: name = "InlinedMegamorphicCall"; break;
       case kMonomorphicCall: name = "MonomorphicCall"; break;
       case kPolymorphicCall: name = "PolymorphicCall"; break;
       case kMegamorphicCall: name = "MegamorphicCall"; break;
+      case kMegamorphicSkewedCall: name = "MegamorphicSkewedCall"; break;
       case kBooleanSimplified : name = "BooleanSimplified"; break;
       case kIntrinsicRecognized : name = "IntrinsicRecognized"; break;
       case kLoopInvariantMoved : name = "LoopInvariantMoved"; break;
+      case kLoopStoreSunk : name = "LoopStoreSunk"; break;
       case kSelectGenerated : name = "SelectGenerated"; break;
       case kRemovedInstanceOf: name = "RemovedInstanceOf"; break;
       case kInlinedInvokeVirtualOrInterface: name = "InlinedInvokeVirtualOrInterface"; break;
@@ -207,10 +238,20 @@ class OptimizingCompilerStats {
       case kNotInlinedWont: name = "NotInlinedWont"; break;
       case kNotInlinedRecursiveBudget: name = "NotInlinedRecursiveBudget"; break;
       case kNotInlinedProxy: name = "NotInlinedProxy"; break;
+      case kNotInlinedColdCallSite: name = "NotInlinedColdCallSite"; break;
       case kConstructorFenceGeneratedNew: name = "ConstructorFenceGeneratedNew"; break;
       case kConstructorFenceGeneratedFinal: name = "ConstructorFenceGeneratedFinal"; break;
       case kConstructorFenceRemovedLSE: name = "ConstructorFenceRemovedLSE"; break;
       case kConstructorFenceRemovedPFRA: name = "ConstructorFenceRemovedPFRA"; break;
+      case kSpeculationDisabled: name = "SpeculationDisabled"; break;
+      case kColdBranchPruned: name = "ColdBranchPruned"; break;
+      case kGraphColorRegisterAllocation: name = "GraphColorRegisterAllocation"; break;
+      case kRegisterAllocatorSpill: name = "RegisterAllocatorSpill"; break;
+      case kRegisterAllocatorReload: name = "RegisterAllocatorReload"; break;
+      case kStackAllocatedInstance: name = "StackAllocatedInstance"; break;
+      case kStackAllocatedArray: name = "StackAllocatedArray"; break;
+      case kStackAllocatedBytes: name = "StackAllocatedBytes"; break;
+      case kColdBlockSplit: name = "ColdBlockSplit"; break;
 
       case kLastStat:
         LOG(FATAL) << "invalid stat "
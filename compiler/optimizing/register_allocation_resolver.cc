@@ -18,6 +18,7 @@
 
 #include "code_generator.h"
 #include "linear_order.h"
+#include "mirror/object.h"
 #include "ssa_liveness_analysis.h"
 
 namespace art {
@@ -304,6 +305,7 @@ void RegisterAllocationResolver::ConnectSiblings(LiveInterval* interval) {
       case 1: loc = Location::StackSlot(interval->GetParent()->GetSpillSlot()); break;
       case 2: loc = Location::DoubleStackSlot(interval->GetParent()->GetSpillSlot()); break;
       case 4: loc = Location::SIMDStackSlot(interval->GetParent()->GetSpillSlot()); break;
+      case 8: loc = Location::SIMDStackSlot(interval->GetParent()->GetSpillSlot()); break;
       default: LOG(FATAL) << "Unexpected number of spill slots"; UNREACHABLE();
     }
     InsertMoveAfter(interval->GetDefinedBy(), interval->ToLocation(), loc);
@@ -396,6 +398,13 @@ void RegisterAllocationResolver::ConnectSiblings(LiveInterval* interval) {
         if (source.GetKind() == Location::kRegister) {
           locations->SetRegisterBit(source.reg());
         }
+      } else if (interval->GetDefinedBy()->IsStackAllocation()) {
+        // The object is not reachable from the heap, so the GC must visit its class
+        // as a root while the object is live.
+        HStackAllocation* stack_allocation = interval->GetDefinedBy()->AsStackAllocation();
+        size_t class_offset =
+            stack_allocation->GetFrameOffset() + mirror::Object::ClassOffset().SizeValue();
+        safepoint_position->GetLocations()->SetStackBit(class_offset / kVRegSize);
       }
     }
     current = next_sibling;
@@ -467,6 +476,7 @@ void RegisterAllocationResolver::ConnectSplitSiblings(LiveInterval* interval,
         case 1: location_source = Location::StackSlot(parent->GetSpillSlot()); break;
         case 2: location_source = Location::DoubleStackSlot(parent->GetSpillSlot()); break;
         case 4: location_source = Location::SIMDStackSlot(parent->GetSpillSlot()); break;
+        case 8: location_source = Location::SIMDStackSlot(parent->GetSpillSlot()); break;
         default: LOG(FATAL) << "Unexpected number of spill slots"; UNREACHABLE();
       }
     }
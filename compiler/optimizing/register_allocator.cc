@@ -49,6 +49,19 @@ RegisterAllocator* RegisterAllocator::Create(ArenaAllocator* allocator,
   }
 }
 
+RegisterAllocator::Strategy RegisterAllocator::SelectAdaptiveStrategy(
+    size_t number_of_instructions,
+    bool has_loops,
+    bool is_hot,
+    bool has_hotness_information) {
+  if (!has_hotness_information || number_of_instructions > kGraphColorMaxInstructions) {
+    return kRegisterAllocatorDefault;
+  }
+  // Linear scan spills badly under the register pressure of hot loops.
+  bool is_small_loop = has_loops && number_of_instructions <= kGraphColorSmallLoopMaxInstructions;
+  return (is_hot || is_small_loop) ? kRegisterAllocatorGraphColor : kRegisterAllocatorDefault;
+}
+
 bool RegisterAllocator::CanAllocateRegistersFor(const HGraph& graph ATTRIBUTE_UNUSED,
                                                 InstructionSet instruction_set) {
   return instruction_set == kArm
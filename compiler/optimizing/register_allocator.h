@@ -51,6 +51,14 @@ class RegisterAllocator : public ArenaObject<kArenaAllocRegisterAllocator> {
                                    const SsaLivenessAnalysis& analysis,
                                    Strategy strategy = kRegisterAllocatorDefault);
 
+  // Picks the strategy for one method when the register allocator is chosen per method
+  // (--register-allocation-strategy=adaptive). Graph coloring is only picked for hot
+  // methods and small methods with loops, when there is hotness information at all.
+  static Strategy SelectAdaptiveStrategy(size_t number_of_instructions,
+                                         bool has_loops,
+                                         bool is_hot,
+                                         bool has_hotness_information);
+
   virtual ~RegisterAllocator() = default;
 
   // Main entry point for the register allocator. Given the liveness analysis,
@@ -75,6 +83,15 @@ class RegisterAllocator : public ArenaObject<kArenaAllocRegisterAllocator> {
 
   static constexpr const char* kRegisterAllocatorPassName = "register";
 
+  // Methods with more instructions than this always use the default register allocator:
+  // the graph coloring allocator pays for its fewer spills with a compile time that grows
+  // faster with the size of the interference graph.
+  static constexpr size_t kGraphColorMaxInstructions = 4000;
+
+  // Methods with loops and at most this many instructions use the graph coloring allocator
+  // even when they are not known to be hot.
+  static constexpr size_t kGraphColorSmallLoopMaxInstructions = 500;
+
  protected:
   RegisterAllocator(ArenaAllocator* allocator,
                     CodeGenerator* codegen,
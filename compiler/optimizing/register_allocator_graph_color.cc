@@ -38,9 +38,19 @@ static constexpr size_t kMaxNumRegs = 32;
 // intervals are split when coloring fails.
 static constexpr size_t kMaxGraphColoringAttemptsDebug = 100;
 
+// The maximum number of graph coloring attempts that use iterative move coalescing.
+// Coalesced nodes have a higher degree than the nodes they replace, so coalescing can
+// delay finding a colorable graph when register pressure is high. Later attempts rely
+// on interval splitting alone, which bounds the compile time of such methods.
+static constexpr size_t kMaxCoalescingAttempts = 4;
+
 // We always want to avoid spilling inside loops.
 static constexpr size_t kLoopSpillWeightMultiplier = 10;
 
+// When the block frequencies are known, they replace the loop depth heuristic. They
+// are scaled so that blocks executing less often than the entry block still differ.
+static constexpr float kBlockFrequencyWeightMultiplier = 16.0f;
+
 // If we avoid moves in single jump blocks, we can avoid jumps to jumps.
 static constexpr size_t kSingleJumpBlockWeightMultiplier = 2;
 
@@ -83,8 +93,13 @@ static size_t CostForMoveAt(size_t position, const SsaLivenessAnalysis& liveness
   if (block->Dominates(block->GetGraph()->GetExitBlock())) {
     cost *= kDominatesExitBlockWeightMultiplier;
   }
-  for (size_t loop_depth = LoopDepthAt(block); loop_depth > 0; --loop_depth) {
-    cost *= kLoopSpillWeightMultiplier;
+  if (block->GetGraph()->HasBlockFrequencies()) {
+    float weight = block->GetFrequency() * kBlockFrequencyWeightMultiplier;
+    cost *= std::max<size_t>(1u, static_cast<size_t>(weight));
+  } else {
+    for (size_t loop_depth = LoopDepthAt(block); loop_depth > 0; --loop_depth) {
+      cost *= kLoopSpillWeightMultiplier;
+    }
   }
   return cost;
 }
@@ -634,10 +649,10 @@ void RegisterAllocatorGraphColor::AllocateRegisters() {
       iteration.BuildInterferenceGraph(intervals, physical_nodes);
 
       // (3) Add coalesce opportunities.
-      //     If we have tried coloring the graph a suspiciously high number of times, give
-      //     up on move coalescing, just in case the coalescing heuristics are not conservative.
-      //     (This situation will be caught if DCHECKs are turned on.)
-      if (iterative_move_coalescing_ && attempt <= kMaxGraphColoringAttemptsDebug) {
+      //     If we have already failed to color the graph a few times, give up on move
+      //     coalescing, both to bound compile time and in case the coalescing heuristics
+      //     are not conservative.
+      if (iterative_move_coalescing_ && attempt <= kMaxCoalescingAttempts) {
         iteration.FindCoalesceOpportunities();
       }
 
@@ -1598,6 +1613,12 @@ bool ColoringIteration::PrecoloredHeuristic(InterferenceNode* from,
     return false;
   }
 
+  // Arbitrary cap to improve compile time, as in the uncolored heuristic. Each adjacent node
+  // is checked for an interference with `into` below, which is linear in its degree.
+  if (from->GetOutDegree() > 2 * num_regs_) {
+    return false;
+  }
+
   // If all adjacent nodes of `from` are "ok", then we can conservatively merge with `into`.
   // Reasons an adjacent node `adj` can be "ok":
   // (1) If `adj` is low degree, interference with `into` will not affect its existing
@@ -55,6 +55,28 @@ TEST_F(RegisterAllocatorTest, test_name##_GraphColor) {\
   test_name(Strategy::kRegisterAllocatorGraphColor);\
 }
 
+TEST_F(RegisterAllocatorTest, SelectAdaptiveStrategy) {
+  constexpr Strategy kLinearScan = Strategy::kRegisterAllocatorLinearScan;
+  constexpr Strategy kGraphColor = Strategy::kRegisterAllocatorGraphColor;
+  constexpr size_t kSmallLoop = RegisterAllocator::kGraphColorSmallLoopMaxInstructions;
+  constexpr size_t kMax = RegisterAllocator::kGraphColorMaxInstructions;
+
+  // Without hotness information (AOT without a profile), always use the default.
+  EXPECT_EQ(kLinearScan, RegisterAllocator::SelectAdaptiveStrategy(100, true, true, false));
+  EXPECT_EQ(kLinearScan, RegisterAllocator::SelectAdaptiveStrategy(100, true, false, false));
+
+  // Hot methods use graph coloring, up to the size limit.
+  EXPECT_EQ(kGraphColor, RegisterAllocator::SelectAdaptiveStrategy(100, false, true, true));
+  EXPECT_EQ(kGraphColor, RegisterAllocator::SelectAdaptiveStrategy(kMax, false, true, true));
+  EXPECT_EQ(kLinearScan, RegisterAllocator::SelectAdaptiveStrategy(kMax + 1, true, true, true));
+
+  // Methods that are not hot only use graph coloring when they are small and have loops.
+  EXPECT_EQ(kGraphColor, RegisterAllocator::SelectAdaptiveStrategy(kSmallLoop, true, false, true));
+  EXPECT_EQ(kLinearScan,
+            RegisterAllocator::SelectAdaptiveStrategy(kSmallLoop + 1, true, false, true));
+  EXPECT_EQ(kLinearScan, RegisterAllocator::SelectAdaptiveStrategy(100, false, false, true));
+}
+
 static bool Check(const uint16_t* data, Strategy strategy) {
   ArenaPool pool;
   ArenaAllocator allocator(&pool);
@@ -27,6 +27,10 @@
 #include "scheduler_arm.h"
 #endif
 
+#ifdef ART_ENABLE_CODEGEN_x86_64
+#include "scheduler_x86_64.h"
+#endif
+
 namespace art {
 
 void SchedulingGraph::AddDependency(SchedulingNode* node,
@@ -563,7 +567,7 @@ void HScheduler::Schedule(HGraph* graph) {
   }
 
   for (HBasicBlock* block : graph->GetReversePostOrder()) {
-    if (IsSchedulable(block)) {
+    if (IsSchedulable(block) && IsSchedulingProfitable(block)) {
       Schedule(block);
     }
   }
@@ -752,6 +756,11 @@ bool HScheduler::IsSchedulable(const HBasicBlock* block) const {
   if (only_optimize_loop_blocks_ && !block->IsInLoop()) {
     return false;
   }
+  // Scheduling blocks that are (almost) never executed is only wasted compile time.
+  if (block->GetGraph()->HasBlockFrequencies() &&
+      block->GetFrequency() < kMinimumSchedulingFrequency) {
+    return false;
+  }
   if (block->GetTryCatchInformation() != nullptr) {
     // Do not schedule blocks that are part of try-catch.
     // Because scheduler cannot see if catch block has assumptions on the instruction order in
@@ -784,7 +793,8 @@ bool HScheduler::IsSchedulingBarrier(const HInstruction* instr) const {
 
 void HInstructionScheduling::Run(bool only_optimize_loop_blocks,
                                  bool schedule_randomly) {
-#if defined(ART_ENABLE_CODEGEN_arm64) || defined(ART_ENABLE_CODEGEN_arm)
+#if defined(ART_ENABLE_CODEGEN_arm64) || defined(ART_ENABLE_CODEGEN_arm) || \
+    defined(ART_ENABLE_CODEGEN_x86_64)
   // Phase-local allocator that allocates scheduler internal data structures like
   // scheduling nodes, internel nodes map, dependencies, etc.
   ArenaAllocator arena_allocator(graph_->GetArena()->GetArenaPool());
@@ -818,6 +828,14 @@ void HInstructionScheduling::Run(bool only_optimize_loop_blocks,
       scheduler.Schedule(graph_);
       break;
     }
+#endif
+#ifdef ART_ENABLE_CODEGEN_x86_64
+    case kX86_64: {
+      x86_64::HSchedulerX86_64 scheduler(&arena_allocator, selector);
+      scheduler.SetOnlyOptimizeLoopBlocks(only_optimize_loop_blocks);
+      scheduler.Schedule(graph_);
+      break;
+    }
 #endif
     default:
       break;
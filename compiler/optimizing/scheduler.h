@@ -147,6 +147,10 @@ static constexpr bool kDumpDotSchedulingGraphs = false;
 // Typically used as a default instruction latency.
 static constexpr uint32_t kGenericInstructionLatency = 1;
 
+// When block frequencies are known, blocks executing less often than this
+// fraction of the method entries are not scheduled.
+static constexpr float kMinimumSchedulingFrequency = 0.05f;
+
 class HScheduler;
 
 /**
@@ -455,6 +459,11 @@ class HScheduler {
   virtual bool IsSchedulable(const HInstruction* instruction) const;
   bool IsSchedulable(const HBasicBlock* block) const;
 
+  // Returns whether rescheduling a schedulable block is expected to pay off on the target.
+  virtual bool IsSchedulingProfitable(const HBasicBlock* block ATTRIBUTE_UNUSED) const {
+    return true;
+  }
+
   void CalculateLatency(SchedulingNode* node) {
     latency_visitor_->CalculateLatency(node);
     node->SetLatency(latency_visitor_->GetLastVisitedLatency());
@@ -215,12 +215,14 @@ void SchedulingLatencyVisitorARM64::VisitVecReplicateScalar(
   last_visited_latency_ = kArm64SIMDReplicateOpLatency;
 }
 
-void SchedulingLatencyVisitorARM64::VisitVecSetScalars(HVecSetScalars* instr) {
-  LOG(FATAL) << "Unsupported SIMD instruction " << instr->GetId();
+void SchedulingLatencyVisitorARM64::VisitVecSetScalars(HVecSetScalars* instr ATTRIBUTE_UNUSED) {
+  last_visited_latency_ = kArm64SIMDReplicateOpLatency;
 }
 
-void SchedulingLatencyVisitorARM64::VisitVecSumReduce(HVecSumReduce* instr) {
-  LOG(FATAL) << "Unsupported SIMD instruction " << instr->GetId();
+void SchedulingLatencyVisitorARM64::VisitVecReduce(HVecReduce* instr ATTRIBUTE_UNUSED) {
+  // Across-lanes reduction followed by a move to a core register.
+  last_visited_internal_latency_ = kArm64SIMDIntegerOpLatency;
+  last_visited_latency_ = kArm64SIMDIntegerOpLatency;
 }
 
 void SchedulingLatencyVisitorARM64::VisitVecCnv(HVecCnv* instr ATTRIBUTE_UNUSED) {
@@ -312,6 +314,19 @@ void SchedulingLatencyVisitorARM64::VisitVecMultiplyAccumulate(
   last_visited_latency_ = kArm64SIMDMulIntegerLatency;
 }
 
+void SchedulingLatencyVisitorARM64::VisitVecDotProd(HVecDotProd* instr ATTRIBUTE_UNUSED) {
+  // Widening multiply-accumulate of the lower and upper halves.
+  last_visited_internal_latency_ = kArm64SIMDMulIntegerLatency;
+  last_visited_latency_ = kArm64SIMDMulIntegerLatency;
+}
+
+void SchedulingLatencyVisitorARM64::VisitVecSADAccumulate(
+    HVecSADAccumulate* instr ATTRIBUTE_UNUSED) {
+  // Widening absolute difference and accumulate of the lower and upper halves.
+  last_visited_internal_latency_ = kArm64SIMDIntegerOpLatency;
+  last_visited_latency_ = kArm64SIMDIntegerOpLatency;
+}
+
 void SchedulingLatencyVisitorARM64::HandleVecAddress(
     HVecMemoryOperation* instruction,
     size_t size ATTRIBUTE_UNUSED) {
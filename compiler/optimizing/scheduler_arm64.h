@@ -84,7 +84,7 @@ class SchedulingLatencyVisitorARM64 : public SchedulingLatencyVisitor {
   M(TypeConversion       , unused)                   \
   M(VecReplicateScalar   , unused)                   \
   M(VecSetScalars        , unused)                   \
-  M(VecSumReduce         , unused)                   \
+  M(VecReduce            , unused)                   \
   M(VecCnv               , unused)                   \
   M(VecNeg               , unused)                   \
   M(VecAbs               , unused)                   \
@@ -104,6 +104,8 @@ class SchedulingLatencyVisitorARM64 : public SchedulingLatencyVisitor {
   M(VecShr               , unused)                   \
   M(VecUShr              , unused)                   \
   M(VecMultiplyAccumulate, unused)                   \
+  M(VecDotProd           , unused)                   \
+  M(VecSADAccumulate     , unused)                   \
   M(VecLoad              , unused)                   \
   M(VecStore             , unused)
 
@@ -34,6 +34,10 @@
 #include "scheduler_arm.h"
 #endif
 
+#ifdef ART_ENABLE_CODEGEN_x86_64
+#include "scheduler_x86_64.h"
+#endif
+
 namespace art {
 
 // Return all combinations of ISA and code generator that are executable on
@@ -371,6 +375,48 @@ TEST_F(SchedulerTest, ArrayAccessAliasingARM) {
 }
 #endif
 
+#if defined(ART_ENABLE_CODEGEN_x86_64)
+TEST_F(SchedulerTest, DependencyGraphAndSchedulerX86_64) {
+  CriticalPathSchedulingNodeSelector critical_path_selector;
+  x86_64::HSchedulerX86_64 scheduler(&allocator_, &critical_path_selector);
+  TestBuildDependencyGraphAndSchedule(&scheduler);
+}
+
+TEST_F(SchedulerTest, ArrayAccessAliasingX86_64) {
+  CriticalPathSchedulingNodeSelector critical_path_selector;
+  x86_64::HSchedulerX86_64 scheduler(&allocator_, &critical_path_selector);
+  TestDependencyGraphOnAliasingArrayAccesses(&scheduler);
+}
+
+TEST_F(SchedulerTest, LatenciesX86_64) {
+  HInstruction* c1 = graph_->GetIntConstant(1);
+  HInstruction* c2 = graph_->GetIntConstant(10);
+  HInstruction* cf = graph_->GetFloatConstant(2.0f);
+  HInstruction* add = new (&allocator_) HAdd(Primitive::kPrimInt, c1, c2);
+  HInstruction* mul = new (&allocator_) HMul(Primitive::kPrimInt, c1, c2);
+  HInstruction* div = new (&allocator_) HDiv(Primitive::kPrimInt, c1, c2, 0);
+  HInstruction* fdiv = new (&allocator_) HDiv(Primitive::kPrimFloat, cf, cf, 0);
+
+  // Relative latencies reflect the cost model of an out-of-order core. A division by a
+  // constant is a multiplication followed by shifts and adds, so compare the latency of
+  // the whole code sequence, including the internal latency of the instruction.
+  x86_64::SchedulingLatencyVisitorX86_64 visitor;
+  auto total_latency = [&](HInstruction* instruction) {
+    SchedulingNode node(instruction, &allocator_, /*is_scheduling_barrier*/ false);
+    visitor.CalculateLatency(&node);
+    return visitor.GetLastVisitedInternalLatency() + visitor.GetLastVisitedLatency();
+  };
+  uint32_t add_latency = total_latency(add);
+  uint32_t mul_latency = total_latency(mul);
+  uint32_t div_latency = total_latency(div);
+  uint32_t fdiv_latency = total_latency(fdiv);
+  EXPECT_LT(add_latency, mul_latency);
+  EXPECT_LT(mul_latency, div_latency);
+  EXPECT_LT(div_latency, x86_64::kX86_64DivIntegerLatency);
+  EXPECT_LT(mul_latency, fdiv_latency);
+}
+#endif
+
 TEST_F(SchedulerTest, RandomScheduling) {
   //
   // Java source: crafted code to make sure (random) scheduling should get correct result.
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stack_allocation.h"
+
+#include "escape.h"
+#include "mirror/array-inl.h"
+#include "mirror/class-inl.h"
+#include "scoped_thread_state_change-inl.h"
+
+namespace art {
+
+// Returns whether `user` only accesses the contents of the object `allocation`, which
+// is all the code generators support for objects living in the frame.
+static bool IsStackAllocationUse(HInstruction* allocation, HInstruction* user, size_t index) {
+  if (user->IsConstructorFence()) {
+    // Removed along with the allocation.
+    return true;
+  }
+  if (index != 0) {
+    // The object itself is used as a value.
+    return false;
+  }
+  if (user->IsArrayLength()) {
+    return !user->AsArrayLength()->IsStringLength();
+  } else if (user->IsArrayGet()) {
+    return !user->AsArrayGet()->IsStringCharAt();
+  } else if (user->IsArraySet()) {
+    return user->AsArraySet()->GetValue() != allocation;
+  } else if (user->IsInstanceFieldGet()) {
+    // Reference fields, and Object.shadow$_klass_ in particular, are never stack allocated.
+    return user->GetType() != Primitive::kPrimNot;
+  } else if (user->IsInstanceFieldSet()) {
+    return user->AsInstanceFieldSet()->GetFieldType() != Primitive::kPrimNot;
+  }
+  return false;
+}
+
+size_t StackAllocationOptimization::GetStackAllocationSize(HInstruction* allocation) const {
+  DCHECK(allocation->IsNewInstance() || allocation->IsNewArray());
+  if (!allocation->InputAt(0)->IsLoadClass()) {
+    // The class may need to be initialized.
+    return 0;
+  }
+  if (allocation->IsNewInstance() &&
+      allocation->AsNewInstance()->GetEntrypoint() != kQuickAllocObjectInitialized) {
+    // The runtime has to check the class can be instantiated, or to initialize it.
+    return 0;
+  }
+  if (allocation->IsNewArray() && !allocation->AsNewArray()->GetLength()->IsIntConstant()) {
+    return 0;
+  }
+
+  for (const HUseListNode<HInstruction*>& use : allocation->GetUses()) {
+    if (!IsStackAllocationUse(allocation, use.GetUser(), use.GetIndex())) {
+      return 0;
+    }
+  }
+  bool is_singleton;
+  bool is_singleton_and_not_returned;
+  bool is_singleton_and_not_deopt_visible;
+  CalculateEscape(allocation,
+                  /* no_escape */ nullptr,
+                  &is_singleton,
+                  &is_singleton_and_not_returned,
+                  &is_singleton_and_not_deopt_visible);
+  if (!is_singleton_and_not_deopt_visible) {
+    // We do not materialize stack objects when deoptimizing. Keep the heap allocation.
+    return 0;
+  }
+
+  size_t object_size = 0;
+  {
+    ScopedObjectAccess soa(Thread::Current());
+    Handle<mirror::Class> klass = allocation->InputAt(0)->AsLoadClass()->GetClass();
+    if (klass == nullptr) {
+      return 0;
+    }
+    if (allocation->IsNewArray()) {
+      int32_t length = allocation->AsNewArray()->GetLength()->AsIntConstant()->GetValue();
+      if (!klass->IsPrimitiveArray() || length < 0) {
+        return 0;
+      }
+      size_t component_size = klass->GetComponentSize();
+      if (static_cast<size_t>(length) > kMaxObjectSize / component_size) {
+        return 0;
+      }
+      object_size = mirror::Array::DataOffset(component_size).Uint32Value() +
+          static_cast<size_t>(length) * component_size;
+    } else {
+      if (klass->IsVariableSize() || klass->IsFinalizable() || klass->IsStringClass()) {
+        return 0;
+      }
+      // Only the class of the object, stored in its header, is visited by the GC.
+      for (ObjPtr<mirror::Class> k = klass.Get(); k->HasSuperClass(); k = k->GetSuperClass()) {
+        if (k->NumReferenceInstanceFields() != 0) {
+          return 0;
+        }
+      }
+      object_size = klass->GetObjectSize();
+    }
+  }
+  object_size = RoundUp(object_size, kObjectAlignment);
+  return (object_size <= kMaxObjectSize) ? object_size : 0;
+}
+
+void StackAllocationOptimization::AllocateOnStack(HInstruction* allocation, size_t object_size) {
+  bool is_array = allocation->IsNewArray();
+  HStackAllocation* stack_allocation = new (graph_->GetArena()) HStackAllocation(
+      allocation->InputAt(0),
+      object_size,
+      is_array,
+      is_array ? allocation->AsNewArray()->GetLength()->AsIntConstant()->GetValue() : 0,
+      allocation->GetDexPc());
+  allocation->GetBlock()->InsertInstructionBefore(stack_allocation, allocation);
+
+  // Without HDeoptimize uses, debuggable code or catch blocks, the environment of
+  // the compiled code is never read back, so we can drop the object from it.
+  allocation->RemoveEnvironmentUsers();
+  HConstructorFence::RemoveConstructorFences(allocation);
+  allocation->ReplaceWith(stack_allocation);
+  allocation->GetBlock()->RemoveInstruction(allocation);
+
+  MaybeRecordStat(stats_,
+                  is_array ? MethodCompilationStat::kStackAllocatedArray
+                           : MethodCompilationStat::kStackAllocatedInstance);
+  MaybeRecordStat(stats_, MethodCompilationStat::kStackAllocatedBytes, object_size);
+}
+
+void StackAllocationOptimization::Run() {
+  if (instruction_set_ != kArm64 && instruction_set_ != kX86_64) {
+    // The object address is held in a long, which only 64-bit code generators
+    // support in a single register.
+    return;
+  }
+  if (kPoisonHeapReferences) {
+    // The class of the object is visited as a stack reference, which is never poisoned.
+    return;
+  }
+  if (graph_->IsDebuggable() ||
+      graph_->IsCompilingOsr() ||
+      graph_->HasShouldDeoptimizeFlag() ||
+      graph_->HasTryCatch()) {
+    // The environment of any instruction may be read back, or the interpreter
+    // frame may provide the object on entry.
+    return;
+  }
+
+  size_t total_size = 0;
+  for (HBasicBlock* block : graph_->GetReversePostOrder()) {
+    for (HInstructionIterator it(block->GetInstructions()); !it.Done(); it.Advance()) {
+      HInstruction* instruction = it.Current();
+      if (!instruction->IsNewInstance() && !instruction->IsNewArray()) {
+        continue;
+      }
+      size_t object_size = GetStackAllocationSize(instruction);
+      if (object_size != 0 && total_size + object_size <= kMaxTotalSize) {
+        AllocateOnStack(instruction, object_size);
+        total_size += object_size;
+        graph_->SetHasStackAllocations(true);
+      }
+    }
+  }
+}
+
+}  // namespace art
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_COMPILER_OPTIMIZING_STACK_ALLOCATION_H_
+#define ART_COMPILER_OPTIMIZING_STACK_ALLOCATION_H_
+
+#include "arch/instruction_set.h"
+#include "nodes.h"
+#include "optimization.h"
+
+namespace art {
+
+/**
+ * Optimization pass replacing allocations of small objects and arrays that do not
+ * escape the compiled method, but that load-store elimination could not remove, by
+ * HStackAllocation instructions allocating the object in the frame.
+ *
+ * Objects visible to an HDeoptimize instruction are kept on the heap, so that
+ * the interpreter always sees a heap object after deoptimization.
+ */
+class StackAllocationOptimization : public HOptimization {
+ public:
+  StackAllocationOptimization(HGraph* graph,
+                              InstructionSet instruction_set,
+                              OptimizingCompilerStats* stats,
+                              const char* name = kStackAllocationPassName)
+      : HOptimization(graph, name, stats),
+        instruction_set_(instruction_set) {}
+
+  void Run() OVERRIDE;
+
+  static constexpr const char* kStackAllocationPassName = "stack_allocation";
+
+  // Maximum size of a single stack allocated object, including its header.
+  static constexpr size_t kMaxObjectSize = 256;
+
+  // Maximum size of all stack allocated objects of a method.
+  static constexpr size_t kMaxTotalSize = 512;
+
+ private:
+  // Returns the size of the object allocated by `allocation` if it can be
+  // allocated on the stack, or 0 otherwise.
+  size_t GetStackAllocationSize(HInstruction* allocation) const;
+
+  void AllocateOnStack(HInstruction* allocation, size_t object_size);
+
+  const InstructionSet instruction_set_;
+
+  DISALLOW_COPY_AND_ASSIGN(StackAllocationOptimization);
+};
+
+}  // namespace art
+
+#endif  // ART_COMPILER_OPTIMIZING_STACK_ALLOCATION_H_
@@ -19,6 +19,7 @@
 #include "art_method.h"
 #include "base/arena_bit_vector.h"
 #include "stack_map_stream.h"
+#include "utils/swap_space.h"
 
 #include "gtest/gtest.h"
 
@@ -1011,4 +1012,80 @@ TEST(StackMapTest, TestInvokeInfo) {
   EXPECT_EQ(invoke3.GetNativePcOffset(encoding.invoke_info.encoding, kRuntimeISA), 16u);
 }
 
+TEST(StackMapTest, TestDedupeCodeInfos) {
+  ArenaPool pool;
+  ArenaAllocator arena(&pool);
+
+  // Two methods with the same stack mask and Dex register locations at different native PCs.
+  std::vector<uint8_t> code_infos[2];
+  ArenaBitVector sp_mask(&arena, 0, true);
+  sp_mask.SetBit(1);
+  sp_mask.SetBit(27);
+  size_t number_of_dex_registers = 2;
+  for (size_t i = 0; i != 2; ++i) {
+    StackMapStream stream(&arena, kRuntimeISA);
+    stream.BeginStackMapEntry(0, 64 * (i + 1), 0x3, &sp_mask, number_of_dex_registers, 0);
+    stream.AddDexRegisterEntry(Kind::kInStack, 0);         // Short location.
+    stream.AddDexRegisterEntry(Kind::kConstant, -2);       // Large location.
+    stream.EndStackMapEntry();
+    size_t size = stream.PrepareForFillIn();
+    code_infos[i].resize(size);
+    stream.FillInCodeInfo(MemoryRegion(code_infos[i].data(), size));
+  }
+
+  std::vector<uint8_t> output;
+  CodeInfo::Deduper deduper(&output);
+  ASSERT_EQ(0u, deduper.Dedupe(code_infos[0].data()));
+  // The first CodeInfo has nothing to share.
+  ASSERT_EQ(code_infos[0].size(), output.size());
+  ASSERT_EQ(0u, deduper.GetSavedBytes());
+  size_t offset = deduper.Dedupe(code_infos[1].data());
+  ASSERT_EQ(code_infos[0].size(), offset);
+  ASSERT_LT(output.size() - offset, code_infos[1].size());
+  ASSERT_EQ(code_infos[1].size() - (output.size() - offset), deduper.GetSavedBytes());
+
+  CodeInfo code_info(output.data() + offset);
+  CodeInfoEncoding encoding = code_info.ExtractEncoding();
+  ASSERT_TRUE(encoding.dex_register_map.IsShared());
+  ASSERT_TRUE(encoding.location_catalog.IsShared());
+  ASSERT_TRUE(encoding.stack_mask.IsShared());
+  // The native PCs differ, and the register mask is smaller than a reference.
+  ASSERT_FALSE(encoding.stack_map.IsShared());
+  ASSERT_FALSE(encoding.register_mask.IsShared());
+
+  ASSERT_EQ(1u, code_info.GetNumberOfStackMaps(encoding));
+  StackMap stack_map = code_info.GetStackMapAt(0, encoding);
+  ASSERT_EQ(0u, stack_map.GetDexPc(encoding.stack_map.encoding));
+  ASSERT_EQ(128u, stack_map.GetNativePcOffset(encoding.stack_map.encoding, kRuntimeISA));
+  ASSERT_EQ(0x3u, code_info.GetRegisterMaskOf(encoding, stack_map));
+  ASSERT_TRUE(CheckStackMask(code_info, encoding, stack_map, sp_mask));
+
+  ASSERT_EQ(2u, code_info.GetNumberOfLocationCatalogEntries(encoding));
+  ASSERT_EQ(1u + 5u, code_info.GetDexRegisterLocationCatalog(encoding).Size());
+  DexRegisterMap dex_register_map =
+      code_info.GetDexRegisterMapOf(stack_map, encoding, number_of_dex_registers);
+  ASSERT_EQ(2u, dex_register_map.GetNumberOfLiveDexRegisters(number_of_dex_registers));
+  ASSERT_EQ(Kind::kInStack, dex_register_map.GetLocationKind(
+                0, number_of_dex_registers, code_info, encoding));
+  ASSERT_EQ(Kind::kConstant, dex_register_map.GetLocationKind(
+                1, number_of_dex_registers, code_info, encoding));
+  ASSERT_EQ(0, dex_register_map.GetStackOffsetInBytes(
+                0, number_of_dex_registers, code_info, encoding));
+  ASSERT_EQ(-2, dex_register_map.GetConstant(1, number_of_dex_registers, code_info, encoding));
+
+  // An output with another allocator, e.g. the swap space of dex2oat, gets the same data.
+  SwapVector<uint8_t> swap_output(SwapAllocator<uint8_t>(nullptr));
+  CodeInfo::BasicDeduper<SwapAllocator<uint8_t>> swap_deduper(&swap_output);
+  ASSERT_EQ(0u, swap_deduper.Dedupe(code_infos[0].data()));
+  ASSERT_EQ(offset, swap_deduper.Dedupe(code_infos[1].data()));
+  ASSERT_EQ(output, std::vector<uint8_t>(swap_output.begin(), swap_output.end()));
+
+  // Copying a CodeInfo with shared tables to another output makes it self-contained again.
+  std::vector<uint8_t> copy;
+  CodeInfo::Deduper copy_deduper(&copy);
+  ASSERT_EQ(0u, copy_deduper.Dedupe(output.data() + offset));
+  ASSERT_EQ(code_infos[1], copy);
+  ASSERT_EQ(0u, copy_deduper.GetSavedBytes());
+}
+
 }  // namespace art
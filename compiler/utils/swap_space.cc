@@ -63,6 +63,9 @@ inline void SwapSpace::InsertChunk(const SpaceChunk& chunk) {
 SwapSpace::SwapSpace(int fd, size_t initial_size)
     : fd_(fd),
       size_(0),
+      memory_limit_(0u),
+      accessed_since_release_(0u),
+      num_releases_(0u),
       lock_("SwapSpace lock", static_cast<LockLevel>(LockLevel::kDefaultMutexLevel - 1)) {
   // Assume that the file is unlinked.
 
@@ -72,7 +75,7 @@ SwapSpace::SwapSpace(int fd, size_t initial_size)
 SwapSpace::~SwapSpace() {
   // Unmap all mmapped chunks. Nothing should be allocated anymore at
   // this point, so there should be only full size chunks in free_by_start_.
-  for (const SpaceChunk& chunk : free_by_start_) {
+  for (const SpaceChunk& chunk : maps_) {
     if (munmap(chunk.ptr, chunk.size) != 0) {
       PLOG(ERROR) << "Failed to unmap swap space chunk at "
           << static_cast<const void*>(chunk.ptr) << " size=" << chunk.size;
@@ -106,9 +109,45 @@ static size_t CollectFree(const FreeByStartSet& free_by_start, const FreeBySizeS
   return sum1;
 }
 
+void SwapSpace::SetMemoryLimit(size_t memory_limit) {
+  MutexLock lock(Thread::Current(), lock_);
+  memory_limit_ = memory_limit;
+}
+
+void SwapSpace::RecordAccess(size_t size) {
+  MutexLock lock(Thread::Current(), lock_);
+  CountAccess(size);
+}
+
+size_t SwapSpace::GetNumberOfReleases() {
+  MutexLock lock(Thread::Current(), lock_);
+  return num_releases_;
+}
+
+void SwapSpace::CountAccess(size_t size) {
+  if (memory_limit_ == 0u) {
+    return;
+  }
+  accessed_since_release_ += size;
+  if (accessed_since_release_ < memory_limit_) {
+    return;
+  }
+  // The mappings are shared, so dropping the pages does not lose their contents. Dirty pages
+  // stay in the page cache until written back to the file, and are faulted back in on access.
+  for (const SpaceChunk& chunk : maps_) {
+    if (madvise(chunk.ptr, chunk.size, MADV_DONTNEED) != 0) {
+      PLOG(WARNING) << "Failed to release swap space chunk at "
+          << static_cast<const void*>(chunk.ptr) << " size=" << chunk.size;
+    }
+  }
+  accessed_since_release_ = 0u;
+  ++num_releases_;
+}
+
 void* SwapSpace::Alloc(size_t size) {
   MutexLock lock(Thread::Current(), lock_);
   size = RoundUp(size, 8U);
+  CountAccess(size);
 
   // Check the free list for something that fits.
   // TODO: Smarter implementation. Global biggest chunk, ...
@@ -179,6 +218,7 @@ SwapSpace::SpaceChunk SwapSpace::NewFileChunk(size_t min_size) {
   }
   size_ += next_part;
   SpaceChunk new_chunk = {ptr, next_part};
+  maps_.push_back(new_chunk);
   return new_chunk;
 #else
   UNUSED(min_size, kMininumMapSize);
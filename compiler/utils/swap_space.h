@@ -42,6 +42,17 @@ class SwapSpace {
     return size_;
   }
 
+  // Release the mapped pages of the swap file from memory each time `memory_limit` bytes were
+  // allocated or accessed, or never if 0. The data stays in the file and is paged back in when
+  // accessed, so the memory used for the swap space stays bounded by the limit.
+  void SetMemoryLimit(size_t memory_limit) REQUIRES(!lock_);
+
+  // Record that `size` bytes of the swap space were accessed, e.g. to write them out.
+  void RecordAccess(size_t size) REQUIRES(!lock_);
+
+  // Return the number of times the mapped pages were released from memory.
+  size_t GetNumberOfReleases() REQUIRES(!lock_);
+
  private:
   // Chunk of space.
   struct SpaceChunk {
@@ -93,9 +104,20 @@ class SwapSpace {
   void RemoveChunk(FreeBySizeSet::const_iterator free_by_size_pos) REQUIRES(lock_);
   void InsertChunk(const SpaceChunk& chunk) REQUIRES(lock_);
 
+  // Count accessed bytes against the memory limit, releasing the mapped pages if reached.
+  void CountAccess(size_t size) REQUIRES(lock_);
+
   int fd_;
   size_t size_;
 
+  // All mapped chunks of the swap file.
+  std::vector<SpaceChunk> maps_ GUARDED_BY(lock_);
+
+  size_t memory_limit_ GUARDED_BY(lock_);
+  // Bytes allocated or accessed since the mapped pages were last released.
+  size_t accessed_since_release_ GUARDED_BY(lock_);
+  size_t num_releases_ GUARDED_BY(lock_);
+
   // NOTE: Boost.Bimap would be useful for the two following members.
 
   // Map start of a free chunk to its size.
@@ -21,6 +21,7 @@
 #include <sys/types.h>
 
 #include <cstdio>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -80,4 +81,36 @@ TEST_F(SwapSpaceTest, Swap) {
   SwapTest(true);
 }
 
+TEST_F(SwapSpaceTest, MemoryLimit) {
+  ScratchFile scratch;
+  int fd = scratch.GetFd();
+  unlink(scratch.GetFilename().c_str());
+
+  SwapSpace pool(fd, 1 * MB);
+  pool.SetMemoryLimit(256 * KB);
+  SwapAllocator<void> alloc(&pool);
+  constexpr int32_t kNumElements = 64 * KB;
+
+  // Releasing the pages from memory keeps the data in the swap file.
+  std::vector<SwapVector<int32_t>> vectors;
+  for (size_t i = 0; i != 16; ++i) {
+    vectors.emplace_back(alloc);
+    vectors.back().reserve(kNumElements);
+    for (int32_t j = 0; j < kNumElements; ++j) {
+      vectors.back().push_back(j);
+    }
+  }
+  EXPECT_NE(0u, pool.GetNumberOfReleases());
+
+  for (const SwapVector<int32_t>& v : vectors) {
+    pool.RecordAccess(v.size() * sizeof(int32_t));
+    for (int32_t j = 0; j < kNumElements; ++j) {
+      EXPECT_EQ(j, v[j]);
+    }
+  }
+  vectors.clear();
+
+  scratch.Close();
+}
+
 }  // namespace art
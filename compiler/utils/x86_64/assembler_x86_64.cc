@@ -1726,6 +1726,15 @@ void X86_64Assembler::pcmpeqq(XmmRegister dst, XmmRegister src) {
   EmitXmmRegisterOperand(dst.LowBits(), src);
 }
 
+void X86_64Assembler::pmovmskb(CpuRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitOptionalRex32(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0xD7);
+  EmitXmmRegisterOperand(dst.LowBits(), src);
+}
+
 void X86_64Assembler::pcmpgtb(XmmRegister dst, XmmRegister src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0x66);
@@ -1795,6 +1804,18 @@ void X86_64Assembler::pshufd(XmmRegister dst, XmmRegister src, const Immediate&
 }
 
 
+void X86_64Assembler::pclmulqdq(XmmRegister dst, XmmRegister src, const Immediate& imm) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0x66);
+  EmitOptionalRex32(dst, src);
+  EmitUint8(0x0F);
+  EmitUint8(0x3A);
+  EmitUint8(0x44);
+  EmitXmmRegisterOperand(dst.LowBits(), src);
+  EmitUint8(imm.value());
+}
+
+
 void X86_64Assembler::punpcklbw(XmmRegister dst, XmmRegister src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0x66);
@@ -1983,6 +2004,477 @@ void X86_64Assembler::psrldq(XmmRegister reg, const Immediate& shift_count) {
 }
 
 
+// VEX prefix fields for the implied SIMD prefix (pp) and opcode map (mmmmm).
+static constexpr uint8_t kVexPpNone = 0x0;
+static constexpr uint8_t kVexPp66 = 0x1;
+static constexpr uint8_t kVexPpF3 = 0x2;
+static constexpr uint8_t kVexMap0F = 0x1;
+static constexpr uint8_t kVexMap0F38 = 0x2;
+static constexpr uint8_t kVexMap0F3A = 0x3;
+
+
+void X86_64Assembler::vzeroupper() {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVexPrefix(false, false, false, false, kVexMap0F, XmmRegister(XMM0), false, kVexPpNone);
+  EmitUint8(0x77);
+}
+
+
+void X86_64Assembler::vmovaps(XmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x28, dst, XmmRegister(XMM0), src);
+}
+
+void X86_64Assembler::vmovaps(XmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x28, dst, src);
+}
+
+void X86_64Assembler::vmovups(XmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x10, dst, src);
+}
+
+void X86_64Assembler::vmovaps(const Address& dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x29, src, dst);
+}
+
+void X86_64Assembler::vmovups(const Address& dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x11, src, dst);
+}
+
+void X86_64Assembler::vmovapd(XmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x28, dst, src);
+}
+
+void X86_64Assembler::vmovupd(XmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x10, dst, src);
+}
+
+void X86_64Assembler::vmovapd(const Address& dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x29, src, dst);
+}
+
+void X86_64Assembler::vmovupd(const Address& dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x11, src, dst);
+}
+
+void X86_64Assembler::vmovdqa(XmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x6F, dst, src);
+}
+
+void X86_64Assembler::vmovdqu(XmmRegister dst, const Address& src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpF3, kVexMap0F, 0x6F, dst, src);
+}
+
+void X86_64Assembler::vmovdqa(const Address& dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x7F, src, dst);
+}
+
+void X86_64Assembler::vmovdqu(const Address& dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpF3, kVexMap0F, 0x7F, src, dst);
+}
+
+void X86_64Assembler::vmovd(XmmRegister dst, CpuRegister src, bool is64bit) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVexPrefix(dst.NeedsRex(), false, src.NeedsRex(), is64bit, kVexMap0F,
+                XmmRegister(XMM0), false, kVexPp66);
+  EmitUint8(0x6E);
+  EmitOperand(dst.LowBits(), Operand(src));
+}
+
+void X86_64Assembler::vmovd(CpuRegister dst, XmmRegister src, bool is64bit) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVexPrefix(src.NeedsRex(), false, dst.NeedsRex(), is64bit, kVexMap0F,
+                XmmRegister(XMM0), false, kVexPp66);
+  EmitUint8(0x7E);
+  EmitOperand(src.LowBits(), Operand(dst));
+}
+
+void X86_64Assembler::vpbroadcastb(XmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x78, dst, XmmRegister(XMM0), src);
+}
+
+void X86_64Assembler::vpbroadcastw(XmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x79, dst, XmmRegister(XMM0), src);
+}
+
+void X86_64Assembler::vpbroadcastd(XmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x58, dst, XmmRegister(XMM0), src);
+}
+
+void X86_64Assembler::vpbroadcastq(XmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x59, dst, XmmRegister(XMM0), src);
+}
+
+void X86_64Assembler::vbroadcastss(XmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x18, dst, XmmRegister(XMM0), src);
+}
+
+void X86_64Assembler::vbroadcastsd(XmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x19, dst, XmmRegister(XMM0), src);
+}
+
+void X86_64Assembler::vcvtdq2ps(XmmRegister dst, XmmRegister src) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x5B, dst, XmmRegister(XMM0), src);
+}
+
+void X86_64Assembler::vaddps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x58, dst, src1, src2);
+}
+
+void X86_64Assembler::vsubps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x5C, dst, src1, src2);
+}
+
+void X86_64Assembler::vmulps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x59, dst, src1, src2);
+}
+
+void X86_64Assembler::vdivps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x5E, dst, src1, src2);
+}
+
+void X86_64Assembler::vaddpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x58, dst, src1, src2);
+}
+
+void X86_64Assembler::vsubpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x5C, dst, src1, src2);
+}
+
+void X86_64Assembler::vmulpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x59, dst, src1, src2);
+}
+
+void X86_64Assembler::vdivpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x5E, dst, src1, src2);
+}
+
+void X86_64Assembler::vpaddb(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xFC, dst, src1, src2);
+}
+
+void X86_64Assembler::vpsubb(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xF8, dst, src1, src2);
+}
+
+void X86_64Assembler::vpaddw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xFD, dst, src1, src2);
+}
+
+void X86_64Assembler::vpsubw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xF9, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmullw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xD5, dst, src1, src2);
+}
+
+void X86_64Assembler::vpaddd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xFE, dst, src1, src2);
+}
+
+void X86_64Assembler::vpsubd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xFA, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmulld(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x40, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaddwd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xF5, dst, src1, src2);
+}
+
+void X86_64Assembler::vpaddq(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xD4, dst, src1, src2);
+}
+
+void X86_64Assembler::vpsubq(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xFB, dst, src1, src2);
+}
+
+void X86_64Assembler::vxorps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x57, dst, src1, src2);
+}
+
+void X86_64Assembler::vxorpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x57, dst, src1, src2);
+}
+
+void X86_64Assembler::vpxor(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xEF, dst, src1, src2);
+}
+
+void X86_64Assembler::vandps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x54, dst, src1, src2);
+}
+
+void X86_64Assembler::vandpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x54, dst, src1, src2);
+}
+
+void X86_64Assembler::vpand(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xDB, dst, src1, src2);
+}
+
+void X86_64Assembler::vandnps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x55, dst, src1, src2);
+}
+
+void X86_64Assembler::vandnpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x55, dst, src1, src2);
+}
+
+void X86_64Assembler::vpandn(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xDF, dst, src1, src2);
+}
+
+void X86_64Assembler::vorps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x56, dst, src1, src2);
+}
+
+void X86_64Assembler::vorpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x56, dst, src1, src2);
+}
+
+void X86_64Assembler::vpor(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xEB, dst, src1, src2);
+}
+
+void X86_64Assembler::vpavgb(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xE0, dst, src1, src2);
+}
+
+void X86_64Assembler::vpavgw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xE3, dst, src1, src2);
+}
+
+void X86_64Assembler::vpsadbw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xF6, dst, src1, src2);
+}
+
+void X86_64Assembler::vpminsb(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x38, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaxsb(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x3C, dst, src1, src2);
+}
+
+void X86_64Assembler::vpminsw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xEA, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaxsw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xEE, dst, src1, src2);
+}
+
+void X86_64Assembler::vpminsd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x39, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaxsd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x3D, dst, src1, src2);
+}
+
+void X86_64Assembler::vpminub(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xDA, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaxub(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0xDE, dst, src1, src2);
+}
+
+void X86_64Assembler::vpminuw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x3A, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaxuw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x3E, dst, src1, src2);
+}
+
+void X86_64Assembler::vpminud(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x3B, dst, src1, src2);
+}
+
+void X86_64Assembler::vpmaxud(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F38, 0x3F, dst, src1, src2);
+}
+
+void X86_64Assembler::vminps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x5D, dst, src1, src2);
+}
+
+void X86_64Assembler::vmaxps(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPpNone, kVexMap0F, 0x5F, dst, src1, src2);
+}
+
+void X86_64Assembler::vminpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x5D, dst, src1, src2);
+}
+
+void X86_64Assembler::vmaxpd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x5F, dst, src1, src2);
+}
+
+void X86_64Assembler::vpcmpeqb(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x74, dst, src1, src2);
+}
+
+void X86_64Assembler::vpcmpgtd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x66, dst, src1, src2);
+}
+
+void X86_64Assembler::vpunpcklbw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x60, dst, src1, src2);
+}
+
+void X86_64Assembler::vpunpcklwd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x61, dst, src1, src2);
+}
+
+void X86_64Assembler::vpunpckhbw(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x68, dst, src1, src2);
+}
+
+void X86_64Assembler::vpunpckhwd(XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x69, dst, src1, src2);
+}
+
+void X86_64Assembler::vpshufd(XmmRegister dst, XmmRegister src, const Immediate& imm) {
+  DCHECK(imm.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256(kVexPp66, kVexMap0F, 0x70, dst, XmmRegister(XMM0), src);
+  EmitUint8(imm.value());
+}
+
+void X86_64Assembler::vextracti128(XmmRegister dst, XmmRegister src, const Immediate& imm) {
+  DCHECK(imm.is_uint8());
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  // The ymm source is encoded in the ModRM reg field, the xmm destination in the rm field.
+  EmitVexPrefix(src.NeedsRex(), false, dst.NeedsRex(), false, kVexMap0F3A,
+                XmmRegister(XMM0), true, kVexPp66);
+  EmitUint8(0x39);
+  EmitXmmRegisterOperand(src.LowBits(), dst);
+  EmitUint8(imm.value());
+}
+
+void X86_64Assembler::vpsllw(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Shift(0x71, 6, dst, src, shift_count);
+}
+
+void X86_64Assembler::vpslld(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Shift(0x72, 6, dst, src, shift_count);
+}
+
+void X86_64Assembler::vpsllq(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Shift(0x73, 6, dst, src, shift_count);
+}
+
+void X86_64Assembler::vpsraw(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Shift(0x71, 4, dst, src, shift_count);
+}
+
+void X86_64Assembler::vpsrad(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Shift(0x72, 4, dst, src, shift_count);
+}
+
+void X86_64Assembler::vpsrlw(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Shift(0x71, 2, dst, src, shift_count);
+}
+
+void X86_64Assembler::vpsrld(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Shift(0x72, 2, dst, src, shift_count);
+}
+
+void X86_64Assembler::vpsrlq(XmmRegister dst, XmmRegister src, const Immediate& shift_count) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitVex256Shift(0x73, 2, dst, src, shift_count);
+}
+
+
 void X86_64Assembler::fldl(const Address& src) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0xDD);
@@ -2156,6 +2648,14 @@ void X86_64Assembler::xchgl(CpuRegister reg, const Address& address) {
 }
 
 
+void X86_64Assembler::xchgq(CpuRegister reg, const Address& address) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitRex64(reg, address);
+  EmitUint8(0x87);
+  EmitOperand(reg.LowBits(), address);
+}
+
+
 void X86_64Assembler::cmpb(const Address& address, const Immediate& imm) {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   CHECK(imm.is_int32());
@@ -3071,6 +3571,13 @@ void X86_64Assembler::jmp(NearLabel* label) {
 }
 
 
+void X86_64Assembler::rep_movsb() {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0xF3);
+  EmitUint8(0xA4);
+}
+
+
 void X86_64Assembler::rep_movsw() {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0x66);
@@ -3079,6 +3586,21 @@ void X86_64Assembler::rep_movsw() {
 }
 
 
+void X86_64Assembler::rep_movsl() {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0xF3);
+  EmitUint8(0xA5);
+}
+
+
+void X86_64Assembler::rep_movsq() {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitUint8(0xF3);
+  EmitRex64();
+  EmitUint8(0xA5);
+}
+
+
 X86_64Assembler* X86_64Assembler::lock() {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0xF0);
@@ -3104,6 +3626,24 @@ void X86_64Assembler::cmpxchgq(const Address& address, CpuRegister reg) {
 }
 
 
+void X86_64Assembler::xaddl(const Address& address, CpuRegister reg) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitOptionalRex32(reg, address);
+  EmitUint8(0x0F);
+  EmitUint8(0xC1);
+  EmitOperand(reg.LowBits(), address);
+}
+
+
+void X86_64Assembler::xaddq(const Address& address, CpuRegister reg) {
+  AssemblerBuffer::EnsureCapacity ensured(&buffer_);
+  EmitRex64(reg, address);
+  EmitUint8(0x0F);
+  EmitUint8(0xC1);
+  EmitOperand(reg.LowBits(), address);
+}
+
+
 void X86_64Assembler::mfence() {
   AssemblerBuffer::EnsureCapacity ensured(&buffer_);
   EmitUint8(0x0F);
@@ -3595,6 +4135,50 @@ void X86_64Assembler::EmitOptionalByteRegNormalizingRex32(CpuRegister dst, const
   }
 }
 
+void X86_64Assembler::EmitVexPrefix(bool r, bool x, bool b, bool w, uint8_t mmmmm,
+                                    XmmRegister vvvv, bool l, uint8_t pp) {
+  // The register extension bits and the vvvv register are encoded inverted.
+  uint8_t vvvv_l_pp = ((~static_cast<uint8_t>(vvvv.AsFloatRegister()) & 0xF) << 3) |
+                      (l ? 0x04 : 0x00) |
+                      pp;
+  if (!x && !b && !w && mmmmm == kVexMap0F) {
+    EmitUint8(0xC5);
+    EmitUint8((r ? 0x00 : 0x80) | vvvv_l_pp);
+  } else {
+    EmitUint8(0xC4);
+    EmitUint8((r ? 0x00 : 0x80) | (x ? 0x00 : 0x40) | (b ? 0x00 : 0x20) | mmmmm);
+    EmitUint8((w ? 0x80 : 0x00) | vvvv_l_pp);
+  }
+}
+
+void X86_64Assembler::EmitVex256(uint8_t pp, uint8_t mmmmm, uint8_t opcode,
+                                 XmmRegister dst, XmmRegister src1, XmmRegister src2) {
+  EmitVexPrefix(dst.NeedsRex(), false, src2.NeedsRex(), false, mmmmm, src1, true, pp);
+  EmitUint8(opcode);
+  EmitXmmRegisterOperand(dst.LowBits(), src2);
+}
+
+void X86_64Assembler::EmitVex256(uint8_t pp, uint8_t mmmmm, uint8_t opcode,
+                                 XmmRegister reg, const Address& address) {
+  uint8_t rex = address.rex();
+  bool x = (rex & 0x02) != 0;  // REX.00X0
+  bool b = (rex & 0x01) != 0;  // REX.000B
+  EmitVexPrefix(reg.NeedsRex(), x, b, false, mmmmm, XmmRegister(XMM0), true, pp);
+  EmitUint8(opcode);
+  EmitOperand(reg.LowBits(), address);
+}
+
+void X86_64Assembler::EmitVex256Shift(uint8_t opcode, uint8_t rm,
+                                      XmmRegister dst, XmmRegister src,
+                                      const Immediate& shift_count) {
+  DCHECK(shift_count.is_uint8());
+  // The destination is encoded in vvvv, the ModRM reg field holds the opcode extension.
+  EmitVexPrefix(false, false, src.NeedsRex(), false, kVexMap0F, dst, true, kVexPp66);
+  EmitUint8(opcode);
+  EmitXmmRegisterOperand(rm, src);
+  EmitUint8(shift_count.value());
+}
+
 void X86_64Assembler::AddConstantArea() {
   ArrayRef<const int32_t> area = constant_area_.GetBuffer();
   for (size_t i = 0, e = area.size(); i < e; i++) {
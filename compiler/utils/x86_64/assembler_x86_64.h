@@ -560,6 +560,8 @@ class X86_64Assembler FINAL : public Assembler {
   void pcmpeqd(XmmRegister dst, XmmRegister src);
   void pcmpeqq(XmmRegister dst, XmmRegister src);
 
+  void pmovmskb(CpuRegister dst, XmmRegister src);
+
   void pcmpgtb(XmmRegister dst, XmmRegister src);
   void pcmpgtw(XmmRegister dst, XmmRegister src);
   void pcmpgtd(XmmRegister dst, XmmRegister src);
@@ -569,6 +571,8 @@ class X86_64Assembler FINAL : public Assembler {
   void shufps(XmmRegister dst, XmmRegister src, const Immediate& imm);
   void pshufd(XmmRegister dst, XmmRegister src, const Immediate& imm);
 
+  void pclmulqdq(XmmRegister dst, XmmRegister src, const Immediate& imm);  // PCLMULQDQ
+
   void punpcklbw(XmmRegister dst, XmmRegister src);
   void punpcklwd(XmmRegister dst, XmmRegister src);
   void punpckldq(XmmRegister dst, XmmRegister src);
@@ -592,6 +596,130 @@ class X86_64Assembler FINAL : public Assembler {
   void psrlq(XmmRegister reg, const Immediate& shift_count);
   void psrldq(XmmRegister reg, const Immediate& shift_count);
 
+  //
+  // AVX2 instructions. These use the VEX.256 encoding and operate on the full 256-bit
+  // ymm registers that alias the given XmmRegister operands. Binary operations take
+  // a separate, non-destructive first source operand.
+  //
+
+  void vzeroupper();
+
+  void vmovaps(XmmRegister dst, XmmRegister src);     // move
+  void vmovaps(XmmRegister dst, const Address& src);  // load aligned
+  void vmovups(XmmRegister dst, const Address& src);  // load unaligned
+  void vmovaps(const Address& dst, XmmRegister src);  // store aligned
+  void vmovups(const Address& dst, XmmRegister src);  // store unaligned
+
+  void vmovapd(XmmRegister dst, const Address& src);  // load aligned
+  void vmovupd(XmmRegister dst, const Address& src);  // load unaligned
+  void vmovapd(const Address& dst, XmmRegister src);  // store aligned
+  void vmovupd(const Address& dst, XmmRegister src);  // store unaligned
+
+  void vmovdqa(XmmRegister dst, const Address& src);  // load aligned
+  void vmovdqu(XmmRegister dst, const Address& src);  // load unaligned
+  void vmovdqa(const Address& dst, XmmRegister src);  // store aligned
+  void vmovdqu(const Address& dst, XmmRegister src);  // store unaligned
+
+  // VEX.128 moves between general purpose and xmm registers, which zero the rest of the ymm
+  // register. Note: with is64bit, these are formally vmovq.
+  void vmovd(XmmRegister dst, CpuRegister src, bool is64bit);
+  void vmovd(CpuRegister dst, XmmRegister src, bool is64bit);
+
+  void vpbroadcastb(XmmRegister dst, XmmRegister src);
+  void vpbroadcastw(XmmRegister dst, XmmRegister src);
+  void vpbroadcastd(XmmRegister dst, XmmRegister src);
+  void vpbroadcastq(XmmRegister dst, XmmRegister src);
+  void vbroadcastss(XmmRegister dst, XmmRegister src);
+  void vbroadcastsd(XmmRegister dst, XmmRegister src);
+
+  void vcvtdq2ps(XmmRegister dst, XmmRegister src);
+
+  void vaddps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vsubps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vmulps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vdivps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vaddpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vsubpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vmulpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vdivpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpaddb(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpsubb(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpaddw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpsubw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpmullw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpaddd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpsubd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpmulld(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpmaddwd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpaddq(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpsubq(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vxorps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vxorpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpxor(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vandps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vandpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpand(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vandnps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vandnpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpandn(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vorps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vorpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpor(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpavgb(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpavgw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpsadbw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpminsb(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpmaxsb(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpminsw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpmaxsw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpminsd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpmaxsd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpminub(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpmaxub(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpminuw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpmaxuw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpminud(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpmaxud(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vminps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vmaxps(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vminpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vmaxpd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpcmpeqb(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpcmpgtd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpunpcklbw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpunpcklwd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpunpckhbw(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void vpunpckhwd(XmmRegister dst, XmmRegister src1, XmmRegister src2);
+
+  void vpshufd(XmmRegister dst, XmmRegister src, const Immediate& imm);  // within 128-bit halves
+  void vextracti128(XmmRegister dst, XmmRegister src, const Immediate& imm);  // 128-bit half
+
+  void vpsllw(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+  void vpslld(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+  void vpsllq(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+
+  void vpsraw(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+  void vpsrad(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+
+  void vpsrlw(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+  void vpsrld(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+  void vpsrlq(XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+
   void flds(const Address& src);
   void fstps(const Address& dst);
   void fsts(const Address& dst);
@@ -623,6 +751,7 @@ class X86_64Assembler FINAL : public Assembler {
   void xchgl(CpuRegister dst, CpuRegister src);
   void xchgq(CpuRegister dst, CpuRegister src);
   void xchgl(CpuRegister reg, const Address& address);
+  void xchgq(CpuRegister reg, const Address& address);
 
   void cmpb(const Address& address, const Immediate& imm);
   void cmpw(const Address& address, const Immediate& imm);
@@ -752,6 +881,8 @@ class X86_64Assembler FINAL : public Assembler {
   X86_64Assembler* lock();
   void cmpxchgl(const Address& address, CpuRegister reg);
   void cmpxchgq(const Address& address, CpuRegister reg);
+  void xaddl(const Address& address, CpuRegister reg);
+  void xaddq(const Address& address, CpuRegister reg);
 
   void mfence();
 
@@ -792,7 +923,10 @@ class X86_64Assembler FINAL : public Assembler {
   void repe_cmpsw();
   void repe_cmpsl();
   void repe_cmpsq();
+  void rep_movsb();
   void rep_movsw();
+  void rep_movsl();
+  void rep_movsq();
 
   //
   // Macros for High-level operations.
@@ -810,6 +944,14 @@ class X86_64Assembler FINAL : public Assembler {
     lock()->cmpxchgq(address, reg);
   }
 
+  void LockXaddl(const Address& address, CpuRegister reg) {
+    lock()->xaddl(address, reg);
+  }
+
+  void LockXaddq(const Address& address, CpuRegister reg) {
+    lock()->xaddq(address, reg);
+  }
+
   //
   // Misc. functionality
   //
@@ -921,6 +1063,21 @@ class X86_64Assembler FINAL : public Assembler {
   void EmitOptionalByteRegNormalizingRex32(CpuRegister dst, CpuRegister src);
   void EmitOptionalByteRegNormalizingRex32(CpuRegister dst, const Operand& operand);
 
+  // Emit a VEX prefix, using the shorter two-byte form whenever possible. The register
+  // extension bits r, x, b are given in their REX sense (true selects R8-R15/XMM8-XMM15),
+  // `mmmmm` selects the implied opcode map, `vvvv` is the extra source register (XMM0
+  // when unused), `l` selects 256-bit vectors, and `pp` selects the implied SIMD prefix.
+  void EmitVexPrefix(bool r, bool x, bool b, bool w, uint8_t mmmmm,
+                     XmmRegister vvvv, bool l, uint8_t pp);
+
+  // Emit a complete 256-bit VEX instruction with register or memory operands.
+  void EmitVex256(uint8_t pp, uint8_t mmmmm, uint8_t opcode,
+                  XmmRegister dst, XmmRegister src1, XmmRegister src2);
+  void EmitVex256(uint8_t pp, uint8_t mmmmm, uint8_t opcode,
+                  XmmRegister reg, const Address& address);
+  void EmitVex256Shift(uint8_t opcode, uint8_t rm,
+                       XmmRegister dst, XmmRegister src, const Immediate& shift_count);
+
   ConstantArea constant_area_;
 
   DISALLOW_COPY_AND_ASSIGN(X86_64Assembler);
@@ -735,6 +735,54 @@ TEST_F(AssemblerX86_64Test, LockCmpxchgq) {
   DriverStr(expected, "lock_cmpxchg");
 }
 
+TEST_F(AssemblerX86_64Test, LockXaddl) {
+  GetAssembler()->LockXaddl(x86_64::Address(
+      x86_64::CpuRegister(x86_64::RDI), x86_64::CpuRegister(x86_64::RBX), x86_64::TIMES_4, 12),
+      x86_64::CpuRegister(x86_64::RSI));
+  GetAssembler()->LockXaddl(x86_64::Address(
+      x86_64::CpuRegister(x86_64::RDI), x86_64::CpuRegister(x86_64::R9), x86_64::TIMES_4, 12),
+      x86_64::CpuRegister(x86_64::R8));
+  GetAssembler()->LockXaddl(x86_64::Address(
+      x86_64::CpuRegister(x86_64::R13), x86_64::CpuRegister(x86_64::R9), x86_64::TIMES_1, 0),
+      x86_64::CpuRegister(x86_64::RSI));
+  const char* expected =
+    "lock xaddl %ESI, 0xc(%RDI,%RBX,4)\n"
+    "lock xaddl %R8d, 0xc(%RDI,%R9,4)\n"
+    "lock xaddl %ESI, (%R13,%R9,1)\n";
+
+  DriverStr(expected, "lock_xaddl");
+}
+
+TEST_F(AssemblerX86_64Test, LockXaddq) {
+  GetAssembler()->LockXaddq(x86_64::Address(
+      x86_64::CpuRegister(x86_64::RDI), x86_64::CpuRegister(x86_64::RBX), x86_64::TIMES_4, 12),
+      x86_64::CpuRegister(x86_64::RSI));
+  GetAssembler()->LockXaddq(x86_64::Address(
+      x86_64::CpuRegister(x86_64::RDI), x86_64::CpuRegister(x86_64::R9), x86_64::TIMES_4, 12),
+      x86_64::CpuRegister(x86_64::R8));
+  GetAssembler()->LockXaddq(x86_64::Address(
+      x86_64::CpuRegister(x86_64::R13), x86_64::CpuRegister(x86_64::R9), x86_64::TIMES_1, 0),
+      x86_64::CpuRegister(x86_64::RSI));
+  const char* expected =
+    "lock xaddq %RSI, 0xc(%RDI,%RBX,4)\n"
+    "lock xaddq %R8, 0xc(%RDI,%R9,4)\n"
+    "lock xaddq %RSI, (%R13,%R9,1)\n";
+
+  DriverStr(expected, "lock_xaddq");
+}
+
+TEST_F(AssemblerX86_64Test, XchgqAddress) {
+  GetAssembler()->xchgq(x86_64::CpuRegister(x86_64::RSI), x86_64::Address(
+      x86_64::CpuRegister(x86_64::RDI), x86_64::CpuRegister(x86_64::RBX), x86_64::TIMES_4, 12));
+  GetAssembler()->xchgq(x86_64::CpuRegister(x86_64::R8), x86_64::Address(
+      x86_64::CpuRegister(x86_64::R13), x86_64::CpuRegister(x86_64::R9), x86_64::TIMES_1, 0));
+  const char* expected =
+    "xchgq %RSI, 0xc(%RDI,%RBX,4)\n"
+    "xchgq %R8, (%R13,%R9,1)\n";
+
+  DriverStr(expected, "xchgq_address");
+}
+
 TEST_F(AssemblerX86_64Test, Movl) {
   GetAssembler()->movl(x86_64::CpuRegister(x86_64::RAX), x86_64::Address(
       x86_64::CpuRegister(x86_64::RDI), x86_64::CpuRegister(x86_64::RBX), x86_64::TIMES_4, 12));
@@ -968,12 +1016,30 @@ TEST_F(AssemblerX86_64Test, RepneScasw) {
   DriverStr(expected, "repne_scasw");
 }
 
+TEST_F(AssemblerX86_64Test, RepMovsb) {
+  GetAssembler()->rep_movsb();
+  const char* expected = "rep movsb\n";
+  DriverStr(expected, "rep_movsb");
+}
+
 TEST_F(AssemblerX86_64Test, RepMovsw) {
   GetAssembler()->rep_movsw();
   const char* expected = "rep movsw\n";
   DriverStr(expected, "rep_movsw");
 }
 
+TEST_F(AssemblerX86_64Test, RepMovsl) {
+  GetAssembler()->rep_movsl();
+  const char* expected = "rep movsl\n";
+  DriverStr(expected, "rep_movsl");
+}
+
+TEST_F(AssemblerX86_64Test, RepMovsq) {
+  GetAssembler()->rep_movsq();
+  const char* expected = "rep movsq\n";
+  DriverStr(expected, "rep_movsq");
+}
+
 TEST_F(AssemblerX86_64Test, Movsxd) {
   DriverStr(RepeatRr(&x86_64::X86_64Assembler::movsxd, "movsxd %{reg2}, %{reg1}"), "movsxd");
 }
@@ -1421,6 +1487,10 @@ TEST_F(AssemblerX86_64Test, PCmpeqq) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::pcmpeqq, "pcmpeqq %{reg2}, %{reg1}"), "pcmpeqq");
 }
 
+TEST_F(AssemblerX86_64Test, Pmovmskb) {
+  DriverStr(RepeatrF(&x86_64::X86_64Assembler::pmovmskb, "pmovmskb %{reg2}, %{reg1}"), "pmovmskb");
+}
+
 TEST_F(AssemblerX86_64Test, PCmpgtb) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::pcmpgtb, "pcmpgtb %{reg2}, %{reg1}"), "pcmpgtb");
 }
@@ -1449,6 +1519,11 @@ TEST_F(AssemblerX86_64Test, PShufd) {
   DriverStr(RepeatFFI(&x86_64::X86_64Assembler::pshufd, 1, "pshufd ${imm}, %{reg2}, %{reg1}"), "pshufd");
 }
 
+TEST_F(AssemblerX86_64Test, Pclmulqdq) {
+  DriverStr(RepeatFFI(&x86_64::X86_64Assembler::pclmulqdq, 1,
+                      "pclmulqdq ${imm}, %{reg2}, %{reg1}"), "pclmulqdq");
+}
+
 TEST_F(AssemblerX86_64Test, Punpcklbw) {
   DriverStr(RepeatFF(&x86_64::X86_64Assembler::punpcklbw, "punpcklbw %{reg2}, %{reg1}"), "punpcklbw");
 }
@@ -1544,6 +1619,445 @@ TEST_F(AssemblerX86_64Test, Psrldq) {
             "psrldq $2, %xmm15\n", "pslrdqi");
 }
 
+// Renames the xmm registers in the given assembly to the aliasing ymm registers,
+// which are the actual operands of the 256-bit AVX2 instructions.
+static std::string Ymm(std::string str) {
+  for (size_t pos = str.find("%xmm"); pos != std::string::npos; pos = str.find("%xmm", pos)) {
+    str.replace(pos, 4, "%ymm");
+  }
+  return str;
+}
+
+TEST_F(AssemblerX86_64Test, Vzeroupper) {
+  GetAssembler()->vzeroupper();
+  DriverStr("vzeroupper\n", "vzeroupper");
+}
+
+TEST_F(AssemblerX86_64Test, Vmovaps) {
+  DriverStr(Ymm(RepeatFF(&x86_64::X86_64Assembler::vmovaps, "vmovaps %{reg2}, %{reg1}")),
+            "vmovaps");
+}
+
+TEST_F(AssemblerX86_64Test, VmovAddress) {
+  GetAssembler()->vmovaps(x86_64::XmmRegister(x86_64::XMM0), x86_64::Address(
+      x86_64::CpuRegister(x86_64::RSP), 32));
+  GetAssembler()->vmovups(x86_64::XmmRegister(x86_64::XMM9), x86_64::Address(
+      x86_64::CpuRegister(x86_64::R9), x86_64::CpuRegister(x86_64::R12), x86_64::TIMES_4, 12));
+  GetAssembler()->vmovaps(x86_64::Address(
+      x86_64::CpuRegister(x86_64::RSP), 32), x86_64::XmmRegister(x86_64::XMM15));
+  GetAssembler()->vmovups(x86_64::Address(
+      x86_64::CpuRegister(x86_64::RAX), x86_64::CpuRegister(x86_64::R8), x86_64::TIMES_8, 4),
+      x86_64::XmmRegister(x86_64::XMM1));
+  GetAssembler()->vmovapd(x86_64::XmmRegister(x86_64::XMM2), x86_64::Address(
+      x86_64::CpuRegister(x86_64::R13), 64));
+  GetAssembler()->vmovupd(x86_64::Address(
+      x86_64::CpuRegister(x86_64::RDI), x86_64::CpuRegister(x86_64::RSI), x86_64::TIMES_2, 16),
+      x86_64::XmmRegister(x86_64::XMM10));
+  GetAssembler()->vmovdqa(x86_64::XmmRegister(x86_64::XMM11), x86_64::Address(
+      x86_64::CpuRegister(x86_64::RSP), 0));
+  GetAssembler()->vmovdqu(x86_64::Address(
+      x86_64::CpuRegister(x86_64::R10), x86_64::CpuRegister(x86_64::RCX), x86_64::TIMES_1, 12),
+      x86_64::XmmRegister(x86_64::XMM4));
+  const char* expected =
+    "vmovaps 0x20(%RSP), %ymm0\n"
+    "vmovups 0xc(%R9,%R12,4), %ymm9\n"
+    "vmovaps %ymm15, 0x20(%RSP)\n"
+    "vmovups %ymm1, 0x4(%RAX,%R8,8)\n"
+    "vmovapd 0x40(%R13), %ymm2\n"
+    "vmovupd %ymm10, 0x10(%RDI,%RSI,2)\n"
+    "vmovdqa (%RSP), %ymm11\n"
+    "vmovdqu %ymm4, 0xc(%R10,%RCX,1)\n";
+  DriverStr(expected, "vmov_address");
+}
+
+TEST_F(AssemblerX86_64Test, Vmovd) {
+  GetAssembler()->vmovd(x86_64::XmmRegister(x86_64::XMM0), x86_64::CpuRegister(x86_64::RAX),
+                        /*is64bit*/ false);
+  GetAssembler()->vmovd(x86_64::XmmRegister(x86_64::XMM9), x86_64::CpuRegister(x86_64::R10),
+                        /*is64bit*/ false);
+  GetAssembler()->vmovd(x86_64::XmmRegister(x86_64::XMM3), x86_64::CpuRegister(x86_64::R15),
+                        /*is64bit*/ true);
+  GetAssembler()->vmovd(x86_64::CpuRegister(x86_64::RDI), x86_64::XmmRegister(x86_64::XMM14),
+                        /*is64bit*/ false);
+  GetAssembler()->vmovd(x86_64::CpuRegister(x86_64::R8), x86_64::XmmRegister(x86_64::XMM1),
+                        /*is64bit*/ true);
+  const char* expected =
+    "vmovd %eax, %xmm0\n"
+    "vmovd %r10d, %xmm9\n"
+    "vmovq %r15, %xmm3\n"
+    "vmovd %xmm14, %edi\n"
+    "vmovq %xmm1, %r8\n";
+  DriverStr(expected, "vmovd");
+}
+
+TEST_F(AssemblerX86_64Test, Vbroadcast) {
+  GetAssembler()->vpbroadcastb(x86_64::XmmRegister(x86_64::XMM0),
+                               x86_64::XmmRegister(x86_64::XMM15));
+  GetAssembler()->vpbroadcastw(x86_64::XmmRegister(x86_64::XMM9),
+                               x86_64::XmmRegister(x86_64::XMM1));
+  GetAssembler()->vpbroadcastd(x86_64::XmmRegister(x86_64::XMM3),
+                               x86_64::XmmRegister(x86_64::XMM3));
+  GetAssembler()->vpbroadcastq(x86_64::XmmRegister(x86_64::XMM12),
+                               x86_64::XmmRegister(x86_64::XMM8));
+  GetAssembler()->vbroadcastss(x86_64::XmmRegister(x86_64::XMM5),
+                               x86_64::XmmRegister(x86_64::XMM5));
+  GetAssembler()->vbroadcastsd(x86_64::XmmRegister(x86_64::XMM14),
+                               x86_64::XmmRegister(x86_64::XMM2));
+  const char* expected =
+    "vpbroadcastb %xmm15, %ymm0\n"
+    "vpbroadcastw %xmm1, %ymm9\n"
+    "vpbroadcastd %xmm3, %ymm3\n"
+    "vpbroadcastq %xmm8, %ymm12\n"
+    "vbroadcastss %xmm5, %ymm5\n"
+    "vbroadcastsd %xmm2, %ymm14\n";
+  DriverStr(expected, "vbroadcast");
+}
+
+TEST_F(AssemblerX86_64Test, Vcvtdq2ps) {
+  DriverStr(Ymm(RepeatFF(&x86_64::X86_64Assembler::vcvtdq2ps, "vcvtdq2ps %{reg2}, %{reg1}")),
+            "vcvtdq2ps");
+}
+
+TEST_F(AssemblerX86_64Test, Vaddps) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vaddps,
+                          "vaddps %{reg3}, %{reg2}, %{reg1}")), "vaddps");
+}
+
+TEST_F(AssemblerX86_64Test, Vsubps) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vsubps,
+                          "vsubps %{reg3}, %{reg2}, %{reg1}")), "vsubps");
+}
+
+TEST_F(AssemblerX86_64Test, Vmulps) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vmulps,
+                          "vmulps %{reg3}, %{reg2}, %{reg1}")), "vmulps");
+}
+
+TEST_F(AssemblerX86_64Test, Vdivps) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vdivps,
+                          "vdivps %{reg3}, %{reg2}, %{reg1}")), "vdivps");
+}
+
+TEST_F(AssemblerX86_64Test, Vaddpd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vaddpd,
+                          "vaddpd %{reg3}, %{reg2}, %{reg1}")), "vaddpd");
+}
+
+TEST_F(AssemblerX86_64Test, Vsubpd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vsubpd,
+                          "vsubpd %{reg3}, %{reg2}, %{reg1}")), "vsubpd");
+}
+
+TEST_F(AssemblerX86_64Test, Vmulpd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vmulpd,
+                          "vmulpd %{reg3}, %{reg2}, %{reg1}")), "vmulpd");
+}
+
+TEST_F(AssemblerX86_64Test, Vdivpd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vdivpd,
+                          "vdivpd %{reg3}, %{reg2}, %{reg1}")), "vdivpd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpaddb) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpaddb,
+                          "vpaddb %{reg3}, %{reg2}, %{reg1}")), "vpaddb");
+}
+
+TEST_F(AssemblerX86_64Test, Vpsubb) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpsubb,
+                          "vpsubb %{reg3}, %{reg2}, %{reg1}")), "vpsubb");
+}
+
+TEST_F(AssemblerX86_64Test, Vpaddw) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpaddw,
+                          "vpaddw %{reg3}, %{reg2}, %{reg1}")), "vpaddw");
+}
+
+TEST_F(AssemblerX86_64Test, Vpsubw) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpsubw,
+                          "vpsubw %{reg3}, %{reg2}, %{reg1}")), "vpsubw");
+}
+
+TEST_F(AssemblerX86_64Test, Vpmullw) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpmullw,
+                          "vpmullw %{reg3}, %{reg2}, %{reg1}")), "vpmullw");
+}
+
+TEST_F(AssemblerX86_64Test, Vpaddd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpaddd,
+                          "vpaddd %{reg3}, %{reg2}, %{reg1}")), "vpaddd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpsubd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpsubd,
+                          "vpsubd %{reg3}, %{reg2}, %{reg1}")), "vpsubd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpmulld) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpmulld,
+                          "vpmulld %{reg3}, %{reg2}, %{reg1}")), "vpmulld");
+}
+
+TEST_F(AssemblerX86_64Test, Vpmaddwd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpmaddwd,
+                          "vpmaddwd %{reg3}, %{reg2}, %{reg1}")), "vpmaddwd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpaddq) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpaddq,
+                          "vpaddq %{reg3}, %{reg2}, %{reg1}")), "vpaddq");
+}
+
+TEST_F(AssemblerX86_64Test, Vpsubq) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpsubq,
+                          "vpsubq %{reg3}, %{reg2}, %{reg1}")), "vpsubq");
+}
+
+TEST_F(AssemblerX86_64Test, Vxorps) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vxorps,
+                          "vxorps %{reg3}, %{reg2}, %{reg1}")), "vxorps");
+}
+
+TEST_F(AssemblerX86_64Test, Vxorpd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vxorpd,
+                          "vxorpd %{reg3}, %{reg2}, %{reg1}")), "vxorpd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpxor) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpxor,
+                          "vpxor %{reg3}, %{reg2}, %{reg1}")), "vpxor");
+}
+
+TEST_F(AssemblerX86_64Test, Vandps) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vandps,
+                          "vandps %{reg3}, %{reg2}, %{reg1}")), "vandps");
+}
+
+TEST_F(AssemblerX86_64Test, Vandpd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vandpd,
+                          "vandpd %{reg3}, %{reg2}, %{reg1}")), "vandpd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpand) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpand,
+                          "vpand %{reg3}, %{reg2}, %{reg1}")), "vpand");
+}
+
+TEST_F(AssemblerX86_64Test, Vandnps) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vandnps,
+                          "vandnps %{reg3}, %{reg2}, %{reg1}")), "vandnps");
+}
+
+TEST_F(AssemblerX86_64Test, Vandnpd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vandnpd,
+                          "vandnpd %{reg3}, %{reg2}, %{reg1}")), "vandnpd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpandn) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpandn,
+                          "vpandn %{reg3}, %{reg2}, %{reg1}")), "vpandn");
+}
+
+TEST_F(AssemblerX86_64Test, Vorps) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vorps,
+                          "vorps %{reg3}, %{reg2}, %{reg1}")), "vorps");
+}
+
+TEST_F(AssemblerX86_64Test, Vorpd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vorpd,
+                          "vorpd %{reg3}, %{reg2}, %{reg1}")), "vorpd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpor) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpor,
+                          "vpor %{reg3}, %{reg2}, %{reg1}")), "vpor");
+}
+
+TEST_F(AssemblerX86_64Test, Vpavgb) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpavgb,
+                          "vpavgb %{reg3}, %{reg2}, %{reg1}")), "vpavgb");
+}
+
+TEST_F(AssemblerX86_64Test, Vpavgw) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpavgw,
+                          "vpavgw %{reg3}, %{reg2}, %{reg1}")), "vpavgw");
+}
+
+TEST_F(AssemblerX86_64Test, Vpminsb) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpminsb,
+                          "vpminsb %{reg3}, %{reg2}, %{reg1}")), "vpminsb");
+}
+
+TEST_F(AssemblerX86_64Test, Vpmaxsb) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpmaxsb,
+                          "vpmaxsb %{reg3}, %{reg2}, %{reg1}")), "vpmaxsb");
+}
+
+TEST_F(AssemblerX86_64Test, Vpminsw) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpminsw,
+                          "vpminsw %{reg3}, %{reg2}, %{reg1}")), "vpminsw");
+}
+
+TEST_F(AssemblerX86_64Test, Vpmaxsw) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpmaxsw,
+                          "vpmaxsw %{reg3}, %{reg2}, %{reg1}")), "vpmaxsw");
+}
+
+TEST_F(AssemblerX86_64Test, Vpminsd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpminsd,
+                          "vpminsd %{reg3}, %{reg2}, %{reg1}")), "vpminsd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpmaxsd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpmaxsd,
+                          "vpmaxsd %{reg3}, %{reg2}, %{reg1}")), "vpmaxsd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpminub) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpminub,
+                          "vpminub %{reg3}, %{reg2}, %{reg1}")), "vpminub");
+}
+
+TEST_F(AssemblerX86_64Test, Vpmaxub) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpmaxub,
+                          "vpmaxub %{reg3}, %{reg2}, %{reg1}")), "vpmaxub");
+}
+
+TEST_F(AssemblerX86_64Test, Vpminuw) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpminuw,
+                          "vpminuw %{reg3}, %{reg2}, %{reg1}")), "vpminuw");
+}
+
+TEST_F(AssemblerX86_64Test, Vpmaxuw) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpmaxuw,
+                          "vpmaxuw %{reg3}, %{reg2}, %{reg1}")), "vpmaxuw");
+}
+
+TEST_F(AssemblerX86_64Test, Vpminud) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpminud,
+                          "vpminud %{reg3}, %{reg2}, %{reg1}")), "vpminud");
+}
+
+TEST_F(AssemblerX86_64Test, Vpmaxud) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpmaxud,
+                          "vpmaxud %{reg3}, %{reg2}, %{reg1}")), "vpmaxud");
+}
+
+TEST_F(AssemblerX86_64Test, Vminps) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vminps,
+                          "vminps %{reg3}, %{reg2}, %{reg1}")), "vminps");
+}
+
+TEST_F(AssemblerX86_64Test, Vmaxps) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vmaxps,
+                          "vmaxps %{reg3}, %{reg2}, %{reg1}")), "vmaxps");
+}
+
+TEST_F(AssemblerX86_64Test, Vminpd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vminpd,
+                          "vminpd %{reg3}, %{reg2}, %{reg1}")), "vminpd");
+}
+
+TEST_F(AssemblerX86_64Test, Vmaxpd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vmaxpd,
+                          "vmaxpd %{reg3}, %{reg2}, %{reg1}")), "vmaxpd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpcmpeqb) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpcmpeqb,
+                          "vpcmpeqb %{reg3}, %{reg2}, %{reg1}")), "vpcmpeqb");
+}
+
+TEST_F(AssemblerX86_64Test, Vpcmpgtd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpcmpgtd,
+                          "vpcmpgtd %{reg3}, %{reg2}, %{reg1}")), "vpcmpgtd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpsadbw) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpsadbw,
+                          "vpsadbw %{reg3}, %{reg2}, %{reg1}")), "vpsadbw");
+}
+
+TEST_F(AssemblerX86_64Test, Vpunpcklbw) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpunpcklbw,
+                          "vpunpcklbw %{reg3}, %{reg2}, %{reg1}")), "vpunpcklbw");
+}
+
+TEST_F(AssemblerX86_64Test, Vpunpcklwd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpunpcklwd,
+                          "vpunpcklwd %{reg3}, %{reg2}, %{reg1}")), "vpunpcklwd");
+}
+
+TEST_F(AssemblerX86_64Test, Vpunpckhbw) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpunpckhbw,
+                          "vpunpckhbw %{reg3}, %{reg2}, %{reg1}")), "vpunpckhbw");
+}
+
+TEST_F(AssemblerX86_64Test, Vpunpckhwd) {
+  DriverStr(Ymm(RepeatFFF(&x86_64::X86_64Assembler::vpunpckhwd,
+                          "vpunpckhwd %{reg3}, %{reg2}, %{reg1}")), "vpunpckhwd");
+}
+
+TEST_F(AssemblerX86_64Test, Vextracti128) {
+  GetAssembler()->vextracti128(x86_64::XmmRegister(x86_64::XMM0),
+                               x86_64::XmmRegister(x86_64::XMM1),
+                               x86_64::Immediate(1));
+  GetAssembler()->vextracti128(x86_64::XmmRegister(x86_64::XMM8),
+                               x86_64::XmmRegister(x86_64::XMM2),
+                               x86_64::Immediate(1));
+  GetAssembler()->vextracti128(x86_64::XmmRegister(x86_64::XMM3),
+                               x86_64::XmmRegister(x86_64::XMM15),
+                               x86_64::Immediate(0));
+  const char* expected =
+    "vextracti128 $1, %ymm1, %xmm0\n"
+    "vextracti128 $1, %ymm2, %xmm8\n"
+    "vextracti128 $0, %ymm15, %xmm3\n";
+  DriverStr(expected, "vextracti128");
+}
+
+TEST_F(AssemblerX86_64Test, Vpshufd) {
+  GetAssembler()->vpshufd(x86_64::XmmRegister(x86_64::XMM0), x86_64::XmmRegister(x86_64::XMM1),
+                          x86_64::Immediate(0x0E));
+  GetAssembler()->vpshufd(x86_64::XmmRegister(x86_64::XMM12), x86_64::XmmRegister(x86_64::XMM3),
+                          x86_64::Immediate(0x01));
+  GetAssembler()->vpshufd(x86_64::XmmRegister(x86_64::XMM5), x86_64::XmmRegister(x86_64::XMM13),
+                          x86_64::Immediate(0x1B));
+  const char* expected =
+    "vpshufd $0xe, %ymm1, %ymm0\n"
+    "vpshufd $0x1, %ymm3, %ymm12\n"
+    "vpshufd $0x1b, %ymm13, %ymm5\n";
+  DriverStr(expected, "vpshufd");
+}
+
+TEST_F(AssemblerX86_64Test, VshiftImm) {
+  GetAssembler()->vpsllw(x86_64::XmmRegister(x86_64::XMM0), x86_64::XmmRegister(x86_64::XMM15),
+                         x86_64::Immediate(1));
+  GetAssembler()->vpslld(x86_64::XmmRegister(x86_64::XMM15), x86_64::XmmRegister(x86_64::XMM0),
+                         x86_64::Immediate(2));
+  GetAssembler()->vpsllq(x86_64::XmmRegister(x86_64::XMM3), x86_64::XmmRegister(x86_64::XMM3),
+                         x86_64::Immediate(63));
+  GetAssembler()->vpsraw(x86_64::XmmRegister(x86_64::XMM8), x86_64::XmmRegister(x86_64::XMM9),
+                         x86_64::Immediate(15));
+  GetAssembler()->vpsrad(x86_64::XmmRegister(x86_64::XMM1), x86_64::XmmRegister(x86_64::XMM2),
+                         x86_64::Immediate(31));
+  GetAssembler()->vpsrlw(x86_64::XmmRegister(x86_64::XMM10), x86_64::XmmRegister(x86_64::XMM4),
+                         x86_64::Immediate(3));
+  GetAssembler()->vpsrld(x86_64::XmmRegister(x86_64::XMM5), x86_64::XmmRegister(x86_64::XMM11),
+                         x86_64::Immediate(4));
+  GetAssembler()->vpsrlq(x86_64::XmmRegister(x86_64::XMM12), x86_64::XmmRegister(x86_64::XMM13),
+                         x86_64::Immediate(5));
+  const char* expected =
+    "vpsllw $1, %ymm15, %ymm0\n"
+    "vpslld $2, %ymm0, %ymm15\n"
+    "vpsllq $63, %ymm3, %ymm3\n"
+    "vpsraw $15, %ymm9, %ymm8\n"
+    "vpsrad $31, %ymm2, %ymm1\n"
+    "vpsrlw $3, %ymm4, %ymm10\n"
+    "vpsrld $4, %ymm11, %ymm5\n"
+    "vpsrlq $5, %ymm13, %ymm12\n";
+  DriverStr(expected, "vshift_imm");
+}
+
 TEST_F(AssemblerX86_64Test, UcomissAddress) {
   GetAssembler()->ucomiss(x86_64::XmmRegister(x86_64::XMM0), x86_64::Address(
       x86_64::CpuRegister(x86_64::RDI), x86_64::CpuRegister(x86_64::RBX), x86_64::TIMES_4, 12));
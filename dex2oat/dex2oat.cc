@@ -58,8 +58,10 @@
 #include "dex/verification_results.h"
 #include "dex2oat_return_codes.h"
 #include "dex_file-inl.h"
+#include "driver/compilation_cache.h"
 #include "driver/compiler_driver.h"
 #include "driver/compiler_options.h"
+#include "driver/incremental_compilation.h"
 #include "elf_file.h"
 #include "elf_writer.h"
 #include "elf_writer_quick.h"
@@ -242,6 +244,20 @@ NO_RETURN static void Usage(const char* fmt, ...) {
   UsageError("  --oat-symbols=<file.oat>: specifies an oat output destination with full symbols.");
   UsageError("      Example: --oat-symbols=/symbols/system/framework/boot.oat");
   UsageError("");
+  UsageError("  --input-oat=<file.oat>: specifies an oat file of a previous compilation of the");
+  UsageError("      dex files, compiled with --record-incremental-info, whose code is reused for");
+  UsageError("      the methods that did not change. Its vdex file must be next to it.");
+  UsageError("      Example: --input-oat=/data/app/oat/arm64/base.odex");
+  UsageError("");
+  UsageError("  --record-incremental-info: record in the oat file what the code of each method");
+  UsageError("      depends on, for reusing it with --input-oat in a later compilation.");
+  UsageError("");
+  UsageError("  --compilation-cache-dir=<directory>: specifies a directory caching compiled code");
+  UsageError("      across dex2oat invocations, keyed by the contents of the dex files and the");
+  UsageError("      compiler options. The directory must exist and may be shared by concurrent");
+  UsageError("      dex2oat processes. Not used for images or with a profile.");
+  UsageError("      Example: --compilation-cache-dir=/data/local/tmp/dex2oat-cache");
+  UsageError("");
   UsageError("  --image=<file.art>: specifies an output image filename.");
   UsageError("      Example: --image=/system/framework/boot.art");
   UsageError("");
@@ -333,6 +349,13 @@ NO_RETURN static void Usage(const char* fmt, ...) {
              CompilerOptions::kDefaultInlineMaxCodeUnits);
   UsageError("      Default: %d", CompilerOptions::kDefaultInlineMaxCodeUnits);
   UsageError("");
+  UsageError("  --loop-unroll-max-instructions=<instruction-count>: the maximum number of");
+  UsageError("      instructions that the body of an unrolled loop may have. A zero value will");
+  UsageError("      disable loop unrolling. Honored only by Optimizing.");
+  UsageError("      Example: --loop-unroll-max-instructions=%d",
+             CompilerOptions::kDefaultLoopUnrollMaxInstructions);
+  UsageError("      Default: %d", CompilerOptions::kDefaultLoopUnrollMaxInstructions);
+  UsageError("");
   UsageError("  --dump-timing: display a breakdown of where time was spent");
   UsageError("");
   UsageError("  -g");
@@ -384,6 +407,12 @@ NO_RETURN static void Usage(const char* fmt, ...) {
   UsageError("      Example: --swap-dex-count-threshold=10");
   UsageError("      Default: %zu", kDefaultMinDexFilesForSwap);
   UsageError("");
+  UsageError("  --swap-memory-limit=<size>: bounds the memory used for the swap file, by");
+  UsageError("      releasing its pages each time <size> bytes of compiled code and data were");
+  UsageError("      written to it or read back from it. Implies the use of swap when a swap");
+  UsageError("      file is given, regardless of the dex file thresholds.");
+  UsageError("      Example: --swap-memory-limit=33554432");
+  UsageError("");
   UsageError("  --very-large-app-threshold=<size>: specifies the minimum total dex file size in");
   UsageError("      bytes to consider the input \"very large\" and reduce compilation done.");
   UsageError("      Example: --very-large-app-threshold=100000000");
@@ -589,6 +618,7 @@ class Dex2Oat FINAL {
       input_vdex_fd_(-1),
       output_vdex_fd_(-1),
       input_vdex_file_(nullptr),
+      record_incremental_info_(false),
       zip_fd_(-1),
       image_base_(0U),
       image_classes_zip_filename_(nullptr),
@@ -815,6 +845,14 @@ class Dex2Oat FINAL {
       Usage("--output-vdex-fd should not be used with --image");
     }
 
+    if ((!input_oat_.empty() || record_incremental_info_) && IsBootImage()) {
+      Usage("--input-oat and --record-incremental-info should not be used with --image");
+    }
+
+    if (!compilation_cache_dir_.empty() && IsBootImage()) {
+      Usage("--compilation-cache-dir should not be used with --image");
+    }
+
     if (oat_fd_ != -1 && !image_filenames_.empty()) {
       Usage("--oat-fd should not be used with --image");
     }
@@ -1207,6 +1245,12 @@ class Dex2Oat FINAL {
         ParseInputVdexFd(option);
       } else if (option.starts_with("--input-vdex=")) {
         input_vdex_ = option.substr(strlen("--input-vdex=")).data();
+      } else if (option.starts_with("--input-oat=")) {
+        input_oat_ = option.substr(strlen("--input-oat=")).data();
+      } else if (option == "--record-incremental-info") {
+        record_incremental_info_ = true;
+      } else if (option.starts_with("--compilation-cache-dir=")) {
+        compilation_cache_dir_ = option.substr(strlen("--compilation-cache-dir=")).data();
       } else if (option.starts_with("--output-vdex=")) {
         output_vdex_ = option.substr(strlen("--output-vdex=")).data();
       } else if (option.starts_with("--output-vdex-fd=")) {
@@ -1298,6 +1342,8 @@ class Dex2Oat FINAL {
                         "--swap-dex-count-threshold",
                         &min_dex_files_for_swap_,
                         Usage);
+      } else if (option.starts_with("--swap-memory-limit=")) {
+        ParseUintOption(option, "--swap-memory-limit", &swap_memory_limit_, Usage);
       } else if (option.starts_with("--very-large-app-threshold=")) {
         ParseUintOption(option,
                         "--very-large-app-threshold",
@@ -1865,6 +1911,7 @@ class Dex2Oat FINAL {
                                      swap_fd_,
                                      profile_compilation_info_.get()));
     driver_->SetDexFilesForOatFile(dex_files_);
+    driver_->GetCompiledMethodStorage()->SetSwapMemoryLimit(swap_memory_limit_);
 
     const bool compile_individually = ShouldCompileDexFilesIndividually();
     if (compile_individually) {
@@ -1891,6 +1938,27 @@ class Dex2Oat FINAL {
       // the results for all the dex files, not just the results for the current dex file.
       callbacks_->SetVerifierDeps(new verifier::VerifierDeps(dex_files_));
     }
+
+    // Set up the reuse of compiled code, once the dex files are unquickened.
+    if (!input_oat_.empty() || record_incremental_info_) {
+      incremental_compilation_.reset(new IncrementalCompilation(driver_.get(), dex_files_));
+      std::string error_msg;
+      if (!input_oat_.empty() &&
+          !incremental_compilation_->OpenPreviousOatFile(input_oat_,
+                                                         *key_value_store_,
+                                                         image_file_location_oat_checksum_,
+                                                         &error_msg)) {
+        LOG(WARNING) << "Not reusing the code of " << input_oat_ << ": " << error_msg;
+      }
+      driver_->SetIncrementalCompilation(incremental_compilation_.get());
+    }
+    if (!compilation_cache_dir_.empty()) {
+      compilation_cache_.reset(new CompilationCache(driver_.get(),
+                                                    compilation_cache_dir_,
+                                                    image_file_location_oat_checksum_));
+      driver_->SetCompilationCache(compilation_cache_.get());
+    }
+
     // Invoke the compilation.
     if (compile_individually) {
       CompileDexFilesIndividually();
@@ -2156,6 +2224,20 @@ class Dex2Oat FINAL {
         elf_writer->WriteDynamicSection();
         elf_writer->WriteDebugInfo(oat_writer->GetMethodDebugInfo());
 
+        if (incremental_compilation_ != nullptr) {
+          LOG(INFO) << "Reused the code of "
+                    << incremental_compilation_->GetNumberOfReusedMethods() << " methods";
+        }
+        if (compilation_cache_ != nullptr) {
+          LOG(INFO) << "Found " << compilation_cache_->GetNumberOfHits()
+                    << " methods in the compilation cache";
+        }
+        if (record_incremental_info_) {
+          std::vector<uint8_t> incremental_info;
+          incremental_compilation_->Encode(&incremental_info);
+          elf_writer->WriteIncrementalInfo(incremental_info);
+        }
+
         if (!elf_writer->End()) {
           LOG(ERROR) << "Failed to write ELF file " << oat_file->GetPath();
           return false;
@@ -2344,6 +2426,10 @@ class Dex2Oat FINAL {
       // Don't use swap, we know generation should succeed, and we don't want to slow it down.
       return false;
     }
+    if (swap_memory_limit_ != 0u) {
+      // The memory is explicitly bounded, only possible with swap.
+      return true;
+    }
     if (dex_files.size() < min_dex_files_for_swap_) {
       // If there are less dex files than the threshold, assume it's gonna be fine.
       return false;
@@ -2873,6 +2959,11 @@ class Dex2Oat FINAL {
   std::string input_vdex_;
   std::string output_vdex_;
   std::unique_ptr<VdexFile> input_vdex_file_;
+  std::string input_oat_;
+  bool record_incremental_info_;
+  std::unique_ptr<IncrementalCompilation> incremental_compilation_;
+  std::string compilation_cache_dir_;
+  std::unique_ptr<CompilationCache> compilation_cache_;
   std::vector<const char*> dex_filenames_;
   std::vector<const char*> dex_locations_;
   int zip_fd_;
@@ -2925,6 +3016,7 @@ class Dex2Oat FINAL {
   size_t min_dex_files_for_swap_ = kDefaultMinDexFilesForSwap;
   size_t min_dex_file_cumulative_size_for_swap_ = kDefaultMinDexFileCumulativeSizeForSwap;
   size_t very_large_threshold_ = std::numeric_limits<size_t>::max();
+  size_t swap_memory_limit_ = 0u;
   std::string app_image_file_name_;
   int app_image_fd_;
   std::string profile_file_;
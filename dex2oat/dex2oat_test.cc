@@ -19,6 +19,8 @@
 #include <string>
 #include <vector>
 
+#include <dirent.h>
+#include <sys/stat.h>
 #include <sys/wait.h>
 #include <unistd.h>
 
@@ -33,6 +35,8 @@
 #include "dex2oat_environment_test.h"
 #include "dex2oat_return_codes.h"
 #include "dex_file-inl.h"
+#include "driver/incremental_compilation.h"
+#include "elf_file.h"
 #include "jit/profile_compilation_info.h"
 #include "oat.h"
 #include "oat_file.h"
@@ -386,6 +390,42 @@ class Dex2oatSwapUseTest : public Dex2oatSwapTest {
     }
   }
 
+  size_t ParseSwapReleases() {
+    std::regex swap_releases_regex("dex2oat took[^\\n]+swap releases=([0-9]+)");
+    std::smatch swap_releases_match;
+    bool found = std::regex_search(output_, swap_releases_match, swap_releases_regex);
+    if (!found) {
+      EXPECT_TRUE(found) << output_;
+      return 0;
+    }
+
+    std::istringstream stream(swap_releases_match[1].str());
+    size_t value;
+    stream >> value;
+
+    return value;
+  }
+
+  size_t ParsePeakRss() {
+    std::regex peak_rss_regex("dex2oat took.*peak rss=[^ ]+ \\(([0-9]+)B\\)");
+    std::smatch peak_rss_match;
+    bool found = std::regex_search(output_, peak_rss_match, peak_rss_regex);
+    if (!found) {
+      EXPECT_TRUE(found);
+      return 0;
+    }
+    if (peak_rss_match.size() != 2U) {
+      EXPECT_EQ(peak_rss_match.size(), 2U);
+      return 0;
+    }
+
+    std::istringstream stream(peak_rss_match[1].str());
+    size_t value;
+    stream >> value;
+
+    return value;
+  }
+
  private:
   size_t ParseNativeAlloc() {
     std::regex native_alloc_regex("dex2oat took.*native alloc=[^ ]+ \\(([0-9]+)B\\)");
@@ -471,6 +511,40 @@ TEST_F(Dex2oatSwapUseTest, CheckSwapUsage) {
   }
 }
 
+TEST_F(Dex2oatSwapUseTest, CheckSwapMemoryLimit) {
+  // Memory usage isn't correctly tracked under sanitization.
+  TEST_DISABLED_FOR_MEMORY_TOOL_ASAN();
+
+  RunTest(false /* use_fd */,
+          true /* expect_use */,
+          { "--swap-dex-size-threshold=0", "--swap-dex-count-threshold=0" });
+  if (kIsTargetBuild) {
+    // The output goes to the logcat, where we cannot parse the memory use.
+    return;
+  }
+  size_t peak_rss_1 = ParsePeakRss();
+
+  // Release the pages of the swap file on each allocation and access. The limit implies the
+  // use of swap, and the compiled code must be read back correctly from the swap file.
+  output_ = "";
+  RunTest(false /* use_fd */, true /* expect_use */, { "--swap-memory-limit=1" });
+  size_t peak_rss_2 = ParsePeakRss();
+  size_t num_releases_2 = ParseSwapReleases();
+  std::string output_2 = output_;
+
+  // The swap space is released on each access, and the accesses only depend on the compiled
+  // code, so the count does not change from one compilation to the next. The peak RSS depends
+  // on the machine and is only logged.
+  output_ = "";
+  RunTest(false /* use_fd */, true /* expect_use */, { "--swap-memory-limit=1" });
+  size_t num_releases_3 = ParseSwapReleases();
+
+  EXPECT_NE(num_releases_2, 0u) << output_2;
+  EXPECT_EQ(num_releases_2, num_releases_3) << output_2 << std::endl << output_;
+  LOG(INFO) << "Peak RSS without swap memory limit: " << peak_rss_1
+            << "B, with a limit of 1 byte: " << peak_rss_2 << "B";
+}
+
 class Dex2oatVeryLargeTest : public Dex2oatTest {
  protected:
   void CheckFilter(CompilerFilter::Filter input ATTRIBUTE_UNUSED,
@@ -1366,4 +1440,373 @@ TEST_F(Dex2oatTest, LayoutSections) {
   }
 }
 
+class Dex2oatCodeReuseTest : public Dex2oatTest {
+ protected:
+  std::unique_ptr<OatFile> OpenOdex(const std::string& odex_location,
+                                    const std::string& dex_location) {
+    std::string error_msg;
+    std::unique_ptr<OatFile> odex_file(OatFile::Open(odex_location.c_str(),
+                                                     odex_location.c_str(),
+                                                     nullptr,
+                                                     nullptr,
+                                                     false,
+                                                     /*low_4gb*/false,
+                                                     dex_location.c_str(),
+                                                     &error_msg));
+    EXPECT_TRUE(odex_file != nullptr) << error_msg;
+    return odex_file;
+  }
+
+  // Calls `visitor(dex_file, method_idx, first_method, second_method)` for each method of the
+  // classes of two oat files compiled from one dex file, or from versions of it that differ only
+  // in their code items.
+  template <typename Visitor>
+  void VisitMethods(const OatFile& first_odex, const OatFile& second_odex, const Visitor& visitor) {
+    ASSERT_EQ(1u, first_odex.GetOatDexFiles().size());
+    ASSERT_EQ(1u, second_odex.GetOatDexFiles().size());
+    const OatDexFile* first_oat_dex = first_odex.GetOatDexFiles()[0];
+    const OatDexFile* second_oat_dex = second_odex.GetOatDexFiles()[0];
+    std::string error_msg;
+    std::unique_ptr<const DexFile> dex_file(first_oat_dex->OpenDexFile(&error_msg));
+    ASSERT_TRUE(dex_file != nullptr) << error_msg;
+    for (uint32_t i = 0; i < dex_file->NumClassDefs(); ++i) {
+      const uint8_t* class_data = dex_file->GetClassData(dex_file->GetClassDef(i));
+      if (class_data == nullptr) {
+        continue;
+      }
+      OatFile::OatClass first_class = first_oat_dex->GetOatClass(i);
+      OatFile::OatClass second_class = second_oat_dex->GetOatClass(i);
+      ClassDataItemIterator it(*dex_file, class_data);
+      it.SkipAllFields();
+      for (uint32_t method_index = 0; it.HasNext(); it.Next(), ++method_index) {
+        visitor(*dex_file,
+                it.GetMemberIndex(),
+                first_class.GetOatMethod(method_index),
+                second_class.GetOatMethod(method_index));
+      }
+    }
+  }
+
+  // Checks that both oat files have the same code for each method, and returns the number of
+  // methods with code.
+  size_t CheckSameCode(const OatFile& first_odex, const OatFile& second_odex) {
+    size_t num_compiled_methods = 0u;
+    VisitMethods(first_odex,
+                 second_odex,
+                 [&](const DexFile& dex_file,
+                     uint32_t method_idx,
+                     const OatFile::OatMethod& first_method,
+                     const OatFile::OatMethod& second_method) {
+      EXPECT_TRUE(HasSameCode(first_method, second_method)) << dex_file.PrettyMethod(method_idx);
+      if (first_method.GetQuickCodeSize() != 0u) {
+        ++num_compiled_methods;
+      }
+    });
+    return num_compiled_methods;
+  }
+
+  static bool HasSameCode(const OatFile::OatMethod& first_method,
+                          const OatFile::OatMethod& second_method) {
+    return first_method.GetQuickCodeSize() == second_method.GetQuickCodeSize() &&
+        (first_method.GetQuickCodeSize() == 0u ||
+         memcmp(first_method.GetQuickCode(),
+                second_method.GetQuickCode(),
+                first_method.GetQuickCodeSize()) == 0);
+  }
+
+  // Returns the number captured by `pattern` in the dex2oat output, or -1 if it is missing.
+  int64_t ParseLoggedCount(const char* pattern) {
+    std::regex count_regex(pattern);
+    std::smatch count_match;
+    bool found = std::regex_search(output_, count_match, count_regex);
+    if (!found) {
+      EXPECT_TRUE(found) << pattern << std::endl << output_;
+      return -1;
+    }
+    std::istringstream stream(count_match[1].str());
+    int64_t value;
+    stream >> value;
+    return value;
+  }
+
+  int64_t ParseReusedMethods() {
+    return ParseLoggedCount("Reused the code of ([0-9]+) methods");
+  }
+
+  int64_t ParseCacheHits() {
+    return ParseLoggedCount("Found ([0-9]+) methods in the compilation cache");
+  }
+
+  // Writes the dex file of ManyMethods to `dex_location`, with ManyMethods.Print6 reading
+  // Strings.msg7 instead of Strings.msg4. Only the code item of Print6 changes, the ids and
+  // the other classes are the same.
+  void WriteModifiedManyMethods(const std::string& dex_location) {
+    std::string jar_location = GetTestDexFileName("ManyMethods");
+    std::string error_msg;
+    std::vector<std::unique_ptr<const DexFile>> dex_files;
+    ASSERT_TRUE(DexFile::Open(jar_location.c_str(),
+                              jar_location,
+                              /* verify_checksum */ true,
+                              &error_msg,
+                              &dex_files)) << error_msg;
+    ASSERT_EQ(1u, dex_files.size());
+    std::vector<uint8_t> data(dex_files[0]->Begin(),
+                              dex_files[0]->Begin() + dex_files[0]->Size());
+    std::unique_ptr<const DexFile> dex_file(DexFile::Open(data.data(),
+                                                          data.size(),
+                                                          dex_location,
+                                                          dex_files[0]->GetLocationChecksum(),
+                                                          /* oat_dex_file */ nullptr,
+                                                          /* verify */ false,
+                                                          /* verify_checksum */ false,
+                                                          &error_msg));
+    ASSERT_TRUE(dex_file != nullptr) << error_msg;
+
+    const DexFile::TypeId* class_type = dex_file->FindTypeId("LManyMethods;");
+    const DexFile::TypeId* strings_type = dex_file->FindTypeId("LManyMethods$Strings;");
+    const DexFile::TypeId* string_type = dex_file->FindTypeId("Ljava/lang/String;");
+    const DexFile::StringId* msg4_name = dex_file->FindStringId("msg4");
+    const DexFile::StringId* msg7_name = dex_file->FindStringId("msg7");
+    ASSERT_TRUE(class_type != nullptr && strings_type != nullptr && string_type != nullptr);
+    ASSERT_TRUE(msg4_name != nullptr && msg7_name != nullptr);
+    const DexFile::FieldId* msg4 = dex_file->FindFieldId(*strings_type, *msg4_name, *string_type);
+    const DexFile::FieldId* msg7 = dex_file->FindFieldId(*strings_type, *msg7_name, *string_type);
+    ASSERT_TRUE(msg4 != nullptr && msg7 != nullptr);
+    const DexFile::ClassDef* class_def =
+        dex_file->FindClassDef(dex_file->GetIndexForTypeId(*class_type));
+    ASSERT_TRUE(class_def != nullptr);
+
+    size_t num_changes = 0u;
+    for (ClassDataItemIterator it(*dex_file, dex_file->GetClassData(*class_def));
+         it.HasNext();
+         it.Next()) {
+      if (!it.IsAtMethod() ||
+          strcmp(dex_file->GetMethodName(dex_file->GetMethodId(it.GetMemberIndex())),
+                 "Print6") != 0) {
+        continue;
+      }
+      for (CodeItemIterator code_it(*it.GetMethodCodeItem()); !code_it.Done(); code_it.Advance()) {
+        Instruction* inst = const_cast<Instruction*>(&code_it.CurrentInstruction());
+        if (inst->Opcode() == Instruction::SGET_OBJECT &&
+            inst->VRegB_21c() == dex_file->GetIndexForFieldId(*msg4)) {
+          inst->SetVRegB_21c(dex_file->GetIndexForFieldId(*msg7));
+          ++num_changes;
+        }
+      }
+    }
+    ASSERT_EQ(1u, num_changes);
+    reinterpret_cast<DexFile::Header*>(data.data())->checksum_ = dex_file->CalculateChecksum();
+
+    std::unique_ptr<File> file(OS::CreateEmptyFile(dex_location.c_str()));
+    ASSERT_TRUE(file != nullptr) << dex_location;
+    ASSERT_TRUE(file->WriteFully(data.data(), data.size()));
+    ASSERT_EQ(0, file->FlushCloseOrErase());
+  }
+};
+
+// Test that recompiling unchanged dex files with --input-oat reuses the code of the previous
+// oat file, and records it again for the next compilation.
+TEST_F(Dex2oatCodeReuseTest, IncrementalCompilation) {
+  std::string dex_location = GetScratchDir() + "/ManyMethods.jar";
+  std::string first_odex_location = GetOdexDir() + "/First.odex";
+  std::string second_odex_location = GetScratchDir() + "/Second.odex";
+  Copy(GetTestDexFileName("ManyMethods"), dex_location);
+
+  GenerateOdexForTest(dex_location,
+                      first_odex_location,
+                      CompilerFilter::kSpeed,
+                      { "--record-incremental-info" });
+  output_ = "";
+  GenerateOdexForTest(dex_location,
+                      second_odex_location,
+                      CompilerFilter::kSpeed,
+                      { "--record-incremental-info", "--input-oat=" + first_odex_location });
+  int64_t num_reused_methods = ParseReusedMethods();
+
+  std::unique_ptr<OatFile> first_odex = OpenOdex(first_odex_location, dex_location);
+  std::unique_ptr<OatFile> second_odex = OpenOdex(second_odex_location, dex_location);
+  ASSERT_TRUE(first_odex != nullptr && second_odex != nullptr);
+
+  // The reused code is identical, once linked at the same place. The methods whose code refers
+  // to other dex files are compiled again.
+  size_t num_compiled_methods = CheckSameCode(*first_odex, *second_odex);
+  EXPECT_GT(num_reused_methods, 0);
+  EXPECT_LE(num_reused_methods, static_cast<int64_t>(num_compiled_methods));
+
+  std::string error_msg;
+  std::unique_ptr<File> file(OS::OpenFileForReading(second_odex_location.c_str()));
+  ASSERT_TRUE(file != nullptr);
+  std::unique_ptr<ElfFile> elf_file(ElfFile::Open(file.get(),
+                                                  /* writable */ false,
+                                                  /* program_header_only */ false,
+                                                  /* low_4gb */ false,
+                                                  &error_msg));
+  ASSERT_TRUE(elf_file != nullptr) << error_msg;
+  uint64_t section_offset;
+  uint64_t section_size;
+  EXPECT_TRUE(elf_file->GetSectionOffsetAndSize(IncrementalCompilation::kSectionName,
+                                                &section_offset,
+                                                &section_size));
+
+  // A third compilation reuses the records written by the second one.
+  output_ = "";
+  GenerateOdexForTest(dex_location,
+                      first_odex_location,
+                      CompilerFilter::kSpeed,
+                      { "--record-incremental-info", "--input-oat=" + second_odex_location });
+  EXPECT_EQ(num_reused_methods, ParseReusedMethods());
+}
+
+// Test that the code compiled with other inlining restrictions or with a profile is not reused.
+TEST_F(Dex2oatCodeReuseTest, IncrementalCompilationOtherConfiguration) {
+  std::string dex_location = GetScratchDir() + "/ManyMethods.jar";
+  std::string first_odex_location = GetOdexDir() + "/First.odex";
+  std::string second_odex_location = GetScratchDir() + "/Second.odex";
+  Copy(GetTestDexFileName("ManyMethods"), dex_location);
+
+  GenerateOdexForTest(dex_location,
+                      first_odex_location,
+                      CompilerFilter::kSpeed,
+                      { "--record-incremental-info" });
+  output_ = "";
+  GenerateOdexForTest(dex_location,
+                      second_odex_location,
+                      CompilerFilter::kSpeed,
+                      { "--input-oat=" + first_odex_location, "--no-inline-from=ManyMethods" });
+  EXPECT_EQ(0, ParseReusedMethods());
+
+  // Even an empty profile may not match the one of the first compilation.
+  ScratchFile profile_file;
+  ProfileCompilationInfo info;
+  ASSERT_TRUE(info.Save(profile_file.GetFd()));
+  output_ = "";
+  GenerateOdexForTest(dex_location,
+                      second_odex_location,
+                      CompilerFilter::kSpeed,
+                      { "--input-oat=" + first_odex_location,
+                        "--profile-file=" + profile_file.GetFilename() });
+  EXPECT_EQ(0, ParseReusedMethods());
+}
+
+// Test that changing the code of one class recompiles its methods, and the methods inlining
+// them, and reuses the code of the other classes.
+TEST_F(Dex2oatCodeReuseTest, IncrementalCompilationModifiedClass) {
+  std::string dex_location = GetScratchDir() + "/ManyMethods.jar";
+  std::string modified_dex_location = GetScratchDir() + "/ModifiedManyMethods.dex";
+  std::string first_odex_location = GetOdexDir() + "/First.odex";
+  std::string unchanged_odex_location = GetScratchDir() + "/Unchanged.odex";
+  std::string incremental_odex_location = GetScratchDir() + "/Incremental.odex";
+  std::string fresh_odex_location = GetScratchDir() + "/Fresh.odex";
+  Copy(GetTestDexFileName("ManyMethods"), dex_location);
+  ASSERT_NO_FATAL_FAILURE(WriteModifiedManyMethods(modified_dex_location));
+
+  GenerateOdexForTest(dex_location,
+                      first_odex_location,
+                      CompilerFilter::kSpeed,
+                      { "--record-incremental-info" });
+  output_ = "";
+  GenerateOdexForTest(dex_location,
+                      unchanged_odex_location,
+                      CompilerFilter::kSpeed,
+                      { "--record-incremental-info", "--input-oat=" + first_odex_location });
+  int64_t num_unchanged_reused_methods = ParseReusedMethods();
+  output_ = "";
+  GenerateOdexForTest(modified_dex_location,
+                      incremental_odex_location,
+                      CompilerFilter::kSpeed,
+                      { "--record-incremental-info", "--input-oat=" + first_odex_location });
+  int64_t num_reused_methods = ParseReusedMethods();
+  GenerateOdexForTest(modified_dex_location,
+                      fresh_odex_location,
+                      CompilerFilter::kSpeed,
+                      { "--record-incremental-info" });
+
+  // The methods of ManyMethods are compiled again, those of the nested classes are reused.
+  EXPECT_GT(num_reused_methods, 0);
+  EXPECT_LT(num_reused_methods, num_unchanged_reused_methods);
+
+  std::unique_ptr<OatFile> first_odex = OpenOdex(first_odex_location, dex_location);
+  std::unique_ptr<OatFile> incremental_odex =
+      OpenOdex(incremental_odex_location, modified_dex_location);
+  std::unique_ptr<OatFile> fresh_odex = OpenOdex(fresh_odex_location, modified_dex_location);
+  ASSERT_TRUE(first_odex != nullptr && incremental_odex != nullptr && fresh_odex != nullptr);
+
+  // The incremental compilation has the code of the modified dex file, not the previous one.
+  EXPECT_GT(CheckSameCode(*incremental_odex, *fresh_odex), 0u);
+  size_t num_changed_print6 = 0u;
+  VisitMethods(*first_odex,
+               *incremental_odex,
+               [&](const DexFile& dex_file,
+                   uint32_t method_idx,
+                   const OatFile::OatMethod& first_method,
+                   const OatFile::OatMethod& incremental_method) {
+    if (dex_file.PrettyMethod(method_idx) == "void ManyMethods.Print6()") {
+      ASSERT_NE(0u, first_method.GetQuickCodeSize());
+      if (!HasSameCode(first_method, incremental_method)) {
+        ++num_changed_print6;
+      }
+    }
+  });
+  EXPECT_EQ(1u, num_changed_print6);
+}
+
+// Test that a second compilation of the same dex file with the same --compilation-cache-dir
+// gets the code written to the cache by the first one, and that a corrupted entry is replaced.
+TEST_F(Dex2oatCodeReuseTest, CompilationCache) {
+  std::string dex_location = GetScratchDir() + "/ManyMethods.jar";
+  std::string cache_dir = GetScratchDir() + "/cache";
+  std::string first_odex_location = GetOdexDir() + "/First.odex";
+  std::string second_odex_location = GetScratchDir() + "/Second.odex";
+  Copy(GetTestDexFileName("ManyMethods"), dex_location);
+  ASSERT_EQ(0, mkdir(cache_dir.c_str(), 0700));
+  const std::vector<std::string> cache_args = { "--compilation-cache-dir=" + cache_dir };
+
+  GenerateOdexForTest(dex_location, first_odex_location, CompilerFilter::kSpeed, cache_args);
+  EXPECT_EQ(0, ParseCacheHits());
+
+  // The first compilation wrote one entry for the dex file.
+  std::vector<std::string> entries;
+  DIR* dir = opendir(cache_dir.c_str());
+  ASSERT_TRUE(dir != nullptr);
+  for (dirent* e = readdir(dir); e != nullptr; e = readdir(dir)) {
+    if (strcmp(e->d_name, ".") != 0 && strcmp(e->d_name, "..") != 0) {
+      entries.push_back(cache_dir + "/" + e->d_name);
+    }
+  }
+  closedir(dir);
+  ASSERT_EQ(1u, entries.size());
+  struct stat entry_stat;
+  ASSERT_EQ(0, stat(entries[0].c_str(), &entry_stat));
+  EXPECT_GT(entry_stat.st_size, 0);
+
+  output_ = "";
+  GenerateOdexForTest(dex_location, second_odex_location, CompilerFilter::kSpeed, cache_args);
+  int64_t num_hits = ParseCacheHits();
+
+  // The cached code is identical, once linked at the same place.
+  std::unique_ptr<OatFile> first_odex = OpenOdex(first_odex_location, dex_location);
+  std::unique_ptr<OatFile> second_odex = OpenOdex(second_odex_location, dex_location);
+  ASSERT_TRUE(first_odex != nullptr && second_odex != nullptr);
+  size_t num_compiled_methods = CheckSameCode(*first_odex, *second_odex);
+  EXPECT_GT(num_hits, 0);
+  EXPECT_LE(num_hits, static_cast<int64_t>(num_compiled_methods));
+
+  // Flip the last byte of the entry. Its digest no longer matches, so the next compilation
+  // does not use it and writes the entry again.
+  std::unique_ptr<File> entry(OS::OpenFileReadWrite(entries[0].c_str()));
+  ASSERT_TRUE(entry != nullptr);
+  uint8_t last_byte;
+  ASSERT_TRUE(entry->PreadFully(&last_byte, 1u, entry_stat.st_size - 1));
+  last_byte ^= 0xffu;
+  ASSERT_TRUE(entry->PwriteFully(&last_byte, 1u, entry_stat.st_size - 1));
+  ASSERT_EQ(0, entry->FlushClose());
+
+  output_ = "";
+  GenerateOdexForTest(dex_location, second_odex_location, CompilerFilter::kSpeed, cache_args);
+  EXPECT_EQ(0, ParseCacheHits());
+  output_ = "";
+  GenerateOdexForTest(dex_location, second_odex_location, CompilerFilter::kSpeed, cache_args);
+  EXPECT_EQ(num_hits, ParseCacheHits());
+}
+
 }  // namespace art
@@ -706,6 +706,15 @@ DISASSEMBLER_ENTRY(cmp,
               src_reg_file = SSE;
               immediate_bytes = 1;
               break;
+            case 0x44:
+              opcode1 = "pclmulqdq";
+              prefix[2] = 0;
+              has_modrm = true;
+              load = true;
+              src_reg_file = SSE;
+              dst_reg_file = SSE;
+              immediate_bytes = 1;
+              break;
             default:
               opcode_tmp = StringPrintf("unknown opcode '0F 3A %02X'", *instr);
               opcode1 = opcode_tmp.c_str();
@@ -1115,6 +1124,11 @@ DISASSEMBLER_ENTRY(cmp,
         has_modrm = true;
         load = true;
         break;
+      case 0xC1:
+        opcode1 = "xadd";
+        has_modrm = true;
+        store = true;
+        break;
       case 0xC3:
         opcode1 = "movnti";
         store = true;
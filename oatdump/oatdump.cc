@@ -633,6 +633,9 @@ class OatDumper {
       kByteKindInlineInfoLast = kByteKindInlineInfoIsLast,
     };
     int64_t bits[kByteKindCount] = {};
+    // Bits of the CodeInfo tables shared with an identical table stored by another CodeInfo.
+    // These are not accounted for in `bits`.
+    int64_t shared_code_info_bits = 0;
     // Since code has deduplication, seen tracks already seen pointers to avoid double counting
     // deduplicated code and tables.
     std::unordered_set<const void*> seen;
@@ -654,6 +657,8 @@ class OatDumper {
     void Dump(VariableIndentationOutputStream& os) {
       const int64_t sum = std::accumulate(bits, bits + kByteKindCount, 0u);
       os.Stream() << "Dumping cumulative use of " << sum / kBitsPerByte << " accounted bytes\n";
+      os.Stream() << "Sharing CodeInfo tables avoided storing "
+                  << shared_code_info_bits / kBitsPerByte << " bytes\n";
       if (sum > 0) {
         Dump(os, "Code                            ", bits[kByteKindCode], sum);
         Dump(os, "QuickMethodHeader               ", bits[kByteKindQuickMethodHeader], sum);
@@ -1661,10 +1666,19 @@ class OatDumper {
       {
         CodeInfoEncoding encoding(helper.GetEncoding());
         StackMapEncoding stack_map_encoding(encoding.stack_map.encoding);
-        const size_t num_stack_maps = encoding.stack_map.num_entries;
+        // The data of shared tables is accounted for by the CodeInfo storing it.
+        auto stored_entries = [](const auto& table) -> size_t {
+          return table.IsShared() ? 0u : table.num_entries;
+        };
+        const size_t num_stack_maps = stored_entries(encoding.stack_map);
         if (stats_.AddBitsIfUnique(Stats::kByteKindCodeInfoEncoding,
                                    encoding.HeaderSize() * kBitsPerByte,
                                    oat_method.GetVmapTable())) {
+          encoding.ForEachTable([this](auto* table) {
+            if (table->IsShared()) {
+              stats_.shared_code_info_bits += table->DataBitSize();
+            }
+          });
           // Stack maps
           stats_.AddBits(
               Stats::kByteKindStackMapNativePc,
@@ -1688,34 +1702,36 @@ class OatDumper {
           // Stack masks
           stats_.AddBits(
               Stats::kByteKindCodeInfoStackMasks,
-              encoding.stack_mask.encoding.BitSize() * encoding.stack_mask.num_entries);
+              encoding.stack_mask.encoding.BitSize() * stored_entries(encoding.stack_mask));
 
           // Register masks
           stats_.AddBits(
               Stats::kByteKindCodeInfoRegisterMasks,
-              encoding.register_mask.encoding.BitSize() * encoding.register_mask.num_entries);
+              encoding.register_mask.encoding.BitSize() * stored_entries(encoding.register_mask));
 
           // Invoke infos
-          if (encoding.invoke_info.num_entries > 0u) {
+          if (stored_entries(encoding.invoke_info) > 0u) {
             stats_.AddBits(
                 Stats::kByteKindCodeInfoInvokeInfo,
-                encoding.invoke_info.encoding.BitSize() * encoding.invoke_info.num_entries);
+                encoding.invoke_info.encoding.BitSize() * stored_entries(encoding.invoke_info));
           }
 
           // Location catalog
-          const size_t location_catalog_bytes =
-              helper.GetCodeInfo().GetDexRegisterLocationCatalogSize(encoding);
+          const size_t location_catalog_bytes = encoding.location_catalog.IsShared()
+              ? 0u
+              : helper.GetCodeInfo().GetDexRegisterLocationCatalogSize(encoding);
           stats_.AddBits(Stats::kByteKindCodeInfoLocationCatalog,
                          kBitsPerByte * location_catalog_bytes);
           // Dex register bytes.
-          const size_t dex_register_bytes =
-              helper.GetCodeInfo().GetDexRegisterMapsSize(encoding, code_item->registers_size_);
+          const size_t dex_register_bytes = encoding.dex_register_map.IsShared()
+              ? 0u
+              : helper.GetCodeInfo().GetDexRegisterMapsSize(encoding, code_item->registers_size_);
           stats_.AddBits(
               Stats::kByteKindCodeInfoDexRegisterMap,
               kBitsPerByte * dex_register_bytes);
 
           // Inline infos.
-          const size_t num_inline_infos = encoding.inline_info.num_entries;
+          const size_t num_inline_infos = stored_entries(encoding.inline_info);
           if (num_inline_infos > 0u) {
             stats_.AddBits(
                 Stats::kByteKindInlineInfoMethodIndexIdx,
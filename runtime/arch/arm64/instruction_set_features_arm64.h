@@ -55,7 +55,7 @@ class Arm64InstructionSetFeatures FINAL : public InstructionSetFeatures {
 
   uint32_t AsBitmap() const OVERRIDE;
 
-  // Return a string of the form "a53" or "none".
+  // Return a string of the form "a53,crc" or "-a53,-crc".
   std::string GetFeatureString() const OVERRIDE;
 
   // Generate code addressing Cortex-A53 erratum 835769?
@@ -68,28 +68,36 @@ class Arm64InstructionSetFeatures FINAL : public InstructionSetFeatures {
       return fix_cortex_a53_843419_;
   }
 
+  // Are the ARMv8 CRC32 instructions available?
+  bool HasCRC() const {
+    return has_crc_;
+  }
+
   virtual ~Arm64InstructionSetFeatures() {}
 
  protected:
-  // Parse a vector of the form "a53" adding these to a new ArmInstructionSetFeatures.
+  // Parse a vector of the form "a53", "crc" adding these to a new ArmInstructionSetFeatures.
   std::unique_ptr<const InstructionSetFeatures>
       AddFeaturesFromSplitString(const std::vector<std::string>& features,
                                  std::string* error_msg) const OVERRIDE;
 
  private:
-  Arm64InstructionSetFeatures(bool needs_a53_835769_fix, bool needs_a53_843419_fix)
+  Arm64InstructionSetFeatures(bool needs_a53_835769_fix, bool needs_a53_843419_fix, bool has_crc)
       : InstructionSetFeatures(),
         fix_cortex_a53_835769_(needs_a53_835769_fix),
-        fix_cortex_a53_843419_(needs_a53_843419_fix) {
+        fix_cortex_a53_843419_(needs_a53_843419_fix),
+        has_crc_(has_crc) {
   }
 
   // Bitmap positions for encoding features as a bitmap.
   enum {
     kA53Bitfield = 1 << 0,
+    kCRCBitField = 1 << 1,
   };
 
   const bool fix_cortex_a53_835769_;
   const bool fix_cortex_a53_843419_;
+  const bool has_crc_;
 
   DISALLOW_COPY_AND_ASSIGN(Arm64InstructionSetFeatures);
 };
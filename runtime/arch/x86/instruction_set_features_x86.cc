@@ -58,27 +58,35 @@ static constexpr const char* x86_variants_with_popcnt[] = {
     "silvermont",
 };
 
+static constexpr const char* x86_variants_with_pclmulqdq[] = {
+    "sandybridge",
+    "silvermont",
+};
+
 X86FeaturesUniquePtr X86InstructionSetFeatures::Create(bool x86_64,
                                                        bool has_SSSE3,
                                                        bool has_SSE4_1,
                                                        bool has_SSE4_2,
                                                        bool has_AVX,
                                                        bool has_AVX2,
-                                                       bool has_POPCNT) {
+                                                       bool has_POPCNT,
+                                                       bool has_PCLMULQDQ) {
   if (x86_64) {
     return X86FeaturesUniquePtr(new X86_64InstructionSetFeatures(has_SSSE3,
                                                                  has_SSE4_1,
                                                                  has_SSE4_2,
                                                                  has_AVX,
                                                                  has_AVX2,
-                                                                 has_POPCNT));
+                                                                 has_POPCNT,
+                                                                 has_PCLMULQDQ));
   } else {
     return X86FeaturesUniquePtr(new X86InstructionSetFeatures(has_SSSE3,
                                                               has_SSE4_1,
                                                               has_SSE4_2,
                                                               has_AVX,
                                                               has_AVX2,
-                                                              has_POPCNT));
+                                                              has_POPCNT,
+                                                              has_PCLMULQDQ));
   }
 }
 
@@ -99,6 +107,9 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromVariant(
   bool has_POPCNT = FindVariantInArray(x86_variants_with_popcnt,
                                        arraysize(x86_variants_with_popcnt),
                                        variant);
+  bool has_PCLMULQDQ = FindVariantInArray(x86_variants_with_pclmulqdq,
+                                          arraysize(x86_variants_with_pclmulqdq),
+                                          variant);
 
   // Verify that variant is known.
   bool known_variant = FindVariantInArray(x86_known_variants, arraysize(x86_known_variants),
@@ -107,7 +118,8 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromVariant(
     LOG(WARNING) << "Unexpected CPU variant for X86 using defaults: " << variant;
   }
 
-  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT);
+  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT,
+                has_PCLMULQDQ);
 }
 
 X86FeaturesUniquePtr X86InstructionSetFeatures::FromBitmap(uint32_t bitmap, bool x86_64) {
@@ -117,7 +129,9 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromBitmap(uint32_t bitmap, bool
   bool has_AVX = (bitmap & kAvxBitfield) != 0;
   bool has_AVX2 = (bitmap & kAvxBitfield) != 0;
   bool has_POPCNT = (bitmap & kPopCntBitfield) != 0;
-  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT);
+  bool has_PCLMULQDQ = (bitmap & kPclmulqdqBitfield) != 0;
+  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT,
+                has_PCLMULQDQ);
 }
 
 X86FeaturesUniquePtr X86InstructionSetFeatures::FromCppDefines(bool x86_64) {
@@ -157,7 +171,14 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromCppDefines(bool x86_64) {
   const bool has_POPCNT = true;
 #endif
 
-  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT);
+#ifndef __PCLMUL__
+  const bool has_PCLMULQDQ = false;
+#else
+  const bool has_PCLMULQDQ = true;
+#endif
+
+  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT,
+                has_PCLMULQDQ);
 }
 
 X86FeaturesUniquePtr X86InstructionSetFeatures::FromCpuInfo(bool x86_64) {
@@ -169,6 +190,7 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromCpuInfo(bool x86_64) {
   bool has_AVX = false;
   bool has_AVX2 = false;
   bool has_POPCNT = false;
+  bool has_PCLMULQDQ = false;
 
   std::ifstream in("/proc/cpuinfo");
   if (!in.fail()) {
@@ -197,6 +219,9 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromCpuInfo(bool x86_64) {
           if (line.find("popcnt") != std::string::npos) {
             has_POPCNT = true;
           }
+          if (line.find("pclmulqdq") != std::string::npos) {
+            has_PCLMULQDQ = true;
+          }
         }
       }
     }
@@ -204,7 +229,8 @@ X86FeaturesUniquePtr X86InstructionSetFeatures::FromCpuInfo(bool x86_64) {
   } else {
     LOG(ERROR) << "Failed to open /proc/cpuinfo";
   }
-  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT);
+  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT,
+                has_PCLMULQDQ);
 }
 
 X86FeaturesUniquePtr X86InstructionSetFeatures::FromHwcap(bool x86_64) {
@@ -227,7 +253,8 @@ bool X86InstructionSetFeatures::Equals(const InstructionSetFeatures* other) cons
       (has_SSE4_2_ == other_as_x86->has_SSE4_2_) &&
       (has_AVX_ == other_as_x86->has_AVX_) &&
       (has_AVX2_ == other_as_x86->has_AVX2_) &&
-      (has_POPCNT_ == other_as_x86->has_POPCNT_);
+      (has_POPCNT_ == other_as_x86->has_POPCNT_) &&
+      (has_PCLMULQDQ_ == other_as_x86->has_PCLMULQDQ_);
 }
 
 bool X86InstructionSetFeatures::HasAtLeast(const InstructionSetFeatures* other) const {
@@ -240,7 +267,8 @@ bool X86InstructionSetFeatures::HasAtLeast(const InstructionSetFeatures* other)
       (has_SSE4_2_ || !other_as_x86->has_SSE4_2_) &&
       (has_AVX_ || !other_as_x86->has_AVX_) &&
       (has_AVX2_ || !other_as_x86->has_AVX2_) &&
-      (has_POPCNT_ || !other_as_x86->has_POPCNT_);
+      (has_POPCNT_ || !other_as_x86->has_POPCNT_) &&
+      (has_PCLMULQDQ_ || !other_as_x86->has_PCLMULQDQ_);
 }
 
 uint32_t X86InstructionSetFeatures::AsBitmap() const {
@@ -249,7 +277,8 @@ uint32_t X86InstructionSetFeatures::AsBitmap() const {
       (has_SSE4_2_ ? kSse4_2Bitfield : 0) |
       (has_AVX_ ? kAvxBitfield : 0) |
       (has_AVX2_ ? kAvx2Bitfield : 0) |
-      (has_POPCNT_ ? kPopCntBitfield : 0);
+      (has_POPCNT_ ? kPopCntBitfield : 0) |
+      (has_PCLMULQDQ_ ? kPclmulqdqBitfield : 0);
 }
 
 std::string X86InstructionSetFeatures::GetFeatureString() const {
@@ -284,6 +313,11 @@ std::string X86InstructionSetFeatures::GetFeatureString() const {
   } else {
     result += ",-popcnt";
   }
+  if (has_PCLMULQDQ_) {
+    result += ",pclmulqdq";
+  } else {
+    result += ",-pclmulqdq";
+  }
   return result;
 }
 
@@ -296,6 +330,7 @@ std::unique_ptr<const InstructionSetFeatures> X86InstructionSetFeatures::AddFeat
   bool has_AVX = has_AVX_;
   bool has_AVX2 = has_AVX2_;
   bool has_POPCNT = has_POPCNT_;
+  bool has_PCLMULQDQ = has_PCLMULQDQ_;
   for (auto i = features.begin(); i != features.end(); i++) {
     std::string feature = android::base::Trim(*i);
     if (feature == "ssse3") {
@@ -322,12 +357,17 @@ std::unique_ptr<const InstructionSetFeatures> X86InstructionSetFeatures::AddFeat
       has_POPCNT = true;
     } else if (feature == "-popcnt") {
       has_POPCNT = false;
+    } else if (feature == "pclmulqdq") {
+      has_PCLMULQDQ = true;
+    } else if (feature == "-pclmulqdq") {
+      has_PCLMULQDQ = false;
     } else {
       *error_msg = StringPrintf("Unknown instruction set feature: '%s'", feature.c_str());
       return nullptr;
     }
   }
-  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT);
+  return Create(x86_64, has_SSSE3, has_SSE4_1, has_SSE4_2, has_AVX, has_AVX2, has_POPCNT,
+                has_PCLMULQDQ);
 }
 
 }  // namespace art
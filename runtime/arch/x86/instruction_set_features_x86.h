@@ -65,8 +65,12 @@ class X86InstructionSetFeatures : public InstructionSetFeatures {
 
   bool HasSSE4_1() const { return has_SSE4_1_; }
 
+  bool HasAVX2() const { return has_AVX2_; }
+
   bool HasPopCnt() const { return has_POPCNT_; }
 
+  bool HasPCLMULQDQ() const { return has_PCLMULQDQ_; }
+
  protected:
   // Parse a string of the form "ssse3" adding these to a new InstructionSetFeatures.
   virtual std::unique_ptr<const InstructionSetFeatures>
@@ -85,14 +89,16 @@ class X86InstructionSetFeatures : public InstructionSetFeatures {
                             bool has_SSE4_2,
                             bool has_AVX,
                             bool has_AVX2,
-                            bool has_POPCNT)
+                            bool has_POPCNT,
+                            bool has_PCLMULQDQ)
       : InstructionSetFeatures(),
         has_SSSE3_(has_SSSE3),
         has_SSE4_1_(has_SSE4_1),
         has_SSE4_2_(has_SSE4_2),
         has_AVX_(has_AVX),
         has_AVX2_(has_AVX2),
-        has_POPCNT_(has_POPCNT) {
+        has_POPCNT_(has_POPCNT),
+        has_PCLMULQDQ_(has_PCLMULQDQ) {
   }
 
   static X86FeaturesUniquePtr Create(bool x86_64,
@@ -101,7 +107,8 @@ class X86InstructionSetFeatures : public InstructionSetFeatures {
                                      bool has_SSE4_2,
                                      bool has_AVX,
                                      bool has_AVX2,
-                                     bool has_POPCNT);
+                                     bool has_POPCNT,
+                                     bool has_PCLMULQDQ);
 
  private:
   // Bitmap positions for encoding features as a bitmap.
@@ -112,6 +119,7 @@ class X86InstructionSetFeatures : public InstructionSetFeatures {
     kAvxBitfield = 1 << 3,
     kAvx2Bitfield = 1 << 4,
     kPopCntBitfield = 1 << 5,
+    kPclmulqdqBitfield = 1 << 6,
   };
 
   const bool has_SSSE3_;   // x86 128bit SIMD - Supplemental SSE.
@@ -120,6 +128,7 @@ class X86InstructionSetFeatures : public InstructionSetFeatures {
   const bool has_AVX_;     // x86 256bit SIMD AVX.
   const bool has_AVX2_;    // x86 256bit SIMD AVX 2.0.
   const bool has_POPCNT_;  // x86 population count
+  const bool has_PCLMULQDQ_;  // x86 carry-less multiplication.
 
   DISALLOW_COPY_AND_ASSIGN(X86InstructionSetFeatures);
 };
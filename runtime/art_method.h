@@ -207,8 +207,10 @@ class ArtMethod FINAL {
   }
 
   bool IsMiranda() {
-    static_assert((kAccMiranda & kAccFlagsNotUsedByIntrinsic) == kAccMiranda,
-                  "kAccMiranda conflicts with intrinsic modifier");
+    if (IsIntrinsic()) {
+      // kAccMiranda overlaps with the intrinsic ordinal. Intrinsics are never abstract.
+      return false;
+    }
     return (GetAccessFlags() & kAccMiranda) != 0;
   }
 
@@ -229,6 +231,16 @@ class ArtMethod FINAL {
     AddAccessFlags(kAccCompileDontBother);
   }
 
+  bool IsPreviouslyWarm() {
+    static_assert((kAccPreviouslyWarm & kAccFlagsNotUsedByIntrinsic) == kAccPreviouslyWarm,
+                  "kAccPreviouslyWarm conflicts with intrinsic modifier");
+    return (GetAccessFlags() & kAccPreviouslyWarm) != 0;
+  }
+
+  void SetPreviouslyWarm() {
+    AddAccessFlags(kAccPreviouslyWarm);
+  }
+
   // A default conflict method is a special sentinel method that stands for a conflict between
   // multiple default methods. It cannot be invoked, throwing an IncompatibleClassChangeError if one
   // attempts to do so.
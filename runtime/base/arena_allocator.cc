@@ -276,6 +276,8 @@ ArenaPool::ArenaPool(bool use_malloc, bool low_4gb, const char* name)
     : use_malloc_(use_malloc),
       lock_("Arena pool lock", kArenaPoolLock),
       free_arenas_(nullptr),
+      bytes_in_use_(0u),
+      peak_bytes_in_use_(0u),
       low_4gb_(low_4gb),
       name_(name) {
   if (low_4gb) {
@@ -318,6 +320,12 @@ Arena* ArenaPool::AllocArena(size_t size) {
         new MemMapArena(size, low_4gb_, name_);
   }
   ret->Reset();
+  size_t bytes_in_use = bytes_in_use_.FetchAndAddRelaxed(ret->Size()) + ret->Size();
+  size_t peak_bytes_in_use = peak_bytes_in_use_.LoadRelaxed();
+  while (bytes_in_use > peak_bytes_in_use &&
+         !peak_bytes_in_use_.CompareExchangeWeakRelaxed(peak_bytes_in_use, bytes_in_use)) {
+    peak_bytes_in_use = peak_bytes_in_use_.LoadRelaxed();
+  }
   return ret;
 }
 
@@ -341,6 +349,14 @@ size_t ArenaPool::GetBytesAllocated() const {
   return total;
 }
 
+size_t ArenaPool::GetPeakBytesInUse() const {
+  return peak_bytes_in_use_.LoadRelaxed();
+}
+
+void ArenaPool::ResetPeakBytesInUse() {
+  peak_bytes_in_use_.StoreRelaxed(bytes_in_use_.LoadRelaxed());
+}
+
 void ArenaPool::FreeArenaChain(Arena* first) {
   if (UNLIKELY(RUNNING_ON_MEMORY_TOOL > 0)) {
     for (Arena* arena = first; arena != nullptr; arena = arena->next_) {
@@ -348,6 +364,13 @@ void ArenaPool::FreeArenaChain(Arena* first) {
     }
   }
 
+  size_t freed_bytes = 0u;
+  for (Arena* arena = first; arena != nullptr; arena = arena->next_) {
+    freed_bytes += arena->Size();
+  }
+  size_t old_bytes_in_use = bytes_in_use_.FetchAndSubRelaxed(freed_bytes);
+  DCHECK_GE(old_bytes_in_use, freed_bytes);
+
   if (arena_allocator::kArenaAllocatorPreciseTracking) {
     // Do not reuse arenas when tracking.
     while (first != nullptr) {
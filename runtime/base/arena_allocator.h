@@ -253,6 +253,11 @@ class ArenaPool {
   Arena* AllocArena(size_t size) REQUIRES(!lock_);
   void FreeArenaChain(Arena* first) REQUIRES(!lock_);
   size_t GetBytesAllocated() const REQUIRES(!lock_);
+  // The peak size of the arenas handed out by this pool and not yet returned to it, since
+  // the last call to ResetPeakBytesInUse(). Unlike the bytes used by one ArenaAllocator, this
+  // includes the short-lived allocators that compiler passes create from the same pool.
+  size_t GetPeakBytesInUse() const;
+  void ResetPeakBytesInUse();
   void ReclaimMemory() NO_THREAD_SAFETY_ANALYSIS;
   void LockReclaimMemory() REQUIRES(!lock_);
   // Trim the maps in arenas by madvising, used by JIT to reduce memory usage. This only works
@@ -263,6 +268,9 @@ class ArenaPool {
   const bool use_malloc_;
   mutable Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
   Arena* free_arenas_ GUARDED_BY(lock_);
+  // Only used for statistics, so updated with relaxed atomics rather than under `lock_`.
+  Atomic<size_t> bytes_in_use_;
+  Atomic<size_t> peak_bytes_in_use_;
   const bool low_4gb_;
   const char* name_;
   DISALLOW_COPY_AND_ASSIGN(ArenaPool);
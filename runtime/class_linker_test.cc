@@ -1550,6 +1550,34 @@ TEST_F(ClassLinkerTest, CreateWellKnownClassLoader) {
   LoadDexInDelegateLastClassLoader("Interfaces", class_loader_c);
 }
 
+// The intrinsic ordinal shares its bits with some runtime-only method flags. Verify that
+// an intrinsic which was never executed is not reported as previously warm, which would make
+// the profile saver record it as hot.
+TEST_F(ClassLinkerTest, IntrinsicIsNotPreviouslyWarm) {
+  ScopedObjectAccess soa(Thread::Current());
+  mirror::Class* math = class_linker_->FindSystemClass(soa.Self(), "Ljava/lang/Math;");
+  ASSERT_TRUE(math != nullptr);
+  ArtMethod* abs = math->FindClassMethod("abs", "(I)I", kRuntimePointerSize);
+  ASSERT_TRUE(abs != nullptr);
+  ASSERT_TRUE(abs->IsStatic());
+  const uint32_t saved_flags = abs->GetAccessFlags();
+
+  // Use the largest ordinal so that every bit of the ordinal is set.
+  const uint32_t intrinsic = kAccMaxIntrinsic;
+  abs->SetIntrinsic(intrinsic);
+  EXPECT_TRUE(abs->IsIntrinsic());
+  EXPECT_EQ(intrinsic, abs->GetIntrinsic());
+  EXPECT_FALSE(abs->IsPreviouslyWarm());
+  EXPECT_FALSE(abs->IsMiranda());
+
+  abs->SetPreviouslyWarm();
+  EXPECT_TRUE(abs->IsPreviouslyWarm());
+  EXPECT_TRUE(abs->IsIntrinsic());
+  EXPECT_EQ(intrinsic, abs->GetIntrinsic());
+
+  abs->SetAccessFlags(saved_flags);
+}
+
 class ClassLinkerClassLoaderTest : public ClassLinkerTest {
  protected:
   // Verifies that the class identified by the given descriptor is loaded with
@@ -27,6 +27,7 @@ enum class DeoptimizationKind {
   kLoopNullBCE,
   kBlockBCE,
   kCHA,
+  kColdBranch,
   kFullFrame,
   kLast = kFullFrame
 };
@@ -40,6 +41,7 @@ inline const char* GetDeoptimizationKindName(DeoptimizationKind kind) {
     case DeoptimizationKind::kLoopNullBCE: return "loop bounds check elimination on null";
     case DeoptimizationKind::kBlockBCE: return "block bounds check elimination";
     case DeoptimizationKind::kCHA: return "class hierarchy analysis";
+    case DeoptimizationKind::kColdBranch: return "cold branch";
     case DeoptimizationKind::kFullFrame: return "full frame";
   }
   LOG(FATAL) << "Unexpected kind " << static_cast<size_t>(kind);
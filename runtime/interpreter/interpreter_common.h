@@ -400,15 +400,17 @@ bool DoFilledNewArray(const Instruction* inst, const ShadowFrame& shadow_frame,
                       Thread* self, JValue* result);
 
 // Handles packed-switch instruction.
-// Returns the branch offset to the next instruction to execute.
+// Returns the branch offset to the next instruction to execute, and sets `target_index`
+// to the index of the matching case, or to the number of cases for the default target.
 static inline int32_t DoPackedSwitch(const Instruction* inst, const ShadowFrame& shadow_frame,
-                                     uint16_t inst_data)
+                                     uint16_t inst_data, /*out*/ uint32_t* target_index)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   DCHECK(inst->Opcode() == Instruction::PACKED_SWITCH);
   const uint16_t* switch_data = reinterpret_cast<const uint16_t*>(inst) + inst->VRegB_31t();
   int32_t test_val = shadow_frame.GetVReg(inst->VRegA_31t(inst_data));
   DCHECK_EQ(switch_data[0], static_cast<uint16_t>(Instruction::kPackedSwitchSignature));
   uint16_t size = switch_data[1];
+  *target_index = size;
   if (size == 0) {
     // Empty packed switch, move forward by 3 (size of PACKED_SWITCH).
     return 3;
@@ -420,6 +422,7 @@ static inline int32_t DoPackedSwitch(const Instruction* inst, const ShadowFrame&
   DCHECK_ALIGNED(targets, 4);
   int32_t index = test_val - first_key;
   if (index >= 0 && index < size) {
+    *target_index = index;
     return targets[index];
   } else {
     // No corresponding value: move forward by 3 (size of PACKED_SWITCH).
@@ -428,15 +431,17 @@ static inline int32_t DoPackedSwitch(const Instruction* inst, const ShadowFrame&
 }
 
 // Handles sparse-switch instruction.
-// Returns the branch offset to the next instruction to execute.
+// Returns the branch offset to the next instruction to execute, and sets `target_index`
+// to the index of the matching case, or to the number of cases for the default target.
 static inline int32_t DoSparseSwitch(const Instruction* inst, const ShadowFrame& shadow_frame,
-                                     uint16_t inst_data)
+                                     uint16_t inst_data, /*out*/ uint32_t* target_index)
     REQUIRES_SHARED(Locks::mutator_lock_) {
   DCHECK(inst->Opcode() == Instruction::SPARSE_SWITCH);
   const uint16_t* switch_data = reinterpret_cast<const uint16_t*>(inst) + inst->VRegB_31t();
   int32_t test_val = shadow_frame.GetVReg(inst->VRegA_31t(inst_data));
   DCHECK_EQ(switch_data[0], static_cast<uint16_t>(Instruction::kSparseSwitchSignature));
   uint16_t size = switch_data[1];
+  *target_index = size;
   // Return length of SPARSE_SWITCH if size is 0.
   if (size == 0) {
     return 3;
@@ -455,6 +460,7 @@ static inline int32_t DoSparseSwitch(const Instruction* inst, const ShadowFrame&
     } else if (test_val > foundVal) {
       lo = mid + 1;
     } else {
+      *target_index = mid;
       return entries[mid];
     }
   }
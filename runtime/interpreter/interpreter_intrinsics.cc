@@ -413,6 +413,25 @@ bool MterpHandleIntrinsic(ShadowFrame* shadow_frame,
     UNIMPLEMENTED_CASE(MathRoundFloat /* (F)I */)
     UNIMPLEMENTED_CASE(SystemArrayCopyChar /* ([CI[CII)V */)
     UNIMPLEMENTED_CASE(SystemArrayCopy /* (Ljava/lang/Object;ILjava/lang/Object;II)V */)
+    UNIMPLEMENTED_CASE(SystemArrayCopyByte /* ([BI[BII)V */)
+    UNIMPLEMENTED_CASE(SystemArrayCopyShort /* ([SI[SII)V */)
+    UNIMPLEMENTED_CASE(SystemArrayCopyInt /* ([II[III)V */)
+    UNIMPLEMENTED_CASE(SystemArrayCopyLong /* ([JI[JII)V */)
+    UNIMPLEMENTED_CASE(ArraysEqualsByte /* ([B[B)Z */)
+    UNIMPLEMENTED_CASE(ArraysEqualsChar /* ([C[C)Z */)
+    UNIMPLEMENTED_CASE(ArraysEqualsShort /* ([S[S)Z */)
+    UNIMPLEMENTED_CASE(ArraysEqualsInt /* ([I[I)Z */)
+    UNIMPLEMENTED_CASE(ArraysEqualsLong /* ([J[J)Z */)
+    UNIMPLEMENTED_CASE(ArraysFillByte /* ([BB)V */)
+    UNIMPLEMENTED_CASE(ArraysFillChar /* ([CC)V */)
+    UNIMPLEMENTED_CASE(ArraysFillShort /* ([SS)V */)
+    UNIMPLEMENTED_CASE(ArraysFillInt /* ([II)V */)
+    UNIMPLEMENTED_CASE(ArraysFillLong /* ([JJ)V */)
+    UNIMPLEMENTED_CASE(ArraysHashCodeByte /* ([B)I */)
+    UNIMPLEMENTED_CASE(ArraysHashCodeChar /* ([C)I */)
+    UNIMPLEMENTED_CASE(ArraysHashCodeShort /* ([S)I */)
+    UNIMPLEMENTED_CASE(ArraysHashCodeInt /* ([I)I */)
+    UNIMPLEMENTED_CASE(ArraysHashCodeLong /* ([J)I */)
     UNIMPLEMENTED_CASE(ThreadCurrentThread /* ()Ljava/lang/Thread; */)
     UNIMPLEMENTED_CASE(MemoryPeekByte /* (J)B */)
     UNIMPLEMENTED_CASE(MemoryPeekIntNative /* (J)I */)
@@ -426,6 +445,7 @@ bool MterpHandleIntrinsic(ShadowFrame* shadow_frame,
     INTRINSIC_CASE(StringCompareTo)
     INTRINSIC_CASE(StringEquals)
     INTRINSIC_CASE(StringGetCharsNoCheck)
+    UNIMPLEMENTED_CASE(StringHashCode /* ()I */)
     INTRINSIC_CASE(StringIndexOf)
     INTRINSIC_CASE(StringIndexOfAfter)
     UNIMPLEMENTED_CASE(StringStringIndexOf /* (Ljava/lang/String;)I */)
@@ -470,6 +490,12 @@ bool MterpHandleIntrinsic(ShadowFrame* shadow_frame,
     UNIMPLEMENTED_CASE(ReferenceGetReferent /* ()Ljava/lang/Object; */)
     UNIMPLEMENTED_CASE(IntegerValueOf /* (I)Ljava/lang/Integer; */)
     UNIMPLEMENTED_CASE(ThreadInterrupted /* ()Z */)
+    UNIMPLEMENTED_CASE(CRC32Update /* (II)I */)
+    UNIMPLEMENTED_CASE(CRC32UpdateBytes /* (I[BII)I */)
+    UNIMPLEMENTED_CASE(CRC32UpdateByteBuffer /* (IJII)I */)
+    UNIMPLEMENTED_CASE(Adler32Update /* (II)I */)
+    UNIMPLEMENTED_CASE(Adler32UpdateBytes /* (I[BII)I */)
+    UNIMPLEMENTED_CASE(Adler32UpdateByteBuffer /* (IJII)I */)
     case Intrinsics::kNone:
       res = false;
       break;
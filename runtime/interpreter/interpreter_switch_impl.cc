@@ -96,6 +96,13 @@ namespace interpreter {
     }                                                                                          \
   } while (false)
 
+#define BRANCH_PROFILE(target_index)                                                           \
+  do {                                                                                         \
+    if (UNLIKELY(jit != nullptr && jit->UseBranchProfiling())) {                               \
+      jit->BranchTaken(method, dex_pc, target_index);                                          \
+    }                                                                                          \
+  } while (false)
+
 #define HOTNESS_UPDATE()                                                                       \
   do {                                                                                         \
     if (jit != nullptr) {                                                                      \
@@ -693,7 +700,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
       }
       case Instruction::PACKED_SWITCH: {
         PREAMBLE();
-        int32_t offset = DoPackedSwitch(inst, shadow_frame, inst_data);
+        uint32_t target_index;
+        int32_t offset = DoPackedSwitch(inst, shadow_frame, inst_data, &target_index);
+        BRANCH_PROFILE(target_index);
         BRANCH_INSTRUMENTATION(offset);
         inst = inst->RelativeAt(offset);
         HANDLE_BACKWARD_BRANCH(offset);
@@ -701,7 +710,9 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
       }
       case Instruction::SPARSE_SWITCH: {
         PREAMBLE();
-        int32_t offset = DoSparseSwitch(inst, shadow_frame, inst_data);
+        uint32_t target_index;
+        int32_t offset = DoSparseSwitch(inst, shadow_frame, inst_data, &target_index);
+        BRANCH_PROFILE(target_index);
         BRANCH_INSTRUMENTATION(offset);
         inst = inst->RelativeAt(offset);
         HANDLE_BACKWARD_BRANCH(offset);
@@ -800,10 +811,12 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         if (shadow_frame.GetVReg(inst->VRegA_22t(inst_data)) ==
             shadow_frame.GetVReg(inst->VRegB_22t(inst_data))) {
           int16_t offset = inst->VRegC_22t();
+          BRANCH_PROFILE(0);
           BRANCH_INSTRUMENTATION(offset);
           inst = inst->RelativeAt(offset);
           HANDLE_BACKWARD_BRANCH(offset);
         } else {
+          BRANCH_PROFILE(1);
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
@@ -814,10 +827,12 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         if (shadow_frame.GetVReg(inst->VRegA_22t(inst_data)) !=
             shadow_frame.GetVReg(inst->VRegB_22t(inst_data))) {
           int16_t offset = inst->VRegC_22t();
+          BRANCH_PROFILE(0);
           BRANCH_INSTRUMENTATION(offset);
           inst = inst->RelativeAt(offset);
           HANDLE_BACKWARD_BRANCH(offset);
         } else {
+          BRANCH_PROFILE(1);
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
@@ -828,10 +843,12 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         if (shadow_frame.GetVReg(inst->VRegA_22t(inst_data)) <
             shadow_frame.GetVReg(inst->VRegB_22t(inst_data))) {
           int16_t offset = inst->VRegC_22t();
+          BRANCH_PROFILE(0);
           BRANCH_INSTRUMENTATION(offset);
           inst = inst->RelativeAt(offset);
           HANDLE_BACKWARD_BRANCH(offset);
         } else {
+          BRANCH_PROFILE(1);
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
@@ -842,10 +859,12 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         if (shadow_frame.GetVReg(inst->VRegA_22t(inst_data)) >=
             shadow_frame.GetVReg(inst->VRegB_22t(inst_data))) {
           int16_t offset = inst->VRegC_22t();
+          BRANCH_PROFILE(0);
           BRANCH_INSTRUMENTATION(offset);
           inst = inst->RelativeAt(offset);
           HANDLE_BACKWARD_BRANCH(offset);
         } else {
+          BRANCH_PROFILE(1);
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
@@ -856,10 +875,12 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         if (shadow_frame.GetVReg(inst->VRegA_22t(inst_data)) >
         shadow_frame.GetVReg(inst->VRegB_22t(inst_data))) {
           int16_t offset = inst->VRegC_22t();
+          BRANCH_PROFILE(0);
           BRANCH_INSTRUMENTATION(offset);
           inst = inst->RelativeAt(offset);
           HANDLE_BACKWARD_BRANCH(offset);
         } else {
+          BRANCH_PROFILE(1);
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
@@ -870,10 +891,12 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         if (shadow_frame.GetVReg(inst->VRegA_22t(inst_data)) <=
             shadow_frame.GetVReg(inst->VRegB_22t(inst_data))) {
           int16_t offset = inst->VRegC_22t();
+          BRANCH_PROFILE(0);
           BRANCH_INSTRUMENTATION(offset);
           inst = inst->RelativeAt(offset);
           HANDLE_BACKWARD_BRANCH(offset);
         } else {
+          BRANCH_PROFILE(1);
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
@@ -883,10 +906,12 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_21t(inst_data)) == 0) {
           int16_t offset = inst->VRegB_21t();
+          BRANCH_PROFILE(0);
           BRANCH_INSTRUMENTATION(offset);
           inst = inst->RelativeAt(offset);
           HANDLE_BACKWARD_BRANCH(offset);
         } else {
+          BRANCH_PROFILE(1);
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
@@ -896,10 +921,12 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_21t(inst_data)) != 0) {
           int16_t offset = inst->VRegB_21t();
+          BRANCH_PROFILE(0);
           BRANCH_INSTRUMENTATION(offset);
           inst = inst->RelativeAt(offset);
           HANDLE_BACKWARD_BRANCH(offset);
         } else {
+          BRANCH_PROFILE(1);
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
@@ -909,10 +936,12 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_21t(inst_data)) < 0) {
           int16_t offset = inst->VRegB_21t();
+          BRANCH_PROFILE(0);
           BRANCH_INSTRUMENTATION(offset);
           inst = inst->RelativeAt(offset);
           HANDLE_BACKWARD_BRANCH(offset);
         } else {
+          BRANCH_PROFILE(1);
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
@@ -922,10 +951,12 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_21t(inst_data)) >= 0) {
           int16_t offset = inst->VRegB_21t();
+          BRANCH_PROFILE(0);
           BRANCH_INSTRUMENTATION(offset);
           inst = inst->RelativeAt(offset);
           HANDLE_BACKWARD_BRANCH(offset);
         } else {
+          BRANCH_PROFILE(1);
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
@@ -935,10 +966,12 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_21t(inst_data)) > 0) {
           int16_t offset = inst->VRegB_21t();
+          BRANCH_PROFILE(0);
           BRANCH_INSTRUMENTATION(offset);
           inst = inst->RelativeAt(offset);
           HANDLE_BACKWARD_BRANCH(offset);
         } else {
+          BRANCH_PROFILE(1);
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
@@ -948,10 +981,12 @@ JValue ExecuteSwitchImpl(Thread* self, const DexFile::CodeItem* code_item,
         PREAMBLE();
         if (shadow_frame.GetVReg(inst->VRegA_21t(inst_data)) <= 0) {
           int16_t offset = inst->VRegB_21t();
+          BRANCH_PROFILE(0);
           BRANCH_INSTRUMENTATION(offset);
           inst = inst->RelativeAt(offset);
           HANDLE_BACKWARD_BRANCH(offset);
         } else {
+          BRANCH_PROFILE(1);
           BRANCH_INSTRUMENTATION(2);
           inst = inst->Next_2xx();
         }
@@ -147,7 +147,11 @@ extern "C" size_t MterpShouldSwitchInterpreters()
     REQUIRES_SHARED(Locks::mutator_lock_) {
   const instrumentation::Instrumentation* const instrumentation =
       Runtime::Current()->GetInstrumentation();
-  return instrumentation->NonJitProfilingActive() || Dbg::IsDebuggerActive();
+  // Mterp does not record branch profiles, leave that to the switch interpreter.
+  const jit::Jit* const jit = Runtime::Current()->GetJit();
+  return instrumentation->NonJitProfilingActive() ||
+      Dbg::IsDebuggerActive() ||
+      (jit != nullptr && jit->UseBranchProfiling());
 }
 
 
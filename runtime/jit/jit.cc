@@ -22,15 +22,18 @@
 #include "base/enums.h"
 #include "base/logging.h"
 #include "base/memory_tool.h"
+#include "base/time_utils.h"
 #include "debugger.h"
 #include "entrypoints/runtime_asm_entrypoints.h"
 #include "interpreter/interpreter.h"
 #include "java_vm_ext.h"
 #include "jit_code_cache.h"
+#include "jit_telemetry.h"
 #include "oat_file_manager.h"
 #include "oat_quick_method_header.h"
 #include "profile_compilation_info.h"
 #include "profile_saver.h"
+#include "profiling_info.h"
 #include "runtime.h"
 #include "runtime_options.h"
 #include "stack.h"
@@ -45,6 +48,8 @@ namespace jit {
 static constexpr bool kEnableOnStackReplacement = true;
 // At what priority to schedule jit threads. 9 is the lowest foreground priority on device.
 static constexpr int kJitPoolThreadPthreadPriority = 9;
+// At what priority to compile large methods. 10 is the background priority on device.
+static constexpr int kJitLargeMethodPthreadPriority = 10;
 
 // Different compilation threshold constants. These can be overridden on the command line.
 static constexpr size_t kJitDefaultCompileThreshold           = 10000;  // Non-debug default.
@@ -75,6 +80,11 @@ JitOptions* JitOptions::CreateFromRuntimeArguments(const RuntimeArgumentMap& opt
       options.GetOrDefault(RuntimeArgumentMap::JITCodeCacheMaxCapacity);
   jit_options->dump_info_on_shutdown_ =
       options.Exists(RuntimeArgumentMap::DumpJITInfoOnShutdown);
+  jit_options->use_branch_profiling_ =
+      options.Exists(RuntimeArgumentMap::JITBranchProfiling);
+  jit_options->large_method_threshold_ =
+      options.GetOrDefault(RuntimeArgumentMap::JITLargeMethodThreshold);
+  jit_options->telemetry_file_ = options.GetOrDefault(RuntimeArgumentMap::JITTelemetryFile);
   jit_options->profile_saver_options_ =
       options.GetOrDefault(RuntimeArgumentMap::ProfileSaverOpts);
 
@@ -152,10 +162,17 @@ bool Jit::ShouldUsePriorityThreadWeight() {
 void Jit::DumpInfo(std::ostream& os) {
   code_cache_->Dump(os);
   cumulative_timings_.Dump(os);
+  if (telemetry_ != nullptr) {
+    telemetry_->DumpInfo(os);
+  }
   MutexLock mu(Thread::Current(), lock_);
   memory_use_.PrintMemoryUse(os);
 }
 
+JitCompilationEvent* Jit::GetCurrentCompilationEvent(Thread* self) {
+  return (telemetry_ != nullptr) ? telemetry_->GetCurrentCompilation(self) : nullptr;
+}
+
 void Jit::DumpForSigQuit(std::ostream& os) {
   DumpInfo(os);
   ProfileSaver::DumpInstanceInfo(os);
@@ -170,11 +187,14 @@ Jit::Jit() : dump_info_on_shutdown_(false),
              memory_use_("Memory used for compilation", 16),
              lock_("JIT memory use lock"),
              use_jit_compilation_(true),
+             use_branch_profiling_(false),
              hot_method_threshold_(0),
              warm_method_threshold_(0),
              osr_method_threshold_(0),
              priority_thread_weight_(0),
-             invoke_transition_weight_(0) {}
+             invoke_transition_weight_(0),
+             large_method_threshold_(0),
+             compiling_large_method_(false) {}
 
 Jit* Jit::Create(JitOptions* options, std::string* error_msg) {
   DCHECK(options->UseJitCompilation() || options->GetProfileSaverOptions().IsEnabled());
@@ -191,12 +211,20 @@ Jit* Jit::Create(JitOptions* options, std::string* error_msg) {
   if (jit->GetCodeCache() == nullptr) {
     return nullptr;
   }
+  if (!options->GetTelemetryFile().empty()) {
+    jit->telemetry_.reset(JitTelemetry::Create(options->GetTelemetryFile(), error_msg));
+    if (jit->telemetry_ == nullptr) {
+      return nullptr;
+    }
+  }
   jit->use_jit_compilation_ = options->UseJitCompilation();
+  jit->use_branch_profiling_ = options->UseBranchProfiling();
   jit->profile_saver_options_ = options->GetProfileSaverOptions();
   VLOG(jit) << "JIT created with initial_capacity="
       << PrettySize(options->GetCodeCacheInitialCapacity())
       << ", max_capacity=" << PrettySize(options->GetCodeCacheMaxCapacity())
       << ", compile_threshold=" << options->GetCompileThreshold()
+      << ", large_method_threshold=" << options->GetLargeMethodThreshold()
       << ", profile_saver_options=" << options->GetProfileSaverOptions();
 
 
@@ -205,6 +233,7 @@ Jit* Jit::Create(JitOptions* options, std::string* error_msg) {
   jit->osr_method_threshold_ = options->GetOsrThreshold();
   jit->priority_thread_weight_ = options->GetPriorityThreadWeight();
   jit->invoke_transition_weight_ = options->GetInvokeTransitionWeight();
+  jit->large_method_threshold_ = options->GetLargeMethodThreshold();
 
   jit->CreateThreadPool();
 
@@ -269,13 +298,37 @@ bool Jit::LoadCompiler(std::string* error_msg) {
   return true;
 }
 
-bool Jit::CompileMethod(ArtMethod* method, Thread* self, bool osr) {
+bool Jit::CompileMethod(ArtMethod* method, Thread* self, bool osr, uint64_t queue_wait_ns) {
   DCHECK(Runtime::Current()->UseJitCompilation());
   DCHECK(!method->IsRuntimeMethod());
 
+  // If we get a request to compile a proxy method, we pass the actual Java method
+  // of that proxy method, as the compiler does not expect a proxy method.
+  ArtMethod* method_to_compile = method->GetInterfaceMethodIfProxy(kRuntimePointerSize);
+  JitCompilationEvent event(method_to_compile, osr, queue_wait_ns);
+  if (telemetry_ != nullptr) {
+    telemetry_->BeginCompilation(self, &event);
+  }
+  event.success = CompileMethodInternal(method, method_to_compile, self, osr, &event);
+  if (telemetry_ != nullptr) {
+    ProfilingInfo* info = method_to_compile->GetProfilingInfo(kRuntimePointerSize);
+    if (info != nullptr) {
+      event.deoptimizations = info->GetNumberOfDeoptimizations();
+    }
+    telemetry_->EndCompilation(self);
+  }
+  return event.success;
+}
+
+bool Jit::CompileMethodInternal(ArtMethod* method,
+                                ArtMethod* method_to_compile,
+                                Thread* self,
+                                bool osr,
+                                JitCompilationEvent* event) {
   // Don't compile the method if it has breakpoints.
   if (Dbg::IsDebuggerActive() && Dbg::MethodHasAnyBreakpoints(method)) {
     VLOG(jit) << "JIT not compiling " << method->PrettyMethod() << " due to breakpoint";
+    event->failure_reason = "Breakpoint";
     return false;
   }
 
@@ -283,20 +336,22 @@ bool Jit::CompileMethod(ArtMethod* method, Thread* self, bool osr) {
   instrumentation::Instrumentation* instrumentation = Runtime::Current()->GetInstrumentation();
   if (instrumentation->AreAllMethodsDeoptimized() || instrumentation->IsDeoptimized(method)) {
     VLOG(jit) << "JIT not compiling " << method->PrettyMethod() << " due to deoptimization";
+    event->failure_reason = "Deoptimized";
     return false;
   }
 
-  // If we get a request to compile a proxy method, we pass the actual Java method
-  // of that proxy method, as the compiler does not expect a proxy method.
-  ArtMethod* method_to_compile = method->GetInterfaceMethodIfProxy(kRuntimePointerSize);
   if (!code_cache_->NotifyCompilationOf(method_to_compile, self, osr)) {
+    // Already compiled, being compiled, or without a ProfilingInfo.
+    event->failure_reason = "RejectedByCodeCache";
     return false;
   }
 
   VLOG(jit) << "Compiling method "
             << ArtMethod::PrettyMethod(method_to_compile)
             << " osr=" << std::boolalpha << osr;
+  uint64_t start_ns = NanoTime();
   bool success = jit_compile_method_(jit_compiler_handle_, method_to_compile, self, osr);
+  event->compile_time_ns = NanoTime() - start_ns;
   code_cache_->DoneCompiling(method_to_compile, self, osr);
   if (!success) {
     VLOG(jit) << "Failed to compile method "
@@ -595,7 +650,8 @@ class JitCompileTask FINAL : public Task {
     kCompileOsr
   };
 
-  JitCompileTask(ArtMethod* method, TaskKind kind) : method_(method), kind_(kind) {
+  JitCompileTask(ArtMethod* method, TaskKind kind)
+      : method_(method), kind_(kind), creation_time_ns_(NanoTime()) {
     ScopedObjectAccess soa(Thread::Current());
     // Add a global ref to the class to prevent class unloading until compilation is done.
     klass_ = soa.Vm()->AddGlobalRef(soa.Self(), method_->GetDeclaringClass());
@@ -609,10 +665,15 @@ class JitCompileTask FINAL : public Task {
 
   void Run(Thread* self) OVERRIDE {
     ScopedObjectAccess soa(self);
-    if (kind_ == kCompile) {
-      Runtime::Current()->GetJit()->CompileMethod(method_, self, /* osr */ false);
-    } else if (kind_ == kCompileOsr) {
-      Runtime::Current()->GetJit()->CompileMethod(method_, self, /* osr */ true);
+    uint64_t queue_wait_ns = NanoTime() - creation_time_ns_;
+    Jit* jit = Runtime::Current()->GetJit();
+    if (kind_ == kCompile || kind_ == kCompileOsr) {
+      bool osr = (kind_ == kCompileOsr);
+      if (jit->IsLargeMethod(method_)) {
+        jit->CompileLargeMethod(method_, self, osr, queue_wait_ns);
+      } else {
+        jit->CompileMethod(method_, self, osr, queue_wait_ns);
+      }
     } else {
       DCHECK(kind_ == kAllocateProfile);
       if (ProfilingInfo::Create(self, method_, /* retry_allocation */ true)) {
@@ -629,11 +690,48 @@ class JitCompileTask FINAL : public Task {
  private:
   ArtMethod* const method_;
   const TaskKind kind_;
+  const uint64_t creation_time_ns_;
   jobject klass_;
 
   DISALLOW_IMPLICIT_CONSTRUCTORS(JitCompileTask);
 };
 
+bool Jit::IsLargeMethod(ArtMethod* method) const {
+  return large_method_threshold_ != 0 &&
+      method->GetCodeItem()->insns_size_in_code_units_ >= large_method_threshold_;
+}
+
+void Jit::AddCompileTask(Thread* self, ArtMethod* method, bool osr) {
+  Task* task = new JitCompileTask(
+      method, osr ? JitCompileTask::kCompileOsr : JitCompileTask::kCompile);
+  if (IsLargeMethod(method)) {
+    // Only compile large methods once no other method is waiting for the JIT, or once
+    // the thread pool has aged the task.
+    thread_pool_->AddLowPriorityTask(self, task);
+  } else {
+    thread_pool_->AddTask(self, task);
+    // The method waits for the large method being compiled, if any: compile that one
+    // at foreground priority, so that the method does not wait at background priority.
+    if (compiling_large_method_.LoadSequentiallyConsistent()) {
+      thread_pool_->SetPthreadPriority(kJitPoolThreadPthreadPriority);
+    }
+  }
+}
+
+void Jit::CompileLargeMethod(ArtMethod* method, Thread* self, bool osr, uint64_t queue_wait_ns) {
+  // Large methods are compiled at background priority, so that they do not compete with
+  // the app's threads. The JIT thread pool has a single worker, which this runs on.
+  compiling_large_method_.StoreSequentiallyConsistent(true);
+  thread_pool_->SetPthreadPriority(kJitLargeMethodPthreadPriority);
+  // A method enqueued before we set `compiling_large_method_` did not raise the priority.
+  if (thread_pool_->HasPendingNormalTasks(self)) {
+    thread_pool_->SetPthreadPriority(kJitPoolThreadPthreadPriority);
+  }
+  CompileMethod(method, self, osr, queue_wait_ns);
+  compiling_large_method_.StoreSequentiallyConsistent(false);
+  thread_pool_->SetPthreadPriority(kJitPoolThreadPthreadPriority);
+}
+
 void Jit::AddSamples(Thread* self, ArtMethod* method, uint16_t count, bool with_backedges) {
   if (thread_pool_ == nullptr) {
     // Should only see this when shutting down.
@@ -685,7 +783,7 @@ void Jit::AddSamples(Thread* self, ArtMethod* method, uint16_t count, bool with_
       if ((new_count >= hot_method_threshold_) &&
           !code_cache_->ContainsPc(method->GetEntryPointFromQuickCompiledCode())) {
         DCHECK(thread_pool_ != nullptr);
-        thread_pool_->AddTask(self, new JitCompileTask(method, JitCompileTask::kCompile));
+        AddCompileTask(self, method, /* osr */ false);
       }
       // Avoid jumping more than one state at a time.
       new_count = std::min(new_count, osr_method_threshold_ - 1);
@@ -696,7 +794,7 @@ void Jit::AddSamples(Thread* self, ArtMethod* method, uint16_t count, bool with_
       }
       if ((new_count >= osr_method_threshold_) &&  !code_cache_->IsOsrCompiled(method)) {
         DCHECK(thread_pool_ != nullptr);
-        thread_pool_->AddTask(self, new JitCompileTask(method, JitCompileTask::kCompileOsr));
+        AddCompileTask(self, method, /* osr */ true);
       }
     }
   }
@@ -737,6 +835,14 @@ void Jit::InvokeVirtualOrInterface(ObjPtr<mirror::Object> this_object,
   }
 }
 
+void Jit::BranchTaken(ArtMethod* method, uint32_t dex_pc, uint32_t target_index) {
+  DCHECK(use_branch_profiling_);
+  ProfilingInfo* info = method->GetProfilingInfo(kRuntimePointerSize);
+  if (info != nullptr) {
+    info->AddBranchInfo(dex_pc, target_index);
+  }
+}
+
 void Jit::WaitForCompilationToFinish(Thread* self) {
   if (thread_pool_ != nullptr) {
     thread_pool_->Wait(self, false, false);
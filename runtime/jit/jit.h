@@ -17,6 +17,7 @@
 #ifndef ART_RUNTIME_JIT_JIT_H_
 #define ART_RUNTIME_JIT_JIT_H_
 
+#include "atomic.h"
 #include "base/histogram-inl.h"
 #include "base/macros.h"
 #include "base/mutex.h"
@@ -41,7 +42,9 @@ class Class;
 namespace jit {
 
 class JitCodeCache;
+struct JitCompilationEvent;
 class JitOptions;
+class JitTelemetry;
 
 static constexpr int16_t kJitCheckForOSR = -1;
 static constexpr int16_t kJitHotnessDisabled = -2;
@@ -55,7 +58,8 @@ class Jit {
 
   virtual ~Jit();
   static Jit* Create(JitOptions* options, std::string* error_msg);
-  bool CompileMethod(ArtMethod* method, Thread* self, bool osr)
+  // `queue_wait_ns` is how long the compilation request waited for a JIT thread.
+  bool CompileMethod(ArtMethod* method, Thread* self, bool osr, uint64_t queue_wait_ns = 0u)
       REQUIRES_SHARED(Locks::mutator_lock_);
   void CreateThreadPool();
 
@@ -71,6 +75,10 @@ class Jit {
   // Dump interesting info: #methods compiled, code vs data size, compile / verify cumulative
   // loggers.
   void DumpInfo(std::ostream& os) REQUIRES(!lock_);
+
+  // Return the compilation in progress on `self` when per-method telemetry is
+  // enabled, for the compiler to fill in the details. Return null otherwise.
+  JitCompilationEvent* GetCurrentCompilationEvent(Thread* self);
   // Add a timing logger to cumulative_timings_.
   void AddTimingLogger(const TimingLogger& logger);
 
@@ -103,6 +111,11 @@ class Jit {
     return profile_saver_options_.IsEnabled();
   }
 
+  // Returns whether the interpreter records branch and switch targets in the ProfilingInfo.
+  bool UseBranchProfiling() const {
+    return use_branch_profiling_;
+  }
+
   // Wait until there is no more pending compilation tasks.
   void WaitForCompilationToFinish(Thread* self);
 
@@ -119,6 +132,9 @@ class Jit {
                                 ArtMethod* callee)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  void BranchTaken(ArtMethod* method, uint32_t dex_pc, uint32_t target_index)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   void NotifyInterpreterToCompiledCodeTransition(Thread* self, ArtMethod* caller)
       REQUIRES_SHARED(Locks::mutator_lock_) {
     AddSamples(self, caller, invoke_transition_weight_, false);
@@ -171,6 +187,10 @@ class Jit {
     return thread_pool_.get();
   }
 
+  // Whether `method` has at least `large_method_threshold_` code units. Large methods are
+  // compiled at low priority, after the other methods waiting for the JIT.
+  bool IsLargeMethod(ArtMethod* method) const REQUIRES_SHARED(Locks::mutator_lock_);
+
   // Stop the JIT by waiting for all current compilations and enqueued compilations to finish.
   void Stop();
 
@@ -182,6 +202,22 @@ class Jit {
 
   static bool LoadCompiler(std::string* error_msg);
 
+  bool CompileMethodInternal(ArtMethod* method,
+                             ArtMethod* method_to_compile,
+                             Thread* self,
+                             bool osr,
+                             JitCompilationEvent* event)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Enqueue the compilation of `method` on the JIT thread pool.
+  void AddCompileTask(Thread* self, ArtMethod* method, bool osr)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
+  // Compile the large method `method` on the JIT thread at background priority, unless
+  // another method is waiting for the JIT.
+  void CompileLargeMethod(ArtMethod* method, Thread* self, bool osr, uint64_t queue_wait_ns)
+      REQUIRES_SHARED(Locks::mutator_lock_);
+
   // JIT compiler
   static void* jit_library_handle_;
   static void* jit_compiler_handle_;
@@ -198,7 +234,11 @@ class Jit {
 
   std::unique_ptr<jit::JitCodeCache> code_cache_;
 
+  // Per-method compilation telemetry, if requested with -Xjittelemetry.
+  std::unique_ptr<JitTelemetry> telemetry_;
+
   bool use_jit_compilation_;
+  bool use_branch_profiling_;
   ProfileSaverOptions profile_saver_options_;
   static bool generate_debug_info_;
   uint16_t hot_method_threshold_;
@@ -206,7 +246,11 @@ class Jit {
   uint16_t osr_method_threshold_;
   uint16_t priority_thread_weight_;
   uint16_t invoke_transition_weight_;
+  uint32_t large_method_threshold_;
   std::unique_ptr<ThreadPool> thread_pool_;
+  // Whether the JIT thread is compiling a large method. The thread then runs at background
+  // priority until another method is enqueued.
+  Atomic<bool> compiling_large_method_;
 
   DISALLOW_COPY_AND_ASSIGN(Jit);
 };
@@ -238,6 +282,15 @@ class JitOptions {
   bool DumpJitInfoOnShutdown() const {
     return dump_info_on_shutdown_;
   }
+  bool UseBranchProfiling() const {
+    return use_branch_profiling_;
+  }
+  uint32_t GetLargeMethodThreshold() const {
+    return large_method_threshold_;
+  }
+  const std::string& GetTelemetryFile() const {
+    return telemetry_file_;
+  }
   const ProfileSaverOptions& GetProfileSaverOptions() const {
     return profile_saver_options_;
   }
@@ -268,6 +321,9 @@ class JitOptions {
   uint16_t priority_thread_weight_;
   size_t invoke_transition_weight_;
   bool dump_info_on_shutdown_;
+  bool use_branch_profiling_;
+  uint32_t large_method_threshold_;
+  std::string telemetry_file_;
   ProfileSaverOptions profile_saver_options_;
 
   JitOptions()
@@ -279,7 +335,9 @@ class JitOptions {
         osr_threshold_(0),
         priority_thread_weight_(0),
         invoke_transition_weight_(0),
-        dump_info_on_shutdown_(false) {}
+        dump_info_on_shutdown_(false),
+        use_branch_profiling_(false),
+        large_method_threshold_(0) {}
 
   DISALLOW_COPY_AND_ASSIGN(JitOptions);
 };
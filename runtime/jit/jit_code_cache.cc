@@ -16,6 +16,7 @@
 
 #include "jit_code_cache.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "arch/context.h"
@@ -518,23 +519,47 @@ void JitCodeCache::DisallowInlineCacheAccess() {
 }
 
 void JitCodeCache::CopyInlineCacheInto(const InlineCache& ic,
-                                       Handle<mirror::ObjectArray<mirror::Class>> array) {
+                                       Handle<mirror::ObjectArray<mirror::Class>> array,
+                                       InlineCacheCounts* counts) {
   WaitUntilInlineCacheAccessible(Thread::Current());
   // Note that we don't need to lock `lock_` here, the compiler calling
   // this method has already ensured the inline cache will not be deleted.
-  for (size_t in_cache = 0, in_array = 0;
-       in_cache < InlineCache::kIndividualCacheSize;
-       ++in_cache) {
-    mirror::Class* object = ic.classes_[in_cache].Read();
+  // The interpreter keeps updating the cache, so read each receiver and its hit count
+  // once, and copy the receivers ordered by decreasing hit count, so that the compiler
+  // checks for the most frequent types first.
+  std::pair<mirror::Class*, uint32_t> entries[InlineCache::kIndividualCacheSize];
+  size_t num_entries = 0u;
+  uint32_t miss_count = ic.miss_count_;
+  for (size_t i = 0; i < InlineCache::kIndividualCacheSize; ++i) {
+    uint32_t hit_count = ic.hit_counts_[i];
+    mirror::Class* object = ic.classes_[i].Read();
     if (object != nullptr) {
-      array->Set(in_array++, object);
+      entries[num_entries++] = std::make_pair(object, hit_count);
+    } else {
+      // The class was unloaded, or the entry is still being filled.
+      miss_count += hit_count;
+    }
+  }
+  std::stable_sort(entries,
+                   entries + num_entries,
+                   [](const std::pair<mirror::Class*, uint32_t>& lhs,
+                      const std::pair<mirror::Class*, uint32_t>& rhs) {
+                     return lhs.second > rhs.second;
+                   });
+  for (size_t i = 0; i < num_entries; ++i) {
+    array->Set(i, entries[i].first);
+  }
+  if (counts != nullptr) {
+    for (size_t i = 0; i < InlineCache::kIndividualCacheSize; ++i) {
+      counts->hit_counts[i] = (i < num_entries) ? entries[i].second : 0u;
     }
+    counts->miss_count = miss_count;
   }
 }
 
 static void ClearMethodCounter(ArtMethod* method, bool was_warm) {
   if (was_warm) {
-    method->AddAccessFlags(kAccPreviouslyWarm);
+    method->SetPreviouslyWarm();
   }
   // We reset the counter to 1 so that the profile knows that the method was executed at least once.
   // This is required for layout purposes.
@@ -1263,10 +1288,12 @@ OatQuickMethodHeader* JitCodeCache::LookupOsrMethodHeader(ArtMethod* method) {
   return OatQuickMethodHeader::FromCodePointer(it->second);
 }
 
-ProfilingInfo* JitCodeCache::AddProfilingInfo(Thread* self,
-                                              ArtMethod* method,
-                                              const std::vector<uint32_t>& entries,
-                                              bool retry_allocation)
+ProfilingInfo* JitCodeCache::AddProfilingInfo(
+    Thread* self,
+    ArtMethod* method,
+    const std::vector<uint32_t>& entries,
+    const std::vector<std::pair<uint32_t, uint32_t>>& branch_entries,
+    bool retry_allocation)
     // No thread safety analysis as we are using TryLock/Unlock explicitly.
     NO_THREAD_SAFETY_ANALYSIS {
   ProfilingInfo* info = nullptr;
@@ -1274,29 +1301,31 @@ ProfilingInfo* JitCodeCache::AddProfilingInfo(Thread* self,
     // If we are allocating for the interpreter, just try to lock, to avoid
     // lock contention with the JIT.
     if (lock_.ExclusiveTryLock(self)) {
-      info = AddProfilingInfoInternal(self, method, entries);
+      info = AddProfilingInfoInternal(self, method, entries, branch_entries);
       lock_.ExclusiveUnlock(self);
     }
   } else {
     {
       MutexLock mu(self, lock_);
-      info = AddProfilingInfoInternal(self, method, entries);
+      info = AddProfilingInfoInternal(self, method, entries, branch_entries);
     }
 
     if (info == nullptr) {
       GarbageCollectCache(self);
       MutexLock mu(self, lock_);
-      info = AddProfilingInfoInternal(self, method, entries);
+      info = AddProfilingInfoInternal(self, method, entries, branch_entries);
     }
   }
   return info;
 }
 
-ProfilingInfo* JitCodeCache::AddProfilingInfoInternal(Thread* self ATTRIBUTE_UNUSED,
-                                                      ArtMethod* method,
-                                                      const std::vector<uint32_t>& entries) {
+ProfilingInfo* JitCodeCache::AddProfilingInfoInternal(
+    Thread* self ATTRIBUTE_UNUSED,
+    ArtMethod* method,
+    const std::vector<uint32_t>& entries,
+    const std::vector<std::pair<uint32_t, uint32_t>>& branch_entries) {
   size_t profile_info_size = RoundUp(
-      sizeof(ProfilingInfo) + sizeof(InlineCache) * entries.size(),
+      ProfilingInfo::ComputeSize(entries, branch_entries),
       sizeof(void*));
 
   // Check whether some other thread has concurrently created it.
@@ -1309,7 +1338,7 @@ ProfilingInfo* JitCodeCache::AddProfilingInfoInternal(Thread* self ATTRIBUTE_UNU
   if (data == nullptr) {
     return nullptr;
   }
-  info = new (data) ProfilingInfo(method, entries);
+  info = new (data) ProfilingInfo(method, entries, branch_entries);
 
   // Make sure other threads see the data in the profiling info object before the
   // store in the ArtMethod's ProfilingInfo pointer.
@@ -1477,6 +1506,15 @@ void JitCodeCache::DoneCompiling(ArtMethod* method, Thread* self ATTRIBUTE_UNUSE
   info->SetIsMethodBeingCompiled(false, osr);
 }
 
+void JitCodeCache::RecordDeoptimization(ArtMethod* method) {
+  ProfilingInfo* profiling_info = method->GetProfilingInfo(kRuntimePointerSize);
+  if (profiling_info != nullptr && profiling_info->AddDeoptimization()) {
+    VLOG(jit) << "Disabling speculative optimizations for " << method->PrettyMethod()
+              << " after " << ProfilingInfo::kMaxDeoptimizationsBeforeNoSpeculation
+              << " deoptimizations";
+  }
+}
+
 size_t JitCodeCache::GetMemorySizeOfCodePointer(const void* ptr) {
   MutexLock mu(Thread::Current(), lock_);
   return mspace_usable_size(reinterpret_cast<const void*>(FromCodeToAllocation(ptr)));
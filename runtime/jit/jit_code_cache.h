@@ -38,6 +38,7 @@ namespace art {
 class ArtMethod;
 class LinearAlloc;
 class InlineCache;
+struct InlineCacheCounts;
 class IsMarkedVisitor;
 class OatQuickMethodHeader;
 class ProfilingInfo;
@@ -183,7 +184,11 @@ class JitCodeCache {
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
-  void CopyInlineCacheInto(const InlineCache& ic, Handle<mirror::ObjectArray<mirror::Class>> array)
+  // Copy the receivers of `ic` into `array`, ordered by decreasing hit count, and their hit
+  // counts into `counts` if not null.
+  void CopyInlineCacheInto(const InlineCache& ic,
+                           Handle<mirror::ObjectArray<mirror::Class>> array,
+                           InlineCacheCounts* counts = nullptr)
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
@@ -192,6 +197,7 @@ class JitCodeCache {
   ProfilingInfo* AddProfilingInfo(Thread* self,
                                   ArtMethod* method,
                                   const std::vector<uint32_t>& entries,
+                                  const std::vector<std::pair<uint32_t, uint32_t>>& branch_entries,
                                   bool retry_allocation)
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
@@ -221,6 +227,10 @@ class JitCodeCache {
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Record that speculative compiled code of `method` deoptimized, so that the method stops
+  // being compiled with speculative optimizations after a deoptimization storm.
+  void RecordDeoptimization(ArtMethod* method) REQUIRES_SHARED(Locks::mutator_lock_);
+
   void Dump(std::ostream& os) REQUIRES(!lock_);
 
   bool IsOsrCompiled(ArtMethod* method) REQUIRES(!lock_);
@@ -275,9 +285,11 @@ class JitCodeCache {
       REQUIRES(!lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
-  ProfilingInfo* AddProfilingInfoInternal(Thread* self,
-                                          ArtMethod* method,
-                                          const std::vector<uint32_t>& entries)
+  ProfilingInfo* AddProfilingInfoInternal(
+      Thread* self,
+      ArtMethod* method,
+      const std::vector<uint32_t>& entries,
+      const std::vector<std::pair<uint32_t, uint32_t>>& branch_entries)
       REQUIRES(lock_)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
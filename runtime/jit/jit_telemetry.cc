@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "jit_telemetry.h"
+
+#include <algorithm>
+#include <ostream>
+#include <sstream>
+
+#include "art_method-inl.h"
+#include "base/time_utils.h"
+#include "base/unix_file/fd_file.h"
+#include "thread-current-inl.h"
+#include "utils.h"
+
+namespace art {
+namespace jit {
+
+// Method names and compiler pass names do not contain control characters, so
+// escaping quotes and backslashes is enough to produce valid JSON strings.
+static void DumpJsonString(std::ostream& os, const std::string& str) {
+  os << '"';
+  for (char c : str) {
+    if (c == '"' || c == '\\') {
+      os << '\\';
+    }
+    os << c;
+  }
+  os << '"';
+}
+
+JitTelemetry* JitTelemetry::Create(const std::string& filename, std::string* error_msg) {
+  std::unique_ptr<File> file(OS::CreateEmptyFileWriteOnly(filename.c_str()));
+  if (file == nullptr) {
+    *error_msg = "Could not create JIT telemetry file " + filename;
+    return nullptr;
+  }
+  return new JitTelemetry(file.release());
+}
+
+JitTelemetry::JitTelemetry(File* file)
+    : lock_("JIT telemetry lock"),
+      file_(file),
+      number_of_compilations_(0u),
+      number_of_failures_(0u),
+      total_queue_wait_ns_(0u),
+      total_compile_time_ns_(0u),
+      max_compile_time_ns_(0u),
+      max_arena_bytes_(0u) {}
+
+JitTelemetry::~JitTelemetry() {
+  MutexLock mu(Thread::Current(), lock_);
+  DCHECK(current_compilations_.empty());
+  if (file_->FlushCloseOrErase() != 0) {
+    PLOG(WARNING) << "Could not close JIT telemetry file " << file_->GetPath();
+  }
+}
+
+void JitTelemetry::BeginCompilation(Thread* self, JitCompilationEvent* event) {
+  MutexLock mu(self, lock_);
+  DCHECK(current_compilations_.find(self) == current_compilations_.end());
+  current_compilations_.emplace(self, event);
+}
+
+JitCompilationEvent* JitTelemetry::GetCurrentCompilation(Thread* self) {
+  MutexLock mu(self, lock_);
+  auto it = current_compilations_.find(self);
+  return (it == current_compilations_.end()) ? nullptr : it->second;
+}
+
+void JitTelemetry::EndCompilation(Thread* self) {
+  JitCompilationEvent* event = GetCurrentCompilation(self);
+  DCHECK(event != nullptr);
+  std::string method_name = event->method->PrettyMethod();
+
+  std::ostringstream line;
+  line << "{\"method\":";
+  DumpJsonString(line, method_name);
+  line << ",\"osr\":" << std::boolalpha << event->osr
+       << ",\"success\":" << event->success;
+  if (!event->failure_reason.empty()) {
+    line << ",\"failure_reason\":";
+    DumpJsonString(line, event->failure_reason);
+  }
+  line << ",\"queue_wait_ns\":" << event->queue_wait_ns
+       << ",\"compile_time_ns\":" << event->compile_time_ns
+       << ",\"arena_bytes\":" << event->arena_bytes
+       << ",\"code_size\":" << event->code_size
+       << ",\"deoptimizations\":" << event->deoptimizations
+       << ",\"passes\":{";
+  const char* separator = "";
+  for (const std::pair<std::string, uint64_t>& pass : event->pass_times_ns) {
+    line << separator;
+    DumpJsonString(line, pass.first);
+    line << ':' << pass.second;
+    separator = ",";
+  }
+  line << "},\"stats\":{";
+  separator = "";
+  for (const std::pair<std::string, uint32_t>& stat : event->compiler_stats) {
+    line << separator;
+    DumpJsonString(line, stat.first);
+    line << ':' << stat.second;
+    separator = ",";
+  }
+  line << "}}\n";
+  std::string str = line.str();
+
+  MutexLock mu(self, lock_);
+  current_compilations_.erase(self);
+  if (!file_->WriteFully(str.c_str(), str.size())) {
+    PLOG(WARNING) << "Could not write to JIT telemetry file " << file_->GetPath();
+  }
+  ++number_of_compilations_;
+  if (!event->success) {
+    ++number_of_failures_;
+    ++failure_reasons_[event->failure_reason.empty() ? "unknown" : event->failure_reason];
+  }
+  total_queue_wait_ns_ += event->queue_wait_ns;
+  total_compile_time_ns_ += event->compile_time_ns;
+  if (event->compile_time_ns > max_compile_time_ns_) {
+    max_compile_time_ns_ = event->compile_time_ns;
+    slowest_method_ = method_name;
+  }
+  max_arena_bytes_ = std::max(max_arena_bytes_, event->arena_bytes);
+}
+
+void JitTelemetry::DumpInfo(std::ostream& os) {
+  MutexLock mu(Thread::Current(), lock_);
+  os << "JIT telemetry: " << number_of_compilations_ << " compilations, "
+     << number_of_failures_ << " failed\n";
+  if (number_of_compilations_ == 0u) {
+    return;
+  }
+  os << "JIT telemetry: average queue wait "
+     << PrettyDuration(total_queue_wait_ns_ / number_of_compilations_)
+     << ", average compile time "
+     << PrettyDuration(total_compile_time_ns_ / number_of_compilations_)
+     << ", max compile time " << PrettyDuration(max_compile_time_ns_)
+     << " (" << slowest_method_ << ")"
+     << ", max arena usage " << PrettySize(max_arena_bytes_) << "\n";
+  for (const auto& reason : failure_reasons_) {
+    os << "JIT telemetry: not compiled because of " << reason.first << ": "
+       << reason.second << "\n";
+  }
+}
+
+}  // namespace jit
+}  // namespace art
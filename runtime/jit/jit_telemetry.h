@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef ART_RUNTIME_JIT_JIT_TELEMETRY_H_
+#define ART_RUNTIME_JIT_JIT_TELEMETRY_H_
+
+#include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/macros.h"
+#include "base/mutex.h"
+#include "os.h"
+
+namespace art {
+
+class ArtMethod;
+class Thread;
+
+namespace jit {
+
+// What happened to one request to JIT compile a method. The runtime fills in
+// the timings and the outcome, the compiler the details of the compilation.
+struct JitCompilationEvent {
+  JitCompilationEvent(ArtMethod* m, bool is_osr, uint64_t wait_ns)
+      : method(m),
+        osr(is_osr),
+        success(false),
+        queue_wait_ns(wait_ns),
+        compile_time_ns(0u),
+        arena_bytes(0u),
+        code_size(0u),
+        deoptimizations(0u) {}
+
+  ArtMethod* const method;
+  const bool osr;
+  bool success;
+  // Why the method was not compiled, empty on success or if unknown.
+  std::string failure_reason;
+  // Time between the compilation request and the start of the compilation.
+  const uint64_t queue_wait_ns;
+  uint64_t compile_time_ns;
+  // Time spent in each compiler pass, in execution order.
+  std::vector<std::pair<std::string, uint64_t>> pass_times_ns;
+  // Peak arena memory taken by the compiler from the JIT arena pool, including the
+  // arenas of the allocators local to compiler passes.
+  size_t arena_bytes;
+  size_t code_size;
+  // Compiler statistics recorded for this method only, for example inlining decisions.
+  std::vector<std::pair<std::string, uint32_t>> compiler_stats;
+  // Number of times previously compiled code of the method has been deoptimized.
+  uint32_t deoptimizations;
+};
+
+// Writes one JSON object per JIT compilation to a file, and keeps a summary
+// of all compilations for SIGQUIT dumps.
+class JitTelemetry {
+ public:
+  static JitTelemetry* Create(const std::string& filename, std::string* error_msg);
+
+  ~JitTelemetry();
+
+  // Make `event` the compilation in progress on `self`.
+  void BeginCompilation(Thread* self, JitCompilationEvent* event) REQUIRES(!lock_);
+
+  // Return the compilation in progress on `self`, or null if there is none.
+  JitCompilationEvent* GetCurrentCompilation(Thread* self) REQUIRES(!lock_);
+
+  // Log the compilation in progress on `self` and add it to the summary.
+  void EndCompilation(Thread* self) REQUIRES(!lock_) REQUIRES_SHARED(Locks::mutator_lock_);
+
+  void DumpInfo(std::ostream& os) REQUIRES(!lock_);
+
+ private:
+  explicit JitTelemetry(File* file);
+
+  Mutex lock_ DEFAULT_MUTEX_ACQUIRED_AFTER;
+  std::unique_ptr<File> file_ GUARDED_BY(lock_);
+  std::map<Thread*, JitCompilationEvent*> current_compilations_ GUARDED_BY(lock_);
+
+  // Summary of the compilations done so far.
+  size_t number_of_compilations_ GUARDED_BY(lock_);
+  size_t number_of_failures_ GUARDED_BY(lock_);
+  uint64_t total_queue_wait_ns_ GUARDED_BY(lock_);
+  uint64_t total_compile_time_ns_ GUARDED_BY(lock_);
+  uint64_t max_compile_time_ns_ GUARDED_BY(lock_);
+  std::string slowest_method_ GUARDED_BY(lock_);
+  size_t max_arena_bytes_ GUARDED_BY(lock_);
+  std::map<std::string, size_t> failure_reasons_ GUARDED_BY(lock_);
+
+  DISALLOW_COPY_AND_ASSIGN(JitTelemetry);
+};
+
+}  // namespace jit
+}  // namespace art
+
+#endif  // ART_RUNTIME_JIT_JIT_TELEMETRY_H_
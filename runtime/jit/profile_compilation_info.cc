@@ -50,6 +50,8 @@ const uint8_t ProfileCompilationInfo::kProfileMagic[] = { 'p', 'r', 'o', '\0' };
 // Last profile version: update the multidex separator.
 const uint8_t ProfileCompilationInfo::kProfileVersion[] = { '0', '0', '9', '\0' };
 
+constexpr uint8_t ProfileCompilationInfo::kIndividualInlineCacheSize;
+
 static constexpr uint16_t kMaxDexFileKeyLength = PATH_MAX;
 
 // Debug flag to ignore checksums when testing if a method or a class is present in the profile.
@@ -60,12 +62,12 @@ static constexpr bool kDebugIgnoreChecksum = false;
 static constexpr uint8_t kIsMissingTypesEncoding = 6;
 static constexpr uint8_t kIsMegamorphicEncoding = 7;
 
-static_assert(sizeof(InlineCache::kIndividualCacheSize) == sizeof(uint8_t),
-              "InlineCache::kIndividualCacheSize does not have the expect type size");
-static_assert(InlineCache::kIndividualCacheSize < kIsMegamorphicEncoding,
-              "InlineCache::kIndividualCacheSize is larger than expected");
-static_assert(InlineCache::kIndividualCacheSize < kIsMissingTypesEncoding,
-              "InlineCache::kIndividualCacheSize is larger than expected");
+static_assert(sizeof(ProfileCompilationInfo::kIndividualInlineCacheSize) == sizeof(uint8_t),
+              "kIndividualInlineCacheSize does not have the expect type size");
+static_assert(ProfileCompilationInfo::kIndividualInlineCacheSize < kIsMegamorphicEncoding,
+              "kIndividualInlineCacheSize is larger than expected");
+static_assert(ProfileCompilationInfo::kIndividualInlineCacheSize < kIsMissingTypesEncoding,
+              "kIndividualInlineCacheSize is larger than expected");
 
 static bool ChecksumMatch(uint32_t dex_file_checksum, uint32_t checksum) {
   return kDebugIgnoreChecksum || dex_file_checksum == checksum;
@@ -110,7 +112,7 @@ void ProfileCompilationInfo::DexPcData::AddClass(uint16_t dex_profile_idx,
   }
 
   // Check if the adding the type will cause the cache to become megamorphic.
-  if (classes.size() + 1 >= InlineCache::kIndividualCacheSize) {
+  if (classes.size() + 1 >= kIndividualInlineCacheSize) {
     is_megamorphic = true;
     classes.clear();
     return;
@@ -462,7 +464,7 @@ void ProfileCompilationInfo::AddInlineCacheToBuffer(std::vector<uint8_t>* buffer
       continue;
     }
 
-    DCHECK_LT(classes.size(), InlineCache::kIndividualCacheSize);
+    DCHECK_LT(classes.size(), kIndividualInlineCacheSize);
     DCHECK_NE(classes.size(), 0u) << "InlineCache contains a dex_pc with 0 classes";
 
     SafeMap<uint8_t, std::vector<dex::TypeIndex>> dex_to_classes_map;
@@ -71,6 +71,11 @@ class ProfileCompilationInfo {
   static const uint8_t kProfileMagic[];
   static const uint8_t kProfileVersion[];
 
+  // Maximum number of classes (exclusive) recorded for a dex pc in the offline profile,
+  // after which the inline cache is considered megamorphic. This is part of the
+  // profile format and is independent of the size of the JIT's InlineCache.
+  static constexpr uint8_t kIndividualInlineCacheSize = 5;
+
   // Data structures for encoding the offline representation of inline caches.
   // This is exposed as public in order to make it available to dex2oat compilations
   // (see compiler/optimizing/inliner.cc).
@@ -142,7 +142,7 @@ class ProfileCompilationInfoTest : public CommonRuntimeTest {
       // Polymorphic
       for (uint16_t dex_pc = 11; dex_pc < 22; dex_pc++) {
         std::vector<TypeReference> classes;
-        for (uint16_t k = 0; k < InlineCache::kIndividualCacheSize / 2; k++) {
+        for (uint16_t k = 0; k < ProfileCompilationInfo::kIndividualInlineCacheSize / 2; k++) {
           classes.emplace_back(method->GetDexFile(), dex::TypeIndex(k));
         }
         caches.emplace_back(dex_pc, /*is_missing_types*/false, classes);
@@ -150,7 +150,7 @@ class ProfileCompilationInfoTest : public CommonRuntimeTest {
       // Megamorphic
       for (uint16_t dex_pc = 22; dex_pc < 33; dex_pc++) {
         std::vector<TypeReference> classes;
-        for (uint16_t k = 0; k < 2 * InlineCache::kIndividualCacheSize; k++) {
+        for (uint16_t k = 0; k < 2 * ProfileCompilationInfo::kIndividualInlineCacheSize; k++) {
           classes.emplace_back(method->GetDexFile(), dex::TypeIndex(k));
         }
         caches.emplace_back(dex_pc, /*is_missing_types*/false, classes);
@@ -254,7 +254,7 @@ class ProfileCompilationInfoTest : public CommonRuntimeTest {
     ProfileCompilationInfo::InlineCacheMap* ic_map =
         const_cast<ProfileCompilationInfo::InlineCacheMap*>(pmi->inline_caches);
     for (auto it : *ic_map) {
-      for (uint16_t k = 0; k <= 2 * InlineCache::kIndividualCacheSize; k++) {
+      for (uint16_t k = 0; k <= 2 * ProfileCompilationInfo::kIndividualInlineCacheSize; k++) {
         it.second.AddClass(0, dex::TypeIndex(k));
       }
     }
@@ -16,7 +16,10 @@
 
 #include "profiling_info.h"
 
+#include <algorithm>
+
 #include "art_method-inl.h"
+#include "bytecode_utils.h"
 #include "dex_instruction.h"
 #include "jit/jit.h"
 #include "jit/jit_code_cache.h"
@@ -25,17 +28,42 @@
 
 namespace art {
 
-ProfilingInfo::ProfilingInfo(ArtMethod* method, const std::vector<uint32_t>& entries)
+ProfilingInfo::ProfilingInfo(ArtMethod* method,
+                             const std::vector<uint32_t>& entries,
+                             const std::vector<BranchEntry>& branch_entries)
       : number_of_inline_caches_(entries.size()),
+        number_of_branch_caches_(branch_entries.size()),
         method_(method),
         is_method_being_compiled_(false),
         is_osr_method_being_compiled_(false),
         current_inline_uses_(0),
+        number_of_deoptimizations_(0),
         saved_entry_point_(nullptr) {
   memset(&cache_, 0, number_of_inline_caches_ * sizeof(InlineCache));
   for (size_t i = 0; i < number_of_inline_caches_; ++i) {
     cache_[i].dex_pc_ = entries[i];
   }
+  BranchCache* branch_caches = GetBranchCaches();
+  uint32_t number_of_counters = 0;
+  for (size_t i = 0; i < number_of_branch_caches_; ++i) {
+    branch_caches[i].dex_pc_ = branch_entries[i].first;
+    branch_caches[i].number_of_targets_ = branch_entries[i].second;
+    branch_caches[i].first_counter_ = number_of_counters;
+    number_of_counters += branch_entries[i].second;
+  }
+  memset(GetBranchCounters(), 0, number_of_counters * sizeof(uint32_t));
+}
+
+size_t ProfilingInfo::ComputeSize(const std::vector<uint32_t>& entries,
+                                  const std::vector<BranchEntry>& branch_entries) {
+  size_t number_of_counters = 0;
+  for (const BranchEntry& entry : branch_entries) {
+    number_of_counters += entry.second;
+  }
+  return sizeof(ProfilingInfo) +
+      sizeof(InlineCache) * entries.size() +
+      sizeof(BranchCache) * branch_entries.size() +
+      sizeof(uint32_t) * number_of_counters;
 }
 
 bool ProfilingInfo::Create(Thread* self, ArtMethod* method, bool retry_allocation) {
@@ -47,8 +75,12 @@ bool ProfilingInfo::Create(Thread* self, ArtMethod* method, bool retry_allocatio
   const uint16_t* code_ptr = code_item.insns_;
   const uint16_t* code_end = code_item.insns_ + code_item.insns_size_in_code_units_;
 
+  jit::Jit* jit = Runtime::Current()->GetJit();
+  const bool profile_branches = jit->UseBranchProfiling();
+
   uint32_t dex_pc = 0;
   std::vector<uint32_t> entries;
+  std::vector<BranchEntry> branch_entries;
   while (code_ptr < code_end) {
     const Instruction& instruction = *Instruction::At(code_ptr);
     switch (instruction.Opcode()) {
@@ -61,6 +93,33 @@ bool ProfilingInfo::Create(Thread* self, ArtMethod* method, bool retry_allocatio
         entries.push_back(dex_pc);
         break;
 
+      case Instruction::IF_EQ:
+      case Instruction::IF_NE:
+      case Instruction::IF_LT:
+      case Instruction::IF_GE:
+      case Instruction::IF_GT:
+      case Instruction::IF_LE:
+      case Instruction::IF_EQZ:
+      case Instruction::IF_NEZ:
+      case Instruction::IF_LTZ:
+      case Instruction::IF_GEZ:
+      case Instruction::IF_GTZ:
+      case Instruction::IF_LEZ:
+        if (profile_branches) {
+          // Taken and not taken.
+          branch_entries.emplace_back(dex_pc, 2u);
+        }
+        break;
+
+      case Instruction::PACKED_SWITCH:
+      case Instruction::SPARSE_SWITCH:
+        if (profile_branches) {
+          // All cases and the default.
+          DexSwitchTable table(instruction, dex_pc);
+          branch_entries.emplace_back(dex_pc, table.GetNumEntries() + 1u);
+        }
+        break;
+
       default:
         break;
     }
@@ -72,8 +131,9 @@ bool ProfilingInfo::Create(Thread* self, ArtMethod* method, bool retry_allocatio
   // interested in. The JIT code cache internally uses it.
 
   // Allocate the `ProfilingInfo` object int the JIT's data space.
-  jit::JitCodeCache* code_cache = Runtime::Current()->GetJit()->GetCodeCache();
-  return code_cache->AddProfilingInfo(self, method, entries, retry_allocation) != nullptr;
+  jit::JitCodeCache* code_cache = jit->GetCodeCache();
+  return code_cache->AddProfilingInfo(
+      self, method, entries, branch_entries, retry_allocation) != nullptr;
 }
 
 InlineCache* ProfilingInfo::GetInlineCache(uint32_t dex_pc) {
@@ -87,13 +147,39 @@ InlineCache* ProfilingInfo::GetInlineCache(uint32_t dex_pc) {
   UNREACHABLE();
 }
 
+const BranchCache* ProfilingInfo::GetBranchCache(uint32_t dex_pc) const {
+  // The branch caches are sorted by dex pc.
+  const BranchCache* begin = GetBranchCaches();
+  const BranchCache* end = begin + number_of_branch_caches_;
+  const BranchCache* it = std::lower_bound(
+      begin, end, dex_pc, [](const BranchCache& cache, uint32_t pc) {
+        return cache.dex_pc_ < pc;
+      });
+  return (it != end && it->dex_pc_ == dex_pc) ? it : nullptr;
+}
+
+void ProfilingInfo::AddBranchInfo(uint32_t dex_pc, uint32_t target_index) {
+  const BranchCache* cache = GetBranchCache(dex_pc);
+  if (cache == nullptr) {
+    // The ProfilingInfo was created before branch profiling was requested.
+    return;
+  }
+  DCHECK_LT(target_index, cache->number_of_targets_);
+  uint32_t* counter = &GetBranchCounters()[cache->first_counter_ + target_index];
+  // Like inline caches, the counters are updated without synchronization.
+  if (*counter != std::numeric_limits<uint32_t>::max()) {
+    ++(*counter);
+  }
+}
+
 void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
   InlineCache* cache = GetInlineCache(dex_pc);
   for (size_t i = 0; i < InlineCache::kIndividualCacheSize; ++i) {
     mirror::Class* existing = cache->classes_[i].Read<kWithoutReadBarrier>();
     mirror::Class* marked = ReadBarrier::IsMarked(existing);
     if (marked == cls) {
-      // Receiver type is already in the cache, nothing else to do.
+      // Receiver type is already in the cache, just record the hit.
+      cache->IncrementHitCount(&cache->hit_counts_[i]);
       return;
     } else if (marked == nullptr) {
       // Cache entry is empty, try to put `cls` in it.
@@ -108,13 +194,41 @@ void ProfilingInfo::AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls) {
         // entry in case the entry contains `cls`.
         --i;
       } else {
-        // We successfully set `cls`, just return.
+        // We successfully set `cls`, record its first hit and return.
+        cache->hit_counts_[i] = 1u;
         return;
       }
     }
   }
   // Unsuccessfull - cache is full, making it megamorphic. We do not DCHECK it though,
   // as the garbage collector might clear the entries concurrently.
+  cache->IncrementHitCount(&cache->miss_count_);
+}
+
+void InlineCache::IncrementHitCount(uint16_t* counter) {
+  // Note: the counters are updated without synchronization, they are only
+  // used as a heuristic by the compiler.
+  if (*counter == kMaxHitCount) {
+    for (size_t i = 0; i < kIndividualCacheSize; ++i) {
+      hit_counts_[i] >>= 1;
+    }
+    miss_count_ >>= 1;
+  }
+  ++(*counter);
+}
+
+bool InlineCacheCounts::IsDominatedBy(size_t number_of_entries, uint32_t percentage) const {
+  DCHECK_LE(number_of_entries, InlineCache::kIndividualCacheSize);
+  uint64_t total = miss_count;
+  uint64_t dominant = 0;
+  for (size_t i = 0; i < InlineCache::kIndividualCacheSize; ++i) {
+    DCHECK(i == 0u || hit_counts[i] <= hit_counts[i - 1]);
+    total += hit_counts[i];
+    if (i < number_of_entries) {
+      dominant += hit_counts[i];
+    }
+  }
+  return total != 0u && dominant * 100u >= total * percentage;
 }
 
 }  // namespace art
@@ -17,6 +17,8 @@
 #ifndef ART_RUNTIME_JIT_PROFILING_INFO_H_
 #define ART_RUNTIME_JIT_PROFILING_INFO_H_
 
+#include <limits>
+#include <utility>
 #include <vector>
 
 #include "base/macros.h"
@@ -37,13 +39,25 @@ class Class;
 
 // Structure to store the classes seen at runtime for a specific instruction.
 // Once the classes_ array is full, we consider the INVOKE to be megamorphic.
+// Each entry also keeps an approximate hit count, so that the compiler can still
+// specialize megamorphic call sites whose receiver distribution is skewed.
 class InlineCache {
  public:
-  static constexpr uint8_t kIndividualCacheSize = 5;
+  static constexpr uint8_t kIndividualCacheSize = 8;
 
  private:
+  // Saturation value of the hit counters. When one counter reaches it, all counters
+  // of the cache are halved, so that the distribution adapts to recent behavior.
+  static constexpr uint16_t kMaxHitCount = std::numeric_limits<uint16_t>::max();
+
+  void IncrementHitCount(uint16_t* counter);
+
   uint32_t dex_pc_;
   GcRoot<mirror::Class> classes_[kIndividualCacheSize];
+  // Number of times each receiver in `classes_` has been seen.
+  uint16_t hit_counts_[kIndividualCacheSize];
+  // Number of times a receiver not in `classes_` has been seen after the cache filled up.
+  uint16_t miss_count_;
 
   friend class jit::JitCodeCache;
   friend class ProfilingInfo;
@@ -51,17 +65,61 @@ class InlineCache {
   DISALLOW_COPY_AND_ASSIGN(InlineCache);
 };
 
+// Hit counts of the receivers copied out of an `InlineCache` by the compiler, taken in the
+// same snapshot as the receivers and in their order, i.e. by decreasing count. The hits of
+// receivers no longer in the cache, e.g. unloaded classes, are counted as misses.
+struct InlineCacheCounts {
+  // Returns whether the `number_of_entries` first receivers account for at least
+  // `percentage` percent of the calls recorded for the INVOKE.
+  bool IsDominatedBy(size_t number_of_entries, uint32_t percentage) const;
+
+  uint32_t hit_counts[InlineCache::kIndividualCacheSize];
+  uint32_t miss_count;
+};
+
+// Structure to store how many times each target of a conditional branch or
+// switch instruction has been taken at runtime. Targets are numbered like the
+// successors of the corresponding HIf (taken, not taken) or HPackedSwitch
+// (cases in table order, then default). The counters themselves are stored
+// after all branch caches of the ProfilingInfo.
+class BranchCache {
+ public:
+  uint32_t GetDexPc() const { return dex_pc_; }
+  uint32_t GetNumberOfTargets() const { return number_of_targets_; }
+
+ private:
+  uint32_t dex_pc_;
+  uint32_t number_of_targets_;
+  // Index of the counter of the first target in the ProfilingInfo counters.
+  uint32_t first_counter_;
+
+  friend class ProfilingInfo;
+
+  DISALLOW_COPY_AND_ASSIGN(BranchCache);
+};
+
 /**
  * Profiling info for a method, created and filled by the interpreter once the
  * method is warm, and used by the compiler to drive optimizations.
  */
 class ProfilingInfo {
  public:
+  // Number of deoptimizations of a method's compiled code after which we consider
+  // the method to be in a deoptimization storm.
+  static constexpr uint16_t kMaxDeoptimizationsBeforeNoSpeculation = 4;
+
+  // A branch instruction to profile: its dex pc and its number of targets.
+  using BranchEntry = std::pair<uint32_t, uint32_t>;
+
   // Create a ProfilingInfo for 'method'. Return whether it succeeded, or if it is
   // not needed in case the method does not have virtual/interface invocations.
   static bool Create(Thread* self, ArtMethod* method, bool retry_allocation)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Return the number of bytes needed for a ProfilingInfo with the given entries.
+  static size_t ComputeSize(const std::vector<uint32_t>& entries,
+                            const std::vector<BranchEntry>& branch_entries);
+
   // Add information from an executed INVOKE instruction to the profile.
   void AddInvokeInfo(uint32_t dex_pc, mirror::Class* cls)
       // Method should not be interruptible, as it manipulates the ProfilingInfo
@@ -73,10 +131,24 @@ class ProfilingInfo {
     return method_;
   }
 
+  // Add information from an executed conditional branch or switch instruction
+  // to the profile. Does nothing if branches are not profiled.
+  void AddBranchInfo(uint32_t dex_pc, uint32_t target_index);
+
   // Mutator lock only required for debugging output.
   InlineCache* GetInlineCache(uint32_t dex_pc)
       REQUIRES_SHARED(Locks::mutator_lock_);
 
+  // Return the branch cache for the instruction at `dex_pc`, or null if
+  // branches are not profiled.
+  const BranchCache* GetBranchCache(uint32_t dex_pc) const;
+
+  // Return how many times the target `target_index` of `cache` has been taken.
+  uint32_t GetBranchCount(const BranchCache& cache, uint32_t target_index) const {
+    DCHECK_LT(target_index, cache.number_of_targets_);
+    return GetBranchCounters()[cache.first_counter_ + target_index];
+  }
+
   bool IsMethodBeingCompiled(bool osr) const {
     return osr
         ? is_osr_method_being_compiled_
@@ -105,6 +177,8 @@ class ProfilingInfo {
       memset(&cache->classes_[0],
              0,
              InlineCache::kIndividualCacheSize * sizeof(GcRoot<mirror::Class>));
+      memset(&cache->hit_counts_[0], 0, InlineCache::kIndividualCacheSize * sizeof(uint16_t));
+      cache->miss_count_ = 0;
     }
   }
 
@@ -124,17 +198,58 @@ class ProfilingInfo {
     current_inline_uses_--;
   }
 
+  // Records a deoptimization of compiled code of the method. Returns whether the
+  // method just reached the threshold after which the compiler stops speculating.
+  bool AddDeoptimization() {
+    if (number_of_deoptimizations_ == std::numeric_limits<uint16_t>::max()) {
+      return false;
+    }
+    number_of_deoptimizations_++;
+    return number_of_deoptimizations_ == kMaxDeoptimizationsBeforeNoSpeculation;
+  }
+
+  // Whether compiled code of the method deoptimized so often that the compiler should
+  // not emit speculative, deoptimization guarded code for it anymore.
+  bool IsSpeculationDisabled() const {
+    return number_of_deoptimizations_ >= kMaxDeoptimizationsBeforeNoSpeculation;
+  }
+
+  uint16_t GetNumberOfDeoptimizations() const {
+    return number_of_deoptimizations_;
+  }
+
   bool IsInUseByCompiler() const {
     return IsMethodBeingCompiled(/*osr*/ true) || IsMethodBeingCompiled(/*osr*/ false) ||
         (current_inline_uses_ > 0);
   }
 
  private:
-  ProfilingInfo(ArtMethod* method, const std::vector<uint32_t>& entries);
+  ProfilingInfo(ArtMethod* method,
+                const std::vector<uint32_t>& entries,
+                const std::vector<BranchEntry>& branch_entries);
+
+  BranchCache* GetBranchCaches() {
+    return reinterpret_cast<BranchCache*>(&cache_[number_of_inline_caches_]);
+  }
+
+  const BranchCache* GetBranchCaches() const {
+    return reinterpret_cast<const BranchCache*>(&cache_[number_of_inline_caches_]);
+  }
+
+  uint32_t* GetBranchCounters() {
+    return reinterpret_cast<uint32_t*>(GetBranchCaches() + number_of_branch_caches_);
+  }
+
+  const uint32_t* GetBranchCounters() const {
+    return reinterpret_cast<const uint32_t*>(GetBranchCaches() + number_of_branch_caches_);
+  }
 
   // Number of instructions we are profiling in the ArtMethod.
   const uint32_t number_of_inline_caches_;
 
+  // Number of branch instructions we are profiling in the ArtMethod.
+  const uint32_t number_of_branch_caches_;
+
   // Method this profiling info is for.
   // Not 'const' as JVMTI introduces obsolete methods that we implement by creating new ArtMethods.
   // See JitCodeCache::MoveObsoleteMethod.
@@ -150,11 +265,16 @@ class ProfilingInfo {
   // it updates this counter so that the GC does not try to clear the inline caches.
   uint16_t current_inline_uses_;
 
+  // Number of times compiled code of the method deoptimized. Updated without
+  // synchronization, as it is only used as a heuristic by the compiler.
+  uint16_t number_of_deoptimizations_;
+
   // Entry point of the corresponding ArtMethod, while the JIT code cache
   // is poking for the liveness of compiled code.
   const void* saved_entry_point_;
 
-  // Dynamically allocated array of size `number_of_inline_caches_`.
+  // Dynamically allocated array of size `number_of_inline_caches_`, followed by
+  // `number_of_branch_caches_` BranchCache objects and their counters.
   InlineCache cache_[0];
 
   friend class jit::JitCodeCache;
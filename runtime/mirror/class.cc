@@ -1222,8 +1222,8 @@ ObjPtr<Method> Class::GetDeclaredMethodInternal(
   // return a non-synthetic method in such situations. We may
   // still return a synthetic method to handle situations like
   // escalated visibility. We never return miranda methods that
-  // were synthesized by the runtime.
-  constexpr uint32_t kSkipModifiers = kAccMiranda | kAccSynthetic;
+  // were synthesized by the runtime. Use the ArtMethod accessors rather than masking the raw
+  // access flags, kAccMiranda shares its bit with the intrinsic ordinal.
   StackHandleScope<3> hs(self);
   auto h_method_name = hs.NewHandle(name);
   if (UNLIKELY(h_method_name == nullptr)) {
@@ -1243,18 +1243,16 @@ ObjPtr<Method> Class::GetDeclaredMethodInternal(
       }
       continue;
     }
-    auto modifiers = m.GetAccessFlags();
-    if ((modifiers & kSkipModifiers) == 0) {
+    if (!m.IsMiranda() && !m.IsSynthetic()) {
       return Method::CreateFromArtMethod<kPointerSize, kTransactionActive>(self, &m);
     }
-    if ((modifiers & kAccMiranda) == 0) {
+    if (!m.IsMiranda()) {
       result = &m;  // Remember as potential result if it's not a miranda method.
     }
   }
   if (result == nullptr) {
     for (auto& m : h_klass->GetDirectMethods(kPointerSize)) {
-      auto modifiers = m.GetAccessFlags();
-      if ((modifiers & kAccConstructor) != 0) {
+      if (m.IsConstructor()) {
         continue;
       }
       auto* np_method = m.GetInterfaceMethodIfProxy(kPointerSize);
@@ -1270,7 +1268,7 @@ ObjPtr<Method> Class::GetDeclaredMethodInternal(
         }
         continue;
       }
-      if ((modifiers & kSkipModifiers) == 0) {
+      if (!m.IsSynthetic()) {
         return Method::CreateFromArtMethod<kPointerSize, kTransactionActive>(self, &m);
       }
       // Direct methods cannot be miranda methods, so this potential result must be synthetic.
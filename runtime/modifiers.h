@@ -58,11 +58,9 @@ static constexpr uint32_t kAccFastNative =            0x00080000;  // method (de
 // and kAccDefaultConflict will have this bit set. Any kAccDefault method contained in the methods_
 // array of a concrete class will also have this bit set.
 static constexpr uint32_t kAccCopied =                0x00100000;  // method (runtime)
-static constexpr uint32_t kAccMiranda =               0x00200000;  // method (dex only)
-static constexpr uint32_t kAccDefault =               0x00400000;  // method (runtime)
-
 // Set by the JIT when clearing profiling infos to denote that a method was previously warm.
-static constexpr uint32_t kAccPreviouslyWarm =        0x00800000;  // method (runtime)
+static constexpr uint32_t kAccPreviouslyWarm =        0x00200000;  // method (runtime)
+static constexpr uint32_t kAccDefault =               0x00400000;  // method (runtime)
 
 // This is set by the class linker during LinkInterfaceMethods. Prior to that point we do not know
 // if any particular method needs to be a default conflict. Used to figure out at runtime if
@@ -79,6 +77,10 @@ static constexpr uint32_t kAccMustCountLocks =        0x04000000;  // method (ru
 // virtual call.
 static constexpr uint32_t kAccSingleImplementation =  0x08000000;  // method (runtime)
 
+// Set by the class linker for an abstract method copied from an interface into a class that
+// does not implement it. Shares its bit with the intrinsic ordinal, see ArtMethod::IsMiranda.
+static constexpr uint32_t kAccMiranda =               0x10000000;  // method (runtime)
+
 static constexpr uint32_t kAccIntrinsic  =            0x80000000;  // method (runtime)
 
 // Special runtime-only flags.
@@ -89,18 +91,21 @@ static constexpr uint32_t kAccHasDefaultMethod          = 0x40000000;
 // class/ancestor overrides finalize()
 static constexpr uint32_t kAccClassIsFinalizable        = 0x80000000;
 
-static constexpr uint32_t kAccFlagsNotUsedByIntrinsic   = 0x00FFFFFF;
-static constexpr uint32_t kAccMaxIntrinsic              = 0x7F;
+static constexpr uint32_t kAccFlagsNotUsedByIntrinsic   = 0x007FFFFF;
+static constexpr uint32_t kAccMaxIntrinsic              = 0xFF;
 
 // Valid (meaningful) bits for a field.
 static constexpr uint32_t kAccValidFieldFlags = kAccPublic | kAccPrivate | kAccProtected |
     kAccStatic | kAccFinal | kAccVolatile | kAccTransient | kAccSynthetic | kAccEnum;
 
-// Valid (meaningful) bits for a method.
+// Valid (meaningful) bits for a method. Intrinsics keep these bits, so they must not overlap
+// with the intrinsic ordinal. This excludes kAccMiranda, which is never set for intrinsics.
 static constexpr uint32_t kAccValidMethodFlags = kAccPublic | kAccPrivate | kAccProtected |
     kAccStatic | kAccFinal | kAccSynchronized | kAccBridge | kAccVarargs | kAccNative |
-    kAccAbstract | kAccStrict | kAccSynthetic | kAccMiranda | kAccConstructor |
+    kAccAbstract | kAccStrict | kAccSynthetic | kAccConstructor |
     kAccDeclaredSynchronized | kAccPreviouslyWarm;
+static_assert((kAccValidMethodFlags & ~kAccFlagsNotUsedByIntrinsic) == 0u,
+              "Valid method flags overlap with the intrinsic ordinal");
 
 // Valid (meaningful) bits for a class (not interface).
 // Note 1. These are positive bits. Other bits may have to be zero.
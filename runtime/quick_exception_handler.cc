@@ -547,7 +547,13 @@ void QuickExceptionHandler::DeoptimizeSingleFrame(DeoptimizationKind kind) {
     DumpFramesWithType(self_, /* details */ true);
   }
   if (Runtime::Current()->UseJitCompilation()) {
-    Runtime::Current()->GetJit()->GetCodeCache()->InvalidateCompiledCodeFor(
+    jit::JitCodeCache* code_cache = Runtime::Current()->GetJit()->GetCodeCache();
+    if (kind != DeoptimizationKind::kCHA) {
+      // CHA guards fail because new classes got loaded, not because the compiled
+      // code speculated wrongly on the profile.
+      code_cache->RecordDeoptimization(deopt_method);
+    }
+    code_cache->InvalidateCompiledCodeFor(
         deopt_method, visitor.GetSingleFrameDeoptQuickMethodHeader());
   } else {
     // Transfer the code to interpreter.
@@ -18,7 +18,10 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+
 #include "art_method.h"
+#include "base/stl_util.h"
 #include "indenter.h"
 #include "scoped_thread_state_change-inl.h"
 
@@ -114,6 +117,93 @@ void InlineInfoEncoding::Dump(VariableIndentationOutputStream* vios) const {
       << ")\n";
 }
 
+void CodeInfo::DeduperBase::DedupeTo(const uint8_t* code_info,
+                                     const uint8_t* output,
+                                     size_t output_size,
+                                     std::vector<uint8_t>* out) {
+  CodeInfoEncoding encoding(code_info);
+  MemoryRegion region(const_cast<uint8_t*>(code_info),
+                      encoding.HeaderSize() + encoding.NonHeaderSize());
+  const size_t bit_offset = output_size * kBitsPerByte;
+  BitMemoryRegion output_bits(MemoryRegion(const_cast<uint8_t*>(output), output_size),
+                              /* bit_offset */ 0u,
+                              bit_offset);
+
+  // Extract the data of the tables. The tables already shared in the input are read from
+  // the CodeInfo they are shared with.
+  std::vector<uint8_t> tables[CodeInfoEncoding::kNumberOfTables];
+  size_t table_index = 0;
+  encoding.ForEachTable([&](auto* table) {
+    const size_t bit_size = table->DataBitSize();
+    if (bit_size != 0u) {
+      std::vector<uint8_t>& data = tables[table_index];
+      BitMemoryRegion bits(table->TableRegion(region), table->DataBitOffset(), bit_size);
+      data.resize(RoundUp(bit_size, kBitsPerByte) / kBitsPerByte);
+      for (size_t i = 0; i < bit_size; i += kBitsPerByte) {
+        data[i / kBitsPerByte] = bits.LoadBits(i, std::min(bit_size - i, kBitsPerByte));
+      }
+    }
+    table->shared_bit_distance = 0u;
+    ++table_index;
+  });
+  std::vector<uint8_t> header;
+  encoding.Compress(&header);
+  encoding.ComputeTableOffsets();
+  const size_t self_contained_size = encoding.HeaderSize() + encoding.NonHeaderSize();
+
+  // Share each table with its last copy in the output if the reference is smaller than the data.
+  // Tables with the same hash are compared, as the hash does not identify the data.
+  TableKey keys[CodeInfoEncoding::kNumberOfTables];
+  table_index = 0;
+  encoding.ForEachTable([&](auto* table) {
+    const size_t bit_size = table->DataBitSize();
+    if (bit_size != 0u) {
+      const std::vector<uint8_t>& data = tables[table_index];
+      keys[table_index] = TableKey(FNVHash<std::vector<uint8_t>>()(data), bit_size);
+      auto it = dedupe_maps_[table_index].find(keys[table_index]);
+      if (it != dedupe_maps_[table_index].end()) {
+        const size_t distance = bit_offset - it->second;
+        bool same_data = true;
+        for (size_t i = 0; same_data && i < bit_size; i += kBitsPerByte) {
+          size_t bits = std::min(bit_size - i, kBitsPerByte);
+          same_data = (output_bits.LoadBits(it->second + i, bits) == data[i / kBitsPerByte]);
+        }
+        if (same_data &&
+            distance <= std::numeric_limits<uint32_t>::max() &&
+            UnsignedLeb128Size(distance) * kBitsPerByte < bit_size) {
+          table->shared_bit_distance = static_cast<uint32_t>(distance);
+        }
+      }
+    }
+    ++table_index;
+  });
+
+  // Write the new header followed by the data of the tables which are not shared.
+  header.clear();
+  encoding.Compress(&header);
+  encoding.ComputeTableOffsets();
+  const size_t size = encoding.HeaderSize() + encoding.NonHeaderSize();
+  out->assign(size, 0u);
+  MemoryRegion out_region(out->data(), size);
+  out_region.CopyFrom(0, MemoryRegion(header.data(), header.size()));
+  table_index = 0;
+  encoding.ForEachTable([&](auto* table) {
+    const size_t bit_size = table->DataBitSize();
+    if (bit_size != 0u && !table->IsShared()) {
+      const std::vector<uint8_t>& data = tables[table_index];
+      BitMemoryRegion bits(out_region, table->DataBitOffset(), bit_size);
+      for (size_t i = 0; i < bit_size; i += kBitsPerByte) {
+        bits.StoreBits(i, data[i / kBitsPerByte], std::min(bit_size - i, kBitsPerByte));
+      }
+      // Later CodeInfos refer to the closest copy, which needs the shortest reference.
+      dedupe_maps_[table_index][keys[table_index]] = bit_offset + table->DataBitOffset();
+    }
+    ++table_index;
+  });
+  DCHECK_LE(size, self_contained_size);
+  saved_bytes_ += self_contained_size - size;
+}
+
 void CodeInfo::Dump(VariableIndentationOutputStream* vios,
                     uint32_t code_offset,
                     uint16_t number_of_dex_registers,
@@ -18,6 +18,9 @@
 #define ART_RUNTIME_STACK_MAP_H_
 
 #include <limits>
+#include <map>
+#include <memory>
+#include <vector>
 
 #include "arch/code_offset.h"
 #include "base/bit_utils.h"
@@ -1092,9 +1095,66 @@ class BitRegionEncoding {
   }
 };
 
+// Base of the CodeInfo tables. The data of a table is either stored in the CodeInfo itself,
+// or shared with an identical table of a CodeInfo stored before it in the same memory (see
+// CodeInfo::Deduper). The sharing flag is stored in the lowest bit of the serialized number
+// of entries, which keeps the header of unshared tables as small as before.
+struct CodeInfoTable {
+  // Distance in bits from the start of the CodeInfo back to the data of the table, or 0 if
+  // the data is stored in the CodeInfo (serialized if not 0).
+  uint32_t shared_bit_distance = 0;
+
+  ALWAYS_INLINE bool IsShared() const {
+    return shared_bit_distance != 0;
+  }
+
+  // Return the memory holding the data of the table, given the region of the CodeInfo.
+  ALWAYS_INLINE MemoryRegion TableRegion(MemoryRegion code_info_region) const {
+    if (LIKELY(!IsShared())) {
+      return code_info_region;
+    }
+    // The shared data ends before the CodeInfo, start the region at its first byte.
+    const size_t num_bytes = RoundUp(shared_bit_distance, kBitsPerByte) / kBitsPerByte;
+    return MemoryRegion(code_info_region.begin() - num_bytes, num_bytes);
+  }
+
+ protected:
+  template<typename Vector>
+  void EncodeNumEntries(Vector* dest, size_t num_entries) const {
+    EncodeUnsignedLeb128(dest, (num_entries << 1) | (IsShared() ? 1u : 0u));
+  }
+
+  ALWAYS_INLINE size_t DecodeNumEntries(const uint8_t** ptr) {
+    const uint32_t value = DecodeUnsignedLeb128(ptr);
+    // Use a non-zero placeholder until the distance, serialized last, is decoded.
+    shared_bit_distance = value & 1u;
+    return value >> 1;
+  }
+
+  template<typename Vector>
+  void EncodeSharedBitDistance(Vector* dest) const {
+    if (IsShared()) {
+      EncodeUnsignedLeb128(dest, shared_bit_distance);
+    }
+  }
+
+  ALWAYS_INLINE void DecodeSharedBitDistance(const uint8_t** ptr) {
+    if (IsShared()) {
+      shared_bit_distance = DecodeUnsignedLeb128(ptr);
+      DCHECK(IsShared());
+    }
+  }
+
+  // Return the bit offset of the shared data in the region returned by TableRegion().
+  ALWAYS_INLINE size_t SharedDataBitOffset() const {
+    DCHECK(IsShared());
+    return RoundUp(shared_bit_distance, kBitsPerByte) - shared_bit_distance;
+  }
+};
+
 // A table of bit sized encodings.
 template <typename Encoding>
-struct BitEncodingTable {
+struct BitEncodingTable : public CodeInfoTable {
   static constexpr size_t kInvalidOffset = static_cast<size_t>(-1);
   // How the encoding is laid out (serialized).
   Encoding encoding;
@@ -1102,38 +1162,53 @@ struct BitEncodingTable {
   // Number of entries in the table (serialized).
   size_t num_entries;
 
-  // Bit offset for the base of the table (computed).
+  // Bit offset for the base of the table in its TableRegion() (computed).
   size_t bit_offset = kInvalidOffset;
 
   template<typename Vector>
   void Encode(Vector* dest) const {
-    EncodeUnsignedLeb128(dest, num_entries);
+    EncodeNumEntries(dest, num_entries);
     encoding.Encode(dest);
+    EncodeSharedBitDistance(dest);
   }
 
   ALWAYS_INLINE void Decode(const uint8_t** ptr) {
-    num_entries = DecodeUnsignedLeb128(ptr);
+    num_entries = DecodeNumEntries(ptr);
     encoding.Decode(ptr);
+    DecodeSharedBitDistance(ptr);
   }
 
   // Set the bit offset in the table and adds the space used by the table to offset.
+  // Shared tables do not use any space in the CodeInfo.
   void UpdateBitOffset(size_t* offset) {
     DCHECK(offset != nullptr);
+    if (IsShared()) {
+      bit_offset = SharedDataBitOffset();
+      return;
+    }
     bit_offset = *offset;
-    *offset += encoding.BitSize() * num_entries;
+    *offset += DataBitSize();
   }
 
-  // Return the bit region for the map at index i.
+  ALWAYS_INLINE size_t DataBitSize() const {
+    return encoding.BitSize() * num_entries;
+  }
+
+  ALWAYS_INLINE size_t DataBitOffset() const {
+    return bit_offset;
+  }
+
+  // Return the bit region for the map at index i, given the region of the CodeInfo.
   ALWAYS_INLINE BitMemoryRegion BitRegion(MemoryRegion region, size_t index) const {
     DCHECK_NE(bit_offset, kInvalidOffset) << "Invalid table offset";
     DCHECK_LT(index, num_entries);
     const size_t map_size = encoding.BitSize();
-    return BitMemoryRegion(region, bit_offset + index * map_size, map_size);
+    return BitMemoryRegion(TableRegion(region), bit_offset + index * map_size, map_size);
   }
 };
 
 // A byte sized table of possible variable sized encodings.
-struct ByteSizedTable {
+struct ByteSizedTable : public CodeInfoTable {
   static constexpr size_t kInvalidOffset = static_cast<size_t>(-1);
 
   // Number of entries in the table (serialized).
@@ -1142,26 +1217,42 @@ struct ByteSizedTable {
   // Number of bytes of the table (serialized).
   size_t num_bytes;
 
-  // Bit offset for the base of the table (computed).
+  // Byte offset for the base of the table in its TableRegion() (computed).
   size_t byte_offset = kInvalidOffset;
 
   template<typename Vector>
   void Encode(Vector* dest) const {
-    EncodeUnsignedLeb128(dest, num_entries);
+    EncodeNumEntries(dest, num_entries);
     EncodeUnsignedLeb128(dest, num_bytes);
+    EncodeSharedBitDistance(dest);
   }
 
   ALWAYS_INLINE void Decode(const uint8_t** ptr) {
-    num_entries = DecodeUnsignedLeb128(ptr);
+    num_entries = DecodeNumEntries(ptr);
     num_bytes = DecodeUnsignedLeb128(ptr);
+    DecodeSharedBitDistance(ptr);
   }
 
   // Set the bit offset of the table. Adds the total bit size of the table to offset.
+  // Shared tables do not use any space in the CodeInfo.
   void UpdateBitOffset(size_t* offset) {
     DCHECK(offset != nullptr);
+    if (IsShared()) {
+      DCHECK_ALIGNED(shared_bit_distance, kBitsPerByte);
+      byte_offset = SharedDataBitOffset() / kBitsPerByte;
+      return;
+    }
     DCHECK_ALIGNED(*offset, kBitsPerByte);
     byte_offset = *offset / kBitsPerByte;
-    *offset += num_bytes * kBitsPerByte;
+    *offset += DataBitSize();
+  }
+
+  ALWAYS_INLINE size_t DataBitSize() const {
+    return num_bytes * kBitsPerByte;
+  }
+
+  ALWAYS_INLINE size_t DataBitOffset() const {
+    return byte_offset * kBitsPerByte;
   }
 };
 
@@ -1334,6 +1425,20 @@ struct CodeInfoEncoding {
     return cache_non_header_size;
   }
 
+  // Call `fn` on each table, in the order they are laid out.
+  template <typename Fn>
+  void ForEachTable(Fn fn) {
+    fn(&dex_register_map);
+    fn(&location_catalog);
+    fn(&stack_map);
+    fn(&register_mask);
+    fn(&stack_mask);
+    fn(&invoke_info);
+    fn(&inline_info);
+  }
+
+  static constexpr size_t kNumberOfTables = 7;
+
  private:
   // Computed fields (not serialized).
   // Header size in bytes, cached to avoid needing to re-decoding the encoding in HeaderSize.
@@ -1354,6 +1459,8 @@ struct CodeInfoEncoding {
  *   [ByteSizedTable(dex_register_map), ByteSizedTable(location_catalog),
  *    BitEncodingTable<StackMapEncoding>, BitEncodingTable<BitRegionEncoding>,
  *    BitEncodingTable<BitRegionEncoding>, BitEncodingTable<InlineInfoEncoding>]
+ *
+ * Tables shared with a CodeInfo stored before this one are omitted from the data.
  */
 class CodeInfo {
  public:
@@ -1377,8 +1484,9 @@ class CodeInfo {
   }
 
   DexRegisterLocationCatalog GetDexRegisterLocationCatalog(const CodeInfoEncoding& encoding) const {
-    return DexRegisterLocationCatalog(region_.Subregion(encoding.location_catalog.byte_offset,
-                                                        encoding.location_catalog.num_bytes));
+    MemoryRegion table_region = encoding.location_catalog.TableRegion(region_);
+    return DexRegisterLocationCatalog(table_region.Subregion(encoding.location_catalog.byte_offset,
+                                                             encoding.location_catalog.num_bytes));
   }
 
   ALWAYS_INLINE size_t GetNumberOfStackMaskBits(const CodeInfoEncoding& encoding) const {
@@ -1434,10 +1542,12 @@ class CodeInfo {
     if (!stack_map.HasDexRegisterMap(encoding.stack_map.encoding)) {
       return DexRegisterMap();
     }
+    MemoryRegion table_region = encoding.dex_register_map.TableRegion(region_);
     const uint32_t offset = encoding.dex_register_map.byte_offset +
         stack_map.GetDexRegisterMapOffset(encoding.stack_map.encoding);
-    size_t size = ComputeDexRegisterMapSizeOf(encoding, offset, number_of_dex_registers);
-    return DexRegisterMap(region_.Subregion(offset, size));
+    size_t size =
+        ComputeDexRegisterMapSizeOf(encoding, table_region, offset, number_of_dex_registers);
+    return DexRegisterMap(table_region.Subregion(offset, size));
   }
 
   size_t GetDexRegisterMapsSize(const CodeInfoEncoding& encoding,
@@ -1459,10 +1569,12 @@ class CodeInfo {
     if (!inline_info.HasDexRegisterMapAtDepth(encoding.inline_info.encoding, depth)) {
       return DexRegisterMap();
     } else {
+      MemoryRegion table_region = encoding.dex_register_map.TableRegion(region_);
       uint32_t offset = encoding.dex_register_map.byte_offset +
           inline_info.GetDexRegisterMapOffsetAtDepth(encoding.inline_info.encoding, depth);
-      size_t size = ComputeDexRegisterMapSizeOf(encoding, offset, number_of_dex_registers);
-      return DexRegisterMap(region_.Subregion(offset, size));
+      size_t size =
+          ComputeDexRegisterMapSizeOf(encoding, table_region, offset, number_of_dex_registers);
+      return DexRegisterMap(table_region.Subregion(offset, size));
     }
   }
 
@@ -1471,9 +1583,11 @@ class CodeInfo {
     // access the inline info for arbitrary depths. To return the precise inline info we would need
     // to count the depth before returning.
     // TODO: Clean this up.
+    MemoryRegion table_region = encoding.inline_info.TableRegion(region_);
     const size_t bit_offset = encoding.inline_info.bit_offset +
         index * encoding.inline_info.encoding.BitSize();
-    return InlineInfo(BitMemoryRegion(region_, bit_offset, region_.size_in_bits() - bit_offset));
+    return InlineInfo(
+        BitMemoryRegion(table_region, bit_offset, table_region.size_in_bits() - bit_offset));
   }
 
   InlineInfo GetInlineInfoOf(StackMap stack_map, const CodeInfoEncoding& encoding) const {
@@ -1574,9 +1688,73 @@ class CodeInfo {
             InstructionSet instruction_set,
             const MethodInfo& method_info) const;
 
+  // The part of BasicDeduper which does not depend on the allocator of the output. To find the
+  // copies of a table, only the hash of its data is kept with the offset of its last copy, and
+  // the data is compared with that copy in the output.
+  class DeduperBase {
+   public:
+    // Return the number of bytes saved by sharing tables so far.
+    size_t GetSavedBytes() const {
+      return saved_bytes_;
+    }
+
+   protected:
+    DeduperBase() {}
+
+    // Write to `out` the CodeInfo at `code_info` as it is to be appended to the `output_size`
+    // bytes of output at `output`, sharing tables with them.
+    void DedupeTo(const uint8_t* code_info,
+                  const uint8_t* output,
+                  size_t output_size,
+                  std::vector<uint8_t>* out);
+
+   private:
+    // The hash of the data of a table and its size in bits.
+    using TableKey = std::pair<size_t, size_t>;
+
+    // Bit offsets in the output of the last copy of each table, for each kind of table.
+    std::map<TableKey, size_t> dedupe_maps_[CodeInfoEncoding::kNumberOfTables];
+    size_t saved_bytes_ = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(DeduperBase);
+  };
+
+  // Appends CodeInfos to a contiguous buffer, sharing each of their tables with an identical
+  // table of a CodeInfo appended before when this saves space. Used to intern the common
+  // tables across all the methods of an oat file. The CodeInfos of the JIT are not deduped,
+  // as their memory is freed independently. The buffer may use any allocator, e.g. the swap
+  // space of dex2oat.
+  template <typename Allocator>
+  class BasicDeduper : public DeduperBase {
+   public:
+    explicit BasicDeduper(std::vector<uint8_t, Allocator>* output) : output_(output) {}
+
+    // Append the CodeInfo at `code_info` to the output and return its offset in the output.
+    // The result is only valid at this place in the output. The CodeInfo may itself share
+    // tables with the data preceding it, e.g. when copied from an oat file, in which case
+    // the output holds its own copy of these tables or shares them with the output.
+    size_t Dedupe(const uint8_t* code_info) {
+      const size_t offset = output_->size();
+      DedupeTo(code_info, output_->data(), offset, &code_info_);
+      output_->insert(output_->end(), code_info_.begin(), code_info_.end());
+      return offset;
+    }
+
+   private:
+    std::vector<uint8_t, Allocator>* const output_;
+    // The last appended CodeInfo, only kept to reuse its memory.
+    std::vector<uint8_t> code_info_;
+
+    DISALLOW_COPY_AND_ASSIGN(BasicDeduper);
+  };
+
+  using Deduper = BasicDeduper<std::allocator<uint8_t>>;
+
   // Check that the code info has valid stack map and abort if it does not.
   void AssertValidStackMap(const CodeInfoEncoding& encoding) const {
-    if (region_.size() != 0 && region_.size_in_bits() < GetStackMapsSizeInBits(encoding)) {
+    if (region_.size() != 0 &&
+        !encoding.stack_map.IsShared() &&
+        region_.size_in_bits() < GetStackMapsSizeInBits(encoding)) {
       LOG(FATAL) << region_.size() << "\n"
                  << encoding.HeaderSize() << "\n"
                  << encoding.NonHeaderSize() << "\n"
@@ -1588,8 +1766,9 @@ class CodeInfo {
 
  private:
   // Compute the size of the Dex register map associated to the stack map at
-  // `dex_register_map_offset_in_code_info`.
+  // `dex_register_map_offset_in_code_info` in `table_region`.
   size_t ComputeDexRegisterMapSizeOf(const CodeInfoEncoding& encoding,
+                                     MemoryRegion table_region,
                                      uint32_t dex_register_map_offset_in_code_info,
                                      uint16_t number_of_dex_registers) const {
     // Offset where the actual mapping data starts within art::DexRegisterMap.
@@ -1598,8 +1777,8 @@ class CodeInfo {
     // Create a temporary art::DexRegisterMap to be able to call
     // art::DexRegisterMap::GetNumberOfLiveDexRegisters and
     DexRegisterMap dex_register_map_without_locations(
-        MemoryRegion(region_.Subregion(dex_register_map_offset_in_code_info,
-                                       location_mapping_data_offset_in_dex_register_map)));
+        MemoryRegion(table_region.Subregion(dex_register_map_offset_in_code_info,
+                                            location_mapping_data_offset_in_dex_register_map)));
     size_t number_of_live_dex_registers =
         dex_register_map_without_locations.GetNumberOfLiveDexRegisters(number_of_dex_registers);
     size_t location_mapping_data_size_in_bits =
@@ -111,9 +111,25 @@ void ThreadPool::AddTask(Thread* self, Task* task) {
   }
 }
 
+void ThreadPool::AddLowPriorityTask(Thread* self, Task* task) {
+  MutexLock mu(self, task_queue_lock_);
+  low_priority_tasks_.push_back(task);
+  // If we have any waiters, signal one.
+  if (started_ && waiting_count_ != 0) {
+    task_queue_condition_.Signal(self);
+  }
+}
+
+bool ThreadPool::HasPendingNormalTasks(Thread* self) {
+  MutexLock mu(self, task_queue_lock_);
+  return !tasks_.empty();
+}
+
 void ThreadPool::RemoveAllTasks(Thread* self) {
   MutexLock mu(self, task_queue_lock_);
   tasks_.clear();
+  low_priority_tasks_.clear();
+  low_priority_task_delay_ = 0;
 }
 
 ThreadPool::ThreadPool(const char* name, size_t num_threads, bool create_peers)
@@ -124,6 +140,7 @@ ThreadPool::ThreadPool(const char* name, size_t num_threads, bool create_peers)
     started_(false),
     shutting_down_(false),
     waiting_count_(0),
+    low_priority_task_delay_(0),
     start_time_(0),
     total_wait_time_(0),
     // Add one since the caller of constructor waits on the barrier too.
@@ -213,8 +230,16 @@ Task* ThreadPool::TryGetTask(Thread* self) {
 
 Task* ThreadPool::TryGetTaskLocked() {
   if (HasOutstandingTasks()) {
-    Task* task = tasks_.front();
-    tasks_.pop_front();
+    bool take_low_priority = !low_priority_tasks_.empty() &&
+        (tasks_.empty() || low_priority_task_delay_ >= kMaxLowPriorityTaskDelay);
+    if (take_low_priority) {
+      low_priority_task_delay_ = 0;
+    } else if (!low_priority_tasks_.empty()) {
+      ++low_priority_task_delay_;
+    }
+    std::deque<Task*>& tasks = take_low_priority ? low_priority_tasks_ : tasks_;
+    Task* task = tasks.front();
+    tasks.pop_front();
     return task;
   }
   return nullptr;
@@ -242,7 +267,7 @@ void ThreadPool::Wait(Thread* self, bool do_work, bool may_hold_locks) {
 
 size_t ThreadPool::GetTaskCount(Thread* self) {
   MutexLock mu(self, task_queue_lock_);
-  return tasks_.size();
+  return tasks_.size() + low_priority_tasks_.size();
 }
 
 void ThreadPool::SetPthreadPriority(int priority) {
@@ -83,6 +83,10 @@ class ThreadPoolWorker {
 // Note that thread pool workers will set Thread#setCanCallIntoJava to false.
 class ThreadPool {
  public:
+  // How many tasks added with AddTask workers process before a waiting low priority task, so
+  // that a steady stream of tasks does not starve the low priority ones.
+  static constexpr size_t kMaxLowPriorityTaskDelay = 16;
+
   // Returns the number of threads in the thread pool.
   size_t GetThreadCount() const {
     return threads_.size();
@@ -102,6 +106,14 @@ class ThreadPool {
   // after running it, it is the caller's responsibility.
   void AddTask(Thread* self, Task* task) REQUIRES(!task_queue_lock_);
 
+  // Add a new task that workers only process once no task added with AddTask is pending, or once
+  // they processed kMaxLowPriorityTaskDelay such tasks since the last low priority task. Tasks of
+  // the same priority are processed in the order they were added.
+  void AddLowPriorityTask(Thread* self, Task* task) REQUIRES(!task_queue_lock_);
+
+  // Returns whether a task added with AddTask is waiting for a worker.
+  bool HasPendingNormalTasks(Thread* self) REQUIRES(!task_queue_lock_);
+
   // Remove all tasks in the queue.
   void RemoveAllTasks(Thread* self) REQUIRES(!task_queue_lock_);
 
@@ -146,7 +158,7 @@ class ThreadPool {
   }
 
   bool HasOutstandingTasks() const REQUIRES(task_queue_lock_) {
-    return started_ && !tasks_.empty();
+    return started_ && (!tasks_.empty() || !low_priority_tasks_.empty());
   }
 
   const std::string name_;
@@ -158,6 +170,9 @@ class ThreadPool {
   // How many worker threads are waiting on the condition.
   volatile size_t waiting_count_ GUARDED_BY(task_queue_lock_);
   std::deque<Task*> tasks_ GUARDED_BY(task_queue_lock_);
+  std::deque<Task*> low_priority_tasks_ GUARDED_BY(task_queue_lock_);
+  // How many tasks workers took from `tasks_` while a low priority task was waiting.
+  size_t low_priority_task_delay_ GUARDED_BY(task_queue_lock_);
   // TODO: make this immutable/const?
   std::vector<ThreadPoolWorker*> threads_;
   // Work balance detection.
@@ -17,6 +17,7 @@
 #include "thread_pool.h"
 
 #include <string>
+#include <vector>
 
 #include "atomic.h"
 #include "common_runtime_test.h"
@@ -160,6 +161,61 @@ TEST_F(ThreadPoolTest, RecursiveTest) {
   EXPECT_EQ((1 << depth) - 1, count.LoadSequentiallyConsistent());
 }
 
+class OrderTask : public Task {
+ public:
+  OrderTask(std::vector<int>* order, int id) : order_(order), id_(id) {}
+
+  void Run(Thread* self ATTRIBUTE_UNUSED) {
+    order_->push_back(id_);
+  }
+
+  void Finalize() {
+    delete this;
+  }
+
+ private:
+  std::vector<int>* const order_;
+  const int id_;
+};
+
+// Test that low priority tasks only run once no other task is pending.
+TEST_F(ThreadPoolTest, LowPriorityTasks) {
+  Thread* self = Thread::Current();
+  ThreadPool thread_pool("Thread pool test thread pool", 1);
+  std::vector<int> order;
+  thread_pool.AddLowPriorityTask(self, new OrderTask(&order, 3));
+  thread_pool.AddTask(self, new OrderTask(&order, 1));
+  thread_pool.AddLowPriorityTask(self, new OrderTask(&order, 4));
+  thread_pool.AddTask(self, new OrderTask(&order, 2));
+  EXPECT_EQ(4u, thread_pool.GetTaskCount(self));
+  thread_pool.StartWorkers(self);
+  thread_pool.Wait(self, false, false);
+  EXPECT_EQ(std::vector<int>({1, 2, 3, 4}), order);
+  EXPECT_EQ(0u, thread_pool.GetTaskCount(self));
+}
+
+// Test that a low priority task runs after a bounded number of other tasks.
+TEST_F(ThreadPoolTest, LowPriorityTaskDelay) {
+  Thread* self = Thread::Current();
+  ThreadPool thread_pool("Thread pool test thread pool", 1);
+  const int max_delay = static_cast<int>(ThreadPool::kMaxLowPriorityTaskDelay);
+  std::vector<int> order;
+  std::vector<int> expected_order;
+  thread_pool.AddLowPriorityTask(self, new OrderTask(&order, -1));
+  for (int i = 0; i != 2 * max_delay; ++i) {
+    thread_pool.AddTask(self, new OrderTask(&order, i));
+    if (i == max_delay) {
+      expected_order.push_back(-1);
+    }
+    expected_order.push_back(i);
+  }
+  EXPECT_TRUE(thread_pool.HasPendingNormalTasks(self));
+  thread_pool.StartWorkers(self);
+  thread_pool.Wait(self, false, false);
+  EXPECT_EQ(expected_order, order);
+  EXPECT_FALSE(thread_pool.HasPendingNormalTasks(self));
+}
+
 class PeerTask : public Task {
  public:
   PeerTask() {}
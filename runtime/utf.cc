@@ -23,6 +23,13 @@
 
 namespace art {
 
+// Returns whether the eight bytes at `utf8` are all one-byte encodings, that is, ASCII.
+static inline bool IsAsciiWord(const char* utf8) {
+  uint64_t word;
+  memcpy(&word, utf8, sizeof(word));
+  return (word & UINT64_C(0x8080808080808080)) == 0u;
+}
+
 // This is used only from debugger and test code.
 size_t CountModifiedUtf8Chars(const char* utf8) {
   return CountModifiedUtf8Chars(utf8, strlen(utf8));
@@ -48,6 +55,14 @@ size_t CountModifiedUtf8Chars(const char* utf8, size_t byte_count) {
   size_t len = 0;
   const char* end = utf8 + byte_count;
   for (; utf8 < end; ++utf8) {
+    // Skip runs of ASCII characters a word at a time.
+    while (end - utf8 >= 8 && IsAsciiWord(utf8)) {
+      utf8 += 8;
+      len += 8;
+    }
+    if (utf8 == end) {
+      break;
+    }
     int ic = *utf8;
     len++;
     if (LIKELY((ic & 0x80) == 0)) {
@@ -106,6 +121,17 @@ void ConvertModifiedUtf8ToUtf16(uint16_t* utf16_data_out, size_t out_chars,
 
   // String contains non-ASCII characters.
   for (const char *p = in_start; p < in_end;) {
+    // Copy runs of ASCII characters a word at a time.
+    while (in_end - p >= 8 && IsAsciiWord(p)) {
+      for (size_t i = 0; i != 8u; ++i) {
+        out_p[i] = static_cast<uint16_t>(p[i]);
+      }
+      p += 8;
+      out_p += 8;
+    }
+    if (p == in_end) {
+      break;
+    }
     const uint32_t ch = GetUtf16FromUtf8(&p);
     const uint16_t leading = GetLeadingUtf16Char(ch);
     const uint16_t trailing = GetTrailingUtf16Char(ch);
@@ -235,6 +261,19 @@ size_t CountUtf8Bytes(const uint16_t* chars, size_t char_count) {
   size_t result = 0;
   const uint16_t *end = chars + char_count;
   while (chars < end) {
+    // Count runs of four one-byte characters, that is, in [0x01, 0x7f], at a time.
+    // A character is zero iff subtracting one borrows from its bit 15 but it was clear.
+    if (end - chars >= 4) {
+      uint64_t word;
+      memcpy(&word, chars, sizeof(word));
+      const uint64_t zero_chars =
+          (word - UINT64_C(0x0001000100010001)) & ~word & UINT64_C(0x8000800080008000);
+      if ((word & UINT64_C(0xff80ff80ff80ff80)) == 0u && zero_chars == 0u) {
+        chars += 4;
+        result += 4;
+        continue;
+      }
+    }
     const uint16_t ch = *chars++;
     if (LIKELY(ch != 0 && ch < 0x80)) {
       result++;
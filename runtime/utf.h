@@ -77,6 +77,14 @@ void ConvertUtf16ToModifiedUtf8(char* utf8_out, size_t byte_count,
 template<typename MemoryType>
 int32_t ComputeUtf16Hash(const MemoryType* chars, size_t char_count) {
   uint32_t hash = 0;
+  // Hash four characters at a time, which breaks the dependency chain of the multiplications.
+  for (; char_count >= 4u; char_count -= 4u, chars += 4) {
+    hash = hash * (31u * 31u * 31u * 31u) +
+        chars[0] * (31u * 31u * 31u) +
+        chars[1] * (31u * 31u) +
+        chars[2] * 31u +
+        chars[3];
+  }
   while (char_count--) {
     hash = hash * 31 + *chars++;
   }
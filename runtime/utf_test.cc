@@ -196,6 +196,46 @@ TEST_F(UtfTest, CountAndConvertUtf8Bytes_UnpairedSurrogate) {
   }
 }
 
+TEST_F(UtfTest, AsciiRuns) {
+  // ASCII runs of various lengths around non-ASCII characters, to cover the word at a time
+  // paths and their tails.
+  for (size_t prefix = 0; prefix != 20u; ++prefix) {
+    for (size_t suffix = 0; suffix != 20u; ++suffix) {
+      std::vector<uint16_t> utf16;
+      std::vector<uint8_t> utf8;
+      for (size_t i = 0; i != prefix; ++i) {
+        utf16.push_back('a' + i);
+        utf8.push_back('a' + i);
+      }
+      utf16.push_back(0x0101);
+      utf8.insert(utf8.end(), { 0xc4, 0x81 });
+      utf16.push_back(0x0000);
+      utf8.insert(utf8.end(), { 0xc0, 0x80 });
+      for (size_t i = 0; i != suffix; ++i) {
+        utf16.push_back('A' + i);
+        utf8.push_back('A' + i);
+      }
+      AssertConversion(utf16, utf8);
+
+      utf8.push_back('\0');
+      const char* utf8_chars = reinterpret_cast<const char*>(&utf8[0]);
+      const size_t byte_count = utf8.size() - 1u;
+      ASSERT_EQ(utf16.size(), CountModifiedUtf8Chars(utf8_chars, byte_count));
+      std::vector<uint16_t> output(utf16.size());
+      ConvertModifiedUtf8ToUtf16(&output[0], output.size(), utf8_chars, byte_count);
+      EXPECT_EQ(utf16, output);
+
+      uint32_t hash = 0;
+      for (uint16_t c : utf16) {
+        hash = hash * 31 + c;
+      }
+      EXPECT_EQ(static_cast<int32_t>(hash), ComputeUtf16Hash(&utf16[0], utf16.size()));
+      EXPECT_EQ(static_cast<int32_t>(hash),
+                ComputeUtf16HashFromModifiedUtf8(utf8_chars, utf16.size()));
+    }
+  }
+}
+
 // Old versions of functions, here to compare answers with optimized versions.
 
 size_t CountModifiedUtf8Chars_reference(const char* utf8) {
@@ -50,6 +50,17 @@ public class Main {
   /// CHECK-START: int Main.set32(java.lang.Object, long, int) intrinsics_recognition (after)
   /// CHECK-DAG: <<Result:i\d+>> InvokeVirtual intrinsic:UnsafeGetAndSetInt
   /// CHECK-DAG:                 Return [<<Result>>]
+
+  /// CHECK-START-ARM64: int Main.set32(java.lang.Object, long, int) disassembly (after)
+  /// CHECK:     InvokeVirtual intrinsic:UnsafeGetAndSetInt
+  /// CHECK:     ldaxr
+  /// CHECK:     stlxr
+  /// CHECK-NOT: blr
+
+  /// CHECK-START-X86_64: int Main.set32(java.lang.Object, long, int) disassembly (after)
+  /// CHECK:     InvokeVirtual intrinsic:UnsafeGetAndSetInt
+  /// CHECK:     xchg
+  /// CHECK-NOT: call
   private static int set32(Object o, long offset, int newValue) {
     return unsafe.getAndSetInt(o, offset, newValue);
   }
@@ -75,6 +86,18 @@ public class Main {
   /// CHECK-START: int Main.add32(java.lang.Object, long, int) intrinsics_recognition (after)
   /// CHECK-DAG: <<Result:i\d+>> InvokeVirtual intrinsic:UnsafeGetAndAddInt
   /// CHECK-DAG:                 Return [<<Result>>]
+
+  /// CHECK-START-ARM64: int Main.add32(java.lang.Object, long, int) disassembly (after)
+  /// CHECK:     InvokeVirtual intrinsic:UnsafeGetAndAddInt
+  /// CHECK:     ldaxr
+  /// CHECK:     add
+  /// CHECK:     stlxr
+  /// CHECK-NOT: blr
+
+  /// CHECK-START-X86_64: int Main.add32(java.lang.Object, long, int) disassembly (after)
+  /// CHECK:     InvokeVirtual intrinsic:UnsafeGetAndAddInt
+  /// CHECK:     lock xadd
+  /// CHECK-NOT: call
   private static int add32(Object o, long offset, int delta) {
     return unsafe.getAndAddInt(o, offset, delta);
   }
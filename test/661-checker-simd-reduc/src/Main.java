@@ -25,8 +25,6 @@ public class Main {
   // Basic reductions in loops.
   //
 
-  // TODO: vectorize these (second step of b/64091002 plan)
-
   private static byte reductionByte(byte[] x) {
     byte sum = 0;
     for (int i = 0; i < x.length; i++) {
@@ -51,6 +49,15 @@ public class Main {
     return sum;
   }
 
+  /// CHECK-START-ARM64: int Main.reductionInt(int[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecAdd                         loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:sum             loop:none
+  //
+  /// CHECK-START-X86_64: int Main.reductionInt(int[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecAdd                         loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:sum             loop:none
   private static int reductionInt(int[] x) {
     int sum = 0;
     for (int i = 0; i < x.length; i++) {
@@ -59,6 +66,15 @@ public class Main {
     return sum;
   }
 
+  /// CHECK-START-ARM64: long Main.reductionLong(long[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecAdd                         loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:sum             loop:none
+  //
+  /// CHECK-START-X86_64: long Main.reductionLong(long[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecAdd                         loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:sum             loop:none
   private static long reductionLong(long[] x) {
     long sum = 0;
     for (int i = 0; i < x.length; i++) {
@@ -131,6 +147,15 @@ public class Main {
     return min;
   }
 
+  /// CHECK-START-ARM64: int Main.reductionMinInt(int[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecMin                         loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:min             loop:none
+  //
+  /// CHECK-START-X86_64: int Main.reductionMinInt(int[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecMin                         loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:min             loop:none
   private static int reductionMinInt(int[] x) {
     int min = Integer.MAX_VALUE;
     for (int i = 0; i < x.length; i++) {
@@ -171,6 +196,15 @@ public class Main {
     return max;
   }
 
+  /// CHECK-START-ARM64: int Main.reductionMaxInt(int[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecMax                         loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:max             loop:none
+  //
+  /// CHECK-START-X86_64: int Main.reductionMaxInt(int[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecMax                         loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:max             loop:none
   private static int reductionMaxInt(int[] x) {
     int max = Integer.MIN_VALUE;
     for (int i = 0; i < x.length; i++) {
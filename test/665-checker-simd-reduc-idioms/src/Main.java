@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for reduction idioms: narrower data accumulated into a wider accumulator.
+ */
+public class Main {
+
+  static final int N = 500;
+
+  //
+  // Sum of absolute differences.
+  //
+
+  /// CHECK-START-ARM64: int Main.sadByte(byte[], byte[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecSADAccumulate               loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:sum             loop:none
+  //
+  /// CHECK-START-X86_64: int Main.sadByte(byte[], byte[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecSADAccumulate               loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:sum             loop:none
+  private static int sadByte(byte[] x, byte[] y) {
+    int sad = 0;
+    for (int i = 0; i < x.length; i++) {
+      sad += Math.abs(x[i] - y[i]);
+    }
+    return sad;
+  }
+
+  /// CHECK-START-ARM64: int Main.sadShort(short[], short[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecSADAccumulate               loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:sum             loop:none
+  //
+  /// CHECK-START-X86_64: int Main.sadShort(short[], short[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecSADAccumulate               loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:sum             loop:none
+  private static int sadShort(short[] x, short[] y) {
+    int sad = 0;
+    for (int i = 0; i < x.length; i++) {
+      sad += Math.abs(x[i] - y[i]);
+    }
+    return sad;
+  }
+
+  //
+  // Dot products.
+  //
+
+  /// CHECK-START-ARM64: int Main.dotProdByte(byte[], byte[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecDotProd                     loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:sum             loop:none
+  //
+  /// CHECK-START-X86_64: int Main.dotProdByte(byte[], byte[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecDotProd                     loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:sum             loop:none
+  private static int dotProdByte(byte[] x, byte[] y) {
+    int sum = 0;
+    for (int i = 0; i < x.length; i++) {
+      sum += x[i] * y[i];
+    }
+    return sum;
+  }
+
+  /// CHECK-START-ARM64: int Main.dotProdShort(short[], short[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecDotProd                     loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:sum             loop:none
+  //
+  /// CHECK-START-X86_64: int Main.dotProdShort(short[], short[]) loop_optimization (after)
+  /// CHECK-DAG: <<Phi:d\d+>> Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecDotProd                     loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecReduce kind:sum             loop:none
+  private static int dotProdShort(short[] x, short[] y) {
+    int sum = 0;
+    for (int i = 0; i < x.length; i++) {
+      sum += x[i] * y[i];
+    }
+    return sum;
+  }
+
+  //
+  // Main driver.
+  //
+
+  public static void main(String[] args) {
+    byte[] xb = new byte[N];
+    byte[] yb = new byte[N];
+    short[] xs = new short[N];
+    short[] ys = new short[N];
+    for (int i = 0, k = -17; i < N; i++, k += 3) {
+      xb[i] = (byte) k;
+      yb[i] = (byte) (k * 7 + 3);
+      xs[i] = (short) (k * 37);
+      ys[i] = (short) (-k * 113 + 5);
+    }
+
+    // Test various idioms in loops.
+    expectEquals(40128, sadByte(xb, yb));
+    expectEquals(12817906, sadShort(xs, ys));
+    expectEquals(354508, dotProdByte(xb, yb));
+    expectEquals(1190498312, dotProdShort(xs, ys));
+
+    System.out.println("passed");
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Tests for loop versioning: a vector loop guarded by runtime tests,
+ * with a sequential loop that executes all iterations otherwise.
+ */
+public class Main {
+
+  static final int N = 101;
+
+  /// CHECK-START-ARM64: void Main.multiAlias(int[], int[], int[]) loop_optimization (after)
+  /// CHECK-DAG:               NotEqual                       loop:none
+  /// CHECK-DAG:               NotEqual                       loop:none
+  /// CHECK-DAG: <<Phi:i\d+>>  Phi                            loop:<<Loop:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Get1:d\d+>> VecLoad [{{l\d+}},<<Phi>>]     loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Get2:d\d+>> VecLoad [{{l\d+}},<<Phi>>]     loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG: <<Add:d\d+>>  VecAdd [<<Get1>>,<<Get2>>]     loop:<<Loop>>      outer_loop:none
+  /// CHECK-DAG:               VecStore [{{l\d+}},{{i\d+}},<<Add>>] loop:<<Loop>> outer_loop:none
+  private static void multiAlias(int[] a, int[] b, int[] c) {
+    // Two disambiguation tests are needed: a != b and a != c.
+    for (int i = 0; i < 100; i++) {
+      a[i + 1] = b[i] + c[i];
+    }
+  }
+
+  private static void copyShifted(int[] a, int[] b, int n) {
+    for (int i = 0; i < n; i++) {
+      a[i] = b[i + 1];
+    }
+  }
+
+  static int[] sCopy;
+
+  // The bounds check on a[i + 1] certainly fails, so bounds check elimination leaves it
+  // alone. The vector loop is versioned on a runtime bounds test instead, and the check
+  // is retained in the sequential loop, with the environment of the original check.
+  //
+  /// CHECK-START: void Main.copyShiftedFixed(int[]) bounds_check_elimination (after)
+  /// CHECK-DAG:               BoundsCheck                    loop:{{B\d+}}
+  //
+  /// CHECK-START-ARM64: void Main.copyShiftedFixed(int[]) loop_optimization (after)
+  /// CHECK-DAG:               LessThanOrEqual                loop:none
+  /// CHECK-DAG: <<Get:d\d+>>  VecLoad                        loop:<<Loop1:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecStore [{{l\d+}},{{i\d+}},<<Get>>] loop:<<Loop1>> outer_loop:none
+  /// CHECK-DAG: <<Phi:i\d+>>  Phi                            loop:<<Loop2:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Add:i\d+>>  Add [<<Phi>>,{{i\d+}}]         loop:<<Loop2>>      outer_loop:none
+  /// CHECK-DAG:               BoundsCheck [<<Add>>,{{i\d+}}] env:[[{{[^\]]*}}<<Phi>>{{[^\]]*}}]] loop:<<Loop2>> outer_loop:none
+  /// CHECK-EVAL: "<<Loop1>>" != "<<Loop2>>"
+  //
+  /// CHECK-START-X86_64: void Main.copyShiftedFixed(int[]) loop_optimization (after)
+  /// CHECK-DAG:               LessThanOrEqual                loop:none
+  /// CHECK-DAG: <<Get:d\d+>>  VecLoad                        loop:<<Loop1:B\d+>> outer_loop:none
+  /// CHECK-DAG:               VecStore [{{l\d+}},{{i\d+}},<<Get>>] loop:<<Loop1>> outer_loop:none
+  /// CHECK-DAG: <<Phi:i\d+>>  Phi                            loop:<<Loop2:B\d+>> outer_loop:none
+  /// CHECK-DAG: <<Add:i\d+>>  Add [<<Phi>>,{{i\d+}}]         loop:<<Loop2>>      outer_loop:none
+  /// CHECK-DAG:               BoundsCheck [<<Add>>,{{i\d+}}] env:[[{{[^\]]*}}<<Phi>>{{[^\]]*}}]] loop:<<Loop2>> outer_loop:none
+  /// CHECK-EVAL: "<<Loop1>>" != "<<Loop2>>"
+  private static void copyShiftedFixed(int[] b) {
+    int[] a = new int[100];
+    sCopy = a;
+    for (int i = 0; i < 100; i++) {
+      a[i + 1] = b[i];
+    }
+  }
+
+  //
+  // Main driver.
+  //
+
+  public static void main(String[] args) {
+    int[] x = new int[N];
+    int[] y = new int[N];
+    int[] z = new int[N];
+    for (int i = 0; i < N; i++) {
+      x[i] = i * 7 - 50;
+      y[i] = 3 * i + 1;
+    }
+
+    // Disjoint arrays.
+    multiAlias(z, x, y);
+    expectEquals(44600, sum(z));
+
+    // Aliased arrays must execute sequentially.
+    multiAlias(x, x, y);
+    expectEquals(499950, sum(x));
+    expectEquals(14900, x[N - 1]);
+
+    // An out-of-bounds access must only occur after all earlier iterations.
+    int[] a = new int[N];
+    int[] b = new int[N];
+    for (int i = 0; i < N; i++) {
+      b[i] = i;
+    }
+    try {
+      copyShifted(a, b, N);
+      throw new Error("Expected ArrayIndexOutOfBoundsException");
+    } catch (ArrayIndexOutOfBoundsException e) {
+      // Expected.
+    }
+    for (int i = 0; i < N - 1; i++) {
+      expectEquals(i + 1, a[i]);
+    }
+    expectEquals(0, a[N - 1]);
+
+    // Same, on the versioning path that retains the bounds check.
+    try {
+      copyShiftedFixed(b);
+      throw new Error("Expected ArrayIndexOutOfBoundsException");
+    } catch (ArrayIndexOutOfBoundsException e) {
+      // Expected.
+    }
+    expectEquals(0, sCopy[0]);
+    for (int i = 1; i < 100; i++) {
+      expectEquals(i - 1, sCopy[i]);
+    }
+
+    System.out.println("passed");
+  }
+
+  private static int sum(int[] a) {
+    int s = 0;
+    for (int i = 0; i < a.length; i++) {
+      s += a[i];
+    }
+    return s;
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+class Point {
+  int x;
+  int y;
+}
+
+public class Main {
+
+  static Point escaped;
+
+  public static void $noinline$escape(Point p) {
+    escaped = p;
+  }
+
+  public static void $noinline$call() {
+  }
+
+  /// CHECK-START: int Main.testPartialEscape(int, int, boolean) load_store_elimination (before)
+  /// CHECK: <<New:l\d+>> NewInstance
+  /// CHECK:              InstanceFieldSet [<<New>>,{{i\d+}}]
+  /// CHECK:              InstanceFieldSet [<<New>>,{{i\d+}}]
+  /// CHECK:              If
+  /// CHECK:              InvokeStaticOrDirect [<<New>>{{(,[ij]\d+)?}}] method_name:Main.$noinline$escape
+  /// CHECK:              Throw
+  /// CHECK:              InstanceFieldGet [<<New>>]
+  /// CHECK:              InstanceFieldGet [<<New>>]
+
+  /// CHECK-START: int Main.testPartialEscape(int, int, boolean) load_store_elimination (after)
+  /// CHECK-NOT:          InstanceFieldGet
+
+  /// CHECK-START: int Main.testPartialEscape(int, int, boolean) code_sinking (after)
+  /// CHECK-NOT:          NewInstance
+  /// CHECK:              If
+  /// CHECK:              begin_block
+  /// CHECK: <<New:l\d+>> NewInstance
+  /// CHECK-NOT:          begin_block
+  /// CHECK:              InstanceFieldSet [<<New>>,{{i\d+}}]
+  /// CHECK-NOT:          begin_block
+  /// CHECK:              InstanceFieldSet [<<New>>,{{i\d+}}]
+  /// CHECK-NOT:          begin_block
+  /// CHECK:              InvokeStaticOrDirect [<<New>>{{(,[ij]\d+)?}}] method_name:Main.$noinline$escape
+  /// CHECK:              Throw
+  public static int testPartialEscape(int a, int b, boolean fail) {
+    Point p = new Point();
+    p.x = a;
+    p.y = b;
+    if (fail) {
+      $noinline$escape(p);
+      throw new Error();
+    }
+    return p.x + p.y;
+  }
+
+  // Calls do not kill the fields of an allocation that has not escaped yet.
+
+  /// CHECK-START: int Main.testCallBeforeUse(int, int, boolean) load_store_elimination (after)
+  /// CHECK-NOT:          InstanceFieldGet
+  public static int testCallBeforeUse(int a, int b, boolean fail) {
+    Point p = new Point();
+    p.x = a;
+    p.y = b;
+    $noinline$call();
+    if (fail) {
+      $noinline$escape(p);
+      throw new Error();
+    }
+    return p.x + p.y;
+  }
+
+  // Loads after the escape must still read the heap.
+
+  /// CHECK-START: int Main.testLoadAfterEscape(int, int, boolean) load_store_elimination (after)
+  /// CHECK:              InvokeStaticOrDirect method_name:Main.$noinline$escape
+  /// CHECK:              InstanceFieldGet
+  /// CHECK:              Throw
+  public static int testLoadAfterEscape(int a, int b, boolean fail) {
+    Point p = new Point();
+    p.x = a;
+    p.y = b;
+    if (fail) {
+      $noinline$escape(p);
+      throw new Error("escaped " + p.x + " " + p.y);
+    }
+    return p.x + p.y;
+  }
+
+  // An allocation that escapes on the common path is not a partial singleton.
+
+  /// CHECK-START: int Main.testFullEscape(int, int, boolean) load_store_elimination (after)
+  /// CHECK:              InvokeStaticOrDirect method_name:Main.$noinline$escape
+  /// CHECK:              InstanceFieldGet
+  public static int testFullEscape(int a, int b, boolean fail) {
+    Point p = new Point();
+    p.x = a;
+    p.y = b;
+    $noinline$escape(p);
+    if (fail) {
+      throw new Error();
+    }
+    return p.x + p.y;
+  }
+
+  public static void main(String[] args) {
+    System.out.println(testPartialEscape(1, 2, false));
+    System.out.println(testCallBeforeUse(1, 2, false));
+    try {
+      testLoadAfterEscape(1, 2, true);
+    } catch (Error e) {
+      System.out.println(e.getMessage());
+    }
+    System.out.println(testLoadAfterEscape(2, 3, false));
+    try {
+      testPartialEscape(2, 3, true);
+    } catch (Error e) {
+      System.out.println("escaped " + escaped.x + " " + escaped.y);
+    }
+    System.out.println(testFullEscape(3, 4, false));
+  }
+}
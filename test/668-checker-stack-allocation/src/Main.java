@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+class Point {
+  int x;
+  int y;
+}
+
+public class Main {
+
+  static Object escaped;
+
+  public static void $noinline$escape(Object o) {
+    escaped = o;
+  }
+
+  public static void $noinline$gc() {
+    Runtime.getRuntime().gc();
+  }
+
+  /// CHECK-START-X86_64: int Main.testArray(int) stack_allocation (before)
+  /// CHECK:     NewArray
+
+  /// CHECK-START-X86_64: int Main.testArray(int) stack_allocation (after)
+  /// CHECK-NOT: NewArray
+  /// CHECK:     StackAllocation
+
+  /// CHECK-START-ARM64: int Main.testArray(int) stack_allocation (after)
+  /// CHECK-NOT: NewArray
+  /// CHECK:     StackAllocation
+  public static int testArray(int n) {
+    int[] a = new int[8];
+    for (int i = 0; i < n; i++) {
+      a[i & 7] += i;
+    }
+    return a[n & 7] + a[(n >> 1) & 7];
+  }
+
+  /// CHECK-START-X86_64: long Main.testArrayLiveAcrossGc(int) stack_allocation (after)
+  /// CHECK-NOT: NewArray
+  /// CHECK:     StackAllocation
+  /// CHECK:     InvokeStaticOrDirect method_name:Main.$noinline$gc
+  public static long testArrayLiveAcrossGc(int n) {
+    long[] a = new long[4];
+    for (int i = 0; i < n; i++) {
+      a[i & 3] += i;
+    }
+    $noinline$gc();
+    return a[n & 3] + a[(n + 1) & 3];
+  }
+
+  /// CHECK-START-X86_64: int Main.testInstance(int) stack_allocation (after)
+  /// CHECK-NOT: NewInstance
+  /// CHECK:     StackAllocation
+  public static int testInstance(int n) {
+    Point p = new Point();
+    for (int i = 0; i < n; i++) {
+      p.x += i;
+      p.y ^= i;
+    }
+    return p.x + p.y;
+  }
+
+  /// CHECK-START-X86_64: int Main.testEscape(int) stack_allocation (after)
+  /// CHECK:     NewArray
+  /// CHECK-NOT: StackAllocation
+  public static int testEscape(int n) {
+    int[] a = new int[2];
+    a[n & 1] = n;
+    $noinline$escape(a);
+    return a[0] + a[1];
+  }
+
+  /// CHECK-START-X86_64: int Main.testTooLarge(int) stack_allocation (after)
+  /// CHECK:     NewArray
+  /// CHECK-NOT: StackAllocation
+  public static int testTooLarge(int n) {
+    int[] a = new int[100];
+    a[n % 100] = n;
+    return a[n % 100];
+  }
+
+  public static void main(String[] args) {
+    System.out.println(testArray(10));
+    System.out.println(testArrayLiveAcrossGc(6));
+    System.out.println(testInstance(5));
+    System.out.println(testEscape(3));
+    System.out.println(testTooLarge(42));
+  }
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  public static int medium(int x) {
+    return x * 3 + x / 7 - (x >> 2);
+  }
+
+  public static int small(int x) {
+    return x + 1;
+  }
+
+  // The call on the throwing path is cold: only small methods are inlined there.
+
+  /// CHECK-START: int Main.$noinline$mediumCallSites(int) inliner (before)
+  /// CHECK:     InvokeStaticOrDirect method_name:Main.medium
+  /// CHECK:     InvokeStaticOrDirect method_name:Main.medium
+
+  /// CHECK-START: int Main.$noinline$mediumCallSites(int) inliner (after)
+  /// CHECK:     InvokeStaticOrDirect method_name:Main.medium
+  /// CHECK-NOT: InvokeStaticOrDirect method_name:Main.medium
+  public static int $noinline$mediumCallSites(int x) {
+    if (x < 0) {
+      throw new Error("Negative input: " + medium(x));
+    }
+    return medium(x);
+  }
+
+  /// CHECK-START: int Main.$noinline$smallCallSites(int) inliner (before)
+  /// CHECK:     InvokeStaticOrDirect method_name:Main.small
+  /// CHECK:     InvokeStaticOrDirect method_name:Main.small
+
+  /// CHECK-START: int Main.$noinline$smallCallSites(int) inliner (after)
+  /// CHECK-NOT: InvokeStaticOrDirect method_name:Main.small
+  public static int $noinline$smallCallSites(int x) {
+    if (x < 0) {
+      throw new Error("Negative input: " + small(x));
+    }
+    return small(x);
+  }
+
+  // Without a profile, a deeply nested call site is not considered cold, even though
+  // evenly split branches would estimate its frequency below the cold threshold.
+
+  /// CHECK-START: int Main.$noinline$nestedCallSite(int) inliner (before)
+  /// CHECK:     InvokeStaticOrDirect method_name:Main.medium
+
+  /// CHECK-START: int Main.$noinline$nestedCallSite(int) inliner (after)
+  /// CHECK-NOT: InvokeStaticOrDirect method_name:Main.medium
+  public static int $noinline$nestedCallSite(int x) {
+    if ((x & 1) != 0) {
+      if ((x & 2) != 0) {
+        if ((x & 4) != 0) {
+          if ((x & 8) != 0) {
+            if ((x & 16) != 0) {
+              if ((x & 32) != 0) {
+                return medium(x);
+              }
+            }
+          }
+        }
+      }
+    }
+    return x;
+  }
+
+  public static void main(String[] args) {
+    System.out.println($noinline$mediumCallSites(12));
+    System.out.println($noinline$smallCallSites(41));
+    System.out.println($noinline$nestedCallSite(63));
+    try {
+      $noinline$mediumCallSites(-7);
+    } catch (Error e) {
+      System.out.println(e.getMessage());
+    }
+  }
+}
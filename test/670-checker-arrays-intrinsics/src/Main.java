@@ -0,0 +1,348 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.util.Arrays;
+
+public class Main {
+
+  // Lengths exercising the 16 bytes loops, the 8 bytes step and the element loops.
+  private static final int MAX_LENGTH = 70;
+
+  /// CHECK-START: boolean Main.$noinline$equalsBytes(byte[], byte[]) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysEqualsByte
+
+  /// CHECK-START-ARM64: boolean Main.$noinline$equalsBytes(byte[], byte[]) disassembly (after)
+  /// CHECK:     InvokeStaticOrDirect intrinsic:ArraysEqualsByte
+  /// CHECK-NOT: blr
+  /// CHECK:     Return
+
+  /// CHECK-START-X86_64: boolean Main.$noinline$equalsBytes(byte[], byte[]) disassembly (after)
+  /// CHECK:     InvokeStaticOrDirect intrinsic:ArraysEqualsByte
+  /// CHECK-NOT: call
+  /// CHECK:     Return
+  public static boolean $noinline$equalsBytes(byte[] a, byte[] b) {
+    return Arrays.equals(a, b);
+  }
+
+  /// CHECK-START: boolean Main.$noinline$equalsChars(char[], char[]) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysEqualsChar
+  public static boolean $noinline$equalsChars(char[] a, char[] b) {
+    return Arrays.equals(a, b);
+  }
+
+  /// CHECK-START: boolean Main.$noinline$equalsShorts(short[], short[]) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysEqualsShort
+  public static boolean $noinline$equalsShorts(short[] a, short[] b) {
+    return Arrays.equals(a, b);
+  }
+
+  /// CHECK-START: boolean Main.$noinline$equalsInts(int[], int[]) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysEqualsInt
+  public static boolean $noinline$equalsInts(int[] a, int[] b) {
+    return Arrays.equals(a, b);
+  }
+
+  /// CHECK-START: boolean Main.$noinline$equalsLongs(long[], long[]) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysEqualsLong
+  public static boolean $noinline$equalsLongs(long[] a, long[] b) {
+    return Arrays.equals(a, b);
+  }
+
+  /// CHECK-START: void Main.$noinline$fillBytes(byte[], byte) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysFillByte
+  public static void $noinline$fillBytes(byte[] a, byte value) {
+    Arrays.fill(a, value);
+  }
+
+  /// CHECK-START: void Main.$noinline$fillChars(char[], char) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysFillChar
+  public static void $noinline$fillChars(char[] a, char value) {
+    Arrays.fill(a, value);
+  }
+
+  /// CHECK-START: void Main.$noinline$fillShorts(short[], short) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysFillShort
+  public static void $noinline$fillShorts(short[] a, short value) {
+    Arrays.fill(a, value);
+  }
+
+  /// CHECK-START: void Main.$noinline$fillInts(int[], int) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysFillInt
+  public static void $noinline$fillInts(int[] a, int value) {
+    Arrays.fill(a, value);
+  }
+
+  /// CHECK-START: void Main.$noinline$fillLongs(long[], long) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysFillLong
+  public static void $noinline$fillLongs(long[] a, long value) {
+    Arrays.fill(a, value);
+  }
+
+  /// CHECK-START: int Main.$noinline$hashCodeBytes(byte[]) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysHashCodeByte
+  public static int $noinline$hashCodeBytes(byte[] a) {
+    return Arrays.hashCode(a);
+  }
+
+  /// CHECK-START: int Main.$noinline$hashCodeChars(char[]) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysHashCodeChar
+  public static int $noinline$hashCodeChars(char[] a) {
+    return Arrays.hashCode(a);
+  }
+
+  /// CHECK-START: int Main.$noinline$hashCodeShorts(short[]) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysHashCodeShort
+  public static int $noinline$hashCodeShorts(short[] a) {
+    return Arrays.hashCode(a);
+  }
+
+  /// CHECK-START: int Main.$noinline$hashCodeInts(int[]) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysHashCodeInt
+  public static int $noinline$hashCodeInts(int[] a) {
+    return Arrays.hashCode(a);
+  }
+
+  /// CHECK-START: int Main.$noinline$hashCodeLongs(long[]) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:ArraysHashCodeLong
+  public static int $noinline$hashCodeLongs(long[] a) {
+    return Arrays.hashCode(a);
+  }
+
+  // The generic System.arraycopy() is turned into the typed one for primitive arrays.
+
+  /// CHECK-START: void Main.$noinline$copyBytes(byte[], int, byte[], int, int) instruction_simplifier (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:SystemArrayCopyByte
+
+  /// CHECK-START-X86_64: void Main.$noinline$copyBytes(byte[], int, byte[], int, int) disassembly (after)
+  /// CHECK:     InvokeStaticOrDirect intrinsic:SystemArrayCopyByte
+  /// CHECK:     rep movsb
+  /// CHECK-NOT: call
+  /// CHECK:     ReturnVoid
+  public static void $noinline$copyBytes(byte[] src, int srcPos, byte[] dst, int dstPos, int n) {
+    System.arraycopy(src, srcPos, dst, dstPos, n);
+  }
+
+  /// CHECK-START: void Main.$noinline$copyShorts(short[], int, short[], int, int) instruction_simplifier (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:SystemArrayCopyShort
+  public static void $noinline$copyShorts(short[] src, int srcPos, short[] dst, int dstPos, int n) {
+    System.arraycopy(src, srcPos, dst, dstPos, n);
+  }
+
+  /// CHECK-START: void Main.$noinline$copyInts(int[], int, int[], int, int) instruction_simplifier (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:SystemArrayCopyInt
+  public static void $noinline$copyInts(int[] src, int srcPos, int[] dst, int dstPos, int n) {
+    System.arraycopy(src, srcPos, dst, dstPos, n);
+  }
+
+  /// CHECK-START: void Main.$noinline$copyLongs(long[], int, long[], int, int) instruction_simplifier (after)
+  /// CHECK-DAG: InvokeStaticOrDirect intrinsic:SystemArrayCopyLong
+  public static void $noinline$copyLongs(long[] src, int srcPos, long[] dst, int dstPos, int n) {
+    System.arraycopy(src, srcPos, dst, dstPos, n);
+  }
+
+  public static void main(String[] args) {
+    for (int length = 0; length <= MAX_LENGTH; length++) {
+      testEquals(length);
+      testFill(length);
+      testHashCode(length);
+    }
+    testNulls();
+    for (int n = 0; n <= MAX_LENGTH / 2; n++) {
+      testArrayCopy(n);
+    }
+    testArrayCopyExceptions();
+    System.out.println("passed");
+  }
+
+  private static void testEquals(int length) {
+    byte[] b1 = new byte[length];
+    char[] c1 = new char[length];
+    short[] s1 = new short[length];
+    int[] i1 = new int[length];
+    long[] l1 = new long[length];
+    for (int i = 0; i < length; i++) {
+      b1[i] = (byte) (i * 37);
+      c1[i] = (char) (i * 4099);
+      s1[i] = (short) (i * -4099);
+      i1[i] = i * 0x01010101;
+      l1[i] = i * 0x0101010101010101L;
+    }
+    expectEquals(true, $noinline$equalsBytes(b1, b1));
+    expectEquals(true, $noinline$equalsBytes(b1, b1.clone()));
+    expectEquals(true, $noinline$equalsChars(c1, c1.clone()));
+    expectEquals(true, $noinline$equalsShorts(s1, s1.clone()));
+    expectEquals(true, $noinline$equalsInts(i1, i1.clone()));
+    expectEquals(true, $noinline$equalsLongs(l1, l1.clone()));
+    // A difference in any element, in particular in the tails.
+    for (int i = 0; i < length; i++) {
+      byte[] b2 = b1.clone();
+      b2[i]++;
+      expectEquals(false, $noinline$equalsBytes(b1, b2));
+      char[] c2 = c1.clone();
+      c2[i]++;
+      expectEquals(false, $noinline$equalsChars(c1, c2));
+      short[] s2 = s1.clone();
+      s2[i]++;
+      expectEquals(false, $noinline$equalsShorts(s1, s2));
+      int[] i2 = i1.clone();
+      i2[i]++;
+      expectEquals(false, $noinline$equalsInts(i1, i2));
+      long[] l2 = l1.clone();
+      l2[i] += 1L << 40;
+      expectEquals(false, $noinline$equalsLongs(l1, l2));
+    }
+    // Different lengths.
+    expectEquals(false, $noinline$equalsBytes(b1, new byte[length + 1]));
+    expectEquals(false, $noinline$equalsLongs(l1, new long[length + 1]));
+  }
+
+  private static void testFill(int length) {
+    byte[] b = new byte[length];
+    char[] c = new char[length];
+    short[] s = new short[length];
+    int[] i = new int[length];
+    long[] l = new long[length];
+    $noinline$fillBytes(b, (byte) -3);
+    $noinline$fillChars(c, (char) 0xfedc);
+    $noinline$fillShorts(s, (short) -1234);
+    $noinline$fillInts(i, 0x89abcdef);
+    $noinline$fillLongs(l, 0x0123456789abcdefL);
+    for (int k = 0; k < length; k++) {
+      expectEquals((byte) -3, b[k]);
+      expectEquals((char) 0xfedc, c[k]);
+      expectEquals((short) -1234, s[k]);
+      expectEquals(0x89abcdef, i[k]);
+      expectEquals(0x0123456789abcdefL, l[k]);
+    }
+  }
+
+  private static void testHashCode(int length) {
+    byte[] b = new byte[length];
+    char[] c = new char[length];
+    short[] s = new short[length];
+    int[] i = new int[length];
+    long[] l = new long[length];
+    int bHash = 1;
+    int cHash = 1;
+    int sHash = 1;
+    int iHash = 1;
+    int lHash = 1;
+    for (int k = 0; k < length; k++) {
+      // Include negative values, which the narrow types sign or zero extend.
+      b[k] = (byte) (k * 67);
+      c[k] = (char) (k * 40503);
+      s[k] = (short) (k * 40503);
+      i[k] = k * 0x9e3779b9;
+      l[k] = k * 0x9e3779b97f4a7c15L;
+      bHash = 31 * bHash + b[k];
+      cHash = 31 * cHash + c[k];
+      sHash = 31 * sHash + s[k];
+      iHash = 31 * iHash + i[k];
+      lHash = 31 * lHash + (int) (l[k] ^ (l[k] >>> 32));
+    }
+    expectEquals(bHash, $noinline$hashCodeBytes(b));
+    expectEquals(cHash, $noinline$hashCodeChars(c));
+    expectEquals(sHash, $noinline$hashCodeShorts(s));
+    expectEquals(iHash, $noinline$hashCodeInts(i));
+    expectEquals(lHash, $noinline$hashCodeLongs(l));
+  }
+
+  private static void testNulls() {
+    expectEquals(true, $noinline$equalsBytes(null, null));
+    expectEquals(false, $noinline$equalsBytes(new byte[0], null));
+    expectEquals(false, $noinline$equalsInts(null, new int[0]));
+    expectEquals(0, $noinline$hashCodeBytes(null));
+    expectEquals(0, $noinline$hashCodeChars(null));
+    expectEquals(0, $noinline$hashCodeShorts(null));
+    expectEquals(0, $noinline$hashCodeInts(null));
+    expectEquals(0, $noinline$hashCodeLongs(null));
+    try {
+      $noinline$fillInts(null, 42);
+      throw new Error("Expected NullPointerException");
+    } catch (NullPointerException expected) {
+      // Expected.
+    }
+  }
+
+  private static void testArrayCopy(int n) {
+    byte[] b = new byte[MAX_LENGTH];
+    short[] s = new short[MAX_LENGTH];
+    int[] i = new int[MAX_LENGTH];
+    long[] l = new long[MAX_LENGTH];
+    for (int k = 0; k < MAX_LENGTH; k++) {
+      b[k] = (byte) k;
+      s[k] = (short) (k * 1001);
+      i[k] = k * 100001;
+      l[k] = k * 10000000001L;
+    }
+    int srcPos = 3;
+    int dstPos = 5;
+    byte[] bCopy = new byte[MAX_LENGTH];
+    short[] sCopy = new short[MAX_LENGTH];
+    int[] iCopy = new int[MAX_LENGTH];
+    long[] lCopy = new long[MAX_LENGTH];
+    $noinline$copyBytes(b, srcPos, bCopy, dstPos, n);
+    $noinline$copyShorts(s, srcPos, sCopy, dstPos, n);
+    $noinline$copyInts(i, srcPos, iCopy, dstPos, n);
+    $noinline$copyLongs(l, srcPos, lCopy, dstPos, n);
+    for (int k = 0; k < MAX_LENGTH; k++) {
+      boolean copied = k >= dstPos && k < dstPos + n;
+      int from = k - dstPos + srcPos;
+      expectEquals(copied ? b[from] : 0, bCopy[k]);
+      expectEquals(copied ? s[from] : 0, sCopy[k]);
+      expectEquals(copied ? i[from] : 0, iCopy[k]);
+      expectEquals(copied ? l[from] : 0L, lCopy[k]);
+    }
+    // Overlapping copy within the same array.
+    $noinline$copyInts(i, 0, i, 1, n);
+    for (int k = 1; k <= n; k++) {
+      expectEquals((k - 1) * 100001, i[k]);
+    }
+  }
+
+  private static void testArrayCopyExceptions() {
+    try {
+      $noinline$copyBytes(new byte[4], 2, new byte[4], 0, 3);
+      throw new Error("Expected ArrayIndexOutOfBoundsException");
+    } catch (ArrayIndexOutOfBoundsException expected) {
+      // Expected.
+    }
+    try {
+      $noinline$copyLongs(null, 0, new long[4], 0, 1);
+      throw new Error("Expected NullPointerException");
+    } catch (NullPointerException expected) {
+      // Expected.
+    }
+  }
+
+  private static void expectEquals(boolean expected, boolean result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(long expected, long result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
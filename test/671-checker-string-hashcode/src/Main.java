@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+
+  // Lengths exercising the vector loops and the element loops.
+  private static final int MAX_LENGTH = 70;
+
+  /// CHECK-START: int Main.$noinline$hashCode(java.lang.String) intrinsics_recognition (after)
+  /// CHECK-DAG: InvokeVirtual intrinsic:StringHashCode
+
+  /// CHECK-START-ARM64: int Main.$noinline$hashCode(java.lang.String) disassembly (after)
+  /// CHECK:     InvokeVirtual intrinsic:StringHashCode
+  /// CHECK-NOT: blr
+  /// CHECK:     Return
+
+  /// CHECK-START-X86_64: int Main.$noinline$hashCode(java.lang.String) disassembly (after)
+  /// CHECK:     InvokeVirtual intrinsic:StringHashCode
+  /// CHECK-NOT: call
+  /// CHECK:     Return
+  public static int $noinline$hashCode(String s) {
+    return s.hashCode();
+  }
+
+  public static void main(String[] args) {
+    for (int length = 0; length <= MAX_LENGTH; length++) {
+      // Compressible characters.
+      testHashCode(length, 'a', 1);
+      // Characters zero extended from bytes but not compressible.
+      testHashCode(length, (char) 0x80, 3);
+      // Characters with the sign bit of a short set.
+      testHashCode(length, (char) 0xff00, 257);
+    }
+
+    // Strings hashing to 0 are not cached, and hashed again on each call.
+    String zero = "f5a5a608";
+    expectEquals(0, $noinline$hashCode(zero));
+    expectEquals(0, $noinline$hashCode(zero + zero + zero + zero));
+    expectEquals(0, $noinline$hashCode(new String(new char[MAX_LENGTH])));
+    expectEquals(0, $noinline$hashCode(""));
+
+    System.out.println("passed");
+  }
+
+  private static void testHashCode(int length, char first, int step) {
+    char[] chars = new char[length];
+    for (int i = 0; i < length; i++) {
+      chars[i] = (char) (first + (i * step) % 26);
+    }
+    int expected = 0;
+    for (char c : chars) {
+      expected = 31 * expected + c;
+    }
+    // A new string, whose hash code is not cached yet.
+    String s = new String(chars);
+    expectEquals(expected, $noinline$hashCode(s));
+    // The cached hash code.
+    expectEquals(expected, $noinline$hashCode(s));
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
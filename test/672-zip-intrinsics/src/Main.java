@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.nio.ByteBuffer;
+import java.util.zip.Adler32;
+import java.util.zip.CRC32;
+import java.util.zip.Checksum;
+
+public class Main {
+
+  // Lengths exercising the sixteen, eight, four bytes and byte loops, and the inlined Adler32
+  // limit.
+  private static final int MAX_LENGTH = 300;
+
+  // Longer than the buffers the intrinsics checksum themselves.
+  private static final int LARGE_LENGTH = 70000;
+
+  public static void main(String[] args) {
+    byte[] bytes = new byte[LARGE_LENGTH];
+    for (int i = 0; i < bytes.length; i++) {
+      bytes[i] = (byte) (i * 131 + (i >> 8));
+    }
+
+    testUpdateByte();
+    for (int length = 0; length <= MAX_LENGTH; length++) {
+      testUpdateBytes(bytes, 0, length);
+      testUpdateBytes(bytes, 3, length);
+      testUpdateByteBuffer(bytes, 5, length);
+    }
+    testUpdateBytes(bytes, 0, LARGE_LENGTH);
+    testUpdateByteBuffer(bytes, 0, LARGE_LENGTH);
+
+    System.out.println("passed");
+  }
+
+  private static void testUpdateByte() {
+    CRC32 crc = new CRC32();
+    Adler32 adler = new Adler32();
+    int expectedCrc = 0;
+    int expectedAdler = 1;
+    for (int i = 0; i < 1000; i++) {
+      // Only the low byte of the argument is used.
+      int b = i * 0x01010101 + 0x7f00;
+      crc.update(b);
+      adler.update(b);
+      expectedCrc = crc32(expectedCrc, new byte[] { (byte) b }, 0, 1);
+      expectedAdler = adler32(expectedAdler, new byte[] { (byte) b }, 0, 1);
+      expectEquals(expectedCrc, (int) crc.getValue());
+      expectEquals(expectedAdler, (int) adler.getValue());
+    }
+  }
+
+  private static void testUpdateBytes(byte[] bytes, int offset, int length) {
+    // Start from a value that is not the initial one.
+    CRC32 crc = new CRC32();
+    crc.update(42);
+    Adler32 adler = new Adler32();
+    adler.update(42);
+    int expectedCrc = crc32(0, new byte[] { 42 }, 0, 1);
+    int expectedAdler = adler32(1, new byte[] { 42 }, 0, 1);
+
+    crc.update(bytes, offset, length);
+    adler.update(bytes, offset, length);
+    expectEquals(crc32(expectedCrc, bytes, offset, length), (int) crc.getValue());
+    expectEquals(adler32(expectedAdler, bytes, offset, length), (int) adler.getValue());
+  }
+
+  private static void testUpdateByteBuffer(byte[] bytes, int offset, int length) {
+    ByteBuffer buffer = ByteBuffer.allocateDirect(offset + length);
+    buffer.put(bytes, 0, offset + length);
+    checkByteBuffer(new CRC32(), buffer, offset, crc32(0, bytes, offset, length));
+    checkByteBuffer(new Adler32(), buffer, offset, adler32(1, bytes, offset, length));
+  }
+
+  private static void checkByteBuffer(Checksum checksum, ByteBuffer buffer, int offset,
+                                      int expected) {
+    buffer.position(offset);
+    if (checksum instanceof CRC32) {
+      ((CRC32) checksum).update(buffer);
+    } else {
+      ((Adler32) checksum).update(buffer);
+    }
+    expectEquals(expected, (int) checksum.getValue());
+  }
+
+  // Reference implementations, one bit or one byte at a time.
+
+  private static int crc32(int crc, byte[] bytes, int offset, int length) {
+    crc = ~crc;
+    for (int i = offset; i < offset + length; i++) {
+      crc ^= bytes[i] & 0xff;
+      for (int bit = 0; bit < 8; bit++) {
+        crc = (crc >>> 1) ^ (-(crc & 1) & 0xedb88320);
+      }
+    }
+    return ~crc;
+  }
+
+  private static int adler32(int adler, byte[] bytes, int offset, int length) {
+    int a = adler & 0xffff;
+    int b = adler >>> 16;
+    for (int i = offset; i < offset + length; i++) {
+      a = (a + (bytes[i] & 0xff)) % 65521;
+      b = (b + a) % 65521;
+    }
+    return (b << 16) | a;
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+class Base {
+  int value() { return 0; }
+}
+
+class A extends Base { int value() { return 1; } }
+class B extends Base { int value() { return 2; } }
+class C extends Base { int value() { return 3; } }
+class D extends Base { int value() { return 4; } }
+class E extends Base { int value() { return 5; } }
+class F extends Base { int value() { return 6; } }
+class G extends Base { int value() { return 7; } }
+class H extends Base { int value() { return 8; } }
+class I extends Base { int value() { return 9; } }
+class J extends Base { int value() { return 10; } }
+
+public class Main {
+  public static void assertEquals(int expected, int actual) {
+    if (expected != actual) {
+      throw new Error("Expected " + expected  + ", got " + actual);
+    }
+  }
+
+  public static int $noinline$callValue(Base b) {
+    return b.value();
+  }
+
+  public static void main(String[] args) {
+    System.loadLibrary(args[0]);
+    Base[] receivers = {
+        new A(), new B(), new C(), new D(), new E(),
+        new F(), new G(), new H(), new I(), new J()
+    };
+
+    // Create the profiling info eagerly to make sure it is filled.
+    ensureProfilingInfo673();
+
+    // See all the receivers once, which fills the inline cache with A and B first and
+    // makes the call site megamorphic, then call it mostly with A and B.
+    for (Base b : receivers) {
+      assertEquals(b.value(), $noinline$callValue(b));
+    }
+    for (int i = 0; i < 10000; ++i) {
+      assertEquals(1, $noinline$callValue(receivers[0]));
+      assertEquals(2, $noinline$callValue(receivers[1]));
+    }
+
+    // The JIT code inlines A.value() and B.value() behind type guards.
+    ensureJittedAndInlined673();
+
+    // The other receivers go through the virtual call, without deoptimizing.
+    for (Base b : receivers) {
+      assertEquals(b.value(), $noinline$callValue(b));
+    }
+    if (hasJit() && !isJitCompiled(Main.class, "$noinline$callValue")) {
+      throw new Error("Expected $noinline$callValue to stay compiled");
+    }
+    System.out.println("passed");
+  }
+
+  private static native boolean hasJit();
+  private static native boolean isJitCompiled(Class<?> cls, String methodName);
+  private static native void ensureProfilingInfo673();
+  private static native void ensureJittedAndInlined673();
+}
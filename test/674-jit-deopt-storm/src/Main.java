@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+class Base {
+  int value() { return 0; }
+}
+
+class A extends Base { int value() { return 1; } }
+class B extends Base { int value() { return 2; } }
+class C extends Base { int value() { return 3; } }
+class D extends Base { int value() { return 4; } }
+class E extends Base { int value() { return 5; } }
+class F extends Base { int value() { return 6; } }
+class G extends Base { int value() { return 7; } }
+
+public class Main {
+  // Must match ProfilingInfo::kMaxDeoptimizationsBeforeNoSpeculation.
+  static final int kMaxDeoptimizationsBeforeNoSpeculation = 4;
+
+  public static void assertEquals(int expected, int actual) {
+    if (expected != actual) {
+      throw new Error("Expected " + expected  + ", got " + actual);
+    }
+  }
+
+  public static int $noinline$callValue(Base b) {
+    return b.value();
+  }
+
+  public static void main(String[] args) {
+    System.loadLibrary(args[0]);
+    if (!hasJit()) {
+      System.out.println("passed");
+      return;
+    }
+    Base[] receivers = {
+        new A(), new B(), new C(), new D(), new E(), new F(), new G()
+    };
+
+    // Each round compiles the method with the receivers seen so far, which the inliner
+    // guards with a deoptimization, then calls it with a new receiver.
+    int deoptimizations = 0;
+    for (int round = 0; round + 1 < receivers.length; ++round) {
+      for (int i = 0; i <= round; ++i) {
+        assertEquals(i + 1, $noinline$callValue(receivers[i]));
+      }
+      ensureJitCompiled(Main.class, "$noinline$callValue");
+      boolean speculationDisabled = isSpeculationDisabled(Main.class, "$noinline$callValue");
+      if (speculationDisabled != (deoptimizations >= kMaxDeoptimizationsBeforeNoSpeculation)) {
+        throw new Error("Unexpected speculation state after " + deoptimizations +
+                        " deoptimizations");
+      }
+
+      int before = numberOfDeoptimizations();
+      assertEquals(round + 2, $noinline$callValue(receivers[round + 1]));
+      int newDeoptimizations = numberOfDeoptimizations() - before;
+      if (speculationDisabled) {
+        // The code compiled without speculation keeps the virtual call as a fallback.
+        assertEquals(0, newDeoptimizations);
+        if (!isJitCompiled(Main.class, "$noinline$callValue")) {
+          throw new Error("Expected $noinline$callValue to stay compiled");
+        }
+      }
+      deoptimizations += newDeoptimizations;
+    }
+    System.out.println("passed");
+  }
+
+  private static native boolean hasJit();
+  private static native boolean isJitCompiled(Class<?> cls, String methodName);
+  private static native void ensureJitCompiled(Class<?> cls, String methodName);
+  private static native int numberOfDeoptimizations();
+  private static native boolean isSpeculationDisabled(Class<?> cls, String methodName);
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+import java.io.BufferedReader;
+import java.io.FileReader;
+
+public class Main {
+  public static void main(String[] args) throws Exception {
+    System.loadLibrary(args[0]);
+    if (hasJit()) {
+      ensureJitCompiled(Main.class, "$noinline$hotMethod");
+      checkTelemetry(findCompilation("Main.$noinline$hotMethod("));
+    }
+    System.out.println("Done");
+  }
+
+  public static int $noinline$hotMethod(int[] array) {
+    int sum = 0;
+    for (int i = 0; i < array.length; ++i) {
+      sum += array[i];
+    }
+    return sum;
+  }
+
+  // Returns the successful compilation of `method` logged by the JIT telemetry.
+  static String findCompilation(String method) throws Exception {
+    String path = System.getenv("DEX_LOCATION") + "/telemetry.json";
+    BufferedReader reader = new BufferedReader(new FileReader(path));
+    try {
+      String line;
+      while ((line = reader.readLine()) != null) {
+        if (!line.startsWith("{") || !line.endsWith("}")) {
+          throw new Error("Malformed telemetry line: " + line);
+        }
+        if (line.contains(method) && line.contains("\"success\":true")) {
+          return line;
+        }
+      }
+    } finally {
+      reader.close();
+    }
+    throw new Error("No successful compilation of " + method + " in " + path);
+  }
+
+  static void checkTelemetry(String line) {
+    assertTrue(line, line.contains("\"osr\":false"));
+    assertTrue(line, !line.contains("\"failure_reason\""));
+    assertTrue(line, getValue(line, "compile_time_ns") > 0);
+    assertTrue(line, getValue(line, "arena_bytes") > 0);
+    assertTrue(line, getValue(line, "code_size") > 0);
+    assertTrue(line, getValue(line, "builder") >= 0);
+    assertTrue(line, getValue(line, "register") >= 0);
+    assertTrue(line, getValue(line, "AttemptCompilation") == 1);
+    assertTrue(line, getValue(line, "Compiled") == 1);
+  }
+
+  // Returns the number after `"key":` in `line`.
+  static long getValue(String line, String key) {
+    String prefix = "\"" + key + "\":";
+    int start = line.indexOf(prefix);
+    if (start == -1) {
+      throw new Error("No " + key + " in " + line);
+    }
+    start += prefix.length();
+    int end = start;
+    while (end < line.length() && Character.isDigit(line.charAt(end))) {
+      ++end;
+    }
+    return Long.parseLong(line.substring(start, end));
+  }
+
+  static void assertTrue(String line, boolean condition) {
+    if (!condition) {
+      throw new Error("Unexpected telemetry: " + line);
+    }
+  }
+
+  private static native boolean hasJit();
+  private static native void ensureJitCompiled(Class<?> cls, String methodName);
+}
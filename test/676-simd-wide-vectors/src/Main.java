@@ -0,0 +1,374 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Functional tests for vectorized loops, run with AVX2 enabled where the host supports it
+ * so that x86-64 emits 256-bit code. The expected values are computed by loops that call
+ * a helper for every element, which keeps them sequential.
+ */
+public class Main {
+
+  // Not a multiple of any vector length, so every loop also runs a cleanup loop.
+  static final int N = 1027;
+
+  static volatile boolean stop = false;
+
+  //
+  // Reductions (vextracti128 followed by the 128-bit combines).
+  //
+
+  private static int sumInt(int[] x) {
+    int sum = 0;
+    for (int i = 0; i < x.length; i++) {
+      sum += x[i];
+    }
+    return sum;
+  }
+
+  private static int minInt(int[] x) {
+    int min = Integer.MAX_VALUE;
+    for (int i = 0; i < x.length; i++) {
+      min = Math.min(min, x[i]);
+    }
+    return min;
+  }
+
+  private static int maxInt(int[] x) {
+    int max = Integer.MIN_VALUE;
+    for (int i = 0; i < x.length; i++) {
+      max = Math.max(max, x[i]);
+    }
+    return max;
+  }
+
+  private static long sumLong(long[] x) {
+    long sum = 0;
+    for (int i = 0; i < x.length; i++) {
+      sum += x[i];
+    }
+    return sum;
+  }
+
+  private static int sadByte(byte[] x, byte[] y) {
+    int sad = 0;
+    for (int i = 0; i < x.length; i++) {
+      sad += Math.abs(x[i] - y[i]);
+    }
+    return sad;
+  }
+
+  private static int dotProdShort(short[] x, short[] y) {
+    int sum = 0;
+    for (int i = 0; i < x.length; i++) {
+      sum += x[i] * y[i];
+    }
+    return sum;
+  }
+
+  //
+  // Element-wise operations on all types (replicated scalars, loads, stores).
+  //
+
+  private static void opsByte(byte[] a, byte[] b, byte k) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] = (byte) ((a[i] + k) ^ b[i]);
+    }
+  }
+
+  private static void opsShort(short[] a, short[] b, short k) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] = (short) ((a[i] * k - b[i]) << 3);
+    }
+  }
+
+  private static void opsInt(int[] a, int[] b, int k) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] = ~(Math.abs(a[i] * b[i]) >> 2) + k;
+    }
+  }
+
+  private static void opsLong(long[] a, long[] b, long k) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] = -((a[i] + b[i]) << 5) ^ k;
+    }
+  }
+
+  private static void opsFloat(float[] a, float[] b, float k) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] = (a[i] + k) * b[i] - k;
+    }
+  }
+
+  private static void opsDouble(double[] a, double[] b, double k) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] = (a[i] - b[i]) / k + k;
+    }
+  }
+
+  //
+  // More invariant vectors than there are SIMD registers: the replicated scalars are
+  // all live throughout the loop, so some of them must be spilled and reloaded.
+  //
+
+  private static void manyInvariants(int[] a, int k0, int k1, int k2, int k3, int k4, int k5,
+                                     int k6, int k7, int k8, int k9, int k10, int k11,
+                                     int k12, int k13, int k14, int k15, int k16, int k17) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] = ((((((((((((((((((a[i] + k0) ^ k1) - k2) & k3) + k4) | k5) - k6) ^ k7) + k8)
+          & k9) - k10) | k11) + k12) ^ k13) - k14) & k15) + k16) ^ k17);
+    }
+  }
+
+  private static int manyInvariantsExpected(int x, int k0, int k1, int k2, int k3, int k4,
+                                            int k5, int k6, int k7, int k8, int k9, int k10,
+                                            int k11, int k12, int k13, int k14, int k15,
+                                            int k16, int k17) {
+    return ((((((((((((((((((x + k0) ^ k1) - k2) & k3) + k4) | k5) - k6) ^ k7) + k8)
+        & k9) - k10) | k11) + k12) ^ k13) - k14) & k15) + k16) ^ k17);
+  }
+
+  //
+  // A long running vector loop with a live replicated scalar, executed while another
+  // thread keeps requesting garbage collections: the suspend check slow path must save
+  // and restore the full width of the live vector registers.
+  //
+
+  private static void addInvariant(int[] a, int k) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] += k;
+    }
+  }
+
+  //
+  // Wide vector code followed by runtime calls and scalar floating-point code
+  // in the same method, which must not observe stale upper register halves.
+  //
+
+  private static double addThenCall(double[] a, double[] b) {
+    for (int i = 0; i < a.length; i++) {
+      a[i] += b[i];
+    }
+    double[] copy = new double[a.length];  // runtime call
+    System.arraycopy(a, 0, copy, 0, a.length);
+    return $noinline$scalarSum(copy) * 0.5;
+  }
+
+  private static double $noinline$scalarSum(double[] x) {
+    double sum = 0;
+    for (int i = 0; i < x.length; i++) {
+      sum += x[i];  // FP reductions are not vectorized
+    }
+    return sum;
+  }
+
+  //
+  // Main driver.
+  //
+
+  public static void main(String[] args) throws Exception {
+    testReductions();
+    testOps();
+    testManyInvariants();
+    testSuspendCheck();
+    testCalls();
+    System.out.println("passed");
+  }
+
+  private static void testReductions() {
+    int[] xi = new int[N];
+    long[] xl = new long[N];
+    byte[] xb = new byte[N];
+    byte[] yb = new byte[N];
+    short[] xs = new short[N];
+    short[] ys = new short[N];
+    for (int i = 0, k = -517; i < N; i++, k += 3) {
+      xi[i] = k * 0x9E3779B1;
+      xl[i] = k * 0x9E3779B97F4A7C15L;
+      xb[i] = (byte) k;
+      yb[i] = (byte) (k * 7 + 3);
+      xs[i] = (short) (k * 37);
+      ys[i] = (short) (-k * 113 + 5);
+    }
+    int sum = 0;
+    int min = Integer.MAX_VALUE;
+    int max = Integer.MIN_VALUE;
+    long lsum = 0;
+    int sad = 0;
+    int dot = 0;
+    for (int i = 0; i < N; i++) {
+      sum = $noinline$addInt(sum, xi[i]);
+      min = $noinline$minInt(min, xi[i]);
+      max = $noinline$maxInt(max, xi[i]);
+      lsum = $noinline$addLong(lsum, xl[i]);
+      sad = $noinline$addInt(sad, Math.abs(xb[i] - yb[i]));
+      dot = $noinline$addInt(dot, xs[i] * ys[i]);
+    }
+    // Run often enough for the JIT to compile the loops as well.
+    for (int r = 0; r < 1000; r++) {
+      expectEquals(sum, sumInt(xi));
+      expectEquals(min, minInt(xi));
+      expectEquals(max, maxInt(xi));
+      expectEquals(lsum, sumLong(xl));
+      expectEquals(sad, sadByte(xb, yb));
+      expectEquals(dot, dotProdShort(xs, ys));
+    }
+  }
+
+  private static void testOps() {
+    byte[] ab = new byte[N];
+    byte[] bb = new byte[N];
+    short[] as = new short[N];
+    short[] bs = new short[N];
+    int[] ai = new int[N];
+    int[] bi = new int[N];
+    long[] al = new long[N];
+    long[] bl = new long[N];
+    float[] af = new float[N];
+    float[] bf = new float[N];
+    double[] ad = new double[N];
+    double[] bd = new double[N];
+    for (int r = 0; r < 100; r++) {
+      for (int i = 0; i < N; i++) {
+        ab[i] = (byte) (i * 3);
+        bb[i] = (byte) (r - i);
+        as[i] = (short) (i * 31);
+        bs[i] = (short) (r * 7 - i);
+        ai[i] = i * 0x01000193;
+        bi[i] = r - i * 5;
+        al[i] = i * 0x100000001B3L;
+        bl[i] = r * 3L - i;
+        af[i] = i * 0.25f;
+        bf[i] = r - i * 0.5f;
+        ad[i] = i * 0.125;
+        bd[i] = r * 0.5 - i;
+      }
+      opsByte(ab, bb, (byte) 17);
+      opsShort(as, bs, (short) -9);
+      opsInt(ai, bi, 12345);
+      opsLong(al, bl, 0x123456789L);
+      opsFloat(af, bf, 1.5f);
+      opsDouble(ad, bd, 4.0);
+      for (int i = 0; i < N; i++) {
+        expectEquals((byte) (((byte) (i * 3) + 17) ^ (byte) (r - i)), ab[i]);
+        expectEquals((short) (((short) (i * 31) * -9 - (short) (r * 7 - i)) << 3), as[i]);
+        expectEquals(~(Math.abs((i * 0x01000193) * (r - i * 5)) >> 2) + 12345, ai[i]);
+        expectEquals(-((i * 0x100000001B3L + (r * 3L - i)) << 5) ^ 0x123456789L, al[i]);
+        expectEquals((i * 0.25f + 1.5f) * (r - i * 0.5f) - 1.5f, af[i]);
+        expectEquals((i * 0.125 - (r * 0.5 - i)) / 4.0 + 4.0, ad[i]);
+      }
+    }
+  }
+
+  private static void testManyInvariants() {
+    int[] a = new int[N];
+    // Read the invariants from an array, so that inlining cannot fold them into constants.
+    int[] k = { 1, 2, 3, -5, 5, 6, 7, 8, 9, -11, 11, 12, 13, 14, 15, -17, 17, 0 };
+    for (int r = 0; r < 100; r++) {
+      k[17] = r;
+      for (int i = 0; i < N; i++) {
+        a[i] = i * 0x9E3779B1 + r;
+      }
+      manyInvariants(a, k[0], k[1], k[2], k[3], k[4], k[5], k[6], k[7], k[8],
+                     k[9], k[10], k[11], k[12], k[13], k[14], k[15], k[16], k[17]);
+      for (int i = 0; i < N; i++) {
+        expectEquals(manyInvariantsExpected(i * 0x9E3779B1 + r,
+                                            k[0], k[1], k[2], k[3], k[4], k[5], k[6], k[7],
+                                            k[8], k[9], k[10], k[11], k[12], k[13], k[14],
+                                            k[15], k[16], k[17]),
+                     a[i]);
+      }
+    }
+  }
+
+  private static void testSuspendCheck() throws Exception {
+    Thread gc = new Thread() {
+      public void run() {
+        while (!stop) {
+          Runtime.getRuntime().gc();
+        }
+      }
+    };
+    gc.start();
+    int[] a = new int[N * 64];
+    for (int r = 0; r < 2000; r++) {
+      addInvariant(a, r);
+    }
+    stop = true;
+    gc.join();
+    int expected = 1999 * 2000 / 2;
+    for (int i = 0; i < a.length; i++) {
+      expectEquals(expected, a[i]);
+    }
+  }
+
+  private static void testCalls() {
+    double[] a = new double[N];
+    double[] b = new double[N];
+    for (int r = 0; r < 1000; r++) {
+      double expected = 0;
+      for (int i = 0; i < N; i++) {
+        a[i] = i;
+        b[i] = r;
+        expected = $noinline$addDouble(expected, i + r);
+      }
+      expectEquals(expected * 0.5, addThenCall(a, b));
+    }
+  }
+
+  private static int $noinline$addInt(int x, int y) {
+    return x + y;
+  }
+
+  private static int $noinline$minInt(int x, int y) {
+    return Math.min(x, y);
+  }
+
+  private static int $noinline$maxInt(int x, int y) {
+    return Math.max(x, y);
+  }
+
+  private static long $noinline$addLong(long x, long y) {
+    return x + y;
+  }
+
+  private static double $noinline$addDouble(double x, double y) {
+    return x + y;
+  }
+
+  private static void expectEquals(int expected, int result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(long expected, long result) {
+    if (expected != result) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(float expected, float result) {
+    if (Float.floatToRawIntBits(expected) != Float.floatToRawIntBits(result)) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+
+  private static void expectEquals(double expected, double result) {
+    if (Double.doubleToRawLongBits(expected) != Double.doubleToRawLongBits(result)) {
+      throw new Error("Expected: " + expected + ", found: " + result);
+    }
+  }
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2017 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+public class Main {
+  // Must be at least the compiler's kMinimumCountForColdBranch.
+  static final int kWarmupIterations = 5000;
+
+  public static void assertEquals(int expected, int actual) {
+    if (expected != actual) {
+      throw new Error("Expected " + expected  + ", got " + actual);
+    }
+  }
+
+  public static int $noinline$abs(int value) {
+    if (value < 0) {
+      return -value;
+    }
+    return value;
+  }
+
+  public static void main(String[] args) {
+    System.loadLibrary(args[0]);
+    if (!hasJit()) {
+      System.out.println("passed");
+      return;
+    }
+    for (int i = 0; i < kWarmupIterations; ++i) {
+      assertEquals(i, $noinline$abs(i));
+    }
+    ensureJitCompiled(Main.class, "$noinline$abs");
+
+    // The compiled code only has the non-negative path, and deoptimizes for the other.
+    int before = numberOfDeoptimizations();
+    assertEquals(42, $noinline$abs(-42));
+    assertEquals(1, numberOfDeoptimizations() - before);
+    System.out.println("passed");
+  }
+
+  private static native boolean hasJit();
+  private static native void ensureJitCompiled(Class<?> cls, String methodName);
+  private static native int numberOfDeoptimizations();
+}